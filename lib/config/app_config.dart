@@ -44,6 +44,15 @@ class AppConfig {
   static const int maxCacheSize = 200 * 1024 * 1024; // 200 MB
   static const Duration cacheExpiration = Duration(days: 30);
 
+  // Configurazioni Salvataggio
+  static const Duration profileCommitWindow = Duration(milliseconds: 500); // Salvataggi del profilo raggruppati in una scrittura
+  static const Duration sessionJournalSyncWindow = Duration(milliseconds: 200); // fsync dei risultati della sessione raggruppati
+
+  // Configurazioni Log
+  static const int logMaxFileSize = 1024 * 1024; // Oltre, il file di log viene chiuso e compresso
+  static const Duration logFlushInterval = Duration(milliseconds: 250); // Scritture dei log raggruppate
+  static const int serviceLogCapacity = 1000; // Righe recenti tenute in memoria
+
   // Configurazioni Learning Analytics
   static const int maxStoredSessions = 20;
   static const int minSessionDuration = 60; // secondi
@@ -10,6 +10,7 @@ import 'services/content_service.dart';
 import 'services/exercise_manager.dart';
 import 'services/game_service.dart';
 import 'services/store_service.dart';
+import 'services/file_storage_service.dart';
 import 'models/player.dart';
 import 'screens/splash_screen.dart';
 import 'screens/game_screen.dart';
@@ -27,6 +28,18 @@ void main() async {
   // Inizializzazione delle SharedPreferences.
   final prefs = await SharedPreferences.getInstance();
 
+  // I salvataggi del profilo ancora in attesa vengono scritti quando l'app
+  // passa in background o viene chiusa.
+  AppLifecycleListener(
+    onHide: FileStorageService().flush,
+    onPause: FileStorageService().flush,
+    onDetach: FileStorageService().flush,
+    onExitRequested: () async {
+      await FileStorageService().flush();
+      return AppExitResponse.exit;
+    },
+  );
+
   runApp(
     MultiProvider(
       providers: [
@@ -3,8 +3,9 @@ import 'dart:math';
 class Word {
   final String text;
   final int crystalValue;
+  final int? lexiconIndex; // Voce del lessico nativo, se la parola viene da lì
 
-  Word(this.text) : crystalValue = text.length;
+  Word(this.text, {this.lexiconIndex}) : crystalValue = text.length;
 }
 
 class Sentence {
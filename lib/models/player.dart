@@ -1,5 +1,6 @@
 // lib/models/player.dart
 
+import 'dart:collection';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/widgets.dart';
 import '../services/file_storage_service.dart';
@@ -94,9 +95,16 @@ class Player with ChangeNotifier {
 
   bool get isAdmin => _isAdmin;
   int get newGamePlusCount => _newGamePlusCount;
-  Set<String> get usedWords => Set.unmodifiable(_usedWords);
-  Set<String> get usedSentences => Set.unmodifiable(_usedSentences);
-  Map<String, dynamic> get gameData => Map<String, dynamic>.from(_gameData);
+  // Viste in sola lettura: i getter sono chiamati spesso e non copiano
+  Set<String> get usedWords => UnmodifiableSetView(_usedWords);
+  Set<String> get usedSentences => UnmodifiableSetView(_usedSentences);
+  Map<String, dynamic> get gameData => UnmodifiableMapView(_gameData);
+
+  /// Imposta un valore di gameData senza salvare: il salvataggio resta al
+  /// chiamante.
+  void setGameValue(String key, dynamic value) {
+    _gameData[key] = value;
+  }
 
   DateTime? get lastPlayDate => _lastPlayDate;
   set lastPlayDate(DateTime? value) {
@@ -316,6 +324,13 @@ class Player with ChangeNotifier {
     }
   }
 
+  /// Salva i progressi e li scrive subito su disco, senza attendere la
+  /// finestra in cui i salvataggi vengono raggruppati.
+  Future<void> flushProgress() async {
+    await saveProgress();
+    await _storageService.flush();
+  }
+
   Future<bool> loadProgress() async {
     if (_id.isEmpty) return false;
     try {
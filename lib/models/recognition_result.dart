@@ -1,6 +1,22 @@
 // recognition_result.dart
 import '../config/app_config.dart';
 
+/// Parola riconosciuta con l'intervallo in cui è pronunciata nella
+/// registrazione.
+class RecognizedWord {
+  final String word;
+  final Duration start;
+  final Duration end;
+  final double confidence;
+
+  const RecognizedWord({
+    required this.word,
+    required this.start,
+    required this.end,
+    required this.confidence,
+  });
+}
+
 class RecognitionResult {
   final String text;              // Testo riconosciuto
   final double confidence;        // Livello di confidenza del riconoscimento
@@ -8,6 +24,9 @@ class RecognitionResult {
   final bool isCorrect;          // Se il testo è considerato corretto
   final Duration duration;        // Durata della registrazione
   final DateTime timestamp;       // Timestamp del riconoscimento
+  final String targetText;        // Testo atteso, usato per ricalcolare la similarità
+  final String profileId;         // Profilo che ha letto; vuoto se non noto
+  final List<RecognizedWord> words; // Parole con i tempi, se note (non salvate)
 
   RecognitionResult({
     required this.text,
@@ -16,6 +35,9 @@ class RecognitionResult {
     required this.isCorrect,
     this.duration = const Duration(seconds: 0),
     DateTime? timestamp,
+    this.targetText = '',
+    this.profileId = '',
+    this.words = const [],
   }) : timestamp = timestamp ?? DateTime.now();
 
   // Factory constructor per creare un risultato dal JSON di VOSK
@@ -43,6 +65,67 @@ class RecognitionResult {
       similarity: totalConfidence, // Usiamo la confidenza di VOSK come similarità
       duration: dur,
       isCorrect: totalConfidence >= AppConfig.minSimilarityScore,
+      targetText: targetText,
+      words: [
+        for (final word in words)
+          RecognizedWord(
+            word: word['word'] as String? ?? '',
+            start: _seconds(word['start'] as num? ?? 0),
+            end: _seconds(word['end'] as num? ?? 0),
+            confidence: (word['conf'] as num? ?? 0).toDouble(),
+          ),
+      ],
+    );
+  }
+
+  /// Copia del risultato con la similarità calcolata dal motore nativo
+  /// (ad esempio con i costi di confusione del profilo) al posto di quella
+  /// del riconoscitore.
+  RecognitionResult withSimilarity(double newSimilarity) {
+    return RecognitionResult(
+      text: text,
+      confidence: confidence,
+      similarity: newSimilarity,
+      isCorrect: newSimilarity >= AppConfig.minSimilarityScore,
+      duration: duration,
+      timestamp: timestamp,
+      targetText: targetText,
+      profileId: profileId,
+      words: words,
+    );
+  }
+
+  /// Copia del risultato attribuita al profilo [id]
+  RecognitionResult withProfile(String id) {
+    return RecognitionResult(
+      text: text,
+      confidence: confidence,
+      similarity: similarity,
+      isCorrect: isCorrect,
+      duration: duration,
+      timestamp: timestamp,
+      targetText: targetText,
+      profileId: id,
+      words: words,
+    );
+  }
+
+  static Duration _seconds(num seconds) =>
+      Duration(microseconds: (seconds * Duration.microsecondsPerSecond).round());
+
+  // Crea un risultato dal JSON prodotto da toJson (cronologia salvata)
+  factory RecognitionResult.fromJson(Map<String, dynamic> json) {
+    return RecognitionResult(
+      text: json['text'] as String? ?? '',
+      confidence: (json['confidence'] as num? ?? 0).toDouble(),
+      similarity: (json['similarity'] as num? ?? 0).toDouble(),
+      isCorrect: json['isCorrect'] as bool? ?? false,
+      duration: Duration(milliseconds: (json['duration'] as num? ?? 0).toInt()),
+      timestamp: json['timestamp'] != null
+          ? DateTime.parse(json['timestamp'] as String)
+          : null,
+      targetText: json['targetText'] as String? ?? '',
+      profileId: json['profileId'] as String? ?? '',
     );
   }
 
@@ -99,6 +182,8 @@ class RecognitionResult {
       'isCorrect': isCorrect,
       'duration': duration.inMilliseconds,
       'timestamp': timestamp.toIso8601String(),
+      'targetText': targetText,
+      if (profileId.isNotEmpty) 'profileId': profileId,
     };
   }
 
@@ -1,3 +1,7 @@
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import '../services/native/opendsa_native_bindings.dart';
+
 /// Classe che implementa algoritmi specializzati per il calcolo della similarità
 /// tra testi, ottimizzata per le particolari esigenze degli utenti con dislessia.
 class TextSimilarity {
@@ -187,8 +191,18 @@ class TextSimilarity {
     return totalScore / maxScore;
   }
 
+  /// Numero massimo di errori copiati dalla diagnosi nativa
+  static const int _maxNativeEdits = 256;
+
   /// Fornisce feedback specifici basati sul tipo di errori
   static String getDetailedFeedback(String recognized, String target) {
+    // La diagnosi nativa allinea i testi una sola volta e classifica ogni
+    // errore, anche dopo inserzioni od omissioni
+    final native = OpenDsaNativeLibrary.instance;
+    if (native != null) {
+      return _getNativeDetailedFeedback(native, recognized, target);
+    }
+
     List<String> feedback = [];
 
     // Analizza diversi tipi di errori
@@ -210,6 +224,55 @@ class TextSimilarity {
         : feedback.join(". ");
   }
 
+  /// Costruisce il feedback a partire dalla diagnosi della libreria nativa
+  static String _getNativeDetailedFeedback(
+      OpenDsaNativeLibrary native,
+      String recognized,
+      String target,
+      ) {
+    return using((arena) {
+      final diagnostics = arena<OpendsaDiagnostics>();
+      diagnostics.ref.edits = arena<OpendsaEdit>(_maxNativeEdits);
+      diagnostics.ref.editCapacity = _maxNativeEdits;
+
+      native.opendsa_diagnose(
+        recognized.toNativeUtf8(allocator: arena),
+        target.toNativeUtf8(allocator: arena),
+        diagnostics,
+      );
+
+      final result = diagnostics.ref;
+      List<String> feedback = [];
+
+      if (result.inversions > 0) {
+        feedback.add("Attenzione alle inversioni di lettere");
+      }
+
+      if (result.confusions > 0) {
+        Set<String> confusions = {};
+        final count = result.editCount < _maxNativeEdits
+            ? result.editCount
+            : _maxNativeEdits;
+        for (int i = 0; i < count; i++) {
+          final edit = result.edits[i];
+          if (edit.kind == OpendsaEditKind.confusion) {
+            confusions.add("${String.fromCharCode(edit.actual)}-"
+                "${String.fromCharCode(edit.expected)}");
+          }
+        }
+        feedback.add("Fai attenzione a distinguere: ${confusions.join(', ')}");
+      }
+
+      if (result.sequenceErrors > 0) {
+        feedback.add("Controlla le combinazioni di lettere");
+      }
+
+      return feedback.isEmpty
+          ? "Continua così!"
+          : feedback.join(". ");
+    });
+  }
+
   /// Verifica la presenza di inversioni di lettere
   static bool _hasLetterInversions(String s1, String s2) {
     for (int i = 0; i < s1.length - 1; i++) {
@@ -4,6 +4,8 @@ import 'package:flutter/material.dart';
 import 'package:provider/provider.dart';
 import '../models/player.dart';
 import '../services/game_service.dart';
+import '../services/learning_analytics_service.dart';
+import '../services/native/attempt_log.dart';
 import 'game_screen.dart';
 
 class LevelSummaryScreen extends StatelessWidget {
@@ -23,6 +25,10 @@ class LevelSummaryScreen extends StatelessWidget {
   Widget build(BuildContext context) {
     final player = Provider.of<Player>(context);
     final gameService = Provider.of<GameService>(context);
+    // Riepilogo materializzato del livello, letto in tempo costante
+    final levelSummary = Provider.of<LearningAnalyticsService>(context,
+            listen: false)
+        .levelSummary(player.id, completedLevel);
 
     return Scaffold(
       body: Container(
@@ -45,6 +51,10 @@ class LevelSummaryScreen extends StatelessWidget {
                   SizedBox(height: 20),
                   _buildProgressInfo(gameService),
                   SizedBox(height: 20),
+                  if (levelSummary != null) ...[
+                    _buildLevelStats(levelSummary),
+                    SizedBox(height: 20),
+                  ],
                   _buildCrystalsInfo(earnedCrystals, player),
                 ],
                 SizedBox(height: 40),
@@ -198,6 +208,59 @@ class LevelSummaryScreen extends StatelessWidget {
     );
   }
 
+  Widget _buildLevelStats(NativeAttemptSummary summary) {
+    final seconds = summary.durationMeanMs / 1000;
+
+    return Container(
+      padding: EdgeInsets.all(16),
+      margin: EdgeInsets.symmetric(horizontal: 32),
+      decoration: BoxDecoration(
+        color: Colors.white,
+        borderRadius: BorderRadius.circular(12),
+        boxShadow: [
+          BoxShadow(
+            color: Colors.black12,
+            blurRadius: 8,
+            spreadRadius: 2,
+          ),
+        ],
+      ),
+      child: Row(
+        mainAxisAlignment: MainAxisAlignment.spaceAround,
+        children: [
+          _buildLevelStat('Letture', '${summary.attempts}'),
+          _buildLevelStat('Corrette', '${(summary.accuracy * 100).round()}%'),
+          _buildLevelStat('Tempo medio', '${seconds.toStringAsFixed(1)}s'),
+          _buildLevelStat('Giorni', '${summary.days}'),
+        ],
+      ),
+    );
+  }
+
+  Widget _buildLevelStat(String label, String value) {
+    return Column(
+      children: [
+        Text(
+          value,
+          style: TextStyle(
+            fontFamily: 'OpenDyslexic',
+            fontSize: 18,
+            fontWeight: FontWeight.bold,
+            color: Colors.black87,
+          ),
+        ),
+        Text(
+          label,
+          style: TextStyle(
+            fontFamily: 'OpenDyslexic',
+            fontSize: 12,
+            color: Colors.grey[600],
+          ),
+        ),
+      ],
+    );
+  }
+
   Widget _buildCrystalsInfo(int earned, Player player) {
     return Column(
       children: [
@@ -9,6 +9,7 @@ import '../services/game_service.dart';
 import '../services/vosk_service.dart';
 import '../services/audio_service.dart';
 import '../services/exercise_manager.dart';
+import '../services/native/tokenized_text.dart';
 import '../models/recognition_result.dart';
 import '../widgets/voice_recognition_feedback.dart';
 import '../widgets/crystal_popup.dart';
@@ -35,6 +36,11 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
   bool _isInitialized = false;
   bool _isSessionStarted = false;
 
+  // Token del testo da leggere (null senza libreria nativa) e token
+  // riconosciuti nell'ultimo tentativo (null prima del tentativo)
+  TokenizedText? _tokens;
+  Set<int>? _readTokens;
+
   // Servizi
   late final VoskService _voskService;
   late final AudioService _audioService;
@@ -87,8 +93,11 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
     try {
       final exercise = await _exerciseManager.generateExercise();
       if (!mounted) return;
+      _tokens?.dispose();
       setState(() {
         _currentWord = exercise.content;
+        _tokens = TokenizedText.tokenize(exercise.content);
+        _readTokens = null;
         _isProcessing = false;
         _currentExercise++;
       });
@@ -129,9 +138,10 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
       if (!mounted) return;
       setState(() => _isRecording = false);
       if (audioPath.isNotEmpty) {
-        // Utilizzo il flusso unificato per processare il risultato
-        final result = await _voskService.startRecognition(_currentWord);
-        await _handleRecognitionResult(result);
+        // Riconosce la registrazione appena conclusa; senza riconoscimento
+        // nativo dei file (o in modalità simulata) torna all'ascolto
+        final result = await _voskService.recognizeFile(audioPath, _currentWord);
+        await _handleRecognitionResult(result, audioPath);
       }
     } catch (e) {
       if (!mounted) return;
@@ -142,8 +152,9 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
     }
   }
 
-  /// Gestisce il risultato del riconoscimento vocale e procede con il caricamento del prossimo esercizio
-  Future<void> _handleRecognitionResult(RecognitionResult result) async {
+  /// Gestisce il risultato del riconoscimento vocale e procede con il caricamento del prossimo esercizio.
+  /// [audioPath] è la registrazione di questo tentativo restituita da [AudioService.stopRecording].
+  Future<void> _handleRecognitionResult(RecognitionResult result, String audioPath) async {
     if (!mounted) return;
     try {
       final playerManager = Provider.of<PlayerManager>(context, listen: false);
@@ -153,13 +164,25 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
       }
       final gameService = Provider.of<GameService>(context, listen: false);
 
+      // La registrazione del tentativo resta nell'archivio per riascoltarla;
+      // la codifica prosegue in background mentre il risultato viene valutato
+      unawaited(_audioService.archiveRecording(
+        audioPath,
+        profileId: player.id,
+        target: _currentWord,
+      ));
+
+      // Similarità calcolata con i costi di confusione appresi per il profilo
+      final scored = await _exerciseManager.scoreResult(result);
+      _highlightReadTokens(scored.text);
+
       // Processa il risultato tramite ExerciseManager e ottiene i cristalli guadagnati
-      final crystalsEarned = await _exerciseManager.processExerciseResult(result);
+      final crystalsEarned = await _exerciseManager.processExerciseResult(scored);
       setState(() => _totalCrystals += crystalsEarned);
       debugPrint('[ReadingExerciseScreen] Risultato processato. Cristalli guadagnati: $crystalsEarned');
 
       // Mostra il popup di feedback
-      await _showFeedbackPopup(result, crystalsEarned,
+      await _showFeedbackPopup(scored, crystalsEarned,
           player.currentLevel);
 
       // Se la sessione è completa, mostra il riepilogo, altrimenti carica un nuovo esercizio
@@ -177,6 +200,58 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
     }
   }
 
+  /// Evidenzia nel testo le parole che il riconoscimento ha allineato a
+  /// [recognized].
+  void _highlightReadTokens(String recognized) {
+    final tokens = _tokens;
+    if (tokens == null || !mounted) return;
+    setState(() {
+      _readTokens = {
+        for (final token in tokens.align(recognized))
+          if (token >= 0) token,
+      };
+    });
+  }
+
+  /// Testo da leggere, composto dai token: dopo un tentativo le parole lette
+  /// sono in verde e quelle mancanti in rosso.
+  Widget _buildReadingText() {
+    const style = TextStyle(
+      fontSize: 32,
+      fontFamily: 'OpenDyslexic',
+      color: Colors.black87,
+    );
+    final tokens = _tokens;
+    final readTokens = _readTokens;
+    if (tokens == null || readTokens == null) {
+      return Text(_currentWord, style: style);
+    }
+
+    final begins = tokens.begins;
+    final ends = tokens.ends;
+    final spans = <TextSpan>[];
+    var position = 0;
+    for (var i = 0; i < tokens.length; i++) {
+      if (begins[i] > position) {
+        spans.add(TextSpan(text: _currentWord.substring(position, begins[i])));
+      }
+      spans.add(TextSpan(
+        text: _currentWord.substring(begins[i], ends[i]),
+        style: tokens.isWord(i)
+            ? TextStyle(
+                color: readTokens.contains(i)
+                    ? Colors.green.shade700
+                    : Colors.red.shade700)
+            : null,
+      ));
+      position = ends[i];
+    }
+    if (position < _currentWord.length) {
+      spans.add(TextSpan(text: _currentWord.substring(position)));
+    }
+    return Text.rich(TextSpan(style: style, children: spans));
+  }
+
   /// Mostra il popup di feedback dopo ogni esercizio
   Future<void> _showFeedbackPopup(RecognitionResult result, int crystalsEarned, int level) async {
     if (!mounted) return;
@@ -329,14 +404,7 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
                             ),
                             child: Padding(
                               padding: const EdgeInsets.all(24.0),
-                              child: Text(
-                                _currentWord,
-                                style: const TextStyle(
-                                  fontSize: 32,
-                                  fontFamily: 'OpenDyslexic',
-                                  color: Colors.black87,
-                                ),
-                              ),
+                              child: _buildReadingText(),
                             ),
                           ),
                           if (_isRecording)
@@ -409,6 +477,8 @@ class _ReadingExerciseScreenState extends State<ReadingExerciseScreen> {
     }
     _audioService.dispose();
     _voskService.dispose();
+    _tokens?.dispose();
+    _tokens = null;
     super.dispose();
   }
 }
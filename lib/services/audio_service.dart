@@ -8,6 +8,8 @@ import 'package:flutter_sound/flutter_sound.dart';
 import 'package:flutter/foundation.dart';
 import '../config/app_config.dart';
 import '../models/enums.dart';
+import 'file_storage_service.dart';
+import 'native/audio_archive.dart';
 
 /// Servizio che gestisce tutti gli aspetti delle registrazioni audio nell'applicazione.
 /// Si occupa della registrazione, della gestione del volume e del ciclo di vita delle sessioni audio.
@@ -27,12 +29,19 @@ class AudioService {
 
   // Componenti audio
   FlutterSoundRecorder? _recorder;
-  String? _recordingPath;
+  String? _recordingDirectory;
+  String? _recordingPath;        // File del tentativo corrente
+  String? _unarchivedRecording;  // Registrazione conclusa non ancora archiviata
   Timer? _recordingTimer;
   Timer? _volumeUpdateTimer;
   bool _processingResult = false;
   final Random _random = Random();
 
+  // Archivio delle registrazioni; null finché non è aperto o se la libreria
+  // nativa non è disponibile
+  NativeAudioArchive? _archive;
+  Future<NativeAudioArchive?>? _archiveOpening;
+
   /// Costruttore privato per il singleton
   AudioService._internal() {
     debugPrint('AudioService inizializzato per ${Platform.operatingSystem}');
@@ -87,15 +96,39 @@ class AudioService {
     }
   }
 
-  /// Configura la directory di registrazione
+  /// Configura la directory di registrazione, la stessa per tutte le
+  /// inizializzazioni. Ogni tentativo registra in un file proprio, eliminato
+  /// dopo che [archiveRecording] lo ha copiato nell'archivio o all'avvio
+  /// del tentativo successivo; quelli rimasti da un'esecuzione precedente
+  /// vengono eliminati qui.
   Future<void> _setupRecordingDirectory() async {
+    if (_recordingDirectory != null) return;
     try {
-      final tempDir = await Directory.systemTemp.createTemp('audio_recording_');
-      _recordingPath = '${tempDir.path}/recording.wav';
-      debugPrint('AudioService: Directory di registrazione impostata su $_recordingPath');
+      final tempDir = Directory('${Directory.systemTemp.path}/opendsa_recording');
+      await tempDir.create(recursive: true);
+      await for (final entry in tempDir.list()) {
+        if (entry is File && entry.path.endsWith('.wav')) {
+          await entry.delete();
+        }
+      }
+      _recordingDirectory = tempDir.path;
+      debugPrint('AudioService: Directory di registrazione impostata su $_recordingDirectory');
     } catch (e) {
       debugPrint('Errore setup directory: $e');
-      _recordingPath = 'recording.wav';
+      _recordingDirectory = '.';
+    }
+  }
+
+  /// Elimina la registrazione conclusa che non è stata archiviata
+  Future<void> _discardUnarchivedRecording() async {
+    final path = _unarchivedRecording;
+    _unarchivedRecording = null;
+    if (path == null) return;
+    try {
+      final file = File(path);
+      if (await file.exists()) await file.delete();
+    } catch (e) {
+      debugPrint('AudioService: impossibile eliminare $path: $e');
     }
   }
 
@@ -105,6 +138,8 @@ class AudioService {
     try {
       debugPrint('AudioService: startRecording() chiamato.');
       _streamControllers.reset();
+      await _discardUnarchivedRecording();
+      _recordingPath = '${_recordingDirectory ?? '.'}/recording_${DateTime.now().microsecondsSinceEpoch}.wav';
 
       if (_state.isSimulatedMode) {
         await _startSimulatedRecording();
@@ -212,6 +247,7 @@ class AudioService {
     if (!_state.isSimulatedMode && _recorder != null) {
       try {
         await _recorder?.stopRecorder();
+        _unarchivedRecording = _recordingPath;
       } catch (e) {
         debugPrint('Errore stop recorder: $e');
       }
@@ -219,6 +255,79 @@ class AudioService {
     return _recordingPath ?? '';
   }
 
+  /// Archivia la registrazione [recordingPath] restituita da [stopRecording]
+  /// come tentativo di [profileId] su [target], compressa senza perdita;
+  /// l'archivio resta entro [AppConfig.maxCacheSize] e
+  /// [AppConfig.cacheExpiration]. La codifica avviene su un thread della
+  /// libreria nativa e il WAV viene eliminato al termine.
+  ///
+  /// Restituisce l'id della clip, null se [recordingPath] non è l'ultima
+  /// registrazione conclusa (simulata, già archiviata o superata da un
+  /// nuovo tentativo) o l'archivio non è disponibile.
+  Future<int?> archiveRecording(
+    String recordingPath, {
+    required String profileId,
+    required String target,
+  }) async {
+    // Il file passa all'archiviazione prima di qualsiasi attesa: un nuovo
+    // tentativo non lo elimina e una seconda chiamata non lo riarchivia
+    if (recordingPath.isEmpty || recordingPath != _unarchivedRecording) {
+      return null;
+    }
+    _unarchivedRecording = null;
+    final recordedAt = DateTime.now();
+    try {
+      if (!await File(recordingPath).exists()) return null;
+      final archive = await _openArchive();
+      return await archive?.addWavInBackground(recordingPath,
+          profileId: profileId, target: target, recordedAt: recordedAt);
+    } catch (e) {
+      debugPrint('AudioService: registrazione non archiviata: $e');
+      return null;
+    } finally {
+      try {
+        final file = File(recordingPath);
+        if (await file.exists()) await file.delete();
+      } catch (e) {
+        debugPrint('AudioService: impossibile eliminare $recordingPath: $e');
+      }
+    }
+  }
+
+  /// Registrazioni archiviate di [profileId] e [target], dalla più recente.
+  Future<List<NativeAudioClip>> archivedRecordings(
+      {String? profileId, String? target}) async {
+    final archive = await _openArchive();
+    return archive?.clips(profileId: profileId, target: target) ?? [];
+  }
+
+  /// Ricostruisce la registrazione [id] in un WAV da riascoltare e ne
+  /// restituisce il percorso.
+  Future<String?> exportArchivedRecording(int id) async {
+    final archive = await _openArchive();
+    if (archive == null) return null;
+    final path = '${Directory.systemTemp.path}/opendsa_replay_$id.wav';
+    return archive.exportWav(id, path) ? path : null;
+  }
+
+  Future<NativeAudioArchive?> _openArchive() {
+    return _archiveOpening ??= () async {
+      try {
+        final dir = await FileStorageService().getAudioArchiveDirectory();
+        _archive = NativeAudioArchive.open(
+          dir,
+          maxBytes: AppConfig.maxCacheSize,
+          maxAge: AppConfig.cacheExpiration,
+        );
+        // Le clip scadute mentre l'app era chiusa
+        _archive?.evict();
+      } catch (e) {
+        debugPrint('AudioService: archivio delle registrazioni non disponibile: $e');
+      }
+      return _archive;
+    }();
+  }
+
   /// Aggiorna lo stato del servizio
   void _updateState(AudioState newState) {
     _state.currentState = newState;
@@ -246,6 +355,10 @@ class AudioService {
       _recorder = null;
     }
     await _streamControllers.dispose();
+    await _discardUnarchivedRecording();
+    _archive?.close();
+    _archive = null;
+    _archiveOpening = null;
     _state.reset();
     debugPrint('AudioService: Dispose completato, risorse rilasciate.');
   }
@@ -7,7 +7,14 @@ import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 import '../models/content_models.dart';
 import '../models/enums.dart';
+import '../models/level.dart';
 import '../config/app_config.dart';
+import 'file_storage_service.dart';
+import 'native/content_index.dart';
+import 'native/content_pack.dart';
+import 'native/lexicon.dart';
+import 'native/opendsa_native_bindings.dart' show OpendsaTokenFlags;
+import 'native/tokenized_text.dart';
 
 /// Servizio responsabile per il caricamento, la gestione e la distribuzione
 /// di tutti i contenuti testuali dell'applicazione (parole, frasi, paragrafi, pagine).
@@ -17,6 +24,18 @@ class ContentService extends ChangeNotifier {
   late ContentSet _contentSet;
   final Map<String, List<String>> _cachedContent = {};
 
+  // Lessico binario precompilato, se disponibile: sostituisce le liste .txt
+  NativeLexicon? _lexicon;
+
+  // Indice delle parole del lessico: scelta senza ripetizioni in tempo costante
+  NativeContentIndex? _contentIndex;
+  int _picksSinceIndexSave = 0;
+  static const int _indexSaveInterval = 5;
+
+  // Pacchetti dei testi di lettura: paragrafi e pagine letti su richiesta
+  NativeContentPack? _paragraphsPack;
+  NativeContentPack? _pagesPack;
+
   // Tracking delle parole usate per evitare ripetizioni
   final Set<String> _usedWords = {};
   final Set<String> _usedSentences = {};
@@ -37,21 +56,43 @@ class ContentService extends ChangeNotifier {
     if (_isInitialized) return;
 
     try {
-      // Carica tutti i contenuti
-      final easyWords = await _loadWords(AppConfig.wordsEasyPath);
-      final mediumWords = await _loadWords(AppConfig.wordsMediumPath);
-      final hardWords = await _loadWords(AppConfig.wordsHardPath);
+      // Le parole vengono dal lessico mappato, se presente; altrimenti
+      // dalle liste di testo
+      _lexicon ??= NativeLexicon.openBundled();
+      final List<Word> dictionary;
+      if (_lexicon != null) {
+        dictionary = _lexicon!.words;
+        await _openContentIndex();
+      } else {
+        final easyWords = await _loadWords(AppConfig.wordsEasyPath);
+        final mediumWords = await _loadWords(AppConfig.wordsMediumPath);
+        final hardWords = await _loadWords(AppConfig.wordsHardPath);
+        dictionary = [
+          ...easyWords.map((word) => Word(word)),
+          ...mediumWords.map((word) => Word(word)),
+          ...hardWords.map((word) => Word(word)),
+        ];
+      }
       final sentences = await _loadSentences(AppConfig.sentencesPath);
-      final paragraphs = await _loadParagraphs(AppConfig.paragraphsPath);
-      final pages = await _loadPages(AppConfig.pagesPath);
+
+      // Con i pacchetti nativi paragrafi e pagine vengono costruiti solo
+      // quando un esercizio li richiede
+      _paragraphsPack ??= NativeContentPack.openBundled(NativeContentPack.paragraphsFileName);
+      _pagesPack ??= NativeContentPack.openBundled(NativeContentPack.pagesFileName);
+      final paragraphs = _paragraphsPack != null
+          ? _paragraphsPack!.map((tokens) => _pagesFromTokens(tokens)
+              .expand((page) => page.paragraphs)
+              .firstWhere((_) => true, orElse: () => Paragraph(const [])))
+          : await _loadParagraphs(AppConfig.paragraphsPath);
+      final pages = _pagesPack != null
+          ? _pagesPack!.map((tokens) => Page(_pagesFromTokens(tokens)
+              .expand((page) => page.paragraphs)
+              .toList()))
+          : await _loadPages(AppConfig.pagesPath);
 
       // Inizializza il ContentSet
       _contentSet = ContentSet(
-        dictionary: [
-          ...easyWords.map((word) => Word(word)),
-          ...mediumWords.map((word) => Word(word)),
-          ...hardWords.map((word) => Word(word)),
-        ],
+        dictionary: dictionary,
         sentences: sentences,
         paragraphs: paragraphs,
         pages: pages,
@@ -68,6 +109,17 @@ class ContentService extends ChangeNotifier {
   }
 
 
+  /// Apre l'indice delle parole ripristinando le parole già proposte
+  Future<void> _openContentIndex() async {
+    String? statePath;
+    try {
+      statePath = await FileStorageService().getContentIndexStatePath();
+    } catch (e) {
+      debugPrint('Stato dell\'indice delle parole non disponibile: $e');
+    }
+    _contentIndex ??= NativeContentIndex.open(_lexicon!, statePath: statePath);
+  }
+
   /// Carica il contenuto di un file di assets
   Future<String> loadAsset(String path) async {
     try {
@@ -125,6 +177,14 @@ class ContentService extends ChangeNotifier {
   Future<List<Paragraph>> _loadParagraphs(String path) async {
     try {
       final content = await loadAsset(path);
+      final tokens = TokenizedText.tokenize(content);
+      if (tokens != null) {
+        try {
+          return _pagesFromTokens(tokens).expand((page) => page.paragraphs).toList();
+        } finally {
+          tokens.dispose();
+        }
+      }
       return content.split('\n\n')
           .where((paragraph) => paragraph.trim().isNotEmpty)
           .map((paragraph) => Paragraph(
@@ -148,6 +208,14 @@ class ContentService extends ChangeNotifier {
   Future<List<Page>> _loadPages(String path) async {
     try {
       final content = await loadAsset(path);
+      final tokens = TokenizedText.tokenize(content);
+      if (tokens != null) {
+        try {
+          return _pagesFromTokens(tokens);
+        } finally {
+          tokens.dispose();
+        }
+      }
       return content.split('\n\n\n')
           .where((page) => page.trim().isNotEmpty)
           .map((page) => Page(
@@ -172,6 +240,65 @@ class ContentService extends ChangeNotifier {
     }
   }
 
+  /// Costruisce pagine, paragrafi e frasi dai token nativi, in un solo
+  /// passaggio. I confini di frase rispettano abbreviazioni, numeri decimali
+  /// e puntini di sospensione; ogni parola è un gruppo di token non separati
+  /// da spazi, con la punteggiatura interna (virgole, virgolette) ma senza
+  /// quella che chiude la frase, come nel caricamento basato su split.
+  List<Page> _pagesFromTokens(TokenizedText tokens) {
+    final pages = <Page>[];
+    var paragraphs = <Paragraph>[];
+    final begins = tokens.begins;
+    final ends = tokens.ends;
+    final sentenceStarts = tokens.sentenceStarts;
+    final paragraphStarts = tokens.paragraphStarts;
+
+    var sentence = 0;
+    for (var paragraph = 0; paragraph < tokens.paragraphCount; paragraph++) {
+      final paragraphEnd = paragraphStarts[paragraph + 1];
+      if (tokens.hasFlag(paragraphStarts[paragraph], OpendsaTokenFlags.pageStart) &&
+          paragraphs.isNotEmpty) {
+        pages.add(Page(paragraphs));
+        paragraphs = <Paragraph>[];
+      }
+
+      final sentences = <Sentence>[];
+      for (; sentence < tokens.sentenceCount && sentenceStarts[sentence] < paragraphEnd; sentence++) {
+        final words = <Word>[];
+        final end = sentenceStarts[sentence + 1];
+        var token = sentenceStarts[sentence];
+        while (token < end) {
+          // Gruppo di token fino al prossimo spazio
+          var groupEnd = token + 1;
+          while (groupEnd < end && !tokens.hasFlag(groupEnd, OpendsaTokenFlags.spaceBefore)) {
+            groupEnd++;
+          }
+          var last = token - 1;
+          var hasWord = false;
+          for (var i = token; i < groupEnd; i++) {
+            if (tokens.hasFlag(i, OpendsaTokenFlags.sentenceEnd)) break;
+            hasWord = hasWord || tokens.isWord(i);
+            last = i;
+          }
+          if (hasWord) {
+            words.add(Word(_normalizeWord(tokens.text.substring(begins[token], ends[last]))));
+          }
+          token = groupEnd;
+        }
+        if (words.isNotEmpty) sentences.add(Sentence(words));
+      }
+      if (sentences.isNotEmpty) paragraphs.add(Paragraph(sentences));
+    }
+    if (paragraphs.isNotEmpty) pages.add(Page(paragraphs));
+    return pages;
+  }
+
+  /// Suddivide [text] in token con offset stabili, per la schermata di
+  /// lettura e per l'allineamento delle parole riconosciute. Restituisce
+  /// null se la libreria nativa non è disponibile; il chiamante deve
+  /// rilasciare il risultato con [TokenizedText.dispose].
+  TokenizedText? tokenizeForReading(String text) => TokenizedText.tokenize(text);
+
   /// Normalizza una parola
   String _normalizeWord(String word) {
     return word.trim().toLowerCase();
@@ -201,8 +328,12 @@ class ContentService extends ChangeNotifier {
         .join('\n\n');
   }
 
-  /// Ottiene una parola casuale appropriata per il livello e la difficoltà
-  Word getRandomWordForLevel(int level, Difficulty difficulty) {
+  /// Ottiene una parola casuale appropriata per il livello e la difficoltà.
+  /// Con l'indice nativo la difficoltà è una chiave dell'indice, calcolata
+  /// dalle sillabe e caratteristiche salvate nel lessico; con [subLevel]
+  /// vengono applicati anche i suoi limiti di lunghezza
+  /// (minWordLength/maxWordLength).
+  Word getRandomWordForLevel(int level, Difficulty difficulty, {SubLevel? subLevel}) {
     _exerciseCounter++;
 
     if (_exerciseCounter >= _maxUsedItems) {
@@ -211,6 +342,16 @@ class ContentService extends ChangeNotifier {
       notifyListeners();
     }
 
+    if (_contentIndex != null) {
+      final word = _pickIndexedWord(level, difficulty, subLevel);
+      if (word != null) {
+        _usedWords.add(word.text);
+        _updateUsageStats(word.text, difficulty);
+        notifyListeners();
+        return word;
+      }
+    }
+
     String path;
     switch (level) {
       case 1:
@@ -242,6 +383,31 @@ class ContentService extends ChangeNotifier {
     return word;
   }
 
+  /// Prossima parola non ancora proposta dall'indice nativo, senza filtrare
+  /// né copiare liste. Se i limiti del sottolivello escludono tutte le parole
+  /// della difficoltà vengono ignorati, e poi anche la difficoltà;
+  /// restituisce null se il livello non ha parole.
+  Word? _pickIndexedWord(int level, Difficulty difficulty, SubLevel? subLevel) {
+    final lexiconLevel = level >= 1 && level <= 3 ? level : 1;
+    final index = _contentIndex!.next(
+          level: lexiconLevel,
+          difficulty: difficulty,
+          minLength: subLevel?.minWordLength,
+          maxLength: subLevel?.maxWordLength,
+        ) ??
+        _contentIndex!.next(level: lexiconLevel, difficulty: difficulty) ??
+        _contentIndex!.next(level: lexiconLevel);
+    if (index == null) return null;
+
+    // Lo stato viene salvato ogni pochi esercizi: dopo un arresto anomalo al
+    // più qualche parola può ripetersi
+    if (++_picksSinceIndexSave >= _indexSaveInterval) {
+      _contentIndex!.save();
+      _picksSinceIndexSave = 0;
+    }
+    return Word(_lexicon!.wordAt(index), lexiconIndex: index);
+  }
+
   /// Carica parole specifiche per un determinato path
   List<Word> _loadSpecificWords(String path) {
     try {
@@ -268,55 +434,6 @@ class ContentService extends ChangeNotifier {
   }
 
 
-  /// Filtra le parole in base alla difficoltà
-  List<Word> _getWordsForDifficulty(Difficulty difficulty) {
-    final words = _contentSet.dictionary;
-    switch (difficulty) {
-      case Difficulty.easy:
-      // Parole brevi con sillabe semplici (2-3 sillabe, max 5 lettere)
-        return words.where((word) =>
-        _countSyllables(word.text) <= 2 &&
-            word.text.length <= 5 &&
-            !_hasComplexSyllables(word.text)
-        ).toList();
-
-      case Difficulty.medium:
-      // Parole di media lunghezza (3-4 sillabe, 6-8 lettere)
-        return words.where((word) =>
-        _countSyllables(word.text) <= 4 &&
-            word.text.length > 5 &&
-            word.text.length <= 8
-        ).toList();
-
-      case Difficulty.hard:
-      // Parole lunghe o complesse (4+ sillabe o 8+ lettere)
-        return words.where((word) =>
-        _countSyllables(word.text) > 4 ||
-            word.text.length > 8 ||
-            _hasComplexSyllables(word.text)
-        ).toList();
-    }
-  }
-
-  /// Conta le sillabe in una parola italiana
-  int _countSyllables(String word) {
-    final vowels = RegExp('[aeiouAEIOU]');
-    final diphthongs = RegExp('(ai|au|ei|eu|oi|ou|ia|ie|io|iu|ua|ue|ui|uo)');
-
-    int count = vowels.allMatches(word).length;
-    count -= diphthongs.allMatches(word).length;
-    return count > 0 ? count : 1;
-  }
-
-  /// Verifica se una parola contiene sillabe complesse
-  bool _hasComplexSyllables(String word) {
-    // Gruppi consonantici complessi in italiano
-    final complexGroups = RegExp(
-        '(str|spr|scr|spl|sbl|sgl|sbr|sfr|zz|gn|gl|gh|ch|sc[ie])'
-    );
-    return complexGroups.hasMatch(word);
-  }
-
   /// Aggiorna le statistiche di utilizzo
   void _updateUsageStats(String word, Difficulty difficulty) {
     _wordUsageStats[word] = (_wordUsageStats[word] ?? 0) + 1;
@@ -346,6 +463,20 @@ class ContentService extends ChangeNotifier {
     notifyListeners();
   }
 
+  @override
+  void dispose() {
+    _paragraphsPack?.close();
+    _paragraphsPack = null;
+    _pagesPack?.close();
+    _pagesPack = null;
+    if (_contentIndex != null) {
+      _contentIndex!.save();
+      _contentIndex!.dispose();
+      _contentIndex = null;
+    }
+    super.dispose();
+  }
+
   // Getters pubblici
   bool get isInitialized => _isInitialized;
   ContentSet get contentSet => _contentSet;
@@ -353,4 +484,5 @@ class ContentService extends ChangeNotifier {
   Set<String> get usedWords => Set.unmodifiable(_usedWords);
   Set<String> get usedSentences => Set.unmodifiable(_usedSentences);
   String? get lastError => _lastError;
+  NativeLexicon? get lexicon => _lexicon;
 }
\ No newline at end of file
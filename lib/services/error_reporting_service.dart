@@ -3,6 +3,10 @@ import 'package:flutter/foundation.dart';
 import 'package:path_provider/path_provider.dart';
 import 'dart:io';
 import 'dart:convert';
+import 'dart:math';
+import '../config/app_config.dart';
+import 'native/native_logger.dart';
+import 'native/opendsa_native_bindings.dart';
 
 class ErrorReportingService {
   // Singleton pattern per garantire una singola istanza del servizio
@@ -13,6 +17,9 @@ class ErrorReportingService {
   late final Directory _logDirectory;
   // File per il log corrente
   late final File _currentLogFile;
+  // Log nativo scritto in background; null se la libreria non è
+  // disponibile, nel qual caso si scrive direttamente su _currentLogFile
+  NativeLogger? _logger;
 
   // Controller per lo stream degli errori
   final _errorController = StreamController<ErrorReport>.broadcast();
@@ -39,6 +46,13 @@ class ErrorReportingService {
 
       final today = DateTime.now().toIso8601String().split('T')[0];
       _currentLogFile = File('${_logDirectory.path}/log_$today.txt');
+      _logger = NativeLogger.open(
+        _logDirectory.path,
+        'log',
+        maxFileBytes: AppConfig.logMaxFileSize,
+        ringCapacity: _maxStoredErrors,
+        flushInterval: AppConfig.logFlushInterval,
+      );
     } catch (e) {
       print('Errore nell\'inizializzazione del servizio di reporting: $e');
     }
@@ -80,12 +94,20 @@ class ErrorReportingService {
     }
   }
 
-  // Salva l'errore nel file di log
+  // Salva l'errore nel file di log, una riga JSON per errore
   Future<void> _logError(ErrorReport report) async {
     try {
-      final logEntry = '${report.toJson()}\n';
+      final logEntry = json.encode(report.toJson(),
+          toEncodable: (value) => value.toString());
+      final logger = _logger;
+      if (logger != null) {
+        // Il contesto diventa il tag della riga, per queryErrors
+        logger.log(logEntry,
+            level: OpendsaLogLevel.error, tag: report.context);
+        return;
+      }
       await _currentLogFile.writeAsString(
-        logEntry,
+        '$logEntry\n',
         mode: FileMode.append,
       );
     } catch (e) {
@@ -110,39 +132,99 @@ class ErrorReportingService {
   // Ottiene tutti i log del giorno specificato
   Future<List<ErrorReport>> getLogsForDate(DateTime date) async {
     try {
-      final dateStr = date.toIso8601String().split('T')[0];
-      final logFile = File('${_logDirectory.path}/log_$dateStr.txt');
-
-      if (!await logFile.exists()) {
-        return [];
+      final logger = _logger;
+      if (logger != null) {
+        final day = DateTime(date.year, date.month, date.day);
+        return _decodeReports(logger
+            .query(from: day, to: DateTime(day.year, day.month, day.day + 1))
+            .map((record) => record.message));
       }
+      return _decodeReports(await _readLogFile(date));
+    } catch (e) {
+      print('Errore nel recupero dei log: $e');
+      return [];
+    }
+  }
 
-      final content = await logFile.readAsString();
-      return content
-          .split('\n')
-          .where((line) => line.isNotEmpty)
-          .map((line) => ErrorReport.fromJson(json.decode(line)))
+  // Gli ultimi [limit] errori registrati con il contesto [context] (tutti
+  // se null), tra [from] e [to]. Con il log nativo legge solo i blocchi dei
+  // segmenti che possono contenerli.
+  Future<List<ErrorReport>> queryErrors({
+    String? context,
+    int limit = 50,
+    DateTime? from,
+    DateTime? to,
+  }) async {
+    try {
+      final logger = _logger;
+      if (logger != null) {
+        return _decodeReports(logger
+            .query(
+              from: from,
+              to: to,
+              minLevel: OpendsaLogLevel.error,
+              tag: context,
+              limit: limit,
+            )
+            .map((record) => record.message));
+      }
+      // Senza la libreria nativa: solo il file di oggi
+      final reports = (await getLogsForDate(DateTime.now()))
+          .where((report) =>
+              (context == null || report.context == context) &&
+              (from == null || !report.timestamp.isBefore(from)) &&
+              (to == null || report.timestamp.isBefore(to)))
           .toList();
+      return reports.sublist(max(0, reports.length - limit));
     } catch (e) {
-      print('Errore nel recupero dei log: $e');
+      print('Errore nella ricerca dei log: $e');
       return [];
     }
   }
 
+  List<ErrorReport> _decodeReports(Iterable<String> lines) {
+    final reports = <ErrorReport>[];
+    for (final line in lines) {
+      try {
+        reports.add(ErrorReport.fromJson(json.decode(line)));
+      } catch (_) {
+        // Righe non in JSON scritte dalle versioni precedenti
+      }
+    }
+    return reports;
+  }
+
+  // Legge le righe del file di log di un giorno, senza la libreria nativa
+  Future<List<String>> _readLogFile(DateTime date) async {
+    final dateStr = date.toIso8601String().split('T')[0];
+    final logFile = File('${_logDirectory.path}/log_$dateStr.txt');
+
+    if (!await logFile.exists()) {
+      return [];
+    }
+
+    final content = await logFile.readAsString();
+    return content.split('\n').where((line) => line.isNotEmpty).toList();
+  }
+
   // Pulisce i log più vecchi di un certo numero di giorni
   Future<void> cleanOldLogs({int daysToKeep = 30}) async {
     try {
       final files = await _logDirectory.list().toList();
       final cutoffDate = DateTime.now().subtract(Duration(days: daysToKeep));
 
+      // Anche i segmenti compressi (<prefix>_<data>.<n>.txt.lz) con i loro
+      // indici (.txt.idx) e i log degli altri servizi nella stessa directory
+      final logName =
+          RegExp(r'^[a-z]+_(\d{4}-\d{2}-\d{2})[.\d]*\.txt(\.lz|\.idx)?$');
       for (var file in files) {
-        if (file is File && file.path.contains('log_')) {
-          final dateStr = file.path.split('log_')[1].split('.txt')[0];
-          final fileDate = DateTime.parse(dateStr);
+        if (file is! File) continue;
+        final match = logName.firstMatch(file.uri.pathSegments.last);
+        if (match == null) continue;
+        final fileDate = DateTime.parse(match.group(1)!);
 
-          if (fileDate.isBefore(cutoffDate)) {
-            await file.delete();
-          }
+        if (fileDate.isBefore(cutoffDate)) {
+          await file.delete();
         }
       }
     } catch (e) {
@@ -152,6 +234,8 @@ class ErrorReportingService {
 
   // Rilascia le risorse quando non più necessarie
   Future<void> dispose() async {
+    _logger?.close();
+    _logger = null;
     await _errorController.close();
   }
 }
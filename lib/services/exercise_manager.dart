@@ -8,7 +8,9 @@ import '../models/recognition_result.dart';
 import '../services/content_service.dart';
 import '../services/learning_analytics_service.dart';
 import '../models/enums.dart';
+import '../models/level.dart';
 import '../services/audio_service.dart';
+import '../services/native/confusion_model.dart';
 
 /// Gestisce la creazione, esecuzione e tracciamento degli esercizi di lettura.
 /// Si occupa anche del salvataggio dei progressi e della gestione delle sessioni audio.
@@ -30,6 +32,10 @@ class ExerciseManager extends ChangeNotifier {
   bool _isSessionActive = false;
   bool _isInitialized = false;
 
+  // Costi di confusione appresi per il profilo corrente: usati per la
+  // similarità di ogni esercizio e aggiornati dopo ogni tentativo
+  Future<ConfusionModel?>? _confusionModel;
+
   // Statistiche della sessione
   List<double> _sessionAccuracies = [];
   double _overallAccuracy = 0.0;
@@ -51,6 +57,7 @@ class ExerciseManager extends ChangeNotifier {
         _analyticsService = analyticsService {
     debugPrint('[ExerciseManager] Costruttore: Inizializzo ExerciseManager con player: ${player.toJson()}');
     _player = player; // Memorizza l'istanza del player
+    _openConfusionModel();
     _initialize();
   }
 
@@ -58,11 +65,52 @@ class ExerciseManager extends ChangeNotifier {
   void updatePlayer(Player newPlayer) async {
     debugPrint('[ExerciseManager] updatePlayer: Aggiornamento player...');
     _player = newPlayer;  // Aggiorna l'istanza del player
+    _openConfusionModel();
     await _player.loadProgress(); // Carica il progresso dal file
     debugPrint('[ExerciseManager] updatePlayer: Nuovo player = ${_player.toJson()}');
     notifyListeners();
   }
 
+  /// Apre il modello delle confusioni del profilo corrente, rilasciando
+  /// quello del profilo precedente
+  void _openConfusionModel() {
+    final previous = _confusionModel;
+    final profileId = _player.id;
+    _confusionModel = () async {
+      (await previous)?.dispose();
+      return ConfusionModel.openForProfile(profileId);
+    }();
+  }
+
+  /// Calcola la similarità di [result] con i costi di confusione del
+  /// profilo. Il risultato va passato così a [processExerciseResult]; senza
+  /// libreria nativa o testo atteso resta quello del riconoscitore. Per le
+  /// parole del lessico la pronuncia attesa viene letta dal lessico.
+  Future<RecognitionResult> scoreResult(RecognitionResult result) async {
+    final model = await _confusionModel;
+    if (model == null || result.targetText.isEmpty) return result;
+    final lexicon = _contentService.lexicon;
+    final exercise = _currentExercise;
+    final lexiconIndex = exercise != null && exercise.content == result.targetText
+        ? exercise.metadata?['lexiconIndex'] as int?
+        : null;
+    final scored = result.withSimilarity(lexicon != null && lexiconIndex != null
+        ? model.lexiconSimilarity(result.text, lexicon, lexiconIndex)
+        : model.similarity(result.text, result.targetText));
+    debugPrint('[ExerciseManager] scoreResult: similarità del profilo ${scored.similarity} (riconoscitore ${result.similarity})');
+    return scored;
+  }
+
+  /// Aggiorna e salva il modello delle confusioni con il tentativo, dopo
+  /// che è stato valutato: un tentativo non influisce sul proprio punteggio
+  Future<void> _learnFromResult(RecognitionResult result) async {
+    final model = await _confusionModel;
+    if (model == null || result.targetText.isEmpty || result.text.isEmpty) return;
+    final observed = model.learn(result.text, result.targetText);
+    model.save();
+    debugPrint('[ExerciseManager] _learnFromResult: tentativi osservati dal modello: $observed');
+  }
+
   /// Inizializza il manager
   Future<void> _initialize() async {
     debugPrint('[ExerciseManager] _initialize: Inizializzazione avviata.');
@@ -118,21 +166,18 @@ class ExerciseManager extends ChangeNotifier {
     }
 
     String content;
+    int? lexiconIndex;
     ExerciseType exerciseType;
     debugPrint('[ExerciseManager] generateExercise: Livello corrente del giocatore: ${_player.currentLevel}');
 
     switch (_player.currentLevel) {
       case 1:
-        exerciseType = ExerciseType.word;
-        content = _contentService.getRandomWordForLevel(1, _currentDifficulty).text;
-        break;
       case 2:
-        exerciseType = ExerciseType.word;
-        content = _contentService.getRandomWordForLevel(2, _currentDifficulty).text;
-        break;
       case 3:
         exerciseType = ExerciseType.word;
-        content = _contentService.getRandomWordForLevel(3, _currentDifficulty).text;
+        final word = _contentService.getRandomWordForLevel(_player.currentLevel, _currentDifficulty, subLevel: _currentSubLevel());
+        content = word.text;
+        lexiconIndex = word.lexiconIndex;
         break;
       case 4:
         exerciseType = ExerciseType.sentence;
@@ -151,7 +196,9 @@ class ExerciseManager extends ChangeNotifier {
         break;
       default:
         exerciseType = ExerciseType.word;
-        content = _contentService.getRandomWordForLevel(1, _currentDifficulty).text;
+        final word = _contentService.getRandomWordForLevel(1, _currentDifficulty);
+        content = word.text;
+        lexiconIndex = word.lexiconIndex;
     }
 
     debugPrint('[ExerciseManager] generateExercise: Contenuto generato: "$content"');
@@ -168,6 +215,7 @@ class ExerciseManager extends ChangeNotifier {
       metadata: {
         'sessionIndex': _currentSessionIndex,
         'difficulty': _currentDifficulty,
+        if (lexiconIndex != null) 'lexiconIndex': lexiconIndex,
       },
     );
     debugPrint('[ExerciseManager] generateExercise: Esercizio generato: ${_currentExercise!.content}');
@@ -175,8 +223,11 @@ class ExerciseManager extends ChangeNotifier {
     return _currentExercise!;
   }
 
-  /// Processa il risultato di un esercizio
-  Future<int> processExerciseResult(RecognitionResult result) async {
+  /// Processa il risultato di un esercizio, già valutato con [scoreResult]
+  Future<int> processExerciseResult(RecognitionResult scored) async {
+    // Il profilo viene salvato con il tentativo: il ricalcolo dello storico
+    // usa i costi di chi l'ha letto
+    final result = scored.profileId.isEmpty ? scored.withProfile(_player.id) : scored;
     debugPrint('[ExerciseManager] processExerciseResult: Inizio elaborazione del risultato.');
     debugPrint('[ExerciseManager] processExerciseResult: Risultato ricevuto: ${result.toJson()}');
 
@@ -193,9 +244,15 @@ class ExerciseManager extends ChangeNotifier {
     _sessionCrystals += crystals;
     debugPrint('[ExerciseManager] processExerciseResult: Aggiornati i totali - Sessione: $_sessionCrystals, Globale: $_totalCrystals');
 
-    await _analyticsService.addResult(result);
+    await _analyticsService.addResult(
+      result,
+      profileId: _player.id,
+      level: _player.currentLevel,
+    );
     debugPrint('[ExerciseManager] processExerciseResult: Risultato inviato ad Analytics.');
 
+    await _learnFromResult(result);
+
     await _player.saveProgress();
     debugPrint('[ExerciseManager] processExerciseResult: Progresso del giocatore salvato.');
 
@@ -219,6 +276,14 @@ class ExerciseManager extends ChangeNotifier {
     notifyListeners();
   }
 
+  /// Sottolivello corrente del giocatore, come in GameService
+  SubLevel? _currentSubLevel() {
+    final levelIndex = _player.currentLevel - 1;
+    if (levelIndex < 0 || levelIndex >= Level.allLevels.length) return null;
+    final subLevels = Level.allLevels[levelIndex].subLevels;
+    return subLevels[(_player.currentStep ~/ 3).clamp(0, subLevels.length - 1)];
+  }
+
   /// Calcola il numero di sillabe in una parola italiana
   int _countSyllables(String word) {
     final vowels = RegExp('[aeiouAEIOU]');
@@ -293,7 +358,7 @@ class ExerciseManager extends ChangeNotifier {
           : _sessionAccuracies.reduce((a, b) => a + b) / _sessionAccuracies.length;
       debugPrint('[ExerciseManager] _completeSession: Accuratezza complessiva della sessione: $_overallAccuracy');
 
-      await _player.saveProgress();
+      await _player.flushProgress();
       debugPrint('[ExerciseManager] _completeSession: Progresso del giocatore salvato.');
     }
 
@@ -302,6 +367,13 @@ class ExerciseManager extends ChangeNotifier {
     notifyListeners();
   }
 
+  @override
+  void dispose() {
+    _confusionModel?.then((model) => model?.dispose());
+    _confusionModel = null;
+    super.dispose();
+  }
+
   // Getters pubblici
   Exercise? get currentExercise => _currentExercise;
   Difficulty get currentDifficulty => _currentDifficulty;
@@ -5,15 +5,38 @@ import 'package:path_provider/path_provider.dart';
 import 'dart:convert';
 import 'package:path/path.dart' as path;
 import 'package:flutter/foundation.dart';
+import '../config/app_config.dart';
+import 'native/binary_profile.dart';
+import 'native/profile_log.dart';
 
 /// Servizio per la gestione del salvataggio e caricamento dei dati su file.
 /// Implementa il pattern Singleton per garantire una singola istanza del servizio.
+///
+/// Con la libreria nativa i profili sono salvati in un log (`.plog`, vedi
+/// [NativeProfileLog]): ogni salvataggio accoda solo i campi cambiati. Senza
+/// libreria si usa il file JSON `.profile`, riscritto per intero; i file
+/// JSON esistenti vengono importati nel log al primo accesso. A ogni
+/// [flush] il log viene copiato anche nel profilo binario `.pbin`, da cui
+/// il profilo si recupera se il log va perso.
+///
+/// I salvataggi ravvicinati del log vengono raggruppati in una sola
+/// scrittura entro [AppConfig.profileCommitWindow]: [flush] li rende
+/// durevoli subito, a fine sessione e alla chiusura dell'app.
 class FileStorageService {
   // Costanti per la gestione dei file
   static const String _savesDirectoryName = 'saves';
   static const String _profileExtension = '.profile';
+  static const String _profileLogExtension = '.plog';
+  static const String _binaryProfileExtension = '.pbin';
   static const String _tempExtension = '.tmp';
   static const String _backupExtension = '.bak';
+  static const String _confusionExtension = '.confusion';
+  static const String _accuracyExtension = '.accuracy';
+  static const String _contentIndexFileName = 'content_index.state';
+  static const String _analyticsFileName = 'learning_analytics.stats';
+  static const String _attemptLogFileName = 'attempts.log';
+  static const String _sessionJournalFileName = 'training_session.journal';
+  static const String _recordingsDirectoryName = 'recordings';
 
   // Directory base per il salvataggio
   Directory? _baseDirectory;
@@ -21,6 +44,9 @@ class FileStorageService {
   // Variabile di lock per evitare operazioni concorrenti
   bool _writeInProgress = false;
 
+  // Log aperti per profilo; null se la libreria nativa non è disponibile
+  final Map<String, Future<NativeProfileLog?>> _profileLogs = {};
+
   // Implementazione Singleton
   static FileStorageService? _instance;
 
@@ -89,6 +115,109 @@ class FileStorageService {
     return File(path.join(baseDir.path, fileName));
   }
 
+  /// Log del profilo, aperto una sola volta anche con richieste concorrenti
+  Future<NativeProfileLog?> _getProfileLog(String profileId) {
+    return _profileLogs.putIfAbsent(profileId, () => _openProfileLog(profileId));
+  }
+
+  /// Apre il log del profilo importando, se c'è, il vecchio file JSON (o la
+  /// copia binaria, se il log è andato perso)
+  Future<NativeProfileLog?> _openProfileLog(String profileId) async {
+    final profileFile = await _getProfileFile(profileId);
+    final log = NativeProfileLog.open(
+        path.setExtension(profileFile.path, _profileLogExtension),
+        commitWindow: AppConfig.profileCommitWindow);
+    if (log == null || !log.isEmpty) return log;
+
+    final legacyData = await _readProfileJson(profileFile);
+    if (legacyData.isNotEmpty) {
+      if (log.write(legacyData) < 0 || !log.compact()) {
+        debugPrint('Importazione del profilo $profileId nel log non riuscita');
+        log.close();
+        return null;
+      }
+      if (await profileFile.exists()) await profileFile.delete();
+      debugPrint('Profilo $profileId importato nel log');
+    }
+    return log;
+  }
+
+  /// Scrive subito i salvataggi dei profili ancora in attesa e ne aggiorna
+  /// la copia binaria (vedi [exportProfile])
+  Future<void> flush() async {
+    for (final entry in _profileLogs.entries.toList()) {
+      final log = await entry.value;
+      if (log == null) continue;
+      if (!log.flush()) {
+        debugPrint('Scrittura del log del profilo non riuscita');
+      } else if (await exportProfile(entry.key) == null) {
+        debugPrint('Copia binaria del profilo ${entry.key} non riuscita');
+      }
+    }
+  }
+
+  /// Chiude i log aperti del profilo (o di tutti i profili)
+  Future<void> _closeProfileLogs([String? profileId]) async {
+    final ids = profileId != null ? [profileId] : _profileLogs.keys.toList();
+    for (final id in ids) {
+      final log = await _profileLogs.remove(id);
+      log?.close();
+    }
+  }
+
+  /// Percorso del modello delle confusioni appreso per il profilo, salvato
+  /// dalla libreria nativa accanto al file del profilo
+  Future<String> getConfusionModelPath(String profileId) async {
+    final profileFile = await _getProfileFile(profileId);
+    return path.setExtension(profileFile.path, _confusionExtension);
+  }
+
+  /// Percorso dello storico dell'accuratezza del profilo, salvato dalla
+  /// libreria nativa accanto al file del profilo
+  Future<String> getAccuracySeriesPath(String profileId) async {
+    final profileFile = await _getProfileFile(profileId);
+    return path.setExtension(profileFile.path, _accuracyExtension);
+  }
+
+  /// Percorso dello stato dell'indice delle parole (permutazioni e cursori),
+  /// condiviso da tutti i profili come l'elenco delle parole già usate
+  Future<String> getContentIndexStatePath() async {
+    final baseDir = await _baseDir;
+    return path.join(baseDir.path, _contentIndexFileName);
+  }
+
+  /// Percorso delle statistiche di apprendimento aggregate, gestite dalla
+  /// libreria nativa come in LearningAnalyticsService
+  Future<String> getAnalyticsPath() async {
+    final baseDir = await _baseDir;
+    return path.join(baseDir.path, _analyticsFileName);
+  }
+
+  /// Percorso del registro a colonne dei tentativi di tutti i profili; la
+  /// libreria nativa vi affianca i file .tail, .dict, .text e .views
+  Future<String> getAttemptLogPath() async {
+    final baseDir = await _baseDir;
+    return path.join(baseDir.path, _attemptLogFileName);
+  }
+
+  /// Percorso del journal della sessione di allenamento in corso, gestito
+  /// dalla libreria nativa come in TrainingSessionService
+  Future<String> getSessionJournalPath() async {
+    final baseDir = await _baseDir;
+    return path.join(baseDir.path, _sessionJournalFileName);
+  }
+
+  /// Directory dell'archivio delle registrazioni dei tentativi, gestito
+  /// dalla libreria nativa come in AudioService
+  Future<String> getAudioArchiveDirectory() async {
+    final baseDir = await _baseDir;
+    final dir = Directory(path.join(baseDir.path, _recordingsDirectoryName));
+    if (!await dir.exists()) {
+      await dir.create(recursive: true);
+    }
+    return dir.path;
+  }
+
   /// Scrive i dati di un profilo su file con backup di sicurezza
   Future<void> writeProfile(String profileId, Map<String, dynamic> data) async {
     if (profileId.isEmpty) {
@@ -97,6 +226,13 @@ class FileStorageService {
     if (data.isEmpty) {
       throw ArgumentError('I dati del profilo non possono essere vuoti');
     }
+    final log = await _getProfileLog(profileId);
+    if (log != null) {
+      if (log.write(data) < 0) {
+        throw FileSystemException('Scrittura del log del profilo non riuscita', profileId);
+      }
+      return;
+    }
     await _performExclusiveOperation(() async {
       debugPrint('Scrittura profilo $profileId');
       final profileFile = await _getProfileFile(profileId);
@@ -138,6 +274,30 @@ class FileStorageService {
     debugPrint('Lettura profilo $profileId');
     try {
       final profileFile = await _getProfileFile(profileId);
+      final logFile = File(path.setExtension(profileFile.path, _profileLogExtension));
+      final backupFile = File('${profileFile.path}$_backupExtension');
+      final binaryFile = File(path.setExtension(profileFile.path, _binaryProfileExtension));
+      // Aprire il log lo creerebbe: un profilo inesistente resta tale
+      if (!await logFile.exists() &&
+          !await profileFile.exists() &&
+          !await backupFile.exists() &&
+          !await binaryFile.exists()) {
+        debugPrint('Nessun file trovato per il profilo $profileId');
+        return {};
+      }
+      final log = await _getProfileLog(profileId);
+      if (log != null) return log.read();
+      return await _readProfileJson(profileFile);
+    } catch (e) {
+      debugPrint('Errore nella lettura del profilo $profileId: $e');
+      return {};
+    }
+  }
+
+  /// Legge un profilo dal file JSON, o dal suo backup se manca; senza
+  /// nessuno dei due ricorre alla copia binaria scritta da [flush]
+  Future<Map<String, dynamic>> _readProfileJson(File profileFile) async {
+    try {
       final backupFile = File('${profileFile.path}$_backupExtension');
       if (!await profileFile.exists()) {
         if (await backupFile.exists()) {
@@ -145,25 +305,52 @@ class FileStorageService {
           debugPrint('Profilo recuperato dal backup');
           return json.decode(backupData) as Map<String, dynamic>;
         }
-        debugPrint('Nessun file trovato per il profilo $profileId');
-        return {};
+        return _readBinaryProfile(profileFile);
       }
       final jsonString = await profileFile.readAsString();
       final data = json.decode(jsonString) as Map<String, dynamic>;
-      debugPrint('Profilo letto correttamente: $data');
       return data;
     } catch (e) {
-      debugPrint('Errore nella lettura del profilo $profileId: $e');
+      debugPrint('Errore nella lettura di ${profileFile.path}: $e');
       return {};
     }
   }
 
+  /// Legge la copia binaria del profilo, se c'è
+  Map<String, dynamic> _readBinaryProfile(File profileFile) {
+    final binary = NativeBinaryProfile.open(
+        path.setExtension(profileFile.path, _binaryProfileExtension));
+    if (binary == null) return {};
+    try {
+      debugPrint('Profilo recuperato dalla copia binaria');
+      return json.decode(binary.toJson()) as Map<String, dynamic>;
+    } finally {
+      binary.close();
+    }
+  }
+
+  /// Esporta il profilo nel formato binario (`.pbin`, vedi
+  /// [NativeBinaryProfile]), accanto agli altri file del profilo, e ne
+  /// restituisce il percorso. [flush] la aggiorna a ogni fine sessione e
+  /// alla chiusura dell'app: se il log va perso o non è più leggibile, il
+  /// profilo viene recuperato da qui. Restituisce null se il profilo non
+  /// esiste o la libreria nativa non è disponibile.
+  Future<String?> exportProfile(String profileId) async {
+    if (!await profileExists(profileId)) return null;
+    final log = await _getProfileLog(profileId);
+    if (log == null) return null;
+    final profileFile = await _getProfileFile(profileId);
+    final binaryPath = path.setExtension(profileFile.path, _binaryProfileExtension);
+    return log.exportBinary(binaryPath) ? binaryPath : null;
+  }
+
   /// Verifica se un profilo esiste
   Future<bool> profileExists(String profileId) async {
     if (profileId.isEmpty) return false;
     try {
       final profileFile = await _getProfileFile(profileId);
-      final exists = await profileFile.exists();
+      final logFile = File(path.setExtension(profileFile.path, _profileLogExtension));
+      final exists = await logFile.exists() || await profileFile.exists();
       debugPrint('Verifica esistenza profilo $profileId: $exists');
       return exists;
     } catch (e) {
@@ -179,10 +366,15 @@ class FileStorageService {
     }
     debugPrint('Eliminazione profilo $profileId');
     try {
+      await _closeProfileLogs(profileId);
       final profileFile = await _getProfileFile(profileId);
       final tempFile = File('${profileFile.path}$_tempExtension');
       final backupFile = File('${profileFile.path}$_backupExtension');
-      for (final file in [profileFile, tempFile, backupFile]) {
+      final confusionFile = File(path.setExtension(profileFile.path, _confusionExtension));
+      final logFile = File(path.setExtension(profileFile.path, _profileLogExtension));
+      final binaryFile = File(path.setExtension(profileFile.path, _binaryProfileExtension));
+      final accuracyFile = File(path.setExtension(profileFile.path, _accuracyExtension));
+      for (final file in [profileFile, tempFile, backupFile, confusionFile, logFile, binaryFile, accuracyFile]) {
         if (await file.exists()) {
           await file.delete();
           debugPrint('File eliminato: ${file.path}');
@@ -207,11 +399,14 @@ class FileStorageService {
       final files = await baseDir
           .list()
           .where((entity) =>
-      entity is File && path.extension(entity.path) == _profileExtension)
+      entity is File &&
+          (path.extension(entity.path) == _profileExtension ||
+              path.extension(entity.path) == _profileLogExtension ||
+              path.extension(entity.path) == _binaryProfileExtension))
           .map((file) {
-        final fileName = path.basename(file.path);
-        return fileName.replaceFirst('profile_', '').replaceFirst(_profileExtension, '');
-      }).toList();
+        final fileName = path.basenameWithoutExtension(file.path);
+        return fileName.replaceFirst('profile_', '');
+      }).toSet().then((ids) => ids.toList());
       debugPrint('Profili trovati: $files');
       return files;
     } catch (e) {
@@ -224,6 +419,7 @@ class FileStorageService {
   Future<void> deleteAllData() async {
     debugPrint('Eliminazione di tutti i dati');
     try {
+      await _closeProfileLogs();
       final baseDir = await _baseDir;
       if (await baseDir.exists()) {
         await baseDir.delete(recursive: true);
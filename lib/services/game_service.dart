@@ -2,6 +2,7 @@
 
 import 'package:flutter/foundation.dart';
 import 'package:flutter/material.dart';
+import 'package:shared_preferences/shared_preferences.dart';
 import '../models/player.dart';
 import '../models/level.dart';
 import '../models/enums.dart';
@@ -9,6 +10,10 @@ import '../services/content_service.dart';
 import '../services/exercise_manager.dart';
 import '../models/recognition_result.dart';
 import '../services/game_notification_manager.dart';
+import '../services/file_storage_service.dart';
+import '../services/native/accuracy_series.dart';
+import '../services/native/confusion_model.dart';
+import '../services/native/history_rescorer.dart';
 
 class GameService extends ChangeNotifier {
   late Player _player;
@@ -24,7 +29,10 @@ class GameService extends ChangeNotifier {
   static const int baseLoginBonus = 10;
   static const double bonusMultiplierIncrease = 0.5;
 
-  // Stato del gioco e progressione
+  // Stato del gioco e progressione. Lo storico dell'accuratezza sta nella
+  // serie nativa del profilo; le liste servono solo se la libreria nativa
+  // non è disponibile
+  NativeAccuracySeries? _accuracySeries;
   final List<DateTime> _accuracyDates = [];
   final List<double> _accuracyHistory = [];
   int _currentStreak = 0;
@@ -50,6 +58,7 @@ class GameService extends ChangeNotifier {
     _player = newPlayer;
     await _player.loadProgress();
     await _loadGameData();
+    await _rescoreHistoryIfNeeded();
     debugPrint('[GameService] updatePlayer: nuovo player = ${_player.toJson()}');
     notifyListeners();
   }
@@ -58,7 +67,7 @@ class GameService extends ChangeNotifier {
     debugPrint('[GameService] _loadGameData: Avvio caricamento dati di gioco...');
     try {
       final gameData = _player.gameData;
-      debugPrint('[GameService] Dati letti dal profilo: $gameData');
+      debugPrint('[GameService] Campi letti dal profilo: ${gameData.length}');
 
       _averageAccuracy = (gameData['averageAccuracy'] is num)
           ? (gameData['averageAccuracy'] as num).toDouble()
@@ -97,7 +106,8 @@ class GameService extends ChangeNotifier {
       _currentStreak = gameData['currentStreak'] as int? ?? 0;
       debugPrint('[GameService] Current streak: $_currentStreak');
 
-      _updateConsecutiveDays();
+      await _openAccuracySeries();
+      _refreshAccuracy();
       _loadCurrentSubLevel();
       await _saveGameData();
 
@@ -114,6 +124,45 @@ class GameService extends ChangeNotifier {
     }
   }
 
+  /// Apre lo storico nativo dell'accuratezza del profilo corrente. Al primo
+  /// avvio vi importa le liste salvate nei dati di gioco, che da quel
+  /// momento non vengono più scritte nel profilo.
+  Future<void> _openAccuracySeries() async {
+    _accuracySeries?.close();
+    _accuracySeries = null;
+    final seriesPath =
+        await FileStorageService().getAccuracySeriesPath(_player.id);
+    final series =
+        NativeAccuracySeries.open(seriesPath, threshold: requiredAccuracy);
+    if (series == null) return;
+
+    if (series.summary.days == 0 &&
+        _accuracyHistory.isNotEmpty &&
+        !series.assign(_accuracyDates, _accuracyHistory)) {
+      debugPrint('[GameService] Importazione dello storico non riuscita, uso le liste del profilo');
+      series.close();
+      return;
+    }
+    _accuracyDates.clear();
+    _accuracyHistory.clear();
+    _accuracySeries = series;
+    debugPrint('[GameService] Storico accuratezza: ${series.summary.days} giorni');
+  }
+
+  /// Media e giorni consecutivi sopra la soglia: letti dalla serie nativa,
+  /// che li mantiene a ogni risultato, o ricalcolati dalle liste.
+  void _refreshAccuracy() {
+    final series = _accuracySeries;
+    if (series == null) {
+      _updateConsecutiveDays();
+      return;
+    }
+    final summary = series.summary;
+    _averageAccuracy = summary.average;
+    _consecutiveDaysOver75 = summary.streak;
+    debugPrint('[GameService] Media accuracy: $_averageAccuracy, ConsecutiveDaysOver75: $_consecutiveDaysOver75');
+  }
+
   void _loadCurrentSubLevel() {
     final currentLevel = _player.currentLevel;
     final levelIndex = currentLevel - 1;
@@ -135,6 +184,7 @@ class GameService extends ChangeNotifier {
       }
       await _loadGameData();
       await _checkDailyLoginBonus();
+      await _rescoreHistoryIfNeeded();
 
       _isInitialized = true;
       debugPrint('[GameService] Inizializzazione completata.');
@@ -163,8 +213,8 @@ class GameService extends ChangeNotifier {
 
     _dailyBonusGiven = true;
     _lastBonusDate = today;
-    _player.gameData['lastBonusDate'] = today.toIso8601String();
-    _player.gameData['dailyBonusGiven'] = true;
+    _player.setGameValue('lastBonusDate', today.toIso8601String());
+    _player.setGameValue('dailyBonusGiven', true);
 
     await _player.saveProgress();
     debugPrint('[GameService] Bonus giornaliero assegnato.');
@@ -214,6 +264,15 @@ class GameService extends ChangeNotifier {
     final now = DateTime.now();
     debugPrint('[GameService] _updateAccuracy: accuracy=$accuracy, now=$now');
 
+    final series = _accuracySeries;
+    if (series != null) {
+      if (!series.record(now, accuracy)) {
+        debugPrint('[GameService] Registrazione dell\'accuratezza non riuscita');
+      }
+      _refreshAccuracy();
+      return;
+    }
+
     if (_accuracyHistory.isEmpty || !_isSameDay(now, _accuracyDates.last)) {
       _accuracyHistory.add(accuracy);
       _accuracyDates.add(now);
@@ -233,6 +292,58 @@ class GameService extends ChangeNotifier {
     _updateConsecutiveDays();
   }
 
+  /// Ricalcola i tentativi del profilo corrente se i parametri del
+  /// punteggio sono cambiati dal suo ultimo ricalcolo e aggiorna la sua
+  /// accuratezza dei giorni ricalcolati
+  Future<void> _rescoreHistoryIfNeeded() async {
+    // Il modello del profilo viene aperto qui, in sola lettura: quello di
+    // ExerciseManager potrebbe essere ancora del profilo precedente
+    final profileId = _player.id;
+    final model = await ConfusionModel.openForProfile(profileId);
+    try {
+      final rescorer = HistoryRescorer(await SharedPreferences.getInstance());
+      final summary = await rescorer.rescoreIfParametersChanged(
+          profileId: profileId, model: model);
+      if (summary == null || summary.dailyAverages.isEmpty || _player.id != profileId) return;
+      debugPrint('[GameService] _rescoreHistoryIfNeeded: ricalcolati ${summary.rescoredAttempts} tentativi');
+      await applyRescoredAccuracy(summary.dailyAverages);
+    } catch (e) {
+      debugPrint('[GameService] Errore nel ricalcolo dello storico: $e');
+    } finally {
+      model?.dispose();
+    }
+  }
+
+  /// Sostituisce l'accuratezza dei giorni ricalcolati da HistoryRescorer,
+  /// lasciando invariati quelli senza tentativi ricalcolati.
+  Future<void> applyRescoredAccuracy(Map<DateTime, double> dailyAverages) async {
+    final series = _accuracySeries;
+    if (series != null) {
+      if (series.setDays(dailyAverages) <= 0) return;
+      _refreshAccuracy();
+      await _saveGameData();
+      notifyListeners();
+      return;
+    }
+
+    var changed = false;
+    for (int i = 0; i < _accuracyDates.length; i++) {
+      final date = _accuracyDates[i];
+      final rescored = dailyAverages[DateTime(date.year, date.month, date.day)];
+      if (rescored != null) {
+        _accuracyHistory[i] = rescored;
+        changed = true;
+      }
+    }
+    if (!changed) return;
+
+    _averageAccuracy = _accuracyHistory.reduce((a, b) => a + b) / _accuracyHistory.length;
+    debugPrint('[GameService] applyRescoredAccuracy: nuova media accuracy: $_averageAccuracy');
+    _updateConsecutiveDays();
+    await _saveGameData();
+    notifyListeners();
+  }
+
   void _updateConsecutiveDays() {
     _consecutiveDaysOver75 = 0;
     for (int i = _accuracyHistory.length - 1; i >= 0; i--) {
@@ -250,16 +361,21 @@ class GameService extends ChangeNotifier {
     final gameData = Map<String, dynamic>.from(_player.gameData);
 
     gameData['averageAccuracy'] = _averageAccuracy;
-    gameData['accuracyDates'] =
-        _accuracyDates.map((date) => date.toIso8601String()).toList();
-    gameData['accuracyHistory'] = _accuracyHistory;
+    if (_accuracySeries == null) {
+      gameData['accuracyDates'] =
+          _accuracyDates.map((date) => date.toIso8601String()).toList();
+      gameData['accuracyHistory'] = _accuracyHistory;
+    } else {
+      // Lo storico è nel file della serie, aggiornato a ogni risultato
+      gameData.remove('accuracyDates');
+      gameData.remove('accuracyHistory');
+    }
     gameData['currentStreak'] = _currentStreak;
     gameData['dailyBonusGiven'] = _dailyBonusGiven;
     if (_lastBonusDate != null) {
       gameData['lastBonusDate'] = _lastBonusDate!.toIso8601String();
     }
 
-    debugPrint('[GameService] GameData aggiornato: $gameData');
 
     _player.updateGameData(gameData);
     await _player.saveProgress();
@@ -282,7 +398,7 @@ class GameService extends ChangeNotifier {
   Future<void> resetDailyBonus() async {
     debugPrint('[GameService] resetDailyBonus: Reset bonus giornaliero...');
     _dailyBonusGiven = false;
-    _player.gameData['dailyBonusGiven'] = false;
+    _player.setGameValue('dailyBonusGiven', false);
     await _player.saveProgress();
     debugPrint('[GameService] Bonus giornaliero resettato.');
   }
@@ -308,16 +424,20 @@ class GameService extends ChangeNotifier {
   int get currentStreak => _currentStreak;
   bool get hasActiveStreak => _currentStreak >= 3;
   int get consecutiveDaysOver75 => _consecutiveDaysOver75;
-  List<DateTime> get accuracyDates => List.unmodifiable(_accuracyDates);
-  List<double> get accuracyHistory => List.unmodifiable(_accuracyHistory);
+  List<DateTime> get accuracyDates => _accuracySeries == null
+      ? List.unmodifiable(_accuracyDates)
+      : List.unmodifiable(_accuracySeries!.days.map((day) => day.date));
+  List<double> get accuracyHistory => _accuracySeries == null
+      ? List.unmodifiable(_accuracyHistory)
+      : List.unmodifiable(_accuracySeries!.days.map((day) => day.value));
   bool get isDailyBonusAvailable =>
       !_dailyBonusGiven ||
           (_lastBonusDate != null && !_isSameDay(_lastBonusDate!, DateTime.now()));
 
   Map<String, dynamic> exportGameData() {
     return {
-      'accuracyDates': _accuracyDates.map((d) => d.toIso8601String()).toList(),
-      'accuracyHistory': _accuracyHistory,
+      'accuracyDates': accuracyDates.map((d) => d.toIso8601String()).toList(),
+      'accuracyHistory': accuracyHistory,
       'currentStreak': _currentStreak,
       'averageAccuracy': _averageAccuracy,
       'consecutiveDaysOver75': _consecutiveDaysOver75,
@@ -338,6 +458,12 @@ class GameService extends ChangeNotifier {
         ..clear()
         ..addAll((data['accuracyHistory'] as List?)?.map((a) => a as double) ?? []);
 
+      final series = _accuracySeries;
+      if (series != null && series.assign(_accuracyDates, _accuracyHistory)) {
+        _accuracyDates.clear();
+        _accuracyHistory.clear();
+      }
+
       _currentStreak = data['currentStreak'] as int? ?? 0;
       _averageAccuracy = data['averageAccuracy'] as double? ?? 0.0;
       _consecutiveDaysOver75 = data['consecutiveDaysOver75'] as int? ?? 0;
@@ -354,6 +480,7 @@ class GameService extends ChangeNotifier {
 
   Future<void> resetGameData({bool keepProgress = false}) async {
     if (!keepProgress) {
+      _accuracySeries?.assign(const [], const []);
       _accuracyDates.clear();
       _accuracyHistory.clear();
       _currentStreak = 0;
@@ -367,4 +494,11 @@ class GameService extends ChangeNotifier {
     await _saveGameData();
     notifyListeners();
   }
+
+  @override
+  void dispose() {
+    _accuracySeries?.close();
+    _accuracySeries = null;
+    super.dispose();
+  }
 }
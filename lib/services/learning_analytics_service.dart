@@ -1,6 +1,10 @@
 import 'dart:convert';
 import 'package:shared_preferences/shared_preferences.dart';
 import '../models/recognition_result.dart';
+import 'file_storage_service.dart';
+import 'native/analytics_store.dart';
+import 'native/attempt_log.dart';
+import 'native/opendsa_native_bindings.dart';
 
 /// Classe che rappresenta le statistiche di apprendimento dell'utente
 class LearningStats {
@@ -37,31 +41,189 @@ class LearningStats {
   }
 }
 
-/// Servizio per l'analisi e il tracciamento dell'apprendimento
+/// Servizio per l'analisi e il tracciamento dell'apprendimento.
+///
+/// Con la libreria nativa le statistiche (totali e della sessione) sono
+/// aggregate in un file mappato e aggiornate sul posto a ogni risultato;
+/// senza, vengono salvate in JSON in SharedPreferences. Ogni tentativo
+/// viene inoltre accodato al registro a colonne dei tentativi, che conserva
+/// tutta la storia per le interrogazioni di [queryAttempts].
 class LearningAnalyticsService {
   static const String _statsKey = 'learning_stats';
-  static const String _sessionKey = 'current_session';
+  static const String sessionKey = 'current_session';
+  static const String _generalErrorKey = 'error_general';
+
+  // Chiavi di commonErrors per gli errori diagnosticati, nell'ordine di
+  // OpendsaEditKind (l'indice 0 sono i risultati errati)
+  static const List<String> _errorKeys = [
+    _generalErrorKey,
+    'inversion',
+    'confusion',
+    'sequence',
+    'omission',
+    'insertion',
+    'substitution',
+  ];
+
   final SharedPreferences _prefs;
 
   // Stato della sessione corrente
   List<RecognitionResult> _currentSessionResults = [];
   DateTime? _sessionStartTime;
 
-  LearningAnalyticsService(this._prefs);
+  // Statistiche native, aperte al primo uso; null se non disponibili
+  NativeAnalytics? _native;
+  Future<NativeAnalytics?>? _nativeOpening;
+  Future<NativeAttemptLog?>? _attemptLogOpening;
+  NativeAttemptLog? _attempts;
+
+  // Il registro viene aperto subito, così i riepiloghi sono pronti quando
+  // le schermate li leggono
+  LearningAnalyticsService(this._prefs) {
+    _attemptLog();
+  }
 
   /// Inizia una nuova sessione di apprendimento
   void startSession() {
-    _sessionStartTime = DateTime.now();
+    final start = DateTime.now();
+    _sessionStartTime = start;
     _currentSessionResults.clear();
+    _nativeStore().then((store) => store?.startSession(start));
   }
 
-  /// Aggiunge un risultato alla sessione corrente e restituisce Future<void>
-  Future<void> addResult(RecognitionResult result) async {
-    _currentSessionResults.add(result);
-    await _saveCurrentSession();
+  /// Aggiunge un risultato alla sessione corrente e restituisce Future<void>.
+  /// Con [profileId] e [level] il tentativo viene anche accodato al registro
+  /// dei tentativi. Con le statistiche native la sessione è aggiornata sul
+  /// posto e non viene riscritta in JSON: ogni risultato costa lo stesso.
+  Future<void> addResult(RecognitionResult result,
+      {String? profileId, int? level}) async {
+    final store = await _nativeStore();
+    if (store == null) {
+      _currentSessionResults.add(result);
+      await _saveCurrentSession();
+    }
+
+    if (profileId != null && level != null) {
+      (await _attemptLog())?.append(
+        timestamp: result.timestamp,
+        profile: profileId,
+        target: result.targetText,
+        recognized: result.text,
+        level: level,
+        correct: result.isCorrect,
+        similarity: result.similarity,
+        confidence: result.confidence,
+        duration: result.duration,
+      );
+    }
+
+    if (store != null) {
+      store.record(
+        similarity: result.similarity,
+        duration: result.duration,
+        correct: result.isCorrect,
+        recognized: result.isCorrect ? null : result.text,
+        target: result.isCorrect || result.targetText.isEmpty
+            ? null
+            : result.targetText,
+      );
+      return;
+    }
     await _updateStats(result);
   }
 
+  /// Apre le statistiche native; alla prima apertura vi importa quelle
+  /// salvate in SharedPreferences, che vengono poi rimosse.
+  Future<NativeAnalytics?> _nativeStore() {
+    return _nativeOpening ??= () async {
+      final store = NativeAnalytics.open(
+          await FileStorageService().getAnalyticsPath());
+      if (store == null) return null;
+
+      final statsJson = _prefs.getString(_statsKey);
+      if (statsJson != null && store.total.attempts == 0) {
+        final stats = LearningStats.fromJson(json.decode(statsJson));
+        final imported = store.importTotal(
+          attempts: stats.totalAttempts,
+          successes: stats.successfulAttempts,
+          similarityMean: stats.averageSimilarity,
+          timeMean: stats.averageTime,
+          errors: [stats.commonErrors[_generalErrorKey] ?? 0],
+        );
+        if (!imported) {
+          store.close();
+          return null;
+        }
+      }
+      if (statsJson != null) await _prefs.remove(_statsKey);
+      return _native = store;
+    }();
+  }
+
+  Future<NativeAttemptLog?> _attemptLog() {
+    return _attemptLogOpening ??= () async {
+      return _attempts = NativeAttemptLog.open(
+          await FileStorageService().getAttemptLogPath());
+    }();
+  }
+
+  /// Riepilogo materializzato dei tentativi di un profilo a un livello,
+  /// letto in tempo costante; null senza tentativi o senza la libreria
+  /// nativa (o finché il registro non è aperto).
+  NativeAttemptSummary? levelSummary(String profileId, int level) =>
+      _attempts?.levelSummary(profileId, level);
+
+  /// Riepilogo dei tentativi di un profilo nel giorno di [day].
+  NativeAttemptSummary? daySummary(String profileId, DateTime day) =>
+      _attempts?.daySummary(profileId, day);
+
+  /// Interroga la storia completa dei tentativi (vedi
+  /// [NativeAttemptLog.query]). Restituisce null senza la libreria nativa.
+  Future<List<NativeAttemptGroup>?> queryAttempts({
+    DateTime? from,
+    DateTime? to,
+    String? profileId,
+    String? target,
+    int minLevel = 0,
+    int maxLevel = 255,
+    int errors = 0,
+    (String, String)? confusion,
+    int groupBy = OpendsaAttemptGroupBy.none,
+  }) async {
+    final log = await _attemptLog();
+    return log
+        ?.query(
+          from: from,
+          to: to,
+          profile: profileId,
+          target: target,
+          minLevel: minLevel,
+          maxLevel: maxLevel,
+          errors: errors,
+          confusion: confusion,
+          groupBy: groupBy,
+        )
+        .groups;
+  }
+
+  /// Testo atteso o profilo di una chiave dei gruppi per testo o profilo.
+  Future<String?> attemptKeyText(int id) async =>
+      (await _attemptLog())?.string(id);
+
+  LearningStats _fromNative(NativeAnalyticsStats stats) {
+    final commonErrors = <String, int>{};
+    for (var i = 0; i < _errorKeys.length; i++) {
+      if (stats.errors[i] > 0) commonErrors[_errorKeys[i]] = stats.errors[i];
+    }
+    return LearningStats(
+      totalAttempts: stats.attempts,
+      successfulAttempts: stats.successes,
+      averageSimilarity: stats.similarityMean,
+      averageTime: stats.timeMean,
+      commonErrors: commonErrors,
+    );
+  }
+
   /// Salva lo stato della sessione corrente
   Future<void> _saveCurrentSession() async {
     if (_sessionStartTime == null) return;
@@ -71,7 +233,7 @@ class LearningAnalyticsService {
       'results': _currentSessionResults.map((r) => r.toJson()).toList(),
     };
 
-    await _prefs.setString(_sessionKey, json.encode(sessionData));
+    await _prefs.setString(sessionKey, json.encode(sessionData));
   }
 
   /// Aggiorna le statistiche globali con un nuovo risultato
@@ -111,6 +273,9 @@ class LearningAnalyticsService {
   }
 
   Future<LearningStats> getStats() async {
+    final store = await _nativeStore();
+    if (store != null) return _fromNative(store.total);
+
     final statsJson = _prefs.getString(_statsKey);
     if (statsJson == null) {
       return LearningStats(
@@ -130,6 +295,10 @@ class LearningAnalyticsService {
   }
 
   LearningStats getCurrentSessionStats() {
+    final store = _native;
+    if (store != null && _sessionStartTime != null) {
+      return _fromNative(store.session);
+    }
     if (_currentSessionResults.isEmpty) {
       return LearningStats(
         totalAttempts: 0,
@@ -165,8 +334,9 @@ class LearningAnalyticsService {
   }
 
   Future<void> resetStats() async {
+    (await _nativeStore())?.reset();
     await _prefs.remove(_statsKey);
-    await _prefs.remove(_sessionKey);
+    await _prefs.remove(sessionKey);
     _currentSessionResults.clear();
     _sessionStartTime = null;
   }
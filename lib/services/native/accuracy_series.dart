@@ -0,0 +1,174 @@
+// lib/services/native/accuracy_series.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Storico dell'accuratezza di un profilo, un valore per giorno, gestito
+/// dalla libreria nativa.
+///
+/// Sostituisce le liste `accuracyHistory`/`accuracyDates` salvate per intero
+/// nel profilo: ogni risultato accoda pochi byte al file della serie e
+/// media, giorni consecutivi sopra la soglia e media degli ultimi giorni
+/// vengono mantenuti in modo incrementale, quindi leggerli non dipende da
+/// quanti anni di esercizi contiene lo storico.
+class NativeAccuracySeries {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  NativeAccuracySeries._(this._native, this._handle);
+
+  /// Apre o crea la serie in [path]; [threshold] è la soglia dei giorni
+  /// consecutivi ([streak]). Restituisce null se la libreria nativa non è
+  /// disponibile o il file non è una serie valida.
+  static NativeAccuracySeries? open(String path, {double threshold = 0.75}) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) => native.opendsa_accuracy_series_open(
+        path.toNativeUtf8(allocator: arena), threshold));
+    if (handle == nullptr) {
+      debugPrint('NativeAccuracySeries: impossibile aprire $path');
+      return null;
+    }
+    return NativeAccuracySeries._(native, handle);
+  }
+
+  /// Registra un risultato nel giorno di [date]: il primo del giorno ne
+  /// diventa il valore, i successivi ne fanno la media con quello corrente.
+  bool record(DateTime date, double accuracy) {
+    _checkOpen();
+    return _native.opendsa_accuracy_series_record(
+            _handle, _dayOf(date), accuracy) ==
+        0;
+  }
+
+  /// Sostituisce i valori dei giorni già registrati in [values] (ad
+  /// esempio dopo un ricalcolo dello storico) con una sola scrittura; i
+  /// giorni assenti vengono ignorati. Restituisce i giorni sostituiti, -1 in
+  /// caso di errore.
+  int setDays(Map<DateTime, double> values) {
+    _checkOpen();
+    return _withDays(values.keys.toList(), values.values.toList(),
+        _native.opendsa_accuracy_series_set_days);
+  }
+
+  /// Sostituisce l'intera serie con i giorni [dates] e i valori [values],
+  /// con una sola scrittura.
+  bool assign(List<DateTime> dates, List<double> values) {
+    _checkOpen();
+    return _withDays(dates, values, _native.opendsa_accuracy_series_assign) ==
+        0;
+  }
+
+  /// Giorni registrati, giorni consecutivi sopra la soglia fino all'ultimo,
+  /// media dei valori giornalieri e ultimo giorno (null se la serie è
+  /// vuota).
+  ({int days, int streak, double average, DateTime? lastDate, double lastValue})
+      get summary {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAccuracySummary>();
+      _native.opendsa_accuracy_series_summary(_handle, out);
+      return (
+        days: out.ref.days,
+        streak: out.ref.streak,
+        average: out.ref.average,
+        lastDate: out.ref.lastDay < 0 ? null : _dateOf(out.ref.lastDay),
+        lastValue: out.ref.lastValue,
+      );
+    });
+  }
+
+  /// Media degli ultimi [days] giorni registrati.
+  double windowAverage(int days) {
+    _checkOpen();
+    return _native.opendsa_accuracy_series_window_average(_handle, days);
+  }
+
+  /// Aggregazioni per giorno, in ordine di data.
+  List<({DateTime date, int attempts, double value, double mean})> get days {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAccuracyDay>();
+      final result =
+          <({DateTime date, int attempts, double value, double mean})>[];
+      for (var i = 0;
+          _native.opendsa_accuracy_series_day(_handle, i, out) == 0;
+          i++) {
+        result.add((
+          date: _dateOf(out.ref.day),
+          attempts: out.ref.attempts,
+          value: out.ref.value,
+          mean: out.ref.mean,
+        ));
+      }
+      return result;
+    });
+  }
+
+  /// Aggregazioni per settimana (da lunedì), in ordine di data.
+  List<
+      ({
+        DateTime monday,
+        int days,
+        int daysOverThreshold,
+        int attempts,
+        double average,
+      })> get weeks {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAccuracyWeek>();
+      final count = _native.opendsa_accuracy_series_week_count(_handle);
+      return [
+        for (var i = 0; i < count; i++)
+          if (_native.opendsa_accuracy_series_week(_handle, i, out) == 0)
+            (
+              // Il giorno 0 è un giovedì: la settimana 0 parte 3 giorni prima
+              monday: _dateOf(out.ref.week * 7 - 3),
+              days: out.ref.days,
+              daysOverThreshold: out.ref.daysOverThreshold,
+              attempts: out.ref.attempts,
+              average: out.ref.average,
+            ),
+      ];
+    });
+  }
+
+  /// Chiude il file. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_accuracy_series_close(_handle);
+    _handle = nullptr;
+  }
+
+  int _withDays(List<DateTime> dates, List<double> values,
+      opendsa_accuracy_series_days_dart function) {
+    final count = dates.length < values.length ? dates.length : values.length;
+    return using((arena) {
+      final days = arena<Int32>(count == 0 ? 1 : count);
+      final numbers = arena<Double>(count == 0 ? 1 : count);
+      for (var i = 0; i < count; i++) {
+        days[i] = _dayOf(dates[i]);
+        numbers[i] = values[i];
+      }
+      return function(_handle, days, numbers, count);
+    });
+  }
+
+  // Giorni dall'1/1/1970 della data locale di [date]
+  static int _dayOf(DateTime date) =>
+      DateTime.utc(date.year, date.month, date.day).millisecondsSinceEpoch ~/
+      Duration.millisecondsPerDay;
+
+  static DateTime _dateOf(int day) {
+    final utc = DateTime.utc(1970, 1, 1 + day);
+    return DateTime(utc.year, utc.month, utc.day);
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeAccuracySeries già chiuso');
+    }
+  }
+}
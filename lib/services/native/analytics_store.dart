@@ -0,0 +1,172 @@
+// lib/services/native/analytics_store.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Statistiche aggregate di un ambito (totale o sessione corrente).
+/// [errors] ha all'indice 0 i risultati errati e agli indici
+/// [OpendsaEditKind] gli errori di lettura diagnosticati; [similarityBuckets]
+/// conta i risultati per similarità a intervalli di 0.1.
+typedef NativeAnalyticsStats = ({
+  int attempts,
+  int successes,
+  double similarityMean,
+  double similarityStddev,
+  double similarityMin,
+  double similarityMax,
+  double timeMean,
+  double timeStddev,
+  List<int> errors,
+  List<int> similarityBuckets,
+});
+
+/// Statistiche di apprendimento mantenute dalla libreria nativa in un file
+/// a layout fisso mappato in memoria.
+///
+/// Ogni risultato aggiorna sul posto totale e sessione (tentativi, successi,
+/// media e deviazione standard di similarità e tempi, istogrammi) con un
+/// lavoro costante, invece di decodificare e ricodificare il JSON delle
+/// statistiche in SharedPreferences.
+class NativeAnalytics {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  NativeAnalytics._(this._native, this._handle);
+
+  /// Apre o crea le statistiche in [path]. Restituisce null se la libreria
+  /// nativa non è disponibile o il file non è valido.
+  static NativeAnalytics? open(String path) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) =>
+        native.opendsa_analytics_open(path.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('NativeAnalytics: impossibile aprire $path');
+      return null;
+    }
+    return NativeAnalytics._(native, handle);
+  }
+
+  /// Aggiunge un risultato. Per un risultato errato con [recognized] e
+  /// [target] gli errori di lettura vengono diagnosticati e contati per
+  /// tipo.
+  bool record({
+    required double similarity,
+    required Duration duration,
+    required bool correct,
+    String? recognized,
+    String? target,
+  }) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_analytics_record(
+              _handle,
+              similarity,
+              duration.inMilliseconds,
+              correct ? 1 : 0,
+              recognized?.toNativeUtf8(allocator: arena) ?? nullptr,
+              target?.toNativeUtf8(allocator: arena) ?? nullptr,
+            ) ==
+        0);
+  }
+
+  /// Azzera le statistiche della sessione e ne registra l'inizio.
+  bool startSession(DateTime start) {
+    _checkOpen();
+    return _native.opendsa_analytics_start_session(
+            _handle, start.millisecondsSinceEpoch) ==
+        0;
+  }
+
+  /// Inizio della sessione corrente, null se non ce n'è una.
+  DateTime? get sessionStart {
+    _checkOpen();
+    final start = _native.opendsa_analytics_session_start(_handle);
+    return start == 0 ? null : DateTime.fromMillisecondsSinceEpoch(start);
+  }
+
+  NativeAnalyticsStats get total => _stats(OpendsaAnalyticsScope.total);
+
+  NativeAnalyticsStats get session => _stats(OpendsaAnalyticsScope.session);
+
+  /// Sostituisce il totale con medie e conteggi già calcolati, ad esempio
+  /// quelli salvati prima delle statistiche native.
+  bool importTotal({
+    required int attempts,
+    required int successes,
+    required double similarityMean,
+    required double timeMean,
+    List<int> errors = const [],
+  }) {
+    _checkOpen();
+    return using((arena) {
+      final stats = arena<OpendsaAnalyticsStats>();
+      stats.ref
+        ..attempts = attempts
+        ..successes = successes
+        ..similarityMean = similarityMean
+        ..similarityMin = 0
+        ..similarityMax = 0
+        ..timeMean = timeMean;
+      for (var i = 0;
+          i < errors.length && i < OpendsaAnalyticsScope.errorKinds;
+          i++) {
+        stats.ref.errors[i] = errors[i];
+      }
+      return _native.opendsa_analytics_import(_handle, stats) == 0;
+    });
+  }
+
+  /// Azzera totale e sessione.
+  bool reset() {
+    _checkOpen();
+    return _native.opendsa_analytics_reset(_handle) == 0;
+  }
+
+  /// Scrive subito su disco le statistiche.
+  bool flush() {
+    _checkOpen();
+    return _native.opendsa_analytics_flush(_handle) == 0;
+  }
+
+  /// Chiude il file. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_analytics_close(_handle);
+    _handle = nullptr;
+  }
+
+  NativeAnalyticsStats _stats(int scope) {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAnalyticsStats>();
+      _native.opendsa_analytics_stats(_handle, scope, out);
+      final stats = out.ref;
+      return (
+        attempts: stats.attempts,
+        successes: stats.successes,
+        similarityMean: stats.similarityMean,
+        similarityStddev: stats.similarityStddev,
+        similarityMin: stats.similarityMin,
+        similarityMax: stats.similarityMax,
+        timeMean: stats.timeMean,
+        timeStddev: stats.timeStddev,
+        errors: [
+          for (var i = 0; i < OpendsaAnalyticsScope.errorKinds; i++)
+            stats.errors[i],
+        ],
+        similarityBuckets: [
+          for (var i = 0; i < OpendsaAnalyticsScope.similarityBuckets; i++)
+            stats.similarityBuckets[i],
+        ],
+      );
+    });
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeAnalytics già chiuso');
+    }
+  }
+}
@@ -0,0 +1,233 @@
+// lib/services/native/attempt_log.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Un gruppo del risultato di [NativeAttemptLog.query]. [key] dipende dal
+/// raggruppamento: giorno o settimana dall'epoca, livello, o id di testo o
+/// profilo (vedi [NativeAttemptLog.string]).
+typedef NativeAttemptGroup = ({
+  int key,
+  int attempts,
+  int correct,
+  double similarityMean,
+  double durationMeanMs,
+});
+
+/// Quanto dei dati ha letto un'interrogazione.
+typedef NativeAttemptQueryStats = ({
+  int chunks,
+  int chunksScanned,
+  int rowsScanned,
+  int rowsMatched,
+  int columnsRead,
+});
+
+/// Riepilogo materializzato dei tentativi di un livello o di un giorno.
+/// [errors] ha all'indice 0 i tentativi errati e agli indici
+/// [OpendsaEditKind] quelli con quell'errore di lettura.
+typedef NativeAttemptSummary = ({
+  int attempts,
+  int correct,
+  double accuracy,
+  double similarityMean,
+  double durationMeanMs,
+  DateTime first,
+  DateTime last,
+  int days,
+  List<int> errors,
+});
+
+/// Registro a colonne di tutti i tentativi di lettura, mantenuto dalla
+/// libreria nativa senza limite di storia.
+///
+/// Le interrogazioni (ad esempio l'accuratezza settimanale sulle parole del
+/// livello 2 con confusioni b/d) leggono solo le colonne che servono e
+/// saltano i blocchi di righe esclusi dai filtri, invece di decodificare
+/// tutta la cronologia delle sessioni. I riepiloghi per livello e per
+/// giorno sono mantenuti dalla libreria a ogni tentativo e si leggono in
+/// tempo costante.
+class NativeAttemptLog {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  NativeAttemptLog._(this._native, this._handle);
+
+  /// Apre o crea il registro in [path]. Restituisce null se la libreria
+  /// nativa non è disponibile o i file non sono validi.
+  static NativeAttemptLog? open(String path) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) =>
+        native.opendsa_attempt_log_open(path.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('NativeAttemptLog: impossibile aprire $path');
+      return null;
+    }
+    return NativeAttemptLog._(native, handle);
+  }
+
+  /// Accoda un tentativo. Per un tentativo errato gli errori di lettura
+  /// vengono diagnosticati confrontando [recognized] e [target].
+  bool append({
+    required DateTime timestamp,
+    required String profile,
+    required String target,
+    required String recognized,
+    required int level,
+    required bool correct,
+    required double similarity,
+    required double confidence,
+    required Duration duration,
+  }) {
+    _checkOpen();
+    return using((arena) {
+      final attempt = arena<OpendsaAttempt>();
+      attempt.ref
+        ..timestampMs = timestamp.millisecondsSinceEpoch
+        ..profile = profile.toNativeUtf8(allocator: arena)
+        ..target = target.toNativeUtf8(allocator: arena)
+        ..recognized = recognized.toNativeUtf8(allocator: arena)
+        ..level = level
+        ..correct = correct ? 1 : 0
+        ..similarity = similarity
+        ..confidence = confidence
+        ..durationMs = duration.inMilliseconds
+        ..utcOffsetMinutes = timestamp.timeZoneOffset.inMinutes;
+      return _native.opendsa_attempt_log_append(_handle, attempt) == 0;
+    });
+  }
+
+  /// Aggrega i tentativi che soddisfano tutti i filtri indicati.
+  ///
+  /// [errors] seleziona i tentativi con almeno uno dei bit indicati
+  /// ([OpendsaAttemptGroupBy.incorrect] o `1 << OpendsaEditKind.*`);
+  /// [confusion] quelli con una confusione fra le due lettere, in un verso o
+  /// nell'altro (ad esempio `('b', 'd')`). [groupBy] è uno dei valori di
+  /// [OpendsaAttemptGroupBy]; giorni e settimane seguono il fuso orario
+  /// in cui è stato fatto ogni tentativo.
+  ({List<NativeAttemptGroup> groups, NativeAttemptQueryStats stats}) query({
+    DateTime? from,
+    DateTime? to,
+    String? profile,
+    String? target,
+    int minLevel = 0,
+    int maxLevel = 255,
+    int errors = 0,
+    (String, String)? confusion,
+    int groupBy = OpendsaAttemptGroupBy.none,
+  }) {
+    _checkOpen();
+    return using((arena) {
+      final query = arena<OpendsaAttemptQuery>();
+      query.ref
+        ..fromMs = from?.millisecondsSinceEpoch ?? 0
+        ..toMs = to?.millisecondsSinceEpoch ?? 0x7fffffffffffffff
+        ..profile = profile?.toNativeUtf8(allocator: arena) ?? nullptr
+        ..target = target?.toNativeUtf8(allocator: arena) ?? nullptr
+        ..minLevel = minLevel
+        ..maxLevel = maxLevel
+        ..errors = errors
+        ..confusionA = confusion?.$1.toLowerCase().runes.first ?? 0
+        ..confusionB = confusion?.$2.toLowerCase().runes.first ?? 0
+        ..groupBy = groupBy;
+      final stats = arena<OpendsaAttemptQueryStats>();
+      final count = _native.opendsa_attempt_log_query(_handle, query, stats);
+      final group = arena<OpendsaAttemptGroup>();
+      final groups = <NativeAttemptGroup>[];
+      for (var i = 0; i < count; i++) {
+        if (_native.opendsa_attempt_log_group(_handle, i, group) != 0) break;
+        final g = group.ref;
+        groups.add((
+          key: g.key,
+          attempts: g.attempts,
+          correct: g.correct,
+          similarityMean: g.similarityMean,
+          durationMeanMs: g.durationMeanMs,
+        ));
+      }
+      final s = stats.ref;
+      return (
+        groups: groups,
+        stats: (
+          chunks: s.chunks,
+          chunksScanned: s.chunksScanned,
+          rowsScanned: s.rowsScanned,
+          rowsMatched: s.rowsMatched,
+          columnsRead: s.columnsRead,
+        ),
+      );
+    });
+  }
+
+  /// Riepilogo dei tentativi di [profile] al livello [level], null se non
+  /// ce ne sono.
+  NativeAttemptSummary? levelSummary(String profile, int level) => _summary(
+      profile, level, _native.opendsa_attempt_log_level_summary);
+
+  /// Riepilogo dei tentativi di [profile] nel giorno locale di [day], null
+  /// se non ce ne sono.
+  NativeAttemptSummary? daySummary(String profile, DateTime day) => _summary(
+      profile, dayOf(day), _native.opendsa_attempt_log_day_summary);
+
+  /// Giorno locale di [time] in giorni dall'epoca, come i riepiloghi nativi.
+  static int dayOf(DateTime time) {
+    final local = time.millisecondsSinceEpoch +
+        time.timeZoneOffset.inMilliseconds;
+    return (local / Duration.millisecondsPerDay).floor();
+  }
+
+  /// Testo o profilo con id [id], la chiave dei gruppi per testo o profilo.
+  String? string(int id) {
+    _checkOpen();
+    final text = _native.opendsa_attempt_log_string(_handle, id);
+    return text == nullptr ? null : text.toDartString();
+  }
+
+  /// Numero di tentativi registrati.
+  int get length {
+    _checkOpen();
+    return _native.opendsa_attempt_log_size(_handle);
+  }
+
+  /// Chiude il registro. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_attempt_log_close(_handle);
+    _handle = nullptr;
+  }
+
+  NativeAttemptSummary? _summary(String profile, int key,
+      opendsa_attempt_log_summary_dart lookup) {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAttemptSummary>();
+      final found =
+          lookup(_handle, profile.toNativeUtf8(allocator: arena), key, out);
+      if (found != 1) return null;
+      final summary = out.ref;
+      return (
+        attempts: summary.attempts,
+        correct: summary.correct,
+        accuracy: summary.accuracy,
+        similarityMean: summary.similarityMean,
+        durationMeanMs: summary.durationMeanMs,
+        first: DateTime.fromMillisecondsSinceEpoch(summary.firstMs),
+        last: DateTime.fromMillisecondsSinceEpoch(summary.lastMs),
+        days: summary.days,
+        errors: [
+          for (var i = 0; i < OpendsaAnalyticsScope.errorKinds; i++)
+            summary.errors[i],
+        ],
+      );
+    });
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeAttemptLog già chiuso');
+    }
+  }
+}
@@ -0,0 +1,197 @@
+// lib/services/native/audio_archive.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Una registrazione archiviata.
+typedef NativeAudioClip = ({
+  int id,
+  String profileId,
+  String target,
+  DateTime recordedAt,
+  DateTime accessedAt,
+  Duration duration,
+  int storedBytes,
+});
+
+/// Archivio delle registrazioni dei tentativi, gestito dalla libreria
+/// nativa.
+///
+/// Ogni registrazione viene codificata senza perdita (predizione lineare e
+/// codice di Rice, circa metà dello spazio del WAV) e indicizzata per
+/// profilo, testo atteso e istante. Dopo ogni aggiunta l'archivio rimuove
+/// le clip più vecchie di [maxAge] e, oltre [maxBytes], quelle ascoltate o
+/// registrate meno di recente. [exportWav] ricostruisce il WAV da
+/// riascoltare.
+class NativeAudioArchive {
+  static const Duration _pollInterval = Duration(milliseconds: 20);
+
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  // Aggiunte in background non ancora terminate
+  final Set<Pointer<Void>> _jobs = {};
+
+  NativeAudioArchive._(this._native, this._handle);
+
+  /// Apre o crea l'archivio in [directory], che deve esistere. Restituisce
+  /// null se la libreria nativa non è disponibile o l'archivio non è
+  /// valido.
+  static NativeAudioArchive? open(
+    String directory, {
+    required int maxBytes,
+    required Duration maxAge,
+  }) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) {
+      final options = arena<OpendsaAudioArchiveOptions>();
+      options.ref
+        ..maxBytes = maxBytes
+        ..maxAgeMs = maxAge.inMilliseconds;
+      return native.opendsa_audio_archive_open(
+          directory.toNativeUtf8(allocator: arena), options);
+    });
+    if (handle == nullptr) {
+      debugPrint('NativeAudioArchive: impossibile aprire $directory');
+      return null;
+    }
+    return NativeAudioArchive._(native, handle);
+  }
+
+  /// Archivia il WAV in [wavPath] registrato da [profileId] leggendo
+  /// [target]. Restituisce l'id della clip, null in caso di errore.
+  int? addWav(
+    String wavPath, {
+    required String profileId,
+    required String target,
+    DateTime? recordedAt,
+  }) {
+    _checkOpen();
+    final id = using((arena) => _native.opendsa_audio_archive_add_wav(
+          _handle,
+          wavPath.toNativeUtf8(allocator: arena),
+          profileId.toNativeUtf8(allocator: arena),
+          target.toNativeUtf8(allocator: arena),
+          (recordedAt ?? DateTime.now()).millisecondsSinceEpoch,
+        ));
+    return id < 0 ? null : id;
+  }
+
+  /// Come [addWav], ma la codifica e il salvataggio avvengono su un thread
+  /// della libreria nativa: l'isolate dell'interfaccia attende solo il
+  /// risultato. [wavPath] deve restare al suo posto fino al completamento.
+  Future<int?> addWavInBackground(
+    String wavPath, {
+    required String profileId,
+    required String target,
+    DateTime? recordedAt,
+  }) async {
+    _checkOpen();
+    final job = using((arena) => _native.opendsa_audio_archive_add_wav_start(
+          _handle,
+          wavPath.toNativeUtf8(allocator: arena),
+          profileId.toNativeUtf8(allocator: arena),
+          target.toNativeUtf8(allocator: arena),
+          (recordedAt ?? DateTime.now()).millisecondsSinceEpoch,
+        ));
+    if (job == nullptr) return null;
+    _jobs.add(job);
+    while (_native.opendsa_audio_archive_add_done(job) == 0) {
+      await Future.delayed(_pollInterval);
+      // Liberato da close, che ne ha atteso la fine
+      if (!_jobs.contains(job)) return null;
+    }
+    if (!_jobs.remove(job)) return null;
+    final id = _native.opendsa_audio_archive_add_wait(job);
+    _native.opendsa_audio_archive_add_free(job);
+    return id < 0 ? null : id;
+  }
+
+  /// Clip di [profileId] e [target] (tutti se null), dalla più recente.
+  List<NativeAudioClip> clips({String? profileId, String? target}) {
+    _checkOpen();
+    return using((arena) {
+      final count = _native.opendsa_audio_archive_list(
+        _handle,
+        profileId == null ? nullptr : profileId.toNativeUtf8(allocator: arena),
+        target == null ? nullptr : target.toNativeUtf8(allocator: arena),
+      );
+      final out = arena<OpendsaAudioClip>();
+      final clips = <NativeAudioClip>[];
+      for (var i = 0; i < count; i++) {
+        if (_native.opendsa_audio_archive_clip(_handle, i, out) != 0) break;
+        clips.add((
+          id: out.ref.id,
+          profileId: out.ref.profile.toDartString(),
+          target: out.ref.target.toDartString(),
+          recordedAt: DateTime.fromMillisecondsSinceEpoch(out.ref.recordedMs),
+          accessedAt: DateTime.fromMillisecondsSinceEpoch(out.ref.accessedMs),
+          duration: Duration(milliseconds: out.ref.durationMs),
+          storedBytes: out.ref.storedBytes,
+        ));
+      }
+      return clips;
+    });
+  }
+
+  /// Ricostruisce la clip [id] come WAV in [wavPath] per riascoltarla.
+  bool exportWav(int id, String wavPath) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_audio_archive_export_wav(
+              _handle,
+              id,
+              DateTime.now().millisecondsSinceEpoch,
+              wavPath.toNativeUtf8(allocator: arena),
+            )) ==
+        0;
+  }
+
+  bool remove(int id) {
+    _checkOpen();
+    return _native.opendsa_audio_archive_remove(_handle, id) == 0;
+  }
+
+  /// Applica i limiti di età e di spazio; restituisce le clip rimosse.
+  int evict() {
+    _checkOpen();
+    return _native.opendsa_audio_archive_evict(
+        _handle, DateTime.now().millisecondsSinceEpoch);
+  }
+
+  /// Clip archiviate, spazio occupato e quello che occuperebbero come WAV,
+  /// clip rimosse dai limiti.
+  ({int clips, int storedBytes, int rawBytes, int evicted}) get stats {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaAudioArchiveStats>();
+      _native.opendsa_audio_archive_stats(_handle, out);
+      return (
+        clips: out.ref.clips,
+        storedBytes: out.ref.storedBytes,
+        rawBytes: out.ref.rawBytes,
+        evicted: out.ref.evicted,
+      );
+    });
+  }
+
+  /// Salva gli ascolti e chiude l'archivio, attendendo prima le aggiunte
+  /// in background. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    for (final job in _jobs) {
+      _native.opendsa_audio_archive_add_free(job);
+    }
+    _jobs.clear();
+    _native.opendsa_audio_archive_close(_handle);
+    _handle = nullptr;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeAudioArchive già chiuso');
+    }
+  }
+}
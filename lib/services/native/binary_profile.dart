@@ -0,0 +1,151 @@
+// lib/services/native/binary_profile.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Profilo in formato binario (`.pbin`) mappato in memoria dalla libreria
+/// nativa.
+///
+/// A differenza del file JSON, un campo si legge senza decodificare il
+/// resto: [operator []] converte in oggetti Dart solo il valore richiesto e
+/// [elementAt] legge un singolo elemento di un vettore come `usedWords`.
+/// [importJson] e [toJson] convertono senza perdite da e verso il JSON dei
+/// file `.profile`.
+class NativeBinaryProfile {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+  final int _root;
+
+  NativeBinaryProfile._(this._native, this._handle)
+      : _root = _native.opendsa_binary_profile_root(_handle);
+
+  /// Converte il JSON [json] in un profilo binario scritto in [path].
+  /// Restituisce false se la libreria nativa non è disponibile, il JSON non
+  /// è valido o il file non è scrivibile.
+  static bool importJson(String json, String path) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return false;
+    return using((arena) {
+      final bytes = utf8.encode(json);
+      final buffer = arena<Uint8>(bytes.length);
+      buffer.asTypedList(bytes.length).setAll(0, bytes);
+      return native.opendsa_binary_profile_import(buffer.cast<Utf8>(),
+              bytes.length, path.toNativeUtf8(allocator: arena)) ==
+          0;
+    });
+  }
+
+  /// Mappa il profilo in [path]. Restituisce null se la libreria nativa non
+  /// è disponibile o il file manca o non è valido.
+  static NativeBinaryProfile? open(String path) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) =>
+        native.opendsa_binary_profile_open(path.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('NativeBinaryProfile: impossibile aprire $path');
+      return null;
+    }
+    return NativeBinaryProfile._(native, handle);
+  }
+
+  /// Vero se il profilo contiene il campo [key].
+  bool containsKey(String key) => _find(key) >= 0;
+
+  /// Valore del campo [key] convertito in oggetti Dart (come json.decode),
+  /// null se assente.
+  dynamic operator [](String key) {
+    final node = _find(key);
+    if (node < 0) return null;
+    return using((arena) => _decode(node, arena<OpendsaProfileValue>()));
+  }
+
+  /// Numero di elementi del vettore [key], 0 se assente o non è un vettore.
+  int lengthOf(String key) {
+    final node = _find(key);
+    if (node < 0) return 0;
+    return using((arena) {
+      final value = arena<OpendsaProfileValue>();
+      _native.opendsa_binary_profile_node(_handle, node, value);
+      return value.ref.type == OpendsaValueType.array ? value.ref.count : 0;
+    });
+  }
+
+  /// Elemento [index] del vettore [key], null se assente.
+  dynamic elementAt(String key, int index) {
+    final node = _find(key);
+    if (node < 0) return null;
+    final element =
+        _native.opendsa_binary_profile_element(_handle, node, index);
+    if (element < 0) return null;
+    return using((arena) => _decode(element, arena<OpendsaProfileValue>()));
+  }
+
+  /// Intero profilo in JSON, con le chiavi degli oggetti in ordine.
+  String toJson() {
+    _checkOpen();
+    return using((arena) {
+      final length = arena<Int32>();
+      final json = _native.opendsa_binary_profile_to_json(_handle, -1, length);
+      return utf8.decode(json.cast<Uint8>().asTypedList(length.value));
+    });
+  }
+
+  /// Rilascia la mappatura. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_binary_profile_close(_handle);
+    _handle = nullptr;
+  }
+
+  int _find(String key) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_binary_profile_find(
+        _handle, _root, key.toNativeUtf8(allocator: arena)));
+  }
+
+  dynamic _decode(int node, Pointer<OpendsaProfileValue> value) {
+    if (_native.opendsa_binary_profile_node(_handle, node, value) != 0) {
+      return null;
+    }
+    final count = value.ref.count;
+    switch (value.ref.type) {
+      case OpendsaValueType.falseValue:
+        return false;
+      case OpendsaValueType.trueValue:
+        return true;
+      case OpendsaValueType.integer:
+        return value.ref.integer;
+      case OpendsaValueType.decimal:
+        return value.ref.number;
+      case OpendsaValueType.string:
+        return utf8.decode(value.ref.string.cast<Uint8>().asTypedList(count));
+      case OpendsaValueType.array:
+        return [
+          for (var i = 0; i < count; i++)
+            _decode(
+                _native.opendsa_binary_profile_element(_handle, node, i), value),
+        ];
+      case OpendsaValueType.object:
+        final result = <String, dynamic>{};
+        for (var i = 0; i < count; i++) {
+          final key = _decode(
+              _native.opendsa_binary_profile_member_key(_handle, node, i), value);
+          result[key as String] = _decode(
+              _native.opendsa_binary_profile_member_value(_handle, node, i), value);
+        }
+        return result;
+      default:
+        return null;
+    }
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeBinaryProfile già chiuso');
+    }
+  }
+}
@@ -0,0 +1,100 @@
+// lib/services/native/confusion_model.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import '../file_storage_service.dart';
+import 'lexicon.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Costi di confusione appresi per un singolo profilo.
+///
+/// Il modello vive nella libreria nativa: ogni tentativo aggiorna in modo
+/// incrementale la matrice 64x64 dei costi, che viene poi usata direttamente
+/// dal calcolo della similarità del profilo. Il file è salvato accanto al
+/// profilo con estensione `.confusion`.
+class ConfusionModel {
+  final OpenDsaNativeLibrary _native;
+  final String _path;
+  Pointer<Void> _handle;
+
+  ConfusionModel._(this._native, this._path, this._handle);
+
+  /// Apre il modello del profilo, creandolo vuoto se non esiste.
+  /// Restituisce null se la libreria nativa non è disponibile.
+  static Future<ConfusionModel?> openForProfile(String profileId) async {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final modelPath = await FileStorageService().getConfusionModelPath(profileId);
+    var handle = using((arena) =>
+        native.opendsa_confusion_model_open(modelPath.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('ConfusionModel: file $modelPath non valido, riparto da un modello vuoto');
+      handle = native.opendsa_confusion_model_open(nullptr);
+    }
+    return ConfusionModel._(native, modelPath, handle);
+  }
+
+  /// Similarità personalizzata con i costi appresi del profilo.
+  double similarity(String recognized, String target) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_similarity_with_model(
+      recognized.toNativeUtf8(allocator: arena),
+      target.toNativeUtf8(allocator: arena),
+      _handle,
+    ));
+  }
+
+  /// Come [similarity], con testo atteso la voce [index] di [lexicon]: la
+  /// pronuncia viene letta dal lessico invece di essere ricalcolata.
+  double lexiconSimilarity(String recognized, NativeLexicon lexicon, int index) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_lexicon_similarity(
+      lexicon.handle,
+      index,
+      recognized.toNativeUtf8(allocator: arena),
+      _handle,
+    ));
+  }
+
+  /// Aggiorna il modello con l'allineamento di un tentativo.
+  /// Restituisce il numero di tentativi osservati finora.
+  int learn(String recognized, String target) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_confusion_model_observe(
+      _handle,
+      recognized.toNativeUtf8(allocator: arena),
+      target.toNativeUtf8(allocator: arena),
+    ));
+  }
+
+  /// Salva il modello accanto al file del profilo.
+  bool save() {
+    _checkOpen();
+    final result = using((arena) => _native.opendsa_confusion_model_save(
+      _handle,
+      _path.toNativeUtf8(allocator: arena),
+    ));
+    if (result != 0) {
+      debugPrint('ConfusionModel: errore nel salvataggio di $_path');
+    }
+    return result == 0;
+  }
+
+  /// Rilascia il modello nativo. L'istanza non è più utilizzabile.
+  void dispose() {
+    if (_handle == nullptr) return;
+    _native.opendsa_confusion_model_free(_handle);
+    _handle = nullptr;
+  }
+
+  /// Puntatore nativo, per le API che accettano un modello opzionale.
+  Pointer<Void> get handle => _handle;
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('ConfusionModel già rilasciato');
+    }
+  }
+}
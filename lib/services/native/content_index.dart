@@ -0,0 +1,110 @@
+// lib/services/native/content_index.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import '../../models/enums.dart';
+import 'lexicon.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Indice nativo delle parole del lessico per (livello, difficoltà, sillabe,
+/// lunghezza).
+///
+/// Ogni gruppo di parole è una permutazione casuale con un cursore: la
+/// prossima parola non ancora proposta si ottiene in tempo costante, senza
+/// filtrare né copiare liste. Permutazioni e cursori vengono salvati, così le
+/// parole non si ripetono neanche fra un avvio e l'altro.
+class NativeContentIndex {
+  final OpenDsaNativeLibrary _native;
+  final String? _statePath;
+  Pointer<Void> _handle;
+  final Pointer<OpendsaWordQuery> _query = calloc<OpendsaWordQuery>();
+
+  NativeContentIndex._(this._native, this._statePath, this._handle);
+
+  /// Costruisce l'indice per [lexicon] e ripristina lo stato salvato in
+  /// [statePath], se compatibile con il lessico corrente.
+  static NativeContentIndex? open(NativeLexicon lexicon, {String? statePath}) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final seed = DateTime.now().microsecondsSinceEpoch;
+    final handle = using((arena) => native.opendsa_content_index_open(
+      lexicon.handle,
+      statePath?.toNativeUtf8(allocator: arena) ?? nullptr,
+      seed,
+    ));
+    if (handle == nullptr) return null;
+    return NativeContentIndex._(native, statePath, handle);
+  }
+
+  /// Indice nel lessico della prossima parola compatibile, o null se nessuna
+  /// parola rispetta i vincoli. I limiti null non vengono applicati.
+  int? next({
+    required int level,
+    Difficulty? difficulty,
+    int? minSyllables,
+    int? maxSyllables,
+    int? minLength,
+    int? maxLength,
+  }) {
+    _checkOpen();
+    _fillQuery(level, difficulty, minSyllables, maxSyllables, minLength, maxLength);
+    final index = _native.opendsa_content_index_next(_handle, _query);
+    return index < 0 ? null : index;
+  }
+
+  /// Numero di parole compatibili con i vincoli.
+  int count({
+    required int level,
+    Difficulty? difficulty,
+    int? minSyllables,
+    int? maxSyllables,
+    int? minLength,
+    int? maxLength,
+  }) {
+    _checkOpen();
+    _fillQuery(level, difficulty, minSyllables, maxSyllables, minLength, maxLength);
+    return _native.opendsa_content_index_count(_handle, _query);
+  }
+
+  /// Salva permutazioni e cursori nel percorso indicato all'apertura.
+  bool save() {
+    _checkOpen();
+    final statePath = _statePath;
+    if (statePath == null) return false;
+    final result = using((arena) => _native.opendsa_content_index_save(
+      _handle,
+      statePath.toNativeUtf8(allocator: arena),
+    ));
+    if (result != 0) {
+      debugPrint('NativeContentIndex: errore nel salvataggio di $statePath');
+    }
+    return result == 0;
+  }
+
+  /// Rilascia l'indice. L'istanza non è più utilizzabile.
+  void dispose() {
+    if (_handle == nullptr) return;
+    _native.opendsa_content_index_free(_handle);
+    _handle = nullptr;
+    calloc.free(_query);
+  }
+
+  void _fillQuery(int level, Difficulty? difficulty, int? minSyllables,
+      int? maxSyllables, int? minLength, int? maxLength) {
+    _query.ref
+      ..level = level
+      ..difficulty = difficulty?.index ?? -1
+      ..minSyllables = minSyllables ?? 0
+      ..maxSyllables = maxSyllables ?? 0
+      ..minLength = minLength ?? 0
+      ..maxLength = maxLength ?? 0;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeContentIndex già rilasciato');
+    }
+  }
+}
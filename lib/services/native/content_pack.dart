@@ -0,0 +1,117 @@
+// lib/services/native/content_pack.dart
+
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart' as path;
+import 'opendsa_native_bindings.dart';
+import 'tokenized_text.dart';
+
+/// Pacchetto dei testi di lettura (pagine o paragrafi), generato in fase di
+/// build da linux/CMakeLists.txt e mappato in memoria dalla libreria nativa.
+///
+/// L'apertura legge solo l'indice delle pagine: una pagina diventa una
+/// [String] o un [TokenizedText] solo quando viene richiesta, e la libreria
+/// tiene in una cache LRU limitata le pagine già suddivise in token. Avvio e
+/// memoria restano costanti qualunque sia la dimensione del corpus.
+class NativeContentPack {
+  static const String paragraphsFileName = 'opendsa_paragraphs.pack';
+  static const String pagesFileName = 'opendsa_pages.pack';
+
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+  final Pointer<Int32> _pageLength = calloc<Int32>();
+  final int length;
+
+  NativeContentPack._(this._native, this._handle)
+      : length = _native.opendsa_content_pack_size(_handle);
+
+  /// Apre il pacchetto [fileName] installato nella cartella data del bundle
+  /// (o nella cartella indicata da OPENDSA_CONTENT_DIR). [cachedPages]
+  /// limita le pagine tenute in memoria già suddivise in token (0 = valore
+  /// predefinito). Restituisce null se la libreria nativa o il file non sono
+  /// disponibili.
+  static NativeContentPack? openBundled(String fileName, {int cachedPages = 0}) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final candidates = <String>[
+      if (Platform.environment['OPENDSA_CONTENT_DIR'] != null)
+        path.join(Platform.environment['OPENDSA_CONTENT_DIR']!, fileName),
+      path.join(File(Platform.resolvedExecutable).parent.path, 'data', fileName),
+    ];
+    for (final candidate in candidates) {
+      final handle = using((arena) => native.opendsa_content_pack_open(
+          candidate.toNativeUtf8(allocator: arena), cachedPages));
+      if (handle != nullptr) return NativeContentPack._(native, handle);
+    }
+    debugPrint('NativeContentPack: $fileName non trovato, uso i file di testo');
+    return null;
+  }
+
+  /// Testo della pagina [index].
+  String pageText(int index) {
+    _checkIndex(index);
+    final data = _native.opendsa_content_pack_page(_handle, index, _pageLength);
+    return utf8.decode(data.asTypedList(_pageLength.value));
+  }
+
+  /// Token della pagina [index], presi dalla cache nativa o calcolati ora.
+  /// Il chiamante deve rilasciarli con [TokenizedText.dispose].
+  TokenizedText pageTokens(int index) {
+    final text = pageText(index);
+    final tokens = _native.opendsa_content_pack_tokens(_handle, index);
+    return TokenizedText.adopt(_native, tokens, text);
+  }
+
+  /// Vista a sola lettura delle pagine, costruite da [build] a ogni accesso
+  /// a partire dai loro token.
+  List<T> map<T>(T Function(TokenizedText tokens) build) => _ContentPackList<T>(this, build);
+
+  /// Rilascia la mappatura e la cache. L'istanza non è più utilizzabile;
+  /// i [TokenizedText] già restituiti restano validi.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_content_pack_close(_handle);
+    _handle = nullptr;
+    calloc.free(_pageLength);
+  }
+
+  void _checkIndex(int index) {
+    if (_handle == nullptr) {
+      throw StateError('NativeContentPack già chiuso');
+    }
+    RangeError.checkValidIndex(index, this, 'index', length);
+  }
+}
+
+/// Lista di elementi costruiti su richiesta dalle pagine di un pacchetto.
+class _ContentPackList<T> extends ListBase<T> {
+  final NativeContentPack _pack;
+  final T Function(TokenizedText tokens) _build;
+
+  _ContentPackList(this._pack, this._build);
+
+  @override
+  int get length => _pack.length;
+
+  @override
+  set length(int newLength) => throw UnsupportedError('Lista a sola lettura');
+
+  @override
+  T operator [](int index) {
+    final tokens = _pack.pageTokens(index);
+    try {
+      return _build(tokens);
+    } finally {
+      tokens.dispose();
+    }
+  }
+
+  @override
+  void operator []=(int index, T value) =>
+      throw UnsupportedError('Lista a sola lettura');
+}
@@ -0,0 +1,153 @@
+// lib/services/native/file_recognizer.dart
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Parola riconosciuta, con l'intervallo in cui è pronunciata nel file.
+typedef NativeRecognizedWord = ({
+  String word,
+  Duration start,
+  Duration end,
+  double confidence,
+});
+
+/// Esito del riconoscimento di un file WAV.
+class NativeFileRecognition {
+  final String text;
+  final List<NativeRecognizedWord> words;
+  final Duration audioDuration;
+  final Duration processingTime;
+
+  const NativeFileRecognition({
+    required this.text,
+    required this.words,
+    required this.audioDuration,
+    required this.processingTime,
+  });
+
+  /// Tempo di elaborazione rispetto alla durata dell'audio: sotto 1 il file
+  /// è stato riconosciuto più velocemente del tempo reale.
+  double get realTimeFactor => audioDuration == Duration.zero
+      ? 0.0
+      : processingTime.inMicroseconds / audioDuration.inMicroseconds;
+}
+
+/// Modello di libvosk caricato dalla libreria nativa, per riconoscere i
+/// file registrati senza passare dal servizio di ascolto in tempo reale.
+///
+/// Il modello viene caricato su un thread nativo; ogni file viene mappato
+/// in memoria, convertito alla frequenza del modello e riconosciuto a
+/// blocchi su un altro thread, mentre Dart ne interroga l'avanzamento.
+class NativeSpeechModel {
+  static const Duration _pollInterval = Duration(milliseconds: 20);
+
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+  int _running = 0;
+  bool _closeRequested = false;
+
+  NativeSpeechModel._(this._native, this._handle);
+
+  /// Avvia il caricamento del modello in [modelDir]. Restituisce null se la
+  /// libreria nativa non è disponibile; un modello non valido o una libvosk
+  /// mancante vengono segnalati da [ready].
+  static NativeSpeechModel? open(String modelDir) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) =>
+        native.opendsa_speech_model_open(modelDir.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('NativeSpeechModel: impossibile aprire $modelDir');
+      return null;
+    }
+    return NativeSpeechModel._(native, handle);
+  }
+
+  /// Attende la fine del caricamento; false se il modello non è utilizzabile.
+  Future<bool> get ready async {
+    _checkOpen();
+    int state;
+    while ((state = _native.opendsa_speech_model_ready(_handle)) == 0) {
+      await Future.delayed(_pollInterval);
+    }
+    return state > 0;
+  }
+
+  /// Riconosce il WAV in [wavPath], a blocchi di [chunkMs] millisecondi (0 =
+  /// predefinito). [onProgress] riceve la frazione del file già elaborata.
+  /// Restituisce null se il file non è un WAV PCM valido o il
+  /// riconoscimento non riesce.
+  Future<NativeFileRecognition?> recognizeWav(
+    String wavPath, {
+    int chunkMs = 0,
+    void Function(double progress)? onProgress,
+  }) async {
+    _checkOpen();
+    final recognition = using((arena) => _native.opendsa_recognize_file_start(
+        _handle, wavPath.toNativeUtf8(allocator: arena), chunkMs));
+    if (recognition == nullptr) {
+      debugPrint('NativeSpeechModel: $wavPath non è un WAV valido');
+      return null;
+    }
+
+    _running++;
+    final result = calloc<OpendsaFileRecognitionResult>();
+    final word = calloc<OpendsaRecognizedWord>();
+    try {
+      double progress;
+      while ((progress = _native.opendsa_recognize_file_progress(recognition)) < 1.0) {
+        onProgress?.call(progress);
+        await Future.delayed(_pollInterval);
+      }
+      if (_native.opendsa_recognize_file_wait(recognition, result) != 0) {
+        debugPrint('NativeSpeechModel: riconoscimento di $wavPath non riuscito');
+        return null;
+      }
+      onProgress?.call(1.0);
+
+      final words = <NativeRecognizedWord>[];
+      for (var i = 0; i < result.ref.wordCount; i++) {
+        if (_native.opendsa_recognize_file_word(recognition, i, word) != 0) break;
+        words.add((
+          word: word.ref.word.toDartString(),
+          start: _seconds(word.ref.start),
+          end: _seconds(word.ref.end),
+          confidence: word.ref.confidence,
+        ));
+      }
+      return NativeFileRecognition(
+        text: result.ref.text.toDartString(),
+        words: words,
+        audioDuration: _seconds(result.ref.audioSeconds),
+        processingTime: _seconds(result.ref.elapsedSeconds),
+      );
+    } finally {
+      calloc.free(word);
+      calloc.free(result);
+      _native.opendsa_recognize_file_free(recognition);
+      _running--;
+      if (_closeRequested && _running == 0) close();
+    }
+  }
+
+  /// Libera il modello; se ci sono riconoscimenti in corso, alla fine
+  /// dell'ultimo. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _closeRequested = true;
+    if (_running > 0) return;
+    _native.opendsa_speech_model_close(_handle);
+    _handle = nullptr;
+  }
+
+  static Duration _seconds(double seconds) =>
+      Duration(microseconds: (seconds * Duration.microsecondsPerSecond).round());
+
+  void _checkOpen() {
+    if (_handle == nullptr || _closeRequested) {
+      throw StateError('NativeSpeechModel già chiuso');
+    }
+  }
+}
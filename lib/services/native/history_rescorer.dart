@@ -0,0 +1,325 @@
+// lib/services/native/history_rescorer.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+import '../../config/app_config.dart';
+import '../learning_analytics_service.dart';
+import '../training_session_service.dart';
+import 'confusion_model.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Avanzamento di un ricalcolo in corso.
+class RescoreProgress {
+  final int completed;
+  final int total;
+
+  const RescoreProgress(this.completed, this.total);
+
+  double get fraction => total == 0 ? 1.0 : completed / total;
+}
+
+/// Esito del ricalcolo dello storico.
+class RescoreSummary {
+  final int rescoredAttempts;
+  final int skippedAttempts;               // Tentativi senza testo atteso salvato
+  final Map<DateTime, double> dailyAverages; // Media ricalcolata per giorno
+
+  const RescoreSummary({
+    required this.rescoredAttempts,
+    required this.skippedAttempts,
+    required this.dailyAverages,
+  });
+}
+
+/// Ricalcola la similarità dei tentativi salvati dopo una modifica dei pesi
+/// o della tabella delle confusioni.
+///
+/// I tentativi (testo letto, testo atteso) vengono raccolti dalla cronologia
+/// di [TrainingSessionService] e dalla sessione di [LearningAnalyticsService],
+/// che contengono i tentativi di tutti i profili. Vengono ricalcolati solo
+/// quelli del profilo indicato, con i suoi costi, e quelli salvati senza
+/// profilo, con i costi predefiniti; gli altri profili restano a quando
+/// verranno ricalcolati loro. La versione dei parametri è salvata per
+/// profilo, più una per i tentativi senza profilo.
+///
+/// Il calcolo avviene in parallelo su tutti i core dalla libreria nativa. Le
+/// similarità ottenute, indicizzate per tentativo, vengono scritte in una
+/// sola chiave: è il punto di commit del ricalcolo. Solo dopo vengono unite
+/// ai documenti riletti in quel momento, così i tentativi salvati durante il
+/// calcolo restano; l'unione si può ripetere, e se l'app si chiude a metà
+/// viene completata al ricalcolo successivo.
+class HistoryRescorer {
+  static const Duration _pollInterval = Duration(milliseconds: 50);
+
+  /// Versione dei parametri con cui sono calcolati i tentativi senza profilo
+  static const String unattributedVersionKey = 'similarity_parameters_version';
+
+  // Similarità ricalcolate non ancora unite ai documenti
+  static const String _pendingKey = 'history_rescore_pending';
+
+  static const List<String> _documentKeys = [
+    TrainingSessionService.sessionsHistoryKey,
+    TrainingSessionService.currentSessionKey,
+    LearningAnalyticsService.sessionKey,
+  ];
+
+  final SharedPreferences _prefs;
+
+  HistoryRescorer(this._prefs);
+
+  /// Versione dei parametri con cui sono calcolati i tentativi di [profileId]
+  static String parametersVersionKey(String profileId) =>
+      '${unattributedVersionKey}_$profileId';
+
+  /// Ricalcola i tentativi di [profileId] (e quelli senza profilo) se la
+  /// libreria nativa usa parametri del punteggio diversi da quelli con cui
+  /// sono stati calcolati, completando prima un ricalcolo interrotto.
+  /// Restituisce null se non c'era nulla da fare o la libreria nativa non è
+  /// disponibile.
+  Future<RescoreSummary?> rescoreIfParametersChanged({
+    required String profileId,
+    ConfusionModel? model,
+    void Function(RescoreProgress progress)? onProgress,
+  }) async {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final recovered = await _applyPending(profileId);
+    final version = native.opendsa_similarity_parameters_version();
+    if (_prefs.getInt(parametersVersionKey(profileId)) == version &&
+        _prefs.getInt(unattributedVersionKey) == version) {
+      return recovered;
+    }
+    debugPrint('HistoryRescorer: parametri del punteggio cambiati, ricalcolo lo storico di $profileId');
+    return rescoreAll(profileId: profileId, model: model, onProgress: onProgress);
+  }
+
+  /// Ricalcola i tentativi di [profileId] con i costi di [model] (o quelli
+  /// predefiniti) e quelli senza profilo con i costi predefiniti. Le medie
+  /// giornaliere restituite sono solo quelle di [profileId]. [onProgress]
+  /// viene chiamato periodicamente durante il calcolo. Restituisce null se
+  /// la libreria nativa non è disponibile.
+  Future<RescoreSummary?> rescoreAll({
+    required String profileId,
+    ConfusionModel? model,
+    int threads = 0,
+    void Function(RescoreProgress progress)? onProgress,
+  }) async {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    // Coppie distinte da valutare, indicizzate per tentativo: lo stesso
+    // tentativo può comparire sia nella sessione corrente sia nella cronologia
+    final own = <String, ({String text, String target})>{};
+    final unattributed = <String, ({String text, String target})>{};
+    var skipped = 0;
+    _forEachResult(_readDocuments(), (result) {
+      final key = _attemptKey(result);
+      final owner = result['profileId'] as String? ?? '';
+      if (key == null) {
+        if (owner.isEmpty || owner == profileId) skipped++;
+        return;
+      }
+      final attempt = (
+        text: result['text'] as String? ?? '',
+        target: result['targetText'] as String,
+      );
+      if (owner == profileId) {
+        own[key] = attempt;
+      } else if (owner.isEmpty) {
+        unattributed[key] = attempt;
+      }
+    });
+
+    final total = own.length + unattributed.length;
+    final Map<String, double> ownSimilarities;
+    final Map<String, double> unattributedSimilarities;
+    try {
+      ownSimilarities = await _score(native, own, model?.handle ?? nullptr, threads,
+          (completed) => onProgress?.call(RescoreProgress(completed, total)));
+      unattributedSimilarities = await _score(native, unattributed, nullptr, threads,
+          (completed) => onProgress?.call(RescoreProgress(own.length + completed, total)));
+    } on StateError catch (e) {
+      debugPrint('HistoryRescorer: $e');
+      return null;
+    }
+    onProgress?.call(RescoreProgress(total, total));
+
+    // Commit: da qui in poi il ricalcolo è salvato anche se l'app si chiude
+    await _prefs.setString(_pendingKey, jsonEncode({
+      'version': native.opendsa_similarity_parameters_version(),
+      'profileId': profileId,
+      'similarities': ownSimilarities,
+      'unattributed': unattributedSimilarities,
+    }));
+    final summary = await _applyPending(profileId);
+    debugPrint('HistoryRescorer: ricalcolati ${own.length} tentativi di $profileId e ${unattributed.length} senza profilo, $skipped senza testo atteso');
+    return RescoreSummary(
+      rescoredAttempts: summary?.rescoredAttempts ?? 0,
+      skippedAttempts: skipped,
+      dailyAverages: summary?.dailyAverages ?? const {},
+    );
+  }
+
+  /// Valuta [attempts] con i costi [model] (nullptr = predefiniti) e
+  /// restituisce le similarità per tentativo.
+  Future<Map<String, double>> _score(
+    OpenDsaNativeLibrary native,
+    Map<String, ({String text, String target})> attempts,
+    Pointer<Void> model,
+    int threads,
+    void Function(int completed) onProgress,
+  ) async {
+    if (attempts.isEmpty) return {};
+
+    // Le stringhe vengono copiate dalla libreria: l'arena si può liberare subito
+    final keys = attempts.keys.toList();
+    final job = using((arena) {
+      final recognized = arena<Pointer<Utf8>>(keys.length);
+      final targets = arena<Pointer<Utf8>>(keys.length);
+      for (var i = 0; i < keys.length; i++) {
+        final attempt = attempts[keys[i]]!;
+        recognized[i] = attempt.text.toNativeUtf8(allocator: arena);
+        targets[i] = attempt.target.toNativeUtf8(allocator: arena);
+      }
+      return native.opendsa_rescore_start(recognized, targets, keys.length, model, threads);
+    });
+    if (job == nullptr) throw StateError('impossibile avviare il ricalcolo');
+
+    final similarities = <String, double>{};
+    final values = calloc<Double>(keys.length);
+    try {
+      int completed;
+      while ((completed = native.opendsa_rescore_progress(job)) < keys.length) {
+        onProgress(completed);
+        await Future.delayed(_pollInterval);
+      }
+      native.opendsa_rescore_wait(job, values);
+      for (var i = 0; i < keys.length; i++) {
+        similarities[keys[i]] = values[i];
+      }
+    } finally {
+      calloc.free(values);
+      native.opendsa_rescore_free(job);
+    }
+    return similarities;
+  }
+
+  /// Unisce le similarità del ricalcolo salvato ai documenti attuali e
+  /// rimuove il ricalcolo. Le medie giornaliere sono restituite solo se il
+  /// ricalcolo era di [profileId]: un ricalcolo interrotto di un altro
+  /// profilo viene unito, ma la sua versione resta da aggiornare, così le
+  /// sue medie verranno ricalcolate quando il profilo verrà usato.
+  /// Restituisce null se non c'era un ricalcolo.
+  Future<RescoreSummary?> _applyPending(String profileId) async {
+    final raw = _prefs.getString(_pendingKey);
+    if (raw == null) return null;
+    final Map<String, double> own;
+    final Map<String, double> unattributed;
+    final int version;
+    final String owner;
+    try {
+      final pending = jsonDecode(raw) as Map<String, dynamic>;
+      version = pending['version'] as int;
+      // I ricalcoli senza profilo erano fatti con i costi di un solo
+      // profilo per tutti: vengono scartati e rifatti
+      owner = pending['profileId'] as String;
+      Map<String, double> decode(Object? values) => (values as Map<String, dynamic>? ?? const {})
+          .map((key, value) => MapEntry(key, (value as num).toDouble()));
+      own = decode(pending['similarities']);
+      unattributed = decode(pending['unattributed']);
+    } catch (e) {
+      debugPrint('HistoryRescorer: ricalcolo salvato non leggibile, scartato: $e');
+      await _prefs.remove(_pendingKey);
+      return null;
+    }
+    final current = owner == profileId;
+
+    // Lettura, unione e scrittura senza attese intermedie: nessun altro
+    // salvataggio può inserirsi fra la rilettura e la scrittura
+    final documents = _readDocuments();
+    final dailySums = <DateTime, double>{};
+    final dailyCounts = <DateTime, int>{};
+    var rescored = 0;
+    final changed = <String>{};
+    for (final entry in documents.entries) {
+      _forEachResult({entry.key: entry.value}, (result) {
+        final key = _attemptKey(result);
+        if (key == null) return;
+        final resultOwner = result['profileId'] as String? ?? '';
+        final similarity = resultOwner.isEmpty
+            ? unattributed[key]
+            : resultOwner == owner ? own[key] : null;
+        if (similarity == null) return;
+        result['similarity'] = similarity;
+        result['isCorrect'] = similarity >= AppConfig.minSimilarityScore;
+        changed.add(entry.key);
+        rescored++;
+        final timestamp = result['timestamp'] as String?;
+        if (resultOwner.isEmpty || !current || timestamp == null) return;
+        final date = DateTime.parse(timestamp);
+        final day = DateTime(date.year, date.month, date.day);
+        dailySums[day] = (dailySums[day] ?? 0.0) + similarity;
+        dailyCounts[day] = (dailyCounts[day] ?? 0) + 1;
+      });
+    }
+    final writes = [
+      for (final key in changed) _prefs.setString(key, jsonEncode(documents[key])),
+      _prefs.setInt(unattributedVersionKey, version),
+      if (current) _prefs.setInt(parametersVersionKey(owner), version),
+    ];
+    await Future.wait(writes);
+    await _prefs.remove(_pendingKey);
+
+    return RescoreSummary(
+      rescoredAttempts: rescored,
+      skippedAttempts: 0,
+      dailyAverages: dailySums.map((day, sum) => MapEntry(day, sum / dailyCounts[day]!)),
+    );
+  }
+
+  /// Documenti salvati, decodificati; quelli non leggibili vengono ignorati
+  Map<String, dynamic> _readDocuments() {
+    final documents = <String, dynamic>{};
+    for (final key in _documentKeys) {
+      final raw = _prefs.getString(key);
+      if (raw == null) continue;
+      try {
+        documents[key] = jsonDecode(raw);
+      } catch (e) {
+        debugPrint('HistoryRescorer: $key non leggibile, ignorato: $e');
+      }
+    }
+    return documents;
+  }
+
+  /// Chiama [visit] per ogni risultato salvato nei documenti
+  static void _forEachResult(Map<String, dynamic> documents,
+      void Function(Map<String, dynamic> result) visit) {
+    void session(dynamic session) {
+      if (session is! Map || session['results'] is! List) return;
+      for (final result in session['results'] as List) {
+        if (result is Map<String, dynamic>) visit(result);
+      }
+    }
+
+    for (final document in documents.values) {
+      if (document is List) {
+        document.forEach(session);
+      } else {
+        session(document);
+      }
+    }
+  }
+
+  /// Chiave di un tentativo: momento, testo atteso e testo letto. Null se
+  /// il testo atteso non è stato salvato.
+  static String? _attemptKey(Map<String, dynamic> result) {
+    final target = result['targetText'] as String? ?? '';
+    if (target.isEmpty) return null;
+    return '${result['timestamp']}\u0000$target\u0000${result['text'] ?? ''}';
+  }
+}
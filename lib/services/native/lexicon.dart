@@ -0,0 +1,178 @@
+// lib/services/native/lexicon.dart
+
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart' as path;
+import '../../models/content_models.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Lessico delle parole degli esercizi, precompilato in fase di build da
+/// linux/CMakeLists.txt e mappato in memoria dalla libreria nativa.
+///
+/// Le voci vengono lette direttamente dalla mappatura: l'apertura non
+/// alloca né analizza nulla, e una parola diventa una [String] Dart solo
+/// quando viene richiesta.
+class NativeLexicon {
+  static const String _fileName = 'opendsa_lexicon.bin';
+
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+  final Pointer<OpendsaLexiconEntry> _entries;
+  final Pointer<OpendsaLexiconPronunciation> _pronunciations;
+  final Pointer<Uint8> _strings;
+  final int length;
+
+  NativeLexicon._(this._native, this._handle)
+      : _entries = _native.opendsa_lexicon_entries(_handle),
+        _pronunciations = _native.opendsa_lexicon_pronunciations(_handle),
+        _strings = _native.opendsa_lexicon_strings(_handle),
+        length = _native.opendsa_lexicon_size(_handle);
+
+  /// Apre il lessico installato nella cartella data del bundle (o quello
+  /// indicato da OPENDSA_LEXICON_PATH). Restituisce null se la libreria
+  /// nativa o il file non sono disponibili.
+  static NativeLexicon? openBundled() {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final candidates = <String>[
+      if (Platform.environment['OPENDSA_LEXICON_PATH'] != null)
+        Platform.environment['OPENDSA_LEXICON_PATH']!,
+      path.join(File(Platform.resolvedExecutable).parent.path, 'data', _fileName),
+    ];
+    for (final candidate in candidates) {
+      final handle = using((arena) =>
+          native.opendsa_lexicon_open(candidate.toNativeUtf8(allocator: arena)));
+      if (handle != nullptr) return NativeLexicon._(native, handle);
+    }
+    debugPrint('NativeLexicon: lessico non trovato, uso le liste di parole');
+    return null;
+  }
+
+  /// Intervallo di voci di un livello (1 = parole facili).
+  ({int first, int count}) levelRange(int level) {
+    _checkOpen();
+    return using((arena) {
+      final first = arena<Int32>();
+      final count = _native.opendsa_lexicon_level_range(_handle, level, first);
+      return (first: first.value, count: count);
+    });
+  }
+
+  /// Parola della voce [index].
+  String wordAt(int index) {
+    final entry = _entryAt(index);
+    return utf8.decode((_strings + entry.textOffset).asTypedList(entry.textBytes));
+  }
+
+  int lengthAt(int index) => _entryAt(index).length;
+  int syllablesAt(int index) => _entryAt(index).syllables;
+  int levelAt(int index) => _entryAt(index).level;
+
+  /// Caratteristiche ortografiche ([OpendsaWordFlags]).
+  int flagsAt(int index) => _entryAt(index).flags;
+
+  /// Sillaba tonica contata dalla fine (1 tronca, 2 piana, 3 sdrucciola).
+  int stressAt(int index) => _entryAt(index).stress;
+
+  /// Lettere che non corrispondono uno a uno a un fonema.
+  int orthographicDepthAt(int index) => _entryAt(index).orthographicDepth;
+
+  /// Pronuncia attesa della voce [index], calcolata in fase di build: un
+  /// fonema IPA per carattere (vedi linux/native/phonemizer.h).
+  String pronunciationAt(int index) {
+    _checkOpen();
+    RangeError.checkValidIndex(index, this, 'index', length);
+    final pronunciation = (_pronunciations + index).ref;
+    return utf8.decode(
+        (_strings + pronunciation.offset).asTypedList(pronunciation.bytes));
+  }
+
+  /// Numero di fonemi della pronuncia della voce [index].
+  int phonesAt(int index) {
+    _checkOpen();
+    RangeError.checkValidIndex(index, this, 'index', length);
+    return (_pronunciations + index).ref.phones;
+  }
+
+  /// Pronuncia di una parola qualsiasi, per i testi che non sono nel
+  /// lessico. La libreria nativa tiene in cache le parole recenti; null se
+  /// non è disponibile.
+  static String? pronounce(String word) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    return using((arena) {
+      final nativeWord = word.toNativeUtf8(allocator: arena);
+      var capacity = 64;
+      var out = arena<Uint8>(capacity);
+      var length = native.opendsa_pronounce(nativeWord, out, capacity);
+      if (length < 0) return null;
+      if (length >= capacity) {
+        capacity = length + 1;
+        out = arena<Uint8>(capacity);
+        length = native.opendsa_pronounce(nativeWord, out, capacity);
+      }
+      return utf8.decode(out.asTypedList(length));
+    });
+  }
+
+  /// Vista a sola lettura di tutte le parole, senza copie.
+  List<Word> get words => _LexiconWordList(this, 0, length);
+
+  /// Vista a sola lettura delle parole di un livello, senza copie.
+  List<Word> wordsForLevel(int level) {
+    final range = levelRange(level);
+    return _LexiconWordList(this, range.first, range.count);
+  }
+
+  /// Puntatore nativo, per le API che leggono il lessico (es. ContentIndex).
+  Pointer<Void> get handle => _handle;
+
+  /// Rilascia la mappatura. L'istanza non è più utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_lexicon_close(_handle);
+    _handle = nullptr;
+  }
+
+  OpendsaLexiconEntry _entryAt(int index) {
+    _checkOpen();
+    RangeError.checkValidIndex(index, this, 'index', length);
+    return (_entries + index).ref;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeLexicon già chiuso');
+    }
+  }
+}
+
+/// Lista di [Word] costruite su richiesta a partire da un intervallo del lessico.
+class _LexiconWordList extends ListBase<Word> {
+  final NativeLexicon _lexicon;
+  final int _first;
+  final int _count;
+
+  _LexiconWordList(this._lexicon, this._first, this._count);
+
+  @override
+  int get length => _count;
+
+  @override
+  set length(int newLength) => throw UnsupportedError('Lista a sola lettura');
+
+  @override
+  Word operator [](int index) {
+    RangeError.checkValidIndex(index, this, 'index', _count);
+    return Word(_lexicon.wordAt(_first + index), lexiconIndex: _first + index);
+  }
+
+  @override
+  void operator []=(int index, Word value) =>
+      throw UnsupportedError('Lista a sola lettura');
+}
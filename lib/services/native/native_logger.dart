@@ -0,0 +1,249 @@
+// lib/services/native/native_logger.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:math';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Una riga del log scomposta: [level] è uno dei valori di
+/// [OpendsaLogLevel], [tag] il contesto (vuoto se assente).
+typedef NativeLogRecord = ({
+  DateTime time,
+  int level,
+  String tag,
+  String message,
+});
+
+/// Log di testo di un servizio, scritto in background dalla libreria
+/// nativa.
+///
+/// [log] accoda il messaggio in una coda senza lock e torna subito: la
+/// riga (`AAAA-MM-GGTHH:MM:SS.mmm L messaggio`, ora locale, oppure
+/// `... L@tag messaggio`) viene scritta da un thread nativo insieme alle
+/// altre in coda. I file sono `<prefix>_<data>.txt` nella directory
+/// indicata; i segmenti che superano [maxFileBytes] o di giorni passati
+/// vengono chiusi e compressi. Le ultime righe restano in memoria
+/// ([recent]); [query] cerca per intervallo, livello e tag negli indici dei
+/// segmenti senza decomprimere quelli che non possono contenere risultati.
+class NativeLogger {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  // Buffer riusato per i messaggi, per non allocare a ogni record
+  Pointer<Uint8> _buffer = nullptr;
+  int _bufferSize = 0;
+
+  NativeLogger._(this._native, this._handle);
+
+  /// Apre il log in [directory], che deve esistere. Restituisce null se la
+  /// libreria nativa non è disponibile o la directory non è accessibile.
+  static NativeLogger? open(
+    String directory,
+    String prefix, {
+    int maxFileBytes = 1024 * 1024,
+    int ringCapacity = 1000,
+    int maxPending = 64 * 1024,
+    Duration flushInterval = const Duration(milliseconds: 250),
+  }) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) {
+      final options = arena<OpendsaLoggerOptions>();
+      options.ref
+        ..maxFileBytes = maxFileBytes
+        ..ringCapacity = ringCapacity
+        ..maxPending = maxPending
+        ..flushIntervalMs = max(flushInterval.inMilliseconds, 1);
+      return native.opendsa_logger_open(
+        directory.toNativeUtf8(allocator: arena),
+        prefix.toNativeUtf8(allocator: arena),
+        options,
+      );
+    });
+    if (handle == nullptr) {
+      debugPrint('NativeLogger: impossibile aprire $directory');
+      return null;
+    }
+    return NativeLogger._(native, handle);
+  }
+
+  /// Accoda [message] con il livello [level] ([OpendsaLogLevel]) e il tag
+  /// di contesto [tag] (spazi e caratteri di controllo diventano `_`).
+  /// Restituisce false se il record è stato scartato perché la coda è
+  /// piena.
+  bool log(String message, {int level = OpendsaLogLevel.info, String? tag}) {
+    _checkOpen();
+    // Nel buffer il tag terminato da zero, poi il messaggio
+    final tagBytes = tag == null || tag.isEmpty ? null : utf8.encode(tag);
+    final tagSize = tagBytes == null ? 0 : tagBytes.length + 1;
+    final bytes = utf8.encode(message);
+    final size = tagSize + bytes.length;
+    if (_buffer == nullptr || size > _bufferSize) {
+      if (_buffer != nullptr) malloc.free(_buffer);
+      _bufferSize = max(size, 256);
+      _buffer = malloc<Uint8>(_bufferSize);
+    }
+    final view = _buffer.asTypedList(size);
+    if (tagBytes != null) {
+      view.setAll(0, tagBytes);
+      view[tagBytes.length] = 0;
+    }
+    view.setAll(tagSize, bytes);
+    return _native.opendsa_logger_log(
+          _handle,
+          level,
+          tagBytes == null ? nullptr : _buffer.cast<Utf8>(),
+          _buffer + tagSize,
+          bytes.length,
+        ) ==
+        0;
+  }
+
+  /// Attende che i record accodati siano scritti; con [sync] anche
+  /// l'fdatasync.
+  bool flush({bool sync = false}) {
+    _checkOpen();
+    return _native.opendsa_logger_flush(_handle, sync ? 1 : 0) == 0;
+  }
+
+  /// Le ultime [limit] righe scritte, dalla più vecchia.
+  List<String> recent([int limit = 1000]) {
+    _checkOpen();
+    final count = _native.opendsa_logger_recent(_handle, limit);
+    return [
+      for (var i = 0; i < count; i++)
+        _native.opendsa_logger_line(_handle, i).toDartString(),
+    ];
+  }
+
+  /// Tutte le righe del giorno di [date], anche dai segmenti compressi.
+  /// Restituisce null se un segmento non è leggibile.
+  List<String>? readDay(DateTime date) {
+    _checkOpen();
+    final day = date.toIso8601String().split('T')[0];
+    return using((arena) {
+      final length = arena<Int64>();
+      final data = _native.opendsa_logger_read_day(
+          _handle, day.toNativeUtf8(allocator: arena), length);
+      if (data == nullptr) return null;
+      return utf8
+          .decode(data.asTypedList(length.value), allowMalformed: true)
+          .split('\n')
+          .where((line) => line.isNotEmpty)
+          .toList();
+    });
+  }
+
+  /// Le righe tra [from] (incluso) e [to] (escluso) con livello almeno
+  /// [minLevel] e, se indicato, con il tag [tag], dalla più vecchia. Con
+  /// [limit] solo le più recenti. I segmenti non leggibili vengono saltati.
+  List<NativeLogRecord> query({
+    DateTime? from,
+    DateTime? to,
+    int minLevel = OpendsaLogLevel.debug,
+    String? tag,
+    int limit = 0,
+  }) {
+    _checkOpen();
+    return using((arena) {
+      final filter = arena<OpendsaLogQuery>();
+      filter.ref
+        ..fromMs = from == null ? _minInt64 : _wallMs(from)
+        ..toMs = to == null ? _maxInt64 : _wallMs(to)
+        ..minLevel = minLevel
+        ..limit = limit
+        ..tag = tag == null || tag.isEmpty
+            ? nullptr
+            : tag.toNativeUtf8(allocator: arena);
+      final count = _native.opendsa_logger_query(_handle, filter, nullptr);
+      final records = <NativeLogRecord>[];
+      for (var i = 0; i < count; i++) {
+        final record =
+            parse(_native.opendsa_logger_line(_handle, i).toDartString());
+        if (record != null) records.add(record);
+      }
+      return records;
+    });
+  }
+
+  /// Contatori del log: record accodati, scartati e scritti, write
+  /// eseguite, segmenti chiusi e compressi.
+  ({
+    int recordsLogged,
+    int recordsDropped,
+    int recordsWritten,
+    int batches,
+    int bytesWritten,
+    int rotations,
+    int bytesArchived,
+    int writeErrors,
+  }) get stats {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaLoggerStats>();
+      _native.opendsa_logger_stats(_handle, out);
+      return (
+        recordsLogged: out.ref.recordsLogged,
+        recordsDropped: out.ref.recordsDropped,
+        recordsWritten: out.ref.recordsWritten,
+        batches: out.ref.batches,
+        bytesWritten: out.ref.bytesWritten,
+        rotations: out.ref.rotations,
+        bytesArchived: out.ref.bytesArchived,
+        writeErrors: out.ref.writeErrors,
+      );
+    });
+  }
+
+  /// Scrive i record in coda e chiude il log. L'istanza non è più
+  /// utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_logger_close(_handle);
+    _handle = nullptr;
+    if (_buffer != nullptr) malloc.free(_buffer);
+    _buffer = nullptr;
+    _bufferSize = 0;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeLogger già chiuso');
+    }
+  }
+
+  /// Il messaggio di una riga del log, senza ora, livello e tag.
+  static String messageOf(String line) => parse(line)?.message ?? line;
+
+  /// Scompone una riga del log; null se non ne ha il formato.
+  static NativeLogRecord? parse(String line) {
+    // "AAAA-MM-GGTHH:MM:SS.mmm L[@tag] messaggio"
+    if (line.length < 25 || line[23] != ' ') return null;
+    final level = _levelChars.indexOf(line[24]);
+    final time = DateTime.tryParse(line.substring(0, 23));
+    if (level < 0 || time == null) return null;
+    final space = line.indexOf(' ', 25);
+    final token = line.substring(25, space < 0 ? line.length : space);
+    if (token.isNotEmpty && !token.startsWith('@')) return null;
+    return (
+      time: time,
+      level: level,
+      tag: token.isEmpty ? '' : token.substring(1),
+      message: space < 0 ? '' : line.substring(space + 1),
+    );
+  }
+
+  static const _levelChars = 'DIWE';
+  static const _minInt64 = -0x8000000000000000;
+  static const _maxInt64 = 0x7fffffffffffffff;
+
+  /// L'ora locale di [time] contata come UTC, come nelle righe del log.
+  static int _wallMs(DateTime time) {
+    final local = time.toLocal();
+    return DateTime.utc(local.year, local.month, local.day, local.hour,
+            local.minute, local.second, local.millisecond)
+        .millisecondsSinceEpoch;
+  }
+}
@@ -0,0 +1,1210 @@
+// lib/services/native/opendsa_native_bindings.dart
+
+/// Binding FFI per la libreria nativa di OpenDSA (libopendsa_native.so),
+/// costruita da linux/native. Le firme rispecchiano linux/native/opendsa_native.h.
+
+import 'dart:ffi';
+import 'dart:io';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'package:path/path.dart' as path;
+
+/// Tipi di errore restituiti da opendsa_diagnose (OPENDSA_EDIT_*).
+class OpendsaEditKind {
+  static const int inversion = 1;
+  static const int confusion = 2;
+  static const int sequence = 3;
+  static const int omission = 4;
+  static const int insertion = 5;
+  static const int substitution = 6;
+}
+
+/// Rispecchia la struct OpendsaEdit.
+final class OpendsaEdit extends Struct {
+  @Int32()
+  external int kind;
+  @Int32()
+  external int targetPos;
+  @Int32()
+  external int recognizedPos;
+  @Int32()
+  external int length;
+  @Uint32()
+  external int expected;
+  @Uint32()
+  external int actual;
+}
+
+/// Rispecchia la struct OpendsaDiagnostics.
+final class OpendsaDiagnostics extends Struct {
+  @Int32()
+  external int inversions;
+  @Int32()
+  external int confusions;
+  @Int32()
+  external int sequenceErrors;
+  @Int32()
+  external int omissions;
+  @Int32()
+  external int insertions;
+  @Int32()
+  external int substitutions;
+  @Int32()
+  external int editCount;
+  @Int32()
+  external int editCapacity;
+  external Pointer<OpendsaEdit> edits;
+  @Double()
+  external double distance;
+  @Double()
+  external double similarity;
+}
+
+/// Tipi dei valori di un profilo binario (OPENDSA_VALUE_*).
+class OpendsaValueType {
+  static const int nullValue = 0;
+  static const int falseValue = 1;
+  static const int trueValue = 2;
+  static const int integer = 3;
+  static const int decimal = 4;
+  static const int string = 5;
+  static const int array = 6;
+  static const int object = 7;
+}
+
+/// Ambiti delle statistiche di apprendimento (OPENDSA_ANALYTICS_*).
+class OpendsaAnalyticsScope {
+  static const int total = 0;
+  static const int session = 1;
+  static const int errorKinds = 8;
+  static const int similarityBuckets = 10;
+}
+
+/// Bit degli errori di un tentativo (OPENDSA_ATTEMPT_INCORRECT) e
+/// raggruppamenti delle interrogazioni (OPENDSA_ATTEMPT_GROUP_*). Gli errori
+/// di lettura usano i bit `1 << OpendsaEditKind.*`.
+class OpendsaAttemptGroupBy {
+  static const int incorrect = 1;
+
+  static const int none = 0;
+  static const int day = 1;
+  static const int week = 2;
+  static const int level = 3;
+  static const int target = 4;
+  static const int profile = 5;
+}
+
+/// Tipi dei record del journal della sessione (OPENDSA_JOURNAL_*).
+class OpendsaJournalRecord {
+  static const int begin = 1;
+  static const int entry = 2;
+}
+
+/// Livelli dei record del log (OPENDSA_LOG_*).
+class OpendsaLogLevel {
+  static const int debug = 0;
+  static const int info = 1;
+  static const int warning = 2;
+  static const int error = 3;
+}
+
+/// Caratteristiche ortografiche di una parola (OPENDSA_WORD_*).
+class OpendsaWordFlags {
+  static const int complexSyllables = 0x0001;
+  static const int accented = 0x0002;
+  static const int digraph = 0x0004;
+  static const int consonantCluster = 0x0008;
+  static const int geminate = 0x0010;
+  static const int hiatus = 0x0020;
+  static const int diphthong = 0x0040;
+  static const int triphthong = 0x0080;
+}
+
+/// Rispecchia la struct OpendsaWordFeatures.
+final class OpendsaWordFeatures extends Struct {
+  @Int32()
+  external int syllables;
+  @Int32()
+  external int stress;
+  @Int32()
+  external int flags;
+  @Int32()
+  external int orthographicDepth;
+}
+
+/// Rispecchia la struct OpendsaLexiconEntry.
+final class OpendsaLexiconEntry extends Struct {
+  @Uint32()
+  external int textOffset;
+  @Uint16()
+  external int textBytes;
+  @Uint16()
+  external int length;
+  @Uint8()
+  external int syllables;
+  @Uint8()
+  external int level;
+  @Uint16()
+  external int flags;
+  @Uint8()
+  external int stress;
+  @Uint8()
+  external int orthographicDepth;
+  @Uint16()
+  external int reserved;
+}
+
+/// Rispecchia la struct OpendsaLexiconPronunciation.
+final class OpendsaLexiconPronunciation extends Struct {
+  @Uint32()
+  external int offset;
+  @Uint16()
+  external int bytes;
+  @Uint16()
+  external int phones;
+}
+
+/// Rispecchia la struct OpendsaWordQuery. I limiti a 0 non vengono applicati.
+final class OpendsaWordQuery extends Struct {
+  @Int32()
+  external int level;
+  @Int32()
+  external int difficulty;
+  @Int32()
+  external int minSyllables;
+  @Int32()
+  external int maxSyllables;
+  @Int32()
+  external int minLength;
+  @Int32()
+  external int maxLength;
+}
+
+/// Tipi di token (OPENDSA_TOKEN_WORD...).
+class OpendsaTokenKind {
+  static const int word = 1;
+  static const int number = 2;
+  static const int punctuation = 3;
+}
+
+/// Caratteristiche di un token (OPENDSA_TOKEN_SENTENCE_START...).
+class OpendsaTokenFlags {
+  static const int sentenceStart = 0x01;
+  static const int paragraphStart = 0x02;
+  static const int pageStart = 0x04;
+  static const int spaceBefore = 0x08;
+  static const int capitalized = 0x10;
+  static const int elision = 0x20;
+  static const int sentenceEnd = 0x40;
+}
+
+/// Rispecchia la struct OpendsaTokenView: array per colonne validi fino a
+/// opendsa_tokens_free.
+final class OpendsaTokenView extends Struct {
+  @Int32()
+  external int tokenCount;
+  @Int32()
+  external int sentenceCount;
+  @Int32()
+  external int paragraphCount;
+  @Int32()
+  external int normalizedSize;
+  external Pointer<Uint32> begins;
+  external Pointer<Uint32> ends;
+  external Pointer<Uint32> utf16Begins;
+  external Pointer<Uint32> utf16Ends;
+  external Pointer<Uint8> kinds;
+  external Pointer<Uint8> flags;
+  external Pointer<Uint32> normalizedOffsets;
+  external Pointer<Uint32> normalizedLengths;
+  external Pointer<Uint8> normalized;
+  external Pointer<Uint32> sentenceStarts;
+  external Pointer<Uint32> paragraphStarts;
+}
+
+/// Rispecchia la struct OpendsaProfileEntry: puntatori validi fino alla
+/// modifica successiva del log.
+final class OpendsaProfileEntry extends Struct {
+  external Pointer<Uint8> key;
+  @Int32()
+  external int keyLength;
+  external Pointer<Uint8> value;
+  @Int32()
+  external int valueLength;
+}
+
+/// Rispecchia la struct OpendsaProfileLogStats.
+final class OpendsaProfileLogStats extends Struct {
+  @Int64()
+  external int recordsReplayed;
+  @Int64()
+  external int recordsAppended;
+  @Int64()
+  external int writesSkipped;
+  @Int64()
+  external int bytesTruncated;
+  @Int64()
+  external int compactions;
+  @Int64()
+  external int logBytes;
+  @Int64()
+  external int liveBytes;
+  @Int64()
+  external int writesRequested;
+  @Int64()
+  external int writesCoalesced;
+  @Int64()
+  external int commits;
+  @Int64()
+  external int failedCommits;
+}
+
+/// Rispecchia la struct OpendsaProfileValue.
+final class OpendsaProfileValue extends Struct {
+  @Int32()
+  external int type;
+  @Int32()
+  external int count;
+  @Int64()
+  external int integer;
+  @Double()
+  external double number;
+  external Pointer<Utf8> string;
+}
+
+/// Rispecchia la struct OpendsaAccuracySummary.
+final class OpendsaAccuracySummary extends Struct {
+  @Int32()
+  external int days;
+  @Int32()
+  external int streak;
+  @Double()
+  external double average;
+  @Double()
+  external double lastValue;
+  @Int32()
+  external int lastDay;
+  @Int32()
+  external int reserved;
+}
+
+/// Rispecchia la struct OpendsaAccuracyDay.
+final class OpendsaAccuracyDay extends Struct {
+  @Int32()
+  external int day;
+  @Int32()
+  external int attempts;
+  @Double()
+  external double value;
+  @Double()
+  external double mean;
+}
+
+/// Rispecchia la struct OpendsaAccuracyWeek.
+final class OpendsaAccuracyWeek extends Struct {
+  @Int32()
+  external int week;
+  @Int32()
+  external int days;
+  @Int32()
+  external int daysOverThreshold;
+  @Int32()
+  external int attempts;
+  @Double()
+  external double average;
+}
+
+/// Rispecchia la struct OpendsaAnalyticsStats.
+final class OpendsaAnalyticsStats extends Struct {
+  @Int64()
+  external int attempts;
+  @Int64()
+  external int successes;
+  @Double()
+  external double similarityMean;
+  @Double()
+  external double similarityStddev;
+  @Double()
+  external double similarityMin;
+  @Double()
+  external double similarityMax;
+  @Double()
+  external double timeMean;
+  @Double()
+  external double timeStddev;
+  @Array(8)
+  external Array<Int64> errors;
+  @Array(10)
+  external Array<Int64> similarityBuckets;
+}
+
+/// Rispecchia la struct OpendsaAttempt.
+final class OpendsaAttempt extends Struct {
+  @Int64()
+  external int timestampMs;
+  external Pointer<Utf8> profile;
+  external Pointer<Utf8> target;
+  external Pointer<Utf8> recognized;
+  @Int32()
+  external int level;
+  @Int32()
+  external int correct;
+  @Double()
+  external double similarity;
+  @Double()
+  external double confidence;
+  @Int64()
+  external int durationMs;
+  @Int32()
+  external int utcOffsetMinutes;
+  @Int32()
+  external int reserved;
+}
+
+/// Rispecchia la struct OpendsaAttemptQuery.
+final class OpendsaAttemptQuery extends Struct {
+  @Int64()
+  external int fromMs;
+  @Int64()
+  external int toMs;
+  external Pointer<Utf8> profile;
+  external Pointer<Utf8> target;
+  @Int32()
+  external int minLevel;
+  @Int32()
+  external int maxLevel;
+  @Int32()
+  external int errors;
+  @Uint32()
+  external int confusionA;
+  @Uint32()
+  external int confusionB;
+  @Int32()
+  external int groupBy;
+}
+
+/// Rispecchia la struct OpendsaAttemptGroup.
+final class OpendsaAttemptGroup extends Struct {
+  @Int64()
+  external int key;
+  @Int64()
+  external int attempts;
+  @Int64()
+  external int correct;
+  @Double()
+  external double similarityMean;
+  @Double()
+  external double durationMeanMs;
+}
+
+/// Rispecchia la struct OpendsaAttemptQueryStats.
+final class OpendsaAttemptQueryStats extends Struct {
+  @Int64()
+  external int chunks;
+  @Int64()
+  external int chunksScanned;
+  @Int64()
+  external int rowsScanned;
+  @Int64()
+  external int rowsMatched;
+  @Int64()
+  external int columnsRead;
+}
+
+/// Rispecchia la struct OpendsaAttemptSummary.
+final class OpendsaAttemptSummary extends Struct {
+  @Int64()
+  external int attempts;
+  @Int64()
+  external int correct;
+  @Double()
+  external double accuracy;
+  @Double()
+  external double similarityMean;
+  @Double()
+  external double durationMeanMs;
+  @Int64()
+  external int firstMs;
+  @Int64()
+  external int lastMs;
+  @Int32()
+  external int days;
+  @Int32()
+  external int reserved;
+  @Array(8)
+  external Array<Int64> errors;
+}
+
+/// Rispecchia la struct OpendsaLoggerOptions.
+final class OpendsaLoggerOptions extends Struct {
+  @Int64()
+  external int maxFileBytes;
+  @Int32()
+  external int ringCapacity;
+  @Int32()
+  external int maxPending;
+  @Int32()
+  external int flushIntervalMs;
+  @Int32()
+  external int reserved;
+}
+
+/// Rispecchia la struct OpendsaLoggerStats.
+final class OpendsaLoggerStats extends Struct {
+  @Int64()
+  external int recordsLogged;
+  @Int64()
+  external int recordsDropped;
+  @Int64()
+  external int recordsWritten;
+  @Int64()
+  external int batches;
+  @Int64()
+  external int bytesWritten;
+  @Int64()
+  external int rotations;
+  @Int64()
+  external int bytesArchived;
+  @Int64()
+  external int writeErrors;
+}
+
+/// Rispecchia la struct OpendsaLogQuery.
+final class OpendsaLogQuery extends Struct {
+  @Int64()
+  external int fromMs;
+  @Int64()
+  external int toMs;
+  @Int32()
+  external int minLevel;
+  @Int32()
+  external int limit;
+  external Pointer<Utf8> tag;
+}
+
+/// Rispecchia la struct OpendsaLogQueryStats.
+final class OpendsaLogQueryStats extends Struct {
+  @Int64()
+  external int segments;
+  @Int64()
+  external int blocks;
+  @Int64()
+  external int blocksRead;
+  @Int64()
+  external int linesScanned;
+  @Int64()
+  external int linesMatched;
+  @Int64()
+  external int incomplete;
+}
+
+/// Rispecchia la struct OpendsaAudioArchiveOptions.
+final class OpendsaAudioArchiveOptions extends Struct {
+  @Int64()
+  external int maxBytes;
+  @Int64()
+  external int maxAgeMs;
+}
+
+/// Rispecchia la struct OpendsaAudioClip.
+final class OpendsaAudioClip extends Struct {
+  @Int64()
+  external int id;
+  @Int64()
+  external int recordedMs;
+  @Int64()
+  external int accessedMs;
+  @Int64()
+  external int durationMs;
+  @Int64()
+  external int storedBytes;
+  @Int32()
+  external int sampleRate;
+  @Int32()
+  external int channels;
+  external Pointer<Utf8> profile;
+  external Pointer<Utf8> target;
+}
+
+/// Rispecchia la struct OpendsaAudioArchiveStats.
+final class OpendsaAudioArchiveStats extends Struct {
+  @Int64()
+  external int clips;
+  @Int64()
+  external int storedBytes;
+  @Int64()
+  external int rawBytes;
+  @Int64()
+  external int evicted;
+}
+
+/// Rispecchia la struct OpendsaRecognizedWord.
+final class OpendsaRecognizedWord extends Struct {
+  external Pointer<Utf8> word;
+  @Double()
+  external double start;
+  @Double()
+  external double end;
+  @Double()
+  external double confidence;
+}
+
+/// Rispecchia la struct OpendsaFileRecognitionResult.
+final class OpendsaFileRecognitionResult extends Struct {
+  external Pointer<Utf8> text;
+  @Int32()
+  external int wordCount;
+  @Int32()
+  external int sampleRate;
+  @Double()
+  external double audioSeconds;
+  @Double()
+  external double elapsedSeconds;
+}
+
+/// Binding per opendsa_similarity.
+typedef opendsa_similarity_native = Double Function(Pointer<Utf8> recognized, Pointer<Utf8> target);
+typedef opendsa_similarity_dart = double Function(Pointer<Utf8> recognized, Pointer<Utf8> target);
+
+/// Binding per opendsa_diagnose.
+typedef opendsa_diagnose_native = Int32 Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<OpendsaDiagnostics> out);
+typedef opendsa_diagnose_dart = int Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<OpendsaDiagnostics> out);
+
+/// Binding per opendsa_confusion_model_open: carica il modello di un profilo.
+typedef opendsa_confusion_model_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_confusion_model_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_confusion_model_save.
+typedef opendsa_confusion_model_save_native = Int32 Function(Pointer<Void> model, Pointer<Utf8> path);
+typedef opendsa_confusion_model_save_dart = int Function(Pointer<Void> model, Pointer<Utf8> path);
+
+/// Binding per opendsa_confusion_model_observe.
+typedef opendsa_confusion_model_observe_native = Int32 Function(Pointer<Void> model, Pointer<Utf8> recognized, Pointer<Utf8> target);
+typedef opendsa_confusion_model_observe_dart = int Function(Pointer<Void> model, Pointer<Utf8> recognized, Pointer<Utf8> target);
+
+/// Binding per opendsa_confusion_model_free.
+typedef opendsa_confusion_model_free_native = Void Function(Pointer<Void> model);
+typedef opendsa_confusion_model_free_dart = void Function(Pointer<Void> model);
+
+/// Binding per opendsa_similarity_parameters_version.
+typedef opendsa_similarity_parameters_version_native = Int32 Function();
+typedef opendsa_similarity_parameters_version_dart = int Function();
+
+/// Binding per opendsa_similarity_with_model.
+typedef opendsa_similarity_with_model_native = Double Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<Void> model);
+typedef opendsa_similarity_with_model_dart = double Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<Void> model);
+
+/// Binding per opendsa_diagnose_with_model.
+typedef opendsa_diagnose_with_model_native = Int32 Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<Void> model, Pointer<OpendsaDiagnostics> out);
+typedef opendsa_diagnose_with_model_dart = int Function(Pointer<Utf8> recognized, Pointer<Utf8> target, Pointer<Void> model, Pointer<OpendsaDiagnostics> out);
+
+/// Binding per opendsa_rescore_start: avvia il ricalcolo in blocco dei tentativi.
+typedef opendsa_rescore_start_native = Pointer<Void> Function(Pointer<Pointer<Utf8>> recognized, Pointer<Pointer<Utf8>> targets, Int32 count, Pointer<Void> model, Int32 threads);
+typedef opendsa_rescore_start_dart = Pointer<Void> Function(Pointer<Pointer<Utf8>> recognized, Pointer<Pointer<Utf8>> targets, int count, Pointer<Void> model, int threads);
+
+/// Binding per opendsa_rescore_progress.
+typedef opendsa_rescore_progress_native = Int32 Function(Pointer<Void> job);
+typedef opendsa_rescore_progress_dart = int Function(Pointer<Void> job);
+
+/// Binding per opendsa_rescore_wait.
+typedef opendsa_rescore_wait_native = Int32 Function(Pointer<Void> job, Pointer<Double> out);
+typedef opendsa_rescore_wait_dart = int Function(Pointer<Void> job, Pointer<Double> out);
+
+/// Binding per opendsa_rescore_free.
+typedef opendsa_rescore_free_native = Void Function(Pointer<Void> job);
+typedef opendsa_rescore_free_dart = void Function(Pointer<Void> job);
+
+/// Binding per opendsa_word_features.
+typedef opendsa_word_features_native = Int32 Function(Pointer<Utf8> word, Pointer<OpendsaWordFeatures> out, Pointer<Int32> syllableStarts, Int32 capacity);
+typedef opendsa_word_features_dart = int Function(Pointer<Utf8> word, Pointer<OpendsaWordFeatures> out, Pointer<Int32> syllableStarts, int capacity);
+
+/// Binding per opendsa_lexicon_open.
+typedef opendsa_lexicon_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_lexicon_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_lexicon_size.
+typedef opendsa_lexicon_size_native = Int32 Function(Pointer<Void> lexicon);
+typedef opendsa_lexicon_size_dart = int Function(Pointer<Void> lexicon);
+
+/// Binding per opendsa_lexicon_entries.
+typedef opendsa_lexicon_entries_native = Pointer<OpendsaLexiconEntry> Function(Pointer<Void> lexicon);
+typedef opendsa_lexicon_entries_dart = Pointer<OpendsaLexiconEntry> Function(Pointer<Void> lexicon);
+
+/// Binding per opendsa_lexicon_strings.
+typedef opendsa_lexicon_strings_native = Pointer<Uint8> Function(Pointer<Void> lexicon);
+typedef opendsa_lexicon_strings_dart = Pointer<Uint8> Function(Pointer<Void> lexicon);
+
+/// Binding per opendsa_lexicon_pronunciations.
+typedef opendsa_lexicon_pronunciations_native = Pointer<OpendsaLexiconPronunciation> Function(Pointer<Void> lexicon);
+typedef opendsa_lexicon_pronunciations_dart = Pointer<OpendsaLexiconPronunciation> Function(Pointer<Void> lexicon);
+
+/// Binding per opendsa_lexicon_level_range.
+typedef opendsa_lexicon_level_range_native = Int32 Function(Pointer<Void> lexicon, Int32 level, Pointer<Int32> first);
+typedef opendsa_lexicon_level_range_dart = int Function(Pointer<Void> lexicon, int level, Pointer<Int32> first);
+
+/// Binding per opendsa_lexicon_similarity.
+typedef opendsa_lexicon_similarity_native = Double Function(Pointer<Void> lexicon, Int32 index, Pointer<Utf8> recognized, Pointer<Void> model);
+typedef opendsa_lexicon_similarity_dart = double Function(Pointer<Void> lexicon, int index, Pointer<Utf8> recognized, Pointer<Void> model);
+
+/// Binding per opendsa_lexicon_close.
+typedef opendsa_lexicon_close_native = Void Function(Pointer<Void> lexicon);
+typedef opendsa_lexicon_close_dart = void Function(Pointer<Void> lexicon);
+
+/// Binding per opendsa_pronounce.
+typedef opendsa_pronounce_native = Int32 Function(Pointer<Utf8> word, Pointer<Uint8> out, Int32 capacity);
+typedef opendsa_pronounce_dart = int Function(Pointer<Utf8> word, Pointer<Uint8> out, int capacity);
+
+/// Binding per opendsa_content_index_open.
+typedef opendsa_content_index_open_native = Pointer<Void> Function(Pointer<Void> lexicon, Pointer<Utf8> statePath, Uint64 seed);
+typedef opendsa_content_index_open_dart = Pointer<Void> Function(Pointer<Void> lexicon, Pointer<Utf8> statePath, int seed);
+
+/// Binding per opendsa_content_index_next.
+typedef opendsa_content_index_next_native = Int32 Function(Pointer<Void> index, Pointer<OpendsaWordQuery> query);
+typedef opendsa_content_index_next_dart = int Function(Pointer<Void> index, Pointer<OpendsaWordQuery> query);
+
+/// Binding per opendsa_content_index_count.
+typedef opendsa_content_index_count_native = Int32 Function(Pointer<Void> index, Pointer<OpendsaWordQuery> query);
+typedef opendsa_content_index_count_dart = int Function(Pointer<Void> index, Pointer<OpendsaWordQuery> query);
+
+/// Binding per opendsa_content_index_save.
+typedef opendsa_content_index_save_native = Int32 Function(Pointer<Void> index, Pointer<Utf8> path);
+typedef opendsa_content_index_save_dart = int Function(Pointer<Void> index, Pointer<Utf8> path);
+
+/// Binding per opendsa_content_index_free.
+typedef opendsa_content_index_free_native = Void Function(Pointer<Void> index);
+typedef opendsa_content_index_free_dart = void Function(Pointer<Void> index);
+
+/// Binding per opendsa_tokenize.
+typedef opendsa_tokenize_native = Pointer<Void> Function(Pointer<Utf8> text, Int32 length);
+typedef opendsa_tokenize_dart = Pointer<Void> Function(Pointer<Utf8> text, int length);
+
+/// Binding per opendsa_tokens_view.
+typedef opendsa_tokens_view_native = Int32 Function(Pointer<Void> tokens, Pointer<OpendsaTokenView> out);
+typedef opendsa_tokens_view_dart = int Function(Pointer<Void> tokens, Pointer<OpendsaTokenView> out);
+
+/// Binding per opendsa_tokens_align.
+typedef opendsa_tokens_align_native = Int32 Function(Pointer<Void> tokens, Int32 first, Int32 count, Pointer<Utf8> recognized, Pointer<Int32> out, Int32 capacity);
+typedef opendsa_tokens_align_dart = int Function(Pointer<Void> tokens, int first, int count, Pointer<Utf8> recognized, Pointer<Int32> out, int capacity);
+
+/// Binding per opendsa_tokens_free.
+typedef opendsa_tokens_free_native = Void Function(Pointer<Void> tokens);
+typedef opendsa_tokens_free_dart = void Function(Pointer<Void> tokens);
+
+/// Binding per opendsa_content_pack_open.
+typedef opendsa_content_pack_open_native = Pointer<Void> Function(Pointer<Utf8> path, Int32 cachedPages);
+typedef opendsa_content_pack_open_dart = Pointer<Void> Function(Pointer<Utf8> path, int cachedPages);
+
+/// Binding per opendsa_content_pack_size.
+typedef opendsa_content_pack_size_native = Int32 Function(Pointer<Void> pack);
+typedef opendsa_content_pack_size_dart = int Function(Pointer<Void> pack);
+
+/// Binding per opendsa_content_pack_page.
+typedef opendsa_content_pack_page_native = Pointer<Uint8> Function(Pointer<Void> pack, Int32 index, Pointer<Int32> length);
+typedef opendsa_content_pack_page_dart = Pointer<Uint8> Function(Pointer<Void> pack, int index, Pointer<Int32> length);
+
+/// Binding per opendsa_content_pack_tokens.
+typedef opendsa_content_pack_tokens_native = Pointer<Void> Function(Pointer<Void> pack, Int32 index);
+typedef opendsa_content_pack_tokens_dart = Pointer<Void> Function(Pointer<Void> pack, int index);
+
+/// Binding per opendsa_content_pack_close.
+typedef opendsa_content_pack_close_native = Void Function(Pointer<Void> pack);
+typedef opendsa_content_pack_close_dart = void Function(Pointer<Void> pack);
+
+/// Binding per opendsa_profile_log_open.
+typedef opendsa_profile_log_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_profile_log_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_profile_log_size.
+typedef opendsa_profile_log_size_native = Int32 Function(Pointer<Void> log);
+typedef opendsa_profile_log_size_dart = int Function(Pointer<Void> log);
+
+/// Binding per opendsa_profile_log_entry.
+typedef opendsa_profile_log_entry_native = Int32 Function(Pointer<Void> log, Int32 index, Pointer<OpendsaProfileEntry> out);
+typedef opendsa_profile_log_entry_dart = int Function(Pointer<Void> log, int index, Pointer<OpendsaProfileEntry> out);
+
+/// Binding per opendsa_profile_log_put.
+typedef opendsa_profile_log_put_native = Int32 Function(Pointer<Void> log, Pointer<Utf8> key, Pointer<Utf8> value, Int32 length);
+typedef opendsa_profile_log_put_dart = int Function(Pointer<Void> log, Pointer<Utf8> key, Pointer<Utf8> value, int length);
+
+/// Binding per opendsa_profile_log_remove.
+typedef opendsa_profile_log_remove_native = Int32 Function(Pointer<Void> log, Pointer<Utf8> key);
+typedef opendsa_profile_log_remove_dart = int Function(Pointer<Void> log, Pointer<Utf8> key);
+
+/// Binding per opendsa_profile_log_set_commit_window.
+typedef opendsa_profile_log_set_commit_window_native = Void Function(Pointer<Void> log, Int32 milliseconds);
+typedef opendsa_profile_log_set_commit_window_dart = void Function(Pointer<Void> log, int milliseconds);
+
+/// Binding per opendsa_profile_log_flush.
+typedef opendsa_profile_log_flush_native = Int32 Function(Pointer<Void> log);
+typedef opendsa_profile_log_flush_dart = int Function(Pointer<Void> log);
+
+/// Binding per opendsa_profile_log_compact.
+typedef opendsa_profile_log_compact_native = Int32 Function(Pointer<Void> log);
+typedef opendsa_profile_log_compact_dart = int Function(Pointer<Void> log);
+
+/// Binding per opendsa_profile_log_stats.
+typedef opendsa_profile_log_stats_native = Void Function(Pointer<Void> log, Pointer<OpendsaProfileLogStats> out);
+typedef opendsa_profile_log_stats_dart = void Function(Pointer<Void> log, Pointer<OpendsaProfileLogStats> out);
+
+/// Binding per opendsa_profile_log_export_binary.
+typedef opendsa_profile_log_export_binary_native = Int32 Function(Pointer<Void> log, Pointer<Utf8> path);
+typedef opendsa_profile_log_export_binary_dart = int Function(Pointer<Void> log, Pointer<Utf8> path);
+
+/// Binding per opendsa_profile_log_close.
+typedef opendsa_profile_log_close_native = Void Function(Pointer<Void> log);
+typedef opendsa_profile_log_close_dart = void Function(Pointer<Void> log);
+
+/// Binding per opendsa_binary_profile_import.
+typedef opendsa_binary_profile_import_native = Int32 Function(Pointer<Utf8> json, Int32 length, Pointer<Utf8> path);
+typedef opendsa_binary_profile_import_dart = int Function(Pointer<Utf8> json, int length, Pointer<Utf8> path);
+
+/// Binding per opendsa_binary_profile_open.
+typedef opendsa_binary_profile_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_binary_profile_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_binary_profile_root.
+typedef opendsa_binary_profile_root_native = Int32 Function(Pointer<Void> profile);
+typedef opendsa_binary_profile_root_dart = int Function(Pointer<Void> profile);
+
+/// Binding per opendsa_binary_profile_find.
+typedef opendsa_binary_profile_find_native = Int32 Function(Pointer<Void> profile, Int32 object, Pointer<Utf8> key);
+typedef opendsa_binary_profile_find_dart = int Function(Pointer<Void> profile, int object, Pointer<Utf8> key);
+
+/// Binding per opendsa_binary_profile_element, member_key e member_value.
+typedef opendsa_binary_profile_child_native = Int32 Function(Pointer<Void> profile, Int32 node, Int32 index);
+typedef opendsa_binary_profile_child_dart = int Function(Pointer<Void> profile, int node, int index);
+
+/// Binding per opendsa_binary_profile_node.
+typedef opendsa_binary_profile_node_native = Int32 Function(Pointer<Void> profile, Int32 node, Pointer<OpendsaProfileValue> out);
+typedef opendsa_binary_profile_node_dart = int Function(Pointer<Void> profile, int node, Pointer<OpendsaProfileValue> out);
+
+/// Binding per opendsa_binary_profile_to_json.
+typedef opendsa_binary_profile_to_json_native = Pointer<Utf8> Function(Pointer<Void> profile, Int32 node, Pointer<Int32> length);
+typedef opendsa_binary_profile_to_json_dart = Pointer<Utf8> Function(Pointer<Void> profile, int node, Pointer<Int32> length);
+
+/// Binding per opendsa_binary_profile_close.
+typedef opendsa_binary_profile_close_native = Void Function(Pointer<Void> profile);
+typedef opendsa_binary_profile_close_dart = void Function(Pointer<Void> profile);
+
+/// Binding per opendsa_accuracy_series_open.
+typedef opendsa_accuracy_series_open_native = Pointer<Void> Function(Pointer<Utf8> path, Double threshold);
+typedef opendsa_accuracy_series_open_dart = Pointer<Void> Function(Pointer<Utf8> path, double threshold);
+
+/// Binding per opendsa_accuracy_series_record.
+typedef opendsa_accuracy_series_record_native = Int32 Function(Pointer<Void> series, Int32 day, Double accuracy);
+typedef opendsa_accuracy_series_record_dart = int Function(Pointer<Void> series, int day, double accuracy);
+
+/// Binding per opendsa_accuracy_series_set_days e opendsa_accuracy_series_assign.
+typedef opendsa_accuracy_series_days_native = Int32 Function(Pointer<Void> series, Pointer<Int32> days, Pointer<Double> values, Int32 count);
+typedef opendsa_accuracy_series_days_dart = int Function(Pointer<Void> series, Pointer<Int32> days, Pointer<Double> values, int count);
+
+/// Binding per opendsa_accuracy_series_summary.
+typedef opendsa_accuracy_series_summary_native = Void Function(Pointer<Void> series, Pointer<OpendsaAccuracySummary> out);
+typedef opendsa_accuracy_series_summary_dart = void Function(Pointer<Void> series, Pointer<OpendsaAccuracySummary> out);
+
+/// Binding per opendsa_accuracy_series_window_average.
+typedef opendsa_accuracy_series_window_average_native = Double Function(Pointer<Void> series, Int32 days);
+typedef opendsa_accuracy_series_window_average_dart = double Function(Pointer<Void> series, int days);
+
+/// Binding per opendsa_accuracy_series_day.
+typedef opendsa_accuracy_series_day_native = Int32 Function(Pointer<Void> series, Int32 index, Pointer<OpendsaAccuracyDay> out);
+typedef opendsa_accuracy_series_day_dart = int Function(Pointer<Void> series, int index, Pointer<OpendsaAccuracyDay> out);
+
+/// Binding per opendsa_accuracy_series_week_count.
+typedef opendsa_accuracy_series_week_count_native = Int32 Function(Pointer<Void> series);
+typedef opendsa_accuracy_series_week_count_dart = int Function(Pointer<Void> series);
+
+/// Binding per opendsa_accuracy_series_week.
+typedef opendsa_accuracy_series_week_native = Int32 Function(Pointer<Void> series, Int32 index, Pointer<OpendsaAccuracyWeek> out);
+typedef opendsa_accuracy_series_week_dart = int Function(Pointer<Void> series, int index, Pointer<OpendsaAccuracyWeek> out);
+
+/// Binding per opendsa_accuracy_series_close.
+typedef opendsa_accuracy_series_close_native = Void Function(Pointer<Void> series);
+typedef opendsa_accuracy_series_close_dart = void Function(Pointer<Void> series);
+
+/// Binding per opendsa_analytics_open.
+typedef opendsa_analytics_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_analytics_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_analytics_record.
+typedef opendsa_analytics_record_native = Int32 Function(Pointer<Void> analytics, Double similarity, Int64 durationMs, Int32 correct, Pointer<Utf8> recognized, Pointer<Utf8> target);
+typedef opendsa_analytics_record_dart = int Function(Pointer<Void> analytics, double similarity, int durationMs, int correct, Pointer<Utf8> recognized, Pointer<Utf8> target);
+
+/// Binding per opendsa_analytics_start_session.
+typedef opendsa_analytics_start_session_native = Int32 Function(Pointer<Void> analytics, Int64 startMs);
+typedef opendsa_analytics_start_session_dart = int Function(Pointer<Void> analytics, int startMs);
+
+/// Binding per opendsa_analytics_session_start.
+typedef opendsa_analytics_session_start_native = Int64 Function(Pointer<Void> analytics);
+typedef opendsa_analytics_session_start_dart = int Function(Pointer<Void> analytics);
+
+/// Binding per opendsa_analytics_stats.
+typedef opendsa_analytics_stats_native = Int32 Function(Pointer<Void> analytics, Int32 scope, Pointer<OpendsaAnalyticsStats> out);
+typedef opendsa_analytics_stats_dart = int Function(Pointer<Void> analytics, int scope, Pointer<OpendsaAnalyticsStats> out);
+
+/// Binding per opendsa_analytics_import.
+typedef opendsa_analytics_import_native = Int32 Function(Pointer<Void> analytics, Pointer<OpendsaAnalyticsStats> stats);
+typedef opendsa_analytics_import_dart = int Function(Pointer<Void> analytics, Pointer<OpendsaAnalyticsStats> stats);
+
+/// Binding per opendsa_analytics_reset e opendsa_analytics_flush.
+typedef opendsa_analytics_action_native = Int32 Function(Pointer<Void> analytics);
+typedef opendsa_analytics_action_dart = int Function(Pointer<Void> analytics);
+
+/// Binding per opendsa_analytics_close.
+typedef opendsa_analytics_close_native = Void Function(Pointer<Void> analytics);
+typedef opendsa_analytics_close_dart = void Function(Pointer<Void> analytics);
+
+/// Binding per opendsa_attempt_log_open: apre o crea il registro dei
+/// tentativi.
+typedef opendsa_attempt_log_open_native = Pointer<Void> Function(Pointer<Utf8> path);
+typedef opendsa_attempt_log_open_dart = Pointer<Void> Function(Pointer<Utf8> path);
+
+/// Binding per opendsa_attempt_log_append.
+typedef opendsa_attempt_log_append_native = Int32 Function(Pointer<Void> log, Pointer<OpendsaAttempt> attempt);
+typedef opendsa_attempt_log_append_dart = int Function(Pointer<Void> log, Pointer<OpendsaAttempt> attempt);
+
+/// Binding per opendsa_attempt_log_query.
+typedef opendsa_attempt_log_query_native = Int32 Function(Pointer<Void> log, Pointer<OpendsaAttemptQuery> query, Pointer<OpendsaAttemptQueryStats> stats);
+typedef opendsa_attempt_log_query_dart = int Function(Pointer<Void> log, Pointer<OpendsaAttemptQuery> query, Pointer<OpendsaAttemptQueryStats> stats);
+
+/// Binding per opendsa_attempt_log_group.
+typedef opendsa_attempt_log_group_native = Int32 Function(Pointer<Void> log, Int32 index, Pointer<OpendsaAttemptGroup> out);
+typedef opendsa_attempt_log_group_dart = int Function(Pointer<Void> log, int index, Pointer<OpendsaAttemptGroup> out);
+
+/// Binding per opendsa_attempt_log_string.
+typedef opendsa_attempt_log_string_native = Pointer<Utf8> Function(Pointer<Void> log, Int64 id);
+typedef opendsa_attempt_log_string_dart = Pointer<Utf8> Function(Pointer<Void> log, int id);
+
+/// Binding per opendsa_attempt_log_size.
+typedef opendsa_attempt_log_size_native = Int64 Function(Pointer<Void> log);
+typedef opendsa_attempt_log_size_dart = int Function(Pointer<Void> log);
+
+/// Binding per opendsa_attempt_log_level_summary e
+/// opendsa_attempt_log_day_summary.
+typedef opendsa_attempt_log_summary_native = Int32 Function(Pointer<Void> log, Pointer<Utf8> profile, Int32 key, Pointer<OpendsaAttemptSummary> out);
+typedef opendsa_attempt_log_summary_dart = int Function(Pointer<Void> log, Pointer<Utf8> profile, int key, Pointer<OpendsaAttemptSummary> out);
+
+/// Binding per opendsa_attempt_log_close.
+typedef opendsa_attempt_log_close_native = Void Function(Pointer<Void> log);
+typedef opendsa_attempt_log_close_dart = void Function(Pointer<Void> log);
+
+/// Binding per opendsa_session_journal_open: apre o crea il journal della
+/// sessione di allenamento.
+typedef opendsa_session_journal_open_native = Pointer<Void> Function(Pointer<Utf8> path, Int32 syncWindowMs);
+typedef opendsa_session_journal_open_dart = Pointer<Void> Function(Pointer<Utf8> path, int syncWindowMs);
+
+/// Binding per opendsa_session_journal_count.
+typedef opendsa_session_journal_count_native = Int32 Function(Pointer<Void> journal);
+typedef opendsa_session_journal_count_dart = int Function(Pointer<Void> journal);
+
+/// Binding per opendsa_session_journal_record.
+typedef opendsa_session_journal_record_native = Int32 Function(Pointer<Void> journal, Int32 index, Pointer<Int32> type, Pointer<Pointer<Uint8>> data, Pointer<Int32> length);
+typedef opendsa_session_journal_record_dart = int Function(Pointer<Void> journal, int index, Pointer<Int32> type, Pointer<Pointer<Uint8>> data, Pointer<Int32> length);
+
+/// Binding per opendsa_session_journal_begin e opendsa_session_journal_append.
+typedef opendsa_session_journal_write_native = Int32 Function(Pointer<Void> journal, Pointer<Uint8> data, Int32 length);
+typedef opendsa_session_journal_write_dart = int Function(Pointer<Void> journal, Pointer<Uint8> data, int length);
+
+/// Binding per opendsa_session_journal_sync e opendsa_session_journal_commit.
+typedef opendsa_session_journal_action_native = Int32 Function(Pointer<Void> journal);
+typedef opendsa_session_journal_action_dart = int Function(Pointer<Void> journal);
+
+/// Binding per opendsa_session_journal_close.
+typedef opendsa_session_journal_close_native = Void Function(Pointer<Void> journal);
+typedef opendsa_session_journal_close_dart = void Function(Pointer<Void> journal);
+
+/// Binding per opendsa_logger_open: apre il log dei servizi.
+typedef opendsa_logger_open_native = Pointer<Void> Function(Pointer<Utf8> dir, Pointer<Utf8> prefix, Pointer<OpendsaLoggerOptions> options);
+typedef opendsa_logger_open_dart = Pointer<Void> Function(Pointer<Utf8> dir, Pointer<Utf8> prefix, Pointer<OpendsaLoggerOptions> options);
+
+/// Binding per opendsa_logger_log.
+typedef opendsa_logger_log_native = Int32 Function(Pointer<Void> logger, Int32 level, Pointer<Utf8> tag, Pointer<Uint8> message, Int32 length);
+typedef opendsa_logger_log_dart = int Function(Pointer<Void> logger, int level, Pointer<Utf8> tag, Pointer<Uint8> message, int length);
+
+/// Binding per opendsa_logger_flush e opendsa_logger_recent.
+typedef opendsa_logger_action_native = Int32 Function(Pointer<Void> logger, Int32 value);
+typedef opendsa_logger_action_dart = int Function(Pointer<Void> logger, int value);
+
+/// Binding per opendsa_logger_query.
+typedef opendsa_logger_query_native = Int32 Function(Pointer<Void> logger, Pointer<OpendsaLogQuery> query, Pointer<OpendsaLogQueryStats> stats);
+typedef opendsa_logger_query_dart = int Function(Pointer<Void> logger, Pointer<OpendsaLogQuery> query, Pointer<OpendsaLogQueryStats> stats);
+
+/// Binding per opendsa_logger_line.
+typedef opendsa_logger_line_native = Pointer<Utf8> Function(Pointer<Void> logger, Int32 index);
+typedef opendsa_logger_line_dart = Pointer<Utf8> Function(Pointer<Void> logger, int index);
+
+/// Binding per opendsa_logger_read_day.
+typedef opendsa_logger_read_day_native = Pointer<Uint8> Function(Pointer<Void> logger, Pointer<Utf8> date, Pointer<Int64> length);
+typedef opendsa_logger_read_day_dart = Pointer<Uint8> Function(Pointer<Void> logger, Pointer<Utf8> date, Pointer<Int64> length);
+
+/// Binding per opendsa_logger_stats.
+typedef opendsa_logger_stats_native = Void Function(Pointer<Void> logger, Pointer<OpendsaLoggerStats> out);
+typedef opendsa_logger_stats_dart = void Function(Pointer<Void> logger, Pointer<OpendsaLoggerStats> out);
+
+/// Binding per opendsa_logger_close.
+typedef opendsa_logger_close_native = Void Function(Pointer<Void> logger);
+typedef opendsa_logger_close_dart = void Function(Pointer<Void> logger);
+
+/// Binding per opendsa_audio_archive_open: apre l'archivio delle
+/// registrazioni.
+typedef opendsa_audio_archive_open_native = Pointer<Void> Function(Pointer<Utf8> dir, Pointer<OpendsaAudioArchiveOptions> options);
+typedef opendsa_audio_archive_open_dart = Pointer<Void> Function(Pointer<Utf8> dir, Pointer<OpendsaAudioArchiveOptions> options);
+
+/// Binding per opendsa_audio_archive_add_wav.
+typedef opendsa_audio_archive_add_wav_native = Int64 Function(Pointer<Void> archive, Pointer<Utf8> wavPath, Pointer<Utf8> profile, Pointer<Utf8> target, Int64 recordedMs);
+typedef opendsa_audio_archive_add_wav_dart = int Function(Pointer<Void> archive, Pointer<Utf8> wavPath, Pointer<Utf8> profile, Pointer<Utf8> target, int recordedMs);
+
+/// Binding per opendsa_audio_archive_add_wav_start.
+typedef opendsa_audio_archive_add_wav_start_native = Pointer<Void> Function(Pointer<Void> archive, Pointer<Utf8> wavPath, Pointer<Utf8> profile, Pointer<Utf8> target, Int64 recordedMs);
+typedef opendsa_audio_archive_add_wav_start_dart = Pointer<Void> Function(Pointer<Void> archive, Pointer<Utf8> wavPath, Pointer<Utf8> profile, Pointer<Utf8> target, int recordedMs);
+
+/// Binding per opendsa_audio_archive_add_done.
+typedef opendsa_audio_archive_add_done_native = Int32 Function(Pointer<Void> job);
+typedef opendsa_audio_archive_add_done_dart = int Function(Pointer<Void> job);
+
+/// Binding per opendsa_audio_archive_add_wait.
+typedef opendsa_audio_archive_add_wait_native = Int64 Function(Pointer<Void> job);
+typedef opendsa_audio_archive_add_wait_dart = int Function(Pointer<Void> job);
+
+/// Binding per opendsa_audio_archive_add_free.
+typedef opendsa_audio_archive_add_free_native = Void Function(Pointer<Void> job);
+typedef opendsa_audio_archive_add_free_dart = void Function(Pointer<Void> job);
+
+/// Binding per opendsa_audio_archive_list.
+typedef opendsa_audio_archive_list_native = Int32 Function(Pointer<Void> archive, Pointer<Utf8> profile, Pointer<Utf8> target);
+typedef opendsa_audio_archive_list_dart = int Function(Pointer<Void> archive, Pointer<Utf8> profile, Pointer<Utf8> target);
+
+/// Binding per opendsa_audio_archive_clip.
+typedef opendsa_audio_archive_clip_native = Int32 Function(Pointer<Void> archive, Int32 index, Pointer<OpendsaAudioClip> out);
+typedef opendsa_audio_archive_clip_dart = int Function(Pointer<Void> archive, int index, Pointer<OpendsaAudioClip> out);
+
+/// Binding per opendsa_audio_archive_export_wav.
+typedef opendsa_audio_archive_export_wav_native = Int32 Function(Pointer<Void> archive, Int64 id, Int64 nowMs, Pointer<Utf8> wavPath);
+typedef opendsa_audio_archive_export_wav_dart = int Function(Pointer<Void> archive, int id, int nowMs, Pointer<Utf8> wavPath);
+
+/// Binding per opendsa_audio_archive_remove e opendsa_audio_archive_evict.
+typedef opendsa_audio_archive_action_native = Int32 Function(Pointer<Void> archive, Int64 value);
+typedef opendsa_audio_archive_action_dart = int Function(Pointer<Void> archive, int value);
+
+/// Binding per opendsa_audio_archive_stats.
+typedef opendsa_audio_archive_stats_native = Void Function(Pointer<Void> archive, Pointer<OpendsaAudioArchiveStats> out);
+typedef opendsa_audio_archive_stats_dart = void Function(Pointer<Void> archive, Pointer<OpendsaAudioArchiveStats> out);
+
+/// Binding per opendsa_audio_archive_close.
+typedef opendsa_audio_archive_close_native = Void Function(Pointer<Void> archive);
+typedef opendsa_audio_archive_close_dart = void Function(Pointer<Void> archive);
+
+/// Binding per opendsa_speech_model_open: avvia il caricamento del modello
+/// di libvosk.
+typedef opendsa_speech_model_open_native = Pointer<Void> Function(Pointer<Utf8> dir);
+typedef opendsa_speech_model_open_dart = Pointer<Void> Function(Pointer<Utf8> dir);
+
+/// Binding per opendsa_speech_model_ready.
+typedef opendsa_speech_model_ready_native = Int32 Function(Pointer<Void> model);
+typedef opendsa_speech_model_ready_dart = int Function(Pointer<Void> model);
+
+/// Binding per opendsa_speech_model_close.
+typedef opendsa_speech_model_close_native = Void Function(Pointer<Void> model);
+typedef opendsa_speech_model_close_dart = void Function(Pointer<Void> model);
+
+/// Binding per opendsa_recognize_file_start: avvia il riconoscimento di un
+/// WAV su un thread nativo.
+typedef opendsa_recognize_file_start_native = Pointer<Void> Function(Pointer<Void> model, Pointer<Utf8> wavPath, Int32 chunkMs);
+typedef opendsa_recognize_file_start_dart = Pointer<Void> Function(Pointer<Void> model, Pointer<Utf8> wavPath, int chunkMs);
+
+/// Binding per opendsa_recognize_file_progress.
+typedef opendsa_recognize_file_progress_native = Double Function(Pointer<Void> recognition);
+typedef opendsa_recognize_file_progress_dart = double Function(Pointer<Void> recognition);
+
+/// Binding per opendsa_recognize_file_wait.
+typedef opendsa_recognize_file_wait_native = Int32 Function(Pointer<Void> recognition, Pointer<OpendsaFileRecognitionResult> out);
+typedef opendsa_recognize_file_wait_dart = int Function(Pointer<Void> recognition, Pointer<OpendsaFileRecognitionResult> out);
+
+/// Binding per opendsa_recognize_file_word.
+typedef opendsa_recognize_file_word_native = Int32 Function(Pointer<Void> recognition, Int32 index, Pointer<OpendsaRecognizedWord> out);
+typedef opendsa_recognize_file_word_dart = int Function(Pointer<Void> recognition, int index, Pointer<OpendsaRecognizedWord> out);
+
+/// Binding per opendsa_recognize_file_free.
+typedef opendsa_recognize_file_free_native = Void Function(Pointer<Void> recognition);
+typedef opendsa_recognize_file_free_dart = void Function(Pointer<Void> recognition);
+
+/// La classe [OpenDsaNativeLibrary] fornisce l'accesso alle funzioni della
+/// libreria nativa. Usare [OpenDsaNativeLibrary.instance], che vale null se la
+/// libreria non è disponibile sulla piattaforma corrente.
+class OpenDsaNativeLibrary {
+  static const String _libraryName = 'libopendsa_native.so';
+
+  static OpenDsaNativeLibrary? _instance;
+  static bool _loadAttempted = false;
+
+  final DynamicLibrary _dylib;
+
+  OpenDsaNativeLibrary._(this._dylib);
+
+  /// Factory constructor per creare un'istanza a partire da un DynamicLibrary già aperto.
+  factory OpenDsaNativeLibrary.fromDynamicLibrary(DynamicLibrary dylib) {
+    return OpenDsaNativeLibrary._(dylib);
+  }
+
+  /// Istanza condivisa, caricata al primo accesso. Restituisce null se la
+  /// libreria non può essere caricata: i chiamanti usano allora il percorso Dart.
+  static OpenDsaNativeLibrary? get instance {
+    if (!_loadAttempted) {
+      _loadAttempted = true;
+      _instance = _load();
+    }
+    return _instance;
+  }
+
+  static OpenDsaNativeLibrary? _load() {
+    if (!Platform.isLinux) return null;
+    final candidates = <String>[
+      if (Platform.environment['OPENDSA_NATIVE_PATH'] != null)
+        Platform.environment['OPENDSA_NATIVE_PATH']!,
+      path.join(File(Platform.resolvedExecutable).parent.path, 'lib', _libraryName),
+      _libraryName,
+    ];
+    for (final candidate in candidates) {
+      try {
+        return OpenDsaNativeLibrary._(DynamicLibrary.open(candidate));
+      } catch (e) {
+        debugPrint('OpenDsaNativeLibrary: impossibile caricare $candidate: $e');
+      }
+    }
+    return null;
+  }
+
+  // Lookup delle funzioni native.
+  late final opendsa_similarity = _dylib.lookupFunction<opendsa_similarity_native, opendsa_similarity_dart>('opendsa_similarity');
+  late final opendsa_diagnose = _dylib.lookupFunction<opendsa_diagnose_native, opendsa_diagnose_dart>('opendsa_diagnose');
+  late final opendsa_similarity_parameters_version = _dylib.lookupFunction<opendsa_similarity_parameters_version_native, opendsa_similarity_parameters_version_dart>('opendsa_similarity_parameters_version');
+  late final opendsa_similarity_with_model = _dylib.lookupFunction<opendsa_similarity_with_model_native, opendsa_similarity_with_model_dart>('opendsa_similarity_with_model');
+  late final opendsa_diagnose_with_model = _dylib.lookupFunction<opendsa_diagnose_with_model_native, opendsa_diagnose_with_model_dart>('opendsa_diagnose_with_model');
+
+  late final opendsa_confusion_model_open = _dylib.lookupFunction<opendsa_confusion_model_open_native, opendsa_confusion_model_open_dart>('opendsa_confusion_model_open');
+  late final opendsa_confusion_model_save = _dylib.lookupFunction<opendsa_confusion_model_save_native, opendsa_confusion_model_save_dart>('opendsa_confusion_model_save');
+  late final opendsa_confusion_model_observe = _dylib.lookupFunction<opendsa_confusion_model_observe_native, opendsa_confusion_model_observe_dart>('opendsa_confusion_model_observe');
+  late final opendsa_confusion_model_free = _dylib.lookupFunction<opendsa_confusion_model_free_native, opendsa_confusion_model_free_dart>('opendsa_confusion_model_free');
+
+  late final opendsa_rescore_start = _dylib.lookupFunction<opendsa_rescore_start_native, opendsa_rescore_start_dart>('opendsa_rescore_start');
+  late final opendsa_rescore_progress = _dylib.lookupFunction<opendsa_rescore_progress_native, opendsa_rescore_progress_dart>('opendsa_rescore_progress');
+  late final opendsa_rescore_wait = _dylib.lookupFunction<opendsa_rescore_wait_native, opendsa_rescore_wait_dart>('opendsa_rescore_wait');
+  late final opendsa_rescore_free = _dylib.lookupFunction<opendsa_rescore_free_native, opendsa_rescore_free_dart>('opendsa_rescore_free');
+
+  late final opendsa_word_features = _dylib.lookupFunction<opendsa_word_features_native, opendsa_word_features_dart>('opendsa_word_features');
+
+  late final opendsa_lexicon_open = _dylib.lookupFunction<opendsa_lexicon_open_native, opendsa_lexicon_open_dart>('opendsa_lexicon_open');
+  late final opendsa_lexicon_size = _dylib.lookupFunction<opendsa_lexicon_size_native, opendsa_lexicon_size_dart>('opendsa_lexicon_size');
+  late final opendsa_lexicon_entries = _dylib.lookupFunction<opendsa_lexicon_entries_native, opendsa_lexicon_entries_dart>('opendsa_lexicon_entries');
+  late final opendsa_lexicon_strings = _dylib.lookupFunction<opendsa_lexicon_strings_native, opendsa_lexicon_strings_dart>('opendsa_lexicon_strings');
+  late final opendsa_lexicon_pronunciations = _dylib.lookupFunction<opendsa_lexicon_pronunciations_native, opendsa_lexicon_pronunciations_dart>('opendsa_lexicon_pronunciations');
+  late final opendsa_lexicon_level_range = _dylib.lookupFunction<opendsa_lexicon_level_range_native, opendsa_lexicon_level_range_dart>('opendsa_lexicon_level_range');
+  late final opendsa_lexicon_similarity = _dylib.lookupFunction<opendsa_lexicon_similarity_native, opendsa_lexicon_similarity_dart>('opendsa_lexicon_similarity');
+  late final opendsa_lexicon_close = _dylib.lookupFunction<opendsa_lexicon_close_native, opendsa_lexicon_close_dart>('opendsa_lexicon_close');
+
+  late final opendsa_pronounce = _dylib.lookupFunction<opendsa_pronounce_native, opendsa_pronounce_dart>('opendsa_pronounce');
+  late final opendsa_content_index_open = _dylib.lookupFunction<opendsa_content_index_open_native, opendsa_content_index_open_dart>('opendsa_content_index_open');
+  late final opendsa_content_index_next = _dylib.lookupFunction<opendsa_content_index_next_native, opendsa_content_index_next_dart>('opendsa_content_index_next');
+  late final opendsa_content_index_count = _dylib.lookupFunction<opendsa_content_index_count_native, opendsa_content_index_count_dart>('opendsa_content_index_count');
+  late final opendsa_content_index_save = _dylib.lookupFunction<opendsa_content_index_save_native, opendsa_content_index_save_dart>('opendsa_content_index_save');
+  late final opendsa_content_index_free = _dylib.lookupFunction<opendsa_content_index_free_native, opendsa_content_index_free_dart>('opendsa_content_index_free');
+  late final opendsa_tokenize = _dylib.lookupFunction<opendsa_tokenize_native, opendsa_tokenize_dart>('opendsa_tokenize');
+  late final opendsa_tokens_view = _dylib.lookupFunction<opendsa_tokens_view_native, opendsa_tokens_view_dart>('opendsa_tokens_view');
+  late final opendsa_tokens_align = _dylib.lookupFunction<opendsa_tokens_align_native, opendsa_tokens_align_dart>('opendsa_tokens_align');
+  late final opendsa_tokens_free = _dylib.lookupFunction<opendsa_tokens_free_native, opendsa_tokens_free_dart>('opendsa_tokens_free');
+  late final opendsa_content_pack_open = _dylib.lookupFunction<opendsa_content_pack_open_native, opendsa_content_pack_open_dart>('opendsa_content_pack_open');
+  late final opendsa_content_pack_size = _dylib.lookupFunction<opendsa_content_pack_size_native, opendsa_content_pack_size_dart>('opendsa_content_pack_size');
+  late final opendsa_content_pack_page = _dylib.lookupFunction<opendsa_content_pack_page_native, opendsa_content_pack_page_dart>('opendsa_content_pack_page');
+  late final opendsa_content_pack_tokens = _dylib.lookupFunction<opendsa_content_pack_tokens_native, opendsa_content_pack_tokens_dart>('opendsa_content_pack_tokens');
+  late final opendsa_content_pack_close = _dylib.lookupFunction<opendsa_content_pack_close_native, opendsa_content_pack_close_dart>('opendsa_content_pack_close');
+  late final opendsa_profile_log_open = _dylib.lookupFunction<opendsa_profile_log_open_native, opendsa_profile_log_open_dart>('opendsa_profile_log_open');
+  late final opendsa_profile_log_size = _dylib.lookupFunction<opendsa_profile_log_size_native, opendsa_profile_log_size_dart>('opendsa_profile_log_size');
+  late final opendsa_profile_log_entry = _dylib.lookupFunction<opendsa_profile_log_entry_native, opendsa_profile_log_entry_dart>('opendsa_profile_log_entry');
+  late final opendsa_profile_log_put = _dylib.lookupFunction<opendsa_profile_log_put_native, opendsa_profile_log_put_dart>('opendsa_profile_log_put');
+  late final opendsa_profile_log_remove = _dylib.lookupFunction<opendsa_profile_log_remove_native, opendsa_profile_log_remove_dart>('opendsa_profile_log_remove');
+  late final opendsa_profile_log_set_commit_window = _dylib.lookupFunction<opendsa_profile_log_set_commit_window_native, opendsa_profile_log_set_commit_window_dart>('opendsa_profile_log_set_commit_window');
+  late final opendsa_profile_log_flush = _dylib.lookupFunction<opendsa_profile_log_flush_native, opendsa_profile_log_flush_dart>('opendsa_profile_log_flush');
+  late final opendsa_profile_log_compact = _dylib.lookupFunction<opendsa_profile_log_compact_native, opendsa_profile_log_compact_dart>('opendsa_profile_log_compact');
+  late final opendsa_profile_log_stats = _dylib.lookupFunction<opendsa_profile_log_stats_native, opendsa_profile_log_stats_dart>('opendsa_profile_log_stats');
+  late final opendsa_profile_log_export_binary = _dylib.lookupFunction<opendsa_profile_log_export_binary_native, opendsa_profile_log_export_binary_dart>('opendsa_profile_log_export_binary');
+  late final opendsa_profile_log_close = _dylib.lookupFunction<opendsa_profile_log_close_native, opendsa_profile_log_close_dart>('opendsa_profile_log_close');
+  late final opendsa_binary_profile_import = _dylib.lookupFunction<opendsa_binary_profile_import_native, opendsa_binary_profile_import_dart>('opendsa_binary_profile_import');
+  late final opendsa_binary_profile_open = _dylib.lookupFunction<opendsa_binary_profile_open_native, opendsa_binary_profile_open_dart>('opendsa_binary_profile_open');
+  late final opendsa_binary_profile_root = _dylib.lookupFunction<opendsa_binary_profile_root_native, opendsa_binary_profile_root_dart>('opendsa_binary_profile_root');
+  late final opendsa_binary_profile_find = _dylib.lookupFunction<opendsa_binary_profile_find_native, opendsa_binary_profile_find_dart>('opendsa_binary_profile_find');
+  late final opendsa_binary_profile_element = _dylib.lookupFunction<opendsa_binary_profile_child_native, opendsa_binary_profile_child_dart>('opendsa_binary_profile_element');
+  late final opendsa_binary_profile_member_key = _dylib.lookupFunction<opendsa_binary_profile_child_native, opendsa_binary_profile_child_dart>('opendsa_binary_profile_member_key');
+  late final opendsa_binary_profile_member_value = _dylib.lookupFunction<opendsa_binary_profile_child_native, opendsa_binary_profile_child_dart>('opendsa_binary_profile_member_value');
+  late final opendsa_binary_profile_node = _dylib.lookupFunction<opendsa_binary_profile_node_native, opendsa_binary_profile_node_dart>('opendsa_binary_profile_node');
+  late final opendsa_binary_profile_to_json = _dylib.lookupFunction<opendsa_binary_profile_to_json_native, opendsa_binary_profile_to_json_dart>('opendsa_binary_profile_to_json');
+  late final opendsa_binary_profile_close = _dylib.lookupFunction<opendsa_binary_profile_close_native, opendsa_binary_profile_close_dart>('opendsa_binary_profile_close');
+  late final opendsa_accuracy_series_open = _dylib.lookupFunction<opendsa_accuracy_series_open_native, opendsa_accuracy_series_open_dart>('opendsa_accuracy_series_open');
+  late final opendsa_accuracy_series_record = _dylib.lookupFunction<opendsa_accuracy_series_record_native, opendsa_accuracy_series_record_dart>('opendsa_accuracy_series_record');
+  late final opendsa_accuracy_series_set_days = _dylib.lookupFunction<opendsa_accuracy_series_days_native, opendsa_accuracy_series_days_dart>('opendsa_accuracy_series_set_days');
+  late final opendsa_accuracy_series_assign = _dylib.lookupFunction<opendsa_accuracy_series_days_native, opendsa_accuracy_series_days_dart>('opendsa_accuracy_series_assign');
+  late final opendsa_accuracy_series_summary = _dylib.lookupFunction<opendsa_accuracy_series_summary_native, opendsa_accuracy_series_summary_dart>('opendsa_accuracy_series_summary');
+  late final opendsa_accuracy_series_window_average = _dylib.lookupFunction<opendsa_accuracy_series_window_average_native, opendsa_accuracy_series_window_average_dart>('opendsa_accuracy_series_window_average');
+  late final opendsa_accuracy_series_day = _dylib.lookupFunction<opendsa_accuracy_series_day_native, opendsa_accuracy_series_day_dart>('opendsa_accuracy_series_day');
+  late final opendsa_accuracy_series_week_count = _dylib.lookupFunction<opendsa_accuracy_series_week_count_native, opendsa_accuracy_series_week_count_dart>('opendsa_accuracy_series_week_count');
+  late final opendsa_accuracy_series_week = _dylib.lookupFunction<opendsa_accuracy_series_week_native, opendsa_accuracy_series_week_dart>('opendsa_accuracy_series_week');
+  late final opendsa_accuracy_series_close = _dylib.lookupFunction<opendsa_accuracy_series_close_native, opendsa_accuracy_series_close_dart>('opendsa_accuracy_series_close');
+  late final opendsa_analytics_open = _dylib.lookupFunction<opendsa_analytics_open_native, opendsa_analytics_open_dart>('opendsa_analytics_open');
+  late final opendsa_analytics_record = _dylib.lookupFunction<opendsa_analytics_record_native, opendsa_analytics_record_dart>('opendsa_analytics_record');
+  late final opendsa_analytics_start_session = _dylib.lookupFunction<opendsa_analytics_start_session_native, opendsa_analytics_start_session_dart>('opendsa_analytics_start_session');
+  late final opendsa_analytics_session_start = _dylib.lookupFunction<opendsa_analytics_session_start_native, opendsa_analytics_session_start_dart>('opendsa_analytics_session_start');
+  late final opendsa_analytics_stats = _dylib.lookupFunction<opendsa_analytics_stats_native, opendsa_analytics_stats_dart>('opendsa_analytics_stats');
+  late final opendsa_analytics_import = _dylib.lookupFunction<opendsa_analytics_import_native, opendsa_analytics_import_dart>('opendsa_analytics_import');
+  late final opendsa_analytics_reset = _dylib.lookupFunction<opendsa_analytics_action_native, opendsa_analytics_action_dart>('opendsa_analytics_reset');
+  late final opendsa_analytics_flush = _dylib.lookupFunction<opendsa_analytics_action_native, opendsa_analytics_action_dart>('opendsa_analytics_flush');
+  late final opendsa_analytics_close = _dylib.lookupFunction<opendsa_analytics_close_native, opendsa_analytics_close_dart>('opendsa_analytics_close');
+  late final opendsa_attempt_log_open = _dylib.lookupFunction<opendsa_attempt_log_open_native, opendsa_attempt_log_open_dart>('opendsa_attempt_log_open');
+  late final opendsa_attempt_log_append = _dylib.lookupFunction<opendsa_attempt_log_append_native, opendsa_attempt_log_append_dart>('opendsa_attempt_log_append');
+  late final opendsa_attempt_log_query = _dylib.lookupFunction<opendsa_attempt_log_query_native, opendsa_attempt_log_query_dart>('opendsa_attempt_log_query');
+  late final opendsa_attempt_log_group = _dylib.lookupFunction<opendsa_attempt_log_group_native, opendsa_attempt_log_group_dart>('opendsa_attempt_log_group');
+  late final opendsa_attempt_log_string = _dylib.lookupFunction<opendsa_attempt_log_string_native, opendsa_attempt_log_string_dart>('opendsa_attempt_log_string');
+  late final opendsa_attempt_log_size = _dylib.lookupFunction<opendsa_attempt_log_size_native, opendsa_attempt_log_size_dart>('opendsa_attempt_log_size');
+  late final opendsa_attempt_log_level_summary = _dylib.lookupFunction<opendsa_attempt_log_summary_native, opendsa_attempt_log_summary_dart>('opendsa_attempt_log_level_summary');
+  late final opendsa_attempt_log_day_summary = _dylib.lookupFunction<opendsa_attempt_log_summary_native, opendsa_attempt_log_summary_dart>('opendsa_attempt_log_day_summary');
+  late final opendsa_attempt_log_close = _dylib.lookupFunction<opendsa_attempt_log_close_native, opendsa_attempt_log_close_dart>('opendsa_attempt_log_close');
+  late final opendsa_session_journal_open = _dylib.lookupFunction<opendsa_session_journal_open_native, opendsa_session_journal_open_dart>('opendsa_session_journal_open');
+  late final opendsa_session_journal_count = _dylib.lookupFunction<opendsa_session_journal_count_native, opendsa_session_journal_count_dart>('opendsa_session_journal_count');
+  late final opendsa_session_journal_record = _dylib.lookupFunction<opendsa_session_journal_record_native, opendsa_session_journal_record_dart>('opendsa_session_journal_record');
+  late final opendsa_session_journal_begin = _dylib.lookupFunction<opendsa_session_journal_write_native, opendsa_session_journal_write_dart>('opendsa_session_journal_begin');
+  late final opendsa_session_journal_append = _dylib.lookupFunction<opendsa_session_journal_write_native, opendsa_session_journal_write_dart>('opendsa_session_journal_append');
+  late final opendsa_session_journal_sync = _dylib.lookupFunction<opendsa_session_journal_action_native, opendsa_session_journal_action_dart>('opendsa_session_journal_sync');
+  late final opendsa_session_journal_commit = _dylib.lookupFunction<opendsa_session_journal_action_native, opendsa_session_journal_action_dart>('opendsa_session_journal_commit');
+  late final opendsa_session_journal_close = _dylib.lookupFunction<opendsa_session_journal_close_native, opendsa_session_journal_close_dart>('opendsa_session_journal_close');
+  late final opendsa_logger_open = _dylib.lookupFunction<opendsa_logger_open_native, opendsa_logger_open_dart>('opendsa_logger_open');
+  // Chiamata foglia: accoda il record senza bloccare né richiamare Dart
+  late final opendsa_logger_log = _dylib.lookupFunction<opendsa_logger_log_native, opendsa_logger_log_dart>('opendsa_logger_log', isLeaf: true);
+  late final opendsa_logger_flush = _dylib.lookupFunction<opendsa_logger_action_native, opendsa_logger_action_dart>('opendsa_logger_flush');
+  late final opendsa_logger_recent = _dylib.lookupFunction<opendsa_logger_action_native, opendsa_logger_action_dart>('opendsa_logger_recent');
+  late final opendsa_logger_query = _dylib.lookupFunction<opendsa_logger_query_native, opendsa_logger_query_dart>('opendsa_logger_query');
+  late final opendsa_logger_line = _dylib.lookupFunction<opendsa_logger_line_native, opendsa_logger_line_dart>('opendsa_logger_line');
+  late final opendsa_logger_read_day = _dylib.lookupFunction<opendsa_logger_read_day_native, opendsa_logger_read_day_dart>('opendsa_logger_read_day');
+  late final opendsa_logger_stats = _dylib.lookupFunction<opendsa_logger_stats_native, opendsa_logger_stats_dart>('opendsa_logger_stats');
+  late final opendsa_logger_close = _dylib.lookupFunction<opendsa_logger_close_native, opendsa_logger_close_dart>('opendsa_logger_close');
+
+  late final opendsa_audio_archive_open = _dylib.lookupFunction<opendsa_audio_archive_open_native, opendsa_audio_archive_open_dart>('opendsa_audio_archive_open');
+  late final opendsa_audio_archive_add_wav = _dylib.lookupFunction<opendsa_audio_archive_add_wav_native, opendsa_audio_archive_add_wav_dart>('opendsa_audio_archive_add_wav');
+  late final opendsa_audio_archive_add_wav_start = _dylib.lookupFunction<opendsa_audio_archive_add_wav_start_native, opendsa_audio_archive_add_wav_start_dart>('opendsa_audio_archive_add_wav_start');
+  late final opendsa_audio_archive_add_done = _dylib.lookupFunction<opendsa_audio_archive_add_done_native, opendsa_audio_archive_add_done_dart>('opendsa_audio_archive_add_done');
+  late final opendsa_audio_archive_add_wait = _dylib.lookupFunction<opendsa_audio_archive_add_wait_native, opendsa_audio_archive_add_wait_dart>('opendsa_audio_archive_add_wait');
+  late final opendsa_audio_archive_add_free = _dylib.lookupFunction<opendsa_audio_archive_add_free_native, opendsa_audio_archive_add_free_dart>('opendsa_audio_archive_add_free');
+  late final opendsa_audio_archive_list = _dylib.lookupFunction<opendsa_audio_archive_list_native, opendsa_audio_archive_list_dart>('opendsa_audio_archive_list');
+  late final opendsa_audio_archive_clip = _dylib.lookupFunction<opendsa_audio_archive_clip_native, opendsa_audio_archive_clip_dart>('opendsa_audio_archive_clip');
+  late final opendsa_audio_archive_export_wav = _dylib.lookupFunction<opendsa_audio_archive_export_wav_native, opendsa_audio_archive_export_wav_dart>('opendsa_audio_archive_export_wav');
+  late final opendsa_audio_archive_remove = _dylib.lookupFunction<opendsa_audio_archive_action_native, opendsa_audio_archive_action_dart>('opendsa_audio_archive_remove');
+  late final opendsa_audio_archive_evict = _dylib.lookupFunction<opendsa_audio_archive_action_native, opendsa_audio_archive_action_dart>('opendsa_audio_archive_evict');
+  late final opendsa_audio_archive_stats = _dylib.lookupFunction<opendsa_audio_archive_stats_native, opendsa_audio_archive_stats_dart>('opendsa_audio_archive_stats');
+  late final opendsa_audio_archive_close = _dylib.lookupFunction<opendsa_audio_archive_close_native, opendsa_audio_archive_close_dart>('opendsa_audio_archive_close');
+
+  late final opendsa_speech_model_open = _dylib.lookupFunction<opendsa_speech_model_open_native, opendsa_speech_model_open_dart>('opendsa_speech_model_open');
+  late final opendsa_speech_model_ready = _dylib.lookupFunction<opendsa_speech_model_ready_native, opendsa_speech_model_ready_dart>('opendsa_speech_model_ready');
+  late final opendsa_speech_model_close = _dylib.lookupFunction<opendsa_speech_model_close_native, opendsa_speech_model_close_dart>('opendsa_speech_model_close');
+  late final opendsa_recognize_file_start = _dylib.lookupFunction<opendsa_recognize_file_start_native, opendsa_recognize_file_start_dart>('opendsa_recognize_file_start');
+  late final opendsa_recognize_file_progress = _dylib.lookupFunction<opendsa_recognize_file_progress_native, opendsa_recognize_file_progress_dart>('opendsa_recognize_file_progress');
+  late final opendsa_recognize_file_wait = _dylib.lookupFunction<opendsa_recognize_file_wait_native, opendsa_recognize_file_wait_dart>('opendsa_recognize_file_wait');
+  late final opendsa_recognize_file_word = _dylib.lookupFunction<opendsa_recognize_file_word_native, opendsa_recognize_file_word_dart>('opendsa_recognize_file_word');
+  late final opendsa_recognize_file_free = _dylib.lookupFunction<opendsa_recognize_file_free_native, opendsa_recognize_file_free_dart>('opendsa_recognize_file_free');
+}
@@ -0,0 +1,184 @@
+// lib/services/native/profile_log.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Archivio a log di un profilo, gestito dalla libreria nativa.
+///
+/// Ogni campo di primo livello del profilo (come in `Player.toJson`) è una
+/// chiave con il valore codificato in JSON. Scrivere il profilo accoda un
+/// piccolo record con CRC solo per i campi cambiati, invece di riscrivere
+/// tutto il file; il log viene compattato in uno snapshot quando cresce e,
+/// all'apertura, una coda interrotta da un crash viene scartata.
+///
+/// Con una [commitWindow] le modifiche che arrivano entro la finestra dalla
+/// prima vengono scritte insieme da un thread nativo, con un solo fsync:
+/// lo stato letto con [read] è sempre quello aggiornato e [flush] rende
+/// durevoli subito le modifiche in attesa.
+class NativeProfileLog {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  NativeProfileLog._(this._native, this._handle);
+
+  /// Apre o crea il log in [path]. Restituisce null se la libreria nativa
+  /// non è disponibile o il file non è un log valido.
+  static NativeProfileLog? open(String path,
+      {Duration commitWindow = Duration.zero}) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) =>
+        native.opendsa_profile_log_open(path.toNativeUtf8(allocator: arena)));
+    if (handle == nullptr) {
+      debugPrint('NativeProfileLog: impossibile aprire $path');
+      return null;
+    }
+    if (commitWindow > Duration.zero) {
+      native.opendsa_profile_log_set_commit_window(
+          handle, commitWindow.inMilliseconds);
+    }
+    return NativeProfileLog._(native, handle);
+  }
+
+  /// Numero di campi salvati.
+  int get length {
+    _checkOpen();
+    return _native.opendsa_profile_log_size(_handle);
+  }
+
+  bool get isEmpty => length == 0;
+
+  /// Stato corrente del profilo, con i valori decodificati dal JSON.
+  Map<String, dynamic> read() {
+    _checkOpen();
+    return using((arena) {
+      final entry = arena<OpendsaProfileEntry>();
+      final data = <String, dynamic>{};
+      final count = _native.opendsa_profile_log_size(_handle);
+      for (var i = 0; i < count; i++) {
+        if (_native.opendsa_profile_log_entry(_handle, i, entry) != 0) break;
+        final key = utf8.decode(entry.ref.key.asTypedList(entry.ref.keyLength));
+        final value =
+            utf8.decode(entry.ref.value.asTypedList(entry.ref.valueLength));
+        data[key] = json.decode(value);
+      }
+      return data;
+    });
+  }
+
+  /// Porta il log allo stato di [data]: accoda un record per ogni campo
+  /// cambiato o rimosso, nessuno per quelli invariati. Restituisce il
+  /// numero di campi cambiati, -1 se questa scrittura o una precedente in
+  /// attesa non è riuscita.
+  int write(Map<String, dynamic> data) {
+    _checkOpen();
+    return using((arena) {
+      var written = 0;
+      for (final entry in data.entries) {
+        final result = _native.opendsa_profile_log_put(
+          _handle,
+          entry.key.toNativeUtf8(allocator: arena),
+          json.encode(entry.value).toNativeUtf8(allocator: arena),
+          -1,
+        );
+        if (result < 0) return -1;
+        written += result;
+      }
+      for (final key in _keys()) {
+        if (data.containsKey(key)) continue;
+        final result = _native.opendsa_profile_log_remove(
+            _handle, key.toNativeUtf8(allocator: arena));
+        if (result < 0) return -1;
+        written += result;
+      }
+      return written;
+    });
+  }
+
+  List<String> _keys() {
+    return using((arena) {
+      final entry = arena<OpendsaProfileEntry>();
+      final count = _native.opendsa_profile_log_size(_handle);
+      return [
+        for (var i = 0; i < count; i++)
+          if (_native.opendsa_profile_log_entry(_handle, i, entry) == 0)
+            utf8.decode(entry.ref.key.asTypedList(entry.ref.keyLength)),
+      ];
+    });
+  }
+
+  /// Scrive subito le modifiche in attesa. Restituisce false se la
+  /// scrittura non è riuscita.
+  bool flush() {
+    _checkOpen();
+    return _native.opendsa_profile_log_flush(_handle) == 0;
+  }
+
+  /// Scrive lo stato corrente in [path] come profilo binario, leggibile
+  /// con `NativeBinaryProfile`.
+  bool exportBinary(String path) {
+    _checkOpen();
+    return using((arena) => _native.opendsa_profile_log_export_binary(
+            _handle, path.toNativeUtf8(allocator: arena)) ==
+        0);
+  }
+
+  /// Riscrive il log come snapshot dello stato corrente.
+  bool compact() {
+    _checkOpen();
+    return _native.opendsa_profile_log_compact(_handle) == 0;
+  }
+
+  /// Contatori del log: record riletti, scritti ed evitati, byte scartati
+  /// all'apertura, compattazioni e dimensioni, scritture richieste e
+  /// scritture effettivamente eseguite sul file (`commits`).
+  ({
+    int recordsReplayed,
+    int recordsAppended,
+    int writesSkipped,
+    int bytesTruncated,
+    int compactions,
+    int logBytes,
+    int liveBytes,
+    int writesRequested,
+    int writesCoalesced,
+    int commits,
+    int failedCommits,
+  }) get stats {
+    _checkOpen();
+    return using((arena) {
+      final out = arena<OpendsaProfileLogStats>();
+      _native.opendsa_profile_log_stats(_handle, out);
+      return (
+        recordsReplayed: out.ref.recordsReplayed,
+        recordsAppended: out.ref.recordsAppended,
+        writesSkipped: out.ref.writesSkipped,
+        bytesTruncated: out.ref.bytesTruncated,
+        compactions: out.ref.compactions,
+        logBytes: out.ref.logBytes,
+        liveBytes: out.ref.liveBytes,
+        writesRequested: out.ref.writesRequested,
+        writesCoalesced: out.ref.writesCoalesced,
+        commits: out.ref.commits,
+        failedCommits: out.ref.failedCommits,
+      );
+    });
+  }
+
+  /// Scrive le modifiche in attesa e chiude il file. L'istanza non è più
+  /// utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_profile_log_close(_handle);
+    _handle = nullptr;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeProfileLog già chiuso');
+    }
+  }
+}
@@ -0,0 +1,122 @@
+// lib/services/native/session_journal.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Un record del journal: [type] è uno dei valori di
+/// [OpendsaJournalRecord], [data] il JSON decodificato.
+typedef NativeJournalRecord = ({int type, Map<String, dynamic> data});
+
+/// Journal della sessione di allenamento in corso, gestito dalla libreria
+/// nativa.
+///
+/// La sessione viene scritta una volta sola all'inizio ([begin]); ogni
+/// risultato è poi un piccolo record accodato ([append]) invece di
+/// ricodificare tutta la sessione. I record sopravvivono a un crash
+/// dell'app e l'fsync che li rende durevoli viene raggruppato su una
+/// [syncWindow]. All'apertura [records] contiene la sessione interrotta,
+/// fino all'ultimo record integro; [commit] svuota il journal quando la
+/// sessione è stata salvata nella cronologia.
+class NativeSessionJournal {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  NativeSessionJournal._(this._native, this._handle);
+
+  /// Apre o crea il journal in [path]. Restituisce null se la libreria
+  /// nativa non è disponibile o il file non è un journal valido.
+  static NativeSessionJournal? open(String path,
+      {Duration syncWindow = Duration.zero}) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+    final handle = using((arena) => native.opendsa_session_journal_open(
+        path.toNativeUtf8(allocator: arena), syncWindow.inMilliseconds));
+    if (handle == nullptr) {
+      debugPrint('NativeSessionJournal: impossibile aprire $path');
+      return null;
+    }
+    return NativeSessionJournal._(native, handle);
+  }
+
+  /// Record del journal in ordine di scrittura. Un record non decodificabile
+  /// chiude l'elenco, come un record troncato.
+  List<NativeJournalRecord> get records {
+    _checkOpen();
+    return using((arena) {
+      final type = arena<Int32>();
+      final data = arena<Pointer<Uint8>>();
+      final length = arena<Int32>();
+      final records = <NativeJournalRecord>[];
+      final count = _native.opendsa_session_journal_count(_handle);
+      for (var i = 0; i < count; i++) {
+        if (_native.opendsa_session_journal_record(
+                _handle, i, type, data, length) !=
+            0) {
+          break;
+        }
+        try {
+          final decoded =
+              json.decode(utf8.decode(data.value.asTypedList(length.value)));
+          records.add((type: type.value, data: decoded as Map<String, dynamic>));
+        } catch (e) {
+          debugPrint('NativeSessionJournal: record $i non valido: $e');
+          break;
+        }
+      }
+      return records;
+    });
+  }
+
+  /// Svuota il journal e vi scrive [data] come inizio della sessione, con
+  /// fsync immediato.
+  bool begin(Map<String, dynamic> data) {
+    _checkOpen();
+    return _write(_native.opendsa_session_journal_begin, data);
+  }
+
+  /// Accoda [data] come record della sessione. Restituisce false se questa
+  /// scrittura o l'fsync di un record precedente non è riuscito.
+  bool append(Map<String, dynamic> data) {
+    _checkOpen();
+    return _write(_native.opendsa_session_journal_append, data);
+  }
+
+  bool _write(opendsa_session_journal_write_dart write,
+      Map<String, dynamic> data) {
+    final bytes = utf8.encode(json.encode(data));
+    return using((arena) {
+      final buffer = arena<Uint8>(bytes.length);
+      buffer.asTypedList(bytes.length).setAll(0, bytes);
+      return write(_handle, buffer, bytes.length) == 0;
+    });
+  }
+
+  /// Rende subito durevoli i record in attesa.
+  bool sync() {
+    _checkOpen();
+    return _native.opendsa_session_journal_sync(_handle) == 0;
+  }
+
+  /// Svuota il journal, dopo che la sessione è passata nella cronologia.
+  bool commit() {
+    _checkOpen();
+    return _native.opendsa_session_journal_commit(_handle) == 0;
+  }
+
+  /// Rende durevoli i record in attesa e chiude il file. L'istanza non è più
+  /// utilizzabile.
+  void close() {
+    if (_handle == nullptr) return;
+    _native.opendsa_session_journal_close(_handle);
+    _handle = nullptr;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('NativeSessionJournal già chiuso');
+    }
+  }
+}
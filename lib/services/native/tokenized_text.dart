@@ -0,0 +1,201 @@
+// lib/services/native/tokenized_text.dart
+
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:typed_data';
+import 'package:ffi/ffi.dart';
+import 'opendsa_native_bindings.dart';
+
+/// Testo suddiviso in token dalla libreria nativa: parole, numeri e
+/// punteggiatura con le loro posizioni, i confini di frase e di paragrafo e
+/// le forme normalizzate.
+///
+/// Gli array sono viste tipizzate sulla memoria nativa, create una sola volta:
+/// la schermata di lettura può disegnare ed evidenziare le parole leggendo
+/// direttamente [begins]/[ends] senza ricostruire nulla a ogni frame. Le viste
+/// non vanno usate dopo [dispose].
+class TokenizedText {
+  final OpenDsaNativeLibrary _native;
+  Pointer<Void> _handle;
+
+  /// Testo originale: [begins] e [ends] sono suoi indici.
+  final String text;
+
+  final int length;
+  final int sentenceCount;
+  final int paragraphCount;
+  final Uint32List _begins;
+  final Uint32List _ends;
+  final Uint32List _byteBegins;
+  final Uint32List _byteEnds;
+  final Uint8List _kinds;
+  final Uint8List _flags;
+  final Uint32List _normalizedOffsets;
+  final Uint32List _normalizedLengths;
+  final Uint8List _normalized;
+  final Uint32List _sentenceStarts;
+  final Uint32List _paragraphStarts;
+
+  TokenizedText._(this._native, this._handle, this.text, OpendsaTokenView view)
+      : length = view.tokenCount,
+        sentenceCount = view.sentenceCount,
+        paragraphCount = view.paragraphCount,
+        _begins = _view(view.utf16Begins, view.tokenCount),
+        _ends = _view(view.utf16Ends, view.tokenCount),
+        _byteBegins = _view(view.begins, view.tokenCount),
+        _byteEnds = _view(view.ends, view.tokenCount),
+        _kinds = _bytes(view.kinds, view.tokenCount),
+        _flags = _bytes(view.flags, view.tokenCount),
+        _normalizedOffsets = _view(view.normalizedOffsets, view.tokenCount),
+        _normalizedLengths = _view(view.normalizedLengths, view.tokenCount),
+        _normalized = _bytes(view.normalized, view.normalizedSize),
+        _sentenceStarts = _view(view.sentenceStarts, _withSentinel(view.sentenceCount)),
+        _paragraphStarts = _view(view.paragraphStarts, _withSentinel(view.paragraphCount));
+
+  /// Suddivide [text] in token. Restituisce null se la libreria nativa non è
+  /// disponibile.
+  static TokenizedText? tokenize(String text) {
+    final native = OpenDsaNativeLibrary.instance;
+    if (native == null) return null;
+
+    final handle = using((arena) {
+      final bytes = utf8.encode(text);
+      final buffer = arena<Uint8>(bytes.length + 1);
+      buffer.asTypedList(bytes.length).setAll(0, bytes);
+      return native.opendsa_tokenize(buffer.cast<Utf8>(), bytes.length);
+    });
+    if (handle == nullptr) return null;
+    return TokenizedText.adopt(native, handle, text);
+  }
+
+  /// Avvolge un risultato nativo già calcolato (ad esempio i token di una
+  /// pagina di un pacchetto), che verrà liberato da [dispose]. [text] deve
+  /// essere il testo da cui [handle] è stato ricavato.
+  factory TokenizedText.adopt(OpenDsaNativeLibrary native, Pointer<Void> handle, String text) {
+    final view = calloc<OpendsaTokenView>();
+    try {
+      native.opendsa_tokens_view(handle, view);
+      return TokenizedText._(native, handle, text, view.ref);
+    } finally {
+      calloc.free(view);
+    }
+  }
+
+  /// Inizio e fine (esclusa) di ogni token, come indici di [text].
+  Uint32List get begins => _checked(_begins);
+  Uint32List get ends => _checked(_ends);
+
+  /// Inizio e fine di ogni token in byte UTF-8.
+  Uint32List get byteBegins => _checked(_byteBegins);
+  Uint32List get byteEnds => _checked(_byteEnds);
+
+  /// Tipo di ogni token ([OpendsaTokenKind]).
+  Uint8List get kinds => _checked(_kinds);
+
+  /// Caratteristiche di ogni token ([OpendsaTokenFlags]).
+  Uint8List get flags => _checked(_flags);
+
+  /// Primo token di ogni frase/paragrafo, seguito da [length]: la frase i va
+  /// da sentenceStarts[i] a sentenceStarts[i + 1].
+  Uint32List get sentenceStarts => _checked(_sentenceStarts);
+  Uint32List get paragraphStarts => _checked(_paragraphStarts);
+
+  /// Testo del token [index] così come compare in [text].
+  String tokenAt(int index) {
+    RangeError.checkValidIndex(index, this, 'index', length);
+    return text.substring(begins[index], ends[index]);
+  }
+
+  /// Forma normalizzata (minuscolo, senza apostrofi) del token [index];
+  /// vuota per la punteggiatura.
+  String normalizedAt(int index) {
+    RangeError.checkValidIndex(index, this, 'index', length);
+    final offset = _checked(_normalizedOffsets)[index];
+    return utf8.decode(Uint8List.sublistView(
+        _normalized, offset, offset + _normalizedLengths[index]));
+  }
+
+  bool isWord(int index) => kinds[index] != OpendsaTokenKind.punctuation;
+
+  bool hasFlag(int index, int flag) => (flags[index] & flag) != 0;
+
+  /// Frase che contiene il token [index].
+  int sentenceOf(int index) => _search(sentenceStarts, sentenceCount, index);
+
+  /// Paragrafo che contiene il token [index].
+  int paragraphOf(int index) => _search(paragraphStarts, paragraphCount, index);
+
+  /// Token che contiene la posizione [offset] di [text], o null se la
+  /// posizione cade in uno spazio.
+  int? tokenAtOffset(int offset) {
+    if (length == 0) return null;
+    final index = _search(begins, length, offset);
+    return offset >= begins[index] && offset < ends[index] ? index : null;
+  }
+
+  /// Allinea le parole lette [recognized] ai token di questo testo (o
+  /// dell'intervallo [first], [first] + [count]). L'elemento i del risultato
+  /// è il token corrispondente all'i-esima parola letta, -1 se nessuno.
+  Int32List align(String recognized, {int first = 0, int? count}) {
+    _checkOpen();
+    final tokenCount = count ?? length - first;
+    return using((arena) {
+      final recognizedUtf8 = recognized.toNativeUtf8(allocator: arena);
+      var capacity = recognized.length ~/ 2 + 1;
+      var out = arena<Int32>(capacity);
+      final words = _native.opendsa_tokens_align(
+          _handle, first, tokenCount, recognizedUtf8, out, capacity);
+      if (words < 0) throw ArgumentError('Intervallo di token non valido');
+      if (words > capacity) {
+        capacity = words;
+        out = arena<Int32>(capacity);
+        _native.opendsa_tokens_align(
+            _handle, first, tokenCount, recognizedUtf8, out, capacity);
+      }
+      return Int32List.fromList(out.asTypedList(words));
+    });
+  }
+
+  /// Rilascia i token. Le viste tipizzate non sono più valide.
+  void dispose() {
+    if (_handle == nullptr) return;
+    _native.opendsa_tokens_free(_handle);
+    _handle = nullptr;
+  }
+
+  /// Ultimo indice i con starts[i] <= value, fra i primi [count] elementi.
+  static int _search(Uint32List starts, int count, int value) {
+    var low = 0;
+    var high = count - 1;
+    while (low < high) {
+      final middle = (low + high + 1) >> 1;
+      if (starts[middle] <= value) {
+        low = middle;
+      } else {
+        high = middle - 1;
+      }
+    }
+    return low;
+  }
+
+  // La sentinella è presente solo se il testo contiene dei token
+  static int _withSentinel(int count) => count == 0 ? 0 : count + 1;
+
+  // Gli array vuoti possono avere un puntatore nullo
+  static Uint32List _view(Pointer<Uint32> data, int count) =>
+      count == 0 || data == nullptr ? Uint32List(0) : data.asTypedList(count);
+
+  static Uint8List _bytes(Pointer<Uint8> data, int count) =>
+      count == 0 || data == nullptr ? Uint8List(0) : data.asTypedList(count);
+
+  T _checked<T>(T list) {
+    _checkOpen();
+    return list;
+  }
+
+  void _checkOpen() {
+    if (_handle == nullptr) {
+      throw StateError('TokenizedText già rilasciato');
+    }
+  }
+}
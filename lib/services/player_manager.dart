@@ -53,7 +53,7 @@ class PlayerManager extends ChangeNotifier {
           final player = Player();
           player.fromJson(profileData);
           _profiles.add(player);
-          debugPrint('Caricato profilo: ${player.toJson()}');
+          debugPrint('Caricato profilo: ${player.id}');
         }
       }
 
@@ -66,16 +66,16 @@ class PlayerManager extends ChangeNotifier {
           try {
             _currentProfile = _profiles.firstWhere((p) => p.id == lastProfileId);
             await _currentProfile!.loadProgress();
-            debugPrint('Profilo corrente impostato: ${_currentProfile!.toJson()}');
+            debugPrint('Profilo corrente impostato: ${_currentProfile!.id}');
           } catch (e) {
             _currentProfile = _profiles.first;
             await _currentProfile!.loadProgress();
-            debugPrint('Profilo di fallback impostato: ${_currentProfile!.toJson()}');
+            debugPrint('Profilo di fallback impostato: ${_currentProfile!.id}');
           }
         } else {
           _currentProfile = _profiles.first;
           await _currentProfile!.loadProgress();
-          debugPrint('Primo profilo impostato: ${_currentProfile!.toJson()}');
+          debugPrint('Primo profilo impostato: ${_currentProfile!.id}');
         }
       } else {
         _currentProfile = null;
@@ -108,7 +108,7 @@ class PlayerManager extends ChangeNotifier {
       final profileData = await _fileStorage.readProfile(selected.id);
       if (profileData.isNotEmpty) {
         selected.fromJson(profileData);
-        debugPrint('Dati profilo caricati: ${selected.toJson()}');
+        debugPrint('Dati profilo caricati: ${selected.id}');
       } else {
         debugPrint('Nessun dato trovato per il profilo ${selected.id}');
       }
@@ -184,7 +184,7 @@ class PlayerManager extends ChangeNotifier {
       final profileData = await _fileStorage.readProfile(player.id);
       if (profileData.isNotEmpty) {
         player.fromJson(profileData);
-        debugPrint('Stato giocatore caricato: ${player.toJson()}');
+        debugPrint('Stato giocatore caricato: ${player.id}');
         return true;
       }
       return false;
@@ -223,7 +223,7 @@ class PlayerManager extends ChangeNotifier {
       await _prefs.setString(_lastProfileKey, player.id);
       notifyListeners();
 
-      debugPrint('Profilo aggiornato con successo: ${player.toJson()}');
+      debugPrint('Profilo aggiornato con successo: ${player.id}');
     } catch (e) {
       debugPrint('Errore nell\'aggiornamento del profilo: $e');
       rethrow;
@@ -258,7 +258,7 @@ class PlayerManager extends ChangeNotifier {
       await _fileStorage.writeProfile(newPlayer.id, profileData);
       notifyListeners();
 
-      debugPrint('Nuovo profilo creato: ${newPlayer.toJson()}');
+      debugPrint('Nuovo profilo creato: ${newPlayer.id}');
       return newPlayer;
     } catch (e) {
       _profiles.removeWhere((p) => p.id == newPlayer.id);
@@ -130,7 +130,9 @@ class SpeechRecognitionService {
       final audioPath = await _audioService.stopRecording();
       debugPrint('SpeechRecognitionService: Registrazione stoppata. File audio: $audioPath');
       if (audioPath.isNotEmpty && _currentTargetText != null) {
-        final result = await _voskService.startRecognition(_currentTargetText!);
+        // Il file appena registrato viene riconosciuto dalla libreria
+        // nativa, senza riavviare l'ascolto
+        final result = await _voskService.recognizeFile(audioPath, _currentTargetText!);
         debugPrint('SpeechRecognitionService: Risultato ottenuto: ${result.text}');
         debugPrint('SpeechRecognitionService: Similarità: ${result.similarity}');
         _resultController.add(result);
@@ -1,9 +1,13 @@
 import 'dart:async';
 import 'dart:convert';
 import 'package:shared_preferences/shared_preferences.dart';
+import '../config/app_config.dart';
 import '../models/recognition_result.dart';
+import '../services/file_storage_service.dart';
 import '../services/learning_analytics_service.dart';
 import '../services/recognition_manager.dart';
+import '../services/native/opendsa_native_bindings.dart';
+import '../services/native/session_journal.dart';
 
 /// Rappresenta una singola sessione di allenamento con tutti i suoi dettagli
 class TrainingSession {
@@ -40,7 +44,7 @@ class TrainingSession {
       targetWords: json['targetWords'] as int,
       currentLevel: json['currentLevel'] as int,
       results: (json['results'] as List)
-          .map((r) => RecognitionResult.fromVoskResult(r, ''))
+          .map((r) => RecognitionResult.fromJson(r as Map<String, dynamic>))
           .toList(),
       crystalsEarned: json['crystalsEarned'] as int,
       isCompleted: json['isCompleted'] as bool,
@@ -51,8 +55,8 @@ class TrainingSession {
 /// Servizio che gestisce le sessioni di allenamento e analizza le performance
 class TrainingSessionService {
   // Costanti per la gestione della persistenza
-  static const String _currentSessionKey = 'current_training_session';
-  static const String _sessionsHistoryKey = 'training_sessions_history';
+  static const String currentSessionKey = 'current_training_session';
+  static const String sessionsHistoryKey = 'training_sessions_history';
 
   // Dipendenze del servizio
   final SharedPreferences _prefs;
@@ -63,6 +67,13 @@ class TrainingSessionService {
   TrainingSession? _currentSession;
   final _sessionController = StreamController<TrainingSession?>.broadcast();
 
+  // Journal nativo della sessione in corso; null se la libreria non è
+  // disponibile, nel qual caso la sessione resta nelle preferenze
+  NativeSessionJournal? _journal;
+
+  // Le scritture vengono eseguite in ordine, una alla volta
+  Future<void> _pendingWrites = Future.value();
+
   TrainingSessionService({
     required SharedPreferences prefs,
     required LearningAnalyticsService analyticsService,
@@ -70,7 +81,7 @@ class TrainingSessionService {
   }) : _prefs = prefs,
         _analyticsService = analyticsService,
         _recognitionManager = recognitionManager {
-    _loadCurrentSession();
+    _pendingWrites = _loadCurrentSession();
     _setupRecognitionListener();
   }
 
@@ -86,13 +97,30 @@ class TrainingSessionService {
     });
   }
 
-  /// Carica la sessione corrente dalle preferenze salvate
+  /// Carica la sessione corrente dal journal, o dalle preferenze salvate
+  /// se il journal non è disponibile o è ancora vuoto
   Future<void> _loadCurrentSession() async {
-    final sessionJson = _prefs.getString(_currentSessionKey);
+    try {
+      _journal = NativeSessionJournal.open(
+        await FileStorageService().getSessionJournalPath(),
+        syncWindow: AppConfig.sessionJournalSyncWindow,
+      );
+    } catch (e) {
+      print('Errore nell\'apertura del journal della sessione: $e');
+    }
+
+    final journal = _journal;
+    if (journal != null && await _replayJournal(journal)) return;
+
+    final sessionJson = _prefs.getString(currentSessionKey);
     if (sessionJson != null) {
       try {
         final sessionData = jsonDecode(sessionJson);
         _currentSession = TrainingSession.fromJson(sessionData);
+        // La sessione salvata con la versione precedente passa nel journal
+        if (journal != null && journal.begin(_currentSession!.toJson())) {
+          await _prefs.remove(currentSessionKey);
+        }
         _sessionController.add(_currentSession);
       } catch (e) {
         print('Errore nel caricamento della sessione: $e');
@@ -100,37 +128,102 @@ class TrainingSessionService {
     }
   }
 
+  /// Ricostruisce la sessione interrotta dai record del journal: l'inizio
+  /// della sessione seguito dai risultati. Una sessione già completa (il
+  /// crash è avvenuto prima di salvarla nella cronologia) viene salvata ora.
+  /// Restituisce false se il journal è vuoto o non leggibile.
+  Future<bool> _replayJournal(NativeSessionJournal journal) async {
+    final records = journal.records;
+    if (records.isEmpty || records.first.type != OpendsaJournalRecord.begin) {
+      return false;
+    }
+
+    try {
+      final session = TrainingSession.fromJson(records.first.data);
+      for (final record in records.skip(1)) {
+        session.results.add(RecognitionResult.fromJson(
+            record.data['result'] as Map<String, dynamic>));
+        session.crystalsEarned += record.data['crystals'] as int;
+      }
+
+      if (session.results.length >= session.targetWords) {
+        session.isCompleted = true;
+        final history = await getSessionHistory();
+        if (!history.any((s) => s.startTime == session.startTime)) {
+          await _saveSessionToHistory(session);
+        }
+        journal.commit();
+        return true;
+      }
+
+      _currentSession = session;
+      _sessionController.add(_currentSession);
+      return true;
+    } catch (e) {
+      print('Errore nel ripristino della sessione: $e');
+      journal.commit();
+      return false;
+    }
+  }
+
+  /// Accoda [write] dopo le scritture precedenti
+  Future<void> _enqueueWrite(Future<void> Function() write) {
+    return _pendingWrites = _pendingWrites.then((_) => write()).catchError(
+        (e) => print('Errore nel salvataggio della sessione: $e'));
+  }
+
   /// Avvia una nuova sessione di allenamento
   Future<void> startNewSession(int targetWords, int currentLevel) async {
-    if (_currentSession?.isCompleted == false) {
-      await _saveSessionToHistory(_currentSession!);
-    }
+    final unfinished = _currentSession?.isCompleted == false ? _currentSession : null;
 
-    _currentSession = TrainingSession(
+    final session = TrainingSession(
       startTime: DateTime.now(),
       targetWords: targetWords,
       currentLevel: currentLevel,
+      results: [],
     );
-
-    await _saveCurrentSession();
+    _currentSession = session;
+
+    // La sessione interrotta passa nella cronologia in coda alle altre
+    // scritture, e prima che il journal venga svuotato dalla nuova
+    await _enqueueWrite(() async {
+      if (unfinished != null) await _saveSessionToHistory(unfinished);
+      if (_journal?.begin(session.toJson()) != true) {
+        await _saveCurrentSession();
+      }
+    });
     _analyticsService.startSession();
     _sessionController.add(_currentSession);
   }
 
-  /// Gestisce un nuovo risultato di riconoscimento
+  /// Gestisce un nuovo risultato di riconoscimento. Nel journal viene
+  /// accodato solo il risultato; la sessione completa passa nella
+  /// cronologia e solo dopo il journal viene svuotato, così un crash in
+  /// mezzo non perde né duplica la sessione.
   void _handleNewResult(RecognitionResult result) {
-    if (_currentSession == null) return;
+    final session = _currentSession;
+    if (session == null) return;
 
-    _currentSession!.results.add(result);
-    _currentSession!.crystalsEarned += _calculateCrystalsForResult(result);
+    final crystals = _calculateCrystalsForResult(result);
+    session.results.add(result);
+    session.crystalsEarned += crystals;
 
-    if (_currentSession!.results.length >= _currentSession!.targetWords) {
-      _currentSession!.isCompleted = true;
-      _saveSessionToHistory(_currentSession!);
+    final completed = session.results.length >= session.targetWords;
+    if (completed) {
+      session.isCompleted = true;
       _currentSession = null;
     }
 
-    _saveCurrentSession();
+    _enqueueWrite(() async {
+      final journal = _journal;
+      final journaled = journal != null &&
+          journal.append({'result': result.toJson(), 'crystals': crystals});
+      if (completed) {
+        await _saveSessionToHistory(session);
+        if (journaled) journal.commit();
+      }
+      if (!journaled) await _saveCurrentSession();
+    });
     _sessionController.add(_currentSession);
   }
 
@@ -155,10 +248,10 @@ class TrainingSessionService {
   /// Salva la sessione corrente nelle preferenze
   Future<void> _saveCurrentSession() async {
     if (_currentSession == null) {
-      await _prefs.remove(_currentSessionKey);
+      await _prefs.remove(currentSessionKey);
     } else {
       final sessionJson = jsonEncode(_currentSession!.toJson());
-      await _prefs.setString(_currentSessionKey, sessionJson);
+      await _prefs.setString(currentSessionKey, sessionJson);
     }
   }
 
@@ -175,12 +268,12 @@ class TrainingSessionService {
     final historyJson = jsonEncode(
         history.map((s) => s.toJson()).toList()
     );
-    await _prefs.setString(_sessionsHistoryKey, historyJson);
+    await _prefs.setString(sessionsHistoryKey, historyJson);
   }
 
   /// Recupera la cronologia delle sessioni
   Future<List<TrainingSession>> getSessionHistory() async {
-    final historyJson = _prefs.getString(_sessionsHistoryKey);
+    final historyJson = _prefs.getString(sessionsHistoryKey);
     if (historyJson == null) return [];
 
     try {
@@ -197,7 +290,10 @@ class TrainingSessionService {
   /// Annulla la sessione corrente
   Future<void> cancelCurrentSession() async {
     _currentSession = null;
-    await _saveCurrentSession();
+    await _enqueueWrite(() async {
+      _journal?.commit();
+      await _saveCurrentSession();
+    });
     _sessionController.add(null);
   }
 
@@ -230,6 +326,8 @@ class TrainingSessionService {
 
   /// Rilascio delle risorse
   Future<void> dispose() async {
+    await _pendingWrites;
+    _journal?.close();
     await _sessionController.close();
   }
 }
\ No newline at end of file
@@ -1,16 +1,21 @@
 // lib/services/vosk_service.dart
 
 import 'dart:async';
+import 'dart:collection';
 import 'dart:io';
 import 'dart:math';
 import 'dart:convert';
 import 'package:flutter/material.dart';
 import 'package:path/path.dart' as path;
+import 'package:path_provider/path_provider.dart';
 import 'package:vosk_flutter/vosk_flutter.dart';
 import '../models/recognition_result.dart';
 import '../config/app_config.dart';
 import 'permission_service.dart';
 import 'audio_service.dart';
+import 'native/file_recognizer.dart';
+import 'native/native_logger.dart';
+import 'native/opendsa_native_bindings.dart';
 
 /// VoskService gestisce l'interazione con il motore di riconoscimento vocale VOSK.
 /// Implementa il pattern Singleton per garantire un'unica istanza del servizio e
@@ -25,6 +30,10 @@ class VoskService {
   Recognizer? _speechRecognizer;
   SpeechService? _speechService;
 
+  // Modello della libreria nativa per riconoscere le registrazioni salvate,
+  // caricato in background all'inizializzazione
+  Future<NativeSpeechModel?>? _fileModel;
+
   // Servizi di supporto
   final PermissionService _permissionService = PermissionService();
   final AudioService _audioService = AudioService();
@@ -38,8 +47,11 @@ class VoskService {
   StreamSubscription? _volumeSubscription;
   double _currentVolume = 0.0;
 
-  // Buffer per i log del servizio
-  final List<String> _serviceLog = [];
+  // Log nativo del servizio, scritto in background in logs/vosk_<data>.txt
+  NativeLogger? _logger;
+  // Buffer per i log del servizio quando il log nativo non è (ancora)
+  // disponibile
+  final Queue<String> _serviceLog = Queue<String>();
 
   // Numero massimo di tentativi di inizializzazione
   static const int _maxInitAttempts = 3;
@@ -53,9 +65,34 @@ class VoskService {
   /// Costruttore privato per il singleton
   VoskService._() {
     _logEvent('VoskService inizializzato');
+    _openLogger();
     _initAudioService();
   }
 
+  /// Apre il log nativo e vi riversa gli eventi registrati nel frattempo
+  Future<void> _openLogger() async {
+    try {
+      final appDir = await getApplicationDocumentsDirectory();
+      final logDirectory = Directory(path.join(appDir.path, 'logs'));
+      await logDirectory.create(recursive: true);
+      final logger = NativeLogger.open(
+        logDirectory.path,
+        'vosk',
+        maxFileBytes: AppConfig.logMaxFileSize,
+        ringCapacity: AppConfig.serviceLogCapacity,
+        flushInterval: AppConfig.logFlushInterval,
+      );
+      if (logger == null) return;
+      for (final entry in _serviceLog) {
+        logger.log(entry);
+      }
+      _serviceLog.clear();
+      _logger = logger;
+    } catch (e) {
+      debugPrint('VoskService: log nativo non disponibile: $e');
+    }
+  }
+
   void _initAudioService() {
     _audioService.initialize();
     _volumeSubscription = _audioService.volumeLevel.listen((volume) {
@@ -63,16 +100,24 @@ class VoskService {
     });
   }
 
-  /// Registra un evento nel log del servizio con timestamp
-  void _logEvent(String event) {
+  /// Registra un evento nel log del servizio. Con il log nativo l'evento
+  /// viene solo accodato: ora e scrittura su file sono a carico del thread
+  /// nativo.
+  void _logEvent(String event, {int level = OpendsaLogLevel.info}) {
+    final logger = _logger;
+    if (logger != null) {
+      logger.log(event, level: level);
+      return;
+    }
+
     final timestamp = DateTime.now().toIso8601String();
     final logEntry = '[$timestamp] $event';
     debugPrint('VoskService: $logEntry');
-    _serviceLog.add(logEntry);
+    _serviceLog.addLast(logEntry);
 
-    // Mantiene solo gli ultimi 1000 log
-    if (_serviceLog.length > 1000) {
-      _serviceLog.removeAt(0);
+    // Mantiene solo gli ultimi log
+    if (_serviceLog.length > AppConfig.serviceLogCapacity) {
+      _serviceLog.removeFirst();
     }
   }
 
@@ -89,6 +134,9 @@ class VoskService {
       return;
     }
 
+    // Il caricamento avviene su un thread nativo: non rallenta l'avvio
+    _fileModel ??= _openFileModel();
+
     int attempts = 0;
     bool success = false;
 
@@ -107,8 +155,9 @@ class VoskService {
         await _initializeWithRetry();
         success = true;
       } catch (e, stackTrace) {
-        _logEvent('Errore nel tentativo #$attempts: $e');
-        _logEvent('Stack trace: $stackTrace');
+        _logEvent('Errore nel tentativo #$attempts: $e',
+            level: OpendsaLogLevel.error);
+        _logEvent('Stack trace: $stackTrace', level: OpendsaLogLevel.error);
 
         if (attempts >= _maxInitAttempts) {
           _isSimulatedMode = true;
@@ -232,7 +281,8 @@ class VoskService {
       _partialSubscription = _speechService!.onPartial().listen(
             (Map<String, dynamic> partial) {
           final partialText = partial['partial'] as String? ?? '';
-          _logEvent('Risultato parziale: $partialText');
+          _logEvent('Risultato parziale: $partialText',
+              level: OpendsaLogLevel.debug);
         },
         onError: (error) {
           _logEvent('Errore nel risultato parziale: $error');
@@ -258,6 +308,7 @@ class VoskService {
               similarity: 0.0,
               isCorrect: false,
               duration: currentDuration,
+              targetText: targetText,
             );
 
             if (!completer.isCompleted) {
@@ -272,19 +323,11 @@ class VoskService {
           double totalConfidence = 0.0;
 
           if (words.isNotEmpty) {
-            // Se il testo riconosciuto corrisponde esattamente al target
-            if (recognizedText.trim().toLowerCase() == targetText.trim().toLowerCase()) {
-              for (var word in words) {
-                totalConfidence += (word['conf'] as num).toDouble();
-              }
-              totalConfidence /= words.length;
-            } else {
-              for (var word in words) {
-                totalConfidence += (word['conf'] as num).toDouble();
-              }
-              totalConfidence /= words.length;
-              totalConfidence *= 0.5; // Penalità per mancata corrispondenza esatta
-            }
+            totalConfidence = _wordConfidence(
+              recognizedText,
+              [for (var word in words) (word['conf'] as num).toDouble()],
+              targetText,
+            );
 
             if (_currentVolume < AppConfig.idealVolume) {
               totalConfidence *= (_currentVolume / AppConfig.idealVolume);
@@ -297,6 +340,7 @@ class VoskService {
             similarity: totalConfidence,
             isCorrect: totalConfidence >= AppConfig.minSimilarityScore,
             duration: currentDuration,
+            targetText: targetText,
           );
           _logEvent('Risultato finale: ${recognitionResult.text}');
           _logEvent('Similarità: ${recognitionResult.similarity}');
@@ -324,6 +368,84 @@ class VoskService {
     return completer.future;
   }
 
+  /// Riconosce la registrazione salvata in [wavPath] con la libreria
+  /// nativa: il file viene decodificato più velocemente del tempo reale,
+  /// qualunque sia il percorso di acquisizione che l'ha prodotto, e il
+  /// risultato contiene i tempi di ogni parola. Se la libreria nativa,
+  /// libvosk o il modello non sono disponibili, o il file non è leggibile,
+  /// torna al riconoscimento in ascolto di [startRecognition].
+  Future<RecognitionResult> recognizeFile(String wavPath, String targetText) async {
+    _logEvent('Riconoscimento del file $wavPath per target: $targetText');
+    final model = await (_fileModel ??= _openFileModel());
+    final recognition = await model?.recognizeWav(wavPath);
+    if (recognition == null) {
+      _logEvent('Riconoscimento nativo del file non disponibile',
+          level: OpendsaLogLevel.warning);
+      return startRecognition(targetText);
+    }
+
+    _logEvent('File di ${recognition.audioDuration.inMilliseconds} ms '
+        'riconosciuto in ${recognition.processingTime.inMilliseconds} ms');
+    final confidence = _wordConfidence(
+      recognition.text,
+      [for (final word in recognition.words) word.confidence],
+      targetText,
+    );
+    final result = RecognitionResult(
+      text: recognition.text,
+      confidence: confidence,
+      similarity: confidence,
+      isCorrect: confidence >= AppConfig.minSimilarityScore,
+      duration: recognition.audioDuration,
+      targetText: targetText,
+      words: [
+        for (final word in recognition.words)
+          RecognizedWord(
+            word: word.word,
+            start: word.start,
+            end: word.end,
+            confidence: word.confidence,
+          ),
+      ],
+    );
+    _logEvent('Risultato finale: ${result.text}');
+    _logEvent('Similarità: ${result.similarity}');
+    return result;
+  }
+
+  /// Carica il modello per il riconoscimento dei file; null se non è
+  /// disponibile
+  Future<NativeSpeechModel?> _openFileModel() async {
+    try {
+      final modelPath = _modelPath.isNotEmpty ? _modelPath : await _findModelPath();
+      final model = NativeSpeechModel.open(modelPath);
+      if (model == null) return null;
+      if (await model.ready) {
+        _logEvent('Modello nativo per i file caricato da $modelPath');
+        return model;
+      }
+      model.close();
+      _logEvent('libvosk o modello non disponibili per i file',
+          level: OpendsaLogLevel.warning);
+    } catch (e) {
+      _logEvent('Errore nel caricamento del modello nativo: $e',
+          level: OpendsaLogLevel.error);
+    }
+    return null;
+  }
+
+  /// Confidenza media delle parole, dimezzata se il testo riconosciuto non
+  /// corrisponde esattamente al target
+  double _wordConfidence(
+      String recognizedText, List<double> confidences, String targetText) {
+    if (confidences.isEmpty) return 0.0;
+    var confidence = confidences.reduce((a, b) => a + b) / confidences.length;
+    if (recognizedText.trim().toLowerCase() != targetText.trim().toLowerCase()) {
+      confidence *= 0.5; // Penalità per mancata corrispondenza esatta
+    }
+    return confidence;
+  }
+
   /// Genera un risultato simulato plausibile
   RecognitionResult _generateSimulatedResult(String targetText) {
     final random = Random();
@@ -348,6 +470,7 @@ class VoskService {
       similarity: similarity,
       isCorrect: similarity >= AppConfig.minSimilarityScore,
       duration: Duration(seconds: 2 + random.nextInt(3)),
+      targetText: targetText,
     );
   }
 
@@ -373,6 +496,9 @@ class VoskService {
     _logEvent('Dispose del servizio VoskService chiamato.');
     await stopRecognition();
     await _volumeSubscription?.cancel();
+    final fileModel = _fileModel;
+    _fileModel = null;
+    (await fileModel)?.close();
     if (_isInitialized && !_isSimulatedMode) {
       _speechRecognizer?.dispose();
       _model?.dispose();
@@ -385,11 +511,27 @@ class VoskService {
       _isInitialized = false;
       _instance = null;
       _logEvent('Risorse Vosk rilasciate.');
+      _logger?.close();
+      _logger = null;
     }
   }
 
   /// Ritorna i log del servizio
-  List<String> getServiceLogs() => List.unmodifiable(_serviceLog);
+  List<String> getServiceLogs() => List.unmodifiable(
+      _logger?.recent(AppConfig.serviceLogCapacity) ?? _serviceLog);
+
+  /// Gli ultimi [limit] errori del servizio, anche dei giorni precedenti:
+  /// la ricerca usa gli indici del log nativo e decodifica solo i blocchi
+  /// che contengono errori.
+  List<String> recentErrors([int limit = 50]) {
+    final logger = _logger;
+    if (logger == null) return const [];
+    return [
+      for (final record
+          in logger.query(minLevel: OpendsaLogLevel.error, limit: limit))
+        '[${record.time.toIso8601String()}] ${record.message}',
+    ];
+  }
 
   // Getters pubblici
   bool get isInitialized => _isInitialized;
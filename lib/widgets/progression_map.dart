@@ -3,10 +3,12 @@
 import 'package:flutter/material.dart';
 import 'package:provider/provider.dart';
 import '../services/game_service.dart';
+import '../services/learning_analytics_service.dart';
 import '../services/player_manager.dart';
 import '../models/player.dart';
 import '../models/level.dart';
 import '../models/enums.dart';
+import '../services/native/attempt_log.dart';
 
 /// Widget che mostra la mappa di progressione del giocatore, inclusi il livello corrente,
 /// i sottolivelli e gli indicatori di progresso. La disposizione è responsive e ancorata.
@@ -19,6 +21,8 @@ class ProgressionMap extends StatelessWidget {
     final Player? player = playerManager.currentProfile;
     final gameService = Provider.of<GameService>(context);
     final currentSubLevel = gameService.getCurrentSubLevel();
+    final analytics =
+        Provider.of<LearningAnalyticsService>(context, listen: false);
 
     if (player == null) {
       return const Center(
@@ -53,7 +57,8 @@ class ProgressionMap extends StatelessWidget {
                 child: FittedBox(
                   fit: BoxFit.scaleDown,
                   alignment: Alignment.topCenter,
-                  child: _buildLevelDetails(gameService, currentSubLevel),
+                  child: _buildLevelDetails(gameService, currentSubLevel,
+                      analytics.daySummary(player.id, DateTime.now())),
                 ),
               ),
               if (gameService.hasActiveStreak) ...[
@@ -184,7 +189,8 @@ class ProgressionMap extends StatelessWidget {
     );
   }
 
-  Widget _buildLevelDetails(GameService gameService, SubLevel currentSubLevel) {
+  Widget _buildLevelDetails(GameService gameService, SubLevel currentSubLevel,
+      NativeAttemptSummary? today) {
     final targetDays = GameService.requiredDaysForLevelUp;
     final daysWithGoodAccuracy = (gameService.getLevelUpProgress() * targetDays).floor();
 
@@ -210,6 +216,15 @@ class ProgressionMap extends StatelessWidget {
             '$daysWithGoodAccuracy/$targetDays',
             Icons.calendar_today,
           ),
+          // Letture corrette di oggi, dal riepilogo materializzato del giorno
+          if (today != null) ...[
+            const SizedBox(height: 2),
+            _buildCompactDetailRow(
+              'Oggi:',
+              '${today.correct}/${today.attempts}',
+              Icons.today,
+            ),
+          ],
         ],
       ),
     );
@@ -0,0 +1,377 @@
+// linux/native/accuracy_series.cc
+
+#include "accuracy_series.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// value, mean, crc
+constexpr size_t kRecordTail = sizeof(float) + sizeof(float) + sizeof(uint16_t);
+constexpr size_t kMaxVarintBytes = 5;
+
+// Record accodati oltre il doppio dei giorni prima di compattare
+constexpr size_t kMinCompactRecords = 64;
+
+void PutVarint(uint32_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+bool GetVarint(const char** p, const char* end, uint32_t* value) {
+  uint64_t result = 0;
+  for (size_t i = 0; i < kMaxVarintBytes && *p < end; i++) {
+    const auto byte = static_cast<uint8_t>(*(*p)++);
+    result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      if (result > UINT32_MAX) return false;
+      *value = static_cast<uint32_t>(result);
+      return true;
+    }
+  }
+  return false;
+}
+
+void EncodeRecord(uint32_t delta, const AccuracyDay& day, std::string* out) {
+  const size_t begin = out->size();
+  PutVarint(delta, out);
+  PutVarint(day.attempts, out);
+  out->append(reinterpret_cast<const char*>(&day.value), sizeof(day.value));
+  out->append(reinterpret_cast<const char*>(&day.mean), sizeof(day.mean));
+  const auto crc =
+      static_cast<uint16_t>(Crc32(out->data() + begin, out->size() - begin));
+  out->append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+}
+
+std::string EmptySeries() {
+  AccuracySeriesHeader header = {};
+  std::memcpy(header.magic, kAccuracySeriesMagic, sizeof(header.magic));
+  header.version = kAccuracySeriesVersion;
+  return std::string(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool DayBefore(const AccuracyDay& day, int32_t wanted) {
+  return day.day < wanted;
+}
+
+}  // namespace
+
+AccuracySeries::~AccuracySeries() { Close(); }
+
+bool AccuracySeries::Open(const std::string& path) {
+  Close();
+  path_ = path;
+
+  // Un file esistente ma illeggibile non va sostituito con uno vuoto
+  std::string data;
+  if (FileExists(path) && !ReadFile(path, &data)) return false;
+  if (data.empty()) {
+    data = EmptySeries();
+    if (!WriteFileAtomically(path, data.data(), data.size())) return false;
+  }
+  size_t valid_end = 0;
+  size_t records = 0;
+  if (!Replay(data, &valid_end, &records)) {
+    Close();
+    return false;
+  }
+  fd_ = open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  // La coda non valida viene tolta prima di accodare altri record
+  if (fd_ < 0 || (valid_end < data.size() &&
+                  ftruncate(fd_, static_cast<off_t>(valid_end)) != 0)) {
+    Close();
+    return false;
+  }
+  file_size_ = valid_end;
+  records_ = records;
+  return true;
+}
+
+void AccuracySeries::Close() {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+  file_size_ = 0;
+  records_ = 0;
+  days_.clear();
+  prefix_.clear();
+  weeks_.clear();
+  streak_ = 0;
+  streak_before_last_ = 0;
+}
+
+bool AccuracySeries::Replay(const std::string& data, size_t* valid_end,
+                            size_t* records) {
+  if (data.size() < sizeof(AccuracySeriesHeader)) return false;
+  AccuracySeriesHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kAccuracySeriesMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != kAccuracySeriesVersion) {
+    return false;
+  }
+
+  const char* end = data.data() + data.size();
+  size_t offset = sizeof(AccuracySeriesHeader);
+  int64_t previous = -1;
+  while (offset < data.size()) {
+    const char* begin = data.data() + offset;
+    const char* p = begin;
+    uint32_t delta;
+    uint32_t attempts;
+    if (!GetVarint(&p, end, &delta) || !GetVarint(&p, end, &attempts) ||
+        static_cast<size_t>(end - p) < kRecordTail) {
+      break;
+    }
+    uint16_t crc;
+    std::memcpy(&crc, p + 2 * sizeof(float), sizeof(crc));
+    const size_t size = static_cast<size_t>(p - begin) + 2 * sizeof(float);
+    if (static_cast<uint16_t>(Crc32(begin, size)) != crc) break;
+    // Un record di sostituzione richiede un giorno precedente
+    if ((delta == 0 && days_.empty()) || previous + delta > INT32_MAX) break;
+
+    AccuracyDay day;
+    day.day = static_cast<int32_t>(previous + delta);
+    day.attempts = attempts;
+    std::memcpy(&day.value, p, sizeof(day.value));
+    std::memcpy(&day.mean, p + sizeof(float), sizeof(day.mean));
+    Apply(day);
+    previous = day.day;
+    (*records)++;
+    offset += size + sizeof(crc);
+  }
+  *valid_end = offset;
+  return true;
+}
+
+void AccuracySeries::Apply(const AccuracyDay& day) {
+  if (!days_.empty() && days_.back().day == day.day) {
+    AddToWeek(days_.back(), -1);
+    days_.back() = day;
+  } else {
+    days_.push_back(day);
+    prefix_.push_back(0);
+    streak_before_last_ = streak_;
+  }
+  // Ricalcolata dal giorno precedente per non accumulare errori di
+  // arrotondamento con molti risultati nello stesso giorno
+  const size_t last = days_.size() - 1;
+  prefix_[last] = (last > 0 ? prefix_[last - 1] : 0.0) + day.value;
+  AddToWeek(day, 1);
+  streak_ = day.value >= threshold_ ? streak_before_last_ + 1 : 0;
+}
+
+void AccuracySeries::AddToWeek(const AccuracyDay& day, int sign) {
+  const int32_t week = WeekOf(day.day);
+  auto it = std::lower_bound(
+      weeks_.begin(), weeks_.end(), week,
+      [](const AccuracyWeek& entry, int32_t wanted) { return entry.week < wanted; });
+  if (it == weeks_.end() || it->week != week) {
+    if (sign < 0) return;
+    it = weeks_.insert(it, AccuracyWeek());
+    it->week = week;
+  }
+  const uint32_t over = day.value >= threshold_ ? 1 : 0;
+  if (sign > 0) {
+    it->days++;
+    it->days_over_threshold += over;
+    it->attempts += day.attempts;
+    it->value_sum += day.value;
+  } else if (it->days <= 1) {
+    weeks_.erase(it);
+  } else {
+    it->days--;
+    it->days_over_threshold -= over;
+    it->attempts -= day.attempts;
+    it->value_sum -= day.value;
+  }
+}
+
+void AccuracySeries::Rebuild() {
+  std::vector<AccuracyDay> days;
+  days.swap(days_);
+  prefix_.clear();
+  weeks_.clear();
+  streak_ = 0;
+  streak_before_last_ = 0;
+  days_.reserve(days.size());
+  prefix_.reserve(days.size());
+  for (const AccuracyDay& day : days) Apply(day);
+}
+
+double AccuracySeries::WindowAverage(uint32_t count) const {
+  if (days_.empty() || count == 0) return 0.0;
+  const size_t n = std::min<size_t>(count, days_.size());
+  const size_t size = days_.size();
+  const double before = n < size ? prefix_[size - n - 1] : 0.0;
+  return (prefix_.back() - before) / static_cast<double>(n);
+}
+
+int32_t AccuracySeries::WeekOf(int32_t day) {
+  // L'1/1/1970 era giovedì: le settimane partono dal lunedì precedente
+  return static_cast<int32_t>((static_cast<int64_t>(day) + 3) / 7);
+}
+
+bool AccuracySeries::Record(int32_t day, float accuracy) {
+  if (fd_ < 0 || day < 0 || !std::isfinite(accuracy)) return false;
+
+  const auto it = std::lower_bound(days_.begin(), days_.end(), day, DayBefore);
+  AccuracyDay updated;
+  if (it != days_.end() && it->day == day) {
+    updated = *it;
+    updated.attempts++;
+    updated.value = (updated.value + accuracy) / 2;
+    updated.mean += (accuracy - updated.mean) / static_cast<float>(updated.attempts);
+  } else {
+    updated.day = day;
+    updated.attempts = 1;
+    updated.value = accuracy;
+    updated.mean = accuracy;
+  }
+  return Store(updated);
+}
+
+int AccuracySeries::SetDays(
+    const std::vector<std::pair<int32_t, float>>& values) {
+  if (fd_ < 0) return -1;
+  std::vector<AccuracyDay> days = days_;
+  int replaced = 0;
+  for (const auto& [day, value] : values) {
+    if (!std::isfinite(value)) return -1;
+    const auto it = std::lower_bound(days.begin(), days.end(), day, DayBefore);
+    if (it == days.end() || it->day != day) continue;
+    it->value = value;
+    replaced++;
+  }
+  if (replaced == 0) return 0;
+
+  days_.swap(days);
+  if (!Rewrite()) {
+    days_.swap(days);
+    return -1;
+  }
+  Rebuild();
+  return replaced;
+}
+
+bool AccuracySeries::Assign(const std::vector<AccuracyDay>& days) {
+  if (fd_ < 0) return false;
+  std::vector<AccuracyDay> sorted;
+  sorted.reserve(days.size());
+  for (const AccuracyDay& day : days) {
+    if (day.day < 0 || !std::isfinite(day.value) || !std::isfinite(day.mean)) {
+      return false;
+    }
+    sorted.push_back(day);
+  }
+  // A parità di giorno vale l'ultimo
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const AccuracyDay& a, const AccuracyDay& b) {
+                     return a.day < b.day;
+                   });
+  std::vector<AccuracyDay> merged;
+  merged.reserve(sorted.size());
+  for (const AccuracyDay& day : sorted) {
+    if (!merged.empty() && merged.back().day == day.day) {
+      merged.back() = day;
+    } else {
+      merged.push_back(day);
+    }
+  }
+
+  days_.swap(merged);
+  if (!Rewrite()) {
+    days_.swap(merged);
+    return false;
+  }
+  Rebuild();
+  return true;
+}
+
+bool AccuracySeries::Store(const AccuracyDay& day) {
+  // Caso comune: un risultato di oggi o di un giorno nuovo si accoda
+  if (days_.empty() || day.day >= days_.back().day) {
+    const int64_t previous = days_.empty() ? -1 : days_.back().day;
+    if (!AppendRecord(static_cast<uint32_t>(day.day - previous), day)) {
+      return false;
+    }
+    Apply(day);
+    if (records_ > 2 * days_.size() + kMinCompactRecords) {
+      Rewrite();  // Se fallisce la serie resta valida, solo più lunga
+    }
+    return true;
+  }
+
+  // Un giorno passato (storico ricalcolato, orologio spostato indietro)
+  // cambia i delta successivi: si riscrive la serie
+  const auto it = std::lower_bound(days_.begin(), days_.end(), day.day, DayBefore);
+  const bool found = it != days_.end() && it->day == day.day;
+  const size_t index = static_cast<size_t>(it - days_.begin());
+  AccuracyDay previous;
+  if (found) {
+    previous = *it;
+    *it = day;
+  } else {
+    days_.insert(it, day);
+  }
+  if (!Rewrite()) {
+    if (found) {
+      days_[index] = previous;
+    } else {
+      days_.erase(days_.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+    return false;
+  }
+  Rebuild();
+  return true;
+}
+
+bool AccuracySeries::AppendRecord(uint32_t delta, const AccuracyDay& day) {
+  if (fd_ < 0) return false;
+  record_.clear();
+  EncodeRecord(delta, day, &record_);
+  if (!WriteAll(fd_, record_.data(), record_.size()) || fdatasync(fd_) != 0) {
+    // Come in ProfileLog: si torna all'ultima fine valida, o si smette di
+    // scrivere se non si può
+    if (ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+    return false;
+  }
+  file_size_ += record_.size();
+  records_++;
+  return true;
+}
+
+bool AccuracySeries::Rewrite() {
+  std::string data = EmptySeries();
+  int64_t previous = -1;
+  for (const AccuracyDay& day : days_) {
+    EncodeRecord(static_cast<uint32_t>(day.day - previous), day, &data);
+    previous = day.day;
+  }
+  if (!WriteFileAtomically(path_, data.data(), data.size())) return false;
+
+  // Il descrittore punta ancora al file sostituito; se non si riapre la
+  // serie resta leggibile ma le scritture successive falliscono
+  if (fd_ >= 0) close(fd_);
+  fd_ = open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  file_size_ = data.size();
+  records_ = days_.size();
+  return true;
+}
+
+}  // namespace opendsa
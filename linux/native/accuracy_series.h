@@ -0,0 +1,139 @@
+// linux/native/accuracy_series.h
+
+#ifndef OPENDSA_NATIVE_ACCURACY_SERIES_H_
+#define OPENDSA_NATIVE_ACCURACY_SERIES_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opendsa {
+
+// Serie storica dell'accuratezza di un profilo, un valore per giorno, come
+// accuracyHistory/accuracyDates di GameService ma senza liste che crescono
+// e vengono risalvate per intero a ogni risultato.
+//
+// Media complessiva, giorni consecutivi sopra la soglia e media degli
+// ultimi N giorni sono mantenuti in modo incrementale e si leggono in O(1);
+// le aggregazioni per giorno e per settimana si aggiornano a ogni
+// risultato.
+//
+// Layout del file (little-endian):
+//   AccuracySeriesHeader                16 byte
+//   record...
+//
+// Record:
+//   day_delta  varint  giorni dal record precedente (dal giorno -1 per il
+//                      primo); 0 sostituisce il giorno precedente
+//   attempts   varint  risultati registrati nel giorno
+//   value      f32     valore del giorno (come in GameService: ogni nuovo
+//                      risultato fa la media con il valore precedente)
+//   mean       f32     media aritmetica dei risultati del giorno
+//   crc        u16     16 bit bassi del CRC32 dei byte precedenti del record
+//
+// Un nuovo risultato nello stesso giorno accoda un record con day_delta 0
+// invece di riscrivere il file; all'apertura un record troncato o con CRC
+// errato chiude la serie (scrittura interrotta) e il file viene compattato
+// quando i record superano il doppio dei giorni. Le date sono giorni
+// dall'1/1/1970 della data locale, calcolati dal chiamante.
+//
+// Non è thread-safe.
+constexpr char kAccuracySeriesMagic[8] = {'O', 'D', 'S', 'A', 'A', 'C', 'C', 'S'};
+constexpr uint32_t kAccuracySeriesVersion = 1;
+
+struct AccuracySeriesHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(AccuracySeriesHeader) == 16,
+              "AccuracySeriesHeader deve restare 16 byte");
+
+// Aggregazione di un giorno.
+struct AccuracyDay {
+  int32_t day = 0;
+  uint32_t attempts = 0;
+  float value = 0;  // Valore usato per media e progressione
+  float mean = 0;   // Media aritmetica dei risultati
+};
+
+// Aggregazione di una settimana (da lunedì a domenica).
+struct AccuracyWeek {
+  int32_t week = 0;  // Settimane dal lunedì 29/12/1969
+  uint32_t days = 0;
+  uint32_t days_over_threshold = 0;
+  uint32_t attempts = 0;
+  double value_sum = 0;
+};
+
+class AccuracySeries {
+ public:
+  explicit AccuracySeries(float threshold = 0.75f) : threshold_(threshold) {}
+  ~AccuracySeries();
+  AccuracySeries(const AccuracySeries&) = delete;
+  AccuracySeries& operator=(const AccuracySeries&) = delete;
+
+  // Apre la serie in |path|, creandola se non esiste. Restituisce false se
+  // il file non è accessibile o ha un formato diverso.
+  bool Open(const std::string& path);
+  void Close();
+
+  // Registra un risultato del giorno |day|. Restituisce false in caso di
+  // errore di scrittura (la serie in memoria resta quella precedente).
+  bool Record(int32_t day, float accuracy);
+
+  // Sostituisce i valori dei giorni già registrati in |values| (giorno,
+  // valore), ad esempio dopo un ricalcolo dello storico, con una sola
+  // scrittura; i giorni assenti vengono ignorati. Restituisce i giorni
+  // sostituiti, -1 in caso di errore.
+  int SetDays(const std::vector<std::pair<int32_t, float>>& values);
+
+  // Sostituisce l'intera serie con |days| (ad esempio per importare lo
+  // storico salvato nel profilo); a parità di giorno vale l'ultimo.
+  bool Assign(const std::vector<AccuracyDay>& days);
+
+  // Media dei valori giornalieri, 0 senza giorni.
+  double average() const {
+    return days_.empty() ? 0.0 : prefix_.back() / static_cast<double>(days_.size());
+  }
+
+  // Media degli ultimi |count| giorni registrati.
+  double WindowAverage(uint32_t count) const;
+
+  // Giorni registrati consecutivi, a partire dall'ultimo, con valore almeno
+  // pari alla soglia.
+  uint32_t streak() const { return streak_; }
+
+  const std::vector<AccuracyDay>& days() const { return days_; }
+  const std::vector<AccuracyWeek>& weeks() const { return weeks_; }
+  float threshold() const { return threshold_; }
+
+  static int32_t WeekOf(int32_t day);
+
+ private:
+  bool Replay(const std::string& data, size_t* valid_end, size_t* records);
+  void Apply(const AccuracyDay& day);
+  void AddToWeek(const AccuracyDay& day, int sign);
+  void Rebuild();
+  bool Store(const AccuracyDay& day);
+  bool AppendRecord(uint32_t delta, const AccuracyDay& day);
+  bool Rewrite();
+
+  float threshold_;
+  std::string path_;
+  int fd_ = -1;
+  uint64_t file_size_ = 0;
+  size_t records_ = 0;
+  std::vector<AccuracyDay> days_;
+  std::vector<double> prefix_;  // prefix_[i]: somma dei valori fino a i
+  std::vector<AccuracyWeek> weeks_;
+  uint32_t streak_ = 0;
+  uint32_t streak_before_last_ = 0;  // Streak esclusi l'ultimo giorno
+  std::string record_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ACCURACY_SERIES_H_
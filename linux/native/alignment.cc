@@ -0,0 +1,129 @@
+// linux/native/alignment.cc
+
+#include "alignment.h"
+
+#include <algorithm>
+
+namespace opendsa {
+
+int32_t Aligner::Distance(const std::u32string& target,
+                          const std::u32string& recognized,
+                          const CostMatrix& costs) {
+  const size_t n = target.size();
+  const size_t m = recognized.size();
+  const size_t width = m + 1;
+  rows_.resize(3 * width);
+
+  // Tre righe a rotazione: i-2 (per le trasposizioni), i-1 e i
+  int32_t* before = rows_.data();
+  int32_t* previous = before + width;
+  int32_t* current = previous + width;
+
+  for (size_t j = 0; j <= m; j++) {
+    previous[j] = static_cast<int32_t>(j) * costs.insertion();
+  }
+
+  for (size_t i = 1; i <= n; i++) {
+    const char32_t expected = target[i - 1];
+    current[0] = static_cast<int32_t>(i) * costs.deletion();
+    for (size_t j = 1; j <= m; j++) {
+      const char32_t actual = recognized[j - 1];
+      int32_t best = previous[j - 1] + costs.Substitution(expected, actual);
+      best = std::min(best, previous[j] + costs.deletion());
+      best = std::min(best, current[j - 1] + costs.insertion());
+      if (i > 1 && j > 1 && expected == recognized[j - 2] &&
+          target[i - 2] == actual) {
+        best = std::min(best, before[j - 2] + costs.transposition());
+      }
+      current[j] = best;
+    }
+    int32_t* recycled = before;
+    before = previous;
+    previous = current;
+    current = recycled;
+  }
+
+  return previous[m];
+}
+
+int32_t Aligner::Align(const std::u32string& target,
+                       const std::u32string& recognized,
+                       const CostMatrix& costs,
+                       std::vector<AlignmentStep>* path) {
+  const size_t n = target.size();
+  const size_t m = recognized.size();
+  const size_t width = m + 1;
+  matrix_.resize((n + 1) * width);
+  int32_t* d = matrix_.data();
+
+  for (size_t j = 0; j <= m; j++) {
+    d[j] = static_cast<int32_t>(j) * costs.insertion();
+  }
+  for (size_t i = 1; i <= n; i++) {
+    const char32_t expected = target[i - 1];
+    int32_t* row = d + i * width;
+    const int32_t* up = row - width;
+    row[0] = static_cast<int32_t>(i) * costs.deletion();
+    for (size_t j = 1; j <= m; j++) {
+      const char32_t actual = recognized[j - 1];
+      int32_t best = up[j - 1] + costs.Substitution(expected, actual);
+      best = std::min(best, up[j] + costs.deletion());
+      best = std::min(best, row[j - 1] + costs.insertion());
+      if (i > 1 && j > 1 && expected == recognized[j - 2] &&
+          target[i - 2] == actual) {
+        best = std::min(best, up[j - 2 - width] + costs.transposition());
+      }
+      row[j] = best;
+    }
+  }
+
+  // Ricostruzione del percorso a ritroso, preferendo le corrispondenze
+  path->clear();
+  size_t i = n;
+  size_t j = m;
+  while (i > 0 || j > 0) {
+    const int32_t value = d[i * width + j];
+    if (i > 0 && j > 0) {
+      const char32_t expected = target[i - 1];
+      const char32_t actual = recognized[j - 1];
+      const int32_t diagonal = d[(i - 1) * width + j - 1];
+      if (expected == actual && value == diagonal) {
+        path->push_back({EditOp::kMatch, static_cast<int32_t>(i - 1),
+                         static_cast<int32_t>(j - 1)});
+        i--;
+        j--;
+        continue;
+      }
+      if (i > 1 && j > 1 && expected == recognized[j - 2] &&
+          target[i - 2] == actual &&
+          value == d[(i - 2) * width + j - 2] + costs.transposition()) {
+        path->push_back({EditOp::kTransposition, static_cast<int32_t>(i - 2),
+                         static_cast<int32_t>(j - 2)});
+        i -= 2;
+        j -= 2;
+        continue;
+      }
+      if (value == diagonal + costs.Substitution(expected, actual)) {
+        path->push_back({EditOp::kSubstitution, static_cast<int32_t>(i - 1),
+                         static_cast<int32_t>(j - 1)});
+        i--;
+        j--;
+        continue;
+      }
+    }
+    if (i > 0 && value == d[(i - 1) * width + j] + costs.deletion()) {
+      path->push_back({EditOp::kDeletion, static_cast<int32_t>(i - 1),
+                       static_cast<int32_t>(j)});
+      i--;
+    } else {
+      path->push_back({EditOp::kInsertion, static_cast<int32_t>(i),
+                       static_cast<int32_t>(j - 1)});
+      j--;
+    }
+  }
+  std::reverse(path->begin(), path->end());
+
+  return d[n * width + m];
+}
+
+}  // namespace opendsa
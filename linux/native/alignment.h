@@ -0,0 +1,56 @@
+// linux/native/alignment.h
+
+#ifndef OPENDSA_NATIVE_ALIGNMENT_H_
+#define OPENDSA_NATIVE_ALIGNMENT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+enum class EditOp : uint8_t {
+  kMatch,
+  kSubstitution,
+  kInsertion,      // Carattere letto in più rispetto al testo atteso
+  kDeletion,       // Carattere atteso non letto
+  kTransposition,  // Due caratteri adiacenti invertiti
+};
+
+// Singolo passo dell'allineamento. Le posizioni sono indici di code point nei
+// testi normalizzati; per un'inserzione |target_pos| indica il carattere
+// atteso davanti al quale compare quello in più, per una cancellazione
+// |recognized_pos| fa lo stesso sul testo letto.
+struct AlignmentStep {
+  EditOp op;
+  int32_t target_pos;
+  int32_t recognized_pos;
+};
+
+// Distanza di Damerau-Levenshtein pesata fra testo atteso e testo letto.
+// I buffer della programmazione dinamica sono riutilizzati fra una chiamata e
+// l'altra, quindi un'istanza non va condivisa fra thread.
+class Aligner {
+ public:
+  // Solo distanza, in unità kCostUnit, tenendo in memoria tre righe.
+  int32_t Distance(const std::u32string& target,
+                   const std::u32string& recognized,
+                   const CostMatrix& costs);
+
+  // Distanza e percorso di allineamento completo, dal primo all'ultimo
+  // carattere. Usa la matrice piena per poter ricostruire il percorso.
+  int32_t Align(const std::u32string& target,
+                const std::u32string& recognized,
+                const CostMatrix& costs,
+                std::vector<AlignmentStep>* path);
+
+ private:
+  std::vector<int32_t> rows_;
+  std::vector<int32_t> matrix_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ALIGNMENT_H_
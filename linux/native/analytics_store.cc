@@ -0,0 +1,176 @@
+// linux/native/analytics_store.cc
+
+#include "analytics_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr size_t kFileSize =
+    sizeof(AnalyticsFileHeader) + 2 * sizeof(AnalyticsSlot);
+
+uint32_t SlotCrc(const AnalyticsSlot& slot) {
+  return Crc32(&slot, offsetof(AnalyticsSlot, crc));
+}
+
+bool SlotValid(const AnalyticsSlot& slot) { return SlotCrc(slot) == slot.crc; }
+
+void Welford(double value, uint64_t count, double* mean, double* m2) {
+  const double delta = value - *mean;
+  *mean += delta / static_cast<double>(count);
+  *m2 += delta * (value - *mean);
+}
+
+}  // namespace
+
+AnalyticsStore::~AnalyticsStore() { Close(); }
+
+bool AnalyticsStore::Open(const std::string& path) {
+  Close();
+
+  // Il file nuovo nasce completo, così un crash non lascia un'intestazione
+  // a metà
+  if (!FileExists(path)) {
+    std::string data(kFileSize, '\0');
+    AnalyticsFileHeader header = {};
+    std::memcpy(header.magic, kAnalyticsMagic, sizeof(header.magic));
+    header.version = kAnalyticsVersion;
+    header.slot_size = sizeof(AnalyticsSlot);
+    std::memcpy(&data[0], &header, sizeof(header));
+    AnalyticsSlot slot = {};
+    slot.crc = SlotCrc(slot);
+    std::memcpy(&data[sizeof(header)], &slot, sizeof(slot));
+    if (!WriteFileAtomically(path, data.data(), data.size())) return false;
+  }
+
+  const int fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0) return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != kFileSize) {
+    close(fd);
+    return false;
+  }
+  void* address =
+      mmap(nullptr, kFileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // La mappatura resta valida anche dopo la chiusura del descrittore
+  close(fd);
+  if (address == MAP_FAILED) return false;
+  map_ = address;
+
+  AnalyticsFileHeader header;
+  std::memcpy(&header, map_, sizeof(header));
+  slots_ = reinterpret_cast<AnalyticsSlot*>(static_cast<char*>(map_) +
+                                            sizeof(AnalyticsFileHeader));
+  const bool valid0 = SlotValid(slots_[0]);
+  const bool valid1 = SlotValid(slots_[1]);
+  if (std::memcmp(header.magic, kAnalyticsMagic, sizeof(header.magic)) != 0 ||
+      header.version != kAnalyticsVersion ||
+      header.slot_size != sizeof(AnalyticsSlot) || (!valid0 && !valid1)) {
+    Close();
+    return false;
+  }
+  active_ = valid0 && (!valid1 || slots_[0].sequence > slots_[1].sequence) ? 0 : 1;
+  return true;
+}
+
+void AnalyticsStore::Close() {
+  if (map_ != nullptr) {
+    msync(map_, kFileSize, MS_SYNC);
+    munmap(map_, kFileSize);
+  }
+  map_ = nullptr;
+  slots_ = nullptr;
+  active_ = 0;
+}
+
+AnalyticsSlot* AnalyticsStore::BeginUpdate() {
+  AnalyticsSlot* next = &slots_[1 - active_];
+  std::memcpy(next, &slots_[active_], sizeof(AnalyticsSlot));
+  next->sequence++;
+  return next;
+}
+
+void AnalyticsStore::Commit() {
+  AnalyticsSlot* next = &slots_[1 - active_];
+  next->crc = SlotCrc(*next);
+  active_ = 1 - active_;
+}
+
+void AnalyticsStore::Add(const AnalyticsSample& sample,
+                         AnalyticsAggregate* out) {
+  const uint64_t count = ++out->attempts;
+  if (sample.correct) out->successes++;
+  Welford(sample.similarity, count, &out->similarity_mean, &out->similarity_m2);
+  Welford(sample.seconds, count, &out->time_mean, &out->time_m2);
+  out->similarity_min =
+      count == 1 ? sample.similarity : std::min(out->similarity_min, sample.similarity);
+  out->similarity_max =
+      count == 1 ? sample.similarity : std::max(out->similarity_max, sample.similarity);
+
+  if (!sample.correct) out->errors[0]++;
+  for (int kind = 1; kind < kAnalyticsErrorKinds; kind++) {
+    out->errors[kind] += sample.errors[kind];
+  }
+  const int bucket = std::clamp(
+      static_cast<int>(sample.similarity * kAnalyticsSimilarityBuckets), 0,
+      kAnalyticsSimilarityBuckets - 1);
+  out->similarity_buckets[bucket]++;
+}
+
+bool AnalyticsStore::Record(const AnalyticsSample& sample) {
+  if (slots_ == nullptr || !std::isfinite(sample.similarity) ||
+      !std::isfinite(sample.seconds)) {
+    return false;
+  }
+  AnalyticsSlot* next = BeginUpdate();
+  Add(sample, &next->total);
+  Add(sample, &next->session);
+  Commit();
+  return true;
+}
+
+bool AnalyticsStore::StartSession(int64_t start_ms) {
+  if (slots_ == nullptr) return false;
+  AnalyticsSlot* next = BeginUpdate();
+  next->session = AnalyticsAggregate();
+  next->session_start_ms = start_ms;
+  Commit();
+  return true;
+}
+
+bool AnalyticsStore::SetTotal(const AnalyticsAggregate& total) {
+  if (slots_ == nullptr) return false;
+  AnalyticsSlot* next = BeginUpdate();
+  next->total = total;
+  Commit();
+  return true;
+}
+
+bool AnalyticsStore::Reset() {
+  if (slots_ == nullptr) return false;
+  AnalyticsSlot* next = BeginUpdate();
+  next->total = AnalyticsAggregate();
+  next->session = AnalyticsAggregate();
+  next->session_start_ms = 0;
+  Commit();
+  return true;
+}
+
+bool AnalyticsStore::Flush() {
+  return map_ != nullptr && msync(map_, kFileSize, MS_SYNC) == 0;
+}
+
+}  // namespace opendsa
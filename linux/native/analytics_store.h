@@ -0,0 +1,130 @@
+// linux/native/analytics_store.h
+
+#ifndef OPENDSA_NATIVE_ANALYTICS_STORE_H_
+#define OPENDSA_NATIVE_ANALYTICS_STORE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace opendsa {
+
+// Statistiche di apprendimento (come LearningStats di
+// LearningAnalyticsService) mantenute in un piccolo file a layout fisso,
+// mappato in memoria e aggiornato sul posto: ogni risultato costa lo stesso
+// lavoro indipendentemente dalla storia accumulata, senza decodificare e
+// ricodificare JSON.
+//
+// Layout del file (little-endian):
+//   AnalyticsFileHeader   16 byte
+//   AnalyticsSlot[2]
+//
+// Ogni aggiornamento scrive lo stato nuovo nello slot non attivo, con
+// sequence incrementata e CRC: all'apertura vale lo slot valido con la
+// sequenza più alta, quindi una scrittura interrotta lascia lo stato
+// precedente. Le pagine mappate vengono scritte su disco dal kernel;
+// Flush le forza subito.
+//
+// Non è thread-safe.
+constexpr char kAnalyticsMagic[8] = {'O', 'D', 'S', 'A', 'A', 'N', 'L', 'Y'};
+constexpr uint32_t kAnalyticsVersion = 1;
+
+// errors[0] conta i risultati errati; errors[k] per k = 1..6 gli errori di
+// lettura diagnosticati di tipo EditKind k.
+constexpr int kAnalyticsErrorKinds = 8;
+// Istogramma della similarità a intervalli di 0.1.
+constexpr int kAnalyticsSimilarityBuckets = 10;
+
+struct AnalyticsAggregate {
+  uint64_t attempts;
+  uint64_t successes;
+  double similarity_mean;
+  double similarity_m2;  // Somma dei quadrati degli scarti (Welford)
+  double similarity_min;
+  double similarity_max;
+  double time_mean;      // Secondi
+  double time_m2;
+  uint64_t errors[kAnalyticsErrorKinds];
+  uint64_t similarity_buckets[kAnalyticsSimilarityBuckets];
+};
+
+struct AnalyticsSlot {
+  uint64_t sequence;
+  int64_t session_start_ms;  // 0 senza sessione
+  AnalyticsAggregate total;
+  AnalyticsAggregate session;
+  uint32_t crc;  // CRC32 dei byte precedenti dello slot
+  uint32_t reserved;
+};
+
+struct AnalyticsFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t slot_size;
+};
+
+static_assert(sizeof(AnalyticsAggregate) == 208,
+              "AnalyticsAggregate deve restare 208 byte");
+static_assert(sizeof(AnalyticsSlot) == 440,
+              "AnalyticsSlot deve restare 440 byte");
+static_assert(sizeof(AnalyticsFileHeader) == 16,
+              "AnalyticsFileHeader deve restare 16 byte");
+
+// Un risultato da aggiungere alle statistiche.
+struct AnalyticsSample {
+  double similarity = 0;
+  double seconds = 0;
+  bool correct = false;
+  uint32_t errors[kAnalyticsErrorKinds] = {};  // Indice 0 ignorato
+};
+
+class AnalyticsStore {
+ public:
+  AnalyticsStore() = default;
+  ~AnalyticsStore();
+  AnalyticsStore(const AnalyticsStore&) = delete;
+  AnalyticsStore& operator=(const AnalyticsStore&) = delete;
+
+  // Apre il file in |path|, creandolo se non esiste. Restituisce false se
+  // il file non è accessibile, ha un formato diverso o nessuno slot valido.
+  bool Open(const std::string& path);
+  void Close();
+
+  // Aggiunge |sample| al totale e alla sessione corrente.
+  bool Record(const AnalyticsSample& sample);
+
+  // Azzera le statistiche della sessione e ne registra l'inizio.
+  bool StartSession(int64_t start_ms);
+
+  // Sostituisce il totale, ad esempio per importare statistiche salvate
+  // in un altro formato.
+  bool SetTotal(const AnalyticsAggregate& total);
+
+  // Azzera totale e sessione.
+  bool Reset();
+
+  // Scrive su disco le pagine mappate.
+  bool Flush();
+
+  const AnalyticsAggregate& total() const { return current()->total; }
+  const AnalyticsAggregate& session() const { return current()->session; }
+  int64_t session_start_ms() const { return current()->session_start_ms; }
+  bool is_open() const { return slots_ != nullptr; }
+
+  static void Add(const AnalyticsSample& sample, AnalyticsAggregate* out);
+  static double Variance(double m2, uint64_t count) {
+    return count > 1 ? m2 / static_cast<double>(count) : 0.0;
+  }
+
+ private:
+  const AnalyticsSlot* current() const { return &slots_[active_]; }
+  AnalyticsSlot* BeginUpdate();
+  void Commit();
+
+  void* map_ = nullptr;
+  AnalyticsSlot* slots_ = nullptr;
+  int active_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ANALYTICS_STORE_H_
@@ -0,0 +1,816 @@
+// linux/native/async_logger.cc
+
+#include "async_logger.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "block_codec.h"
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kLiveSuffix[] = ".txt";
+constexpr char kArchiveSuffix[] = ".txt.lz";
+constexpr char kIndexSuffix[] = ".idx";
+constexpr size_t kDateLength = 10;     // AAAA-MM-GG
+constexpr size_t kBlockHeaderSize = 12;  // raw_size, size, crc32
+// Un blocco contiene righe intere: una riga molto lunga lo allarga oltre
+// block_size, fino a questo limite di sicurezza in lettura
+constexpr uint32_t kMaxRawBlockSize = 64 * 1024 * 1024;
+
+constexpr char kLevelChars[] = {'D', 'I', 'W', 'E'};
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+bool EndsWith(std::string_view text, std::string_view suffix) {
+  return text.size() >= suffix.size() &&
+         text.substr(text.size() - suffix.size()) == suffix;
+}
+
+// Spazi e caratteri di controllo chiuderebbero il tag nella riga
+char SanitizeTagChar(char c) {
+  return static_cast<unsigned char>(c) <= ' ' ? '_' : c;
+}
+
+bool ReadRange(int fd, uint64_t offset, size_t size, std::string* out) {
+  out->resize(size);
+  size_t done = 0;
+  while (done < size) {
+    const ssize_t count = pread(fd, &(*out)[done], size - done,
+                                static_cast<off_t>(offset + done));
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) return false;
+    done += static_cast<size_t>(count);
+  }
+  return true;
+}
+
+// Aggiunge a |builder| le righe di |text|, anche l'ultima se incompleta.
+void IndexLines(std::string_view text, LogIndexBuilder* builder) {
+  size_t start = 0;
+  while (start < text.size()) {
+    const size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      builder->Add(text.substr(start), text.size() - start);
+      return;
+    }
+    builder->Add(text.substr(start, end - start), end + 1 - start);
+    start = end + 1;
+  }
+}
+
+// Decodifica il blocco di archivio |block| (intestazione compresa) in |out|.
+bool DecodeArchiveBlock(std::string_view block, std::string* out) {
+  if (block.size() < kBlockHeaderSize) return false;
+  uint32_t fields[3];
+  std::memcpy(fields, block.data(), sizeof(fields));
+  const uint32_t raw_size = fields[0];
+  const uint32_t size = fields[1];
+  if (raw_size > kMaxRawBlockSize || size > raw_size ||
+      block.size() - kBlockHeaderSize != size) {
+    return false;
+  }
+  const auto* source =
+      reinterpret_cast<const uint8_t*>(block.data()) + kBlockHeaderSize;
+  out->resize(raw_size);
+  auto* target = reinterpret_cast<uint8_t*>(&(*out)[0]);
+  if (size == raw_size) {
+    std::memcpy(target, source, raw_size);
+  } else if (!DecompressBlock(source, size, target, raw_size)) {
+    return false;
+  }
+  return Crc32(target, raw_size) == fields[2];
+}
+
+}  // namespace
+
+AsyncLogger::AsyncLogger() : head_(&stub_), tail_(&stub_) {}
+
+AsyncLogger::~AsyncLogger() { Close(); }
+
+bool AsyncLogger::Open(const std::string& dir, const std::string& prefix,
+                       const AsyncLoggerOptions& options) {
+  Close();
+  struct stat info;
+  if (prefix.empty() || stat(dir.c_str(), &info) != 0 ||
+      !S_ISDIR(info.st_mode) || access(dir.c_str(), W_OK) != 0) {
+    return false;
+  }
+  dir_ = dir;
+  prefix_ = prefix;
+  options_ = options;
+  options_.ring_capacity = std::max<uint32_t>(options_.ring_capacity, 1);
+  options_.max_file_bytes = std::max<uint64_t>(options_.max_file_bytes, 1);
+  {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    ring_.clear();
+    ring_next_ = 0;
+  }
+  stopping_ = false;
+  failed_ = false;
+  accepting_.store(true, std::memory_order_release);
+  worker_ = std::thread(&AsyncLogger::Run, this);
+  return true;
+}
+
+void AsyncLogger::Close() {
+  accepting_.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  if (worker_.joinable()) worker_.join();
+
+  // Record accodati mentre il thread interno terminava
+  Drain();
+  if (fd_ >= 0) {
+    fdatasync(fd_);
+    close(fd_);
+  }
+  fd_ = -1;
+  date_.clear();
+  file_size_ = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = progress_;
+}
+
+bool AsyncLogger::Log(LogLevel level, std::string_view tag,
+                      std::string_view message) {
+  if (!accepting_.load(std::memory_order_acquire)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  const uint32_t pending = pending_.fetch_add(1, std::memory_order_relaxed);
+  if (pending >= options_.max_pending) {
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto* node = new Node();
+  node->time_ns = NowNanos();
+  node->level = level;
+  node->tag_size = static_cast<uint32_t>(tag.size());
+  node->text.reserve(tag.size() + message.size());
+  node->text.append(tag.data(), tag.size());
+  node->text.append(message.data(), message.size());
+  Push(node);
+  logged_.fetch_add(1, std::memory_order_relaxed);
+
+  // Senza lock: una notifica persa ritarda la scrittura al più di un
+  // intervallo
+  if (pending + 1 == kWakeRecords) wake_.notify_one();
+  return true;
+}
+
+void AsyncLogger::Push(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+  previous->next.store(node, std::memory_order_release);
+}
+
+AsyncLogger::Node* AsyncLogger::Pop() {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr) return nullptr;
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  // Un produttore ha scambiato head_ ma non ha ancora collegato il nodo: lo
+  // si riprende al giro successivo
+  if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+  Push(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+bool AsyncLogger::Flush(bool sync) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!worker_.joinable() || stopping_) return false;
+  const uint64_t ticket = ++flush_requested_;
+  if (sync) sync_requested_ = true;
+  wake_.notify_one();
+  flushed_.wait(lock, [&] { return flush_done_ >= ticket; });
+  const bool ok = !failed_;
+  failed_ = false;
+  return ok;
+}
+
+std::vector<std::string> AsyncLogger::Recent(size_t max) const {
+  std::lock_guard<std::mutex> lock(ring_mutex_);
+  const size_t count = std::min(max, ring_.size());
+  std::vector<std::string> lines;
+  lines.reserve(count);
+  // ring_next_ è la riga più vecchia (0 finché il buffer non è pieno)
+  const size_t start = ring_next_ + ring_.size() - count;
+  for (size_t i = 0; i < count; ++i) {
+    lines.push_back(ring_[(start + i) % ring_.size()]);
+  }
+  return lines;
+}
+
+AsyncLoggerStats AsyncLogger::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AsyncLoggerStats stats = stats_;
+  stats.records_logged = logged_.load(std::memory_order_relaxed);
+  stats.records_dropped = dropped_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AsyncLogger::Run() {
+  FormatTime(NowNanos());
+  {
+    std::lock_guard<std::mutex> files(files_mutex_);
+    ArchiveStaleSegments(cached_date_);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait_for(lock, options_.flush_interval, [this] {
+      return stopping_ || flush_requested_ > flush_done_ ||
+             pending_.load(std::memory_order_relaxed) >= kWakeRecords;
+    });
+    const bool stopping = stopping_;
+    const uint64_t ticket = flush_requested_;
+    const bool sync = sync_requested_;
+    sync_requested_ = false;
+    lock.unlock();
+
+    Drain();
+    if (sync && fd_ >= 0 && fdatasync(fd_) != 0) {
+      progress_.write_errors++;
+      write_failed_ = true;
+    }
+
+    lock.lock();
+    stats_ = progress_;
+    failed_ = failed_ || write_failed_;
+    write_failed_ = false;
+    flush_done_ = ticket;
+    flushed_.notify_all();
+    if (stopping) return;
+  }
+}
+
+void AsyncLogger::Drain() {
+  while (Node* node = Pop()) {
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    AppendLine(*node);
+    delete node;
+  }
+  WriteBatch();
+
+  if (batch_lines_.empty()) return;
+  std::lock_guard<std::mutex> lock(ring_mutex_);
+  for (std::string& line : batch_lines_) {
+    if (ring_.size() < options_.ring_capacity) {
+      ring_.push_back(std::move(line));
+    } else {
+      ring_[ring_next_] = std::move(line);
+      ring_next_ = (ring_next_ + 1) % ring_.size();
+    }
+  }
+  batch_lines_.clear();
+}
+
+void AsyncLogger::FormatTime(int64_t time_ns) {
+  const int64_t second = time_ns / 1000000000;
+  if (second == cached_second_) return;
+  cached_second_ = second;
+  const auto time = static_cast<time_t>(second);
+  struct tm local;
+  localtime_r(&time, &local);
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d",
+                local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+                local.tm_hour, local.tm_min, local.tm_sec);
+  cached_prefix_ = buffer;
+  cached_date_ = cached_prefix_.substr(0, kDateLength);
+}
+
+void AsyncLogger::AppendLine(const Node& node) {
+  FormatTime(node.time_ns);
+  if (cached_date_ != date_) {
+    WriteBatch();
+    std::lock_guard<std::mutex> files(files_mutex_);
+    if (!date_.empty()) CloseSegment(true);
+    OpenSegment(cached_date_);
+  }
+
+  char millis[8];
+  std::snprintf(millis, sizeof(millis), ".%03d ",
+                static_cast<int>(node.time_ns / 1000000 % 1000));
+  std::string line = cached_prefix_;
+  line += millis;
+  line += kLevelChars[static_cast<uint8_t>(node.level) & 3];
+  if (node.tag_size > 0) {
+    line += '@';
+    for (size_t i = 0; i < node.tag_size; ++i) {
+      line += SanitizeTagChar(node.text[i]);
+    }
+  }
+  line += ' ';
+  for (size_t i = node.tag_size; i < node.text.size(); ++i) {
+    const char c = node.text[i];
+    if (c == '\n') {
+      line += "\\n";
+    } else if (c == '\r') {
+      line += "\\r";
+    } else {
+      line += c;
+    }
+  }
+
+  // Il segmento si chiude prima della riga che gli farebbe superare il
+  // limite, a meno che sia vuoto
+  const uint64_t size = file_size_ + batch_.size();
+  if (size > 0 && size + line.size() + 1 > options_.max_file_bytes) {
+    WriteBatch();
+    std::lock_guard<std::mutex> files(files_mutex_);
+    CloseSegment(true);
+    OpenSegment(cached_date_);
+  }
+
+  batch_ += line;
+  batch_ += '\n';
+  batch_records_++;
+  batch_lines_.push_back(std::move(line));
+}
+
+bool AsyncLogger::WriteBatch() {
+  if (batch_.empty()) return true;
+  if (fd_ < 0 && !date_.empty()) {
+    std::lock_guard<std::mutex> files(files_mutex_);
+    OpenSegment(date_);
+  }
+  bool ok = fd_ >= 0 && WriteAll(fd_, batch_.data(), batch_.size());
+  if (ok) {
+    // Le righe di questo gruppo sono le ultime di batch_lines_
+    std::lock_guard<std::mutex> files(files_mutex_);
+    for (size_t i = batch_lines_.size() - batch_records_;
+         i < batch_lines_.size(); ++i) {
+      live_index_.Add(batch_lines_[i], batch_lines_[i].size() + 1);
+    }
+    file_size_ += batch_.size();
+    progress_.records_written += batch_records_;
+    progress_.bytes_written += batch_.size();
+    progress_.batches++;
+  } else {
+    // Come negli altri log: la riga scritta a metà viene tolta
+    if (fd_ >= 0 && ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+    progress_.write_errors++;
+    write_failed_ = true;
+  }
+  batch_.clear();
+  batch_records_ = 0;
+  return ok;
+}
+
+bool AsyncLogger::OpenSegment(const std::string& date) {
+  date_ = date;
+  file_size_ = 0;
+  fd_ = open(SegmentPath(date).c_str(),
+             O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd_ < 0) return false;
+  struct stat info;
+  if (fstat(fd_, &info) != 0) {
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  file_size_ = static_cast<uint64_t>(info.st_size);
+
+  // L'indice del segmento riaperto si ricostruisce dal testo già scritto
+  live_index_.Clear();
+  std::string data;
+  if (file_size_ > 0 && ReadFile(SegmentPath(date), &data)) {
+    IndexLines(data, &live_index_);
+  }
+  return true;
+}
+
+void AsyncLogger::CloseSegment(bool archive) {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+  if (archive) ArchiveSegment(SegmentPath(date_), date_);
+  live_index_.Clear();
+  file_size_ = 0;
+}
+
+bool AsyncLogger::ArchiveSegment(const std::string& path,
+                                 const std::string& date) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) return false;
+  if (info.st_size == 0) return unlink(path.c_str()) == 0;
+
+  // Prima si rinomina il segmento come chiuso: se la compressione si
+  // interrompe, all'apertura successiva viene ripresa senza duplicare righe
+  const std::string closed = ClosedPath(date, NextSequence(date));
+  if (rename(path.c_str(), closed.c_str()) != 0) return false;
+  return CompressSegment(closed);
+}
+
+bool AsyncLogger::CompressSegment(const std::string& closed) {
+  std::string data;
+  if (!ReadFile(closed, &data)) return false;
+
+  LogArchiveHeader header = {};
+  std::memcpy(header.magic, kLogArchiveMagic, sizeof(header.magic));
+  header.version = kLogArchiveVersion;
+  header.block_size = kLogArchiveBlockSize;
+  std::string archive(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // Blocchi di righe intere, con l'indice che li descrive
+  LogIndexBuilder builder(kLogArchiveBlockSize);
+  IndexLines(data, &builder);
+  std::vector<LogIndexEntry> entries = builder.Entries();
+
+  BlockCompressor compressor;
+  std::string packed;
+  for (LogIndexEntry& entry : entries) {
+    const size_t size = entry.raw_size;
+    const auto* raw =
+        reinterpret_cast<const uint8_t*>(data.data()) + entry.raw_offset;
+    entry.archive_offset = archive.size();
+    packed.clear();
+    compressor.Compress(raw, size, &packed);
+    // I blocchi che non si riducono restano come sono
+    const bool stored = packed.size() >= size;
+    const uint32_t fields[3] = {
+        static_cast<uint32_t>(size),
+        static_cast<uint32_t>(stored ? size : packed.size()),
+        Crc32(raw, size)};
+    archive.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+    if (stored) {
+      archive.append(reinterpret_cast<const char*>(raw), size);
+    } else {
+      archive += packed;
+    }
+    entry.archive_size = static_cast<uint32_t>(archive.size() -
+                                               entry.archive_offset);
+  }
+
+  // L'indice prima dell'archivio: un archivio presente ha sempre il suo
+  if (!WriteLogIndex(closed + kIndexSuffix, entries) ||
+      !WriteFileAtomically(closed + ".lz", archive.data(), archive.size())) {
+    return false;
+  }
+  unlink(closed.c_str());
+  progress_.rotations++;
+  progress_.bytes_archived += archive.size();
+  return true;
+}
+
+void AsyncLogger::ArchiveStaleSegments(const std::string& today) {
+  const std::vector<Segment> segments = ListSegments();
+  for (const Segment& segment : segments) {
+    if (segment.compressed) continue;
+    if (segment.sequence == 0) {
+      if (segment.date != today) {
+        ArchiveSegment(SegmentPath(segment.date), segment.date);
+      }
+      continue;
+    }
+    const std::string closed = ClosedPath(segment.date, segment.sequence);
+    const bool archived = std::any_of(
+        segments.begin(), segments.end(), [&](const Segment& other) {
+          return other.compressed && other.date == segment.date &&
+                 other.sequence == segment.sequence;
+        });
+    if (archived) {
+      unlink(closed.c_str());
+    } else {
+      CompressSegment(closed);
+    }
+  }
+}
+
+std::vector<AsyncLogger::Segment> AsyncLogger::ListSegments() const {
+  std::vector<Segment> segments;
+  DIR* dir = opendir(dir_.c_str());
+  if (dir == nullptr) return segments;
+  const std::string head = prefix_ + "_";
+  while (const dirent* entry = readdir(dir)) {
+    std::string_view name(entry->d_name);
+    if (name.substr(0, head.size()) != head) continue;
+    name.remove_prefix(head.size());
+    if (name.size() < kDateLength) continue;
+
+    Segment segment;
+    segment.date = std::string(name.substr(0, kDateLength));
+    name.remove_prefix(kDateLength);
+    if (name == kLiveSuffix) {
+      segments.push_back(std::move(segment));
+      continue;
+    }
+    segment.compressed = EndsWith(name, kArchiveSuffix);
+    if (segment.compressed) {
+      name.remove_suffix(sizeof(kArchiveSuffix) - 1);
+    } else if (EndsWith(name, kLiveSuffix)) {
+      name.remove_suffix(sizeof(kLiveSuffix) - 1);
+    } else {
+      continue;
+    }
+    // Resta ".<n>"
+    if (name.size() < 2 || name.size() > 10 || name[0] != '.') continue;
+    uint32_t sequence = 0;
+    bool digits = true;
+    for (const char c : name.substr(1)) {
+      if (c < '0' || c > '9') {
+        digits = false;
+        break;
+      }
+      sequence = sequence * 10 + static_cast<uint32_t>(c - '0');
+    }
+    if (!digits || sequence == 0) continue;
+    segment.sequence = sequence;
+    segments.push_back(std::move(segment));
+  }
+  closedir(dir);
+  return segments;
+}
+
+uint32_t AsyncLogger::NextSequence(const std::string& date) const {
+  uint32_t last = 0;
+  for (const Segment& segment : ListSegments()) {
+    if (segment.date == date) last = std::max(last, segment.sequence);
+  }
+  return last + 1;
+}
+
+std::string AsyncLogger::SegmentPath(const std::string& date) const {
+  return dir_ + "/" + prefix_ + "_" + date + kLiveSuffix;
+}
+
+std::string AsyncLogger::ClosedPath(const std::string& date,
+                                    uint32_t sequence) const {
+  return dir_ + "/" + prefix_ + "_" + date + "." + std::to_string(sequence) +
+         kLiveSuffix;
+}
+
+bool AsyncLogger::ReadDay(std::string_view date, std::string* out) {
+  out->clear();
+  if (date.size() != kDateLength) return false;
+  Flush(false);
+
+  std::lock_guard<std::mutex> files(files_mutex_);
+  std::vector<Segment> segments;
+  for (Segment& segment : ListSegments()) {
+    if (segment.date == date) segments.push_back(std::move(segment));
+  }
+  // Segmenti chiusi in ordine, il segmento corrente per ultimo; di un
+  // segmento presente in entrambe le forme si legge quella compressa
+  std::sort(segments.begin(), segments.end(),
+            [](const Segment& a, const Segment& b) {
+              const uint64_t a_order = a.sequence == 0 ? UINT32_MAX + 1ull
+                                                       : a.sequence;
+              const uint64_t b_order = b.sequence == 0 ? UINT32_MAX + 1ull
+                                                       : b.sequence;
+              return a_order != b_order ? a_order < b_order
+                                        : a.compressed > b.compressed;
+            });
+
+  bool ok = true;
+  std::string data;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const Segment& segment = segments[i];
+    if (i > 0 && segments[i - 1].sequence == segment.sequence) continue;
+    if (segment.compressed) {
+      const std::string path =
+          ClosedPath(segment.date, segment.sequence) + ".lz";
+      if (!ReadArchive(path, &data)) {
+        ok = false;
+        continue;
+      }
+    } else {
+      const std::string path = segment.sequence == 0
+                                   ? SegmentPath(segment.date)
+                                   : ClosedPath(segment.date, segment.sequence);
+      if (!ReadFile(path, &data)) {
+        ok = false;
+        continue;
+      }
+      // Una riga in corso di scrittura non viene restituita a metà
+      data.resize(data.rfind('\n') + 1);
+    }
+    *out += data;
+  }
+  return ok;
+}
+
+bool AsyncLogger::Query(const LogQuery& filter, std::vector<std::string>* lines,
+                        LogQueryStats* stats) {
+  lines->clear();
+  // Il tag cercato nella forma in cui viene scritto
+  LogQuery query = filter;
+  for (char& c : query.tag) c = SanitizeTagChar(c);
+  LogQueryStats unused;
+  if (stats == nullptr) stats = &unused;
+  *stats = LogQueryStats();
+  if (query.from_ms >= query.to_ms) return true;
+  Flush(false);
+
+  // Le date dei segmenti delimitano già l'intervallo di tempo
+  const std::string first_date =
+      query.from_ms == INT64_MIN ? std::string() : WallDate(query.from_ms);
+  const std::string last_date =
+      query.to_ms == INT64_MAX ? std::string() : WallDate(query.to_ms - 1);
+
+  std::lock_guard<std::mutex> files(files_mutex_);
+  std::vector<Segment> segments;
+  for (Segment& segment : ListSegments()) {
+    if ((!first_date.empty() && segment.date < first_date) ||
+        (!last_date.empty() && segment.date > last_date)) {
+      continue;
+    }
+    segments.push_back(std::move(segment));
+  }
+  // Dal segmento più recente: giorni a ritroso e, nel giorno, il segmento
+  // corrente e poi i chiusi dall'ultimo, preferendo la forma compressa
+  std::sort(segments.begin(), segments.end(),
+            [](const Segment& a, const Segment& b) {
+              if (a.date != b.date) return a.date > b.date;
+              const uint64_t a_order = a.sequence == 0 ? UINT32_MAX + 1ull
+                                                       : a.sequence;
+              const uint64_t b_order = b.sequence == 0 ? UINT32_MAX + 1ull
+                                                       : b.sequence;
+              return a_order != b_order ? a_order > b_order
+                                        : a.compressed > b.compressed;
+            });
+
+  bool ok = true;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (query.limit > 0 && lines->size() >= query.limit) break;
+    const Segment& segment = segments[i];
+    if (i > 0 && segments[i - 1].date == segment.date &&
+        segments[i - 1].sequence == segment.sequence) {
+      continue;
+    }
+    stats->segments++;
+    if (!QuerySegment(segment, query, lines, stats)) ok = false;
+  }
+  // Raccolte dalla più recente
+  std::reverse(lines->begin(), lines->end());
+  return ok;
+}
+
+bool AsyncLogger::QuerySegment(const Segment& segment, const LogQuery& query,
+                               std::vector<std::string>* lines,
+                               LogQueryStats* stats) {
+  const uint8_t levels = static_cast<uint8_t>(
+      0xF << static_cast<uint8_t>(query.min_level) & 0xF);
+  const uint64_t tag_bits = LogTagBits(query.tag);
+
+  // Tre casi: il segmento corrente con l'indice in memoria, un archivio con
+  // il suo file di indice, oppure (segmento non indicizzato) tutto il testo
+  // letto e indicizzato qui
+  std::vector<LogIndexEntry> entries;
+  std::string text;
+  std::string path;
+  bool archive = false;
+  if (segment.sequence == 0 && segment.date == date_) {
+    entries = live_index_.Entries();
+    path = SegmentPath(segment.date);
+  } else if (segment.compressed &&
+             ReadLogIndex(ClosedPath(segment.date, segment.sequence) +
+                              kIndexSuffix,
+                          &entries)) {
+    path = ClosedPath(segment.date, segment.sequence) + ".lz";
+    archive = true;
+  } else {
+    const std::string source =
+        segment.sequence == 0 ? SegmentPath(segment.date)
+                              : ClosedPath(segment.date, segment.sequence);
+    if (segment.compressed ? !ReadArchive(source + ".lz", &text)
+                           : !ReadFile(source, &text)) {
+      return false;
+    }
+    LogIndexBuilder builder(kLogArchiveBlockSize);
+    IndexLines(text, &builder);
+    entries = builder.Entries();
+  }
+
+  int fd = -1;
+  if (!path.empty()) {
+    fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+  }
+  bool ok = true;
+  std::string raw;
+  std::string block;
+  for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+    if (query.limit > 0 && lines->size() >= query.limit) break;
+    stats->blocks++;
+    if ((entry->levels & levels) == 0 || entry->last_ms < query.from_ms ||
+        entry->first_ms >= query.to_ms ||
+        (entry->tags & tag_bits) != tag_bits) {
+      continue;
+    }
+
+    std::string_view data;
+    if (fd < 0) {
+      data = std::string_view(text).substr(entry->raw_offset, entry->raw_size);
+    } else if (archive) {
+      if (!ReadRange(fd, entry->archive_offset, entry->archive_size, &raw) ||
+          !DecodeArchiveBlock(raw, &block) || block.size() != entry->raw_size) {
+        ok = false;
+        continue;
+      }
+      data = block;
+    } else {
+      if (!ReadRange(fd, entry->raw_offset, entry->raw_size, &block)) {
+        ok = false;
+        continue;
+      }
+      data = block;
+    }
+    stats->blocks_read++;
+
+    // Righe del blocco dall'ultima, ciascuna verificata per intero
+    if (!data.empty() && data.back() == '\n') data.remove_suffix(1);
+    while (!data.empty()) {
+      if (query.limit > 0 && lines->size() >= query.limit) break;
+      const size_t newline = data.rfind('\n');
+      const std::string_view line =
+          newline == std::string_view::npos ? data : data.substr(newline + 1);
+      data.remove_suffix(newline == std::string_view::npos
+                             ? data.size()
+                             : data.size() - newline);
+      stats->lines_scanned++;
+      LogLine parsed;
+      if (!ParseLogLine(line, &parsed) ||
+          parsed.level < static_cast<uint8_t>(query.min_level) ||
+          parsed.time_ms < query.from_ms || parsed.time_ms >= query.to_ms ||
+          (!query.tag.empty() && parsed.tag != query.tag)) {
+        continue;
+      }
+      stats->lines_matched++;
+      lines->emplace_back(line);
+    }
+  }
+  if (fd >= 0) close(fd);
+  return ok;
+}
+
+bool AsyncLogger::ReadArchive(const std::string& path, std::string* out) {
+  out->clear();
+  std::string data;
+  if (!ReadFile(path, &data) || data.size() < sizeof(LogArchiveHeader)) {
+    return false;
+  }
+  LogArchiveHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kLogArchiveMagic, sizeof(header.magic)) != 0 ||
+      header.version != kLogArchiveVersion) {
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  std::string block;
+  while (offset < data.size()) {
+    if (data.size() - offset < kBlockHeaderSize) return false;
+    uint32_t size;
+    std::memcpy(&size, data.data() + offset + sizeof(uint32_t), sizeof(size));
+    if (data.size() - offset - kBlockHeaderSize < size ||
+        !DecodeArchiveBlock(std::string_view(data).substr(
+                                offset, kBlockHeaderSize + size),
+                            &block)) {
+      return false;
+    }
+    *out += block;
+    offset += kBlockHeaderSize + size;
+  }
+  return true;
+}
+
+}  // namespace opendsa
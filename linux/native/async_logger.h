@@ -0,0 +1,238 @@
+// linux/native/async_logger.h
+
+#ifndef OPENDSA_NATIVE_ASYNC_LOGGER_H_
+#define OPENDSA_NATIVE_ASYNC_LOGGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "log_index.h"
+
+namespace opendsa {
+
+// Log di testo scritto in background, per i log dei servizi dell'app.
+//
+// Log() accoda il messaggio in una coda MPSC senza lock (un exchange
+// atomico, nessuna system call) e torna subito: può essere chiamato da Dart
+// e da qualsiasi thread nativo. Un thread interno svuota la coda a
+// intervalli regolari, o prima se si accumulano kWakeRecords record, e
+// scrive ogni gruppo di righe con una sola write. Se il thread resta
+// indietro oltre max_pending record, i nuovi vengono scartati e contati.
+//
+// Ogni riga è "AAAA-MM-GGTHH:MM:SS.mmm L messaggio", con l'ora locale e il
+// livello (D, I, W, E), oppure "... L@tag messaggio" con un tag di contesto
+// (ad esempio il servizio che ha registrato l'errore); gli a capo nel
+// messaggio diventano "\n", gli spazi nel tag "_".
+//
+// File in |dir|:
+//   <prefix>_<data>.txt          segmento corrente del giorno
+//   <prefix>_<data>.<n>.txt.lz   segmenti chiusi, compressi (n da 1)
+//
+// Un segmento viene chiuso quando supera max_file_bytes o quando arriva un
+// record di un altro giorno; viene poi compresso a blocchi con
+// BlockCompressor, con accanto l'indice dei blocchi (vedi log_index.h).
+// All'apertura i segmenti dei giorni precedenti rimasti aperti (ad esempio
+// dopo un crash) vengono chiusi allo stesso modo.
+//
+// Formato dei segmenti compressi (little-endian):
+//   LogArchiveHeader                16 byte
+//   per ogni blocco di righe intere: raw_size u32, size u32, crc32 u32 dei
+//   byte originali, poi size byte (compressi, o così come sono se
+//   size == raw_size)
+//
+// Le ultime ring_capacity righe restano anche in memoria (Recent).
+constexpr char kLogArchiveMagic[8] = {'O', 'D', 'S', 'A', 'L', 'O', 'G', 'Z'};
+constexpr uint32_t kLogArchiveVersion = 1;
+constexpr uint32_t kLogArchiveBlockSize = 64 * 1024;
+
+struct LogArchiveHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t block_size;
+};
+
+static_assert(sizeof(LogArchiveHeader) == 16,
+              "LogArchiveHeader deve restare 16 byte");
+
+enum class LogLevel : uint8_t { kDebug = 0, kInfo, kWarning, kError };
+
+struct AsyncLoggerOptions {
+  uint64_t max_file_bytes = 1024 * 1024;
+  uint32_t ring_capacity = 1000;
+  uint32_t max_pending = 64 * 1024;
+  std::chrono::milliseconds flush_interval{250};
+};
+
+// Filtri di AsyncLogger::Query; i tempi sono ore da parete (log_index.h).
+struct LogQuery {
+  int64_t from_ms = INT64_MIN;  // Incluso
+  int64_t to_ms = INT64_MAX;    // Escluso
+  LogLevel min_level = LogLevel::kDebug;
+  std::string tag;              // Vuoto = tutti
+  size_t limit = 0;             // Le più recenti; 0 = tutte
+};
+
+struct LogQueryStats {
+  uint64_t segments = 0;        // Segmenti nell'intervallo di date
+  uint64_t blocks = 0;          // Blocchi di indice considerati
+  uint64_t blocks_read = 0;     // Blocchi decodificati
+  uint64_t lines_scanned = 0;
+  uint64_t lines_matched = 0;
+};
+
+struct AsyncLoggerStats {
+  uint64_t records_logged = 0;   // Accettati da Log
+  uint64_t records_dropped = 0;  // Scartati: coda piena o logger chiuso
+  uint64_t records_written = 0;
+  uint64_t batches = 0;          // Write eseguite dal thread interno
+  uint64_t bytes_written = 0;
+  uint64_t rotations = 0;        // Segmenti chiusi e compressi
+  uint64_t bytes_archived = 0;   // Byte dei segmenti compressi
+  uint64_t write_errors = 0;
+};
+
+class AsyncLogger {
+ public:
+  // Un record in arrivo dopo kWakeRecords non ancora scritti sveglia il
+  // thread interno senza attendere l'intervallo.
+  static constexpr uint32_t kWakeRecords = 512;
+
+  AsyncLogger();
+  ~AsyncLogger();
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+  // Scrive i log in |dir| (che deve esistere) con nomi che iniziano per
+  // |prefix| e avvia il thread interno. Restituisce false se la directory
+  // non è accessibile.
+  bool Open(const std::string& dir, const std::string& prefix,
+            const AsyncLoggerOptions& options);
+
+  // Scrive i record in coda e ferma il thread interno.
+  void Close();
+
+  // Accoda |message| con il tag di contesto |tag| (anche vuoto).
+  // Restituisce false se il record è stato scartato.
+  bool Log(LogLevel level, std::string_view tag, std::string_view message);
+
+  // Attende che i record accodati finora siano scritti sul file; con
+  // |sync| anche l'fdatasync. Restituisce false se una scrittura non è
+  // riuscita.
+  bool Flush(bool sync);
+
+  // Le ultime |max| righe scritte, dalla più vecchia.
+  std::vector<std::string> Recent(size_t max) const;
+
+  // Righe del giorno |date| ("AAAA-MM-GG"), dai segmenti compressi in
+  // ordine e poi dal segmento corrente, in |out|. Scrive prima i record in
+  // coda. Restituisce false se un segmento non è leggibile.
+  bool ReadDay(std::string_view date, std::string* out);
+
+  // Le righe che soddisfano |query|, dalla più vecchia; con un limite, le
+  // più recenti. Legge gli indici dei segmenti e decodifica solo i blocchi
+  // che possono contenere righe valide. Scrive prima i record in coda.
+  // |stats| può essere nullptr. Restituisce false se un segmento non è
+  // leggibile (le righe degli altri vengono comunque restituite).
+  bool Query(const LogQuery& query, std::vector<std::string>* lines,
+             LogQueryStats* stats);
+
+  AsyncLoggerStats stats() const;
+  bool is_open() const { return worker_.joinable(); }
+
+  // Decomprime un segmento chiuso in |out|.
+  static bool ReadArchive(const std::string& path, std::string* out);
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    int64_t time_ns = 0;
+    LogLevel level = LogLevel::kInfo;
+    uint32_t tag_size = 0;
+    std::string text;  // Tag seguito dal messaggio, una sola allocazione
+  };
+
+  // Un file di log in |dir_|: sequence 0 è il segmento corrente del giorno.
+  struct Segment {
+    std::string date;
+    uint32_t sequence = 0;
+    bool compressed = false;
+  };
+
+  void Push(Node* node);
+  Node* Pop();
+  void Run();
+  void Drain();
+  void FormatTime(int64_t time_ns);
+  void AppendLine(const Node& node);
+  bool WriteBatch();
+  bool OpenSegment(const std::string& date);
+  void CloseSegment(bool archive);
+  bool ArchiveSegment(const std::string& path, const std::string& date);
+  bool CompressSegment(const std::string& closed);
+  bool QuerySegment(const Segment& segment, const LogQuery& query,
+                    std::vector<std::string>* lines, LogQueryStats* stats);
+  void ArchiveStaleSegments(const std::string& today);
+  std::vector<Segment> ListSegments() const;
+  uint32_t NextSequence(const std::string& date) const;
+  std::string SegmentPath(const std::string& date) const;
+  std::string ClosedPath(const std::string& date, uint32_t sequence) const;
+
+  std::string dir_;
+  std::string prefix_;
+  AsyncLoggerOptions options_;
+
+  // Coda MPSC intrusiva (Vyukov): i produttori scambiano head_, il thread
+  // interno consuma da tail_; stub_ tiene la coda sempre non vuota.
+  std::atomic<Node*> head_;
+  Node* tail_;
+  Node stub_;
+  std::atomic<uint32_t> pending_{0};
+  std::atomic<bool> accepting_{false};
+  std::atomic<uint64_t> logged_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  // Stato del thread interno
+  int fd_ = -1;
+  std::string date_;  // Giorno del segmento aperto
+  uint64_t file_size_ = 0;
+  std::string batch_;
+  uint64_t batch_records_ = 0;
+  std::vector<std::string> batch_lines_;
+  int64_t cached_second_ = INT64_MIN;
+  std::string cached_prefix_;  // "AAAA-MM-GGTHH:MM:SS" di cached_second_
+  std::string cached_date_;
+  AsyncLoggerStats progress_;  // Pubblicato in stats_ dopo ogni gruppo
+  bool write_failed_ = false;
+
+  // Rinomine e compressioni dei segmenti, e l'indice del segmento corrente,
+  // contro le letture di ReadDay e Query
+  std::mutex files_mutex_;
+  LogIndexBuilder live_index_{kLogArchiveBlockSize};
+
+  mutable std::mutex ring_mutex_;
+  std::vector<std::string> ring_;
+  size_t ring_next_ = 0;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable flushed_;
+  uint64_t flush_requested_ = 0;
+  uint64_t flush_done_ = 0;
+  bool sync_requested_ = false;
+  bool stopping_ = false;
+  bool failed_ = false;  // Scrittura non riuscita dall'ultimo Flush
+  AsyncLoggerStats stats_;
+  std::thread worker_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ASYNC_LOGGER_H_
@@ -0,0 +1,772 @@
+// linux/native/attempt_log.cc
+
+#include "attempt_log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "cost_matrix.h"
+#include "crc32.h"
+#include "file_utils.h"
+#include "similarity.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr size_t kColumnSizes[kAttemptColumns] = {
+    sizeof(int64_t),   // kTimestamp
+    sizeof(uint64_t),  // kRecognizedOffset
+    sizeof(uint32_t),  // kProfile
+    sizeof(uint32_t),  // kTarget
+    sizeof(uint32_t),  // kRecognizedLength
+    sizeof(uint32_t),  // kDuration
+    sizeof(float),     // kSimilarity
+    sizeof(float),     // kConfidence
+    sizeof(uint32_t),  // kErrors
+    sizeof(uint32_t),  // kConfusions
+    sizeof(uint8_t),   // kLevel
+    sizeof(int16_t),   // kUtcOffset
+};
+
+// Record della coda più corto: riga senza testo letto e CRC
+constexpr size_t kMinTailRecordSize = sizeof(AttemptRow) + sizeof(uint32_t);
+
+// Difesa da intestazioni corrotte
+constexpr uint32_t kMaxChunkRows = 1u << 20;
+
+constexpr int64_t kMsPerDay = 24LL * 60 * 60 * 1000;
+
+size_t Align8(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+// Offset di ogni colonna in un chunk di |rows| righe; restituisce la
+// dimensione del chunk.
+size_t ColumnLayout(uint32_t rows, size_t offsets[kAttemptColumns]) {
+  size_t offset = sizeof(AttemptChunkHeader);
+  for (int column = 0; column < kAttemptColumns; column++) {
+    offsets[column] = offset;
+    offset += Align8(kColumnSizes[column] * rows);
+  }
+  return offset;
+}
+
+double ColumnValue(const AttemptRow& row, int column) {
+  switch (static_cast<AttemptColumn>(column)) {
+    case AttemptColumn::kTimestamp:
+      return static_cast<double>(row.timestamp_ms);
+    case AttemptColumn::kRecognizedOffset:
+      return static_cast<double>(row.recognized_offset);
+    case AttemptColumn::kProfile:
+      return row.profile;
+    case AttemptColumn::kTarget:
+      return row.target;
+    case AttemptColumn::kRecognizedLength:
+      return row.recognized_length;
+    case AttemptColumn::kDuration:
+      return row.duration_ms;
+    case AttemptColumn::kSimilarity:
+      return row.similarity;
+    case AttemptColumn::kConfidence:
+      return row.confidence;
+    case AttemptColumn::kErrors:
+      return row.errors;
+    case AttemptColumn::kConfusions:
+      return row.confusions;
+    case AttemptColumn::kLevel:
+      return row.level;
+    case AttemptColumn::kUtcOffset:
+      return row.utc_offset_minutes;
+    case AttemptColumn::kCount:
+      break;
+  }
+  return 0;
+}
+
+// Campo di |row| che corrisponde a |column|.
+void* ColumnField(AttemptRow* row, int column) {
+  switch (static_cast<AttemptColumn>(column)) {
+    case AttemptColumn::kTimestamp: return &row->timestamp_ms;
+    case AttemptColumn::kRecognizedOffset: return &row->recognized_offset;
+    case AttemptColumn::kProfile: return &row->profile;
+    case AttemptColumn::kTarget: return &row->target;
+    case AttemptColumn::kRecognizedLength: return &row->recognized_length;
+    case AttemptColumn::kDuration: return &row->duration_ms;
+    case AttemptColumn::kSimilarity: return &row->similarity;
+    case AttemptColumn::kConfidence: return &row->confidence;
+    case AttemptColumn::kErrors: return &row->errors;
+    case AttemptColumn::kConfusions: return &row->confusions;
+    case AttemptColumn::kLevel: return &row->level;
+    case AttemptColumn::kUtcOffset: return &row->utc_offset_minutes;
+    case AttemptColumn::kCount: break;
+  }
+  return nullptr;
+}
+
+void StoreColumn(const AttemptRow& row, int column, uint32_t index,
+                 char* data) {
+  const size_t size = kColumnSizes[column];
+  std::memcpy(data + size * index,
+              ColumnField(const_cast<AttemptRow*>(&row), column), size);
+}
+
+// Ricompone la riga |index| di un chunk dalle sue colonne.
+AttemptRow LoadRow(const uint8_t* chunk, const size_t offsets[kAttemptColumns],
+                   uint32_t index) {
+  AttemptRow row;
+  for (int column = 0; column < kAttemptColumns; column++) {
+    const size_t size = kColumnSizes[column];
+    std::memcpy(ColumnField(&row, column), chunk + offsets[column] + size * index,
+                size);
+  }
+  return row;
+}
+
+uint32_t ChunkCrc(const uint8_t* chunk, size_t bytes) {
+  const size_t begin = offsetof(AttemptChunkHeader, rows);
+  return Crc32(chunk + begin, bytes - begin);
+}
+
+std::string EmptyTail(uint64_t base_row) {
+  AttemptTailHeader header = {};
+  std::memcpy(header.magic, kAttemptTailMagic, sizeof(header.magic));
+  header.version = kAttemptLogVersion;
+  header.base_row = base_row;
+  return std::string(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void EncodeTailRecord(const AttemptRow& row, std::string_view recognized,
+                      std::string* out) {
+  const uint32_t crc = Crc32(recognized.data(), recognized.size(),
+                             Crc32(&row, sizeof(row)));
+  out->append(reinterpret_cast<const char*>(&row), sizeof(row));
+  out->append(recognized);
+  out->append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+}
+
+int64_t FloorDiv(int64_t value, int64_t divisor) {
+  const int64_t quotient = value / divisor;
+  return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+// Stato di un'interrogazione condiviso fra chunk e coda.
+struct QueryPlan {
+  const AttemptQuery* query;
+  bool by_confusion;
+  uint32_t confusion_bit;  // 0 se la coppia non è tracciata: nessuna riga
+  std::map<int64_t, AttemptGroup> groups;
+
+  bool KeepTimestamp(int64_t value) const {
+    return value >= query->from_ms && value < query->to_ms;
+  }
+  bool KeepLevel(uint8_t value) const {
+    return value >= query->min_level && value <= query->max_level;
+  }
+  bool KeepErrors(uint32_t value) const {
+    return query->errors == 0 || (value & query->errors) != 0;
+  }
+  bool KeepConfusion(uint32_t value) const {
+    return (value & confusion_bit) != 0;
+  }
+
+  bool Keep(const AttemptRow& row) const {
+    return KeepTimestamp(row.timestamp_ms) && KeepLevel(row.level) &&
+           (query->profile < 0 || row.profile == query->profile) &&
+           (query->target < 0 || row.target == query->target) &&
+           KeepErrors(row.errors) &&
+           (!by_confusion || KeepConfusion(row.confusions));
+  }
+
+  // Giorni e settimane seguono il fuso registrato con ogni tentativo, come
+  // i riepiloghi di AttemptViews: un tentativo resta nel giorno in cui è
+  // stato fatto anche se poi il fuso cambia.
+  int64_t Key(int64_t timestamp_ms, int16_t utc_offset_minutes, uint8_t level,
+              uint32_t target, uint32_t profile) const {
+    const int64_t local =
+        timestamp_ms + static_cast<int64_t>(utc_offset_minutes) * 60000;
+    switch (query->group_by) {
+      case AttemptGroupBy::kNone:
+        return 0;
+      case AttemptGroupBy::kDay:
+        return FloorDiv(local, kMsPerDay);
+      case AttemptGroupBy::kWeek:
+        return FloorDiv(FloorDiv(local, kMsPerDay) + 3, 7);
+      case AttemptGroupBy::kLevel:
+        return level;
+      case AttemptGroupBy::kTarget:
+        return target;
+      case AttemptGroupBy::kProfile:
+        return profile;
+    }
+    return 0;
+  }
+
+  void Add(int64_t key, uint32_t errors, float similarity,
+           uint32_t duration_ms) {
+    AttemptGroup& group = groups[key];
+    group.key = key;
+    group.attempts++;
+    if ((errors & kAttemptIncorrect) == 0) group.correct++;
+    group.similarity_sum += similarity;
+    group.duration_sum_ms += duration_ms;
+  }
+};
+
+// Vero se nessuna riga del chunk può cadere in [low, high].
+bool Disjoint(const AttemptChunkHeader& header, AttemptColumn column,
+              double low, double high) {
+  const int index = static_cast<int>(column);
+  return header.max[index] < low || header.min[index] > high;
+}
+
+// Vero se tutte le righe del chunk cadono in [low, high].
+bool Covered(const AttemptChunkHeader& header, AttemptColumn column,
+             double low, double high) {
+  const int index = static_cast<int>(column);
+  return header.min[index] >= low && header.max[index] <= high;
+}
+
+}  // namespace
+
+AttemptLog::~AttemptLog() { Close(); }
+
+bool AttemptLog::Open(const std::string& path, bool sync,
+                      uint32_t chunk_rows) {
+  Close();
+  path_ = path;
+  sync_ = sync;
+  if (chunk_rows == 0 || chunk_rows > kMaxChunkRows) return false;
+
+  if (!dictionary_.Open(path + ".dict", sync)) {
+    Close();
+    return false;
+  }
+  for (const auto& [text, value] : dictionary_.entries()) {
+    const unsigned long id = std::strtoul(value.c_str(), nullptr, 10);
+    if (id >= kNoId) continue;
+    if (id >= strings_.size()) strings_.resize(id + 1);
+    strings_[id] = text;
+  }
+
+  if (!OpenChunks(chunk_rows) || !OpenTail() || !OpenText()) {
+    Close();
+    return false;
+  }
+  ReplayViews();
+  // Una coda piena rimasta da un crash durante la sigillatura; se non si
+  // riesce a sigillarla ora ci si riprova al prossimo Append
+  if (pending_.size() >= chunk_rows_) Seal();
+  return true;
+}
+
+void AttemptLog::Close() {
+  // Lo snapshot evita di riapplicare la coda alla prossima apertura
+  if (tail_fd_ >= 0 && size() > 0 && views_.rows() == size()) {
+    views_.Save(path_ + ".views");
+  }
+  if (fd_ >= 0) close(fd_);
+  if (tail_fd_ >= 0) close(tail_fd_);
+  if (text_fd_ >= 0) close(text_fd_);
+  fd_ = -1;
+  tail_fd_ = -1;
+  text_fd_ = -1;
+  file_.Close();
+  chunks_.clear();
+  file_size_ = 0;
+  sealed_rows_ = 0;
+  tail_size_ = 0;
+  text_sealed_ = 0;
+  pending_.clear();
+  pending_text_.clear();
+  dictionary_.Close();
+  strings_.clear();
+  views_.Clear();
+}
+
+bool AttemptLog::OpenChunks(uint32_t chunk_rows) {
+  if (!FileExists(path_)) {
+    AttemptLogHeader header = {};
+    std::memcpy(header.magic, kAttemptLogMagic, sizeof(header.magic));
+    header.version = kAttemptLogVersion;
+    header.chunk_rows = chunk_rows;
+    if (!WriteFileAtomically(path_, &header, sizeof(header))) return false;
+  }
+  if (!file_.Open(path_) || file_.size() < sizeof(AttemptLogHeader)) {
+    return false;
+  }
+  AttemptLogHeader header;
+  std::memcpy(&header, file_.data(), sizeof(header));
+  if (std::memcmp(header.magic, kAttemptLogMagic, sizeof(header.magic)) != 0 ||
+      header.version != kAttemptLogVersion || header.chunk_rows == 0 ||
+      header.chunk_rows > kMaxChunkRows) {
+    return false;
+  }
+  chunk_rows_ = header.chunk_rows;
+
+  // Il primo chunk troncato o con CRC errato segna la fine del file
+  size_t offset = sizeof(AttemptLogHeader);
+  while (file_.size() - offset >= sizeof(AttemptChunkHeader)) {
+    AttemptChunkHeader chunk;
+    std::memcpy(&chunk, file_.data() + offset, sizeof(chunk));
+    size_t offsets[kAttemptColumns];
+    if (std::memcmp(chunk.magic, kAttemptChunkMagic, sizeof(chunk.magic)) !=
+            0 ||
+        chunk.rows == 0 || chunk.rows > kMaxChunkRows ||
+        chunk.bytes != ColumnLayout(chunk.rows, offsets) ||
+        chunk.bytes > file_.size() - offset ||
+        ChunkCrc(file_.data() + offset, chunk.bytes) != chunk.crc) {
+      break;
+    }
+    chunks_.push_back(offset);
+    sealed_rows_ += chunk.rows;
+    text_sealed_ = chunk.text_end;
+    offset += chunk.bytes;
+  }
+
+  fd_ = open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  if (fd_ < 0 || (offset < file_.size() &&
+                  ftruncate(fd_, static_cast<off_t>(offset)) != 0)) {
+    return false;
+  }
+  file_size_ = offset;
+  return true;
+}
+
+bool AttemptLog::OpenTail() {
+  const std::string path = path_ + ".tail";
+  std::string data;
+  if (FileExists(path) && !ReadFile(path, &data)) return false;
+  if (data.empty()) {
+    data = EmptyTail(sealed_rows_);
+    if (!WriteFileAtomically(path, data.data(), data.size())) return false;
+  }
+  if (data.size() < sizeof(AttemptTailHeader)) return false;
+  AttemptTailHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kAttemptTailMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != kAttemptLogVersion) {
+    return false;
+  }
+
+  // Le righe già sigillate in un chunk prima che la coda venisse svuotata
+  // vengono saltate
+  uint64_t skip =
+      sealed_rows_ > header.base_row ? sealed_rows_ - header.base_row : 0;
+  size_t offset = sizeof(AttemptTailHeader);
+  while (data.size() - offset >= kMinTailRecordSize) {
+    AttemptRow row;
+    std::memcpy(&row, data.data() + offset, sizeof(row));
+    if (row.recognized_length >
+        data.size() - offset - kMinTailRecordSize) {
+      break;
+    }
+    const char* text = data.data() + offset + sizeof(row);
+    uint32_t crc;
+    std::memcpy(&crc, text + row.recognized_length, sizeof(crc));
+    if (Crc32(text, row.recognized_length, Crc32(&row, sizeof(row))) != crc) {
+      break;
+    }
+    offset += kMinTailRecordSize + row.recognized_length;
+    if (skip > 0) {
+      skip--;
+    } else {
+      // L'offset nell'heap segue i chunk rimasti validi, non quelli che
+      // c'erano quando la riga è stata accodata
+      row.recognized_offset = text_sealed_ + pending_text_.size();
+      pending_.push_back(row);
+      pending_text_.append(text, row.recognized_length);
+    }
+  }
+
+  // Una coda con righe già sigillate (o che si riferisce a chunk scartati)
+  // viene riscritta con le sole righe in attesa, così base_row torna a
+  // coincidere con le righe sigillate
+  if (header.base_row != sealed_rows_) {
+    data = EmptyTail(sealed_rows_);
+    for (const AttemptRow& row : pending_) {
+      EncodeTailRecord(row, PendingText(row), &data);
+    }
+    if (!WriteFileAtomically(path, data.data(), data.size())) return false;
+    offset = data.size();
+  }
+
+  tail_fd_ = open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  if (tail_fd_ < 0 || (offset < data.size() &&
+                       ftruncate(tail_fd_, static_cast<off_t>(offset)) != 0)) {
+    return false;
+  }
+  tail_size_ = offset;
+  return true;
+}
+
+bool AttemptLog::OpenText() {
+  // I byte oltre l'ultimo chunk sono di una sigillatura non riuscita e
+  // vengono riscritti dalla prossima
+  text_fd_ = open((path_ + ".text").c_str(),
+                  O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  return text_fd_ >= 0 &&
+         ftruncate(text_fd_, static_cast<off_t>(text_sealed_)) == 0;
+}
+
+std::string_view AttemptLog::PendingText(const AttemptRow& row) const {
+  return std::string_view(pending_text_)
+      .substr(row.recognized_offset - text_sealed_, row.recognized_length);
+}
+
+void AttemptLog::ReplayViews() {
+  // Uno snapshot che copre più righe di quelle presenti (una coda persa)
+  // non è più affidabile: i riepiloghi si ricostruiscono da capo
+  if (!views_.Load(path_ + ".views") || views_.rows() > size()) {
+    views_.Clear();
+  }
+  uint64_t row = 0;
+  for (const uint64_t offset : chunks_) {
+    const uint8_t* base = file_.data() + offset;
+    AttemptChunkHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (row + header.rows > views_.rows()) {
+      size_t offsets[kAttemptColumns];
+      ColumnLayout(header.rows, offsets);
+      for (uint32_t i = static_cast<uint32_t>(
+               std::max(views_.rows(), row) - row);
+           i < header.rows; i++) {
+        views_.Add(LoadRow(base, offsets, i));
+      }
+    }
+    row += header.rows;
+  }
+  for (const AttemptRow& pending : pending_) {
+    if (row++ >= views_.rows()) views_.Add(pending);
+  }
+}
+
+bool AttemptLog::Append(const AttemptRow& appended,
+                        std::string_view recognized) {
+  if (tail_fd_ < 0 || recognized.size() > UINT32_MAX) return false;
+  AttemptRow row = appended;
+  row.recognized_offset = text_sealed_ + pending_text_.size();
+  row.recognized_length = static_cast<uint32_t>(recognized.size());
+  std::string record;
+  EncodeTailRecord(row, recognized, &record);
+  if (!WriteAll(tail_fd_, record.data(), record.size()) ||
+      (sync_ && fdatasync(tail_fd_) != 0)) {
+    if (ftruncate(tail_fd_, static_cast<off_t>(tail_size_)) != 0) {
+      close(tail_fd_);
+      tail_fd_ = -1;
+    }
+    return false;
+  }
+  tail_size_ += record.size();
+  pending_.push_back(row);
+  pending_text_.append(recognized);
+  views_.Add(row);
+  // La riga è già al sicuro nella coda: un errore di sigillatura viene
+  // ritentato alla riga successiva
+  if (pending_.size() >= chunk_rows_) Seal();
+  return true;
+}
+
+bool AttemptLog::Seal() {
+  if (fd_ < 0 || text_fd_ < 0 || pending_.empty()) return false;
+  const auto rows = static_cast<uint32_t>(pending_.size());
+  size_t offsets[kAttemptColumns];
+  const size_t bytes = ColumnLayout(rows, offsets);
+  std::string chunk(bytes, '\0');
+
+  AttemptChunkHeader header = {};
+  std::memcpy(header.magic, kAttemptChunkMagic, sizeof(header.magic));
+  header.rows = rows;
+  header.bytes = static_cast<uint32_t>(bytes);
+  header.first_row = sealed_rows_;
+  header.text_end = text_sealed_ + pending_text_.size();
+  for (int column = 0; column < kAttemptColumns; column++) {
+    header.min[column] = ColumnValue(pending_[0], column);
+    header.max[column] = header.min[column];
+  }
+  for (uint32_t i = 0; i < rows; i++) {
+    const AttemptRow& row = pending_[i];
+    for (int column = 0; column < kAttemptColumns; column++) {
+      StoreColumn(row, column, i, &chunk[offsets[column]]);
+      const double value = ColumnValue(row, column);
+      header.min[column] = std::min(header.min[column], value);
+      header.max[column] = std::max(header.max[column], value);
+    }
+    header.errors_union |= row.errors;
+    header.confusions_union |= row.confusions;
+  }
+  std::memcpy(&chunk[0], &header, sizeof(header));
+  header.crc = ChunkCrc(reinterpret_cast<const uint8_t*>(chunk.data()), bytes);
+  std::memcpy(&chunk[0], &header, sizeof(header));
+
+  // I testi letti vanno nell'heap prima del chunk che li riferisce; se una
+  // delle due scritture fallisce l'heap torna alla fine dell'ultimo chunk
+  const bool written =
+      WriteAll(text_fd_, pending_text_.data(), pending_text_.size()) &&
+      (!sync_ || pending_text_.empty() || fdatasync(text_fd_) == 0) &&
+      WriteAll(fd_, chunk.data(), chunk.size()) &&
+      (!sync_ || fdatasync(fd_) == 0);
+  if (!written) {
+    if (ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+    if (ftruncate(text_fd_, static_cast<off_t>(text_sealed_)) != 0) {
+      close(text_fd_);
+      text_fd_ = -1;
+    }
+    return false;
+  }
+  chunks_.push_back(file_size_);
+  file_size_ += bytes;
+  sealed_rows_ += rows;
+  text_sealed_ = header.text_end;
+  pending_.clear();
+  pending_text_.clear();
+
+  // Se la coda non si svuota le sue righe vengono saltate alla riapertura
+  // grazie a base_row, quindi si può continuare ad accodare
+  const std::string tail_path = path_ + ".tail";
+  const std::string tail = EmptyTail(sealed_rows_);
+  if (WriteFileAtomically(tail_path, tail.data(), tail.size())) {
+    close(tail_fd_);
+    tail_fd_ = open(tail_path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    tail_size_ = tail.size();
+  }
+  views_.Save(path_ + ".views");
+  return Remap();
+}
+
+bool AttemptLog::Remap() {
+  return file_.Open(path_) && file_.size() >= file_size_;
+}
+
+uint32_t AttemptLog::Intern(std::string_view text) {
+  const uint32_t found = Find(text);
+  if (found != kNoId) return found;
+  if (!dictionary_.is_open() || strings_.size() >= kNoId) return kNoId;
+  const auto id = static_cast<uint32_t>(strings_.size());
+  if (dictionary_.Put(text, std::to_string(id)) < 0) return kNoId;
+  strings_.emplace_back(text);
+  return id;
+}
+
+bool AttemptLog::Recognized(const AttemptRow& row, std::string* out) const {
+  out->clear();
+  if (row.recognized_offset >= text_sealed_) {
+    if (row.recognized_offset - text_sealed_ + row.recognized_length >
+        pending_text_.size()) {
+      return false;
+    }
+    out->assign(PendingText(row));
+    return true;
+  }
+  if (text_fd_ < 0 ||
+      row.recognized_offset + row.recognized_length > text_sealed_) {
+    return false;
+  }
+  out->resize(row.recognized_length);
+  size_t done = 0;
+  while (done < out->size()) {
+    const ssize_t count =
+        pread(text_fd_, &(*out)[done], out->size() - done,
+              static_cast<off_t>(row.recognized_offset + done));
+    if (count <= 0) {
+      out->clear();
+      return false;
+    }
+    done += static_cast<size_t>(count);
+  }
+  return true;
+}
+
+uint32_t AttemptLog::Find(std::string_view text) const {
+  const std::string* value = dictionary_.Get(text);
+  if (value == nullptr) return kNoId;
+  const unsigned long id = std::strtoul(value->c_str(), nullptr, 10);
+  return id < strings_.size() ? static_cast<uint32_t>(id) : kNoId;
+}
+
+const std::string* AttemptLog::String(uint32_t id) const {
+  return id < strings_.size() ? &strings_[id] : nullptr;
+}
+
+uint32_t AttemptLog::ConfusionBit(char32_t a, char32_t b) {
+  const int pair = CommonConfusionPair(a, b);
+  return pair >= 0 ? 1u << pair : 0;
+}
+
+void AttemptLog::Query(const AttemptQuery& query,
+                       std::vector<AttemptGroup>* out,
+                       AttemptQueryStats* stats) const {
+  out->clear();
+  AttemptQueryStats local;
+  QueryPlan plan;
+  plan.query = &query;
+  plan.by_confusion = query.confusion_a != 0 || query.confusion_b != 0;
+  plan.confusion_bit = ConfusionBit(query.confusion_a, query.confusion_b);
+
+  const uint32_t confusion_bit = 1u << static_cast<int>(EditKind::kConfusion);
+  const uint32_t required_errors =
+      plan.by_confusion ? confusion_bit : query.errors;
+  const double from = static_cast<double>(query.from_ms);
+  // to_ms è escluso: il confronto sul massimo del chunk resta prudente
+  const double to = static_cast<double>(query.to_ms);
+
+  // Se l'ultima mappatura non è riuscita i chunk non si possono leggere
+  const bool mapped = file_.size() >= file_size_;
+  std::vector<uint32_t> selection;
+  std::vector<uint32_t> next;
+  for (const uint64_t offset : chunks_) {
+    if (!mapped) break;
+    local.chunks++;
+    const uint8_t* base = file_.data() + offset;
+    AttemptChunkHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (Disjoint(header, AttemptColumn::kTimestamp, from, to) ||
+        Disjoint(header, AttemptColumn::kLevel, query.min_level,
+                 query.max_level) ||
+        (query.profile >= 0 &&
+         Disjoint(header, AttemptColumn::kProfile, query.profile,
+                  query.profile)) ||
+        (query.target >= 0 &&
+         Disjoint(header, AttemptColumn::kTarget, query.target,
+                  query.target)) ||
+        (required_errors != 0 &&
+         (header.errors_union & required_errors) == 0) ||
+        (plan.by_confusion &&
+         (header.confusions_union & plan.confusion_bit) == 0)) {
+      continue;
+    }
+    local.chunks_scanned++;
+    local.rows_scanned += header.rows;
+
+    size_t offsets[kAttemptColumns];
+    ColumnLayout(header.rows, offsets);
+    auto column = [&](AttemptColumn which) {
+      local.columns_read++;
+      return base + offsets[static_cast<int>(which)];
+    };
+
+    // Ogni filtro legge solo la sua colonna e riduce la selezione; i filtri
+    // che il chunk soddisfa per intero vengono saltati
+    selection.resize(header.rows);
+    for (uint32_t i = 0; i < header.rows; i++) selection[i] = i;
+    auto filter = [&](AttemptColumn which, auto type, auto keep) {
+      using T = decltype(type);
+      const uint8_t* data = column(which);
+      next.clear();
+      for (const uint32_t i : selection) {
+        T value;
+        std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+        if (keep(value)) next.push_back(i);
+      }
+      selection.swap(next);
+    };
+    if (!Covered(header, AttemptColumn::kTimestamp, from, to - 1)) {
+      filter(AttemptColumn::kTimestamp, int64_t(),
+             [&](int64_t value) { return plan.KeepTimestamp(value); });
+    }
+    if (!Covered(header, AttemptColumn::kLevel, query.min_level,
+                 query.max_level)) {
+      filter(AttemptColumn::kLevel, uint8_t(),
+             [&](uint8_t value) { return plan.KeepLevel(value); });
+    }
+    if (query.profile >= 0 && !Covered(header, AttemptColumn::kProfile,
+                                       query.profile, query.profile)) {
+      filter(AttemptColumn::kProfile, uint32_t(),
+             [&](uint32_t value) { return value == query.profile; });
+    }
+    if (query.target >= 0 && !Covered(header, AttemptColumn::kTarget,
+                                      query.target, query.target)) {
+      filter(AttemptColumn::kTarget, uint32_t(),
+             [&](uint32_t value) { return value == query.target; });
+    }
+    if (query.errors != 0) {
+      filter(AttemptColumn::kErrors, uint32_t(),
+             [&](uint32_t value) { return plan.KeepErrors(value); });
+    }
+    if (plan.by_confusion) {
+      filter(AttemptColumn::kConfusions, uint32_t(),
+             [&](uint32_t value) { return plan.KeepConfusion(value); });
+    }
+    if (selection.empty()) continue;
+    local.rows_matched += selection.size();
+
+    const uint8_t* keys = nullptr;
+    const uint8_t* utc_offsets = nullptr;
+    size_t key_size = 0;
+    switch (query.group_by) {
+      case AttemptGroupBy::kNone:
+        break;
+      case AttemptGroupBy::kDay:
+      case AttemptGroupBy::kWeek:
+        keys = column(AttemptColumn::kTimestamp);
+        utc_offsets = column(AttemptColumn::kUtcOffset);
+        key_size = sizeof(int64_t);
+        break;
+      case AttemptGroupBy::kLevel:
+        keys = column(AttemptColumn::kLevel);
+        key_size = sizeof(uint8_t);
+        break;
+      case AttemptGroupBy::kTarget:
+        keys = column(AttemptColumn::kTarget);
+        key_size = sizeof(uint32_t);
+        break;
+      case AttemptGroupBy::kProfile:
+        keys = column(AttemptColumn::kProfile);
+        key_size = sizeof(uint32_t);
+        break;
+    }
+    const uint8_t* errors = column(AttemptColumn::kErrors);
+    const uint8_t* similarity = column(AttemptColumn::kSimilarity);
+    const uint8_t* duration = column(AttemptColumn::kDuration);
+    for (const uint32_t i : selection) {
+      int64_t timestamp = 0;
+      int16_t offset = 0;
+      uint8_t level = 0;
+      uint32_t id = 0;
+      if (key_size == sizeof(int64_t)) {
+        std::memcpy(&timestamp, keys + i * key_size, key_size);
+        std::memcpy(&offset, utc_offsets + i * sizeof(int16_t),
+                    sizeof(int16_t));
+      } else if (key_size == sizeof(uint8_t)) {
+        level = keys[i];
+      } else if (key_size == sizeof(uint32_t)) {
+        std::memcpy(&id, keys + i * key_size, key_size);
+      }
+      uint32_t row_errors;
+      float row_similarity;
+      uint32_t row_duration;
+      std::memcpy(&row_errors, errors + i * sizeof(uint32_t), sizeof(uint32_t));
+      std::memcpy(&row_similarity, similarity + i * sizeof(float),
+                  sizeof(float));
+      std::memcpy(&row_duration, duration + i * sizeof(uint32_t),
+                  sizeof(uint32_t));
+      plan.Add(plan.Key(timestamp, offset, level, id, id), row_errors,
+               row_similarity, row_duration);
+    }
+  }
+
+  // Le righe non ancora sigillate si leggono dalla memoria
+  for (const AttemptRow& row : pending_) {
+    local.rows_scanned++;
+    if (!plan.Keep(row)) continue;
+    local.rows_matched++;
+    plan.Add(plan.Key(row.timestamp_ms, row.utc_offset_minutes, row.level,
+                      row.target, row.profile),
+             row.errors, row.similarity, row.duration_ms);
+  }
+
+  out->reserve(plan.groups.size());
+  for (const auto& [key, group] : plan.groups) out->push_back(group);
+  if (stats != nullptr) *stats = local;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,248 @@
+// linux/native/attempt_log.h
+
+#ifndef OPENDSA_NATIVE_ATTEMPT_LOG_H_
+#define OPENDSA_NATIVE_ATTEMPT_LOG_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "attempt_views.h"
+#include "mapped_file.h"
+#include "profile_log.h"
+
+namespace opendsa {
+
+// Registro a colonne di tutti i tentativi di lettura, senza limite di
+// storia: una riga per tentativo (istante, profilo, livello, testo atteso e
+// letto, similarità, confidenza, durata, tipi di errore) invece delle
+// sessioni in JSON tagliate a AppConfig.maxStoredSessions.
+//
+// Le righe vengono accodate con CRC a un file di coda (<path>.tail) e,
+// ogni chunk_rows righe, sigillate in un chunk del file principale in cui
+// ogni colonna è un vettore contiguo e l'intestazione riporta minimo e
+// massimo di ogni colonna. Un'interrogazione salta i chunk esclusi da
+// minimo e massimo e legge solo le colonne dei filtri e delle aggregazioni.
+// Profili e testi attesi, pochi e ripetuti, sono sostituiti da
+// identificativi di un dizionario salvato come ProfileLog in <path>.dict; i
+// testi letti, quasi tutti diversi, vengono accodati a un heap di stringhe
+// in <path>.text e la riga ne riporta offset e lunghezza. Finché la riga è
+// nella coda il suo testo letto viaggia nel record della coda, e l'heap
+// viene scritto solo alla sigillatura del chunk. I riepiloghi per
+// livello e per giorno (AttemptViews) vengono aggiornati a ogni riga e
+// salvati in <path>.views a ogni chunk sigillato e alla chiusura.
+//
+// Layout del file principale (little-endian):
+//   AttemptLogHeader
+//   chunk...: AttemptChunkHeader, poi le colonne in ordine di
+//             AttemptColumn, ognuna allineata a 8 byte
+// Record della coda: AttemptRow, i recognized_length byte del testo letto,
+// poi il CRC32 di entrambi.
+//
+// Un chunk scritto a metà viene scartato all'apertura: le sue righe sono
+// ancora nella coda, che viene svuotata solo dopo il chunk. base_row nella
+// coda dice quante righe erano già sigillate, così le righe ripetute di un
+// chunk scritto prima del crash vengono ignorate.
+//
+// Non è thread-safe.
+constexpr char kAttemptLogMagic[8] = {'O', 'D', 'S', 'A', 'A', 'T', 'T', 'L'};
+constexpr char kAttemptTailMagic[8] = {'O', 'D', 'S', 'A', 'A', 'T', 'T', 'T'};
+constexpr char kAttemptChunkMagic[4] = {'O', 'D', 'C', 'H'};
+constexpr uint32_t kAttemptLogVersion = 2;
+constexpr uint32_t kAttemptChunkRows = 4096;
+
+// Bit di AttemptRow::errors: il bit 0 segna un risultato errato, il bit k
+// un errore di lettura di tipo EditKind k.
+constexpr uint32_t kAttemptIncorrect = 1;
+
+enum class AttemptColumn : int {
+  kTimestamp = 0,     // int64: millisecondi dall'epoca
+  kRecognizedOffset,  // uint64: offset del testo letto nell'heap
+  kProfile,           // uint32: id nel dizionario
+  kTarget,            // uint32: id nel dizionario
+  kRecognizedLength,  // uint32: byte del testo letto
+  kDuration,          // uint32: millisecondi
+  kSimilarity,        // float
+  kConfidence,        // float
+  kErrors,            // uint32: bit kAttemptIncorrect e EditKind
+  kConfusions,        // uint32: bit ConfusionBit delle coppie confuse
+  kLevel,             // uint8
+  kUtcOffset,      // int16: fuso locale del tentativo in minuti
+  kCount,
+};
+
+constexpr int kAttemptColumns = static_cast<int>(AttemptColumn::kCount);
+
+struct AttemptRow {
+  int64_t timestamp_ms = 0;
+  uint64_t recognized_offset = 0;  // Assegnato da Append
+  uint32_t profile = 0;
+  uint32_t target = 0;
+  uint32_t recognized_length = 0;  // Assegnato da Append
+  uint32_t duration_ms = 0;
+  float similarity = 0;
+  float confidence = 0;
+  uint32_t errors = 0;
+  uint32_t confusions = 0;
+  int16_t utc_offset_minutes = 0;
+  uint8_t level = 0;
+  uint8_t reserved[5] = {};
+};
+
+struct AttemptLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t chunk_rows;
+};
+
+struct AttemptChunkHeader {
+  char magic[4];
+  uint32_t crc;        // CRC32 del chunk da rows alla fine
+  uint32_t rows;
+  uint32_t bytes;      // Intestazione compresa
+  uint64_t first_row;
+  double min[kAttemptColumns];
+  double max[kAttemptColumns];
+  uint32_t errors_union;      // OR dei bit di errore delle righe
+  uint32_t confusions_union;  // OR dei bit delle coppie confuse
+  uint64_t text_end;          // Fine nell'heap dei testi letti del chunk
+};
+
+struct AttemptTailHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t base_row;  // Righe sigillate quando la coda è stata svuotata
+};
+
+static_assert(sizeof(AttemptRow) == 56, "AttemptRow deve restare 56 byte");
+static_assert(sizeof(AttemptLogHeader) == 16,
+              "AttemptLogHeader deve restare 16 byte");
+static_assert(sizeof(AttemptChunkHeader) == 232,
+              "AttemptChunkHeader deve restare 232 byte");
+static_assert(sizeof(AttemptTailHeader) == 24,
+              "AttemptTailHeader deve restare 24 byte");
+
+enum class AttemptGroupBy : int {
+  kNone = 0,
+  kDay = 1,      // Giorni dall'epoca nel fuso registrato col tentativo
+  kWeek = 2,     // Settimane dal lunedì 29/12/1969, come AccuracySeries
+  kLevel = 3,
+  kTarget = 4,   // Id del testo atteso
+  kProfile = 5,  // Id del profilo
+};
+
+// Filtri di un'interrogazione; i valori predefiniti non filtrano nulla.
+struct AttemptQuery {
+  int64_t from_ms = std::numeric_limits<int64_t>::min();  // Incluso
+  int64_t to_ms = std::numeric_limits<int64_t>::max();    // Escluso
+  int64_t profile = -1;  // Id, -1 = tutti
+  int64_t target = -1;
+  int32_t min_level = 0;
+  int32_t max_level = 255;
+  uint32_t errors = 0;  // Righe con almeno uno di questi bit, 0 = tutte
+  // Righe con una confusione fra queste due lettere, in un verso o
+  // nell'altro; 0 = tutte. Una coppia non fra le confusioni comuni non ha
+  // righe.
+  char32_t confusion_a = 0;
+  char32_t confusion_b = 0;
+  AttemptGroupBy group_by = AttemptGroupBy::kNone;
+};
+
+struct AttemptGroup {
+  int64_t key = 0;
+  uint64_t attempts = 0;
+  uint64_t correct = 0;
+  double similarity_sum = 0;
+  double duration_sum_ms = 0;
+};
+
+struct AttemptQueryStats {
+  uint64_t chunks = 0;          // Chunk sigillati
+  uint64_t chunks_scanned = 0;  // Chunk non esclusi da minimo e massimo
+  uint64_t rows_scanned = 0;
+  uint64_t rows_matched = 0;
+  uint64_t columns_read = 0;    // Colonne lette, sommate sui chunk
+};
+
+class AttemptLog {
+ public:
+  static constexpr uint32_t kNoId = UINT32_MAX;
+
+  AttemptLog() = default;
+  ~AttemptLog();
+  AttemptLog(const AttemptLog&) = delete;
+  AttemptLog& operator=(const AttemptLog&) = delete;
+
+  // Apre il registro in |path|, creandolo con chunk da |chunk_rows| righe
+  // se non esiste. Restituisce false se i file non sono accessibili o
+  // hanno un formato diverso.
+  bool Open(const std::string& path, bool sync = true,
+            uint32_t chunk_rows = kAttemptChunkRows);
+  void Close();
+
+  // Accoda una riga con il testo letto |recognized|; sigilla un chunk
+  // quando la coda è piena.
+  bool Append(const AttemptRow& row, std::string_view recognized);
+
+  // Testo letto di |row|. Restituisce false se l'heap non lo contiene.
+  bool Recognized(const AttemptRow& row, std::string* out) const;
+
+  // Id di |text| nel dizionario, aggiungendolo se manca; kNoId in caso di
+  // errore. Solo per profili e testi attesi: ogni testo nuovo costa una
+  // scrittura sincrona e resta nel dizionario.
+  uint32_t Intern(std::string_view text);
+
+  // Id di |text| senza aggiungerlo, kNoId se assente.
+  uint32_t Find(std::string_view text) const;
+
+  // Testo dell'id |id|, null se non esiste.
+  const std::string* String(uint32_t id) const;
+
+  // Aggrega le righe che soddisfano |query| in gruppi ordinati per chiave.
+  void Query(const AttemptQuery& query, std::vector<AttemptGroup>* out,
+             AttemptQueryStats* stats = nullptr) const;
+
+  // Riepiloghi materializzati per livello e per giorno.
+  const AttemptViews& views() const { return views_; }
+
+  uint64_t size() const { return sealed_rows_ + pending_.size(); }
+  size_t chunk_count() const { return chunks_.size(); }
+
+  // Bit di kConfusions della coppia {a, b} in un verso o nell'altro, 0 se
+  // non è fra le confusioni comuni (IsCommonConfusion).
+  static uint32_t ConfusionBit(char32_t a, char32_t b);
+
+ private:
+  bool OpenChunks(uint32_t chunk_rows);
+  bool OpenTail();
+  bool OpenText();
+  std::string_view PendingText(const AttemptRow& row) const;
+  bool Seal();
+  bool Remap();
+  void ReplayViews();
+
+  std::string path_;
+  bool sync_ = true;
+  uint32_t chunk_rows_ = kAttemptChunkRows;
+  MappedFile file_;
+  std::vector<uint64_t> chunks_;  // Offset dei chunk validi
+  uint64_t file_size_ = 0;
+  uint64_t sealed_rows_ = 0;
+  std::vector<AttemptRow> pending_;  // Righe nella coda
+  std::string pending_text_;         // Testi letti delle righe nella coda
+  int fd_ = -1;       // File principale, in accodamento
+  int tail_fd_ = -1;
+  uint64_t tail_size_ = 0;
+  int text_fd_ = -1;          // Heap dei testi letti
+  uint64_t text_sealed_ = 0;  // Byte dell'heap dei chunk sigillati
+  ProfileLog dictionary_;
+  std::vector<std::string> strings_;  // Id -> testo
+  AttemptViews views_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ATTEMPT_LOG_H_
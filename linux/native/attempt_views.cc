@@ -0,0 +1,143 @@
+// linux/native/attempt_views.cc
+
+#include "attempt_views.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "attempt_log.h"
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr int64_t kMsPerDay = 24LL * 60 * 60 * 1000;
+
+uint64_t LevelKey(uint32_t profile, uint32_t level) {
+  return static_cast<uint64_t>(profile) << 32 | level;
+}
+
+uint64_t DayKey(uint32_t profile, int32_t day) {
+  return static_cast<uint64_t>(profile) << 32 | static_cast<uint32_t>(day);
+}
+
+void AddTo(const AttemptRow& row, int32_t day, AttemptSummary* summary) {
+  if (summary->attempts == 0) {
+    summary->first_ms = row.timestamp_ms;
+    summary->last_ms = row.timestamp_ms;
+    summary->days = 1;
+    summary->last_day = day;
+  } else {
+    summary->first_ms = std::min(summary->first_ms, row.timestamp_ms);
+    summary->last_ms = std::max(summary->last_ms, row.timestamp_ms);
+    // I tentativi arrivano in ordine di tempo: un giorno nuovo è successivo
+    // all'ultimo visto
+    if (day > summary->last_day) {
+      summary->days++;
+      summary->last_day = day;
+    }
+  }
+  summary->attempts++;
+  if ((row.errors & kAttemptIncorrect) == 0) summary->correct++;
+  summary->similarity_sum += row.similarity;
+  summary->duration_sum_ms += row.duration_ms;
+  for (int kind = 0; kind < kAttemptSummaryErrors; kind++) {
+    if (row.errors & (1u << kind)) summary->errors[kind]++;
+  }
+}
+
+// Voci di una vista in ordine di chiave, così lo snapshot è deterministico.
+void AppendSorted(const std::unordered_map<uint64_t, AttemptSummary>& view,
+                  std::string* out) {
+  std::vector<AttemptViewEntry> entries;
+  entries.reserve(view.size());
+  for (const auto& [key, summary] : view) entries.push_back({key, summary});
+  std::sort(entries.begin(), entries.end(),
+            [](const AttemptViewEntry& a, const AttemptViewEntry& b) {
+              return a.key < b.key;
+            });
+  out->append(reinterpret_cast<const char*>(entries.data()),
+              entries.size() * sizeof(AttemptViewEntry));
+}
+
+}  // namespace
+
+int32_t AttemptViews::DayOf(int64_t timestamp_ms, int32_t utc_offset_minutes) {
+  const int64_t local =
+      timestamp_ms + static_cast<int64_t>(utc_offset_minutes) * 60000;
+  const int64_t day = local / kMsPerDay;
+  return static_cast<int32_t>(day * kMsPerDay > local ? day - 1 : day);
+}
+
+void AttemptViews::Add(const AttemptRow& row) {
+  const int32_t day = DayOf(row.timestamp_ms, row.utc_offset_minutes);
+  AddTo(row, day, &levels_[LevelKey(row.profile, row.level)]);
+  AddTo(row, day, &days_[DayKey(row.profile, day)]);
+  rows_++;
+}
+
+const AttemptSummary* AttemptViews::Level(uint32_t profile,
+                                          uint32_t level) const {
+  const auto it = levels_.find(LevelKey(profile, level));
+  return it != levels_.end() ? &it->second : nullptr;
+}
+
+const AttemptSummary* AttemptViews::Day(uint32_t profile, int32_t day) const {
+  const auto it = days_.find(DayKey(profile, day));
+  return it != days_.end() ? &it->second : nullptr;
+}
+
+bool AttemptViews::Load(const std::string& path) {
+  Clear();
+  std::string data;
+  if (!ReadFile(path, &data) || data.size() < sizeof(AttemptViewsHeader)) {
+    return false;
+  }
+  AttemptViewsHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  const size_t entries = static_cast<size_t>(header.levels) + header.days;
+  const size_t begin = offsetof(AttemptViewsHeader, rows);
+  if (std::memcmp(header.magic, kAttemptViewsMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != kAttemptViewsVersion ||
+      data.size() != sizeof(header) + entries * sizeof(AttemptViewEntry) ||
+      Crc32(data.data() + begin, data.size() - begin) != header.crc) {
+    return false;
+  }
+  const char* p = data.data() + sizeof(header);
+  for (size_t i = 0; i < entries; i++, p += sizeof(AttemptViewEntry)) {
+    AttemptViewEntry entry;
+    std::memcpy(&entry, p, sizeof(entry));
+    (i < header.levels ? levels_ : days_)[entry.key] = entry.summary;
+  }
+  rows_ = header.rows;
+  return true;
+}
+
+bool AttemptViews::Save(const std::string& path) const {
+  AttemptViewsHeader header = {};
+  std::memcpy(header.magic, kAttemptViewsMagic, sizeof(header.magic));
+  header.version = kAttemptViewsVersion;
+  header.rows = rows_;
+  header.levels = static_cast<uint32_t>(levels_.size());
+  header.days = static_cast<uint32_t>(days_.size());
+  std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+  AppendSorted(levels_, &data);
+  AppendSorted(days_, &data);
+  const size_t begin = offsetof(AttemptViewsHeader, rows);
+  header.crc = Crc32(data.data() + begin, data.size() - begin);
+  std::memcpy(&data[0], &header, sizeof(header));
+  return WriteFileAtomically(path, data.data(), data.size());
+}
+
+void AttemptViews::Clear() {
+  levels_.clear();
+  days_.clear();
+  rows_ = 0;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,99 @@
+// linux/native/attempt_views.h
+
+#ifndef OPENDSA_NATIVE_ATTEMPT_VIEWS_H_
+#define OPENDSA_NATIVE_ATTEMPT_VIEWS_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace opendsa {
+
+struct AttemptRow;
+
+// Riepiloghi materializzati del registro dei tentativi, per profilo e
+// livello e per profilo e giorno, aggiornati a ogni riga accodata: le
+// schermate di riepilogo li leggono in tempo costante invece di ricalcolare
+// le medie dalla storia.
+//
+// Vengono salvati come snapshot con CRC in <path>.views insieme al numero di
+// righe che coprono; all'apertura AttemptLog riapplica solo le righe
+// successive (o tutte, se lo snapshot manca o non è valido).
+//
+// Layout del file (little-endian):
+//   AttemptViewsHeader
+//   AttemptViewEntry[levels], poi AttemptViewEntry[days]
+constexpr char kAttemptViewsMagic[8] = {'O', 'D', 'S', 'A', 'A', 'T', 'T', 'V'};
+constexpr uint32_t kAttemptViewsVersion = 1;
+
+// errors[0] conta i tentativi errati, errors[k] quelli con un errore di
+// lettura di tipo EditKind k.
+constexpr int kAttemptSummaryErrors = 8;
+
+struct AttemptSummary {
+  uint64_t attempts;
+  uint64_t correct;
+  double similarity_sum;
+  double duration_sum_ms;
+  int64_t first_ms;
+  int64_t last_ms;
+  int32_t days;      // Giorni distinti con almeno un tentativo
+  int32_t last_day;  // Giorno locale dell'ultimo tentativo
+  uint32_t errors[kAttemptSummaryErrors];
+};
+
+struct AttemptViewEntry {
+  uint64_t key;
+  AttemptSummary summary;
+};
+
+struct AttemptViewsHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t crc;  // CRC32 del file da rows alla fine
+  uint64_t rows;
+  uint32_t levels;
+  uint32_t days;
+};
+
+static_assert(sizeof(AttemptSummary) == 88,
+              "AttemptSummary deve restare 88 byte");
+static_assert(sizeof(AttemptViewEntry) == 96,
+              "AttemptViewEntry deve restare 96 byte");
+static_assert(sizeof(AttemptViewsHeader) == 32,
+              "AttemptViewsHeader deve restare 32 byte");
+
+class AttemptViews {
+ public:
+  // Aggiunge una riga ai riepiloghi del suo livello e del suo giorno.
+  void Add(const AttemptRow& row);
+
+  // Riepilogo di un livello o di un giorno (giorni dall'epoca nel fuso
+  // locale del tentativo), null se non ci sono tentativi.
+  const AttemptSummary* Level(uint32_t profile, uint32_t level) const;
+  const AttemptSummary* Day(uint32_t profile, int32_t day) const;
+
+  // Carica lo snapshot in |path|; restituisce false se manca o non è
+  // valido, lasciando i riepiloghi vuoti.
+  bool Load(const std::string& path);
+
+  // Scrive lo snapshot in |path| in modo atomico.
+  bool Save(const std::string& path) const;
+
+  void Clear();
+
+  // Righe aggiunte, comprese quelle dello snapshot caricato.
+  uint64_t rows() const { return rows_; }
+
+  // Giorno locale di un istante.
+  static int32_t DayOf(int64_t timestamp_ms, int32_t utc_offset_minutes);
+
+ private:
+  std::unordered_map<uint64_t, AttemptSummary> levels_;
+  std::unordered_map<uint64_t, AttemptSummary> days_;
+  uint64_t rows_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_ATTEMPT_VIEWS_H_
@@ -0,0 +1,347 @@
+// linux/native/audio_archive.cc
+
+#include "audio_archive.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "audio_codec.h"
+#include "crc32.h"
+#include "file_utils.h"
+#include "mapped_file.h"
+#include "wav_file.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kClipSuffix[] = ".odac";
+constexpr char kIndexFileName[] = "archive.idx";
+
+uint32_t RecordCrc(const AudioClip& clip) {
+  uint32_t crc = Crc32(&clip.record, offsetof(AudioClipRecord, crc));
+  crc = Crc32(clip.profile.data(), clip.profile.size(), crc);
+  return Crc32(clip.target.data(), clip.target.size(), crc);
+}
+
+}  // namespace
+
+AudioArchive::~AudioArchive() { Close(); }
+
+bool AudioArchive::Open(const std::string& dir,
+                        const AudioArchiveOptions& options) {
+  Close();
+  struct stat info;
+  if (stat(dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode) ||
+      access(dir.c_str(), W_OK) != 0) {
+    return false;
+  }
+  dir_ = dir;
+  options_ = options;
+  if (!Load()) {
+    dir_.clear();
+    return false;
+  }
+
+  // La clip viene scritta prima dell'elenco: dopo un'interruzione può
+  // restare una clip senza voce, o una voce di una clip rimossa a metà
+  DIR* handle = opendir(dir_.c_str());
+  if (handle != nullptr) {
+    while (const dirent* entry = readdir(handle)) {
+      const std::string_view name(entry->d_name);
+      const size_t suffix = sizeof(kClipSuffix) - 1;
+      if (name.size() <= suffix ||
+          name.substr(name.size() - suffix) != kClipSuffix) {
+        continue;
+      }
+      uint64_t id = 0;
+      bool digits = true;
+      for (const char c : name.substr(0, name.size() - suffix)) {
+        if (c < '0' || c > '9') {
+          digits = false;
+          break;
+        }
+        id = id * 10 + static_cast<uint64_t>(c - '0');
+      }
+      if (digits && Find(id) == clips_.size()) {
+        unlink((dir_ + "/" + std::string(name)).c_str());
+      }
+      if (digits) next_id_ = std::max(next_id_, id + 1);
+    }
+    closedir(handle);
+  }
+  const size_t count = clips_.size();
+  clips_.erase(std::remove_if(clips_.begin(), clips_.end(),
+                              [&](const AudioClip& clip) {
+                                return !FileExists(ClipPath(clip.record.id));
+                              }),
+               clips_.end());
+  stored_bytes_ = 0;
+  for (const AudioClip& clip : clips_) {
+    stored_bytes_ += clip.record.stored_bytes;
+  }
+  if (clips_.size() != count) Save();
+  return true;
+}
+
+void AudioArchive::Close() {
+  if (!is_open()) return;
+  Flush();
+  dir_.clear();
+  clips_.clear();
+  next_id_ = 1;
+  stored_bytes_ = 0;
+  evicted_ = 0;
+  dirty_ = false;
+}
+
+uint64_t AudioArchive::AddWav(const std::string& wav_path,
+                              std::string_view profile,
+                              std::string_view target, int64_t recorded_ms) {
+  if (!is_open()) return 0;
+  MappedFile file;
+  WavInfo wav;
+  if (!file.Open(wav_path) || !ParseWav(file.data(), file.size(), &wav) ||
+      wav.frames == 0) {
+    return 0;
+  }
+  std::vector<int16_t> samples;
+  ReadPcm16(file.data(), wav, &samples);
+  return Add(samples.data(), static_cast<size_t>(wav.frames), wav.channels,
+             wav.sample_rate, profile, target, recorded_ms);
+}
+
+uint64_t AudioArchive::Add(const int16_t* samples, size_t frames,
+                           uint16_t channels, uint32_t sample_rate,
+                           std::string_view profile, std::string_view target,
+                           int64_t recorded_ms) {
+  if (!is_open() || frames == 0 || channels == 0 || sample_rate == 0) {
+    return 0;
+  }
+  std::string encoded;
+  EncodeAudio(samples, frames, channels, sample_rate, &encoded);
+
+  AudioClip clip;
+  clip.record.id = next_id_;
+  clip.record.recorded_ms = recorded_ms;
+  clip.record.accessed_ms = recorded_ms;
+  clip.record.frames = frames;
+  clip.record.stored_bytes = encoded.size();
+  clip.record.sample_rate = sample_rate;
+  clip.record.channels = channels;
+  clip.profile.assign(profile.data(), profile.size());
+  clip.target.assign(target.data(), target.size());
+  if (!WriteFileAtomically(ClipPath(clip.record.id), encoded.data(),
+                           encoded.size())) {
+    return 0;
+  }
+  next_id_++;
+  stored_bytes_ += clip.record.stored_bytes;
+  clips_.push_back(std::move(clip));
+  const uint64_t id = clips_.back().record.id;
+
+  // La clip appena registrata resta anche se da sola supera i limiti
+  Enforce(recorded_ms, id);
+  if (!Save()) {
+    Delete(Find(id));
+    return 0;
+  }
+  return id;
+}
+
+bool AudioArchive::Read(uint64_t id, int64_t now_ms,
+                        std::vector<int16_t>* samples, AudioClip* clip) {
+  samples->clear();
+  const size_t index = Find(id);
+  if (index == clips_.size()) return false;
+  MappedFile file;
+  AudioClipHeader header;
+  if (!file.Open(ClipPath(id)) ||
+      !DecodeAudio(file.data(), file.size(), &header, samples)) {
+    return false;
+  }
+  AudioClip& stored = clips_[index];
+  if (now_ms > stored.record.accessed_ms) {
+    stored.record.accessed_ms = now_ms;
+    dirty_ = true;
+  }
+  if (clip != nullptr) *clip = stored;
+  return true;
+}
+
+bool AudioArchive::ExportWav(uint64_t id, int64_t now_ms,
+                             const std::string& wav_path) {
+  std::vector<int16_t> samples;
+  AudioClip clip;
+  if (!Read(id, now_ms, &samples, &clip)) return false;
+  return WriteWav(wav_path, clip.record.sample_rate, clip.record.channels,
+                  samples.data(), static_cast<size_t>(clip.record.frames));
+}
+
+bool AudioArchive::Remove(uint64_t id) {
+  const size_t index = Find(id);
+  if (index == clips_.size()) return false;
+  Delete(index);
+  return Save();
+}
+
+size_t AudioArchive::Evict(int64_t now_ms) {
+  if (!is_open()) return 0;
+  const size_t removed = Enforce(now_ms, 0);
+  if (removed > 0) Save();
+  return removed;
+}
+
+bool AudioArchive::Flush() {
+  return !dirty_ || Save();
+}
+
+std::vector<AudioClip> AudioArchive::List(std::string_view profile,
+                                          std::string_view target) const {
+  std::vector<AudioClip> clips;
+  for (auto it = clips_.rbegin(); it != clips_.rend(); ++it) {
+    if ((profile.empty() || it->profile == profile) &&
+        (target.empty() || it->target == target)) {
+      clips.push_back(*it);
+    }
+  }
+  std::stable_sort(clips.begin(), clips.end(),
+                   [](const AudioClip& a, const AudioClip& b) {
+                     return a.record.recorded_ms > b.record.recorded_ms;
+                   });
+  return clips;
+}
+
+AudioArchiveStats AudioArchive::stats() const {
+  AudioArchiveStats stats;
+  stats.clips = clips_.size();
+  stats.stored_bytes = stored_bytes_;
+  for (const AudioClip& clip : clips_) {
+    stats.raw_bytes += clip.record.frames * clip.record.channels * 2;
+  }
+  stats.evicted = evicted_;
+  return stats;
+}
+
+size_t AudioArchive::Find(uint64_t id) const {
+  // Gli id crescono con le aggiunte: l'elenco è già ordinato
+  const auto it = std::lower_bound(
+      clips_.begin(), clips_.end(), id,
+      [](const AudioClip& clip, uint64_t key) { return clip.record.id < key; });
+  return it != clips_.end() && it->record.id == id
+             ? static_cast<size_t>(it - clips_.begin())
+             : clips_.size();
+}
+
+std::string AudioArchive::ClipPath(uint64_t id) const {
+  return dir_ + "/" + std::to_string(id) + kClipSuffix;
+}
+
+std::string AudioArchive::IndexPath() const {
+  return dir_ + "/" + kIndexFileName;
+}
+
+bool AudioArchive::Load() {
+  clips_.clear();
+  next_id_ = 1;
+  std::string data;
+  if (!FileExists(IndexPath())) return true;
+  if (!ReadFile(IndexPath(), &data) || data.size() < sizeof(AudioArchiveHeader)) {
+    return false;
+  }
+  AudioArchiveHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kAudioArchiveMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != kAudioArchiveVersion) {
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  while (offset < data.size()) {
+    AudioClip clip;
+    if (data.size() - offset < sizeof(AudioClipRecord)) return false;
+    std::memcpy(&clip.record, data.data() + offset, sizeof(clip.record));
+    offset += sizeof(clip.record);
+    const uint64_t strings = static_cast<uint64_t>(clip.record.profile_size) +
+                             clip.record.target_size;
+    if (data.size() - offset < strings) return false;
+    clip.profile.assign(data, offset, clip.record.profile_size);
+    offset += clip.record.profile_size;
+    clip.target.assign(data, offset, clip.record.target_size);
+    offset += clip.record.target_size;
+    if (RecordCrc(clip) != clip.record.crc ||
+        (!clips_.empty() && clip.record.id <= clips_.back().record.id)) {
+      return false;
+    }
+    next_id_ = clip.record.id + 1;
+    clips_.push_back(std::move(clip));
+  }
+  return true;
+}
+
+bool AudioArchive::Save() {
+  AudioArchiveHeader header = {};
+  std::memcpy(header.magic, kAudioArchiveMagic, sizeof(header.magic));
+  header.version = kAudioArchiveVersion;
+  std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (AudioClip& clip : clips_) {
+    clip.record.profile_size = static_cast<uint32_t>(clip.profile.size());
+    clip.record.target_size = static_cast<uint32_t>(clip.target.size());
+    clip.record.crc = RecordCrc(clip);
+    data.append(reinterpret_cast<const char*>(&clip.record),
+                sizeof(clip.record));
+    data += clip.profile;
+    data += clip.target;
+  }
+  if (!WriteFileAtomically(IndexPath(), data.data(), data.size())) {
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+void AudioArchive::Delete(size_t index) {
+  if (index >= clips_.size()) return;
+  unlink(ClipPath(clips_[index].record.id).c_str());
+  stored_bytes_ -= clips_[index].record.stored_bytes;
+  clips_.erase(clips_.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+size_t AudioArchive::Enforce(int64_t now_ms, uint64_t keep_id) {
+  size_t removed = 0;
+  for (size_t i = 0; i < clips_.size();) {
+    if (clips_[i].record.id != keep_id && options_.max_age_ms > 0 &&
+        now_ms - clips_[i].record.recorded_ms > options_.max_age_ms) {
+      Delete(i);
+      removed++;
+    } else {
+      ++i;
+    }
+  }
+  if (stored_bytes_ > options_.max_bytes) {
+    // Dall'ascolto (o dalla registrazione) meno recente
+    std::vector<std::pair<int64_t, uint64_t>> order;
+    order.reserve(clips_.size());
+    for (const AudioClip& clip : clips_) {
+      if (clip.record.id != keep_id) {
+        order.emplace_back(clip.record.accessed_ms, clip.record.id);
+      }
+    }
+    std::sort(order.begin(), order.end());
+    for (const auto& [accessed_ms, id] : order) {
+      if (stored_bytes_ <= options_.max_bytes) break;
+      Delete(Find(id));
+      removed++;
+    }
+  }
+  evicted_ += removed;
+  return removed;
+}
+
+}  // namespace opendsa
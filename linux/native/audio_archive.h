@@ -0,0 +1,152 @@
+// linux/native/audio_archive.h
+
+#ifndef OPENDSA_NATIVE_AUDIO_ARCHIVE_H_
+#define OPENDSA_NATIVE_AUDIO_ARCHIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace opendsa {
+
+// Archivio delle registrazioni dei tentativi, per riascoltarle.
+//
+// Ogni registrazione è una clip <id>.odac in |dir|, codificata senza
+// perdita con EncodeAudio (audio_codec.h). L'elenco delle clip con profilo,
+// testo atteso, istante di registrazione e ultimo ascolto è in
+// <dir>/archive.idx, riscritto in modo atomico a ogni aggiunta o
+// rimozione; gli ascolti vengono salvati con la modifica successiva o con
+// Flush.
+//
+// Dopo ogni aggiunta (e con Evict) l'archivio rispetta due limiti: le clip
+// registrate da più di max_age_ms vengono rimosse, poi, finché lo spazio
+// delle clip supera max_bytes, quelle ascoltate o registrate meno di
+// recente.
+//
+// Layout di archive.idx (little-endian):
+//   AudioArchiveHeader              16 byte
+//   per ogni clip: AudioClipRecord (64 byte), poi profile_size byte del
+//   profilo e target_size byte del testo atteso
+//
+// Non è thread-safe.
+constexpr char kAudioArchiveMagic[8] = {'O', 'D', 'S', 'A', 'A', 'U', 'D', 'I'};
+constexpr uint32_t kAudioArchiveVersion = 1;
+
+struct AudioArchiveHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+struct AudioClipRecord {
+  uint64_t id;
+  int64_t recorded_ms;  // Millisecondi dall'epoca
+  int64_t accessed_ms;  // Ultimo ascolto, o recorded_ms
+  uint64_t frames;
+  uint64_t stored_bytes;  // Dimensione del file della clip
+  uint32_t sample_rate;
+  uint16_t channels;
+  uint16_t reserved;
+  uint32_t profile_size;
+  uint32_t target_size;
+  uint32_t crc;  // CRC dei byte precedenti, del profilo e del testo
+  uint32_t reserved2;
+};
+
+static_assert(sizeof(AudioArchiveHeader) == 16,
+              "AudioArchiveHeader deve restare 16 byte");
+static_assert(sizeof(AudioClipRecord) == 64,
+              "AudioClipRecord deve restare 64 byte");
+
+struct AudioArchiveOptions {
+  uint64_t max_bytes = 200ull * 1024 * 1024;
+  int64_t max_age_ms = 30ll * 24 * 60 * 60 * 1000;  // 0 = senza limite
+};
+
+struct AudioClip {
+  AudioClipRecord record = {};
+  std::string profile;
+  std::string target;
+};
+
+struct AudioArchiveStats {
+  uint64_t clips = 0;
+  uint64_t stored_bytes = 0;  // Spazio delle clip
+  uint64_t raw_bytes = 0;     // Spazio degli stessi campioni in PCM a 16 bit
+  uint64_t evicted = 0;       // Clip rimosse dai limiti dall'apertura
+};
+
+class AudioArchive {
+ public:
+  AudioArchive() = default;
+  ~AudioArchive();
+  AudioArchive(const AudioArchive&) = delete;
+  AudioArchive& operator=(const AudioArchive&) = delete;
+
+  // Apre l'archivio in |dir| (che deve esistere), eliminando le clip senza
+  // voce nell'elenco e le voci senza clip lasciate da un'interruzione.
+  // Restituisce false se la directory non è accessibile o l'elenco non è
+  // valido.
+  bool Open(const std::string& dir, const AudioArchiveOptions& options);
+
+  // Salva gli ascolti e chiude l'archivio.
+  void Close();
+
+  // Codifica e archivia il WAV PCM in |wav_path| (i campioni oltre 16 bit
+  // vengono ridotti a 16), registrato all'istante |recorded_ms|. Restituisce
+  // l'id della clip, 0 in caso di errore.
+  uint64_t AddWav(const std::string& wav_path, std::string_view profile,
+                  std::string_view target, int64_t recorded_ms);
+
+  // Archivia |frames| frame interleaved di |channels| canali.
+  uint64_t Add(const int16_t* samples, size_t frames, uint16_t channels,
+               uint32_t sample_rate, std::string_view profile,
+               std::string_view target, int64_t recorded_ms);
+
+  // Decodifica la clip |id| in |samples| (interleaved) e ne registra
+  // l'ascolto all'istante |now_ms|.
+  bool Read(uint64_t id, int64_t now_ms, std::vector<int16_t>* samples,
+            AudioClip* clip);
+
+  // Decodifica la clip |id| in un WAV PCM a 16 bit in |wav_path|.
+  bool ExportWav(uint64_t id, int64_t now_ms, const std::string& wav_path);
+
+  bool Remove(uint64_t id);
+
+  // Applica i limiti di età e di spazio all'istante |now_ms| e restituisce
+  // il numero di clip rimosse.
+  size_t Evict(int64_t now_ms);
+
+  // Salva gli ascolti registrati da Read.
+  bool Flush();
+
+  // Clip di |profile| e |target| (vuoti = tutti), dalla più recente.
+  std::vector<AudioClip> List(std::string_view profile,
+                              std::string_view target) const;
+
+  AudioArchiveStats stats() const;
+  bool is_open() const { return !dir_.empty(); }
+
+ private:
+  size_t Find(uint64_t id) const;
+  std::string ClipPath(uint64_t id) const;
+  std::string IndexPath() const;
+  bool Load();
+  bool Save();
+  void Delete(size_t index);
+  size_t Enforce(int64_t now_ms, uint64_t keep_id);
+
+  std::string dir_;
+  AudioArchiveOptions options_;
+  std::vector<AudioClip> clips_;  // In ordine di id
+  uint64_t next_id_ = 1;
+  uint64_t stored_bytes_ = 0;
+  uint64_t evicted_ = 0;
+  bool dirty_ = false;  // Ascolti non ancora salvati
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_AUDIO_ARCHIVE_H_
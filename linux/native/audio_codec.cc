@@ -0,0 +1,333 @@
+// linux/native/audio_codec.cc
+
+#include "audio_codec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "crc32.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr size_t kBlockHeaderSize = 12;  // frames, size, crc32
+constexpr int kMaxOrder = 3;
+constexpr int kMaxRiceParameter = 24;
+// Un residuo con quoziente di Rice da qui in su viene scritto per intero
+// dopo kEscapeQuotient uni, così un picco isolato costa al più 56 bit
+constexpr uint32_t kEscapeQuotient = 24;
+
+// Bit accodati dal meno significativo.
+class BitWriter {
+ public:
+  explicit BitWriter(std::string* out) : out_(out) {}
+
+  void Write(uint32_t value, int bits) {
+    const uint64_t mask = bits == 32 ? 0xFFFFFFFFull : (1ull << bits) - 1;
+    buffer_ |= (value & mask) << count_;
+    count_ += bits;
+    while (count_ >= 8) {
+      out_->push_back(static_cast<char>(buffer_ & 0xFF));
+      buffer_ >>= 8;
+      count_ -= 8;
+    }
+  }
+
+  // |ones| bit a uno seguiti da uno zero
+  void WriteUnary(uint32_t ones) {
+    for (; ones >= 24; ones -= 24) Write(0xFFFFFF, 24);
+    Write((1u << ones) - 1, static_cast<int>(ones) + 1);
+  }
+
+  // Completa l'ultimo byte con zeri
+  void Finish() {
+    if (count_ > 0) out_->push_back(static_cast<char>(buffer_ & 0xFF));
+    buffer_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  std::string* out_;
+  uint64_t buffer_ = 0;
+  int count_ = 0;
+};
+
+class BitReader {
+ public:
+  BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool Read(int bits, uint32_t* value) {
+    while (count_ < bits) {
+      if (position_ >= size_) return false;
+      buffer_ |= static_cast<uint64_t>(data_[position_++]) << count_;
+      count_ += 8;
+    }
+    const uint64_t mask = bits == 32 ? 0xFFFFFFFFull : (1ull << bits) - 1;
+    *value = static_cast<uint32_t>(buffer_ & mask);
+    buffer_ >>= bits;
+    count_ -= bits;
+    return true;
+  }
+
+  // Uni fino al primo zero, al più |max|; lo zero viene consumato solo se
+  // arriva prima di |max| uni
+  bool ReadUnary(uint32_t max, uint32_t* ones) {
+    *ones = 0;
+    while (*ones < max) {
+      if (count_ == 0) {
+        if (position_ >= size_) return false;
+        buffer_ = data_[position_++];
+        count_ = 8;
+      }
+      const bool one = buffer_ & 1;
+      buffer_ >>= 1;
+      count_--;
+      if (!one) return true;
+      ++*ones;
+    }
+    return true;
+  }
+
+  // Byte letti, compreso l'ultimo iniziato
+  size_t position() const { return position_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+  uint64_t buffer_ = 0;
+  int count_ = 0;
+};
+
+int32_t Predict(const int32_t* x, size_t i, int order) {
+  switch (order) {
+    case 1:
+      return x[i - 1];
+    case 2:
+      return 2 * x[i - 1] - x[i - 2];
+    case 3:
+      return 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3];
+    default:
+      return 0;
+  }
+}
+
+uint32_t ZigZag(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^
+         static_cast<uint32_t>(value >> 31);
+}
+
+int32_t UnZigZag(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+uint64_t RiceBits(const std::vector<uint32_t>& residuals, int k) {
+  uint64_t bits = 0;
+  for (const uint32_t u : residuals) {
+    const uint32_t quotient = u >> k;
+    bits += quotient < kEscapeQuotient ? quotient + 1 + k
+                                       : kEscapeQuotient + 32;
+  }
+  return bits;
+}
+
+void EncodeChannel(const int32_t* x, size_t n, std::vector<uint32_t>* residuals,
+                   std::string* out) {
+  // Ordine con la somma dei residui più piccola, come i predittori fissi di
+  // FLAC
+  int order = 0;
+  uint64_t best = UINT64_MAX;
+  for (int candidate = 0; candidate <= kMaxOrder; ++candidate) {
+    if (static_cast<size_t>(candidate) > n) break;
+    uint64_t sum = 0;
+    for (size_t i = candidate; i < n; ++i) {
+      const int32_t e = x[i] - Predict(x, i, candidate);
+      sum += static_cast<uint64_t>(e < 0 ? -static_cast<int64_t>(e) : e);
+    }
+    if (sum < best) {
+      best = sum;
+      order = candidate;
+    }
+  }
+
+  residuals->clear();
+  for (size_t i = order; i < n; ++i) {
+    residuals->push_back(ZigZag(x[i] - Predict(x, i, order)));
+  }
+  // Parametro vicino a log2 della media dei residui, poi affinato
+  const uint64_t count = std::max<uint64_t>(residuals->size(), 1);
+  int k = 0;
+  while (k < kMaxRiceParameter && (count << (k + 1)) <= 2 * best) ++k;
+  uint64_t bits = RiceBits(*residuals, k);
+  for (const int step : {-1, 1}) {
+    for (int next = k + step; next >= 0 && next <= kMaxRiceParameter;
+         next += step) {
+      const uint64_t next_bits = RiceBits(*residuals, next);
+      if (next_bits >= bits) break;
+      bits = next_bits;
+      k = next;
+    }
+  }
+
+  BitWriter writer(out);
+  if (bits + 16ull * order + 16 >= 16ull * n) {
+    out->push_back(static_cast<char>(kAudioVerbatim));
+    for (size_t i = 0; i < n; ++i) {
+      writer.Write(static_cast<uint16_t>(x[i]), 16);
+    }
+    return;
+  }
+  out->push_back(static_cast<char>(order));
+  out->push_back(static_cast<char>(k));
+  for (int i = 0; i < order; ++i) {
+    writer.Write(static_cast<uint16_t>(x[i]), 16);
+  }
+  for (const uint32_t u : *residuals) {
+    const uint32_t quotient = u >> k;
+    if (quotient < kEscapeQuotient) {
+      writer.WriteUnary(quotient);
+      if (k > 0) writer.Write(u, k);
+    } else {
+      writer.Write((1u << kEscapeQuotient) - 1, kEscapeQuotient);
+      writer.Write(u, 32);
+    }
+  }
+  writer.Finish();
+}
+
+// Decodifica un canale di |n| campioni da |data|; restituisce i byte letti,
+// 0 se i dati non sono validi.
+size_t DecodeChannel(const uint8_t* data, size_t size, size_t n, int32_t* x) {
+  if (size < 1) return 0;
+  const uint8_t mode = data[0];
+  if (mode == kAudioVerbatim) {
+    if (size - 1 < n * 2) return 0;
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = static_cast<int16_t>(data[1 + i * 2] | data[2 + i * 2] << 8);
+    }
+    return 1 + n * 2;
+  }
+  if (size < 2 || mode > kMaxOrder || data[1] > kMaxRiceParameter ||
+      mode > n) {
+    return 0;
+  }
+  const int order = mode;
+  const int k = data[1];
+  BitReader reader(data + 2, size - 2);
+  uint32_t value;
+  for (int i = 0; i < order; ++i) {
+    if (!reader.Read(16, &value)) return 0;
+    x[i] = static_cast<int16_t>(value);
+  }
+  for (size_t i = order; i < n; ++i) {
+    uint32_t quotient;
+    if (!reader.ReadUnary(kEscapeQuotient, &quotient)) return 0;
+    uint32_t u;
+    if (quotient == kEscapeQuotient) {
+      if (!reader.Read(32, &u)) return 0;
+    } else {
+      uint32_t low = 0;
+      if (k > 0 && !reader.Read(k, &low)) return 0;
+      u = (quotient << k) | low;
+    }
+    const int64_t sample =
+        static_cast<int64_t>(Predict(x, i, order)) + UnZigZag(u);
+    if (sample < INT16_MIN || sample > INT16_MAX) return 0;
+    x[i] = static_cast<int32_t>(sample);
+  }
+  return 2 + reader.position();
+}
+
+}  // namespace
+
+void EncodeAudio(const int16_t* samples, size_t frames, uint16_t channels,
+                 uint32_t sample_rate, std::string* out) {
+  out->clear();
+  AudioClipHeader header = {};
+  std::memcpy(header.magic, kAudioClipMagic, sizeof(header.magic));
+  header.version = kAudioClipVersion;
+  header.sample_rate = sample_rate;
+  header.channels = channels;
+  header.block_frames = kAudioBlockFrames;
+  header.frames = frames;
+  out->append(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (channels == 0) return;
+
+  std::vector<int32_t> channel(kAudioBlockFrames);
+  std::vector<uint32_t> residuals;
+  residuals.reserve(kAudioBlockFrames);
+  for (size_t start = 0; start < frames; start += kAudioBlockFrames) {
+    const size_t n = std::min<size_t>(kAudioBlockFrames, frames - start);
+    const int16_t* block = samples + start * channels;
+    const size_t header_offset = out->size();
+    out->append(kBlockHeaderSize, '\0');
+    for (uint16_t c = 0; c < channels; ++c) {
+      for (size_t i = 0; i < n; ++i) channel[i] = block[i * channels + c];
+      EncodeChannel(channel.data(), n, &residuals, out);
+    }
+    const uint32_t fields[3] = {
+        static_cast<uint32_t>(n),
+        static_cast<uint32_t>(out->size() - header_offset - kBlockHeaderSize),
+        Crc32(block, n * channels * sizeof(int16_t))};
+    std::memcpy(&(*out)[header_offset], fields, sizeof(fields));
+  }
+}
+
+bool DecodeAudio(const uint8_t* data, size_t size, AudioClipHeader* header,
+                 std::vector<int16_t>* samples) {
+  samples->clear();
+  if (size < sizeof(AudioClipHeader)) return false;
+  std::memcpy(header, data, sizeof(*header));
+  if (std::memcmp(header->magic, kAudioClipMagic, sizeof(header->magic)) !=
+          0 ||
+      header->version != kAudioClipVersion || header->channels == 0 ||
+      header->block_frames == 0 || header->block_frames > (1u << 24)) {
+    return false;
+  }
+  const uint16_t channels = header->channels;
+  // Il numero di frame dichiarato non può superare quello dei blocchi
+  // presenti: limita l'allocazione per un'intestazione danneggiata
+  const uint64_t max_frames =
+      (size / kBlockHeaderSize + 1) * static_cast<uint64_t>(header->block_frames);
+  if (header->frames > max_frames) return false;
+  samples->resize(static_cast<size_t>(header->frames) * channels);
+
+  std::vector<int32_t> channel(header->block_frames);
+  size_t offset = sizeof(AudioClipHeader);
+  uint64_t decoded = 0;
+  while (decoded < header->frames) {
+    if (size - offset < kBlockHeaderSize) return false;
+    uint32_t fields[3];
+    std::memcpy(fields, data + offset, sizeof(fields));
+    offset += kBlockHeaderSize;
+    const uint32_t n = fields[0];
+    if (n == 0 || n > header->block_frames || n > header->frames - decoded ||
+        size - offset < fields[1]) {
+      return false;
+    }
+    const uint8_t* payload = data + offset;
+    size_t remaining = fields[1];
+    int16_t* block = samples->data() + decoded * channels;
+    for (uint16_t c = 0; c < channels; ++c) {
+      const size_t used =
+          DecodeChannel(payload, remaining, n, channel.data());
+      if (used == 0 || used > remaining) return false;
+      payload += used;
+      remaining -= used;
+      for (uint32_t i = 0; i < n; ++i) {
+        block[i * channels + c] = static_cast<int16_t>(channel[i]);
+      }
+    }
+    if (remaining != 0 ||
+        Crc32(block, static_cast<size_t>(n) * channels * sizeof(int16_t)) !=
+            fields[2]) {
+      return false;
+    }
+    offset += fields[1];
+    decoded += n;
+  }
+  return offset == size;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,59 @@
+// linux/native/audio_codec.h
+
+#ifndef OPENDSA_NATIVE_AUDIO_CODEC_H_
+#define OPENDSA_NATIVE_AUDIO_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opendsa {
+
+// Codifica senza perdita di audio PCM a 16 bit, nello stile di FLAC e
+// Shorten: ogni canale di un blocco di kAudioBlockFrames frame viene
+// predetto con il polinomio fisso di ordine 0-3 che dà i residui più
+// piccoli, e i residui sono scritti con un codice di Rice il cui parametro
+// è scelto per blocco. Per la voce registrata dal microfono si ottiene
+// circa la metà dello spazio del WAV; un canale che non si riduce resta
+// com'è.
+//
+// Formato di una clip codificata (little-endian):
+//   AudioClipHeader                 32 byte
+//   per ogni blocco: frames u32, size u32, crc32 u32 dei campioni
+//   decodificati, poi size byte con i canali uno dopo l'altro:
+//     modo u8: ordine del predittore 0-3, o kAudioVerbatim
+//     parametro di Rice u8 (assente per kAudioVerbatim)
+//     campioni iniziali (16 bit ciascuno) e residui, in bit
+//     (kAudioVerbatim: i campioni a 16 bit), fino al byte intero
+constexpr char kAudioClipMagic[8] = {'O', 'D', 'S', 'A', 'A', 'U', 'D', 'C'};
+constexpr uint32_t kAudioClipVersion = 1;
+constexpr uint32_t kAudioBlockFrames = 4096;
+constexpr uint8_t kAudioVerbatim = 0xFF;
+
+struct AudioClipHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t sample_rate;
+  uint16_t channels;
+  uint16_t reserved;
+  uint32_t block_frames;
+  uint64_t frames;
+};
+
+static_assert(sizeof(AudioClipHeader) == 32,
+              "AudioClipHeader deve restare 32 byte");
+
+// Codifica |frames| frame interleaved di |channels| canali in |out|.
+void EncodeAudio(const int16_t* samples, size_t frames, uint16_t channels,
+                 uint32_t sample_rate, std::string* out);
+
+// Decodifica una clip in |samples| (interleaved) e ne copia l'intestazione
+// in |header|. Restituisce false se la clip è troncata o un blocco non
+// corrisponde al suo CRC.
+bool DecodeAudio(const uint8_t* data, size_t size, AudioClipHeader* header,
+                 std::vector<int16_t>* samples);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_AUDIO_CODEC_H_
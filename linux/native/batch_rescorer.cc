@@ -0,0 +1,57 @@
+// linux/native/batch_rescorer.cc
+
+#include "batch_rescorer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "similarity.h"
+
+namespace opendsa {
+
+BatchRescorer::~BatchRescorer() { Wait(); }
+
+void BatchRescorer::Add(std::string recognized, std::string target) {
+  recognized_.push_back(std::move(recognized));
+  target_.push_back(std::move(target));
+}
+
+void BatchRescorer::Start(const CostMatrix& costs, int threads) {
+  costs_ = costs;
+  similarities_.assign(recognized_.size(), 0.0);
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  // Non ha senso avere più thread che blocchi di lavoro
+  const int chunks = (size() + kChunkSize - 1) / kChunkSize;
+  threads = std::max(1, std::min(threads, chunks));
+  threads_.reserve(threads);
+  for (int i = 0; i < threads; i++) {
+    threads_.emplace_back(&BatchRescorer::Work, this);
+  }
+}
+
+void BatchRescorer::Wait() {
+  for (std::thread& thread : threads_) {
+    if (thread.joinable()) thread.join();
+  }
+  threads_.clear();
+}
+
+void BatchRescorer::Work() {
+  SimilarityEngine engine;
+  const int32_t total = size();
+  for (;;) {
+    const int32_t begin =
+        next_.fetch_add(kChunkSize, std::memory_order_relaxed);
+    if (begin >= total) break;
+    const int32_t end = std::min(total, begin + kChunkSize);
+    // Ogni thread scrive solo le proprie celle di similarities_
+    for (int32_t i = begin; i < end; i++) {
+      similarities_[i] = engine.Similarity(recognized_[i], target_[i], costs_);
+    }
+    completed_.fetch_add(end - begin, std::memory_order_release);
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,64 @@
+// linux/native/batch_rescorer.h
+
+#ifndef OPENDSA_NATIVE_BATCH_RESCORER_H_
+#define OPENDSA_NATIVE_BATCH_RESCORER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+// Ricalcola in parallelo la similarità di un insieme di tentativi storici
+// (testo letto, testo atteso), ad esempio dopo una modifica dei pesi o della
+// tabella delle confusioni. Ogni thread ha il proprio SimilarityEngine e
+// prende i tentativi a blocchi da un indice condiviso, così il carico resta
+// bilanciato anche quando frasi e pagine si alternano a parole singole.
+//
+// Start() ritorna subito: l'avanzamento si legge con completed() da
+// qualunque thread e Wait() attende la fine del lavoro.
+class BatchRescorer {
+ public:
+  // Tentativi assegnati a un thread a ogni prelievo dall'indice condiviso.
+  static constexpr int32_t kChunkSize = 32;
+
+  BatchRescorer() = default;
+  ~BatchRescorer();
+
+  BatchRescorer(const BatchRescorer&) = delete;
+  BatchRescorer& operator=(const BatchRescorer&) = delete;
+
+  void Add(std::string recognized, std::string target);
+
+  // Avvia |threads| thread (0 = uno per core) con una copia di |costs|.
+  // Va chiamato una sola volta, dopo aver aggiunto tutti i tentativi.
+  void Start(const CostMatrix& costs, int threads = 0);
+
+  // Attende la fine dei thread. Dopo Wait() similarities() è completo.
+  void Wait();
+
+  int32_t size() const { return static_cast<int32_t>(recognized_.size()); }
+  int32_t completed() const {
+    return completed_.load(std::memory_order_acquire);
+  }
+  const std::vector<double>& similarities() const { return similarities_; }
+
+ private:
+  void Work();
+
+  std::vector<std::string> recognized_;
+  std::vector<std::string> target_;
+  std::vector<double> similarities_;
+  CostMatrix costs_;
+  std::atomic<int32_t> next_{0};
+  std::atomic<int32_t> completed_{0};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_BATCH_RESCORER_H_
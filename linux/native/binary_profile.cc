@@ -0,0 +1,661 @@
+// linux/native/binary_profile.cc
+
+#include "binary_profile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <numeric>
+#include <unordered_map>
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// Oltre questa profondità il JSON viene rifiutato e l'esportazione si
+// ferma: protegge lo stack da file costruiti ad arte
+constexpr int kMaxDepth = 256;
+
+// Valore JSON decodificato, prima di essere disposto in nodi
+struct JsonValue {
+  ProfileValueType type = ProfileValueType::kNull;
+  int64_t integer = 0;
+  double number = 0;
+  std::string text;
+  std::vector<std::string> keys;     // Chiavi di un oggetto
+  std::vector<JsonValue> elements;   // Elementi, o valori delle chiavi
+};
+
+class JsonParser {
+ public:
+  explicit JsonParser(std::string_view text) : text_(text) {}
+
+  bool Parse(JsonValue* value) {
+    SkipSpace();
+    if (!ParseValue(value, 0)) return false;
+    SkipSpace();
+    return pos_ == text_.size();
+  }
+
+  size_t position() const { return pos_; }
+
+ private:
+  void SkipSpace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' ||
+            text_[pos_] == '\r')) {
+      pos_++;
+    }
+  }
+
+  bool Consume(std::string_view literal) {
+    if (text_.compare(pos_, literal.size(), literal) != 0) return false;
+    pos_ += literal.size();
+    return true;
+  }
+
+  bool ParseValue(JsonValue* value, int depth) {
+    if (pos_ >= text_.size() || depth > kMaxDepth) return false;
+    switch (text_[pos_]) {
+      case '{':
+        return ParseObject(value, depth);
+      case '[':
+        return ParseArray(value, depth);
+      case '"':
+        value->type = ProfileValueType::kString;
+        return ParseString(&value->text);
+      case 't':
+        value->type = ProfileValueType::kTrue;
+        return Consume("true");
+      case 'f':
+        value->type = ProfileValueType::kFalse;
+        return Consume("false");
+      case 'n':
+        value->type = ProfileValueType::kNull;
+        return Consume("null");
+      default:
+        return ParseNumber(value);
+    }
+  }
+
+  bool ParseObject(JsonValue* value, int depth) {
+    value->type = ProfileValueType::kObject;
+    pos_++;
+    SkipSpace();
+    if (pos_ < text_.size() && text_[pos_] == '}') {
+      pos_++;
+      return true;
+    }
+    while (true) {
+      SkipSpace();
+      std::string key;
+      if (pos_ >= text_.size() || text_[pos_] != '"' || !ParseString(&key)) {
+        return false;
+      }
+      SkipSpace();
+      if (!Consume(":")) return false;
+      SkipSpace();
+      value->keys.push_back(std::move(key));
+      value->elements.emplace_back();
+      if (!ParseValue(&value->elements.back(), depth + 1)) return false;
+      SkipSpace();
+      if (Consume("}")) return true;
+      if (!Consume(",")) return false;
+    }
+  }
+
+  bool ParseArray(JsonValue* value, int depth) {
+    value->type = ProfileValueType::kArray;
+    pos_++;
+    SkipSpace();
+    if (pos_ < text_.size() && text_[pos_] == ']') {
+      pos_++;
+      return true;
+    }
+    while (true) {
+      SkipSpace();
+      value->elements.emplace_back();
+      if (!ParseValue(&value->elements.back(), depth + 1)) return false;
+      SkipSpace();
+      if (Consume("]")) return true;
+      if (!Consume(",")) return false;
+    }
+  }
+
+  bool ParseHex4(uint32_t* cp) {
+    if (text_.size() - pos_ < 4) return false;
+    *cp = 0;
+    for (int i = 0; i < 4; i++) {
+      const char c = text_[pos_++];
+      *cp <<= 4;
+      if (c >= '0' && c <= '9') {
+        *cp |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        *cp |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        *cp |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseString(std::string* out) {
+    pos_++;  // Virgolette di apertura
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_++];
+      if (c == '"') return true;
+      if (static_cast<unsigned char>(c) < 0x20) return false;
+      if (c != '\\') {
+        out->push_back(c);
+        continue;
+      }
+      if (pos_ >= text_.size()) return false;
+      switch (text_[pos_++]) {
+        case '"': out->push_back('"'); break;
+        case '\\': out->push_back('\\'); break;
+        case '/': out->push_back('/'); break;
+        case 'b': out->push_back('\b'); break;
+        case 'f': out->push_back('\f'); break;
+        case 'n': out->push_back('\n'); break;
+        case 'r': out->push_back('\r'); break;
+        case 't': out->push_back('\t'); break;
+        case 'u': {
+          uint32_t cp;
+          if (!ParseHex4(&cp)) return false;
+          if (cp >= 0xD800 && cp < 0xDC00 && Consume("\\u")) {
+            uint32_t low;
+            if (!ParseHex4(&low)) return false;
+            cp = low >= 0xDC00 && low < 0xE000
+                     ? 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00)
+                     : 0xFFFD;
+          } else if (cp >= 0xD800 && cp < 0xE000) {
+            cp = 0xFFFD;  // Surrogato isolato, come fa utf8.encode in Dart
+          }
+          AppendUtf8(static_cast<char32_t>(cp), out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  bool ParseNumber(JsonValue* value) {
+    const size_t begin = pos_;
+    bool integer = true;
+    if (pos_ < text_.size() && text_[pos_] == '-') pos_++;
+    const size_t digits = pos_;
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+      pos_++;
+    }
+    if (pos_ == digits || (text_[digits] == '0' && pos_ - digits > 1)) {
+      return false;
+    }
+    if (pos_ < text_.size() && text_[pos_] == '.') {
+      integer = false;
+      const size_t fraction = ++pos_;
+      while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+        pos_++;
+      }
+      if (pos_ == fraction) return false;
+    }
+    if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+      integer = false;
+      pos_++;
+      if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+        pos_++;
+      }
+      const size_t exponent = pos_;
+      while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+        pos_++;
+      }
+      if (pos_ == exponent) return false;
+    }
+
+    const char* first = text_.data() + begin;
+    const char* last = text_.data() + pos_;
+    if (integer) {
+      const auto [end, ec] = std::from_chars(first, last, value->integer);
+      if (ec == std::errc() && end == last) {
+        value->type = ProfileValueType::kInt;
+        return true;
+      }
+      // Interi fuori da int64 diventano decimali, come in json.decode
+    }
+    const auto [end, ec] = std::from_chars(first, last, value->number);
+    if (ec != std::errc() || end != last) return false;
+    value->type = ProfileValueType::kDouble;
+    return true;
+  }
+
+  std::string_view text_;
+  size_t pos_ = 0;
+};
+
+// Dispone i valori in nodi, livello per livello: i figli di ogni nodo sono
+// contigui e stanno sempre dopo il padre
+class NodeWriter {
+ public:
+  void Write(JsonValue* root, std::string* out) {
+    nodes_.assign(1, BinaryProfileNode());
+    strings_.clear();
+    offsets_.clear();
+    std::deque<std::pair<JsonValue*, uint32_t>> queue = {{root, 0}};
+    while (!queue.empty()) {
+      auto [value, index] = queue.front();
+      queue.pop_front();
+      if (value->type == ProfileValueType::kObject) SortKeys(value);
+
+      BinaryProfileNode node = {};
+      node.type = static_cast<uint8_t>(value->type);
+      switch (value->type) {
+        case ProfileValueType::kInt:
+          std::memcpy(&node.payload, &value->integer, sizeof(node.payload));
+          break;
+        case ProfileValueType::kDouble:
+          std::memcpy(&node.payload, &value->number, sizeof(node.payload));
+          break;
+        case ProfileValueType::kString:
+          node.count = static_cast<uint32_t>(value->text.size());
+          node.payload = Intern(value->text);
+          break;
+        case ProfileValueType::kArray:
+          node.count = static_cast<uint32_t>(value->elements.size());
+          node.payload = nodes_.size();
+          for (JsonValue& element : value->elements) {
+            queue.emplace_back(&element, static_cast<uint32_t>(nodes_.size()));
+            nodes_.emplace_back();
+          }
+          break;
+        case ProfileValueType::kObject:
+          node.count = static_cast<uint32_t>(value->elements.size());
+          node.payload = nodes_.size();
+          for (size_t i = 0; i < value->elements.size(); i++) {
+            BinaryProfileNode key = {};
+            key.type = static_cast<uint8_t>(ProfileValueType::kString);
+            key.count = static_cast<uint32_t>(value->keys[i].size());
+            key.payload = Intern(value->keys[i]);
+            nodes_.push_back(key);
+            queue.emplace_back(&value->elements[i],
+                               static_cast<uint32_t>(nodes_.size()));
+            nodes_.emplace_back();
+          }
+          break;
+        default:
+          break;
+      }
+      nodes_[index] = node;
+    }
+
+    BinaryProfileHeader header = {};
+    std::memcpy(header.magic, kBinaryProfileMagic, sizeof(header.magic));
+    header.version = kBinaryProfileVersion;
+    header.header_size = sizeof(BinaryProfileHeader);
+    header.node_count = static_cast<uint32_t>(nodes_.size());
+    header.root = 0;
+    header.strings_offset = static_cast<uint32_t>(
+        sizeof(BinaryProfileHeader) + nodes_.size() * sizeof(BinaryProfileNode));
+    header.strings_size = static_cast<uint32_t>(strings_.size());
+
+    out->clear();
+    out->reserve(header.strings_offset + strings_.size());
+    out->append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out->append(reinterpret_cast<const char*>(nodes_.data()),
+                nodes_.size() * sizeof(BinaryProfileNode));
+    out->append(strings_);
+  }
+
+ private:
+  // Ordina le coppie per chiave; con chiavi ripetute vale l'ultima, come
+  // in json.decode
+  static void SortKeys(JsonValue* object) {
+    std::vector<uint32_t> order(object->keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return object->keys[a] < object->keys[b];
+    });
+    std::vector<std::string> keys;
+    std::vector<JsonValue> elements;
+    keys.reserve(order.size());
+    elements.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+      if (i + 1 < order.size() &&
+          object->keys[order[i]] == object->keys[order[i + 1]]) {
+        continue;
+      }
+      keys.push_back(std::move(object->keys[order[i]]));
+      elements.push_back(std::move(object->elements[order[i]]));
+    }
+    object->keys = std::move(keys);
+    object->elements = std::move(elements);
+  }
+
+  // Le stringhe ripetute (chiavi degli oggetti in un array) sono salvate
+  // una volta sola
+  uint32_t Intern(const std::string& text) {
+    const auto [it, inserted] =
+        offsets_.try_emplace(text, static_cast<uint32_t>(strings_.size()));
+    if (inserted) {
+      strings_.append(text);
+      strings_.push_back('\0');
+    }
+    return it->second;
+  }
+
+  std::vector<BinaryProfileNode> nodes_;
+  std::string strings_;
+  std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+bool ParseError(const JsonParser& parser, std::string* error) {
+  if (error != nullptr) {
+    *error = "JSON non valido alla posizione " +
+             std::to_string(parser.position());
+  }
+  return false;
+}
+
+void AppendJsonString(std::string_view text, std::string* out) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  out->push_back('"');
+  for (const char c : text) {
+    switch (c) {
+      case '"': out->append("\\\""); break;
+      case '\\': out->append("\\\\"); break;
+      case '\b': out->append("\\b"); break;
+      case '\f': out->append("\\f"); break;
+      case '\n': out->append("\\n"); break;
+      case '\r': out->append("\\r"); break;
+      case '\t': out->append("\\t"); break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out->append("\\u00");
+          out->push_back(kHex[(c >> 4) & 0xF]);
+          out->push_back(kHex[c & 0xF]);
+        } else {
+          out->push_back(c);
+        }
+    }
+  }
+  out->push_back('"');
+}
+
+}  // namespace
+
+bool BuildBinaryProfile(std::string_view json, std::string* out,
+                        std::string* error) {
+  JsonValue root;
+  JsonParser parser(json);
+  if (!parser.Parse(&root)) return ParseError(parser, error);
+  NodeWriter().Write(&root, out);
+  return true;
+}
+
+bool BuildBinaryProfile(
+    const std::vector<std::pair<std::string, std::string>>& fields,
+    std::string* out, std::string* error) {
+  JsonValue root;
+  root.type = ProfileValueType::kObject;
+  root.keys.reserve(fields.size());
+  root.elements.resize(fields.size());
+  for (size_t i = 0; i < fields.size(); i++) {
+    root.keys.push_back(fields[i].first);
+    JsonParser parser(fields[i].second);
+    if (!parser.Parse(&root.elements[i])) {
+      if (error != nullptr) *error = "Valore JSON non valido: " + fields[i].first;
+      return false;
+    }
+  }
+  NodeWriter().Write(&root, out);
+  return true;
+}
+
+bool BinaryProfile::Open(const std::string& path) {
+  header_ = nullptr;
+  nodes_ = nullptr;
+  strings_ = nullptr;
+  if (!file_.Open(path) || file_.size() < sizeof(BinaryProfileHeader)) {
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const BinaryProfileHeader*>(file_.data());
+  const uint64_t file_size = file_.size();
+  if (std::memcmp(header->magic, kBinaryProfileMagic, sizeof(header->magic)) != 0 ||
+      header->version != kBinaryProfileVersion ||
+      header->header_size < sizeof(BinaryProfileHeader) ||
+      header->header_size % alignof(BinaryProfileNode) != 0 ||
+      header->header_size +
+              uint64_t{header->node_count} * sizeof(BinaryProfileNode) >
+          file_size ||
+      uint64_t{header->strings_offset} + header->strings_size > file_size ||
+      header->root >= header->node_count) {
+    file_.Close();
+    return false;
+  }
+  header_ = header;
+  nodes_ = reinterpret_cast<const BinaryProfileNode*>(file_.data() +
+                                                      header->header_size);
+  strings_ = reinterpret_cast<const char*>(file_.data() + header->strings_offset);
+  if (!Validate()) {
+    header_ = nullptr;
+    nodes_ = nullptr;
+    strings_ = nullptr;
+    file_.Close();
+    return false;
+  }
+  return true;
+}
+
+bool BinaryProfile::Validate() const {
+  // Come per il lessico, le stringhe vanno terminate da zero perché Dart le
+  // legge dalla mappatura; i figli stanno dopo il padre, così nessun
+  // percorso nella tabella può tornare indietro
+  const uint64_t node_count = header_->node_count;
+  auto is_string = [&](const BinaryProfileNode& node) {
+    const uint64_t end = node.payload + uint64_t{node.count};
+    return node.type == static_cast<uint8_t>(ProfileValueType::kString) &&
+           node.payload < header_->strings_size &&
+           end < header_->strings_size && strings_[end] == '\0';
+  };
+  for (uint64_t i = 0; i < node_count; i++) {
+    const BinaryProfileNode& node = nodes_[i];
+    switch (static_cast<ProfileValueType>(node.type)) {
+      case ProfileValueType::kNull:
+      case ProfileValueType::kFalse:
+      case ProfileValueType::kTrue:
+      case ProfileValueType::kInt:
+      case ProfileValueType::kDouble:
+        break;
+      case ProfileValueType::kString:
+        if (!is_string(node)) return false;
+        break;
+      case ProfileValueType::kArray:
+        if (node.payload <= i || node.payload > node_count ||
+            node.count > node_count - node.payload) {
+          return false;
+        }
+        break;
+      case ProfileValueType::kObject:
+        if (node.payload <= i || node.payload > node_count ||
+            2 * uint64_t{node.count} > node_count - node.payload) {
+          return false;
+        }
+        for (uint64_t k = 0; k < node.count; k++) {
+          if (!is_string(nodes_[node.payload + 2 * k])) return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+uint32_t BinaryProfile::Find(uint32_t object, std::string_view key) const {
+  const BinaryProfileNode* parent = node(object);
+  if (parent == nullptr ||
+      parent->type != static_cast<uint8_t>(ProfileValueType::kObject)) {
+    return kNone;
+  }
+  uint32_t low = 0;
+  uint32_t high = parent->count;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    const std::string_view candidate =
+        String(static_cast<uint32_t>(parent->payload) + 2 * mid);
+    if (candidate < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low < parent->count &&
+      String(static_cast<uint32_t>(parent->payload) + 2 * low) == key) {
+    return static_cast<uint32_t>(parent->payload) + 2 * low + 1;
+  }
+  return kNone;
+}
+
+uint32_t BinaryProfile::Element(uint32_t array, uint32_t index) const {
+  const BinaryProfileNode* parent = node(array);
+  if (parent == nullptr ||
+      parent->type != static_cast<uint8_t>(ProfileValueType::kArray) ||
+      index >= parent->count) {
+    return kNone;
+  }
+  return static_cast<uint32_t>(parent->payload) + index;
+}
+
+uint32_t BinaryProfile::Key(uint32_t object, uint32_t index) const {
+  const BinaryProfileNode* parent = node(object);
+  if (parent == nullptr ||
+      parent->type != static_cast<uint8_t>(ProfileValueType::kObject) ||
+      index >= parent->count) {
+    return kNone;
+  }
+  return static_cast<uint32_t>(parent->payload) + 2 * index;
+}
+
+uint32_t BinaryProfile::Value(uint32_t object, uint32_t index) const {
+  const uint32_t key = Key(object, index);
+  return key != kNone ? key + 1 : kNone;
+}
+
+int64_t BinaryProfile::Int(uint32_t index) const {
+  const BinaryProfileNode* value = node(index);
+  int64_t integer = 0;
+  if (value != nullptr &&
+      value->type == static_cast<uint8_t>(ProfileValueType::kInt)) {
+    std::memcpy(&integer, &value->payload, sizeof(integer));
+  } else if (value != nullptr &&
+             value->type == static_cast<uint8_t>(ProfileValueType::kDouble)) {
+    // Fuori da int64 (o NaN) la conversione non è definita
+    const double number = Double(index);
+    if (number > -9.2e18 && number < 9.2e18) {
+      integer = static_cast<int64_t>(number);
+    }
+  }
+  return integer;
+}
+
+double BinaryProfile::Double(uint32_t index) const {
+  const BinaryProfileNode* value = node(index);
+  if (value == nullptr) return 0;
+  if (value->type == static_cast<uint8_t>(ProfileValueType::kInt)) {
+    return static_cast<double>(Int(index));
+  }
+  double number = 0;
+  if (value->type == static_cast<uint8_t>(ProfileValueType::kDouble)) {
+    std::memcpy(&number, &value->payload, sizeof(number));
+  }
+  return number;
+}
+
+std::string_view BinaryProfile::String(uint32_t index) const {
+  const BinaryProfileNode* value = node(index);
+  if (value == nullptr ||
+      value->type != static_cast<uint8_t>(ProfileValueType::kString)) {
+    return {};
+  }
+  return std::string_view(strings_ + value->payload, value->count);
+}
+
+void BinaryProfile::ToJson(uint32_t index, std::string* out) const {
+  out->clear();
+  if (header_ == nullptr) return;
+  AppendJson(index == kNone ? root() : index, 0, out);
+}
+
+void BinaryProfile::AppendJson(uint32_t index, int depth,
+                               std::string* out) const {
+  // Senza limite di profondità, un file valido ma annidato a catena
+  // esaurirebbe lo stack
+  const BinaryProfileNode* value = node(index);
+  if (value == nullptr || depth > kMaxDepth) {
+    out->append("null");
+    return;
+  }
+  switch (static_cast<ProfileValueType>(value->type)) {
+    case ProfileValueType::kNull:
+      out->append("null");
+      break;
+    case ProfileValueType::kFalse:
+      out->append("false");
+      break;
+    case ProfileValueType::kTrue:
+      out->append("true");
+      break;
+    case ProfileValueType::kInt: {
+      char buffer[24];
+      const auto result =
+          std::to_chars(buffer, buffer + sizeof(buffer), Int(index));
+      out->append(buffer, result.ptr);
+      break;
+    }
+    case ProfileValueType::kDouble: {
+      const double number = Double(index);
+      if (!std::isfinite(number)) {
+        out->append("null");
+        break;
+      }
+      // Rappresentazione più corta che rilegge lo stesso double; ".0" evita
+      // che torni indietro come intero
+      char buffer[32];
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+      const std::string_view text(buffer, result.ptr - buffer);
+      out->append(text);
+      if (text.find_first_of(".e") == std::string_view::npos) out->append(".0");
+      break;
+    }
+    case ProfileValueType::kString:
+      AppendJsonString(String(index), out);
+      break;
+    case ProfileValueType::kArray:
+      out->push_back('[');
+      for (uint32_t i = 0; i < value->count; i++) {
+        if (i > 0) out->push_back(',');
+        AppendJson(Element(index, i), depth + 1, out);
+      }
+      out->push_back(']');
+      break;
+    case ProfileValueType::kObject:
+      out->push_back('{');
+      for (uint32_t i = 0; i < value->count; i++) {
+        if (i > 0) out->push_back(',');
+        AppendJsonString(String(Key(index, i)), out);
+        out->push_back(':');
+        AppendJson(Value(index, i), depth + 1, out);
+      }
+      out->push_back('}');
+      break;
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,142 @@
+// linux/native/binary_profile.h
+
+#ifndef OPENDSA_NATIVE_BINARY_PROFILE_H_
+#define OPENDSA_NATIVE_BINARY_PROFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace opendsa {
+
+// Profilo in formato binario, pensato per essere mappato in memoria e letto
+// un campo alla volta senza decodificare il resto. Rappresenta un valore
+// JSON qualsiasi (in pratica Player.toJson, con usedWords, gameData e lo
+// storico dell'accuratezza) come tabella di nodi a dimensione fissa:
+// scalari e lunghezze stanno nel nodo, le stringhe in un'area comune e i
+// figli di array e oggetti in nodi contigui. Le chiavi di ogni oggetto sono
+// ordinate, quindi un campo si trova con una ricerca binaria e un elemento
+// di un vettore con un accesso diretto.
+//
+// Il formato non fissa uno schema: campi nuovi del profilo non richiedono
+// modifiche e i lettori ignorano quelli che non conoscono. version cambia
+// solo con il layout; header_size permette di estendere l'intestazione
+// senza spostare le tabelle.
+//
+// Layout del file (little-endian):
+//   BinaryProfileHeader
+//   BinaryProfileNode[node_count]   a partire da header_size
+//   stringhe UTF-8 terminate da zero
+//
+// La conversione da e verso JSON è senza perdite: interi e decimali restano
+// distinti e l'esportazione riproduce lo stesso valore, con le chiavi degli
+// oggetti in ordine.
+constexpr char kBinaryProfileMagic[8] = {'O', 'D', 'S', 'A', 'P', 'B', 'I', 'N'};
+constexpr uint32_t kBinaryProfileVersion = 1;
+
+enum class ProfileValueType : uint8_t {
+  kNull = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInt = 3,     // payload: int64
+  kDouble = 4,  // payload: bit del double
+  kString = 5,  // payload: offset nell'area stringhe, count: byte
+  kArray = 6,   // payload: indice del primo elemento, count: elementi
+  kObject = 7,  // payload: indice della prima chiave, count: coppie
+                // (chiave, valore) contigue, in ordine di chiave
+};
+
+struct BinaryProfileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t node_count;
+  uint32_t root;
+  uint32_t strings_offset;
+  uint32_t strings_size;
+};
+
+struct BinaryProfileNode {
+  uint8_t type;
+  uint8_t reserved[3];
+  uint32_t count;
+  uint64_t payload;
+};
+
+static_assert(sizeof(BinaryProfileHeader) == 32,
+              "BinaryProfileHeader deve restare 32 byte");
+static_assert(sizeof(BinaryProfileNode) == 16,
+              "BinaryProfileNode deve restare 16 byte");
+
+// Converte il testo JSON |json| nel formato binario. Restituisce false, con
+// la posizione in |error|, se il testo non è JSON valido.
+bool BuildBinaryProfile(std::string_view json, std::string* out,
+                        std::string* error = nullptr);
+
+// Come BuildBinaryProfile, per un oggetto dato come coppie (chiave, valore
+// in JSON), ad esempio lo stato di un ProfileLog.
+bool BuildBinaryProfile(
+    const std::vector<std::pair<std::string, std::string>>& fields,
+    std::string* out, std::string* error = nullptr);
+
+// Lettore di un profilo binario mappato. I nodi sono indici nella tabella;
+// le stringhe restituite puntano alla mappatura e restano valide finché il
+// profilo è aperto.
+class BinaryProfile {
+ public:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  BinaryProfile() = default;
+  BinaryProfile(const BinaryProfile&) = delete;
+  BinaryProfile& operator=(const BinaryProfile&) = delete;
+
+  // Mappa |path| e ne verifica intestazione, nodi e stringhe. Restituisce
+  // false se il file manca o non è valido.
+  bool Open(const std::string& path);
+
+  uint32_t root() const { return header_ != nullptr ? header_->root : kNone; }
+  uint32_t size() const { return header_ != nullptr ? header_->node_count : 0; }
+
+  // Nodo |index|, null se fuori tabella.
+  const BinaryProfileNode* node(uint32_t index) const {
+    return index < size() ? &nodes_[index] : nullptr;
+  }
+
+  // Valore di |key| nell'oggetto |object|, kNone se assente o se |object|
+  // non è un oggetto.
+  uint32_t Find(uint32_t object, std::string_view key) const;
+
+  // Elemento |index| di un array, o chiave/valore della coppia |index| di
+  // un oggetto; kNone se fuori intervallo.
+  uint32_t Element(uint32_t array, uint32_t index) const;
+  uint32_t Key(uint32_t object, uint32_t index) const;
+  uint32_t Value(uint32_t object, uint32_t index) const;
+
+  // Numero del nodo |index|, convertito tra intero e decimale; 0 se non è un
+  // numero.
+  int64_t Int(uint32_t index) const;
+  double Double(uint32_t index) const;
+
+  // Stringa del nodo |index|, vuota se non è una stringa.
+  std::string_view String(uint32_t index) const;
+
+  // Serializza il nodo |index| (la radice con kNone) in JSON compatto.
+  void ToJson(uint32_t index, std::string* out) const;
+
+ private:
+  bool Validate() const;
+  void AppendJson(uint32_t index, int depth, std::string* out) const;
+
+  MappedFile file_;
+  const BinaryProfileHeader* header_ = nullptr;
+  const BinaryProfileNode* nodes_ = nullptr;
+  const char* strings_ = nullptr;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_BINARY_PROFILE_H_
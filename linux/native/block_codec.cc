@@ -0,0 +1,155 @@
+// linux/native/block_codec.cc
+
+#include "block_codec.h"
+
+#include <cstring>
+
+namespace opendsa {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 15;
+// Candidati esaminati per ogni posizione: oltre, il guadagno sui testi
+// degli esercizi è trascurabile
+constexpr int kMaxChain = 64;
+// Limite di sicurezza sulle lunghezze estese di un blocco corrotto
+constexpr size_t kMaxLength = size_t{1} << 30;
+
+uint32_t Hash4(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+void AppendLength(size_t extra, std::string* out) {
+  while (extra >= 255) {
+    out->push_back(static_cast<char>(255));
+    extra -= 255;
+  }
+  out->push_back(static_cast<char>(extra));
+}
+
+// Accoda una sequenza; |match_length| 0 indica l'ultima, di soli letterali.
+void EmitSequence(const uint8_t* literals, size_t literal_count, size_t offset,
+                  size_t match_length, std::string* out) {
+  const size_t match_code = match_length > 0 ? match_length - kMinMatch : 0;
+  const size_t literal_nibble = literal_count < 15 ? literal_count : 15;
+  const size_t match_nibble = match_code < 15 ? match_code : 15;
+  out->push_back(static_cast<char>((literal_nibble << 4) | match_nibble));
+  if (literal_count >= 15) AppendLength(literal_count - 15, out);
+  out->append(reinterpret_cast<const char*>(literals), literal_count);
+  if (match_length == 0) return;
+  out->push_back(static_cast<char>(offset & 0xFF));
+  out->push_back(static_cast<char>(offset >> 8));
+  if (match_code >= 15) AppendLength(match_code - 15, out);
+}
+
+bool ReadLength(const uint8_t** in, const uint8_t* end, size_t* length) {
+  uint8_t next;
+  do {
+    if (*in >= end) return false;
+    next = *(*in)++;
+    *length += next;
+    if (*length > kMaxLength) return false;
+  } while (next == 255);
+  return true;
+}
+
+}  // namespace
+
+void BlockCompressor::Compress(const uint8_t* data, size_t size,
+                               std::string* out) {
+  head_.assign(size_t{1} << kHashBits, -1);
+  chain_.resize(size);
+
+  // Inserisce |pos| in testa alla catena del suo hash
+  auto insert = [&](size_t pos) {
+    const uint32_t hash = Hash4(data + pos);
+    chain_[pos] = head_[hash];
+    head_[hash] = static_cast<int32_t>(pos);
+  };
+
+  size_t anchor = 0;
+  size_t pos = 0;
+  while (size >= kMinMatch && pos <= size - kMinMatch) {
+    size_t best_length = 0;
+    size_t best_offset = 0;
+    int32_t candidate = head_[Hash4(data + pos)];
+    for (int depth = 0; candidate >= 0 && depth < kMaxChain; depth++) {
+      const size_t offset = pos - static_cast<size_t>(candidate);
+      if (offset > kMaxOffset) break;
+      // Un candidato può migliorare solo se coincide anche sul byte oltre
+      // la copia migliore trovata finora
+      if (data[candidate + best_length] == data[pos + best_length]) {
+        size_t length = 0;
+        while (pos + length < size && data[candidate + length] == data[pos + length]) {
+          length++;
+        }
+        if (length > best_length) {
+          best_length = length;
+          best_offset = offset;
+          if (pos + best_length == size) break;
+        }
+      }
+      candidate = chain_[candidate];
+    }
+
+    insert(pos);
+    if (best_length >= kMinMatch) {
+      EmitSequence(data + anchor, pos - anchor, best_offset, best_length, out);
+      for (size_t p = pos + 1; p < pos + best_length && p <= size - kMinMatch; p++) {
+        insert(p);
+      }
+      pos += best_length;
+      anchor = pos;
+    } else {
+      pos++;
+    }
+  }
+  EmitSequence(data + anchor, size - anchor, 0, 0, out);
+}
+
+bool DecompressBlock(const uint8_t* data, size_t size, uint8_t* out,
+                     size_t out_size) {
+  const uint8_t* in = data;
+  const uint8_t* const end = data + size;
+  uint8_t* op = out;
+  uint8_t* const out_end = out + out_size;
+
+  while (in < end) {
+    const uint8_t token = *in++;
+    size_t literals = token >> 4;
+    if (literals == 15 && !ReadLength(&in, end, &literals)) return false;
+    if (literals > static_cast<size_t>(end - in) ||
+        literals > static_cast<size_t>(out_end - op)) {
+      return false;
+    }
+    std::memcpy(op, in, literals);
+    in += literals;
+    op += literals;
+    if (in == end) break;  // Ultima sequenza
+
+    if (end - in < 2) return false;
+    const size_t offset = in[0] | (size_t{in[1]} << 8);
+    in += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - out)) return false;
+    size_t length = token & 0x0F;
+    if (length == 15 && !ReadLength(&in, end, &length)) return false;
+    length += kMinMatch;
+    if (length > static_cast<size_t>(out_end - op)) return false;
+
+    const uint8_t* source = op - offset;
+    if (offset >= length) {
+      std::memcpy(op, source, length);
+      op += length;
+    } else {
+      // Copia sovrapposta: ripete gli ultimi |offset| byte
+      for (size_t i = 0; i < length; i++) *op++ = source[i];
+    }
+  }
+  return op == out_end;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,47 @@
+// linux/native/block_codec.h
+
+#ifndef OPENDSA_NATIVE_BLOCK_CODEC_H_
+#define OPENDSA_NATIVE_BLOCK_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opendsa {
+
+// Compressione LZ a blocchi indipendenti, nello stile di LZ4: ogni blocco si
+// decomprime da solo, senza dizionari condivisi, con una sola passata e
+// nessuna allocazione. Il formato è una serie di sequenze:
+//
+//   token          4 bit alti: letterali (15 = continua), 4 bit bassi:
+//                  lunghezza della copia - 4 (15 = continua)
+//   [lunghezza]    byte aggiuntivi dei letterali, 255 = continua
+//   letterali
+//   offset         2 byte little-endian, distanza all'indietro (1..65535)
+//   [lunghezza]    byte aggiuntivi della copia, 255 = continua
+//
+// L'ultima sequenza contiene solo letterali e termina il blocco.
+//
+// Il compressore cerca le ripetizioni con catene di hash: è più lento di LZ4
+// ma comprime meglio, ed è usato solo in fase di build. Non è thread-safe:
+// usare un'istanza per thread.
+class BlockCompressor {
+ public:
+  // Accoda a |out| la compressione di |size| byte di |data|.
+  void Compress(const uint8_t* data, size_t size, std::string* out);
+
+ private:
+  std::vector<int32_t> head_;
+  std::vector<int32_t> chain_;
+};
+
+// Decomprime un blocco in |out|, che deve essere lungo esattamente
+// |out_size| byte (la dimensione originale). Restituisce false se il blocco
+// è corrotto o non produce esattamente |out_size| byte.
+bool DecompressBlock(const uint8_t* data, size_t size, uint8_t* out,
+                     size_t out_size);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_BLOCK_CODEC_H_
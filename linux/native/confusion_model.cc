@@ -0,0 +1,151 @@
+// linux/native/confusion_model.cc
+
+#include "confusion_model.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'D', 'S', 'A', 'C', 'O', 'N', 'F'};
+constexpr uint32_t kFormatVersion = 1;
+
+// Layout del file .confusion (little-endian, come la piattaforma):
+// intestazione, conteggi delle osservazioni e matrice delle sostituzioni.
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t attempts;
+};
+
+constexpr size_t kObservationsBytes = kNumCharClasses * sizeof(uint16_t);
+constexpr size_t kSubstitutionsBytes =
+    kNumCharClasses * kNumCharClasses * sizeof(uint16_t);
+constexpr size_t kFileSize =
+    sizeof(FileHeader) + kObservationsBytes + kSubstitutionsBytes;
+
+}  // namespace
+
+ConfusionModel::ConfusionModel() {
+  Reset();
+}
+
+void ConfusionModel::Reset() {
+  observations_.fill(0);
+  substitutions_.fill(0);
+  dirty_rows_.fill(false);
+  attempts_ = 0;
+  costs_ = CostMatrix::Default();
+}
+
+void ConfusionModel::Decay(int expected_class) {
+  observations_[expected_class] /= 2;
+  uint16_t* row = &substitutions_[expected_class * kNumCharClasses];
+  for (int r = 0; r < kNumCharClasses; r++) row[r] /= 2;
+}
+
+void ConfusionModel::Count(int expected_class, int recognized_class) {
+  // Le sostituzioni di una riga non superano mai le sue osservazioni, quindi
+  // basta controllare queste ultime per evitare l'overflow
+  if (observations_[expected_class] == UINT16_MAX) Decay(expected_class);
+  observations_[expected_class]++;
+  if (recognized_class >= 0) {
+    substitutions_[expected_class * kNumCharClasses + recognized_class]++;
+  }
+  dirty_rows_[expected_class] = true;
+}
+
+void ConfusionModel::Observe(const std::u32string& target,
+                             const std::u32string& recognized,
+                             const std::vector<AlignmentStep>& path) {
+  for (const AlignmentStep& step : path) {
+    switch (step.op) {
+      case EditOp::kMatch:
+      case EditOp::kDeletion:
+        // Lettera letta correttamente o saltata: conta solo al denominatore
+        Count(CharClass(target[step.target_pos]), -1);
+        break;
+      case EditOp::kTransposition:
+        Count(CharClass(target[step.target_pos]), -1);
+        Count(CharClass(target[step.target_pos + 1]), -1);
+        break;
+      case EditOp::kSubstitution:
+        Count(CharClass(target[step.target_pos]),
+              CharClass(recognized[step.recognized_pos]));
+        break;
+      case EditOp::kInsertion:
+        break;
+    }
+  }
+  attempts_++;
+
+  for (int e = 0; e < kNumCharClasses; e++) {
+    if (dirty_rows_[e]) {
+      RebuildRow(e);
+      dirty_rows_[e] = false;
+    }
+  }
+}
+
+void ConfusionModel::RebuildRow(int expected_class) {
+  const CostMatrix& base = CostMatrix::Default();
+  const uint16_t observed = observations_[expected_class];
+  for (int r = 0; r < kNumCharClasses; r++) {
+    const uint16_t base_cost = base.cell(expected_class, r);
+    if (observed < kMinObservations || r == expected_class) {
+      costs_.set_cell(expected_class, r, base_cost);
+      continue;
+    }
+    // Più spesso il profilo confonde la coppia, più la sostituzione è
+    // considerata un errore "tipico" e pesa meno sulla similarità
+    const double rate =
+        static_cast<double>(substitutions(expected_class, r)) / observed;
+    const double discount = std::min(1.0, rate / kSaturationRate) * kCostUnit;
+    const int32_t cost = static_cast<int32_t>(base_cost - discount);
+    costs_.set_cell(expected_class, r,
+                    static_cast<uint16_t>(std::max<int32_t>(kMinLearnedCost,
+                                                            cost)));
+  }
+}
+
+bool ConfusionModel::Load(const std::string& path) {
+  Reset();
+  std::string data;
+  if (!ReadFile(path, &data)) return !FileExists(path);
+  if (data.size() != kFileSize) return false;
+
+  FileHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kFormatVersion) {
+    return false;
+  }
+
+  attempts_ = header.attempts;
+  std::memcpy(observations_.data(), data.data() + sizeof(header),
+              kObservationsBytes);
+  std::memcpy(substitutions_.data(),
+              data.data() + sizeof(header) + kObservationsBytes,
+              kSubstitutionsBytes);
+  for (int e = 0; e < kNumCharClasses; e++) RebuildRow(e);
+  return true;
+}
+
+bool ConfusionModel::Save(const std::string& path) const {
+  std::string data(kFileSize, '\0');
+  FileHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.attempts = attempts_;
+  std::memcpy(&data[0], &header, sizeof(header));
+  std::memcpy(&data[sizeof(header)], observations_.data(), kObservationsBytes);
+  std::memcpy(&data[sizeof(header) + kObservationsBytes],
+              substitutions_.data(), kSubstitutionsBytes);
+  return WriteFileAtomically(path, data.data(), data.size());
+}
+
+}  // namespace opendsa
@@ -0,0 +1,74 @@
+// linux/native/confusion_model.h
+
+#ifndef OPENDSA_NATIVE_CONFUSION_MODEL_H_
+#define OPENDSA_NATIVE_CONFUSION_MODEL_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "alignment.h"
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+// Modello delle confusioni di un singolo profilo, appreso dagli allineamenti
+// dei tentativi. Mantiene i conteggi delle sostituzioni per coppia di classi
+// (attesa, letta) e una CostMatrix derivata, ricalcolata solo sulle righe
+// toccate da ogni aggiornamento: il motore di similarità la usa così com'è,
+// senza costi aggiuntivi per cella.
+class ConfusionModel {
+ public:
+  // Osservazioni minime di una lettera prima di personalizzarne i costi.
+  static constexpr uint16_t kMinObservations = 8;
+
+  // Frequenza di confusione oltre la quale lo sconto sul costo è massimo.
+  static constexpr double kSaturationRate = 0.15;
+
+  // Costo minimo di una sostituzione appresa.
+  static constexpr uint16_t kMinLearnedCost = kCostUnit / 4;
+
+  ConfusionModel();
+
+  // Aggiorna i conteggi con l'allineamento di un tentativo. |path| deve
+  // riferirsi ai testi normalizzati |target| e |recognized|.
+  void Observe(const std::u32string& target,
+               const std::u32string& recognized,
+               const std::vector<AlignmentStep>& path);
+
+  // Carica il modello da |path|. Un file assente lascia il modello vuoto e
+  // restituisce true; un file corrotto o di versione diversa restituisce false.
+  bool Load(const std::string& path);
+
+  // Salva il modello in modo atomico (file temporaneo e rename).
+  bool Save(const std::string& path) const;
+
+  void Reset();
+
+  const CostMatrix& costs() const { return costs_; }
+  uint32_t attempts() const { return attempts_; }
+  uint16_t observations(int expected_class) const {
+    return observations_[expected_class];
+  }
+  uint16_t substitutions(int expected_class, int recognized_class) const {
+    return substitutions_[expected_class * kNumCharClasses + recognized_class];
+  }
+
+ private:
+  void Count(int expected_class, int recognized_class);
+  void Decay(int expected_class);
+  void RebuildRow(int expected_class);
+
+  // I conteggi sono a 16 bit: quando una riga satura viene dimezzata, il che
+  // dà anche più peso ai tentativi recenti.
+  std::array<uint16_t, kNumCharClasses> observations_;
+  std::array<uint16_t, kNumCharClasses * kNumCharClasses> substitutions_;
+  std::array<bool, kNumCharClasses> dirty_rows_;
+  uint32_t attempts_ = 0;
+  CostMatrix costs_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_CONFUSION_MODEL_H_
@@ -0,0 +1,237 @@
+// linux/native/content_index.cc
+
+#include "content_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kIndexMagic[8] = {'O', 'D', 'S', 'A', 'I', 'D', 'X', '\0'};
+constexpr uint32_t kIndexVersion = 1;
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t fingerprint;
+  uint32_t bucket_count;
+  uint64_t rng_state;
+};
+
+static_assert(sizeof(IndexHeader) == 32, "IndexHeader deve restare 32 byte");
+
+// FNV-1a delle voci del lessico: cambia se cambiano parole o caratteristiche
+uint32_t Fingerprint(const Lexicon& lexicon) {
+  uint32_t hash = 2166136261u;
+  const auto* bytes = reinterpret_cast<const uint8_t*>(lexicon.entries());
+  const size_t size = size_t{lexicon.size()} * sizeof(LexiconEntry);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+bool InRange(int32_t value, int32_t min, int32_t max) {
+  return (min <= 0 || value >= min) && (max <= 0 || value <= max);
+}
+
+}  // namespace
+
+WordDifficulty ClassifyDifficulty(const LexiconEntry& entry) {
+  const bool complex = (entry.flags & kWordComplexSyllables) != 0;
+  if (entry.syllables > 4 || entry.length > 8 || complex) {
+    return WordDifficulty::kHard;
+  }
+  if (entry.syllables <= 2 && entry.length <= 5) return WordDifficulty::kEasy;
+  return WordDifficulty::kMedium;
+}
+
+uint32_t ContentIndex::KeyFor(const LexiconEntry& entry) {
+  const uint32_t difficulty =
+      static_cast<uint32_t>(ClassifyDifficulty(entry));
+  const uint32_t syllables =
+      std::min<uint32_t>(entry.syllables, kMaxSyllables);
+  const uint32_t length = std::min<uint32_t>(entry.length, kMaxLength);
+  return uint32_t{entry.level} << 24 | difficulty << 16 | syllables << 8 |
+         length;
+}
+
+bool ContentIndex::Matches(uint32_t key, const WordQuery& query) {
+  const int32_t level = static_cast<int32_t>(key >> 24);
+  const auto difficulty = static_cast<WordDifficulty>((key >> 16) & 0xFF);
+  const int32_t syllables = static_cast<int32_t>((key >> 8) & 0xFF);
+  const int32_t length = static_cast<int32_t>(key & 0xFF);
+  return level == query.level &&
+         (query.difficulty == WordDifficulty::kAny ||
+          query.difficulty == difficulty) &&
+         InRange(syllables, query.min_syllables, query.max_syllables) &&
+         InRange(length, query.min_length, query.max_length);
+}
+
+void ContentIndex::Build(const Lexicon& lexicon, uint64_t seed) {
+  const uint32_t size = lexicon.size();
+  fingerprint_ = Fingerprint(lexicon);
+  rng_state_ = seed;
+
+  keys_.resize(size);
+  order_.resize(size);
+  for (uint32_t i = 0; i < size; i++) {
+    keys_[i] = KeyFor(lexicon.entry(i));
+    order_[i] = i;
+  }
+  std::stable_sort(order_.begin(), order_.end(),
+                   [this](uint32_t a, uint32_t b) {
+                     return keys_[a] < keys_[b];
+                   });
+
+  buckets_.clear();
+  for (uint32_t i = 0; i < size; i++) {
+    const uint32_t key = keys_[order_[i]];
+    if (buckets_.empty() || buckets_.back().key != key) {
+      buckets_.push_back({key, i, 0, 0});
+    }
+    buckets_.back().count++;
+  }
+  for (Bucket& bucket : buckets_) Shuffle(&bucket);
+}
+
+bool ContentIndex::Load(const std::string& path) {
+  std::string data;
+  if (!ReadFile(path, &data) || data.size() < sizeof(IndexHeader)) {
+    return false;
+  }
+  IndexHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  const size_t expected_size = sizeof(IndexHeader) +
+                               buckets_.size() * sizeof(Bucket) +
+                               order_.size() * sizeof(uint32_t);
+  if (std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+      header.version != kIndexVersion ||
+      header.entry_count != order_.size() ||
+      header.fingerprint != fingerprint_ ||
+      header.bucket_count != buckets_.size() || data.size() != expected_size) {
+    return false;
+  }
+
+  std::vector<Bucket> buckets(buckets_.size());
+  std::vector<uint32_t> order(order_.size());
+  const char* cursor = data.data() + sizeof(IndexHeader);
+  std::memcpy(buckets.data(), cursor, buckets.size() * sizeof(Bucket));
+  cursor += buckets.size() * sizeof(Bucket);
+  std::memcpy(order.data(), cursor, order.size() * sizeof(uint32_t));
+
+  // Ogni bucket deve contenere esattamente le sue parole, una volta sola
+  std::vector<bool> seen(order.size(), false);
+  for (size_t b = 0; b < buckets.size(); b++) {
+    const Bucket& saved = buckets[b];
+    const Bucket& built = buckets_[b];
+    if (saved.key != built.key || saved.begin != built.begin ||
+        saved.count != built.count || saved.cursor > saved.count) {
+      return false;
+    }
+    for (uint32_t i = saved.begin; i < saved.begin + saved.count; i++) {
+      const uint32_t word = order[i];
+      if (word >= order.size() || seen[word] || keys_[word] != saved.key) {
+        return false;
+      }
+      seen[word] = true;
+    }
+  }
+
+  buckets_ = std::move(buckets);
+  order_ = std::move(order);
+  rng_state_ = header.rng_state;
+  return true;
+}
+
+bool ContentIndex::Save(const std::string& path) const {
+  IndexHeader header = {};
+  std::memcpy(header.magic, kIndexMagic, sizeof(header.magic));
+  header.version = kIndexVersion;
+  header.entry_count = static_cast<uint32_t>(order_.size());
+  header.fingerprint = fingerprint_;
+  header.bucket_count = static_cast<uint32_t>(buckets_.size());
+  header.rng_state = rng_state_;
+
+  std::string data;
+  data.reserve(sizeof(header) + buckets_.size() * sizeof(Bucket) +
+               order_.size() * sizeof(uint32_t));
+  data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  data.append(reinterpret_cast<const char*>(buckets_.data()),
+              buckets_.size() * sizeof(Bucket));
+  data.append(reinterpret_cast<const char*>(order_.data()),
+              order_.size() * sizeof(uint32_t));
+  return WriteFileAtomically(path, data.data(), data.size());
+}
+
+int32_t ContentIndex::Next(const WordQuery& query) {
+  uint32_t remaining = static_cast<uint32_t>(Remaining(query));
+  if (remaining == 0) {
+    // Giro completo: si rimescolano solo i bucket della richiesta
+    for (Bucket& bucket : buckets_) {
+      if (!Matches(bucket.key, query)) continue;
+      Shuffle(&bucket);
+      remaining += bucket.count;
+    }
+    if (remaining == 0) return -1;
+  }
+
+  // Scegliendo il bucket in proporzione alle parole rimaste, la sequenza
+  // complessiva è una permutazione uniforme di tutte le parole compatibili
+  uint32_t pick = static_cast<uint32_t>(NextRandom() % remaining);
+  for (Bucket& bucket : buckets_) {
+    if (!Matches(bucket.key, query)) continue;
+    const uint32_t left = bucket.count - bucket.cursor;
+    if (pick < left) {
+      return static_cast<int32_t>(order_[bucket.begin + bucket.cursor++]);
+    }
+    pick -= left;
+  }
+  return -1;
+}
+
+int32_t ContentIndex::Count(const WordQuery& query) const {
+  uint32_t count = 0;
+  for (const Bucket& bucket : buckets_) {
+    if (Matches(bucket.key, query)) count += bucket.count;
+  }
+  return static_cast<int32_t>(count);
+}
+
+int32_t ContentIndex::Remaining(const WordQuery& query) const {
+  uint32_t remaining = 0;
+  for (const Bucket& bucket : buckets_) {
+    if (Matches(bucket.key, query)) remaining += bucket.count - bucket.cursor;
+  }
+  return static_cast<int32_t>(remaining);
+}
+
+void ContentIndex::Shuffle(Bucket* bucket) {
+  uint32_t* words = order_.data() + bucket->begin;
+  const uint32_t last = bucket->count > 0 ? words[bucket->count - 1] : 0;
+  for (uint32_t i = bucket->count; i > 1; i--) {
+    const uint32_t j = static_cast<uint32_t>(NextRandom() % i);
+    std::swap(words[i - 1], words[j]);
+  }
+  // L'ultima parola del giro precedente non apre quello nuovo
+  if (bucket->count > 1 && words[0] == last) {
+    std::swap(words[0], words[bucket->count - 1]);
+  }
+  bucket->cursor = 0;
+}
+
+// splitmix64: veloce, con stato di 64 bit facile da salvare
+uint64_t ContentIndex::NextRandom() {
+  uint64_t z = (rng_state_ += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+}  // namespace opendsa
@@ -0,0 +1,93 @@
+// linux/native/content_index.h
+
+#ifndef OPENDSA_NATIVE_CONTENT_INDEX_H_
+#define OPENDSA_NATIVE_CONTENT_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lexicon.h"
+
+namespace opendsa {
+
+// Difficoltà di una parola. I valori coincidono con Difficulty.index in Dart
+// e con le costanti OPENDSA_DIFFICULTY_*.
+enum class WordDifficulty : int32_t {
+  kAny = -1,
+  kEasy = 0,
+  kMedium = 1,
+  kHard = 2,
+};
+
+// Difficoltà di una voce del lessico, con le stesse soglie di
+// ContentService._getWordsForDifficulty ma senza sovrapposizioni: ogni
+// parola finisce in una sola classe.
+WordDifficulty ClassifyDifficulty(const LexiconEntry& entry);
+
+// Vincoli di una richiesta di parola. I limiti a 0 non vengono applicati.
+struct WordQuery {
+  int32_t level = 1;
+  WordDifficulty difficulty = WordDifficulty::kAny;
+  int32_t min_syllables = 0;
+  int32_t max_syllables = 0;
+  int32_t min_length = 0;
+  int32_t max_length = 0;
+};
+
+// Indice delle parole del lessico per (livello, difficoltà, sillabe,
+// lunghezza). Ogni bucket è una permutazione casuale delle sue parole con un
+// cursore: la parola successiva non ancora proposta si ottiene senza
+// allocazioni e senza scandire il lessico. Quando le parole compatibili con
+// una richiesta sono esaurite, i loro bucket vengono rimescolati.
+//
+// Permutazioni e cursori possono essere salvati, così le parole già proposte
+// non si ripetono neanche fra un avvio e l'altro.
+class ContentIndex {
+ public:
+  // Sillabe e lunghezze oltre questi valori finiscono nell'ultimo bucket.
+  static constexpr int32_t kMaxSyllables = 8;
+  static constexpr int32_t kMaxLength = 24;
+
+  // Costruisce i bucket per |lexicon| e li mescola a partire da |seed|.
+  void Build(const Lexicon& lexicon, uint64_t seed);
+
+  // Ripristina permutazioni e cursori salvati. Restituisce false (lasciando
+  // l'indice com'è) se il file manca o è stato creato per un altro lessico.
+  bool Load(const std::string& path);
+
+  // Salva lo stato in modo atomico.
+  bool Save(const std::string& path) const;
+
+  // Indice nel lessico della prossima parola compatibile con |query|, -1 se
+  // nessuna parola è compatibile.
+  int32_t Next(const WordQuery& query);
+
+  // Parole compatibili con |query|, in totale e non ancora proposte.
+  int32_t Count(const WordQuery& query) const;
+  int32_t Remaining(const WordQuery& query) const;
+
+ private:
+  struct Bucket {
+    uint32_t key;
+    uint32_t begin;   // Primo elemento in order_
+    uint32_t count;
+    uint32_t cursor;  // Parole già proposte nel giro corrente
+  };
+
+  static uint32_t KeyFor(const LexiconEntry& entry);
+  static bool Matches(uint32_t key, const WordQuery& query);
+
+  void Shuffle(Bucket* bucket);
+  uint64_t NextRandom();
+
+  std::vector<Bucket> buckets_;
+  std::vector<uint32_t> order_;
+  std::vector<uint32_t> keys_;  // Chiave del bucket di ogni voce del lessico
+  uint32_t fingerprint_ = 0;
+  uint64_t rng_state_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_CONTENT_INDEX_H_
@@ -0,0 +1,262 @@
+// linux/native/content_pack.cc
+
+#include "content_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace opendsa {
+
+namespace {
+
+bool IsBlank(std::string_view line) {
+  return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+std::string_view TrimRight(std::string_view line) {
+  const size_t end = line.find_last_not_of(" \t\r");
+  return end == std::string_view::npos ? std::string_view()
+                                       : line.substr(0, end + 1);
+}
+
+// Righe vuote che separano due pagine.
+int SeparatorBlankLines(ContentSplit split) {
+  switch (split) {
+    case ContentSplit::kLines:
+      return 0;
+    case ContentSplit::kParagraphs:
+      return 1;
+    case ContentSplit::kPages:
+      return 2;
+  }
+  return 0;
+}
+
+}  // namespace
+
+bool ContentPackBuilder::Add(std::string_view page) {
+  if (page.empty() || page.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  ContentPackPage entry = {};
+  entry.offset = data_.size();
+  entry.length = static_cast<uint32_t>(page.size());
+  pages_.push_back(entry);
+  data_.append(page);
+  return true;
+}
+
+size_t ContentPackBuilder::AddText(std::string_view text, ContentSplit split) {
+  const int separator = SeparatorBlankLines(split);
+  const size_t before = pages_.size();
+  std::string page;
+  int blank_lines = 0;
+
+  while (!text.empty()) {
+    const size_t end = text.find('\n');
+    const std::string_view line = text.substr(0, end);
+    text = end == std::string_view::npos ? std::string_view()
+                                         : text.substr(end + 1);
+    if (IsBlank(line)) {
+      blank_lines++;
+      continue;
+    }
+    if (!page.empty()) {
+      if (blank_lines >= separator) {
+        Add(page);
+        page.clear();
+      } else {
+        page.append(static_cast<size_t>(blank_lines) + 1, '\n');
+      }
+    }
+    page.append(TrimRight(line));
+    blank_lines = 0;
+  }
+  if (!page.empty()) Add(page);
+  return pages_.size() - before;
+}
+
+std::string ContentPackBuilder::Build(uint32_t block_size) {
+  if (block_size == 0) block_size = kContentPackBlockSize;
+  const size_t block_count = (data_.size() + block_size - 1) / block_size;
+
+  std::vector<ContentPackBlock> blocks(block_count);
+  std::string compressed;
+  std::string packed;
+  const auto* text = reinterpret_cast<const uint8_t*>(data_.data());
+  for (size_t i = 0; i < block_count; i++) {
+    const size_t begin = i * block_size;
+    const size_t raw_size = std::min<size_t>(block_size, data_.size() - begin);
+    compressed.clear();
+    compressor_.Compress(text + begin, raw_size, &compressed);
+    blocks[i].offset = packed.size();
+    blocks[i].raw_size = static_cast<uint32_t>(raw_size);
+    if (compressed.size() < raw_size) {
+      blocks[i].size = static_cast<uint32_t>(compressed.size());
+      packed.append(compressed);
+    } else {
+      blocks[i].size = static_cast<uint32_t>(raw_size);
+      packed.append(data_, begin, raw_size);
+    }
+  }
+
+  ContentPackHeader header = {};
+  std::memcpy(header.magic, kContentPackMagic, sizeof(header.magic));
+  header.version = kContentPackVersion;
+  header.page_count = static_cast<uint32_t>(pages_.size());
+  header.block_count = static_cast<uint32_t>(block_count);
+  header.block_size = block_size;
+  header.text_size = data_.size();
+  header.index_offset = sizeof(ContentPackHeader);
+  header.blocks_offset =
+      header.index_offset + pages_.size() * sizeof(ContentPackPage);
+  header.data_offset =
+      header.blocks_offset + blocks.size() * sizeof(ContentPackBlock);
+  header.data_size = packed.size();
+
+  std::string out;
+  out.reserve(header.data_offset + packed.size());
+  out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.append(reinterpret_cast<const char*>(pages_.data()),
+             pages_.size() * sizeof(ContentPackPage));
+  out.append(reinterpret_cast<const char*>(blocks.data()),
+             blocks.size() * sizeof(ContentPackBlock));
+  out.append(packed);
+  return out;
+}
+
+bool ContentPack::Open(const std::string& path, size_t cached_pages,
+                       size_t cached_blocks) {
+  header_ = nullptr;
+  pages_ = nullptr;
+  blocks_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+  page_cache_.Clear();
+  page_cache_.set_capacity(cached_pages);
+  block_cache_.Clear();
+  block_cache_.set_capacity(cached_blocks);
+  if (!file_.Open(path) || file_.size() < sizeof(ContentPackHeader)) {
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const ContentPackHeader*>(file_.data());
+  const uint64_t file_size = file_.size();
+  // Gli indici devono stare nel file e i blocchi coprire tutto il testo
+  auto fits = [file_size](uint64_t offset, uint64_t size) {
+    return offset <= file_size && size <= file_size - offset;
+  };
+  if (std::memcmp(header->magic, kContentPackMagic,
+                  sizeof(kContentPackMagic)) != 0 ||
+      header->version != kContentPackVersion || header->block_size == 0 ||
+      header->index_offset % alignof(ContentPackPage) != 0 ||
+      header->blocks_offset % alignof(ContentPackBlock) != 0 ||
+      !fits(header->index_offset,
+            uint64_t{header->page_count} * sizeof(ContentPackPage)) ||
+      !fits(header->blocks_offset,
+            uint64_t{header->block_count} * sizeof(ContentPackBlock)) ||
+      !fits(header->data_offset, header->data_size) ||
+      (header->text_size + header->block_size - 1) / header->block_size !=
+          header->block_count) {
+    file_.Close();
+    return false;
+  }
+
+  const auto* pages = reinterpret_cast<const ContentPackPage*>(
+      file_.data() + header->index_offset);
+  for (uint32_t i = 0; i < header->page_count; i++) {
+    if (pages[i].offset > header->text_size ||
+        pages[i].length > header->text_size - pages[i].offset) {
+      file_.Close();
+      return false;
+    }
+  }
+  const auto* blocks = reinterpret_cast<const ContentPackBlock*>(
+      file_.data() + header->blocks_offset);
+  for (uint32_t i = 0; i < header->block_count; i++) {
+    const uint64_t expected_raw = std::min<uint64_t>(
+        header->block_size, header->text_size - uint64_t{i} * header->block_size);
+    if (blocks[i].raw_size != expected_raw || blocks[i].size > blocks[i].raw_size ||
+        blocks[i].offset > header->data_size ||
+        blocks[i].size > header->data_size - blocks[i].offset) {
+      file_.Close();
+      return false;
+    }
+  }
+
+  header_ = header;
+  pages_ = pages;
+  blocks_ = blocks;
+  data_ = file_.data() + header->data_offset;
+  size_ = header->page_count;
+  return true;
+}
+
+const std::vector<uint8_t>* ContentPack::Block(uint32_t index) {
+  const ContentPackBlock& block = blocks_[index];
+  if (const std::vector<uint8_t>* cached = block_cache_.Find(index)) {
+    return cached->size() == block.raw_size ? cached : nullptr;
+  }
+  std::vector<uint8_t>& buffer = block_cache_.Insert(index);
+  buffer.resize(block.raw_size);
+  const uint8_t* source = data_ + block.offset;
+  if (block.size == block.raw_size) {
+    std::memcpy(buffer.data(), source, block.raw_size);
+  } else if (!DecompressBlock(source, block.size, buffer.data(),
+                              block.raw_size)) {
+    // Il buffer resta in cache: lo si svuota perché non venga scambiato per
+    // un blocco valido
+    buffer.clear();
+    return nullptr;
+  }
+  return &buffer;
+}
+
+std::string_view ContentPack::Page(uint32_t index) {
+  if (index >= size_ || pages_[index].length == 0) return {};
+  const ContentPackPage& page = pages_[index];
+  const uint32_t block_size = header_->block_size;
+  const auto first = static_cast<uint32_t>(page.offset / block_size);
+  const auto last =
+      static_cast<uint32_t>((page.offset + page.length - 1) / block_size);
+  const size_t skip = page.offset - uint64_t{first} * block_size;
+
+  if (first == last) {
+    const std::vector<uint8_t>* block = Block(first);
+    if (block == nullptr || block->size() < skip + page.length) return {};
+    return {reinterpret_cast<const char*>(block->data()) + skip, page.length};
+  }
+
+  // Pagina a cavallo di più blocchi: viene ricomposta nel buffer
+  page_buffer_.clear();
+  for (uint32_t i = first; i <= last; i++) {
+    const std::vector<uint8_t>* block = Block(i);
+    if (block == nullptr) return {};
+    const size_t begin = i == first ? skip : 0;
+    const size_t count =
+        std::min(block->size() - begin, page.length - page_buffer_.size());
+    page_buffer_.append(reinterpret_cast<const char*>(block->data()) + begin,
+                        count);
+  }
+  return page_buffer_;
+}
+
+std::shared_ptr<const TokenizedText> ContentPack::Tokens(uint32_t index) {
+  if (index >= size_) return nullptr;
+  if (std::shared_ptr<TokenizedText>* cached = page_cache_.Find(index)) {
+    return *cached;
+  }
+
+  const std::string_view text = Page(index);
+  if (text.empty()) return nullptr;
+  // Il testo scartato dalla cache viene riusato se nessuno lo tiene più
+  std::shared_ptr<TokenizedText>& slot = page_cache_.Insert(index);
+  if (slot == nullptr || slot.use_count() > 1) {
+    slot = std::make_shared<TokenizedText>();
+  }
+  tokenizer_.Tokenize(text, slot.get());
+  return slot;
+}
+
+}  // namespace opendsa
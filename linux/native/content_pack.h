@@ -0,0 +1,163 @@
+// linux/native/content_pack.h
+
+#ifndef OPENDSA_NATIVE_CONTENT_PACK_H_
+#define OPENDSA_NATIVE_CONTENT_PACK_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "block_codec.h"
+#include "lru_cache.h"
+#include "mapped_file.h"
+#include "tokenizer.h"
+
+namespace opendsa {
+
+// Pacchetto di contenuti di lettura (pagine o paragrafi), generato durante
+// la build da tools/build_content_pack.cc. Il file viene mappato in memoria:
+// l'apertura legge solo l'intestazione e gli indici, una pagina si
+// raggiunge in tempo costante e viene suddivisa in token solo quando serve.
+// Avvio e memoria non dipendono quindi dalla dimensione del corpus.
+//
+// Il testo delle pagine, concatenato, è diviso in blocchi di block_size
+// byte compressi indipendentemente (block_codec.h): leggere una pagina
+// decomprime solo i blocchi che tocca.
+//
+// Layout (little-endian):
+//   ContentPackHeader                  64 byte
+//   ContentPackPage[page_count]        indice delle pagine
+//   ContentPackBlock[block_count]      indice dei blocchi
+//   blocchi compressi
+
+constexpr char kContentPackMagic[8] = {'O', 'D', 'S', 'A', 'P', 'A', 'K', '\0'};
+constexpr uint32_t kContentPackVersion = 2;
+
+// Dimensione predefinita dei blocchi: abbastanza grandi da comprimere bene,
+// abbastanza piccoli da decomprimerne uno in pochi microsecondi.
+constexpr uint32_t kContentPackBlockSize = 16 * 1024;
+
+struct ContentPackHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t page_count;
+  uint32_t block_count;
+  uint32_t block_size;     // Byte di testo per blocco (l'ultimo può averne meno)
+  uint64_t text_size;      // Testo non compresso
+  uint64_t index_offset;   // ContentPackPage[page_count]
+  uint64_t blocks_offset;  // ContentPackBlock[block_count]
+  uint64_t data_offset;    // Primo blocco compresso
+  uint64_t data_size;
+};
+
+struct ContentPackPage {
+  uint64_t offset;  // Offset nel testo non compresso
+  uint32_t length;  // Lunghezza in byte
+  uint32_t reserved;
+};
+
+struct ContentPackBlock {
+  uint64_t offset;      // Offset del blocco compresso, relativo a data_offset
+  uint32_t size;        // Byte compressi; uguale a raw_size se non compresso
+  uint32_t raw_size;
+};
+
+static_assert(sizeof(ContentPackHeader) == 64,
+              "ContentPackHeader deve restare 64 byte");
+static_assert(sizeof(ContentPackPage) == 16,
+              "ContentPackPage deve restare 16 byte");
+static_assert(sizeof(ContentPackBlock) == 16,
+              "ContentPackBlock deve restare 16 byte");
+
+// Modalità di divisione di un file di testo in pagine del pacchetto.
+enum class ContentSplit {
+  kLines,       // Una pagina per riga (sentences.txt)
+  kParagraphs,  // Pagine separate da una riga vuota (paragraphs.txt)
+  kPages,       // Pagine separate da due righe vuote (pages.txt)
+};
+
+// Costruisce un pacchetto. Usato dallo strumento di build, non
+// dall'applicazione.
+class ContentPackBuilder {
+ public:
+  // Aggiunge una pagina. Restituisce false se è vuota o oltre i 4 GiB.
+  bool Add(std::string_view page);
+
+  // Divide |text| secondo |split| e aggiunge le pagine non vuote, senza gli
+  // spazi in fondo alle righe. Le righe vuote interne a una pagina restano,
+  // così il Tokenizer ne riconosce i paragrafi. Restituisce le pagine aggiunte.
+  size_t AddText(std::string_view text, ContentSplit split);
+
+  // Serializza il pacchetto nel formato descritto sopra, comprimendo il
+  // testo in blocchi di |block_size| byte. I blocchi che non si riducono
+  // vengono salvati così come sono.
+  std::string Build(uint32_t block_size = kContentPackBlockSize);
+
+  size_t size() const { return pages_.size(); }
+  size_t text_size() const { return data_.size(); }
+
+ private:
+  std::vector<ContentPackPage> pages_;
+  std::string data_;
+  BlockCompressor compressor_;
+};
+
+// Lettore di un pacchetto mappato in memoria, con una cache LRU dei blocchi
+// decompressi e una delle pagine già suddivise in token. I buffer dei
+// blocchi scartati vengono riusati: a regime la lettura non alloca.
+//
+// Non è thread-safe: le cache vengono aggiornate anche dalle letture.
+class ContentPack {
+ public:
+  static constexpr size_t kDefaultCachedPages = 16;
+  static constexpr size_t kDefaultCachedBlocks = 8;
+
+  // Mappa e valida il file. |cached_pages| limita le pagine tenute in
+  // memoria già suddivise in token, |cached_blocks| i blocchi decompressi.
+  // Restituisce false se il file manca, è troncato o ha un formato diverso
+  // da quello atteso.
+  bool Open(const std::string& path,
+            size_t cached_pages = kDefaultCachedPages,
+            size_t cached_blocks = kDefaultCachedBlocks);
+
+  uint32_t size() const { return size_; }
+
+  // Testo della pagina |index|, decomprimendo solo i blocchi che tocca.
+  // Resta valido fino alla chiamata successiva; vuoto se l'indice non è
+  // valido o un blocco è corrotto.
+  std::string_view Page(uint32_t index);
+
+  // Token della pagina |index|, calcolati alla prima richiesta. Il
+  // risultato resta valido anche dopo l'uscita della pagina dalla cache;
+  // null se l'indice non è valido o la pagina non è leggibile.
+  std::shared_ptr<const TokenizedText> Tokens(uint32_t index);
+
+  const LruCache<uint32_t, std::shared_ptr<TokenizedText>>& page_cache() const {
+    return page_cache_;
+  }
+  const LruCache<uint32_t, std::vector<uint8_t>>& block_cache() const {
+    return block_cache_;
+  }
+
+ private:
+  // Blocco |index| decompresso, dalla cache o decompresso ora; null se
+  // corrotto.
+  const std::vector<uint8_t>* Block(uint32_t index);
+
+  MappedFile file_;
+  const ContentPackHeader* header_ = nullptr;
+  const ContentPackPage* pages_ = nullptr;
+  const ContentPackBlock* blocks_ = nullptr;
+  const uint8_t* data_ = nullptr;
+  uint32_t size_ = 0;
+  std::string page_buffer_;  // Pagine a cavallo di più blocchi
+  Tokenizer tokenizer_;
+  LruCache<uint32_t, std::shared_ptr<TokenizedText>> page_cache_;
+  LruCache<uint32_t, std::vector<uint8_t>> block_cache_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_CONTENT_PACK_H_
@@ -0,0 +1,117 @@
+// linux/native/cost_matrix.cc
+
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+namespace {
+
+// Coppie confuse frequentemente, nello stesso orientamento di
+// TextSimilarity._commonConfusions: { letto, atteso }.
+constexpr char32_t kCommonConfusions[][2] = {
+    {'b', 'd'}, {'b', 'p'},  // Confusione tra b/d/p
+    {'d', 'b'}, {'d', 'q'},  // Confusione tra d/b/q
+    {'p', 'q'}, {'p', 'b'},  // Confusione tra p/q/b
+    {'q', 'p'}, {'q', 'd'},  // Confusione tra q/p/d
+    {'m', 'n'}, {'m', 'w'},  // Confusione tra m/n/w
+    {'n', 'm'},              // Confusione tra n/m
+    {'a', 'e'}, {'e', 'a'},  // Confusione tra a/e
+    {'s', 'z'}, {'z', 's'},  // Confusione tra s/z
+    {'f', 'v'}, {'v', 'f'},  // Confusione tra f/v
+    {'l', 'i'}, {'i', 'l'},  // Confusione tra l/i
+};
+
+// Le stesse coppie senza verso, nell'ordine di CommonConfusionPair.
+constexpr char32_t kConfusionPairs[kCommonConfusionPairs][2] = {
+    {'b', 'd'}, {'b', 'p'}, {'d', 'q'}, {'p', 'q'}, {'m', 'n'},
+    {'m', 'w'}, {'a', 'e'}, {'s', 'z'}, {'f', 'v'}, {'l', 'i'},
+};
+
+// Lettere accentate e simboli fonetici con una classe dedicata.
+constexpr struct {
+  char32_t cp;
+  int char_class;
+} kExtraClasses[] = {
+    {0xE0, 39},   // à
+    {0xE8, 40},   // è
+    {0xE9, 41},   // é
+    {0xEC, 42},   // ì
+    {0xED, 43},   // í
+    {0xEE, 44},   // î
+    {0xF2, 45},   // ò
+    {0xF3, 46},   // ó
+    {0xF9, 47},   // ù
+    {0xFA, 48},   // ú
+    {0xF1, 49},   // ñ, anche codice fonetico di "gn"
+    {0xE7, 50},   // ç
+    {0x28E, 51},  // ʎ, codice fonetico di "gl"
+    {0x283, 52},  // ʃ, codice fonetico di "sc"
+};
+
+struct ClassTable {
+  unsigned char latin1[256];
+
+  constexpr ClassTable() : latin1() {
+    latin1[static_cast<unsigned char>(' ')] = 1;
+    for (int c = 'a'; c <= 'z'; c++) latin1[c] = static_cast<unsigned char>(2 + c - 'a');
+    for (int c = '0'; c <= '9'; c++) latin1[c] = static_cast<unsigned char>(28 + c - '0');
+    latin1[static_cast<unsigned char>('_')] = 38;
+    for (const auto& extra : kExtraClasses) {
+      if (extra.cp < 256) {
+        latin1[extra.cp] = static_cast<unsigned char>(extra.char_class);
+      }
+    }
+  }
+};
+
+constexpr ClassTable kClassTable;
+
+CostMatrix BuildDefault() {
+  CostMatrix matrix;
+  for (const auto& pair : kCommonConfusions) {
+    matrix.set_cell(CharClass(pair[1]), CharClass(pair[0]), kConfusionCost);
+  }
+  return matrix;
+}
+
+}  // namespace
+
+int CharClass(char32_t cp) {
+  if (cp < 256) return kClassTable.latin1[cp];
+  if (cp == 0x28E) return 51;
+  if (cp == 0x283) return 52;
+  return 0;
+}
+
+bool IsCommonConfusion(char32_t recognized, char32_t expected) {
+  for (const auto& pair : kCommonConfusions) {
+    if (pair[0] == recognized && pair[1] == expected) return true;
+  }
+  return false;
+}
+
+int CommonConfusionPair(char32_t a, char32_t b) {
+  for (int i = 0; i < kCommonConfusionPairs; i++) {
+    const char32_t* pair = kConfusionPairs[i];
+    if ((pair[0] == a && pair[1] == b) || (pair[0] == b && pair[1] == a)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+CostMatrix::CostMatrix() {
+  cells_.fill(kDefaultSubstitutionCost);
+}
+
+const CostMatrix& CostMatrix::Default() {
+  static const CostMatrix matrix = BuildDefault();
+  return matrix;
+}
+
+const CostMatrix& CostMatrix::Plain() {
+  static const CostMatrix matrix;
+  return matrix;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,77 @@
+// linux/native/cost_matrix.h
+
+#ifndef OPENDSA_NATIVE_COST_MATRIX_H_
+#define OPENDSA_NATIVE_COST_MATRIX_H_
+
+#include <array>
+#include <cstdint>
+
+namespace opendsa {
+
+// Numero di classi di caratteri: lettere, vocali accentate, cifre e i simboli
+// del codice fonetico. Tutto il resto ricade nella classe 0.
+constexpr int kNumCharClasses = 64;
+
+// Unità dei costi in virgola fissa: 1.0 corrisponde a kCostUnit.
+constexpr int32_t kCostUnit = 256;
+
+// Costi standard, equivalenti a quelli di TextSimilarity.
+constexpr uint16_t kDefaultSubstitutionCost = 2 * kCostUnit;
+constexpr uint16_t kConfusionCost = kCostUnit;
+constexpr uint16_t kDefaultIndelCost = kCostUnit;
+constexpr uint16_t kDefaultTranspositionCost = kCostUnit;
+
+// Restituisce la classe (0..63) di un code point già normalizzato.
+int CharClass(char32_t cp);
+
+// Verifica se la coppia (letto, atteso) appartiene alle confusioni tipiche
+// della dislessia (b/d/p/q, m/n/w, a/e, s/z, f/v, l/i).
+bool IsCommonConfusion(char32_t recognized, char32_t expected);
+
+// Numero di coppie non ordinate fra le confusioni comuni.
+constexpr int kCommonConfusionPairs = 10;
+
+// Indice (0..kCommonConfusionPairs-1) della coppia {a, b} fra le confusioni
+// comuni, in un verso o nell'altro; -1 se non ne fa parte.
+int CommonConfusionPair(char32_t a, char32_t b);
+
+// Tabella densa dei costi di sostituzione fra classi di caratteri.
+// Le righe sono indicizzate dal carattere atteso, le colonne da quello letto.
+class CostMatrix {
+ public:
+  CostMatrix();
+
+  // Tabella con le confusioni comuni a costo ridotto.
+  static const CostMatrix& Default();
+
+  // Tabella senza confusioni, usata per il confronto fonetico.
+  static const CostMatrix& Plain();
+
+  int32_t Substitution(char32_t expected, char32_t recognized) const {
+    if (expected == recognized) return 0;
+    return cells_[CharClass(expected) * kNumCharClasses +
+                  CharClass(recognized)];
+  }
+
+  uint16_t cell(int expected_class, int recognized_class) const {
+    return cells_[expected_class * kNumCharClasses + recognized_class];
+  }
+
+  void set_cell(int expected_class, int recognized_class, uint16_t cost) {
+    cells_[expected_class * kNumCharClasses + recognized_class] = cost;
+  }
+
+  int32_t insertion() const { return insertion_; }
+  int32_t deletion() const { return deletion_; }
+  int32_t transposition() const { return transposition_; }
+
+ private:
+  std::array<uint16_t, kNumCharClasses * kNumCharClasses> cells_;
+  uint16_t insertion_ = kDefaultIndelCost;
+  uint16_t deletion_ = kDefaultIndelCost;
+  uint16_t transposition_ = kDefaultTranspositionCost;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_COST_MATRIX_H_
@@ -0,0 +1,51 @@
+// linux/native/crc32.cc
+
+#include "crc32.h"
+
+#include <array>
+
+namespace opendsa {
+
+namespace {
+
+// Tabelle per l'algoritmo slice-by-4: quattro byte per iterazione
+using CrcTables = std::array<std::array<uint32_t, 256>, 4>;
+
+constexpr CrcTables MakeTables() {
+  CrcTables tables = {};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xEDB88320u : 0);
+    }
+    tables[0][i] = crc;
+  }
+  for (uint32_t i = 0; i < 256; i++) {
+    for (size_t t = 1; t < tables.size(); t++) {
+      const uint32_t previous = tables[t - 1][i];
+      tables[t][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr CrcTables kTables = MakeTables();
+
+}  // namespace
+
+uint32_t Crc32(const void* data, size_t size, uint32_t crc) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  while (size >= 4) {
+    crc ^= uint32_t{p[0]} | (uint32_t{p[1]} << 8) | (uint32_t{p[2]} << 16) |
+           (uint32_t{p[3]} << 24);
+    crc = kTables[3][crc & 0xFF] ^ kTables[2][(crc >> 8) & 0xFF] ^
+          kTables[1][(crc >> 16) & 0xFF] ^ kTables[0][crc >> 24];
+    p += 4;
+    size -= 4;
+  }
+  while (size-- > 0) crc = (crc >> 8) ^ kTables[0][(crc ^ *p++) & 0xFF];
+  return ~crc;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,17 @@
+// linux/native/crc32.h
+
+#ifndef OPENDSA_NATIVE_CRC32_H_
+#define OPENDSA_NATIVE_CRC32_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace opendsa {
+
+// CRC-32 (polinomio 0xEDB88320, lo stesso di zlib e PNG) di |size| byte.
+// Per calcolarlo a pezzi si passa come |crc| il risultato precedente.
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_CRC32_H_
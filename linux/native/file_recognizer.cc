@@ -0,0 +1,397 @@
+// linux/native/file_recognizer.cc
+
+#include "file_recognizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+#include "file_utils.h"
+#include "resampler.h"
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kSampleFrequencyOption[] = "--sample-frequency=";
+constexpr int kMaxJsonDepth = 32;
+
+// Lettore del JSON prodotto da libvosk: estrae testo e parole e salta gli
+// altri campi (alternative, speaker, ...).
+class VoskJsonReader {
+ public:
+  explicit VoskJsonReader(std::string_view json) : json_(json) {}
+
+  bool ReadResult(FileRecognition* out) {
+    std::string text;
+    std::vector<RecognizedWord> words;
+    if (!ReadObject([&](const std::string& key) {
+          if (key == "text") return ReadString(&text);
+          if (key == "result") return ReadWords(&words);
+          return SkipValue(0);
+        })) {
+      return false;
+    }
+    SkipSpace();
+    if (position_ != json_.size()) return false;
+    if (!text.empty()) {
+      if (!out->text.empty()) out->text += ' ';
+      out->text += text;
+    }
+    out->words.insert(out->words.end(),
+                      std::make_move_iterator(words.begin()),
+                      std::make_move_iterator(words.end()));
+    return true;
+  }
+
+ private:
+  void SkipSpace() {
+    while (position_ < json_.size() &&
+           (json_[position_] == ' ' || json_[position_] == '\n' ||
+            json_[position_] == '\r' || json_[position_] == '\t')) {
+      ++position_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipSpace();
+    if (position_ >= json_.size() || json_[position_] != c) return false;
+    ++position_;
+    return true;
+  }
+
+  bool Peek(char c) {
+    SkipSpace();
+    return position_ < json_.size() && json_[position_] == c;
+  }
+
+  // Chiama |field| per ogni chiave dell'oggetto, con la posizione sul
+  // valore
+  template <typename Field>
+  bool ReadObject(Field field) {
+    if (!Consume('{')) return false;
+    if (Consume('}')) return true;
+    do {
+      std::string key;
+      if (!ReadString(&key) || !Consume(':') || !field(key)) return false;
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+  bool ReadWords(std::vector<RecognizedWord>* words) {
+    if (!Consume('[')) return false;
+    if (Consume(']')) return true;
+    do {
+      RecognizedWord word;
+      if (!ReadObject([&](const std::string& key) {
+            if (key == "word") return ReadString(&word.word);
+            if (key == "start") return ReadNumber(&word.start);
+            if (key == "end") return ReadNumber(&word.end);
+            if (key == "conf") return ReadNumber(&word.confidence);
+            return SkipValue(0);
+          })) {
+        return false;
+      }
+      words->push_back(std::move(word));
+    } while (Consume(','));
+    return Consume(']');
+  }
+
+  bool ReadHex4(uint32_t* value) {
+    if (json_.size() - position_ < 4) return false;
+    *value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const char c = json_[position_++];
+      *value <<= 4;
+      if (c >= '0' && c <= '9') {
+        *value |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        *value |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        *value |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ReadString(std::string* out) {
+    if (!Consume('"')) return false;
+    out->clear();
+    while (position_ < json_.size()) {
+      const char c = json_[position_++];
+      if (c == '"') return true;
+      if (c != '\\') {
+        out->push_back(c);
+        continue;
+      }
+      if (position_ >= json_.size()) return false;
+      const char escape = json_[position_++];
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          out->push_back(escape);
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t cp;
+          if (!ReadHex4(&cp)) return false;
+          // Coppia surrogata per i caratteri oltre il piano di base
+          if (cp >= 0xD800 && cp <= 0xDBFF &&
+              json_.substr(position_, 2) == "\\u") {
+            position_ += 2;
+            uint32_t low;
+            if (!ReadHex4(&low) || low < 0xDC00 || low > 0xDFFF) return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(static_cast<char32_t>(cp), out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  bool ReadNumber(double* value) {
+    SkipSpace();
+    const size_t start = position_;
+    while (position_ < json_.size() &&
+           std::string_view("+-0123456789.eE").find(json_[position_]) !=
+               std::string_view::npos) {
+      ++position_;
+    }
+    if (position_ == start) return false;
+    const std::string number(json_.substr(start, position_ - start));
+    char* end = nullptr;
+    *value = std::strtod(number.c_str(), &end);
+    return end == number.c_str() + number.size();
+  }
+
+  bool SkipValue(int depth) {
+    if (depth > kMaxJsonDepth) return false;
+    SkipSpace();
+    if (position_ >= json_.size()) return false;
+    switch (json_[position_]) {
+      case '"': {
+        std::string ignored;
+        return ReadString(&ignored);
+      }
+      case '{':
+        return ReadObject(
+            [&](const std::string&) { return SkipValue(depth + 1); });
+      case '[':
+        ++position_;
+        if (Consume(']')) return true;
+        do {
+          if (!SkipValue(depth + 1)) return false;
+        } while (Consume(','));
+        return Consume(']');
+      case 't':
+        return SkipLiteral("true");
+      case 'f':
+        return SkipLiteral("false");
+      case 'n':
+        return SkipLiteral("null");
+      default: {
+        double ignored;
+        return ReadNumber(&ignored);
+      }
+    }
+  }
+
+  bool SkipLiteral(std::string_view literal) {
+    if (json_.substr(position_, literal.size()) != literal) return false;
+    position_ += literal.size();
+    return true;
+  }
+
+  std::string_view json_;
+  size_t position_ = 0;
+};
+
+}  // namespace
+
+bool ParseVoskResult(std::string_view json, FileRecognition* out) {
+  return VoskJsonReader(json).ReadResult(out);
+}
+
+SpeechModel::~SpeechModel() {
+  Wait();
+  if (model_ != nullptr) api_->model_free(model_);
+}
+
+void SpeechModel::Load(const std::string& dir) {
+  ready_ = std::async(std::launch::async, &SpeechModel::Read, this, dir);
+}
+
+bool SpeechModel::Wait() const { return ready_.valid() && ready_.get(); }
+
+bool SpeechModel::loaded() const {
+  return ready_.valid() && ready_.wait_for(std::chrono::seconds(0)) ==
+                               std::future_status::ready;
+}
+
+bool SpeechModel::Read(const std::string& dir) {
+  api_ = LoadVoskApi();
+  if (api_ == nullptr) return false;
+  // Frequenza delle caratteristiche MFCC del modello, se dichiarata
+  std::string conf;
+  if (ReadFile(dir + "/conf/mfcc.conf", &conf)) {
+    const size_t option = conf.find(kSampleFrequencyOption);
+    if (option != std::string::npos) {
+      const long rate = std::strtol(
+          conf.c_str() + option + sizeof(kSampleFrequencyOption) - 1, nullptr,
+          10);
+      if (rate > 0) sample_rate_ = static_cast<uint32_t>(rate);
+    }
+  }
+  model_ = api_->model_new(dir.c_str());
+  return model_ != nullptr;
+}
+
+FileRecognizer::~FileRecognizer() {
+  if (recognizer_ != nullptr) api_->recognizer_free(recognizer_);
+}
+
+bool FileRecognizer::Open(const SpeechModel& model) {
+  if (recognizer_ != nullptr) {
+    api_->recognizer_free(recognizer_);
+    recognizer_ = nullptr;
+  }
+  if (!model.Wait()) return false;
+  api_ = model.api();
+  sample_rate_ = model.sample_rate();
+  recognizer_ = api_->recognizer_new(model.handle(),
+                                     static_cast<float>(sample_rate_));
+  if (recognizer_ == nullptr) return false;
+  api_->recognizer_set_words(recognizer_, 1);
+  return true;
+}
+
+bool FileRecognizer::Recognize(const uint8_t* data, const WavInfo& info,
+                               const FileRecognitionOptions& options,
+                               FileRecognition* out,
+                               std::atomic<uint64_t>* progress) {
+  *out = FileRecognition();
+  if (recognizer_ == nullptr || info.channels == 0 || info.sample_rate == 0) {
+    return false;
+  }
+  const auto started = std::chrono::steady_clock::now();
+  api_->recognizer_reset(recognizer_);
+  out->sample_rate = info.sample_rate;
+  out->audio_seconds = static_cast<double>(info.frames) / info.sample_rate;
+
+  Resampler resampler(info.sample_rate, sample_rate_);
+  const size_t chunk = std::max<size_t>(
+      1, static_cast<uint64_t>(info.sample_rate) * options.chunk_ms / 1000);
+  std::vector<int16_t> pcm;
+  std::vector<int16_t> mono;
+  std::vector<int16_t> resampled;
+  for (uint64_t frame = 0; frame < info.frames; frame += chunk) {
+    ReadPcm16(data, info, frame, chunk, &pcm);
+    const size_t frames = pcm.size() / info.channels;
+    const std::vector<int16_t>* samples = &pcm;
+    if (info.channels > 1) {
+      mono.resize(frames);
+      for (size_t i = 0; i < frames; ++i) {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < info.channels; ++c) {
+          sum += pcm[i * info.channels + c];
+        }
+        mono[i] = static_cast<int16_t>(sum / info.channels);
+      }
+      samples = &mono;
+    }
+    resampled.clear();
+    resampler.Process(samples->data(), frames, &resampled);
+    if (!Feed(resampled, out)) return false;
+    if (progress != nullptr) {
+      progress->store(frame + frames, std::memory_order_release);
+    }
+  }
+  resampled.clear();
+  resampler.Flush(&resampled);
+  if (!Feed(resampled, out) ||
+      !ParseVoskResult(api_->recognizer_final_result(recognizer_), out)) {
+    return false;
+  }
+  out->elapsed_seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - started)
+                             .count();
+  return true;
+}
+
+bool FileRecognizer::RecognizeFile(const std::string& path,
+                                   const FileRecognitionOptions& options,
+                                   FileRecognition* out) {
+  MappedFile file;
+  WavInfo info;
+  if (!file.Open(path) || !ParseWav(file.data(), file.size(), &info)) {
+    *out = FileRecognition();
+    return false;
+  }
+  return Recognize(file.data(), info, options, out);
+}
+
+bool FileRecognizer::Feed(const std::vector<int16_t>& samples,
+                          FileRecognition* out) {
+  if (samples.empty()) return true;
+  const int status = api_->recognizer_accept_waveform_s(
+      recognizer_, samples.data(), static_cast<int>(samples.size()));
+  if (status < 0) return false;
+  // Una pausa ha chiuso una frase: il risultato va letto prima di
+  // proseguire
+  return status == 0 ||
+         ParseVoskResult(api_->recognizer_result(recognizer_), out);
+}
+
+FileRecognitionJob::~FileRecognitionJob() { Wait(); }
+
+bool FileRecognitionJob::Start(const SpeechModel* model,
+                               const std::string& path,
+                               const FileRecognitionOptions& options) {
+  if (model == nullptr || !file_.Open(path) ||
+      !ParseWav(file_.data(), file_.size(), &info_)) {
+    return false;
+  }
+  thread_ = std::thread(&FileRecognitionJob::Work, this, model, options);
+  return true;
+}
+
+bool FileRecognitionJob::Wait() {
+  if (thread_.joinable()) thread_.join();
+  return succeeded_;
+}
+
+void FileRecognitionJob::Work(const SpeechModel* model,
+                              FileRecognitionOptions options) {
+  FileRecognizer recognizer;
+  succeeded_ = recognizer.Open(*model) &&
+               recognizer.Recognize(file_.data(), info_, options, &result_,
+                                    &processed_);
+  // Anche in caso di errore il lavoro risulta terminato
+  processed_.store(info_.frames, std::memory_order_release);
+  done_.store(true, std::memory_order_release);
+}
+
+}  // namespace opendsa
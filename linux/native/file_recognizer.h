@@ -0,0 +1,186 @@
+// linux/native/file_recognizer.h
+
+#ifndef OPENDSA_NATIVE_FILE_RECOGNIZER_H_
+#define OPENDSA_NATIVE_FILE_RECOGNIZER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "mapped_file.h"
+#include "vosk_api.h"
+#include "wav_file.h"
+
+namespace opendsa {
+
+// Riconoscimento vocale di un file WAV registrato, senza passare dal
+// servizio di ascolto in tempo reale.
+//
+// Il file viene mappato in memoria e letto a blocchi di chunk_ms
+// millisecondi: ogni blocco viene ridotto a mono, convertito alla
+// frequenza del modello (Resampler) e passato a libvosk. Le frasi chiuse da
+// libvosk a ogni pausa e il risultato finale vengono uniti in un unico
+// testo, con l'intervallo e la confidenza di ogni parola.
+
+struct RecognizedWord {
+  std::string word;
+  double start = 0.0;  // Secondi dall'inizio del file
+  double end = 0.0;
+  double confidence = 0.0;
+};
+
+struct FileRecognition {
+  std::string text;
+  std::vector<RecognizedWord> words;
+  uint32_t sample_rate = 0;      // Frequenza del file
+  double audio_seconds = 0.0;    // Durata del file
+  double elapsed_seconds = 0.0;  // Tempo di elaborazione
+};
+
+// Aggiunge a |out| il testo e le parole di un risultato JSON di libvosk
+// ({"result": [{"conf", "end", "start", "word"}...], "text": ...}).
+// Restituisce false se |json| non ha questa forma.
+bool ParseVoskResult(std::string_view json, FileRecognition* out);
+
+// Modello di libvosk condiviso da più riconoscitori, anche su thread
+// diversi.
+class SpeechModel {
+ public:
+  // Frequenza dei modelli che non la dichiarano in conf/mfcc.conf
+  static constexpr uint32_t kDefaultSampleRate = 16000;
+
+  SpeechModel() = default;
+  ~SpeechModel();
+
+  SpeechModel(const SpeechModel&) = delete;
+  SpeechModel& operator=(const SpeechModel&) = delete;
+
+  // Avvia il caricamento del modello in |dir| su un thread e ritorna
+  // subito: il caricamento di un modello richiede anche qualche secondo.
+  // Va chiamata una sola volta.
+  void Load(const std::string& dir);
+
+  // Attende la fine del caricamento. Restituisce false se libvosk o il
+  // modello non sono disponibili.
+  bool Wait() const;
+
+  // Carica il modello e ne attende la fine.
+  bool Open(const std::string& dir) {
+    Load(dir);
+    return Wait();
+  }
+
+  // true a caricamento concluso, riuscito o meno.
+  bool loaded() const;
+
+  // Validi dopo un Wait() riuscito.
+  const VoskApi* api() const { return api_; }
+  VoskModel* handle() const { return model_; }
+  uint32_t sample_rate() const { return sample_rate_; }
+
+ private:
+  bool Read(const std::string& dir);
+
+  std::shared_future<bool> ready_;
+  const VoskApi* api_ = nullptr;
+  VoskModel* model_ = nullptr;
+  uint32_t sample_rate_ = kDefaultSampleRate;
+};
+
+struct FileRecognitionOptions {
+  // Audio passato a libvosk a ogni chiamata. Blocchi più lunghi riducono il
+  // costo fisso delle chiamate; oltre qualche centinaio di millisecondi il
+  // guadagno è trascurabile (vedi bench_vosk).
+  uint32_t chunk_ms = 200;
+};
+
+// Riconoscitore di file su un modello caricato. Non è thread-safe: per
+// riconoscere più file in parallelo serve un FileRecognizer per thread,
+// tutti sullo stesso SpeechModel.
+class FileRecognizer {
+ public:
+  FileRecognizer() = default;
+  ~FileRecognizer();
+
+  FileRecognizer(const FileRecognizer&) = delete;
+  FileRecognizer& operator=(const FileRecognizer&) = delete;
+
+  // Crea il riconoscitore su |model|, che deve restare aperto finché il
+  // riconoscitore è in uso. Restituisce false se il modello non è stato
+  // caricato.
+  bool Open(const SpeechModel& model);
+
+  // Riconosce i campioni del WAV |data| descritti da |info|. Se |progress|
+  // non è null vi scrive i frame già elaborati. Restituisce false se
+  // libvosk segnala un errore.
+  bool Recognize(const uint8_t* data, const WavInfo& info,
+                 const FileRecognitionOptions& options, FileRecognition* out,
+                 std::atomic<uint64_t>* progress = nullptr);
+
+  // Mappa e riconosce il WAV in |path|. Restituisce false anche se il file
+  // manca o non è un WAV PCM valido.
+  bool RecognizeFile(const std::string& path,
+                     const FileRecognitionOptions& options,
+                     FileRecognition* out);
+
+ private:
+  bool Feed(const std::vector<int16_t>& samples, FileRecognition* out);
+
+  const VoskApi* api_ = nullptr;
+  VoskRecognizer* recognizer_ = nullptr;
+  uint32_t sample_rate_ = 0;
+};
+
+// Riconoscimento di un file su un thread dedicato, per non bloccare il
+// chiamante. Start() ritorna subito dopo aver controllato il file;
+// l'avanzamento si legge con processed() e done() da qualunque thread e
+// Wait() attende il risultato.
+class FileRecognitionJob {
+ public:
+  FileRecognitionJob() = default;
+  ~FileRecognitionJob();
+
+  FileRecognitionJob(const FileRecognitionJob&) = delete;
+  FileRecognitionJob& operator=(const FileRecognitionJob&) = delete;
+
+  // Mappa il WAV in |path|, ne controlla l'intestazione e avvia il
+  // riconoscimento su |model|, attendendone prima il caricamento. Il
+  // modello deve restare aperto fino alla fine del lavoro. Restituisce
+  // false, senza avviare il thread, se il file non è un WAV PCM valido.
+  // Va chiamata una sola volta.
+  bool Start(const SpeechModel* model, const std::string& path,
+             const FileRecognitionOptions& options);
+
+  // Attende la fine del lavoro. Restituisce false se il riconoscimento non
+  // è riuscito.
+  bool Wait();
+
+  uint64_t frames() const { return info_.frames; }
+  uint64_t processed() const {
+    return processed_.load(std::memory_order_acquire);
+  }
+  // Vero quando anche il risultato finale è pronto (o il lavoro è fallito):
+  // da qui Wait() non blocca. processed() arriva a frames() prima, mentre
+  // libvosk calcola il risultato finale.
+  bool done() const { return done_.load(std::memory_order_acquire); }
+  const FileRecognition& result() const { return result_; }
+
+ private:
+  void Work(const SpeechModel* model, FileRecognitionOptions options);
+
+  MappedFile file_;
+  WavInfo info_;
+  FileRecognition result_;
+  bool succeeded_ = false;
+  std::atomic<uint64_t> processed_{0};
+  std::atomic<bool> done_{false};
+  std::thread thread_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_FILE_RECOGNIZER_H_
@@ -0,0 +1,76 @@
+// linux/native/file_utils.cc
+
+#include "file_utils.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+namespace opendsa {
+
+bool WriteAll(int fd, const void* buffer, size_t size) {
+  const auto* data = static_cast<const char*>(buffer);
+  while (size > 0) {
+    const ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool ReadFile(const std::string& path, std::string* out) {
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return false;
+  }
+
+  out->resize(static_cast<size_t>(info.st_size));
+  size_t offset = 0;
+  while (offset < out->size()) {
+    const ssize_t count = read(fd, &(*out)[offset], out->size() - offset);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) break;
+    offset += static_cast<size_t>(count);
+  }
+  out->resize(offset);
+  close(fd);
+  return true;
+}
+
+bool WriteFileAtomically(const std::string& path, const void* data,
+                         size_t size) {
+  const std::string temp_path = path + ".tmp";
+  const int fd =
+      open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) return false;
+
+  const bool written = WriteAll(fd, data, size) &&
+                       fsync(fd) == 0;
+  if (close(fd) != 0 || !written) {
+    unlink(temp_path.c_str());
+    return false;
+  }
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    unlink(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool FileExists(const std::string& path) {
+  struct stat info;
+  return stat(path.c_str(), &info) == 0;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,28 @@
+// linux/native/file_utils.h
+
+#ifndef OPENDSA_NATIVE_FILE_UTILS_H_
+#define OPENDSA_NATIVE_FILE_UTILS_H_
+
+#include <cstddef>
+#include <string>
+
+namespace opendsa {
+
+// Legge l'intero file in |out|. Restituisce false se il file non esiste o non
+// è leggibile.
+bool ReadFile(const std::string& path, std::string* out);
+
+// Scrive |size| byte in un file temporaneo accanto a |path|, esegue fsync e
+// lo rinomina sul file definitivo: chi legge vede il contenuto vecchio o
+// quello nuovo, mai uno parziale.
+bool WriteFileAtomically(const std::string& path, const void* data,
+                         size_t size);
+
+// Scrive tutti i |size| byte su |fd|, ripetendo le scritture parziali.
+bool WriteAll(int fd, const void* data, size_t size);
+
+bool FileExists(const std::string& path);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_FILE_UTILS_H_
@@ -0,0 +1,185 @@
+// linux/native/lexicon.cc
+
+#include "lexicon.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+std::string_view TrimSpaces(std::string_view text) {
+  while (!text.empty() && IsSpace(static_cast<unsigned char>(text.front()))) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && IsSpace(static_cast<unsigned char>(text.back()))) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+}  // namespace
+
+bool LexiconBuilder::Add(std::string_view word, int level) {
+  if (level < 1 || level > kLexiconLevels) return false;
+  word = TrimSpaces(word);
+  if (word.empty()) return true;
+
+  std::u32string decoded;
+  DecodeUtf8(word, &decoded);
+  std::string normalized;
+  for (char32_t& cp : decoded) {
+    cp = ToLower(cp);
+    AppendUtf8(cp, &normalized);
+  }
+  if (normalized.size() > std::numeric_limits<uint16_t>::max()) return false;
+
+  const WordFeatures features = syllabifier_.Analyze(decoded);
+  LexiconEntry entry = {};
+  entry.text_offset = Intern(normalized);
+  entry.text_bytes = static_cast<uint16_t>(normalized.size());
+  entry.length = static_cast<uint16_t>(decoded.size());
+  entry.syllables = static_cast<uint8_t>(std::min(features.syllables, 255));
+  entry.level = static_cast<uint8_t>(level);
+  entry.flags = features.flags;
+  entry.stress = static_cast<uint8_t>(std::min(features.stress, 255));
+  entry.orthographic_depth = features.orthographic_depth;
+
+  std::u32string phones;
+  phonemizer_.Phonemize(decoded, &phones);
+  std::string encoded;
+  for (const char32_t phone : phones) AppendUtf8(phone, &encoded);
+  if (encoded.size() > std::numeric_limits<uint16_t>::max()) return false;
+  LexiconPronunciation pronunciation = {};
+  pronunciation.offset = Intern(encoded);
+  pronunciation.bytes = static_cast<uint16_t>(encoded.size());
+  pronunciation.phones = static_cast<uint16_t>(phones.size());
+
+  entries_.push_back(entry);
+  pronunciations_.push_back(pronunciation);
+  return true;
+}
+
+uint32_t LexiconBuilder::Intern(const std::string& text) {
+  const auto found = interned_.find(text);
+  if (found != interned_.end()) return found->second;
+  const uint32_t offset = static_cast<uint32_t>(strings_.size());
+  strings_.append(text);
+  strings_.push_back('\0');
+  interned_.emplace(text, offset);
+  return offset;
+}
+
+std::string LexiconBuilder::Build() const {
+  // Le pronunce seguono le voci nell'ordinamento per livello
+  std::vector<uint32_t> order(entries_.size());
+  for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return entries_[a].level < entries_[b].level;
+  });
+  std::vector<LexiconEntry> entries(order.size());
+  std::vector<LexiconPronunciation> pronunciations(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    entries[i] = entries_[order[i]];
+    pronunciations[i] = pronunciations_[order[i]];
+  }
+
+  LexiconHeader header = {};
+  std::memcpy(header.magic, kLexiconMagic, sizeof(header.magic));
+  header.version = kLexiconVersion;
+  header.entry_count = static_cast<uint32_t>(entries.size());
+  header.entries_offset = sizeof(LexiconHeader);
+  header.pronunciations_offset = static_cast<uint32_t>(
+      header.entries_offset + entries.size() * sizeof(LexiconEntry));
+  header.strings_offset = static_cast<uint32_t>(
+      header.pronunciations_offset +
+      pronunciations.size() * sizeof(LexiconPronunciation));
+  header.strings_size = static_cast<uint32_t>(strings_.size());
+  for (uint32_t i = 0; i < entries.size(); i++) {
+    LexiconRange& range = header.levels[entries[i].level - 1];
+    if (range.count == 0) range.first = i;
+    range.count++;
+  }
+
+  std::string out;
+  out.reserve(header.strings_offset + strings_.size());
+  out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.append(reinterpret_cast<const char*>(entries.data()),
+             entries.size() * sizeof(LexiconEntry));
+  out.append(reinterpret_cast<const char*>(pronunciations.data()),
+             pronunciations.size() * sizeof(LexiconPronunciation));
+  out.append(strings_);
+  return out;
+}
+
+bool Lexicon::Open(const std::string& path) {
+  header_ = nullptr;
+  entries_ = nullptr;
+  pronunciations_ = nullptr;
+  strings_ = nullptr;
+  size_ = 0;
+  if (!file_.Open(path) || file_.size() < sizeof(LexiconHeader)) return false;
+
+  const auto* header = reinterpret_cast<const LexiconHeader*>(file_.data());
+  const uint64_t file_size = file_.size();
+  if (std::memcmp(header->magic, kLexiconMagic, sizeof(kLexiconMagic)) != 0 ||
+      header->version != kLexiconVersion ||
+      header->entries_offset % alignof(LexiconEntry) != 0 ||
+      header->entries_offset +
+              uint64_t{header->entry_count} * sizeof(LexiconEntry) >
+          file_size ||
+      header->pronunciations_offset % alignof(LexiconPronunciation) != 0 ||
+      header->pronunciations_offset +
+              uint64_t{header->entry_count} * sizeof(LexiconPronunciation) >
+          file_size ||
+      uint64_t{header->strings_offset} + header->strings_size > file_size) {
+    file_.Close();
+    return false;
+  }
+  for (const LexiconRange& range : header->levels) {
+    if (uint64_t{range.first} + range.count > header->entry_count) {
+      file_.Close();
+      return false;
+    }
+  }
+
+  const auto* entries = reinterpret_cast<const LexiconEntry*>(
+      file_.data() + header->entries_offset);
+  const auto* pronunciations = reinterpret_cast<const LexiconPronunciation*>(
+      file_.data() + header->pronunciations_offset);
+  const char* strings =
+      reinterpret_cast<const char*>(file_.data() + header->strings_offset);
+  // Ogni parola e ogni pronuncia devono stare nell'area delle stringhe ed
+  // essere terminate da zero: Dart le legge direttamente dalla mappatura
+  auto terminated = [&](uint32_t offset, uint16_t bytes) {
+    const uint64_t end = uint64_t{offset} + bytes;
+    return end < header->strings_size && strings[end] == '\0';
+  };
+  for (uint32_t i = 0; i < header->entry_count; i++) {
+    if (!terminated(entries[i].text_offset, entries[i].text_bytes) ||
+        !terminated(pronunciations[i].offset, pronunciations[i].bytes)) {
+      file_.Close();
+      return false;
+    }
+  }
+
+  header_ = header;
+  entries_ = entries;
+  pronunciations_ = pronunciations;
+  strings_ = strings;
+  size_ = header->entry_count;
+  return true;
+}
+
+LexiconRange Lexicon::level(int level) const {
+  if (header_ == nullptr || level < 1 || level > kLexiconLevels) {
+    return {0, 0};
+  }
+  return header_->levels[level - 1];
+}
+
+}  // namespace opendsa
@@ -0,0 +1,144 @@
+// linux/native/lexicon.h
+
+#ifndef OPENDSA_NATIVE_LEXICON_H_
+#define OPENDSA_NATIVE_LEXICON_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mapped_file.h"
+#include "phonemizer.h"
+#include "syllabifier.h"
+
+namespace opendsa {
+
+// Lessico binario precompilato dalle liste di parole degli esercizi
+// (easy/medium/hard_words.txt) durante la build. Il file viene mappato in
+// memoria così com'è: nessun parsing né allocazione all'avvio.
+//
+// Layout (little-endian):
+//   LexiconHeader                      64 byte
+//   LexiconEntry[entry_count]          ordinate per livello, poi come nei file
+//   LexiconPronunciation[entry_count]  pronuncia della voce con lo stesso indice
+//   stringhe UTF-8 terminate da zero   internate: le parole e le pronunce
+//                                      ripetute condividono lo stesso offset
+
+constexpr char kLexiconMagic[8] = {'O', 'D', 'S', 'A', 'L', 'E', 'X', '\0'};
+constexpr uint32_t kLexiconVersion = 3;
+
+// Livelli di esercizio serializzati (1 = parole facili ... 4).
+constexpr int kLexiconLevels = 4;
+
+struct LexiconRange {
+  uint32_t first;
+  uint32_t count;
+};
+
+struct LexiconHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t entries_offset;
+  uint32_t strings_offset;
+  uint32_t strings_size;
+  uint32_t pronunciations_offset;
+  LexiconRange levels[kLexiconLevels];  // levels[0] è il livello 1
+};
+
+struct LexiconEntry {
+  uint32_t text_offset;  // Offset della parola nell'area delle stringhe
+  uint16_t text_bytes;   // Lunghezza in byte, senza il terminatore
+  uint16_t length;       // Lunghezza in code point
+  uint8_t syllables;
+  uint8_t level;
+  uint16_t flags;        // kWord* (syllabifier.h)
+  uint8_t stress;        // Sillaba tonica contata dalla fine
+  uint8_t orthographic_depth;
+  uint16_t reserved;     // Riservato alle estensioni del formato
+};
+
+// Pronuncia attesa di una voce, calcolata dal Phonemizer in fase di build:
+// fonemi UTF-8 (phonemizer.h) nell'area delle stringhe, terminati da zero.
+struct LexiconPronunciation {
+  uint32_t offset;  // Offset nell'area delle stringhe
+  uint16_t bytes;   // Lunghezza in byte, senza il terminatore
+  uint16_t phones;  // Numero di fonemi
+};
+
+static_assert(sizeof(LexiconHeader) == 64, "LexiconHeader deve restare 64 byte");
+static_assert(sizeof(LexiconEntry) == 16, "LexiconEntry deve restare 16 byte");
+static_assert(sizeof(LexiconPronunciation) == 8,
+              "LexiconPronunciation deve restare 8 byte");
+
+// Costruisce il file del lessico. Usato dallo strumento di build
+// (tools/build_lexicon.cc), non dall'applicazione. Sillabe, accento e
+// caratteristiche ortografiche di ogni parola vengono calcolati qui con il
+// Syllabifier, la pronuncia con il Phonemizer, così l'applicazione li legge
+// senza analizzare le parole.
+class LexiconBuilder {
+ public:
+  // Aggiunge una parola del livello |level| (1..kLexiconLevels), normalizzata
+  // come ContentService._normalizeWord. Le righe vuote vengono ignorate.
+  // Restituisce false se il livello non è valido o la parola è troppo lunga.
+  bool Add(std::string_view word, int level);
+
+  // Serializza il lessico nel formato descritto sopra.
+  std::string Build() const;
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  uint32_t Intern(const std::string& text);
+
+  std::vector<LexiconEntry> entries_;
+  std::vector<LexiconPronunciation> pronunciations_;
+  std::string strings_;
+  std::unordered_map<std::string, uint32_t> interned_;
+  Syllabifier syllabifier_;
+  Phonemizer phonemizer_;
+};
+
+// Lettore del lessico mappato in memoria. Le voci e le stringhe puntano
+// direttamente nella mappatura e restano valide finché il lessico è aperto.
+class Lexicon {
+ public:
+  // Mappa e valida il file. Restituisce false se manca, è troncato o ha un
+  // formato diverso da quello atteso.
+  bool Open(const std::string& path);
+
+  uint32_t size() const { return size_; }
+  const LexiconEntry* entries() const { return entries_; }
+  const LexiconEntry& entry(uint32_t index) const { return entries_[index]; }
+  const char* strings() const { return strings_; }
+  const LexiconPronunciation* pronunciations() const { return pronunciations_; }
+
+  std::string_view text(uint32_t index) const {
+    return {strings_ + entries_[index].text_offset,
+            entries_[index].text_bytes};
+  }
+
+  // Pronuncia attesa della voce |index| (fonemi di phonemizer.h, UTF-8).
+  std::string_view pronunciation(uint32_t index) const {
+    return {strings_ + pronunciations_[index].offset,
+            pronunciations_[index].bytes};
+  }
+
+  // Intervallo di voci del livello |level| (1..kLexiconLevels); vuoto per
+  // livelli non validi.
+  LexiconRange level(int level) const;
+
+ private:
+  MappedFile file_;
+  const LexiconHeader* header_ = nullptr;
+  const LexiconEntry* entries_ = nullptr;
+  const LexiconPronunciation* pronunciations_ = nullptr;
+  const char* strings_ = nullptr;
+  uint32_t size_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_LEXICON_H_
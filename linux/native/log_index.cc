@@ -0,0 +1,194 @@
+// linux/native/log_index.cc
+
+#include "log_index.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// "AAAA-MM-GGTHH:MM:SS.mmm L"
+constexpr size_t kTimeLength = 23;
+
+constexpr char kLevelChars[] = {'D', 'I', 'W', 'E'};
+
+bool ParseDigits(std::string_view text, size_t offset, size_t count,
+                 int* out) {
+  int value = 0;
+  for (size_t i = offset; i < offset + count; ++i) {
+    if (text[i] < '0' || text[i] > '9') return false;
+    value = value * 10 + (text[i] - '0');
+  }
+  *out = value;
+  return true;
+}
+
+// Giorni dal 1970-01-01 di una data del calendario gregoriano (algoritmo di
+// Howard Hinnant)
+int64_t DaysFromCivil(int64_t year, int month, int day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t year_of_era = year - era * 400;
+  const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 +
+                              day - 1;
+  const int64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+uint32_t EntryCrc(const LogIndexEntry& entry) {
+  return Crc32(&entry, offsetof(LogIndexEntry, crc));
+}
+
+}  // namespace
+
+bool ParseLogLine(std::string_view line, LogLine* out) {
+  if (line.size() < kTimeLength + 2 || line[4] != '-' || line[7] != '-' ||
+      line[10] != 'T' || line[13] != ':' || line[16] != ':' ||
+      line[19] != '.' || line[kTimeLength] != ' ') {
+    return false;
+  }
+  int year, month, day, hour, minute, second, millis;
+  if (!ParseDigits(line, 0, 4, &year) || !ParseDigits(line, 5, 2, &month) ||
+      !ParseDigits(line, 8, 2, &day) || !ParseDigits(line, 11, 2, &hour) ||
+      !ParseDigits(line, 14, 2, &minute) ||
+      !ParseDigits(line, 17, 2, &second) ||
+      !ParseDigits(line, 20, 3, &millis) || month < 1 || month > 12) {
+    return false;
+  }
+  const char* level = static_cast<const char*>(
+      std::memchr(kLevelChars, line[kTimeLength + 1], sizeof(kLevelChars)));
+  if (level == nullptr) return false;
+
+  // Il token del livello finisce al primo spazio: "E" o "E@tag"
+  std::string_view rest = line.substr(kTimeLength + 2);
+  const size_t space = rest.find(' ');
+  std::string_view token = rest.substr(0, space);
+  if (!token.empty() && token[0] != '@') return false;
+  out->time_ms =
+      WallTimeMs(year, month, day, hour, minute, second, millis);
+  out->level = static_cast<uint8_t>(level - kLevelChars);
+  out->tag = token.empty() ? token : token.substr(1);
+  out->message =
+      space == std::string_view::npos ? std::string_view() : rest.substr(space + 1);
+  return true;
+}
+
+int64_t WallTimeMs(int year, int month, int day, int hour, int minute,
+                   int second, int millis) {
+  const int64_t days = DaysFromCivil(year, month, day);
+  return ((days * 24 + hour) * 60 + minute) * 60000 +
+         static_cast<int64_t>(second) * 1000 + millis;
+}
+
+std::string WallDate(int64_t time_ms) {
+  int64_t days = time_ms / 86400000;
+  if (time_ms % 86400000 < 0) days--;
+  // Inverso di DaysFromCivil
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t day_of_era = days - era * 146097;
+  const int64_t year_of_era = (day_of_era - day_of_era / 1460 +
+                               day_of_era / 36524 - day_of_era / 146096) /
+                              365;
+  const int64_t day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const int64_t mp = (5 * day_of_year + 2) / 153;
+  const int64_t day = day_of_year - (153 * mp + 2) / 5 + 1;
+  const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t year = year_of_era + era * 400 + (month <= 2);
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lld",
+                static_cast<long long>(year), static_cast<long long>(month),
+                static_cast<long long>(day));
+  return buffer;
+}
+
+uint64_t LogTagBits(std::string_view tag) {
+  if (tag.empty()) return 0;
+  const uint32_t hash = Crc32(tag.data(), tag.size());
+  return (uint64_t{1} << (hash & 63)) | (uint64_t{1} << ((hash >> 6) & 63));
+}
+
+void LogIndexBuilder::Add(std::string_view line, size_t size) {
+  if (current_.lines > 0 && current_.raw_size + size > block_size_) {
+    entries_.push_back(current_);
+    current_ = {};
+    current_.raw_offset = size_;
+  }
+  LogLine parsed;
+  if (ParseLogLine(line, &parsed)) {
+    const bool first = current_.levels == 0;
+    if (first || parsed.time_ms < current_.first_ms) {
+      current_.first_ms = parsed.time_ms;
+    }
+    if (first || parsed.time_ms > current_.last_ms) {
+      current_.last_ms = parsed.time_ms;
+    }
+    current_.levels |= static_cast<uint8_t>(1 << parsed.level);
+    current_.tags |= LogTagBits(parsed.tag);
+  }
+  current_.raw_size += static_cast<uint32_t>(size);
+  current_.lines++;
+  size_ += size;
+}
+
+void LogIndexBuilder::Clear() {
+  entries_.clear();
+  current_ = {};
+  size_ = 0;
+}
+
+std::vector<LogIndexEntry> LogIndexBuilder::Entries() const {
+  std::vector<LogIndexEntry> entries = entries_;
+  if (current_.lines > 0) entries.push_back(current_);
+  return entries;
+}
+
+bool WriteLogIndex(const std::string& path,
+                   const std::vector<LogIndexEntry>& entries) {
+  LogIndexHeader header = {};
+  std::memcpy(header.magic, kLogIndexMagic, sizeof(header.magic));
+  header.version = kLogIndexVersion;
+  std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (LogIndexEntry entry : entries) {
+    entry.crc = EntryCrc(entry);
+    data.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  }
+  return WriteFileAtomically(path, data.data(), data.size());
+}
+
+bool ReadLogIndex(const std::string& path, std::vector<LogIndexEntry>* out) {
+  out->clear();
+  std::string data;
+  if (!ReadFile(path, &data) || data.size() < sizeof(LogIndexHeader) ||
+      (data.size() - sizeof(LogIndexHeader)) % sizeof(LogIndexEntry) != 0) {
+    return false;
+  }
+  LogIndexHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kLogIndexMagic, sizeof(header.magic)) != 0 ||
+      header.version != kLogIndexVersion) {
+    return false;
+  }
+  const size_t count =
+      (data.size() - sizeof(LogIndexHeader)) / sizeof(LogIndexEntry);
+  out->resize(count);
+  std::memcpy(out->data(), data.data() + sizeof(LogIndexHeader),
+              count * sizeof(LogIndexEntry));
+  for (const LogIndexEntry& entry : *out) {
+    if (EntryCrc(entry) != entry.crc) {
+      out->clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,115 @@
+// linux/native/log_index.h
+
+#ifndef OPENDSA_NATIVE_LOG_INDEX_H_
+#define OPENDSA_NATIVE_LOG_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace opendsa {
+
+// Indice a blocchi dei segmenti di AsyncLogger.
+//
+// Il testo di un segmento è diviso in blocchi di righe intere di circa
+// kLogArchiveBlockSize byte (una riga più lunga forma un blocco da sola);
+// per ogni blocco l'indice tiene l'intervallo di tempo delle righe, i
+// livelli presenti e un filtro di Bloom a 64 bit dei tag di contesto. Le
+// interrogazioni leggono solo l'indice e decodificano i blocchi che possono
+// contenere righe valide.
+//
+// I tempi sono millisecondi dell'ora locale scritta nelle righe, contati
+// come se fosse UTC ("ora da parete"): non dipendono dal fuso con cui si
+// rilegge il log.
+//
+// Un segmento compresso <nome>.txt.lz ha accanto <nome>.txt.idx:
+//   LogIndexHeader                  16 byte
+//   LogIndexEntry[...]              64 byte ciascuna, con CRC
+// Il segmento corrente non ha file di indice: il logger tiene il suo in
+// memoria e lo ricostruisce all'apertura.
+constexpr char kLogIndexMagic[8] = {'O', 'D', 'S', 'A', 'L', 'O', 'G', 'I'};
+constexpr uint32_t kLogIndexVersion = 1;
+
+struct LogIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(LogIndexHeader) == 16,
+              "LogIndexHeader deve restare 16 byte");
+
+struct LogIndexEntry {
+  int64_t first_ms;         // Ora da parete della prima riga
+  int64_t last_ms;          // e dell'ultima
+  uint64_t raw_offset;      // Posizione nel testo del segmento
+  uint64_t archive_offset;  // Posizione del blocco nel file compresso
+  uint64_t tags;            // Filtro di Bloom dei tag (LogTagBits)
+  uint32_t raw_size;
+  uint32_t archive_size;    // Intestazione del blocco compresa
+  uint32_t lines;
+  uint8_t levels;           // Bit 1 << livello
+  uint8_t reserved[3];
+  uint32_t crc;             // CRC dei byte precedenti
+  uint32_t reserved2;
+};
+
+static_assert(sizeof(LogIndexEntry) == 64, "LogIndexEntry deve restare 64 byte");
+
+// Una riga del log scomposta: "AAAA-MM-GGTHH:MM:SS.mmm L[@tag] messaggio".
+struct LogLine {
+  int64_t time_ms = 0;  // Ora da parete
+  uint8_t level = 0;
+  std::string_view tag;
+  std::string_view message;
+};
+
+// Scompone |line| (senza '\n'). Restituisce false se non è una riga del
+// log.
+bool ParseLogLine(std::string_view line, LogLine* out);
+
+// Millisecondi da parete di una data e ora locali.
+int64_t WallTimeMs(int year, int month, int day, int hour, int minute,
+                   int second, int millis);
+
+// Data "AAAA-MM-GG" di un tempo da parete.
+std::string WallDate(int64_t time_ms);
+
+// Bit del filtro di Bloom di |tag| (nessuno per il tag vuoto).
+uint64_t LogTagBits(std::string_view tag);
+
+// Raccoglie le righe di un segmento in blocchi di indice.
+class LogIndexBuilder {
+ public:
+  explicit LogIndexBuilder(uint32_t block_size) : block_size_(block_size) {}
+
+  // Aggiunge una riga di |size| byte, '\n' compreso, che inizia alla fine
+  // delle precedenti. Le righe non valide entrano nel blocco senza
+  // cambiarne tempi, livelli e tag.
+  void Add(std::string_view line, size_t size);
+
+  void Clear();
+
+  // Blocchi completi più quello in corso.
+  std::vector<LogIndexEntry> Entries() const;
+
+  uint64_t size() const { return size_; }
+
+ private:
+  uint32_t block_size_;
+  std::vector<LogIndexEntry> entries_;
+  LogIndexEntry current_ = {};
+  uint64_t size_ = 0;
+};
+
+// Scrive e rilegge il file di indice di un segmento compresso. La lettura
+// restituisce false se il file manca o non è valido.
+bool WriteLogIndex(const std::string& path,
+                   const std::vector<LogIndexEntry>& entries);
+bool ReadLogIndex(const std::string& path, std::vector<LogIndexEntry>* out);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_LOG_INDEX_H_
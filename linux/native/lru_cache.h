@@ -0,0 +1,92 @@
+// linux/native/lru_cache.h
+
+#ifndef OPENDSA_NATIVE_LRU_CACHE_H_
+#define OPENDSA_NATIVE_LRU_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace opendsa {
+
+// Cache LRU a capacità fissa. Quando è piena, Insert riusa il nodo e il
+// valore dell'elemento usato meno di recente invece di allocarne uno nuovo:
+// valori come std::string o std::vector mantengono la loro memoria e il
+// chiamante li sovrascrive senza riallocare.
+//
+// Non è thread-safe.
+template <typename Key, typename Value>
+class LruCache {
+ public:
+  explicit LruCache(size_t capacity = 1) : capacity_(capacity > 0 ? capacity : 1) {}
+
+  // Cambia la capacità (almeno 1), scartando gli elementi in eccesso.
+  void set_capacity(size_t capacity) {
+    capacity_ = capacity > 0 ? capacity : 1;
+    while (items_.size() > capacity_) {
+      index_.erase(items_.back().first);
+      items_.pop_back();
+    }
+  }
+
+  // Valore associato a |key|, che diventa il più recente; null se assente.
+  Value* Find(const Key& key) {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      misses_++;
+      return nullptr;
+    }
+    hits_++;
+    items_.splice(items_.begin(), items_, it->second);
+    return &it->second->second;
+  }
+
+  // Inserisce |key| come elemento più recente e ne restituisce il valore da
+  // compilare. Il valore è quello di un elemento scartato (se la cache era
+  // piena) o uno costruito di default; se |key| era già presente viene
+  // restituito il suo valore.
+  Value& Insert(const Key& key) {
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      items_.splice(items_.begin(), items_, it->second);
+      return it->second->second;
+    }
+    if (items_.size() >= capacity_) {
+      index_.erase(items_.back().first);
+      items_.splice(items_.begin(), items_, std::prev(items_.end()));
+      items_.front().first = key;
+      evictions_++;
+    } else {
+      items_.emplace_front(key, Value());
+    }
+    index_.emplace(key, items_.begin());
+    return items_.front().second;
+  }
+
+  void Clear() {
+    items_.clear();
+    index_.clear();
+  }
+
+  size_t size() const { return items_.size(); }
+  size_t capacity() const { return capacity_; }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+  uint64_t evictions() const { return evictions_; }
+
+ private:
+  using Item = std::pair<Key, Value>;
+
+  size_t capacity_;
+  std::list<Item> items_;  // Dal più recente al meno recente
+  std::unordered_map<Key, typename std::list<Item>::iterator> index_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_LRU_CACHE_H_
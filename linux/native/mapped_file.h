@@ -0,0 +1,39 @@
+// linux/native/mapped_file.h
+
+#ifndef OPENDSA_NATIVE_MAPPED_FILE_H_
+#define OPENDSA_NATIVE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace opendsa {
+
+// File mappato in memoria in sola lettura. La mappatura viene rilasciata dal
+// distruttore; i puntatori restituiti da data() restano validi fino ad allora.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Mappa |path| sostituendo l'eventuale mappatura precedente. Restituisce
+  // false se il file non esiste, non è leggibile o è vuoto.
+  bool Open(const std::string& path);
+
+  void Close();
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool is_open() const { return data_ != nullptr; }
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_MAPPED_FILE_H_
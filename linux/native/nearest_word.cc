@@ -0,0 +1,62 @@
+// linux/native/nearest_word.cc
+
+#include "nearest_word.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+NearestWordIndex::NearestWordIndex(const std::vector<std::string>& words) {
+  std::u32string decoded;
+  std::u32string normalized;
+  for (size_t i = 0; i < words.size(); i++) {
+    DecodeUtf8(words[i], &decoded);
+    NormalizeText(decoded, &normalized);
+    if (normalized.empty()) continue;
+    if (by_length_.size() <= normalized.size()) {
+      by_length_.resize(normalized.size() + 1);
+    }
+    by_length_[normalized.size()].push_back(
+        {normalized, static_cast<int32_t>(i)});
+    count_++;
+  }
+}
+
+NearestWordIndex::Match NearestWordIndex::Find(std::string_view word,
+                                               const CostMatrix& costs) {
+  DecodeUtf8(word, &decoded_);
+  NormalizeText(decoded_, &query_);
+
+  Match best;
+  int32_t best_distance = std::numeric_limits<int32_t>::max();
+  const int32_t indel = std::min(costs.insertion(), costs.deletion());
+  const int32_t query_length = static_cast<int32_t>(query_.size());
+  const int32_t max_length = static_cast<int32_t>(by_length_.size()) - 1;
+
+  // Si parte dalla stessa lunghezza e ci si allontana in entrambe le
+  // direzioni finché il limite inferiore supera la distanza migliore
+  for (int32_t delta = 0; delta <= std::max(query_length, max_length);
+       delta++) {
+    if (delta * indel > best_distance) break;
+    for (int32_t sign : {-1, 1}) {
+      if (delta == 0 && sign > 0) continue;
+      const int32_t length = query_length + sign * delta;
+      if (length < 0 || length > max_length) continue;
+      for (const Entry& entry : by_length_[length]) {
+        const int32_t distance = aligner_.Distance(entry.text, query_, costs);
+        if (distance < best_distance ||
+            (distance == best_distance && entry.index < best.index)) {
+          best_distance = distance;
+          best.index = entry.index;
+          best.distance = distance;
+        }
+      }
+    }
+  }
+  return best;
+}
+
+}  // namespace opendsa
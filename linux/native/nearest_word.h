@@ -0,0 +1,52 @@
+// linux/native/nearest_word.h
+
+#ifndef OPENDSA_NATIVE_NEAREST_WORD_H_
+#define OPENDSA_NATIVE_NEAREST_WORD_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alignment.h"
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+// Ricerca della parola del lessico più vicina a una parola letta, con la
+// stessa distanza pesata usata per la similarità. Le parole sono raggruppate
+// per lunghezza: la differenza di lunghezza è un limite inferiore della
+// distanza, quindi i gruppi troppo lontani vengono scartati senza calcoli.
+class NearestWordIndex {
+ public:
+  struct Match {
+    int32_t index = -1;     // Indice nella lista originale, -1 se vuota
+    int32_t distance = 0;   // In unità kCostUnit
+  };
+
+  explicit NearestWordIndex(const std::vector<std::string>& words);
+
+  // Parola più vicina a |word| (UTF-8). A parità di distanza vince quella
+  // che compare prima nella lista.
+  Match Find(std::string_view word,
+             const CostMatrix& costs = CostMatrix::Default());
+
+  size_t size() const { return count_; }
+
+ private:
+  struct Entry {
+    std::u32string text;
+    int32_t index;
+  };
+
+  // by_length_[n] contiene le parole normalizzate di n code point
+  std::vector<std::vector<Entry>> by_length_;
+  size_t count_ = 0;
+  Aligner aligner_;
+  std::u32string decoded_;
+  std::u32string query_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_NEAREST_WORD_H_
@@ -0,0 +1,1556 @@
+// linux/native/opendsa_native.cc
+
+#include "opendsa_native.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "accuracy_series.h"
+#include "analytics_store.h"
+#include "async_logger.h"
+#include "attempt_log.h"
+#include "audio_archive.h"
+#include "batch_rescorer.h"
+#include "binary_profile.h"
+#include "confusion_model.h"
+#include "content_index.h"
+#include "content_pack.h"
+#include "file_recognizer.h"
+#include "file_utils.h"
+#include "lexicon.h"
+#include "phonemizer.h"
+#include "profile_store.h"
+#include "session_journal.h"
+#include "syllabifier.h"
+#include "text_utils.h"
+#include "similarity.h"
+#include "tokenizer.h"
+#include "word_aligner.h"
+
+struct OpendsaConfusionModel {
+  opendsa::ConfusionModel model;
+};
+
+struct OpendsaRescoreJob {
+  opendsa::BatchRescorer rescorer;
+};
+
+struct OpendsaLexicon {
+  opendsa::Lexicon lexicon;
+};
+
+struct OpendsaContentIndex {
+  opendsa::ContentIndex index;
+};
+
+// I token di una pagina possono essere condivisi con la cache del pacchetto
+struct OpendsaTokens {
+  std::shared_ptr<const opendsa::TokenizedText> text;
+};
+
+struct OpendsaContentPack {
+  opendsa::ContentPack pack;
+};
+
+struct OpendsaProfileLog {
+  opendsa::ProfileStore log;
+};
+
+struct OpendsaBinaryProfile {
+  opendsa::BinaryProfile profile;
+  std::string json;  // Buffer di opendsa_binary_profile_to_json
+};
+
+struct OpendsaAnalytics {
+  opendsa::AnalyticsStore store;
+};
+
+struct OpendsaAttemptLog {
+  opendsa::AttemptLog log;
+  std::vector<opendsa::AttemptGroup> groups;  // Ultima interrogazione
+};
+
+struct OpendsaSessionJournal {
+  opendsa::SessionJournal journal;
+};
+
+struct OpendsaLogger {
+  opendsa::AsyncLogger logger;
+  std::vector<std::string> lines;  // Ultima opendsa_logger_recent
+  std::string day;                 // Ultima opendsa_logger_read_day
+};
+
+struct OpendsaAudioArchive {
+  opendsa::AudioArchive archive;
+  std::vector<opendsa::AudioClip> clips;
+  mutable std::mutex mutex;  // Serializza le aggiunte in background
+};
+
+struct OpendsaAudioArchiveJob {
+  std::thread thread;
+  std::atomic<bool> done{false};
+  int64_t id = -1;
+};
+
+struct OpendsaSpeechModel {
+  opendsa::SpeechModel model;
+};
+
+struct OpendsaFileRecognition {
+  opendsa::FileRecognitionJob job;
+};
+
+struct OpendsaAccuracySeries {
+  explicit OpendsaAccuracySeries(float threshold) : series(threshold) {}
+  opendsa::AccuracySeries series;
+};
+
+// Le voci mappate vengono passate a Dart senza copia
+static_assert(sizeof(OpendsaLexiconEntry) == sizeof(opendsa::LexiconEntry),
+              "OpendsaLexiconEntry e LexiconEntry devono coincidere");
+static_assert(offsetof(OpendsaLexiconEntry, flags) ==
+                  offsetof(opendsa::LexiconEntry, flags),
+              "OpendsaLexiconEntry e LexiconEntry devono coincidere");
+static_assert(offsetof(OpendsaLexiconEntry, orthographic_depth) ==
+                  offsetof(opendsa::LexiconEntry, orthographic_depth),
+              "OpendsaLexiconEntry e LexiconEntry devono coincidere");
+static_assert(sizeof(OpendsaLexiconPronunciation) ==
+                  sizeof(opendsa::LexiconPronunciation),
+              "OpendsaLexiconPronunciation e LexiconPronunciation devono "
+              "coincidere");
+static_assert(OPENDSA_WORD_COMPLEX_SYLLABLES ==
+                  opendsa::kWordComplexSyllables &&
+              OPENDSA_WORD_ACCENTED == opendsa::kWordAccented &&
+              OPENDSA_WORD_DIGRAPH == opendsa::kWordDigraph &&
+              OPENDSA_WORD_CONSONANT_CLUSTER ==
+                  opendsa::kWordConsonantCluster &&
+              OPENDSA_WORD_GEMINATE == opendsa::kWordGeminate &&
+              OPENDSA_WORD_HIATUS == opendsa::kWordHiatus &&
+              OPENDSA_WORD_DIPHTHONG == opendsa::kWordDiphthong &&
+              OPENDSA_WORD_TRIPHTHONG == opendsa::kWordTriphthong,
+              "Flag delle parole non allineati");
+static_assert(OPENDSA_TOKEN_WORD ==
+                  static_cast<int>(opendsa::TokenKind::kWord) &&
+              OPENDSA_TOKEN_NUMBER ==
+                  static_cast<int>(opendsa::TokenKind::kNumber) &&
+              OPENDSA_TOKEN_PUNCTUATION ==
+                  static_cast<int>(opendsa::TokenKind::kPunctuation),
+              "Tipi di token non allineati");
+static_assert(OPENDSA_TOKEN_SENTENCE_START == opendsa::kTokenSentenceStart &&
+              OPENDSA_TOKEN_PARAGRAPH_START ==
+                  opendsa::kTokenParagraphStart &&
+              OPENDSA_TOKEN_PAGE_START == opendsa::kTokenPageStart &&
+              OPENDSA_TOKEN_SPACE_BEFORE == opendsa::kTokenSpaceBefore &&
+              OPENDSA_TOKEN_CAPITALIZED == opendsa::kTokenCapitalized &&
+              OPENDSA_TOKEN_ELISION == opendsa::kTokenElision &&
+              OPENDSA_TOKEN_SENTENCE_END == opendsa::kTokenSentenceEnd,
+              "Flag dei token non allineati");
+static_assert(OPENDSA_VALUE_NULL ==
+                  static_cast<int>(opendsa::ProfileValueType::kNull) &&
+              OPENDSA_VALUE_STRING ==
+                  static_cast<int>(opendsa::ProfileValueType::kString) &&
+              OPENDSA_VALUE_OBJECT ==
+                  static_cast<int>(opendsa::ProfileValueType::kObject),
+              "Tipi dei valori del profilo non allineati");
+static_assert(OPENDSA_ANALYTICS_ERROR_KINDS == opendsa::kAnalyticsErrorKinds &&
+              OPENDSA_ANALYTICS_SIMILARITY_BUCKETS ==
+                  opendsa::kAnalyticsSimilarityBuckets,
+              "Dimensioni delle statistiche non allineate");
+static_assert(OPENDSA_ATTEMPT_INCORRECT == opendsa::kAttemptIncorrect &&
+              OPENDSA_ATTEMPT_GROUP_PROFILE ==
+                  static_cast<int>(opendsa::AttemptGroupBy::kProfile),
+              "Costanti del registro dei tentativi non allineate");
+static_assert(OPENDSA_ANALYTICS_ERROR_KINDS == opendsa::kAttemptSummaryErrors,
+              "Errori dei riepiloghi dei tentativi non allineati");
+static_assert(OPENDSA_JOURNAL_BEGIN == opendsa::kJournalBegin &&
+                  OPENDSA_JOURNAL_ENTRY == opendsa::kJournalEntry,
+              "Tipi dei record del journal non allineati");
+static_assert(OPENDSA_LOG_DEBUG ==
+                      static_cast<int>(opendsa::LogLevel::kDebug) &&
+                  OPENDSA_LOG_ERROR ==
+                      static_cast<int>(opendsa::LogLevel::kError),
+              "Livelli del log non allineati");
+
+namespace {
+
+// Un motore per thread: Dart può chiamare l'API da più isolate.
+opendsa::SimilarityEngine& ThreadEngine() {
+  thread_local opendsa::SimilarityEngine engine;
+  return engine;
+}
+
+opendsa::WordQuery ToWordQuery(const OpendsaWordQuery& query) {
+  opendsa::WordQuery result;
+  result.level = query.level;
+  result.difficulty = static_cast<opendsa::WordDifficulty>(query.difficulty);
+  result.min_syllables = query.min_syllables;
+  result.max_syllables = query.max_syllables;
+  result.min_length = query.min_length;
+  result.max_length = query.max_length;
+  return result;
+}
+
+const opendsa::CostMatrix& CostsFor(const OpendsaConfusionModel* model) {
+  return model != nullptr ? model->model.costs()
+                          : opendsa::CostMatrix::Default();
+}
+
+// Gli indici dei nodi passano da uint32 (kNone) a int32 (-1)
+int32_t ToNode(uint32_t index) {
+  return index == opendsa::BinaryProfile::kNone ? -1
+                                                : static_cast<int32_t>(index);
+}
+
+uint32_t FromNode(int32_t node) {
+  return node < 0 ? opendsa::BinaryProfile::kNone : static_cast<uint32_t>(node);
+}
+
+void ToAnalyticsStats(const opendsa::AnalyticsAggregate& aggregate,
+                      OpendsaAnalyticsStats* out) {
+  out->attempts = static_cast<int64_t>(aggregate.attempts);
+  out->successes = static_cast<int64_t>(aggregate.successes);
+  out->similarity_mean = aggregate.similarity_mean;
+  out->similarity_stddev = std::sqrt(opendsa::AnalyticsStore::Variance(
+      aggregate.similarity_m2, aggregate.attempts));
+  out->similarity_min = aggregate.similarity_min;
+  out->similarity_max = aggregate.similarity_max;
+  out->time_mean = aggregate.time_mean;
+  out->time_stddev = std::sqrt(opendsa::AnalyticsStore::Variance(
+      aggregate.time_m2, aggregate.attempts));
+  for (int i = 0; i < OPENDSA_ANALYTICS_ERROR_KINDS; i++) {
+    out->errors[i] = static_cast<int64_t>(aggregate.errors[i]);
+  }
+  for (int i = 0; i < OPENDSA_ANALYTICS_SIMILARITY_BUCKETS; i++) {
+    out->similarity_buckets[i] =
+        static_cast<int64_t>(aggregate.similarity_buckets[i]);
+  }
+}
+
+// Copia un riepilogo dei tentativi; restituisce 1 se esiste, 0 altrimenti.
+int32_t ToAttemptSummary(const opendsa::AttemptSummary* summary,
+                         OpendsaAttemptSummary* out) {
+  *out = OpendsaAttemptSummary();
+  if (summary == nullptr || summary->attempts == 0) return 0;
+  const auto attempts = static_cast<double>(summary->attempts);
+  out->attempts = static_cast<int64_t>(summary->attempts);
+  out->correct = static_cast<int64_t>(summary->correct);
+  out->accuracy = static_cast<double>(summary->correct) / attempts;
+  out->similarity_mean = summary->similarity_sum / attempts;
+  out->duration_mean_ms = summary->duration_sum_ms / attempts;
+  out->first_ms = summary->first_ms;
+  out->last_ms = summary->last_ms;
+  out->days = summary->days;
+  for (int i = 0; i < OPENDSA_ANALYTICS_ERROR_KINDS; i++) {
+    out->errors[i] = summary->errors[i];
+  }
+  return 1;
+}
+
+}  // namespace
+
+extern "C" {
+
+double opendsa_similarity(const char* recognized, const char* target) {
+  return opendsa_similarity_with_model(recognized, target, nullptr);
+}
+
+int32_t opendsa_similarity_parameters_version(void) {
+  return opendsa::kSimilarityParametersVersion;
+}
+
+int32_t opendsa_diagnose(const char* recognized,
+                         const char* target,
+                         OpendsaDiagnostics* out) {
+  return opendsa_diagnose_with_model(recognized, target, nullptr, out);
+}
+
+double opendsa_similarity_with_model(const char* recognized,
+                                     const char* target,
+                                     const OpendsaConfusionModel* model) {
+  if (recognized == nullptr || target == nullptr) return 0.0;
+  return ThreadEngine().Similarity(recognized, target, CostsFor(model));
+}
+
+int32_t opendsa_diagnose_with_model(const char* recognized,
+                                    const char* target,
+                                    const OpendsaConfusionModel* model,
+                                    OpendsaDiagnostics* out) {
+  if (recognized == nullptr || target == nullptr || out == nullptr) return -1;
+
+  thread_local opendsa::Diagnostics diagnostics;
+  ThreadEngine().Diagnose(recognized, target, &diagnostics, CostsFor(model));
+
+  out->inversions = diagnostics.inversions;
+  out->confusions = diagnostics.confusions;
+  out->sequence_errors = diagnostics.sequence_errors;
+  out->omissions = diagnostics.omissions;
+  out->insertions = diagnostics.insertions;
+  out->substitutions = diagnostics.substitutions;
+  out->distance = static_cast<double>(diagnostics.distance) / opendsa::kCostUnit;
+  out->similarity = diagnostics.similarity;
+  out->edit_count = static_cast<int32_t>(diagnostics.edits.size());
+
+  if (out->edits != nullptr) {
+    const int32_t count = out->edit_count < out->edit_capacity
+        ? out->edit_count
+        : out->edit_capacity;
+    for (int32_t i = 0; i < count; i++) {
+      const opendsa::DiagnosticEdit& edit = diagnostics.edits[i];
+      out->edits[i] = {static_cast<int32_t>(edit.kind), edit.target_pos,
+                       edit.recognized_pos, edit.length,
+                       static_cast<uint32_t>(edit.expected),
+                       static_cast<uint32_t>(edit.actual)};
+    }
+  }
+  return 0;
+}
+
+OpendsaConfusionModel* opendsa_confusion_model_open(const char* path) {
+  auto* handle = new OpendsaConfusionModel();
+  if (path != nullptr && !handle->model.Load(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_confusion_model_save(const OpendsaConfusionModel* model,
+                                     const char* path) {
+  if (model == nullptr || path == nullptr) return -1;
+  return model->model.Save(path) ? 0 : -1;
+}
+
+int32_t opendsa_confusion_model_observe(OpendsaConfusionModel* model,
+                                        const char* recognized,
+                                        const char* target) {
+  if (model == nullptr || recognized == nullptr || target == nullptr) {
+    return -1;
+  }
+  // Allineamento con i costi standard, così il modello non rinforza se stesso
+  opendsa::SimilarityEngine& engine = ThreadEngine();
+  const auto& path = engine.Align(recognized, target);
+  model->model.Observe(engine.normalized_target(),
+                       engine.normalized_recognized(), path);
+  return static_cast<int32_t>(model->model.attempts());
+}
+
+void opendsa_confusion_model_free(OpendsaConfusionModel* model) {
+  delete model;
+}
+
+OpendsaRescoreJob* opendsa_rescore_start(const char* const* recognized,
+                                         const char* const* targets,
+                                         int32_t count,
+                                         const OpendsaConfusionModel* model,
+                                         int32_t threads) {
+  if (count < 0) return nullptr;
+  if (count > 0 && (recognized == nullptr || targets == nullptr)) {
+    return nullptr;
+  }
+  auto* job = new OpendsaRescoreJob();
+  for (int32_t i = 0; i < count; i++) {
+    job->rescorer.Add(recognized[i] != nullptr ? recognized[i] : "",
+                      targets[i] != nullptr ? targets[i] : "");
+  }
+  job->rescorer.Start(CostsFor(model), threads);
+  return job;
+}
+
+int32_t opendsa_rescore_progress(const OpendsaRescoreJob* job) {
+  return job != nullptr ? job->rescorer.completed() : 0;
+}
+
+int32_t opendsa_rescore_wait(OpendsaRescoreJob* job, double* out) {
+  if (job == nullptr) return 0;
+  job->rescorer.Wait();
+  const std::vector<double>& similarities = job->rescorer.similarities();
+  if (out != nullptr) std::copy(similarities.begin(), similarities.end(), out);
+  return out != nullptr ? static_cast<int32_t>(similarities.size()) : 0;
+}
+
+void opendsa_rescore_free(OpendsaRescoreJob* job) {
+  delete job;
+}
+
+int32_t opendsa_word_features(const char* word,
+                              OpendsaWordFeatures* out,
+                              int32_t* syllable_starts,
+                              int32_t capacity) {
+  if (word == nullptr || out == nullptr) return -1;
+  thread_local opendsa::Syllabifier syllabifier;
+  thread_local std::u32string decoded;
+  thread_local std::vector<int32_t> starts;
+
+  opendsa::DecodeUtf8(word, &decoded);
+  for (char32_t& cp : decoded) cp = opendsa::ToLower(cp);
+  const opendsa::WordFeatures features =
+      syllabifier.Analyze(decoded, &starts);
+  out->syllables = features.syllables;
+  out->stress = features.stress;
+  out->flags = features.flags;
+  out->orthographic_depth = features.orthographic_depth;
+  if (syllable_starts != nullptr) {
+    const int32_t count =
+        std::min(capacity, static_cast<int32_t>(starts.size()));
+    std::copy(starts.begin(), starts.begin() + std::max(count, 0),
+              syllable_starts);
+  }
+  return features.syllables;
+}
+
+OpendsaLexicon* opendsa_lexicon_open(const char* path) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaLexicon();
+  if (!handle->lexicon.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_lexicon_size(const OpendsaLexicon* lexicon) {
+  return lexicon != nullptr ? static_cast<int32_t>(lexicon->lexicon.size())
+                            : 0;
+}
+
+const OpendsaLexiconEntry* opendsa_lexicon_entries(
+    const OpendsaLexicon* lexicon) {
+  if (lexicon == nullptr) return nullptr;
+  return reinterpret_cast<const OpendsaLexiconEntry*>(
+      lexicon->lexicon.entries());
+}
+
+const char* opendsa_lexicon_strings(const OpendsaLexicon* lexicon) {
+  return lexicon != nullptr ? lexicon->lexicon.strings() : nullptr;
+}
+
+const OpendsaLexiconPronunciation* opendsa_lexicon_pronunciations(
+    const OpendsaLexicon* lexicon) {
+  if (lexicon == nullptr) return nullptr;
+  return reinterpret_cast<const OpendsaLexiconPronunciation*>(
+      lexicon->lexicon.pronunciations());
+}
+
+int32_t opendsa_lexicon_level_range(const OpendsaLexicon* lexicon,
+                                    int32_t level,
+                                    int32_t* first) {
+  if (lexicon == nullptr) return 0;
+  const opendsa::LexiconRange range = lexicon->lexicon.level(level);
+  if (first != nullptr) *first = static_cast<int32_t>(range.first);
+  return static_cast<int32_t>(range.count);
+}
+
+double opendsa_lexicon_similarity(const OpendsaLexicon* lexicon,
+                                  int32_t index, const char* recognized,
+                                  const OpendsaConfusionModel* model) {
+  if (lexicon == nullptr || recognized == nullptr || index < 0 ||
+      static_cast<uint32_t>(index) >= lexicon->lexicon.size()) {
+    return 0.0;
+  }
+  const auto entry = static_cast<uint32_t>(index);
+  return ThreadEngine().Similarity(recognized, lexicon->lexicon.text(entry),
+                                   CostsFor(model),
+                                   lexicon->lexicon.pronunciation(entry));
+}
+
+void opendsa_lexicon_close(OpendsaLexicon* lexicon) {
+  delete lexicon;
+}
+
+int32_t opendsa_pronounce(const char* word, char* out, int32_t capacity) {
+  if (word == nullptr || capacity < 0 || (out == nullptr && capacity > 0)) {
+    return -1;
+  }
+  thread_local opendsa::Phonemizer phonemizer;
+  const std::string_view pronunciation = phonemizer.Pronounce(word);
+  if (capacity > 0) {
+    const size_t count =
+        std::min(pronunciation.size(), static_cast<size_t>(capacity) - 1);
+    std::memcpy(out, pronunciation.data(), count);
+    out[count] = '\0';
+  }
+  return static_cast<int32_t>(pronunciation.size());
+}
+
+OpendsaContentIndex* opendsa_content_index_open(const OpendsaLexicon* lexicon,
+                                                const char* state_path,
+                                                uint64_t seed) {
+  if (lexicon == nullptr) return nullptr;
+  auto* handle = new OpendsaContentIndex();
+  handle->index.Build(lexicon->lexicon, seed);
+  if (state_path != nullptr) handle->index.Load(state_path);
+  return handle;
+}
+
+int32_t opendsa_content_index_next(OpendsaContentIndex* index,
+                                   const OpendsaWordQuery* query) {
+  if (index == nullptr || query == nullptr) return -1;
+  return index->index.Next(ToWordQuery(*query));
+}
+
+int32_t opendsa_content_index_count(const OpendsaContentIndex* index,
+                                    const OpendsaWordQuery* query) {
+  if (index == nullptr || query == nullptr) return 0;
+  return index->index.Count(ToWordQuery(*query));
+}
+
+int32_t opendsa_content_index_save(const OpendsaContentIndex* index,
+                                   const char* path) {
+  if (index == nullptr || path == nullptr) return -1;
+  return index->index.Save(path) ? 0 : -1;
+}
+
+void opendsa_content_index_free(OpendsaContentIndex* index) {
+  delete index;
+}
+
+OpendsaTokens* opendsa_tokenize(const char* text, int32_t length) {
+  if (text == nullptr || length < -1) return nullptr;
+  const size_t size = length < 0 ? std::strlen(text)
+                                 : static_cast<size_t>(length);
+  auto tokenized = std::make_shared<opendsa::TokenizedText>();
+  opendsa::Tokenizer().Tokenize(std::string_view(text, size), tokenized.get());
+  return new OpendsaTokens{std::move(tokenized)};
+}
+
+int32_t opendsa_tokens_view(const OpendsaTokens* tokens,
+                            OpendsaTokenView* out) {
+  if (tokens == nullptr || out == nullptr) return -1;
+  const opendsa::TokenizedText& text = *tokens->text;
+  out->token_count = static_cast<int32_t>(text.size());
+  out->sentence_count = static_cast<int32_t>(text.sentence_count());
+  out->paragraph_count = static_cast<int32_t>(text.paragraph_count());
+  out->normalized_size = static_cast<int32_t>(text.normalized.size());
+  out->begins = text.begins.data();
+  out->ends = text.ends.data();
+  out->utf16_begins = text.utf16_begins.data();
+  out->utf16_ends = text.utf16_ends.data();
+  out->kinds = text.kinds.data();
+  out->flags = text.flags.data();
+  out->normalized_offsets = text.normalized_offsets.data();
+  out->normalized_lengths = text.normalized_lengths.data();
+  out->normalized = text.normalized.data();
+  out->sentence_starts = text.sentence_starts.data();
+  out->paragraph_starts = text.paragraph_starts.data();
+  return out->token_count;
+}
+
+int32_t opendsa_tokens_align(const OpendsaTokens* tokens,
+                             int32_t first,
+                             int32_t count,
+                             const char* recognized,
+                             int32_t* out,
+                             int32_t capacity) {
+  if (tokens == nullptr || recognized == nullptr || first < 0 || count < 0) {
+    return -1;
+  }
+  thread_local opendsa::WordAligner aligner;
+  thread_local std::vector<int32_t> matches;
+
+  aligner.Align(*tokens->text, static_cast<size_t>(first),
+                static_cast<size_t>(count), recognized, &matches);
+  if (out != nullptr) {
+    const int32_t copied =
+        std::min(capacity, static_cast<int32_t>(matches.size()));
+    std::copy(matches.begin(), matches.begin() + std::max(copied, 0), out);
+  }
+  return static_cast<int32_t>(matches.size());
+}
+
+void opendsa_tokens_free(OpendsaTokens* tokens) {
+  delete tokens;
+}
+
+OpendsaContentPack* opendsa_content_pack_open(const char* path,
+                                              int32_t cached_pages) {
+  if (path == nullptr || cached_pages < 0) return nullptr;
+  auto* handle = new OpendsaContentPack();
+  const size_t capacity = cached_pages > 0
+                              ? static_cast<size_t>(cached_pages)
+                              : opendsa::ContentPack::kDefaultCachedPages;
+  if (!handle->pack.Open(path, capacity)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_content_pack_size(const OpendsaContentPack* pack) {
+  return pack != nullptr ? static_cast<int32_t>(pack->pack.size()) : 0;
+}
+
+const char* opendsa_content_pack_page(OpendsaContentPack* pack,
+                                      int32_t index,
+                                      int32_t* length) {
+  if (pack == nullptr || index < 0 ||
+      static_cast<uint32_t>(index) >= pack->pack.size()) {
+    return nullptr;
+  }
+  const std::string_view page = pack->pack.Page(static_cast<uint32_t>(index));
+  if (length != nullptr) *length = static_cast<int32_t>(page.size());
+  return page.data();
+}
+
+OpendsaTokens* opendsa_content_pack_tokens(OpendsaContentPack* pack,
+                                           int32_t index) {
+  if (pack == nullptr || index < 0) return nullptr;
+  std::shared_ptr<const opendsa::TokenizedText> tokens =
+      pack->pack.Tokens(static_cast<uint32_t>(index));
+  if (tokens == nullptr) return nullptr;
+  return new OpendsaTokens{std::move(tokens)};
+}
+
+void opendsa_content_pack_close(OpendsaContentPack* pack) {
+  delete pack;
+}
+
+OpendsaProfileLog* opendsa_profile_log_open(const char* path) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaProfileLog();
+  if (!handle->log.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_profile_log_size(const OpendsaProfileLog* log) {
+  return log != nullptr ? static_cast<int32_t>(log->log.entries().size()) : 0;
+}
+
+int32_t opendsa_profile_log_entry(const OpendsaProfileLog* log, int32_t index,
+                                  OpendsaProfileEntry* out) {
+  if (log == nullptr || out == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= log->log.entries().size()) {
+    return -1;
+  }
+  const auto& [key, value] = log->log.entries()[static_cast<size_t>(index)];
+  out->key = key.data();
+  out->key_length = static_cast<int32_t>(key.size());
+  out->value = value.data();
+  out->value_length = static_cast<int32_t>(value.size());
+  return 0;
+}
+
+const char* opendsa_profile_log_get(const OpendsaProfileLog* log,
+                                    const char* key, int32_t* length) {
+  if (log == nullptr || key == nullptr) return nullptr;
+  const std::string* value = log->log.Get(key);
+  if (value == nullptr) return nullptr;
+  if (length != nullptr) *length = static_cast<int32_t>(value->size());
+  return value->data();
+}
+
+int32_t opendsa_profile_log_put(OpendsaProfileLog* log, const char* key,
+                                const char* value, int32_t length) {
+  if (log == nullptr || key == nullptr || value == nullptr) return -1;
+  const size_t size =
+      length < 0 ? std::strlen(value) : static_cast<size_t>(length);
+  return log->log.Put(key, std::string_view(value, size));
+}
+
+int32_t opendsa_profile_log_remove(OpendsaProfileLog* log, const char* key) {
+  if (log == nullptr || key == nullptr) return -1;
+  return log->log.Erase(key);
+}
+
+void opendsa_profile_log_set_commit_window(OpendsaProfileLog* log,
+                                           int32_t milliseconds) {
+  if (log == nullptr) return;
+  log->log.set_commit_window(std::chrono::milliseconds(milliseconds));
+}
+
+int32_t opendsa_profile_log_flush(OpendsaProfileLog* log) {
+  if (log == nullptr) return -1;
+  return log->log.Flush() ? 0 : -1;
+}
+
+int32_t opendsa_profile_log_compact(OpendsaProfileLog* log) {
+  if (log == nullptr) return -1;
+  return log->log.Compact() ? 0 : -1;
+}
+
+void opendsa_profile_log_stats(const OpendsaProfileLog* log,
+                               OpendsaProfileLogStats* out) {
+  if (out == nullptr) return;
+  *out = OpendsaProfileLogStats();
+  if (log == nullptr) return;
+  const opendsa::ProfileStoreStats stats = log->log.stats();
+  out->records_replayed = static_cast<int64_t>(stats.log.records_replayed);
+  out->records_appended = static_cast<int64_t>(stats.log.records_appended);
+  out->writes_skipped = static_cast<int64_t>(stats.log.writes_skipped);
+  out->bytes_truncated = static_cast<int64_t>(stats.log.bytes_truncated);
+  out->compactions = static_cast<int64_t>(stats.log.compactions);
+  out->log_bytes = static_cast<int64_t>(stats.log.log_bytes);
+  out->live_bytes = static_cast<int64_t>(stats.log.live_bytes);
+  out->writes_requested = static_cast<int64_t>(stats.writes_requested);
+  out->writes_coalesced = static_cast<int64_t>(stats.writes_coalesced);
+  out->commits = static_cast<int64_t>(stats.commits);
+  out->failed_commits = static_cast<int64_t>(stats.failed_commits);
+}
+
+int32_t opendsa_profile_log_export_binary(OpendsaProfileLog* log,
+                                          const char* path) {
+  if (log == nullptr || path == nullptr) return -1;
+  std::string profile;
+  if (!opendsa::BuildBinaryProfile(log->log.entries(), &profile)) return -1;
+  return opendsa::WriteFileAtomically(path, profile.data(), profile.size())
+             ? 0
+             : -1;
+}
+
+void opendsa_profile_log_close(OpendsaProfileLog* log) {
+  delete log;
+}
+
+int32_t opendsa_binary_profile_import(const char* json, int32_t length,
+                                      const char* path) {
+  if (json == nullptr || path == nullptr) return -1;
+  const size_t size =
+      length < 0 ? std::strlen(json) : static_cast<size_t>(length);
+  std::string profile;
+  if (!opendsa::BuildBinaryProfile(std::string_view(json, size), &profile)) {
+    return -1;
+  }
+  return opendsa::WriteFileAtomically(path, profile.data(), profile.size())
+             ? 0
+             : -1;
+}
+
+OpendsaBinaryProfile* opendsa_binary_profile_open(const char* path) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaBinaryProfile();
+  if (!handle->profile.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_binary_profile_root(const OpendsaBinaryProfile* profile) {
+  return profile != nullptr ? ToNode(profile->profile.root()) : -1;
+}
+
+int32_t opendsa_binary_profile_find(const OpendsaBinaryProfile* profile,
+                                    int32_t object, const char* key) {
+  if (profile == nullptr || key == nullptr) return -1;
+  return ToNode(profile->profile.Find(FromNode(object), key));
+}
+
+int32_t opendsa_binary_profile_element(const OpendsaBinaryProfile* profile,
+                                       int32_t array, int32_t index) {
+  if (profile == nullptr || index < 0) return -1;
+  return ToNode(profile->profile.Element(FromNode(array),
+                                         static_cast<uint32_t>(index)));
+}
+
+int32_t opendsa_binary_profile_member_key(const OpendsaBinaryProfile* profile,
+                                          int32_t object, int32_t index) {
+  if (profile == nullptr || index < 0) return -1;
+  return ToNode(
+      profile->profile.Key(FromNode(object), static_cast<uint32_t>(index)));
+}
+
+int32_t opendsa_binary_profile_member_value(const OpendsaBinaryProfile* profile,
+                                            int32_t object, int32_t index) {
+  if (profile == nullptr || index < 0) return -1;
+  return ToNode(
+      profile->profile.Value(FromNode(object), static_cast<uint32_t>(index)));
+}
+
+int32_t opendsa_binary_profile_node(const OpendsaBinaryProfile* profile,
+                                    int32_t node, OpendsaProfileValue* out) {
+  if (profile == nullptr || out == nullptr) return -1;
+  const uint32_t index = FromNode(node);
+  const opendsa::BinaryProfileNode* value = profile->profile.node(index);
+  if (value == nullptr) return -1;
+  out->type = value->type;
+  out->count = static_cast<int32_t>(value->count);
+  out->integer = profile->profile.Int(index);
+  out->number = profile->profile.Double(index);
+  out->string = value->type == OPENDSA_VALUE_STRING
+                    ? profile->profile.String(index).data()
+                    : nullptr;
+  return 0;
+}
+
+const char* opendsa_binary_profile_to_json(OpendsaBinaryProfile* profile,
+                                           int32_t node, int32_t* length) {
+  if (profile == nullptr) return nullptr;
+  profile->profile.ToJson(FromNode(node), &profile->json);
+  if (length != nullptr) *length = static_cast<int32_t>(profile->json.size());
+  return profile->json.c_str();
+}
+
+void opendsa_binary_profile_close(OpendsaBinaryProfile* profile) {
+  delete profile;
+}
+
+OpendsaAccuracySeries* opendsa_accuracy_series_open(const char* path,
+                                                    double threshold) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaAccuracySeries(static_cast<float>(threshold));
+  if (!handle->series.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_accuracy_series_record(OpendsaAccuracySeries* series,
+                                       int32_t day, double accuracy) {
+  if (series == nullptr) return -1;
+  return series->series.Record(day, static_cast<float>(accuracy)) ? 0 : -1;
+}
+
+int32_t opendsa_accuracy_series_set_days(OpendsaAccuracySeries* series,
+                                         const int32_t* days,
+                                         const double* values, int32_t count) {
+  if (series == nullptr || count < 0 ||
+      (count > 0 && (days == nullptr || values == nullptr))) {
+    return -1;
+  }
+  std::vector<std::pair<int32_t, float>> entries(static_cast<size_t>(count));
+  for (size_t i = 0; i < entries.size(); i++) {
+    entries[i] = {days[i], static_cast<float>(values[i])};
+  }
+  return series->series.SetDays(entries);
+}
+
+int32_t opendsa_accuracy_series_assign(OpendsaAccuracySeries* series,
+                                       const int32_t* days,
+                                       const double* values, int32_t count) {
+  if (series == nullptr || count < 0 ||
+      (count > 0 && (days == nullptr || values == nullptr))) {
+    return -1;
+  }
+  std::vector<opendsa::AccuracyDay> entries(static_cast<size_t>(count));
+  for (size_t i = 0; i < entries.size(); i++) {
+    entries[i].day = days[i];
+    entries[i].attempts = 1;
+    entries[i].value = static_cast<float>(values[i]);
+    entries[i].mean = entries[i].value;
+  }
+  return series->series.Assign(entries) ? 0 : -1;
+}
+
+void opendsa_accuracy_series_summary(const OpendsaAccuracySeries* series,
+                                     OpendsaAccuracySummary* out) {
+  if (out == nullptr) return;
+  *out = OpendsaAccuracySummary();
+  out->last_day = -1;
+  if (series == nullptr) return;
+  const opendsa::AccuracySeries& data = series->series;
+  out->days = static_cast<int32_t>(data.days().size());
+  out->streak = static_cast<int32_t>(data.streak());
+  out->average = data.average();
+  if (!data.days().empty()) {
+    out->last_value = data.days().back().value;
+    out->last_day = data.days().back().day;
+  }
+}
+
+double opendsa_accuracy_series_window_average(
+    const OpendsaAccuracySeries* series, int32_t days) {
+  if (series == nullptr || days <= 0) return 0.0;
+  return series->series.WindowAverage(static_cast<uint32_t>(days));
+}
+
+int32_t opendsa_accuracy_series_day(const OpendsaAccuracySeries* series,
+                                    int32_t index, OpendsaAccuracyDay* out) {
+  if (series == nullptr || out == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= series->series.days().size()) {
+    return -1;
+  }
+  const opendsa::AccuracyDay& day =
+      series->series.days()[static_cast<size_t>(index)];
+  out->day = day.day;
+  out->attempts = static_cast<int32_t>(day.attempts);
+  out->value = day.value;
+  out->mean = day.mean;
+  return 0;
+}
+
+int32_t opendsa_accuracy_series_week_count(
+    const OpendsaAccuracySeries* series) {
+  return series != nullptr
+             ? static_cast<int32_t>(series->series.weeks().size())
+             : 0;
+}
+
+int32_t opendsa_accuracy_series_week(const OpendsaAccuracySeries* series,
+                                     int32_t index, OpendsaAccuracyWeek* out) {
+  if (series == nullptr || out == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= series->series.weeks().size()) {
+    return -1;
+  }
+  const opendsa::AccuracyWeek& week =
+      series->series.weeks()[static_cast<size_t>(index)];
+  out->week = week.week;
+  out->days = static_cast<int32_t>(week.days);
+  out->days_over_threshold = static_cast<int32_t>(week.days_over_threshold);
+  out->attempts = static_cast<int32_t>(week.attempts);
+  out->average = week.days > 0 ? week.value_sum / week.days : 0.0;
+  return 0;
+}
+
+void opendsa_accuracy_series_close(OpendsaAccuracySeries* series) {
+  delete series;
+}
+
+OpendsaAnalytics* opendsa_analytics_open(const char* path) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaAnalytics();
+  if (!handle->store.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_analytics_record(OpendsaAnalytics* analytics,
+                                 double similarity, int64_t duration_ms,
+                                 int32_t correct, const char* recognized,
+                                 const char* target) {
+  if (analytics == nullptr) return -1;
+  opendsa::AnalyticsSample sample;
+  sample.similarity = similarity;
+  sample.seconds = static_cast<double>(duration_ms) / 1000.0;
+  sample.correct = correct != 0;
+  if (!sample.correct && recognized != nullptr && target != nullptr) {
+    thread_local opendsa::Diagnostics diagnostics;
+    ThreadEngine().Diagnose(recognized, target, &diagnostics);
+    sample.errors[OPENDSA_EDIT_INVERSION] =
+        static_cast<uint32_t>(diagnostics.inversions);
+    sample.errors[OPENDSA_EDIT_CONFUSION] =
+        static_cast<uint32_t>(diagnostics.confusions);
+    sample.errors[OPENDSA_EDIT_SEQUENCE] =
+        static_cast<uint32_t>(diagnostics.sequence_errors);
+    sample.errors[OPENDSA_EDIT_OMISSION] =
+        static_cast<uint32_t>(diagnostics.omissions);
+    sample.errors[OPENDSA_EDIT_INSERTION] =
+        static_cast<uint32_t>(diagnostics.insertions);
+    sample.errors[OPENDSA_EDIT_SUBSTITUTION] =
+        static_cast<uint32_t>(diagnostics.substitutions);
+  }
+  return analytics->store.Record(sample) ? 0 : -1;
+}
+
+int32_t opendsa_analytics_start_session(OpendsaAnalytics* analytics,
+                                        int64_t start_ms) {
+  if (analytics == nullptr) return -1;
+  return analytics->store.StartSession(start_ms) ? 0 : -1;
+}
+
+int64_t opendsa_analytics_session_start(const OpendsaAnalytics* analytics) {
+  return analytics != nullptr ? analytics->store.session_start_ms() : 0;
+}
+
+int32_t opendsa_analytics_stats(const OpendsaAnalytics* analytics,
+                                int32_t scope, OpendsaAnalyticsStats* out) {
+  if (analytics == nullptr || out == nullptr) return -1;
+  if (scope == OPENDSA_ANALYTICS_TOTAL) {
+    ToAnalyticsStats(analytics->store.total(), out);
+  } else if (scope == OPENDSA_ANALYTICS_SESSION) {
+    ToAnalyticsStats(analytics->store.session(), out);
+  } else {
+    return -1;
+  }
+  return 0;
+}
+
+int32_t opendsa_analytics_import(OpendsaAnalytics* analytics,
+                                 const OpendsaAnalyticsStats* stats) {
+  if (analytics == nullptr || stats == nullptr || stats->attempts < 0) {
+    return -1;
+  }
+  opendsa::AnalyticsAggregate total = {};
+  total.attempts = static_cast<uint64_t>(stats->attempts);
+  total.successes = static_cast<uint64_t>(std::max<int64_t>(stats->successes, 0));
+  total.similarity_mean = stats->similarity_mean;
+  total.similarity_m2 = stats->similarity_stddev * stats->similarity_stddev *
+                        static_cast<double>(stats->attempts);
+  total.similarity_min = stats->similarity_min;
+  total.similarity_max = stats->similarity_max;
+  total.time_mean = stats->time_mean;
+  total.time_m2 = stats->time_stddev * stats->time_stddev *
+                  static_cast<double>(stats->attempts);
+  for (int i = 0; i < OPENDSA_ANALYTICS_ERROR_KINDS; i++) {
+    total.errors[i] = static_cast<uint64_t>(std::max<int64_t>(stats->errors[i], 0));
+  }
+  for (int i = 0; i < OPENDSA_ANALYTICS_SIMILARITY_BUCKETS; i++) {
+    total.similarity_buckets[i] =
+        static_cast<uint64_t>(std::max<int64_t>(stats->similarity_buckets[i], 0));
+  }
+  return analytics->store.SetTotal(total) ? 0 : -1;
+}
+
+int32_t opendsa_analytics_reset(OpendsaAnalytics* analytics) {
+  if (analytics == nullptr) return -1;
+  return analytics->store.Reset() ? 0 : -1;
+}
+
+int32_t opendsa_analytics_flush(OpendsaAnalytics* analytics) {
+  if (analytics == nullptr) return -1;
+  return analytics->store.Flush() ? 0 : -1;
+}
+
+void opendsa_analytics_close(OpendsaAnalytics* analytics) {
+  delete analytics;
+}
+
+OpendsaAttemptLog* opendsa_attempt_log_open(const char* path) {
+  if (path == nullptr) return nullptr;
+  auto* handle = new OpendsaAttemptLog();
+  if (!handle->log.Open(path)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_attempt_log_append(OpendsaAttemptLog* log,
+                                   const OpendsaAttempt* attempt) {
+  if (log == nullptr || attempt == nullptr ||
+      !std::isfinite(attempt->similarity) ||
+      !std::isfinite(attempt->confidence)) {
+    return -1;
+  }
+  const char* recognized =
+      attempt->recognized != nullptr ? attempt->recognized : "";
+  const char* target = attempt->target != nullptr ? attempt->target : "";
+  opendsa::AttemptRow row;
+  row.timestamp_ms = attempt->timestamp_ms;
+  row.profile = log->log.Intern(attempt->profile != nullptr ? attempt->profile
+                                                            : "");
+  row.target = log->log.Intern(target);
+  if (row.profile == opendsa::AttemptLog::kNoId ||
+      row.target == opendsa::AttemptLog::kNoId) {
+    return -1;
+  }
+  row.level = static_cast<uint8_t>(std::clamp(attempt->level, 0, 255));
+  row.similarity = static_cast<float>(attempt->similarity);
+  row.confidence = static_cast<float>(attempt->confidence);
+  row.duration_ms = static_cast<uint32_t>(
+      std::clamp<int64_t>(attempt->duration_ms, 0, UINT32_MAX));
+  row.utc_offset_minutes =
+      static_cast<int16_t>(std::clamp(attempt->utc_offset_minutes, -1440, 1440));
+  if (!attempt->correct) {
+    row.errors = opendsa::kAttemptIncorrect;
+    thread_local opendsa::Diagnostics diagnostics;
+    ThreadEngine().Diagnose(recognized, target, &diagnostics);
+    for (const opendsa::DiagnosticEdit& edit : diagnostics.edits) {
+      row.errors |= 1u << static_cast<int>(edit.kind);
+      if (edit.kind == opendsa::EditKind::kConfusion) {
+        row.confusions |=
+            opendsa::AttemptLog::ConfusionBit(edit.expected, edit.actual);
+      }
+    }
+  }
+  return log->log.Append(row, recognized) ? 0 : -1;
+}
+
+int32_t opendsa_attempt_log_query(OpendsaAttemptLog* log,
+                                  const OpendsaAttemptQuery* query,
+                                  OpendsaAttemptQueryStats* stats) {
+  if (log == nullptr || query == nullptr ||
+      query->group_by < OPENDSA_ATTEMPT_GROUP_NONE ||
+      query->group_by > OPENDSA_ATTEMPT_GROUP_PROFILE) {
+    return -1;
+  }
+  log->groups.clear();
+  if (stats != nullptr) *stats = OpendsaAttemptQueryStats();
+
+  opendsa::AttemptQuery wanted;
+  wanted.from_ms = query->from_ms;
+  wanted.to_ms = query->to_ms;
+  wanted.min_level = query->min_level;
+  wanted.max_level = query->max_level;
+  wanted.errors = static_cast<uint32_t>(query->errors);
+  wanted.confusion_a = query->confusion_a;
+  wanted.confusion_b = query->confusion_b;
+  wanted.group_by = static_cast<opendsa::AttemptGroupBy>(query->group_by);
+  // Un profilo o un testo mai registrato non ha tentativi
+  if (query->profile != nullptr) {
+    const uint32_t id = log->log.Find(query->profile);
+    if (id == opendsa::AttemptLog::kNoId) return 0;
+    wanted.profile = id;
+  }
+  if (query->target != nullptr) {
+    const uint32_t id = log->log.Find(query->target);
+    if (id == opendsa::AttemptLog::kNoId) return 0;
+    wanted.target = id;
+  }
+
+  opendsa::AttemptQueryStats result;
+  log->log.Query(wanted, &log->groups, &result);
+  if (stats != nullptr) {
+    stats->chunks = static_cast<int64_t>(result.chunks);
+    stats->chunks_scanned = static_cast<int64_t>(result.chunks_scanned);
+    stats->rows_scanned = static_cast<int64_t>(result.rows_scanned);
+    stats->rows_matched = static_cast<int64_t>(result.rows_matched);
+    stats->columns_read = static_cast<int64_t>(result.columns_read);
+  }
+  return static_cast<int32_t>(log->groups.size());
+}
+
+int32_t opendsa_attempt_log_group(const OpendsaAttemptLog* log, int32_t index,
+                                  OpendsaAttemptGroup* out) {
+  if (log == nullptr || out == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= log->groups.size()) {
+    return -1;
+  }
+  const opendsa::AttemptGroup& group = log->groups[index];
+  const auto attempts = static_cast<double>(group.attempts);
+  out->key = group.key;
+  out->attempts = static_cast<int64_t>(group.attempts);
+  out->correct = static_cast<int64_t>(group.correct);
+  out->similarity_mean = group.similarity_sum / attempts;
+  out->duration_mean_ms = group.duration_sum_ms / attempts;
+  return 0;
+}
+
+const char* opendsa_attempt_log_string(const OpendsaAttemptLog* log,
+                                       int64_t id) {
+  if (log == nullptr || id < 0 || id >= opendsa::AttemptLog::kNoId) {
+    return nullptr;
+  }
+  const std::string* text = log->log.String(static_cast<uint32_t>(id));
+  return text != nullptr ? text->c_str() : nullptr;
+}
+
+int64_t opendsa_attempt_log_size(const OpendsaAttemptLog* log) {
+  return log != nullptr ? static_cast<int64_t>(log->log.size()) : 0;
+}
+
+int32_t opendsa_attempt_log_level_summary(const OpendsaAttemptLog* log,
+                                          const char* profile, int32_t level,
+                                          OpendsaAttemptSummary* out) {
+  if (log == nullptr || profile == nullptr || out == nullptr || level < 0) {
+    return -1;
+  }
+  const uint32_t id = log->log.Find(profile);
+  return ToAttemptSummary(
+      id != opendsa::AttemptLog::kNoId
+          ? log->log.views().Level(id, static_cast<uint32_t>(level))
+          : nullptr,
+      out);
+}
+
+int32_t opendsa_attempt_log_day_summary(const OpendsaAttemptLog* log,
+                                        const char* profile, int32_t day,
+                                        OpendsaAttemptSummary* out) {
+  if (log == nullptr || profile == nullptr || out == nullptr) return -1;
+  const uint32_t id = log->log.Find(profile);
+  return ToAttemptSummary(
+      id != opendsa::AttemptLog::kNoId ? log->log.views().Day(id, day)
+                                       : nullptr,
+      out);
+}
+
+void opendsa_attempt_log_close(OpendsaAttemptLog* log) { delete log; }
+
+OpendsaSessionJournal* opendsa_session_journal_open(const char* path,
+                                                    int32_t sync_window_ms) {
+  if (path == nullptr || sync_window_ms < 0) return nullptr;
+  auto* handle = new OpendsaSessionJournal();
+  if (!handle->journal.Open(path,
+                            std::chrono::milliseconds(sync_window_ms))) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_session_journal_count(const OpendsaSessionJournal* journal) {
+  return journal != nullptr
+             ? static_cast<int32_t>(journal->journal.records().size())
+             : 0;
+}
+
+int32_t opendsa_session_journal_record(const OpendsaSessionJournal* journal,
+                                       int32_t index, int32_t* type,
+                                       const char** data, int32_t* length) {
+  if (journal == nullptr || type == nullptr || data == nullptr ||
+      length == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= journal->journal.records().size()) {
+    return -1;
+  }
+  const auto& [kind, payload] =
+      journal->journal.records()[static_cast<size_t>(index)];
+  *type = kind;
+  *data = payload.data();
+  *length = static_cast<int32_t>(payload.size());
+  return 0;
+}
+
+int32_t opendsa_session_journal_begin(OpendsaSessionJournal* journal,
+                                      const char* data, int32_t length) {
+  if (journal == nullptr || (data == nullptr && length > 0) || length < 0) {
+    return -1;
+  }
+  return journal->journal.Begin(std::string_view(data, length)) ? 0 : -1;
+}
+
+int32_t opendsa_session_journal_append(OpendsaSessionJournal* journal,
+                                       const char* data, int32_t length) {
+  if (journal == nullptr || (data == nullptr && length > 0) || length < 0) {
+    return -1;
+  }
+  return journal->journal.Append(std::string_view(data, length)) ? 0 : -1;
+}
+
+int32_t opendsa_session_journal_sync(OpendsaSessionJournal* journal) {
+  if (journal == nullptr) return -1;
+  return journal->journal.Sync() ? 0 : -1;
+}
+
+int32_t opendsa_session_journal_commit(OpendsaSessionJournal* journal) {
+  if (journal == nullptr) return -1;
+  return journal->journal.Commit() ? 0 : -1;
+}
+
+void opendsa_session_journal_close(OpendsaSessionJournal* journal) {
+  delete journal;
+}
+
+OpendsaLogger* opendsa_logger_open(const char* dir, const char* prefix,
+                                   const OpendsaLoggerOptions* options) {
+  if (dir == nullptr || prefix == nullptr) return nullptr;
+  opendsa::AsyncLoggerOptions logger_options;
+  if (options != nullptr) {
+    if (options->max_file_bytes <= 0 || options->ring_capacity <= 0 ||
+        options->max_pending <= 0 || options->flush_interval_ms <= 0) {
+      return nullptr;
+    }
+    logger_options.max_file_bytes =
+        static_cast<uint64_t>(options->max_file_bytes);
+    logger_options.ring_capacity =
+        static_cast<uint32_t>(options->ring_capacity);
+    logger_options.max_pending = static_cast<uint32_t>(options->max_pending);
+    logger_options.flush_interval =
+        std::chrono::milliseconds(options->flush_interval_ms);
+  }
+  auto* handle = new OpendsaLogger();
+  if (!handle->logger.Open(dir, prefix, logger_options)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int32_t opendsa_logger_log(OpendsaLogger* logger, int32_t level,
+                           const char* tag, const char* message,
+                           int32_t length) {
+  if (logger == nullptr || message == nullptr || level < OPENDSA_LOG_DEBUG ||
+      level > OPENDSA_LOG_ERROR) {
+    return -1;
+  }
+  const size_t size =
+      length < 0 ? std::strlen(message) : static_cast<size_t>(length);
+  return logger->logger.Log(static_cast<opendsa::LogLevel>(level),
+                            tag == nullptr ? std::string_view() : tag,
+                            std::string_view(message, size))
+             ? 0
+             : -1;
+}
+
+int32_t opendsa_logger_flush(OpendsaLogger* logger, int32_t sync) {
+  if (logger == nullptr) return -1;
+  return logger->logger.Flush(sync != 0) ? 0 : -1;
+}
+
+int32_t opendsa_logger_recent(OpendsaLogger* logger, int32_t max) {
+  if (logger == nullptr || max < 0) return -1;
+  logger->lines = logger->logger.Recent(static_cast<size_t>(max));
+  return static_cast<int32_t>(logger->lines.size());
+}
+
+int32_t opendsa_logger_query(OpendsaLogger* logger,
+                             const OpendsaLogQuery* query,
+                             OpendsaLogQueryStats* stats) {
+  if (stats != nullptr) *stats = OpendsaLogQueryStats();
+  if (logger == nullptr || query == nullptr || query->limit < 0 ||
+      query->min_level < OPENDSA_LOG_DEBUG ||
+      query->min_level > OPENDSA_LOG_ERROR) {
+    return -1;
+  }
+  opendsa::LogQuery filter;
+  filter.from_ms = query->from_ms;
+  filter.to_ms = query->to_ms;
+  filter.min_level = static_cast<opendsa::LogLevel>(query->min_level);
+  if (query->tag != nullptr) filter.tag = query->tag;
+  filter.limit = static_cast<size_t>(query->limit);
+  opendsa::LogQueryStats query_stats;
+  const bool ok = logger->logger.Query(filter, &logger->lines, &query_stats);
+  if (stats != nullptr) {
+    stats->segments = static_cast<int64_t>(query_stats.segments);
+    stats->blocks = static_cast<int64_t>(query_stats.blocks);
+    stats->blocks_read = static_cast<int64_t>(query_stats.blocks_read);
+    stats->lines_scanned = static_cast<int64_t>(query_stats.lines_scanned);
+    stats->lines_matched = static_cast<int64_t>(query_stats.lines_matched);
+    stats->incomplete = ok ? 0 : 1;
+  }
+  return static_cast<int32_t>(logger->lines.size());
+}
+
+const char* opendsa_logger_line(const OpendsaLogger* logger, int32_t index) {
+  if (logger == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= logger->lines.size()) {
+    return nullptr;
+  }
+  return logger->lines[static_cast<size_t>(index)].c_str();
+}
+
+const char* opendsa_logger_read_day(OpendsaLogger* logger, const char* date,
+                                    int64_t* length) {
+  if (logger == nullptr || date == nullptr || length == nullptr) {
+    return nullptr;
+  }
+  if (!logger->logger.ReadDay(date, &logger->day)) return nullptr;
+  *length = static_cast<int64_t>(logger->day.size());
+  return logger->day.c_str();
+}
+
+void opendsa_logger_stats(const OpendsaLogger* logger,
+                          OpendsaLoggerStats* out) {
+  if (out == nullptr) return;
+  *out = OpendsaLoggerStats();
+  if (logger == nullptr) return;
+  const opendsa::AsyncLoggerStats stats = logger->logger.stats();
+  out->records_logged = static_cast<int64_t>(stats.records_logged);
+  out->records_dropped = static_cast<int64_t>(stats.records_dropped);
+  out->records_written = static_cast<int64_t>(stats.records_written);
+  out->batches = static_cast<int64_t>(stats.batches);
+  out->bytes_written = static_cast<int64_t>(stats.bytes_written);
+  out->rotations = static_cast<int64_t>(stats.rotations);
+  out->bytes_archived = static_cast<int64_t>(stats.bytes_archived);
+  out->write_errors = static_cast<int64_t>(stats.write_errors);
+}
+
+void opendsa_logger_close(OpendsaLogger* logger) { delete logger; }
+
+OpendsaAudioArchive* opendsa_audio_archive_open(
+    const char* dir, const OpendsaAudioArchiveOptions* options) {
+  if (dir == nullptr) return nullptr;
+  opendsa::AudioArchiveOptions archive_options;
+  if (options != nullptr) {
+    if (options->max_bytes < 0 || options->max_age_ms < 0) return nullptr;
+    archive_options.max_bytes = static_cast<uint64_t>(options->max_bytes);
+    archive_options.max_age_ms = options->max_age_ms;
+  }
+  auto* handle = new OpendsaAudioArchive();
+  if (!handle->archive.Open(dir, archive_options)) {
+    delete handle;
+    return nullptr;
+  }
+  return handle;
+}
+
+int64_t opendsa_audio_archive_add_wav(OpendsaAudioArchive* archive,
+                                      const char* wav_path,
+                                      const char* profile, const char* target,
+                                      int64_t recorded_ms) {
+  if (archive == nullptr || wav_path == nullptr) return -1;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  const uint64_t id = archive->archive.AddWav(
+      wav_path, profile == nullptr ? "" : profile,
+      target == nullptr ? "" : target, recorded_ms);
+  return id == 0 ? -1 : static_cast<int64_t>(id);
+}
+
+OpendsaAudioArchiveJob* opendsa_audio_archive_add_wav_start(
+    OpendsaAudioArchive* archive, const char* wav_path, const char* profile,
+    const char* target, int64_t recorded_ms) {
+  if (archive == nullptr || wav_path == nullptr) return nullptr;
+  auto* job = new OpendsaAudioArchiveJob();
+  // Le stringhe vengono copiate: il chiamante può liberarle subito
+  job->thread = std::thread(
+      [archive, job, recorded_ms](std::string path, std::string clip_profile,
+                                  std::string clip_target) {
+        job->id = opendsa_audio_archive_add_wav(archive, path.c_str(),
+                                                clip_profile.c_str(),
+                                                clip_target.c_str(),
+                                                recorded_ms);
+        job->done.store(true, std::memory_order_release);
+      },
+      std::string(wav_path), std::string(profile == nullptr ? "" : profile),
+      std::string(target == nullptr ? "" : target));
+  return job;
+}
+
+int32_t opendsa_audio_archive_add_done(const OpendsaAudioArchiveJob* job) {
+  return job == nullptr || job->done.load(std::memory_order_acquire) ? 1 : 0;
+}
+
+int64_t opendsa_audio_archive_add_wait(OpendsaAudioArchiveJob* job) {
+  if (job == nullptr) return -1;
+  if (job->thread.joinable()) job->thread.join();
+  return job->id;
+}
+
+void opendsa_audio_archive_add_free(OpendsaAudioArchiveJob* job) {
+  if (job == nullptr) return;
+  if (job->thread.joinable()) job->thread.join();
+  delete job;
+}
+
+int32_t opendsa_audio_archive_list(OpendsaAudioArchive* archive,
+                                   const char* profile, const char* target) {
+  if (archive == nullptr) return -1;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  archive->clips = archive->archive.List(profile == nullptr ? "" : profile,
+                                         target == nullptr ? "" : target);
+  return static_cast<int32_t>(archive->clips.size());
+}
+
+int32_t opendsa_audio_archive_clip(const OpendsaAudioArchive* archive,
+                                   int32_t index, OpendsaAudioClip* out) {
+  if (archive == nullptr || out == nullptr || index < 0 ||
+      static_cast<size_t>(index) >= archive->clips.size()) {
+    return -1;
+  }
+  const opendsa::AudioClip& clip = archive->clips[static_cast<size_t>(index)];
+  *out = OpendsaAudioClip();
+  out->id = static_cast<int64_t>(clip.record.id);
+  out->recorded_ms = clip.record.recorded_ms;
+  out->accessed_ms = clip.record.accessed_ms;
+  out->duration_ms =
+      static_cast<int64_t>(clip.record.frames * 1000 / clip.record.sample_rate);
+  out->stored_bytes = static_cast<int64_t>(clip.record.stored_bytes);
+  out->sample_rate = static_cast<int32_t>(clip.record.sample_rate);
+  out->channels = clip.record.channels;
+  out->profile = clip.profile.c_str();
+  out->target = clip.target.c_str();
+  return 0;
+}
+
+int32_t opendsa_audio_archive_export_wav(OpendsaAudioArchive* archive,
+                                         int64_t id, int64_t now_ms,
+                                         const char* wav_path) {
+  if (archive == nullptr || wav_path == nullptr || id <= 0) return -1;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  return archive->archive.ExportWav(static_cast<uint64_t>(id), now_ms,
+                                    wav_path)
+             ? 0
+             : -1;
+}
+
+int32_t opendsa_audio_archive_remove(OpendsaAudioArchive* archive,
+                                     int64_t id) {
+  if (archive == nullptr || id <= 0) return -1;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  return archive->archive.Remove(static_cast<uint64_t>(id)) ? 0 : -1;
+}
+
+int32_t opendsa_audio_archive_evict(OpendsaAudioArchive* archive,
+                                    int64_t now_ms) {
+  if (archive == nullptr) return -1;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  return static_cast<int32_t>(archive->archive.Evict(now_ms));
+}
+
+void opendsa_audio_archive_stats(const OpendsaAudioArchive* archive,
+                                 OpendsaAudioArchiveStats* out) {
+  if (out == nullptr) return;
+  *out = OpendsaAudioArchiveStats();
+  if (archive == nullptr) return;
+  std::lock_guard<std::mutex> lock(archive->mutex);
+  const opendsa::AudioArchiveStats stats = archive->archive.stats();
+  out->clips = static_cast<int64_t>(stats.clips);
+  out->stored_bytes = static_cast<int64_t>(stats.stored_bytes);
+  out->raw_bytes = static_cast<int64_t>(stats.raw_bytes);
+  out->evicted = static_cast<int64_t>(stats.evicted);
+}
+
+void opendsa_audio_archive_close(OpendsaAudioArchive* archive) {
+  delete archive;
+}
+
+OpendsaSpeechModel* opendsa_speech_model_open(const char* dir) {
+  if (dir == nullptr) return nullptr;
+  auto* model = new OpendsaSpeechModel();
+  model->model.Load(dir);
+  return model;
+}
+
+int32_t opendsa_speech_model_ready(const OpendsaSpeechModel* model) {
+  if (model == nullptr) return -1;
+  if (!model->model.loaded()) return 0;
+  return model->model.Wait() ? 1 : -1;
+}
+
+void opendsa_speech_model_close(OpendsaSpeechModel* model) {
+  delete model;
+}
+
+OpendsaFileRecognition* opendsa_recognize_file_start(
+    const OpendsaSpeechModel* model, const char* wav_path, int32_t chunk_ms) {
+  if (model == nullptr || wav_path == nullptr) return nullptr;
+  opendsa::FileRecognitionOptions options;
+  if (chunk_ms > 0) options.chunk_ms = static_cast<uint32_t>(chunk_ms);
+  auto* recognition = new OpendsaFileRecognition();
+  if (!recognition->job.Start(&model->model, wav_path, options)) {
+    delete recognition;
+    return nullptr;
+  }
+  return recognition;
+}
+
+double opendsa_recognize_file_progress(
+    const OpendsaFileRecognition* recognition) {
+  if (recognition == nullptr) return 0.0;
+  if (recognition->job.done()) return 1.0;
+  // 1 solo con il risultato finale pronto: opendsa_recognize_file_wait non
+  // deve bloccare il chiamante
+  const uint64_t frames = recognition->job.frames();
+  if (frames == 0) return 0.0;
+  const double processed = static_cast<double>(recognition->job.processed()) /
+                           static_cast<double>(frames);
+  return std::min(processed, std::nextafter(1.0, 0.0));
+}
+
+int32_t opendsa_recognize_file_wait(OpendsaFileRecognition* recognition,
+                                    OpendsaFileRecognitionResult* out) {
+  if (out != nullptr) *out = {};
+  if (recognition == nullptr || !recognition->job.Wait()) return -1;
+  if (out != nullptr) {
+    const opendsa::FileRecognition& result = recognition->job.result();
+    out->text = result.text.c_str();
+    out->word_count = static_cast<int32_t>(result.words.size());
+    out->sample_rate = static_cast<int32_t>(result.sample_rate);
+    out->audio_seconds = result.audio_seconds;
+    out->elapsed_seconds = result.elapsed_seconds;
+  }
+  return 0;
+}
+
+int32_t opendsa_recognize_file_word(const OpendsaFileRecognition* recognition,
+                                    int32_t index,
+                                    OpendsaRecognizedWord* out) {
+  if (recognition == nullptr || out == nullptr || index < 0) return -1;
+  const std::vector<opendsa::RecognizedWord>& words =
+      recognition->job.result().words;
+  if (static_cast<size_t>(index) >= words.size()) return -1;
+  const opendsa::RecognizedWord& word = words[index];
+  out->word = word.word.c_str();
+  out->start = word.start;
+  out->end = word.end;
+  out->confidence = word.confidence;
+  return 0;
+}
+
+void opendsa_recognize_file_free(OpendsaFileRecognition* recognition) {
+  delete recognition;
+}
+
+}  // extern "C"
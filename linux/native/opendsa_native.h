@@ -0,0 +1,1127 @@
+// linux/native/opendsa_native.h
+//
+// API C della libreria nativa di OpenDSA, caricata da Dart tramite FFI
+// (vedi lib/services/native/opendsa_native_bindings.dart). Tutte le stringhe
+// sono UTF-8 terminate da zero.
+
+#ifndef OPENDSA_NATIVE_OPENDSA_NATIVE_H_
+#define OPENDSA_NATIVE_OPENDSA_NATIVE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OPENDSA_EXPORT __attribute__((visibility("default")))
+
+// --- Similarità e diagnosi degli errori ---
+
+// Tipi di errore riportati in OpendsaEdit.kind
+#define OPENDSA_EDIT_INVERSION 1
+#define OPENDSA_EDIT_CONFUSION 2
+#define OPENDSA_EDIT_SEQUENCE 3
+#define OPENDSA_EDIT_OMISSION 4
+#define OPENDSA_EDIT_INSERTION 5
+#define OPENDSA_EDIT_SUBSTITUTION 6
+
+typedef struct {
+  int32_t kind;
+  int32_t target_pos;      // Indice di code point nel testo atteso normalizzato
+  int32_t recognized_pos;  // Indice di code point nel testo letto normalizzato
+  int32_t length;          // Caratteri coinvolti (sequenze e inversioni)
+  uint32_t expected;       // Code point atteso, 0 se assente
+  uint32_t actual;         // Code point letto, 0 se assente
+} OpendsaEdit;
+
+typedef struct {
+  int32_t inversions;
+  int32_t confusions;
+  int32_t sequence_errors;
+  int32_t omissions;
+  int32_t insertions;
+  int32_t substitutions;
+  int32_t edit_count;     // Errori totali trovati, anche oltre edit_capacity
+  int32_t edit_capacity;  // Impostato dal chiamante: dimensione di edits
+  OpendsaEdit* edits;     // Buffer del chiamante, può essere NULL
+  double distance;        // Distanza pesata di Damerau-Levenshtein
+  double similarity;      // Similarità combinata in [0, 1]
+} OpendsaDiagnostics;
+
+// Similarità combinata fra testo letto e testo atteso, equivalente a
+// TextSimilarity.calculateSimilarity.
+OPENDSA_EXPORT double opendsa_similarity(const char* recognized,
+                                         const char* target);
+
+// Versione dei parametri del punteggio (kSimilarityParametersVersion): se
+// differisce da quella con cui è stato calcolato lo storico, le similarità
+// salvate vanno ricalcolate.
+OPENDSA_EXPORT int32_t opendsa_similarity_parameters_version(void);
+
+// Analizza gli errori di lettura in un solo passaggio. I contatori e la
+// similarità sono sempre compilati; gli errori vengono copiati in
+// out->edits fino a out->edit_capacity. Restituisce 0 in caso di successo,
+// -1 se gli argomenti non sono validi.
+OPENDSA_EXPORT int32_t opendsa_diagnose(const char* recognized,
+                                        const char* target,
+                                        OpendsaDiagnostics* out);
+
+// --- Costi di confusione appresi per profilo ---
+
+// Modello opaco delle confusioni di un profilo (opendsa::ConfusionModel).
+typedef struct OpendsaConfusionModel OpendsaConfusionModel;
+
+// Crea un modello e lo carica da |path| se il file esiste. Restituisce NULL
+// se il file esiste ma è corrotto o di una versione non supportata.
+OPENDSA_EXPORT OpendsaConfusionModel* opendsa_confusion_model_open(
+    const char* path);
+
+// Salva il modello in modo atomico. Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_confusion_model_save(
+    const OpendsaConfusionModel* model, const char* path);
+
+// Aggiorna il modello con un tentativo, allineando i testi con i costi
+// standard. Restituisce il numero di tentativi osservati finora.
+OPENDSA_EXPORT int32_t opendsa_confusion_model_observe(
+    OpendsaConfusionModel* model, const char* recognized, const char* target);
+
+OPENDSA_EXPORT void opendsa_confusion_model_free(OpendsaConfusionModel* model);
+
+// Varianti di opendsa_similarity e opendsa_diagnose con i costi del modello
+// indicato; con |model| NULL usano la tabella predefinita. Il modello non
+// va aggiornato mentre è in uso su un altro thread.
+OPENDSA_EXPORT double opendsa_similarity_with_model(
+    const char* recognized, const char* target,
+    const OpendsaConfusionModel* model);
+
+OPENDSA_EXPORT int32_t opendsa_diagnose_with_model(
+    const char* recognized, const char* target,
+    const OpendsaConfusionModel* model, OpendsaDiagnostics* out);
+
+// --- Ricalcolo in blocco dello storico dei tentativi ---
+
+// Lavoro di ricalcolo in corso (opendsa::BatchRescorer).
+typedef struct OpendsaRescoreJob OpendsaRescoreJob;
+
+// Avvia il ricalcolo della similarità di |count| tentativi su |threads|
+// thread (0 = uno per core), con i costi di |model| o con quelli predefiniti
+// se |model| è NULL. Le stringhe e i costi vengono copiati: il chiamante può
+// liberarli subito, e il modello può essere aggiornato durante il lavoro.
+// Restituisce NULL se gli argomenti non sono validi.
+OPENDSA_EXPORT OpendsaRescoreJob* opendsa_rescore_start(
+    const char* const* recognized, const char* const* targets, int32_t count,
+    const OpendsaConfusionModel* model, int32_t threads);
+
+// Tentativi già ricalcolati. Non blocca: può essere interrogata a intervalli
+// per mostrare l'avanzamento.
+OPENDSA_EXPORT int32_t opendsa_rescore_progress(const OpendsaRescoreJob* job);
+
+// Attende la fine del lavoro e copia le similarità in |out|, che deve avere
+// spazio per |count| valori. Restituisce il numero di valori copiati.
+OPENDSA_EXPORT int32_t opendsa_rescore_wait(OpendsaRescoreJob* job,
+                                            double* out);
+
+// Libera il lavoro, attendendone prima la fine.
+OPENDSA_EXPORT void opendsa_rescore_free(OpendsaRescoreJob* job);
+
+// --- Sillabazione e caratteristiche delle parole ---
+
+// Caratteristiche ortografiche di una parola (flags)
+#define OPENDSA_WORD_COMPLEX_SYLLABLES 0x0001
+#define OPENDSA_WORD_ACCENTED 0x0002
+#define OPENDSA_WORD_DIGRAPH 0x0004
+#define OPENDSA_WORD_CONSONANT_CLUSTER 0x0008
+#define OPENDSA_WORD_GEMINATE 0x0010
+#define OPENDSA_WORD_HIATUS 0x0020
+#define OPENDSA_WORD_DIPHTHONG 0x0040
+#define OPENDSA_WORD_TRIPHTHONG 0x0080
+
+typedef struct {
+  int32_t syllables;
+  int32_t stress;              // Sillaba tonica contata dalla fine
+  int32_t flags;               // OPENDSA_WORD_*
+  int32_t orthographic_depth;  // Lettere senza corrispondenza uno a uno
+} OpendsaWordFeatures;
+
+// Sillaba |word| (minuscolo) e ne calcola le caratteristiche. Se
+// |syllable_starts| non è NULL riceve fino a |capacity| indici (in code
+// point) di inizio sillaba. Restituisce il numero di sillabe, -1 se gli
+// argomenti non sono validi.
+OPENDSA_EXPORT int32_t opendsa_word_features(const char* word,
+                                             OpendsaWordFeatures* out,
+                                             int32_t* syllable_starts,
+                                             int32_t capacity);
+
+// --- Lessico precompilato delle parole degli esercizi ---
+
+// Voce del lessico, letta direttamente dal file mappato. La parola è
+// opendsa_lexicon_strings() + text_offset, terminata da zero.
+typedef struct {
+  uint32_t text_offset;
+  uint16_t text_bytes;  // Lunghezza in byte, senza il terminatore
+  uint16_t length;      // Lunghezza in code point
+  uint8_t syllables;
+  uint8_t level;        // Livello di esercizio (1 = parole facili)
+  uint16_t flags;       // OPENDSA_WORD_*
+  uint8_t stress;       // Sillaba tonica contata dalla fine (2 = piana)
+  uint8_t orthographic_depth;
+  uint16_t reserved;
+} OpendsaLexiconEntry;
+
+// Pronuncia attesa di una voce: fonemi UTF-8 (vedi opendsa_pronounce) in
+// opendsa_lexicon_strings() + offset, terminati da zero.
+typedef struct {
+  uint32_t offset;
+  uint16_t bytes;   // Lunghezza in byte, senza il terminatore
+  uint16_t phones;  // Numero di fonemi
+} OpendsaLexiconPronunciation;
+
+// Lessico mappato in memoria (opendsa::Lexicon).
+typedef struct OpendsaLexicon OpendsaLexicon;
+
+// Mappa il lessico generato in fase di build. Restituisce NULL se il file
+// manca o non è valido.
+OPENDSA_EXPORT OpendsaLexicon* opendsa_lexicon_open(const char* path);
+
+OPENDSA_EXPORT int32_t opendsa_lexicon_size(const OpendsaLexicon* lexicon);
+
+// Array delle voci e area delle stringhe, validi fino alla chiusura.
+OPENDSA_EXPORT const OpendsaLexiconEntry* opendsa_lexicon_entries(
+    const OpendsaLexicon* lexicon);
+OPENDSA_EXPORT const char* opendsa_lexicon_strings(
+    const OpendsaLexicon* lexicon);
+
+// Pronunce delle voci, con lo stesso indice di opendsa_lexicon_entries.
+OPENDSA_EXPORT const OpendsaLexiconPronunciation* opendsa_lexicon_pronunciations(
+    const OpendsaLexicon* lexicon);
+
+// Voci del livello |level|: restituisce quante sono e scrive in |first|
+// l'indice della prima.
+OPENDSA_EXPORT int32_t opendsa_lexicon_level_range(
+    const OpendsaLexicon* lexicon, int32_t level, int32_t* first);
+
+// Come opendsa_similarity_with_model con testo atteso la voce |index|: la
+// pronuncia viene letta dal lessico invece di essere ricalcolata. |model|
+// può essere NULL. Restituisce 0 se gli argomenti non sono validi.
+OPENDSA_EXPORT double opendsa_lexicon_similarity(
+    const OpendsaLexicon* lexicon, int32_t index, const char* recognized,
+    const OpendsaConfusionModel* model);
+
+OPENDSA_EXPORT void opendsa_lexicon_close(OpendsaLexicon* lexicon);
+
+// --- Pronuncia attesa ---
+
+// Trascrive |word| in fonemi italiani, un code point IPA ciascuno (vedi
+// linux/native/phonemizer.h), per le parole che non sono nel lessico. Le
+// parole recenti restano in una cache per thread. Copia in |out| al massimo
+// |capacity| - 1 byte seguiti da zero e restituisce la lunghezza completa in
+// byte, come snprintf; -1 se gli argomenti non sono validi.
+OPENDSA_EXPORT int32_t opendsa_pronounce(const char* word, char* out,
+                                         int32_t capacity);
+
+// --- Indice delle parole per livello e difficoltà ---
+
+// Difficoltà di una parola (come Difficulty.index in Dart)
+#define OPENDSA_DIFFICULTY_ANY (-1)
+#define OPENDSA_DIFFICULTY_EASY 0
+#define OPENDSA_DIFFICULTY_MEDIUM 1
+#define OPENDSA_DIFFICULTY_HARD 2
+
+// Vincoli di una richiesta; i limiti a 0 non vengono applicati.
+typedef struct {
+  int32_t level;
+  int32_t difficulty;  // OPENDSA_DIFFICULTY_*
+  int32_t min_syllables;
+  int32_t max_syllables;
+  int32_t min_length;
+  int32_t max_length;
+} OpendsaWordQuery;
+
+// Indice opaco (opendsa::ContentIndex).
+typedef struct OpendsaContentIndex OpendsaContentIndex;
+
+// Costruisce l'indice di |lexicon| mescolato con |seed| e, se |state_path|
+// non è NULL, ripristina le permutazioni e i cursori salvati (se compatibili
+// con il lessico). Il lessico deve restare aperto finché l'indice è in uso.
+OPENDSA_EXPORT OpendsaContentIndex* opendsa_content_index_open(
+    const OpendsaLexicon* lexicon, const char* state_path, uint64_t seed);
+
+// Prossima parola non ancora proposta compatibile con |query|, come indice
+// nel lessico; -1 se nessuna parola è compatibile.
+OPENDSA_EXPORT int32_t opendsa_content_index_next(
+    OpendsaContentIndex* index, const OpendsaWordQuery* query);
+
+// Parole compatibili con |query|.
+OPENDSA_EXPORT int32_t opendsa_content_index_count(
+    const OpendsaContentIndex* index, const OpendsaWordQuery* query);
+
+// Salva permutazioni e cursori. Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_content_index_save(
+    const OpendsaContentIndex* index, const char* path);
+
+OPENDSA_EXPORT void opendsa_content_index_free(OpendsaContentIndex* index);
+
+// --- Suddivisione del testo in token ---
+
+// Tipo di un token (OpendsaTokenView.kinds)
+#define OPENDSA_TOKEN_WORD 1
+#define OPENDSA_TOKEN_NUMBER 2
+#define OPENDSA_TOKEN_PUNCTUATION 3
+
+// Caratteristiche di un token (OpendsaTokenView.flags)
+#define OPENDSA_TOKEN_SENTENCE_START 0x01
+#define OPENDSA_TOKEN_PARAGRAPH_START 0x02
+#define OPENDSA_TOKEN_PAGE_START 0x04
+#define OPENDSA_TOKEN_SPACE_BEFORE 0x08
+#define OPENDSA_TOKEN_CAPITALIZED 0x10
+#define OPENDSA_TOKEN_ELISION 0x20
+#define OPENDSA_TOKEN_SENTENCE_END 0x40
+
+// Array per colonne di un testo suddiviso, validi fino a
+// opendsa_tokens_free. Gli array per token hanno token_count elementi; le
+// posizioni sono in byte UTF-8 (begins/ends) e in unità UTF-16, cioè indici
+// delle String Dart (utf16_begins/utf16_ends), con la fine esclusa.
+typedef struct {
+  int32_t token_count;
+  int32_t sentence_count;
+  int32_t paragraph_count;
+  int32_t normalized_size;
+  const uint32_t* begins;
+  const uint32_t* ends;
+  const uint32_t* utf16_begins;
+  const uint32_t* utf16_ends;
+  const uint8_t* kinds;               // OPENDSA_TOKEN_WORD...
+  const uint8_t* flags;               // OPENDSA_TOKEN_SENTENCE_START...
+  const uint32_t* normalized_offsets;  // In normalized, vuoti per la punteggiatura
+  const uint32_t* normalized_lengths;
+  const char* normalized;              // Forme normalizzate, non terminate da zero
+  // Primo token di ogni frase e paragrafo, seguito da token_count: la frase
+  // i va da sentence_starts[i] a sentence_starts[i + 1].
+  const uint32_t* sentence_starts;
+  const uint32_t* paragraph_starts;
+} OpendsaTokenView;
+
+// Testo suddiviso in token (opendsa::TokenizedText).
+typedef struct OpendsaTokens OpendsaTokens;
+
+// Suddivide |length| byte di |text| (-1 = fino al terminatore) in parole,
+// numeri e punteggiatura, con i confini di frase e di paragrafo.
+// Restituisce NULL se gli argomenti non sono validi.
+OPENDSA_EXPORT OpendsaTokens* opendsa_tokenize(const char* text,
+                                               int32_t length);
+
+// Compila |out| con gli array di |tokens|. Restituisce il numero di token,
+// -1 se gli argomenti non sono validi.
+OPENDSA_EXPORT int32_t opendsa_tokens_view(const OpendsaTokens* tokens,
+                                           OpendsaTokenView* out);
+
+// Allinea le parole di |recognized| ai token [first, first + count) e
+// scrive in |out|, fino a |capacity| elementi, l'indice del token
+// corrispondente a ogni parola letta (-1 se nessuno). Restituisce il numero
+// di parole lette, anche oltre |capacity|, o -1 se gli argomenti non sono
+// validi.
+OPENDSA_EXPORT int32_t opendsa_tokens_align(const OpendsaTokens* tokens,
+                                            int32_t first, int32_t count,
+                                            const char* recognized,
+                                            int32_t* out, int32_t capacity);
+
+OPENDSA_EXPORT void opendsa_tokens_free(OpendsaTokens* tokens);
+
+// --- Pacchetti dei testi di lettura ---
+
+// Pacchetto mappato in memoria (opendsa::ContentPack).
+typedef struct OpendsaContentPack OpendsaContentPack;
+
+// Apre il pacchetto generato in fase di build, tenendo in cache fino a
+// |cached_pages| pagine suddivise in token (0 = valore predefinito).
+// Restituisce NULL se il file manca o non è valido.
+OPENDSA_EXPORT OpendsaContentPack* opendsa_content_pack_open(
+    const char* path, int32_t cached_pages);
+
+// Numero di pagine.
+OPENDSA_EXPORT int32_t opendsa_content_pack_size(
+    const OpendsaContentPack* pack);
+
+// Testo UTF-8 (non terminato da zero) della pagina |index|, con la
+// lunghezza in byte in |length|. Il puntatore è valido fino alla chiamata
+// successiva sullo stesso pacchetto. Restituisce NULL se l'indice non è
+// valido.
+OPENDSA_EXPORT const char* opendsa_content_pack_page(OpendsaContentPack* pack,
+                                                     int32_t index,
+                                                     int32_t* length);
+
+// Token della pagina |index|, presi dalla cache o calcolati ora. Il
+// risultato va liberato con opendsa_tokens_free e resta valido anche dopo
+// la chiusura del pacchetto. Restituisce NULL se l'indice non è valido.
+OPENDSA_EXPORT OpendsaTokens* opendsa_content_pack_tokens(
+    OpendsaContentPack* pack, int32_t index);
+
+OPENDSA_EXPORT void opendsa_content_pack_close(OpendsaContentPack* pack);
+
+// --- Archivio a log del profilo ---
+
+// Log del profilo (opendsa::ProfileStore): una mappa chiave -> valore in cui
+// ogni modifica viene accodata come record con CRC. Con una finestra di
+// raggruppamento le modifiche vengono scritte insieme da un thread interno.
+typedef struct OpendsaProfileLog OpendsaProfileLog;
+
+// Coppia chiave-valore, non terminate da zero. I puntatori restano validi
+// fino alla modifica successiva del log.
+typedef struct {
+  const char* key;
+  int32_t key_length;
+  const char* value;
+  int32_t value_length;
+} OpendsaProfileEntry;
+
+typedef struct {
+  int64_t records_replayed;  // Record riapplicati all'apertura
+  int64_t records_appended;  // Record scritti da questa istanza
+  int64_t writes_skipped;    // Scritture evitate: valore invariato
+  int64_t bytes_truncated;   // Coda interrotta da un crash, scartata
+  int64_t compactions;
+  int64_t log_bytes;         // Dimensione del file
+  int64_t live_bytes;        // Dimensione di uno snapshot dello stato
+  int64_t writes_requested;  // Put e remove ricevuti
+  int64_t writes_coalesced;  // Modifiche sostituite da una più recente
+  int64_t commits;           // Scritture sul file, un fsync ciascuna
+  int64_t failed_commits;
+} OpendsaProfileLogStats;
+
+// Apre (o crea) il log in |path| e ne riapplica i record; una coda troncata
+// o corrotta viene scartata. Restituisce NULL se il file non è accessibile
+// o non è un log di profilo.
+OPENDSA_EXPORT OpendsaProfileLog* opendsa_profile_log_open(const char* path);
+
+OPENDSA_EXPORT int32_t opendsa_profile_log_size(const OpendsaProfileLog* log);
+
+// Coppia |index| in ordine di chiave. Restituisce 0, -1 se l'indice non è
+// valido.
+OPENDSA_EXPORT int32_t opendsa_profile_log_entry(const OpendsaProfileLog* log,
+                                                 int32_t index,
+                                                 OpendsaProfileEntry* out);
+
+// Valore di |key| con la sua lunghezza in |length|, NULL se assente. Valido
+// fino alla modifica successiva.
+OPENDSA_EXPORT const char* opendsa_profile_log_get(const OpendsaProfileLog* log,
+                                                   const char* key,
+                                                   int32_t* length);
+
+// Imposta |key| ai primi |length| byte di |value| (-1 = strlen), accodando
+// un record con fsync, o mettendolo in attesa se è attiva una finestra di
+// raggruppamento. Restituisce 1 se lo stato è cambiato, 0 se il valore non
+// era cambiato, -1 se questa scrittura o una precedente in attesa non è
+// riuscita (verrà ritentata).
+OPENDSA_EXPORT int32_t opendsa_profile_log_put(OpendsaProfileLog* log,
+                                               const char* key,
+                                               const char* value,
+                                               int32_t length);
+
+// Rimuove |key|. Restituisce 1 se rimossa, 0 se assente, -1 in caso di
+// errore.
+OPENDSA_EXPORT int32_t opendsa_profile_log_remove(OpendsaProfileLog* log,
+                                                  const char* key);
+
+// Raggruppa le modifiche che arrivano entro |milliseconds| dalla prima in
+// una sola scrittura; 0 (il default) le scrive una per una.
+OPENDSA_EXPORT void opendsa_profile_log_set_commit_window(
+    OpendsaProfileLog* log, int32_t milliseconds);
+
+// Scrive subito le modifiche in attesa. Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_profile_log_flush(OpendsaProfileLog* log);
+
+// Riscrive il log come snapshot dello stato. Avviene anche da sola quando
+// il log supera il doppio dei dati vivi. Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_profile_log_compact(OpendsaProfileLog* log);
+
+OPENDSA_EXPORT void opendsa_profile_log_stats(const OpendsaProfileLog* log,
+                                              OpendsaProfileLogStats* out);
+
+// Scrive lo stato corrente del log in |path| come profilo binario (vedi
+// sotto). Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_profile_log_export_binary(OpendsaProfileLog* log,
+                                                         const char* path);
+
+// Scrive le modifiche in attesa e chiude il log.
+OPENDSA_EXPORT void opendsa_profile_log_close(OpendsaProfileLog* log);
+
+// --- Profilo binario ---
+
+// Profilo in formato binario mappato in memoria (opendsa::BinaryProfile): un
+// valore JSON disposto in nodi a dimensione fissa, letto un campo alla volta
+// senza decodificare il resto. I nodi sono indici; -1 indica un nodo
+// assente.
+typedef struct OpendsaBinaryProfile OpendsaBinaryProfile;
+
+#define OPENDSA_VALUE_NULL 0
+#define OPENDSA_VALUE_FALSE 1
+#define OPENDSA_VALUE_TRUE 2
+#define OPENDSA_VALUE_INT 3
+#define OPENDSA_VALUE_DOUBLE 4
+#define OPENDSA_VALUE_STRING 5
+#define OPENDSA_VALUE_ARRAY 6
+#define OPENDSA_VALUE_OBJECT 7
+
+typedef struct {
+  int32_t type;        // OPENDSA_VALUE_*
+  int32_t count;       // Byte della stringa, elementi o coppie chiave-valore
+  int64_t integer;     // Valore di un numero, troncato se decimale
+  double number;       // Valore di un numero
+  const char* string;  // Stringa terminata da zero nella mappatura, o NULL
+} OpendsaProfileValue;
+
+// Converte il JSON |json| (|length| byte, -1 = strlen) in un profilo binario
+// scritto in |path| in modo atomico. Restituisce 0, -1 se il JSON non è
+// valido o il file non è scrivibile.
+OPENDSA_EXPORT int32_t opendsa_binary_profile_import(const char* json,
+                                                     int32_t length,
+                                                     const char* path);
+
+// Mappa il profilo in |path|. Restituisce NULL se manca o non è valido.
+OPENDSA_EXPORT OpendsaBinaryProfile* opendsa_binary_profile_open(
+    const char* path);
+
+// Nodo radice del profilo (un oggetto per i profili dei giocatori).
+OPENDSA_EXPORT int32_t opendsa_binary_profile_root(
+    const OpendsaBinaryProfile* profile);
+
+// Valore di |key| nell'oggetto |object|, -1 se assente.
+OPENDSA_EXPORT int32_t opendsa_binary_profile_find(
+    const OpendsaBinaryProfile* profile, int32_t object, const char* key);
+
+// Elemento |index| di un array, -1 se fuori intervallo.
+OPENDSA_EXPORT int32_t opendsa_binary_profile_element(
+    const OpendsaBinaryProfile* profile, int32_t array, int32_t index);
+
+// Chiave e valore della coppia |index| di un oggetto, -1 se fuori
+// intervallo.
+OPENDSA_EXPORT int32_t opendsa_binary_profile_member_key(
+    const OpendsaBinaryProfile* profile, int32_t object, int32_t index);
+OPENDSA_EXPORT int32_t opendsa_binary_profile_member_value(
+    const OpendsaBinaryProfile* profile, int32_t object, int32_t index);
+
+// Legge il nodo |node| in |out|. Restituisce 0, -1 se il nodo non esiste.
+OPENDSA_EXPORT int32_t opendsa_binary_profile_node(
+    const OpendsaBinaryProfile* profile, int32_t node,
+    OpendsaProfileValue* out);
+
+// Nodo |node| (-1 = radice) serializzato in JSON, con la lunghezza in
+// |length|. Il buffer appartiene al profilo ed è valido fino alla chiamata
+// successiva.
+OPENDSA_EXPORT const char* opendsa_binary_profile_to_json(
+    OpendsaBinaryProfile* profile, int32_t node, int32_t* length);
+
+OPENDSA_EXPORT void opendsa_binary_profile_close(OpendsaBinaryProfile* profile);
+
+// --- Storico dell'accuratezza ---
+
+// Serie dell'accuratezza giornaliera di un profilo (opendsa::AccuracySeries),
+// su file compatto con aggregazioni per giorno e per settimana. Media, media
+// degli ultimi giorni e giorni consecutivi sopra la soglia si leggono in
+// tempo costante. I giorni sono contati dall'1/1/1970 (data locale).
+typedef struct OpendsaAccuracySeries OpendsaAccuracySeries;
+
+typedef struct {
+  int32_t days;          // Giorni registrati
+  int32_t streak;        // Ultimi giorni consecutivi sopra la soglia
+  double average;        // Media dei valori giornalieri
+  double last_value;     // Valore dell'ultimo giorno, 0 senza giorni
+  int32_t last_day;      // Ultimo giorno registrato, -1 senza giorni
+  int32_t reserved;
+} OpendsaAccuracySummary;
+
+typedef struct {
+  int32_t day;
+  int32_t attempts;      // Risultati registrati nel giorno
+  double value;          // Valore del giorno usato per media e progressione
+  double mean;           // Media aritmetica dei risultati
+} OpendsaAccuracyDay;
+
+typedef struct {
+  int32_t week;          // Settimane dal lunedì 29/12/1969
+  int32_t days;
+  int32_t days_over_threshold;
+  int32_t attempts;
+  double average;        // Media dei valori giornalieri della settimana
+} OpendsaAccuracyWeek;
+
+// Apre (o crea) la serie in |path|; |threshold| è la soglia dei giorni
+// consecutivi. Restituisce NULL se il file non è accessibile o non è una
+// serie.
+OPENDSA_EXPORT OpendsaAccuracySeries* opendsa_accuracy_series_open(
+    const char* path, double threshold);
+
+// Registra un risultato del giorno |day|: il primo del giorno ne diventa il
+// valore, i successivi ne fanno la media con il valore corrente.
+// Restituisce 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_record(
+    OpendsaAccuracySeries* series, int32_t day, double accuracy);
+
+// Sostituisce i valori dei giorni già registrati tra i |count| giorni
+// |days|, con i valori |values|, in una sola scrittura; gli altri vengono
+// ignorati. Restituisce i giorni sostituiti, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_set_days(
+    OpendsaAccuracySeries* series, const int32_t* days, const double* values,
+    int32_t count);
+
+// Sostituisce l'intera serie con i |count| giorni |days| e valori |values|;
+// a parità di giorno vale l'ultimo. Restituisce 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_assign(
+    OpendsaAccuracySeries* series, const int32_t* days, const double* values,
+    int32_t count);
+
+OPENDSA_EXPORT void opendsa_accuracy_series_summary(
+    const OpendsaAccuracySeries* series, OpendsaAccuracySummary* out);
+
+// Media degli ultimi |days| giorni registrati, 0 senza giorni.
+OPENDSA_EXPORT double opendsa_accuracy_series_window_average(
+    const OpendsaAccuracySeries* series, int32_t days);
+
+// Giorno |index| in ordine di data. Restituisce 0, -1 se l'indice non è
+// valido.
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_day(
+    const OpendsaAccuracySeries* series, int32_t index,
+    OpendsaAccuracyDay* out);
+
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_week_count(
+    const OpendsaAccuracySeries* series);
+
+// Settimana |index| in ordine di data. Restituisce 0, -1 se l'indice non è
+// valido.
+OPENDSA_EXPORT int32_t opendsa_accuracy_series_week(
+    const OpendsaAccuracySeries* series, int32_t index,
+    OpendsaAccuracyWeek* out);
+
+OPENDSA_EXPORT void opendsa_accuracy_series_close(
+    OpendsaAccuracySeries* series);
+
+// --- Statistiche di apprendimento ---
+
+// Statistiche aggregate dei risultati (opendsa::AnalyticsStore) in un file a
+// layout fisso mappato in memoria: ogni risultato le aggiorna sul posto in
+// tempo costante. Un ambito è il totale o la sessione corrente.
+typedef struct OpendsaAnalytics OpendsaAnalytics;
+
+#define OPENDSA_ANALYTICS_TOTAL 0
+#define OPENDSA_ANALYTICS_SESSION 1
+#define OPENDSA_ANALYTICS_ERROR_KINDS 8
+#define OPENDSA_ANALYTICS_SIMILARITY_BUCKETS 10
+
+typedef struct {
+  int64_t attempts;
+  int64_t successes;
+  double similarity_mean;
+  double similarity_stddev;
+  double similarity_min;
+  double similarity_max;
+  double time_mean;              // Secondi
+  double time_stddev;
+  // [0]: risultati errati; [OPENDSA_EDIT_*]: errori di lettura diagnosticati
+  int64_t errors[OPENDSA_ANALYTICS_ERROR_KINDS];
+  // Risultati per similarità, a intervalli di 0.1
+  int64_t similarity_buckets[OPENDSA_ANALYTICS_SIMILARITY_BUCKETS];
+} OpendsaAnalyticsStats;
+
+// Apre (o crea) le statistiche in |path|. Restituisce NULL se il file non è
+// accessibile o non è valido.
+OPENDSA_EXPORT OpendsaAnalytics* opendsa_analytics_open(const char* path);
+
+// Aggiunge un risultato al totale e alla sessione. Per un risultato errato
+// con |recognized| e |target| non NULL, gli errori di lettura diagnosticati
+// vengono contati per tipo. Restituisce 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_analytics_record(OpendsaAnalytics* analytics,
+                                                double similarity,
+                                                int64_t duration_ms,
+                                                int32_t correct,
+                                                const char* recognized,
+                                                const char* target);
+
+// Azzera la sessione e ne registra l'inizio (millisecondi dall'epoca).
+OPENDSA_EXPORT int32_t opendsa_analytics_start_session(
+    OpendsaAnalytics* analytics, int64_t start_ms);
+
+// Inizio della sessione corrente, 0 se non ce n'è una.
+OPENDSA_EXPORT int64_t opendsa_analytics_session_start(
+    const OpendsaAnalytics* analytics);
+
+// Statistiche dell'ambito |scope| (OPENDSA_ANALYTICS_*). Restituisce 0, -1
+// se l'ambito non è valido.
+OPENDSA_EXPORT int32_t opendsa_analytics_stats(
+    const OpendsaAnalytics* analytics, int32_t scope,
+    OpendsaAnalyticsStats* out);
+
+// Sostituisce il totale con |stats|, ad esempio per importare statistiche
+// salvate altrove. Restituisce 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_analytics_import(
+    OpendsaAnalytics* analytics, const OpendsaAnalyticsStats* stats);
+
+// Azzera totale e sessione. Restituisce 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_analytics_reset(OpendsaAnalytics* analytics);
+
+// Scrive subito su disco le statistiche. Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_analytics_flush(OpendsaAnalytics* analytics);
+
+OPENDSA_EXPORT void opendsa_analytics_close(OpendsaAnalytics* analytics);
+
+// --- Registro dei tentativi ---
+
+// Registro a colonne di tutti i tentativi di lettura (opendsa::AttemptLog),
+// senza limite di storia. Le interrogazioni filtrano per intervallo di
+// tempo, profilo, testo, livello e tipo di errore e aggregano per giorno,
+// settimana, livello, testo o profilo leggendo solo le colonne e i blocchi
+// di righe necessari.
+typedef struct OpendsaAttemptLog OpendsaAttemptLog;
+
+// Bit degli errori di un tentativo: OPENDSA_ATTEMPT_INCORRECT per un
+// risultato errato, (1 << OPENDSA_EDIT_*) per gli errori di lettura
+// diagnosticati.
+#define OPENDSA_ATTEMPT_INCORRECT 1
+
+#define OPENDSA_ATTEMPT_GROUP_NONE 0
+#define OPENDSA_ATTEMPT_GROUP_DAY 1      // Giorni dall'epoca, nel fuso del tentativo
+#define OPENDSA_ATTEMPT_GROUP_WEEK 2     // Settimane da lunedì, come le serie
+#define OPENDSA_ATTEMPT_GROUP_LEVEL 3
+#define OPENDSA_ATTEMPT_GROUP_TARGET 4   // Id del testo atteso
+#define OPENDSA_ATTEMPT_GROUP_PROFILE 5  // Id del profilo
+
+typedef struct {
+  int64_t timestamp_ms;
+  const char* profile;     // NULL = ""
+  const char* target;
+  const char* recognized;
+  int32_t level;
+  int32_t correct;
+  double similarity;
+  double confidence;
+  int64_t duration_ms;
+  int32_t utc_offset_minutes;  // Fuso locale, per i riepiloghi per giorno
+  int32_t reserved;
+} OpendsaAttempt;
+
+typedef struct {
+  int64_t from_ms;          // Incluso
+  int64_t to_ms;            // Escluso
+  const char* profile;      // NULL = tutti
+  const char* target;       // NULL = tutti
+  int32_t min_level;
+  int32_t max_level;
+  int32_t errors;           // Almeno uno di questi bit, 0 = tutti
+  // Confusione fra due lettere minuscole, in un verso o nell'altro; 0 =
+  // tutte. Sono registrate le coppie b/d, b/p, d/q, p/q, m/n, m/w, a/e,
+  // s/z, f/v e l/i: le altre non hanno tentativi.
+  uint32_t confusion_a;
+  uint32_t confusion_b;
+  int32_t group_by;         // OPENDSA_ATTEMPT_GROUP_*
+} OpendsaAttemptQuery;
+
+typedef struct {
+  int64_t key;
+  int64_t attempts;
+  int64_t correct;
+  double similarity_mean;
+  double duration_mean_ms;
+} OpendsaAttemptGroup;
+
+typedef struct {
+  int64_t chunks;          // Blocchi di righe sigillati
+  int64_t chunks_scanned;  // Blocchi non esclusi da minimo e massimo
+  int64_t rows_scanned;
+  int64_t rows_matched;
+  int64_t columns_read;
+} OpendsaAttemptQueryStats;
+
+// Riepilogo materializzato dei tentativi di un livello o di un giorno.
+typedef struct {
+  int64_t attempts;
+  int64_t correct;
+  double accuracy;           // correct / attempts
+  double similarity_mean;
+  double duration_mean_ms;
+  int64_t first_ms;
+  int64_t last_ms;
+  int32_t days;              // Giorni distinti con tentativi
+  int32_t reserved;
+  // [0]: tentativi errati; [OPENDSA_EDIT_*]: tentativi con quell'errore
+  int64_t errors[OPENDSA_ANALYTICS_ERROR_KINDS];
+} OpendsaAttemptSummary;
+
+// Apre (o crea) il registro in |path|, con i file <path>.tail,
+// <path>.dict, <path>.text e <path>.views. Restituisce NULL se i file non
+// sono accessibili o non sono validi.
+OPENDSA_EXPORT OpendsaAttemptLog* opendsa_attempt_log_open(const char* path);
+
+// Accoda un tentativo; per un risultato errato gli errori di lettura
+// vengono diagnosticati confrontando |recognized| e |target|. Restituisce
+// 0, -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_attempt_log_append(
+    OpendsaAttemptLog* log, const OpendsaAttempt* attempt);
+
+// Esegue |query| e conserva i gruppi nel registro fino all'interrogazione
+// successiva. |stats| può essere NULL. Restituisce il numero di gruppi, -1
+// in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_attempt_log_query(
+    OpendsaAttemptLog* log, const OpendsaAttemptQuery* query,
+    OpendsaAttemptQueryStats* stats);
+
+// Gruppo |index| dell'ultima interrogazione, in ordine di chiave.
+// Restituisce 0, -1 se l'indice non è valido.
+OPENDSA_EXPORT int32_t opendsa_attempt_log_group(const OpendsaAttemptLog* log,
+                                                 int32_t index,
+                                                 OpendsaAttemptGroup* out);
+
+// Testo con id |id| (chiave dei gruppi per testo o profilo), NULL se non
+// esiste. Resta valido fino alla chiusura del registro.
+OPENDSA_EXPORT const char* opendsa_attempt_log_string(
+    const OpendsaAttemptLog* log, int64_t id);
+
+// Numero di tentativi registrati.
+OPENDSA_EXPORT int64_t opendsa_attempt_log_size(const OpendsaAttemptLog* log);
+
+// Riepilogo dei tentativi di |profile| al livello |level|, letto in tempo
+// costante. Restituisce 1 se ci sono tentativi, 0 se non ce ne sono (|out|
+// azzerato), -1 in caso di errore.
+OPENDSA_EXPORT int32_t opendsa_attempt_log_level_summary(
+    const OpendsaAttemptLog* log, const char* profile, int32_t level,
+    OpendsaAttemptSummary* out);
+
+// Riepilogo dei tentativi di |profile| nel giorno |day| (giorni dall'epoca
+// nel fuso locale dei tentativi), con lo stesso risultato.
+OPENDSA_EXPORT int32_t opendsa_attempt_log_day_summary(
+    const OpendsaAttemptLog* log, const char* profile, int32_t day,
+    OpendsaAttemptSummary* out);
+
+OPENDSA_EXPORT void opendsa_attempt_log_close(OpendsaAttemptLog* log);
+
+// --- Journal della sessione di allenamento ---
+
+// Journal (opendsa::SessionJournal) della sessione in corso: un record
+// OPENDSA_JOURNAL_BEGIN con i dati della sessione e un record
+// OPENDSA_JOURNAL_ENTRY per ogni risultato. I record sopravvivono a un crash
+// dell'app; l'fsync viene raggruppato su una finestra di tempo.
+typedef struct OpendsaSessionJournal OpendsaSessionJournal;
+
+#define OPENDSA_JOURNAL_BEGIN 1
+#define OPENDSA_JOURNAL_ENTRY 2
+
+// Apre (o crea) il journal in |path| e ne rilegge i record; un record
+// troncato o corrotto da un crash chiude il journal e viene scartato. Con
+// |sync_window_ms| zero ogni record attende il proprio fsync. Restituisce
+// NULL se il file non è accessibile o non è un journal.
+OPENDSA_EXPORT OpendsaSessionJournal* opendsa_session_journal_open(
+    const char* path, int32_t sync_window_ms);
+
+// Numero di record nel journal.
+OPENDSA_EXPORT int32_t opendsa_session_journal_count(
+    const OpendsaSessionJournal* journal);
+
+// Record |index| in ordine di scrittura: tipo in |type|, payload (non
+// terminato da zero) in |data| e |length|. Valido fino alla modifica
+// successiva. Restituisce 0, -1 se l'indice non è valido.
+OPENDSA_EXPORT int32_t opendsa_session_journal_record(
+    const OpendsaSessionJournal* journal, int32_t index, int32_t* type,
+    const char** data, int32_t* length);
+
+// Svuota il journal e vi scrive i primi |length| byte di |data| come record
+// OPENDSA_JOURNAL_BEGIN, con fsync immediato. Restituisce 0, -1 in caso di
+// errore.
+OPENDSA_EXPORT int32_t opendsa_session_journal_begin(
+    OpendsaSessionJournal* journal, const char* data, int32_t length);
+
+// Accoda un record OPENDSA_JOURNAL_ENTRY. Restituisce 0, -1 se la scrittura
+// o l'fsync di un record precedente non è riuscito.
+OPENDSA_EXPORT int32_t opendsa_session_journal_append(
+    OpendsaSessionJournal* journal, const char* data, int32_t length);
+
+// Rende subito durevoli i record in attesa. Restituisce 0 in caso di
+// successo.
+OPENDSA_EXPORT int32_t opendsa_session_journal_sync(
+    OpendsaSessionJournal* journal);
+
+// Svuota il journal dopo che la sessione è stata salvata nella cronologia.
+// Restituisce 0 in caso di successo.
+OPENDSA_EXPORT int32_t opendsa_session_journal_commit(
+    OpendsaSessionJournal* journal);
+
+// Rende durevoli i record in attesa e chiude il journal.
+OPENDSA_EXPORT void opendsa_session_journal_close(
+    OpendsaSessionJournal* journal);
+
+// --- Log dei servizi ---
+
+// Log di testo scritto in background (opendsa::AsyncLogger). La scrittura
+// di un record accoda il messaggio senza lock né system call; un thread
+// interno scrive i record a gruppi in <dir>/<prefix>_<data>.txt, chiude e
+// comprime i segmenti per dimensione e per giorno e tiene le ultime righe
+// in memoria. Ogni segmento ha un indice a blocchi (tempi, livelli, tag) con
+// cui opendsa_logger_query decodifica solo i blocchi che le interessano.
+typedef struct OpendsaLogger OpendsaLogger;
+
+#define OPENDSA_LOG_DEBUG 0
+#define OPENDSA_LOG_INFO 1
+#define OPENDSA_LOG_WARNING 2
+#define OPENDSA_LOG_ERROR 3
+
+typedef struct {
+  int64_t max_file_bytes;     // Dimensione oltre cui un segmento si chiude
+  int32_t ring_capacity;      // Righe tenute in memoria
+  int32_t max_pending;        // Record in coda oltre cui si scartano
+  int32_t flush_interval_ms;  // Intervallo delle scritture
+  int32_t reserved;
+} OpendsaLoggerOptions;
+
+typedef struct {
+  int64_t records_logged;
+  int64_t records_dropped;   // Coda piena o logger chiuso
+  int64_t records_written;
+  int64_t batches;           // Write eseguite dal thread interno
+  int64_t bytes_written;
+  int64_t rotations;         // Segmenti chiusi e compressi
+  int64_t bytes_archived;
+  int64_t write_errors;
+} OpendsaLoggerStats;
+
+// Filtri di opendsa_logger_query. I tempi sono millisecondi dell'ora locale
+// contata come UTC (l'ora scritta nelle righe), da |from_ms| incluso a
+// |to_ms| escluso.
+typedef struct {
+  int64_t from_ms;     // INT64_MIN = dall'inizio
+  int64_t to_ms;       // INT64_MAX = fino all'ultima riga
+  int32_t min_level;   // OPENDSA_LOG_*
+  int32_t limit;       // Le righe più recenti; 0 = tutte
+  const char* tag;     // NULL o "" = tutti i tag
+} OpendsaLogQuery;
+
+typedef struct {
+  int64_t segments;       // Segmenti nell'intervallo di date
+  int64_t blocks;         // Blocchi di indice considerati
+  int64_t blocks_read;    // Blocchi decodificati
+  int64_t lines_scanned;
+  int64_t lines_matched;
+  int64_t incomplete;     // 1 se un segmento non era leggibile
+} OpendsaLogQueryStats;
+
+// Apre il log in |dir|, che deve esistere, con file che iniziano per
+// |prefix|. |options| può essere NULL per i valori predefiniti. Restituisce
+// NULL se la directory non è accessibile.
+OPENDSA_EXPORT OpendsaLogger* opendsa_logger_open(
+    const char* dir, const char* prefix, const OpendsaLoggerOptions* options);
+
+// Accoda i primi |length| byte di |message| (-1 = strlen) con il livello
+// OPENDSA_LOG_* e il tag di contesto |tag| (NULL = nessuno; spazi e
+// caratteri di controllo diventano '_'). Può essere chiamata da qualsiasi
+// thread. Restituisce 0, -1 se il record è stato scartato.
+OPENDSA_EXPORT int32_t opendsa_logger_log(OpendsaLogger* logger,
+                                          int32_t level, const char* tag,
+                                          const char* message,
+                                          int32_t length);
+
+// Attende che i record accodati finora siano scritti; con |sync| diverso da
+// zero anche l'fdatasync. Restituisce 0, -1 se una scrittura non è
+// riuscita.
+OPENDSA_EXPORT int32_t opendsa_logger_flush(OpendsaLogger* logger,
+                                            int32_t sync);
+
+// Conserva nel logger le ultime |max| righe scritte, dalla più vecchia, e
+// ne restituisce il numero (-1 in caso di errore).
+OPENDSA_EXPORT int32_t opendsa_logger_recent(OpendsaLogger* logger,
+                                             int32_t max);
+
+// Conserva nel logger le righe che soddisfano |query|, dalla più vecchia, e
+// ne restituisce il numero (-1 in caso di errore). Con un limite sono le
+// più recenti. I segmenti non leggibili vengono saltati e segnalati in
+// |stats|, che può essere NULL.
+OPENDSA_EXPORT int32_t opendsa_logger_query(OpendsaLogger* logger,
+                                            const OpendsaLogQuery* query,
+                                            OpendsaLogQueryStats* stats);
+
+// Riga |index| dell'ultima opendsa_logger_recent o opendsa_logger_query,
+// NULL se l'indice non è valido. Valida fino alla chiamata successiva.
+OPENDSA_EXPORT const char* opendsa_logger_line(const OpendsaLogger* logger,
+                                               int32_t index);
+
+// Tutte le righe del giorno |date| ("AAAA-MM-GG"), dai segmenti compressi e
+// dal segmento corrente, separate da '\n', con la lunghezza in |length|.
+// Valide fino alla chiamata successiva. Restituisce NULL se un segmento non
+// è leggibile.
+OPENDSA_EXPORT const char* opendsa_logger_read_day(OpendsaLogger* logger,
+                                                   const char* date,
+                                                   int64_t* length);
+
+OPENDSA_EXPORT void opendsa_logger_stats(const OpendsaLogger* logger,
+                                         OpendsaLoggerStats* out);
+
+// Scrive i record in coda e chiude il log.
+OPENDSA_EXPORT void opendsa_logger_close(OpendsaLogger* logger);
+
+// --- Archivio delle registrazioni ---
+
+// Registrazioni dei tentativi (opendsa::AudioArchive) codificate senza
+// perdita con predizione lineare e codice di Rice, indicizzate per profilo,
+// testo atteso e istante, con limiti di spazio e di età: oltre il limite di
+// spazio si rimuovono le clip ascoltate o registrate meno di recente.
+// Le funzioni si possono chiamare mentre un'aggiunta in background è in
+// corso: l'archivio le serializza.
+typedef struct OpendsaAudioArchive OpendsaAudioArchive;
+typedef struct OpendsaAudioArchiveJob OpendsaAudioArchiveJob;
+
+typedef struct {
+  int64_t max_bytes;   // Spazio massimo delle clip
+  int64_t max_age_ms;  // Età massima dalla registrazione, 0 = nessuna
+} OpendsaAudioArchiveOptions;
+
+typedef struct {
+  int64_t id;
+  int64_t recorded_ms;
+  int64_t accessed_ms;   // Ultimo ascolto, o recorded_ms
+  int64_t duration_ms;
+  int64_t stored_bytes;
+  int32_t sample_rate;
+  int32_t channels;
+  const char* profile;   // Valido fino alla chiamata successiva
+  const char* target;
+} OpendsaAudioClip;
+
+typedef struct {
+  int64_t clips;
+  int64_t stored_bytes;
+  int64_t raw_bytes;     // Gli stessi campioni in PCM a 16 bit
+  int64_t evicted;       // Clip rimosse dai limiti dall'apertura
+} OpendsaAudioArchiveStats;
+
+// Apre (o crea) l'archivio in |dir|, che deve esistere. |options| può
+// essere NULL per 200 MB e 30 giorni. Restituisce NULL se la directory non
+// è accessibile o l'elenco delle clip non è valido.
+OPENDSA_EXPORT OpendsaAudioArchive* opendsa_audio_archive_open(
+    const char* dir, const OpendsaAudioArchiveOptions* options);
+
+// Archivia il WAV PCM in |wav_path| registrato all'istante |recorded_ms| e
+// applica i limiti. Restituisce l'id della clip, -1 in caso di errore.
+OPENDSA_EXPORT int64_t opendsa_audio_archive_add_wav(
+    OpendsaAudioArchive* archive, const char* wav_path, const char* profile,
+    const char* target, int64_t recorded_ms);
+
+// Come opendsa_audio_archive_add_wav, ma codifica e salva la clip su un
+// thread. Il WAV deve restare al suo posto fino alla fine del lavoro, e il
+// lavoro va liberato prima di chiudere l'archivio. Restituisce NULL se
+// |archive| o |wav_path| mancano.
+OPENDSA_EXPORT OpendsaAudioArchiveJob* opendsa_audio_archive_add_wav_start(
+    OpendsaAudioArchive* archive, const char* wav_path, const char* profile,
+    const char* target, int64_t recorded_ms);
+
+// 1 se l'aggiunta è terminata, 0 altrimenti. Non blocca.
+OPENDSA_EXPORT int32_t opendsa_audio_archive_add_done(
+    const OpendsaAudioArchiveJob* job);
+
+// Attende la fine dell'aggiunta e restituisce l'id della clip, -1 in caso
+// di errore.
+OPENDSA_EXPORT int64_t opendsa_audio_archive_add_wait(
+    OpendsaAudioArchiveJob* job);
+
+// Libera il lavoro, attendendone prima la fine.
+OPENDSA_EXPORT void opendsa_audio_archive_add_free(OpendsaAudioArchiveJob* job);
+
+// Conserva nell'archivio le clip di |profile| e |target| (NULL = tutti),
+// dalla più recente, e ne restituisce il numero (-1 in caso di errore).
+OPENDSA_EXPORT int32_t opendsa_audio_archive_list(OpendsaAudioArchive* archive,
+                                                  const char* profile,
+                                                  const char* target);
+
+// Clip |index| dell'ultima opendsa_audio_archive_list. Restituisce 0, -1 se
+// l'indice non è valido.
+OPENDSA_EXPORT int32_t opendsa_audio_archive_clip(
+    const OpendsaAudioArchive* archive, int32_t index, OpendsaAudioClip* out);
+
+// Decodifica la clip |id| in un WAV PCM a 16 bit in |wav_path| e ne
+// registra l'ascolto all'istante |now_ms|. Restituisce 0, -1 in caso di
+// errore.
+OPENDSA_EXPORT int32_t opendsa_audio_archive_export_wav(
+    OpendsaAudioArchive* archive, int64_t id, int64_t now_ms,
+    const char* wav_path);
+
+// Rimuove la clip |id|. Restituisce 0, -1 se non esiste.
+OPENDSA_EXPORT int32_t opendsa_audio_archive_remove(
+    OpendsaAudioArchive* archive, int64_t id);
+
+// Applica i limiti all'istante |now_ms|; restituisce le clip rimosse (-1 in
+// caso di errore).
+OPENDSA_EXPORT int32_t opendsa_audio_archive_evict(
+    OpendsaAudioArchive* archive, int64_t now_ms);
+
+OPENDSA_EXPORT void opendsa_audio_archive_stats(
+    const OpendsaAudioArchive* archive, OpendsaAudioArchiveStats* out);
+
+// Salva gli ascolti e chiude l'archivio. Le aggiunte in background vanno
+// liberate prima.
+OPENDSA_EXPORT void opendsa_audio_archive_close(OpendsaAudioArchive* archive);
+
+// --- Riconoscimento dei file WAV ---
+
+// Modello di libvosk (opendsa::SpeechModel), condiviso dai riconoscimenti.
+typedef struct OpendsaSpeechModel OpendsaSpeechModel;
+
+// Riconoscimento di un file in corso (opendsa::FileRecognitionJob).
+typedef struct OpendsaFileRecognition OpendsaFileRecognition;
+
+typedef struct {
+  const char* word;   // Valido finché il riconoscimento non viene liberato
+  double start;       // Secondi dall'inizio del file
+  double end;
+  double confidence;
+} OpendsaRecognizedWord;
+
+typedef struct {
+  const char* text;         // Valido finché il riconoscimento non viene liberato
+  int32_t word_count;
+  int32_t sample_rate;      // Frequenza del file
+  double audio_seconds;     // Durata del file
+  double elapsed_seconds;   // Tempo di elaborazione
+} OpendsaFileRecognitionResult;
+
+// Avvia il caricamento del modello in |dir| su un thread e ritorna subito.
+// Restituisce NULL solo se |dir| è NULL; un modello o una libvosk mancanti
+// vengono segnalati da opendsa_speech_model_ready.
+OPENDSA_EXPORT OpendsaSpeechModel* opendsa_speech_model_open(const char* dir);
+
+// 1 se il modello è pronto, 0 se è in caricamento, -1 se non è stato
+// possibile caricarlo. Non blocca.
+OPENDSA_EXPORT int32_t opendsa_speech_model_ready(
+    const OpendsaSpeechModel* model);
+
+// Libera il modello, attendendo la fine del caricamento. I riconoscimenti
+// avviati sul modello vanno liberati prima.
+OPENDSA_EXPORT void opendsa_speech_model_close(OpendsaSpeechModel* model);
+
+// Mappa il WAV PCM in |wav_path|, ne controlla l'intestazione e avvia il
+// riconoscimento su un thread, a blocchi di |chunk_ms| millisecondi (0 =
+// predefinito) convertiti alla frequenza del modello. Restituisce NULL se il
+// file manca o non è un WAV PCM valido.
+OPENDSA_EXPORT OpendsaFileRecognition* opendsa_recognize_file_start(
+    const OpendsaSpeechModel* model, const char* wav_path, int32_t chunk_ms);
+
+// Frazione del file già elaborata, tra 0 e 1: vale 1 solo quando anche il
+// risultato finale è pronto e opendsa_recognize_file_wait non blocca. Non
+// blocca.
+OPENDSA_EXPORT double opendsa_recognize_file_progress(
+    const OpendsaFileRecognition* recognition);
+
+// Attende la fine del riconoscimento e ne scrive il risultato in |out|.
+// Restituisce 0, -1 se il modello non è disponibile o libvosk ha
+// segnalato un errore.
+OPENDSA_EXPORT int32_t opendsa_recognize_file_wait(
+    OpendsaFileRecognition* recognition, OpendsaFileRecognitionResult* out);
+
+// Parola |index| del risultato, dopo opendsa_recognize_file_wait.
+// Restituisce 0, -1 se l'indice non è valido.
+OPENDSA_EXPORT int32_t opendsa_recognize_file_word(
+    const OpendsaFileRecognition* recognition, int32_t index,
+    OpendsaRecognizedWord* out);
+
+// Libera il riconoscimento, attendendone prima la fine.
+OPENDSA_EXPORT void opendsa_recognize_file_free(
+    OpendsaFileRecognition* recognition);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // OPENDSA_NATIVE_OPENDSA_NATIVE_H_
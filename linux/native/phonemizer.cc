@@ -0,0 +1,330 @@
+// linux/native/phonemizer.cc
+
+#include "phonemizer.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+struct Exception {
+  std::u32string_view word;
+  std::u32string_view phones;
+};
+
+// Parole che le regole trascrivono male, in ordine di code point per la
+// ricerca binaria
+constexpr Exception kExceptions[] = {
+    {U"allergia", U"allerʤia"},
+    {U"anglicano", U"anglikano"},
+    {U"bugia", U"buʤia"},
+    {U"cortesia", U"kortezia"},
+    {U"energia", U"enerʤia"},
+    {U"fantasia", U"fantazia"},
+    {U"farmacia", U"farmaʧia"},
+    {U"geroglifico", U"ʤeroglifiko"},
+    {U"glicemia", U"gliʧemia"},
+    {U"glicerina", U"gliʧerina"},
+    {U"glicine", U"gliʧine"},
+    {U"magia", U"maʤia"},
+    {U"negligente", U"negliʤente"},
+    {U"nostalgia", U"nostalʤia"},
+    {U"poesia", U"poezia"},
+    {U"scia", U"ʃia"},
+    {U"sciare", U"ʃiare"},
+    {U"sciatore", U"ʃiatore"},
+    {U"sinergia", U"sinerʤia"},
+    {U"zampa", U"ʦampa"},
+    {U"zappa", U"ʦappa"},
+    {U"zia", U"ʦia"},
+    {U"zio", U"ʦio"},
+    {U"zitto", U"ʦitto"},
+    {U"zoccolo", U"ʦokkolo"},
+    {U"zucca", U"ʦukka"},
+    {U"zucchero", U"ʦukkero"},
+    {U"zuppa", U"ʦuppa"},
+};
+
+// Terminazioni dotte con la i tonica seguita da -a o -e (zoologia,
+// geografie): la i resta vocale invece di diventare semivocale o diacritica
+constexpr std::u32string_view kStressedISuffixes[] = {
+    U"crazi", U"fili", U"fobi", U"foni", U"grafi", U"logi", U"metri",
+    U"nomi", U"pati", U"scopi", U"sofi", U"terapi", U"tomi",
+};
+
+// Vocale semplice corrispondente a |cp|, 0 se non è una vocale. L'accento
+// grave su e e o indica la vocale aperta.
+char32_t VowelPhone(char32_t cp) {
+  switch (cp) {
+    case 'a': case 0xE0: case 0xE1: case 0xE2:
+      return 'a';
+    case 'e': case 0xE9: case 0xEA:
+      return 'e';
+    case 0xE8:
+      return kPhoneOpenE;
+    case 'i': case 0xEC: case 0xED: case 0xEE: case 0xEF:
+      return 'i';
+    case 'o': case 0xF3: case 0xF4:
+      return 'o';
+    case 0xF2:
+      return kPhoneOpenO;
+    case 'u': case 0xF9: case 0xFA: case 0xFB: case 0xFC:
+      return 'u';
+    default:
+      return 0;
+  }
+}
+
+bool IsVowel(char32_t cp) { return VowelPhone(cp) != 0; }
+
+bool IsFrontVowel(char32_t cp) {
+  const char32_t phone = VowelPhone(cp);
+  return phone == 'e' || phone == 'i' || phone == kPhoneOpenE;
+}
+
+bool IsVowelPhone(char32_t phone) {
+  switch (phone) {
+    case 'a': case 'e': case 'i': case 'o': case 'u': case 'j': case 'w':
+    case kPhoneOpenE: case kPhoneOpenO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsVoicedConsonant(char32_t cp) {
+  switch (cp) {
+    case 'b': case 'd': case 'g': case 'l': case 'm': case 'n': case 'r':
+    case 'v':
+      return true;
+    default:
+      return false;
+  }
+}
+
+const Exception* FindException(std::u32string_view word) {
+  const auto found = std::lower_bound(
+      std::begin(kExceptions), std::end(kExceptions), word,
+      [](const Exception& entry, std::u32string_view key) {
+        return entry.word < key;
+      });
+  return found != std::end(kExceptions) && found->word == word ? found
+                                                              : nullptr;
+}
+
+// Indice della i tonica di una terminazione dotta, -1 se assente.
+int32_t StressedSuffixI(std::u32string_view word) {
+  if (word.size() < 2 || (word.back() != 'a' && word.back() != 'e')) return -1;
+  const std::u32string_view stem = word.substr(0, word.size() - 1);
+  for (const std::u32string_view suffix : kStressedISuffixes) {
+    if (stem.size() > suffix.size() &&
+        stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0) {
+      return static_cast<int32_t>(stem.size()) - 1;
+    }
+  }
+  return -1;
+}
+
+// Consonante della parola: fonema e lettere consumate
+struct Consonant {
+  char32_t phone = 0;
+  char32_t second = 0;  // Secondo fonema (x -> ks), 0 se assente
+  int32_t letters = 1;
+  bool long_between_vowels = false;
+};
+
+class WordRules {
+ public:
+  explicit WordRules(const std::u32string& word)
+      : word_(word),
+        length_(static_cast<int32_t>(word.size())),
+        stressed_i_(StressedSuffixI(word)) {
+    // Parole brevi come mio, via, due, lui: la prima vocale è debole e la
+    // seconda chiude la parola, quindi l'accento cade sulla prima (iato)
+    for (int32_t p = 0; p < length_; p++) {
+      if (!IsVowel(word_[p])) continue;
+      if (p + 2 == length_ && IsVowel(word_[p + 1])) short_hiatus_ = p;
+      break;
+    }
+  }
+
+  char32_t at(int32_t p) const { return p >= 0 && p < length_ ? word_[p] : 0; }
+
+  // i e u atone davanti a vocale sono semivocali, salvo negli iati noti
+  bool IsGlide(int32_t p) const {
+    const char32_t cp = word_[p];
+    if ((cp != 'i' && cp != 'u') || p == stressed_i_ || p == short_hiatus_) {
+      return false;
+    }
+    const char32_t next = at(p + 1);
+    return IsVowel(next) && next != cp;
+  }
+
+  // i diacritica di ci, gi, gli, sci davanti a vocale (ciao, figlio)
+  bool IsSilentI(int32_t p) const { return at(p) == 'i' && IsGlide(p); }
+
+  Consonant Read(int32_t p) const {
+    const char32_t cp = word_[p];
+    const char32_t next = at(p + 1);
+    Consonant c;
+    switch (cp) {
+      case 'c':
+        if (next == 'h') {
+          c.phone = 'k';
+          c.letters = 2;
+        } else if (IsFrontVowel(next)) {
+          c.phone = kPhoneCh;
+          c.letters = IsSilentI(p + 1) ? 2 : 1;
+        } else {
+          c.phone = 'k';
+        }
+        break;
+      case 'g':
+        if (next == 'h') {
+          c.phone = 'g';
+          c.letters = 2;
+        } else if (next == 'n') {
+          c.phone = kPhoneGn;
+          c.letters = 2;
+          c.long_between_vowels = true;
+        } else if (next == 'l' && at(p + 2) == 'i') {
+          c.phone = kPhoneGl;
+          c.letters = IsSilentI(p + 2) ? 3 : 2;
+          c.long_between_vowels = true;
+        } else if (IsFrontVowel(next)) {
+          c.phone = kPhoneJh;
+          c.letters = IsSilentI(p + 1) ? 2 : 1;
+        } else {
+          c.phone = 'g';
+        }
+        break;
+      case 's':
+        if (next == 'c' && IsFrontVowel(at(p + 2))) {
+          c.phone = kPhoneSh;
+          c.letters = IsSilentI(p + 2) ? 3 : 2;
+          c.long_between_vowels = true;
+        } else {
+          c.phone = IsVoicedConsonant(next) ? 'z' : 's';
+        }
+        break;
+      case 'z':
+        c.phone = p == 0 ? kPhoneDz : kPhoneTs;
+        c.long_between_vowels = true;
+        break;
+      case 'q': case 'k':
+        c.phone = 'k';
+        break;
+      case 'x':
+        c.phone = 'k';
+        c.second = 's';
+        break;
+      case 'j':
+        c.phone = 'j';
+        break;
+      case 'y':
+        c.phone = 'i';
+        break;
+      case 'b': case 'd': case 'f': case 'l': case 'm': case 'n': case 'p':
+      case 'r': case 't': case 'v': case 'w':
+        c.phone = cp;
+        break;
+      default:
+        c.phone = 0;  // Non è una lettera
+        break;
+    }
+    return c;
+  }
+
+ private:
+  const std::u32string& word_;
+  const int32_t length_;
+  const int32_t stressed_i_;
+  int32_t short_hiatus_ = -1;
+};
+
+}  // namespace
+
+void Phonemizer::Phonemize(const std::u32string& word,
+                           std::u32string* phones) const {
+  phones->clear();
+  if (const Exception* exception = FindException(word)) {
+    phones->assign(exception->phones);
+    return;
+  }
+
+  const WordRules rules(word);
+  const int32_t length = static_cast<int32_t>(word.size());
+  int32_t p = 0;
+  while (p < length) {
+    const char32_t cp = word[p];
+    if (const char32_t vowel = VowelPhone(cp)) {
+      if (rules.IsGlide(p)) {
+        phones->push_back(cp == 'i' ? 'j' : 'w');
+      } else {
+        phones->push_back(vowel);
+      }
+      p++;
+      continue;
+    }
+    if (cp == 'h') {  // Sempre muta
+      p++;
+      continue;
+    }
+
+    // Le doppie prendono il suono della seconda lettera (cce -> ʧʧ)
+    const bool geminate = cp == rules.at(p + 1);
+    const int32_t start = geminate ? p + 1 : p;
+    const Consonant consonant = rules.Read(start);
+    p = start + consonant.letters;
+    if (consonant.phone == 0) continue;
+
+    const bool between_vowels = consonant.long_between_vowels &&
+                                !phones->empty() &&
+                                IsVowelPhone(phones->back()) &&
+                                IsVowel(rules.at(p));
+    phones->push_back(consonant.phone);
+    if (geminate || between_vowels) phones->push_back(consonant.phone);
+    if (consonant.second != 0) phones->push_back(consonant.second);
+  }
+}
+
+const std::string& Phonemizer::Cached(const std::u32string& word) {
+  key_.clear();
+  for (const char32_t cp : word) AppendUtf8(cp, &key_);
+  if (const std::string* cached = cache_.Find(key_)) return *cached;
+
+  Phonemize(word, &phones_);
+  std::string& pronunciation = cache_.Insert(key_);
+  pronunciation.clear();
+  for (const char32_t phone : phones_) AppendUtf8(phone, &pronunciation);
+  return pronunciation;
+}
+
+std::string_view Phonemizer::Pronounce(std::string_view word) {
+  DecodeUtf8(word, &word_);
+  for (char32_t& cp : word_) cp = ToLower(cp);
+  return Cached(word_);
+}
+
+void Phonemizer::PronounceText(const std::u32string& text,
+                               std::u32string* phones) {
+  phones->clear();
+  size_t begin = 0;
+  while (begin < text.size()) {
+    size_t end = text.find(U' ', begin);
+    if (end == std::u32string::npos) end = text.size();
+    word_.assign(text, begin, end - begin);
+    begin = end + 1;
+    const std::string& pronunciation = Cached(word_);
+    if (pronunciation.empty()) continue;
+    DecodeUtf8(pronunciation, &decoded_);
+    if (!phones->empty()) phones->push_back(U' ');
+    phones->append(decoded_);
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,89 @@
+// linux/native/phonemizer.h
+
+#ifndef OPENDSA_NATIVE_PHONEMIZER_H_
+#define OPENDSA_NATIVE_PHONEMIZER_H_
+
+#include <string>
+#include <string_view>
+
+#include "lru_cache.h"
+
+namespace opendsa {
+
+// Fonemi prodotti dal Phonemizer, un code point ciascuno (IPA, con le
+// legature per le affricate) così che le pronunce si confrontino con le
+// stesse distanze di edit usate per il testo:
+//
+//   vocali        a e ɛ i o ɔ u      (ɛ ɔ solo se indicate dall'accento grave)
+//   semivocali    j w
+//   occlusive     p b t d k g
+//   fricative     f v s z ʃ
+//   affricate     ʧ ʤ ʦ ʣ
+//   nasali        m n ɲ
+//   liquide       l r ʎ
+//
+// Le consonanti doppie sono il fonema ripetuto (gatto -> gatto, pezzo ->
+// peʦʦo); ɲ, ʎ, ʃ e ʦ fra due vocali sono sempre lunghe e vengono ripetute
+// anche se scritte scempie (bagno -> baɲɲo). L'accento non è segnato: il
+// lessico lo conserva a parte.
+constexpr char32_t kPhoneOpenE = 0x25B;     // ɛ
+constexpr char32_t kPhoneOpenO = 0x254;     // ɔ
+constexpr char32_t kPhoneSh = 0x283;        // ʃ
+constexpr char32_t kPhoneCh = 0x2A7;        // ʧ
+constexpr char32_t kPhoneJh = 0x2A4;        // ʤ
+constexpr char32_t kPhoneTs = 0x2A6;        // ʦ
+constexpr char32_t kPhoneDz = 0x2A3;        // ʣ
+constexpr char32_t kPhoneGn = 0x272;        // ɲ
+constexpr char32_t kPhoneGl = 0x28E;        // ʎ
+
+// Trascrizione fonematica dell'italiano (grapheme-to-phoneme) a regole,
+// con un lessico di eccezioni per le parole che le regole sbagliano: i
+// tonica in iato (farmacia, bugia), gl non palatale (glicine), z sorda
+// iniziale (zio, zucchero).
+//
+// Le regole coprono i digrammi e i trigrammi (ch, gh, gn, gli, sc, sci),
+// la i diacritica, le semivocali, la s sonora davanti a consonante sonora,
+// la z sonora a inizio parola, le doppie e l'allungamento fra vocali. La i
+// tonica delle terminazioni dotte (-logia, -grafia, -nomia...) resta
+// vocale. La distinzione fra e/o aperte e chiuse senza accento grafico non
+// è ricostruibile dalla scrittura: vengono trascritte chiuse.
+//
+// Non è thread-safe: usare un'istanza per thread.
+class Phonemizer {
+ public:
+  static constexpr size_t kDefaultCachedWords = 1024;
+
+  explicit Phonemizer(size_t cached_words = kDefaultCachedWords)
+      : cache_(cached_words) {}
+
+  // Trascrive |word| (minuscola, code point) in |phones|. I caratteri che
+  // non sono lettere (apostrofi, trattini, cifre) vengono ignorati.
+  void Phonemize(const std::u32string& word, std::u32string* phones) const;
+
+  // Pronuncia UTF-8 di |word| (UTF-8, maiuscole ammesse), dalla cache delle
+  // parole recenti o calcolata ora. Resta valida fino alla chiamata
+  // successiva.
+  std::string_view Pronounce(std::string_view word);
+
+  // Pronuncia di un testo normalizzato (parole minuscole separate da uno
+  // spazio, come NormalizeText), parola per parola dalla stessa cache. Le
+  // parole restano separate da uno spazio; quelle senza lettere vengono
+  // saltate.
+  void PronounceText(const std::u32string& text, std::u32string* phones);
+
+  const LruCache<std::string, std::string>& cache() const { return cache_; }
+
+ private:
+  // Pronuncia UTF-8 di |word| (minuscola), dalla cache o calcolata ora.
+  const std::string& Cached(const std::u32string& word);
+
+  LruCache<std::string, std::string> cache_;
+  std::string key_;
+  std::u32string decoded_;
+  std::u32string word_;
+  std::u32string phones_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_PHONEMIZER_H_
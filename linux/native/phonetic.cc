@@ -0,0 +1,53 @@
+// linux/native/phonetic.cc
+
+#include "phonetic.h"
+
+namespace opendsa {
+
+namespace {
+
+inline bool IsFrontVowel(char32_t cp) { return cp == 'i' || cp == 'e'; }
+
+}  // namespace
+
+void PhoneticCode(const std::u32string& text, std::u32string* out) {
+  out->clear();
+  out->reserve(text.size());
+  const size_t length = text.size();
+  size_t i = 0;
+  while (i < length) {
+    const char32_t cp = text[i];
+    const char32_t next = i + 1 < length ? text[i + 1] : 0;
+    const char32_t after = i + 2 < length ? text[i + 2] : 0;
+
+    // chi/che -> ki/ke, ghi/ghe -> gi/ge
+    if ((cp == 'c' || cp == 'g') && next == 'h' && IsFrontVowel(after)) {
+      out->push_back(cp == 'c' ? 'k' : 'g');
+      out->push_back(after);
+      i += 3;
+      continue;
+    }
+    if (cp == 'g' && next == 'n') {
+      out->push_back(0xF1);  // ñ
+      i += 2;
+      continue;
+    }
+    if (cp == 'g' && next == 'l') {
+      out->push_back(0x28E);  // ʎ
+      i += 2;
+      continue;
+    }
+    // "sc" seguito da "hi"/"he" lascia il posto alla regola di "chi"/"che",
+    // che nella versione Dart viene applicata per prima.
+    if (cp == 's' && next == 'c' &&
+        !(after == 'h' && i + 3 < length && IsFrontVowel(text[i + 3]))) {
+      out->push_back(0x283);  // ʃ
+      i += 2;
+      continue;
+    }
+    out->push_back(cp);
+    i++;
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,18 @@
+// linux/native/phonetic.h
+
+#ifndef OPENDSA_NATIVE_PHONETIC_H_
+#define OPENDSA_NATIVE_PHONETIC_H_
+
+#include <string>
+
+namespace opendsa {
+
+// Porta nativa di TextSimilarity._getPhoneticCode: chi/che -> ki/ke,
+// ghi/ghe -> gi/ge, gn -> ñ, gl -> ʎ, sc -> ʃ. Le regole sono applicate in un
+// solo passaggio da sinistra a destra con lo stesso risultato delle
+// sostituzioni in cascata della versione Dart.
+void PhoneticCode(const std::u32string& text, std::u32string* out);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_PHONETIC_H_
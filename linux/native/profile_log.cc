@@ -0,0 +1,279 @@
+// linux/native/profile_log.cc
+
+#include "profile_log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// crc32, size, type, reserved, key_size
+constexpr size_t kRecordPrefix = 8;
+constexpr size_t kRecordFields = 4;
+
+uint32_t ReadU32(const char* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint64_t RecordBytes(std::string_view key, std::string_view value) {
+  return kRecordPrefix + kRecordFields + key.size() + value.size();
+}
+
+void AppendRecord(uint8_t type, std::string_view key, std::string_view value,
+                  std::string* out) {
+  const size_t begin = out->size();
+  const auto size = static_cast<uint32_t>(kRecordFields + key.size() + value.size());
+  const auto key_size = static_cast<uint16_t>(key.size());
+  out->append(sizeof(uint32_t), '\0');  // CRC, scritto alla fine
+  out->append(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->push_back(static_cast<char>(type));
+  out->push_back('\0');
+  out->append(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+  out->append(key);
+  out->append(value);
+  const uint32_t crc = Crc32(out->data() + begin + sizeof(uint32_t),
+                             out->size() - begin - sizeof(uint32_t));
+  std::memcpy(&(*out)[begin], &crc, sizeof(crc));
+}
+
+}  // namespace
+
+ProfileLog::~ProfileLog() { Close(); }
+
+bool ProfileLog::Open(const std::string& path, bool sync) {
+  Close();
+  path_ = path;
+  sync_ = sync;
+
+  // Un file esistente ma illeggibile non va sostituito con uno vuoto
+  std::string data;
+  if (FileExists(path) && !ReadFile(path, &data)) return false;
+  if (data.empty()) {
+    ProfileLogHeader header = {};
+    std::memcpy(header.magic, kProfileLogMagic, sizeof(header.magic));
+    header.version = kProfileLogVersion;
+    if (!WriteFileAtomically(path, &header, sizeof(header))) return false;
+    data.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  if (!Replay(data) || !OpenForAppend()) {
+    Close();
+    return false;
+  }
+  // La coda non valida viene tolta prima di accodare altri record
+  if (stats_.bytes_truncated > 0 &&
+      ftruncate(fd_, static_cast<off_t>(stats_.log_bytes)) != 0) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void ProfileLog::Close() {
+  if (fd_ >= 0) close(fd_);
+  fd_ = -1;
+  entries_.clear();
+  stats_ = ProfileLogStats();
+}
+
+bool ProfileLog::Replay(const std::string& data) {
+  if (data.size() < sizeof(ProfileLogHeader)) return false;
+  ProfileLogHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kProfileLogMagic, sizeof(header.magic)) != 0 ||
+      header.version != kProfileLogVersion) {
+    return false;
+  }
+
+  size_t offset = sizeof(ProfileLogHeader);
+  while (data.size() - offset >= kRecordPrefix + kRecordFields) {
+    const char* record = data.data() + offset;
+    const uint32_t size = ReadU32(record + sizeof(uint32_t));
+    if (size < kRecordFields || size > kMaxRecordSize ||
+        size > data.size() - offset - kRecordPrefix ||
+        Crc32(record + sizeof(uint32_t), size + sizeof(uint32_t)) !=
+            ReadU32(record)) {
+      break;
+    }
+    const uint8_t type = static_cast<uint8_t>(record[kRecordPrefix]);
+    uint16_t key_size;
+    std::memcpy(&key_size, record + kRecordPrefix + 2, sizeof(key_size));
+    if (key_size > size - kRecordFields ||
+        (type != kProfileRecordPut && type != kProfileRecordErase)) {
+      break;
+    }
+    const char* payload = record + kRecordPrefix + kRecordFields;
+    const std::string_view key(payload, key_size);
+    const std::string_view value(payload + key_size,
+                                 size - kRecordFields - key_size);
+
+    ApplyInMemory(type, key, value);
+    stats_.records_replayed++;
+    offset += kRecordPrefix + size;
+  }
+
+  stats_.log_bytes = offset;
+  stats_.bytes_truncated = data.size() - offset;
+  stats_.live_bytes += sizeof(ProfileLogHeader);
+  return true;
+}
+
+bool ProfileLog::OpenForAppend() {
+  if (fd_ >= 0) close(fd_);
+  fd_ = open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  return fd_ >= 0;
+}
+
+std::vector<std::pair<std::string, std::string>>::iterator ProfileLog::Find(
+    std::string_view key) {
+  return std::lower_bound(
+      entries_.begin(), entries_.end(), key,
+      [](const std::pair<std::string, std::string>& entry,
+         std::string_view wanted) { return entry.first < wanted; });
+}
+
+const std::string* ProfileLog::Get(std::string_view key) const {
+  const auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), key,
+      [](const std::pair<std::string, std::string>& entry,
+         std::string_view wanted) { return entry.first < wanted; });
+  return it != entries_.end() && it->first == key ? &it->second : nullptr;
+}
+
+int ProfileLog::Append(uint8_t type, std::string_view key,
+                       std::string_view value) {
+  if (key.size() > UINT16_MAX ||
+      kRecordFields + key.size() + value.size() > kMaxRecordSize) {
+    return -1;
+  }
+  record_.clear();
+  AppendRecord(type, key, value, &record_);
+  return WriteRecords(1) ? 1 : -1;
+}
+
+bool ProfileLog::WriteRecords(uint64_t count) {
+  if (fd_ < 0) return false;
+  if (!WriteAll(fd_, record_.data(), record_.size()) ||
+      (sync_ && fdatasync(fd_) != 0)) {
+    // Un record scritto a metà renderebbe illeggibili i successivi: si
+    // torna all'ultima fine valida, o si smette di scrivere se non si può
+    if (ftruncate(fd_, static_cast<off_t>(stats_.log_bytes)) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+    return false;
+  }
+  stats_.log_bytes += record_.size();
+  stats_.records_appended += count;
+  return true;
+}
+
+void ProfileLog::ApplyInMemory(uint8_t type, std::string_view key,
+                               std::string_view value) {
+  const auto it = Find(key);
+  const bool found = it != entries_.end() && it->first == key;
+  if (found) stats_.live_bytes -= RecordBytes(it->first, it->second);
+  if (type == kProfileRecordErase) {
+    if (found) entries_.erase(it);
+    return;
+  }
+  if (found) {
+    it->second.assign(value);
+  } else {
+    entries_.emplace(it, std::string(key), std::string(value));
+  }
+  stats_.live_bytes += RecordBytes(key, value);
+}
+
+void ProfileLog::MaybeCompact() {
+  if (stats_.log_bytes > kMinCompactBytes &&
+      stats_.log_bytes > 2 * stats_.live_bytes) {
+    Compact();  // Se fallisce il log resta valido, solo più lungo
+  }
+}
+
+int ProfileLog::Put(std::string_view key, std::string_view value) {
+  const std::string* current = Get(key);
+  if (current != nullptr && *current == value) {
+    stats_.writes_skipped++;
+    return 0;
+  }
+  if (Append(kProfileRecordPut, key, value) < 0) return -1;
+  ApplyInMemory(kProfileRecordPut, key, value);
+  MaybeCompact();
+  return 1;
+}
+
+int ProfileLog::Erase(std::string_view key) {
+  if (Get(key) == nullptr) {
+    stats_.writes_skipped++;
+    return 0;
+  }
+  if (Append(kProfileRecordErase, key, {}) < 0) return -1;
+  ApplyInMemory(kProfileRecordErase, key, {});
+  return 1;
+}
+
+int ProfileLog::Apply(const std::vector<ProfileMutation>& mutations) {
+  record_.clear();
+  uint64_t count = 0;
+  for (const ProfileMutation& mutation : mutations) {
+    const std::string* current = Get(mutation.key);
+    if (mutation.erase ? current == nullptr
+                       : current != nullptr && *current == mutation.value) {
+      stats_.writes_skipped++;
+      continue;
+    }
+    if (mutation.key.size() > UINT16_MAX ||
+        kRecordFields + mutation.key.size() + mutation.value.size() >
+            kMaxRecordSize) {
+      return -1;
+    }
+    AppendRecord(mutation.erase ? kProfileRecordErase : kProfileRecordPut,
+                 mutation.key, mutation.value, &record_);
+    count++;
+  }
+  if (count == 0) return 0;
+  if (!WriteRecords(count)) return -1;
+
+  // Le chiavi sono distinte: ogni modifica saltata sopra lo è anche qui
+  for (const ProfileMutation& mutation : mutations) {
+    ApplyInMemory(mutation.erase ? kProfileRecordErase : kProfileRecordPut,
+                  mutation.key, mutation.value);
+  }
+  MaybeCompact();
+  return static_cast<int>(count);
+}
+
+bool ProfileLog::Compact() {
+  if (fd_ < 0) return false;
+  ProfileLogHeader header = {};
+  std::memcpy(header.magic, kProfileLogMagic, sizeof(header.magic));
+  header.version = kProfileLogVersion;
+
+  std::string snapshot;
+  snapshot.reserve(stats_.live_bytes);
+  snapshot.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto& [key, value] : entries_) {
+    AppendRecord(kProfileRecordPut, key, value, &snapshot);
+  }
+  if (!WriteFileAtomically(path_, snapshot.data(), snapshot.size())) {
+    return false;
+  }
+  // Il descrittore punta ancora al file sostituito
+  if (!OpenForAppend()) return false;
+  stats_.log_bytes = snapshot.size();
+  stats_.compactions++;
+  return true;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,141 @@
+// linux/native/profile_log.h
+
+#ifndef OPENDSA_NATIVE_PROFILE_LOG_H_
+#define OPENDSA_NATIVE_PROFILE_LOG_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace opendsa {
+
+// Archivio di un profilo strutturato come log: lo stato è una mappa da
+// chiave a valore (in pratica i campi di Player.toJson, con i valori
+// codificati in JSON) e ogni modifica viene accodata al file come un piccolo
+// record con CRC, invece di riscrivere tutto il profilo.
+//
+// Layout del file (little-endian):
+//   ProfileLogHeader                   16 byte
+//   record...
+//
+// Record:
+//   crc32     u32   CRC dei byte successivi del record (size e payload)
+//   size      u32   byte del payload
+//   type      u8    kProfileRecordPut / kProfileRecordErase
+//   reserved  u8
+//   key_size  u16
+//   chiave, valore  (valore: size - 4 - key_size byte)
+//
+// All'apertura i record vengono riapplicati in ordine. Il primo record
+// troncato o con CRC errato segna la fine del log (una scrittura interrotta
+// da un crash): il file viene accorciato lì e le scritture successive
+// ripartono da un punto valido. Quando il log supera il doppio dei dati vivi
+// viene compattato: lo stato corrente viene riscritto come snapshot, un
+// record per chiave, in un nuovo file che sostituisce il vecchio in modo
+// atomico.
+//
+// Non è thread-safe.
+constexpr char kProfileLogMagic[8] = {'O', 'D', 'S', 'A', 'P', 'L', 'O', 'G'};
+constexpr uint32_t kProfileLogVersion = 1;
+
+constexpr uint8_t kProfileRecordPut = 1;
+constexpr uint8_t kProfileRecordErase = 2;
+
+struct ProfileLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(ProfileLogHeader) == 16,
+              "ProfileLogHeader deve restare 16 byte");
+
+struct ProfileLogStats {
+  uint64_t records_replayed = 0;   // Record riapplicati all'apertura
+  uint64_t records_appended = 0;   // Record scritti da questa istanza
+  uint64_t writes_skipped = 0;     // Put con il valore già presente
+  uint64_t bytes_truncated = 0;    // Coda non valida scartata all'apertura
+  uint64_t compactions = 0;
+  uint64_t log_bytes = 0;          // Dimensione attuale del file
+  uint64_t live_bytes = 0;         // Dimensione di uno snapshot dello stato
+};
+
+// Modifica di una chiave, per le scritture raggruppate di Apply.
+struct ProfileMutation {
+  std::string key;
+  std::string value;
+  bool erase = false;
+};
+
+class ProfileLog {
+ public:
+  // Il log viene compattato quando supera il doppio dello snapshot e almeno
+  // questa dimensione: i profili piccoli non vengono riscritti di continuo.
+  static constexpr uint64_t kMinCompactBytes = 64 * 1024;
+
+  // Limite di un singolo record, anche come difesa da dimensioni corrotte.
+  static constexpr uint32_t kMaxRecordSize = 16 * 1024 * 1024;
+
+  ProfileLog() = default;
+  ~ProfileLog();
+  ProfileLog(const ProfileLog&) = delete;
+  ProfileLog& operator=(const ProfileLog&) = delete;
+
+  // Apre il log in |path|, creandolo se non esiste, e ne riapplica i
+  // record. Con |sync| ogni scrittura attende fsync prima di restituire.
+  // Restituisce false se il file non è accessibile o ha un formato diverso.
+  bool Open(const std::string& path, bool sync = true);
+  void Close();
+
+  // Imposta |key| a |value|. Restituisce 1 se il record è stato accodato, 0
+  // se il valore era già quello, -1 in caso di errore di scrittura (lo stato
+  // in memoria resta quello precedente).
+  int Put(std::string_view key, std::string_view value);
+
+  // Rimuove |key|, con lo stesso risultato di Put.
+  int Erase(std::string_view key);
+
+  // Applica più modifiche con una sola scrittura e un solo fsync (group
+  // commit); le chiavi devono essere distinte. Le modifiche che non cambiano
+  // lo stato vengono saltate. Restituisce i record accodati, -1 in caso di
+  // errore di scrittura (nessuna modifica viene applicata).
+  int Apply(const std::vector<ProfileMutation>& mutations);
+
+  // Valore di |key|, null se assente. Resta valido fino alla modifica
+  // successiva.
+  const std::string* Get(std::string_view key) const;
+
+  // Coppie chiave-valore in ordine di chiave.
+  const std::vector<std::pair<std::string, std::string>>& entries() const {
+    return entries_;
+  }
+
+  // Riscrive il log come snapshot dello stato corrente.
+  bool Compact();
+
+  const ProfileLogStats& stats() const { return stats_; }
+  bool is_open() const { return fd_ >= 0; }
+
+ private:
+  bool Replay(const std::string& data);
+  int Append(uint8_t type, std::string_view key, std::string_view value);
+  bool WriteRecords(uint64_t count);
+  void ApplyInMemory(uint8_t type, std::string_view key, std::string_view value);
+  void MaybeCompact();
+  bool OpenForAppend();
+  std::vector<std::pair<std::string, std::string>>::iterator Find(
+      std::string_view key);
+
+  std::string path_;
+  int fd_ = -1;
+  bool sync_ = true;
+  std::vector<std::pair<std::string, std::string>> entries_;
+  std::string record_;  // Buffer riusato per il record da accodare
+  ProfileLogStats stats_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_PROFILE_LOG_H_
@@ -0,0 +1,208 @@
+// linux/native/profile_store.cc
+
+#include "profile_store.h"
+
+#include <algorithm>
+
+namespace opendsa {
+
+ProfileStore::~ProfileStore() { Close(); }
+
+bool ProfileStore::Open(const std::string& path, bool sync) {
+  Close();
+  std::lock_guard<std::mutex> commit_lock(commit_mutex_);
+  if (!log_.Open(path, sync)) return false;
+  entries_ = log_.entries();
+  open_ = true;
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = ProfileStoreStats();
+  stats_.log = log_.stats();
+  failed_ = false;
+  if (window_.count() > 0) StartWorker();
+  return true;
+}
+
+void ProfileStore::Close() {
+  if (!open_) return;
+  StopWorker();
+  Commit();  // Se non riesce, le modifiche in attesa vanno perse
+  std::lock_guard<std::mutex> commit_lock(commit_mutex_);
+  log_.Close();
+  entries_.clear();
+  open_ = false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_.clear();
+}
+
+void ProfileStore::set_commit_window(std::chrono::milliseconds window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  window_ = std::max(window, std::chrono::milliseconds(0));
+  if (open_ && window_.count() > 0) StartWorker();
+  wake_.notify_one();
+}
+
+void ProfileStore::StartWorker() {
+  if (worker_.joinable()) return;
+  stopping_ = false;
+  worker_ = std::thread(&ProfileStore::Run, this);
+}
+
+void ProfileStore::StopWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  if (worker_.joinable()) worker_.join();
+}
+
+void ProfileStore::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+    if (stopping_) return;
+    // Le modifiche che arrivano entro la finestra dalla prima finiscono
+    // nella stessa scrittura
+    wake_.wait_until(lock, first_pending_ + window_,
+                     [this] { return stopping_ || pending_.empty(); });
+    if (stopping_) return;
+    if (pending_.empty()) continue;  // Già scritte da Flush
+    lock.unlock();
+    Commit();
+    lock.lock();
+  }
+}
+
+std::vector<std::pair<std::string, std::string>>::iterator ProfileStore::Find(
+    std::string_view key) {
+  return std::lower_bound(
+      entries_.begin(), entries_.end(), key,
+      [](const std::pair<std::string, std::string>& entry,
+         std::string_view wanted) { return entry.first < wanted; });
+}
+
+const std::string* ProfileStore::Get(std::string_view key) const {
+  const auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), key,
+      [](const std::pair<std::string, std::string>& entry,
+         std::string_view wanted) { return entry.first < wanted; });
+  return it != entries_.end() && it->first == key ? &it->second : nullptr;
+}
+
+int ProfileStore::Put(std::string_view key, std::string_view value) {
+  // Un record che il log rifiuterebbe non va messo in attesa
+  if (!open_ || key.size() > UINT16_MAX ||
+      sizeof(uint32_t) + key.size() + value.size() >
+          ProfileLog::kMaxRecordSize) {
+    return -1;
+  }
+  auto it = Find(key);
+  const bool found = it != entries_.end() && it->first == key;
+  if (found && it->second == value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.writes_requested++;
+    return 0;
+  }
+  if (found) {
+    it->second.assign(value);
+  } else {
+    entries_.emplace(it, std::string(key), std::string(value));
+  }
+  Stage(key, value, false);
+  return Submit() ? 1 : -1;
+}
+
+int ProfileStore::Erase(std::string_view key) {
+  if (!open_ || key.size() > UINT16_MAX) return -1;
+  const auto it = Find(key);
+  if (it == entries_.end() || it->first != key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.writes_requested++;
+    return 0;
+  }
+  entries_.erase(it);
+  Stage(key, {}, true);
+  return Submit() ? 1 : -1;
+}
+
+void ProfileStore::Stage(std::string_view key, std::string_view value,
+                         bool erase) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.writes_requested++;
+    if (pending_.empty()) first_pending_ = std::chrono::steady_clock::now();
+    auto it = pending_.find(key);
+    if (it != pending_.end()) {
+      stats_.writes_coalesced++;
+    } else {
+      it = pending_.emplace(std::string(key), ProfileMutation()).first;
+      it->second.key.assign(key);
+    }
+    it->second.value.assign(value);
+    it->second.erase = erase;
+  }
+  wake_.notify_one();
+}
+
+bool ProfileStore::Flush() { return Commit(); }
+
+bool ProfileStore::Submit() {
+  // Con la finestra attiva la scrittura resta al thread interno: qui si
+  // segnala solo un errore di quella precedente
+  bool deferred;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    deferred = window_.count() > 0 && worker_.joinable();
+  }
+  if (!deferred) return Commit();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const bool failed = failed_;
+  failed_ = false;
+  return !failed;
+}
+
+bool ProfileStore::Commit() {
+  std::lock_guard<std::mutex> commit_lock(commit_mutex_);
+  std::vector<ProfileMutation> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch.reserve(pending_.size());
+    for (auto& [key, mutation] : pending_) batch.push_back(std::move(mutation));
+    pending_.clear();
+  }
+  const int written = batch.empty() ? 0 : log_.Apply(batch);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (written < 0) {
+    // Si ritenta alla prossima occasione, salvo le chiavi modificate di nuovo
+    // nel frattempo
+    if (pending_.empty()) first_pending_ = std::chrono::steady_clock::now();
+    for (ProfileMutation& mutation : batch) {
+      std::string key = mutation.key;
+      pending_.try_emplace(std::move(key), std::move(mutation));
+    }
+    stats_.failed_commits++;
+    failed_ = true;
+    return false;
+  }
+  if (written > 0) stats_.commits++;
+  stats_.log = log_.stats();
+  failed_ = false;
+  return true;
+}
+
+bool ProfileStore::Compact() {
+  if (!open_ || !Commit()) return false;
+  std::lock_guard<std::mutex> commit_lock(commit_mutex_);
+  const bool compacted = log_.Compact();
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.log = log_.stats();
+  return compacted;
+}
+
+ProfileStoreStats ProfileStore::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace opendsa
@@ -0,0 +1,117 @@
+// linux/native/profile_store.h
+
+#ifndef OPENDSA_NATIVE_PROFILE_STORE_H_
+#define OPENDSA_NATIVE_PROFILE_STORE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "profile_log.h"
+
+namespace opendsa {
+
+struct ProfileStoreStats {
+  uint64_t writes_requested = 0;  // Put ed Erase ricevuti
+  uint64_t writes_coalesced = 0;  // Modifiche sostituite da una più recente
+  uint64_t commits = 0;           // Scritture sul file, un fsync ciascuna
+  uint64_t failed_commits = 0;
+  ProfileLogStats log;
+};
+
+// ProfileLog con scritture raggruppate (group commit). Lo stato visibile si
+// aggiorna subito, mentre le modifiche restano in attesa per una finestra di
+// tempo dalla prima: un thread le scrive poi tutte insieme, una sola per
+// chiave, con una sola write e un solo fsync. Le raffiche di salvataggi del
+// profilo (ogni setter di Player salva) diventano così una scrittura. Flush()
+// rende durevole subito quanto in attesa, ad esempio a fine sessione o alla
+// chiusura dell'app; con finestra zero ogni modifica è scritta subito, come
+// con ProfileLog.
+//
+// Put, Erase, Get ed entries() vanno chiamati da un solo thread alla volta;
+// la scrittura avviene sul thread interno o in Flush().
+class ProfileStore {
+ public:
+  ProfileStore() = default;
+  ~ProfileStore();
+  ProfileStore(const ProfileStore&) = delete;
+  ProfileStore& operator=(const ProfileStore&) = delete;
+
+  // Apre il log in |path| come ProfileLog::Open.
+  bool Open(const std::string& path, bool sync = true);
+
+  // Scrive quanto in attesa e chiude il file.
+  void Close();
+
+  // Finestra di raggruppamento delle modifiche; zero le scrive subito.
+  void set_commit_window(std::chrono::milliseconds window);
+
+  // Imposta |key| a |value|. Restituisce 1 se lo stato è cambiato, 0 se il
+  // valore era già quello, -1 se la scrittura (questa o una precedente in
+  // attesa) non è riuscita: lo stato visibile resta aggiornato e la
+  // scrittura viene ritentata alla successiva.
+  int Put(std::string_view key, std::string_view value);
+
+  // Rimuove |key|, con lo stesso risultato di Put.
+  int Erase(std::string_view key);
+
+  // Valore di |key|, null se assente. Resta valido fino alla modifica
+  // successiva.
+  const std::string* Get(std::string_view key) const;
+
+  // Coppie chiave-valore in ordine di chiave, comprese quelle in attesa.
+  const std::vector<std::pair<std::string, std::string>>& entries() const {
+    return entries_;
+  }
+
+  // Scrive subito le modifiche in attesa. Restituisce false se la scrittura
+  // non è riuscita.
+  bool Flush();
+
+  // Scrive le modifiche in attesa e riscrive il log come snapshot.
+  bool Compact();
+
+  ProfileStoreStats stats() const;
+  bool is_open() const { return open_; }
+
+ private:
+  void Stage(std::string_view key, std::string_view value, bool erase);
+  bool Submit();
+  bool Commit();
+  void StartWorker();
+  void StopWorker();
+  void Run();
+
+  std::vector<std::pair<std::string, std::string>>::iterator Find(
+      std::string_view key);
+
+  // Solo per il thread che modifica il profilo
+  std::vector<std::pair<std::string, std::string>> entries_;
+  bool open_ = false;
+
+  // Serializza le scritture sul log, nell'ordine in cui le modifiche sono
+  // state prelevate; si acquisisce prima di mutex_
+  std::mutex commit_mutex_;
+  ProfileLog log_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::map<std::string, ProfileMutation, std::less<>> pending_;
+  std::chrono::steady_clock::time_point first_pending_;
+  std::chrono::milliseconds window_{0};
+  bool failed_ = false;  // Scrittura non riuscita non ancora segnalata
+  bool stopping_ = false;
+  ProfileStoreStats stats_;
+  std::thread worker_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_PROFILE_STORE_H_
@@ -0,0 +1,119 @@
+// linux/native/resampler.cc
+
+#include "resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace opendsa {
+
+namespace {
+
+// Banda passante rispetto alla metà della frequenza più bassa: il resto è
+// la banda di transizione del filtro
+constexpr double kRolloff = 0.95;
+constexpr double kPi = 3.14159265358979323846;
+
+}  // namespace
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate) {
+  input_rate = std::max(input_rate, 1u);
+  output_rate = std::max(output_rate, 1u);
+  const uint32_t divisor = std::gcd(input_rate, output_rate);
+  up_ = output_rate / divisor;
+  down_ = input_rate / divisor;
+  half_ = 0;
+  if (!passthrough()) {
+    // In riduzione il filtro si allarga in proporzione, in campioni di
+    // ingresso
+    const double scale =
+        kRolloff * std::min(1.0, static_cast<double>(up_) / down_);
+    const double half_width = kZeroCrossings / scale;
+    half_ = static_cast<int32_t>(std::ceil(half_width));
+    const size_t width = 2 * static_cast<size_t>(half_);
+    taps_.resize(up_ * width);
+    for (uint32_t phase = 0; phase < up_; ++phase) {
+      float* taps = &taps_[phase * width];
+      const double fraction = static_cast<double>(phase) / up_;
+      double sum = 0.0;
+      for (int32_t d = -half_ + 1; d <= half_; ++d) {
+        const double x = d - fraction;
+        double value = 0.0;
+        if (std::fabs(x) < half_width) {
+          const double sinc =
+              x == 0.0 ? 1.0 : std::sin(kPi * scale * x) / (kPi * scale * x);
+          const double window = 0.5 * (1.0 + std::cos(kPi * x / half_width));
+          value = sinc * window;
+        }
+        taps[d + half_ - 1] = static_cast<float>(value);
+        sum += value;
+      }
+      for (size_t i = 0; i < width; ++i) {
+        taps[i] = static_cast<float>(taps[i] / sum);
+      }
+    }
+  }
+  Reset();
+}
+
+void Resampler::Process(const int16_t* samples, size_t count,
+                        std::vector<int16_t>* out) {
+  consumed_ += count;
+  if (passthrough()) {
+    out->insert(out->end(), samples, samples + count);
+    return;
+  }
+  buffer_.insert(buffer_.end(), samples, samples + count);
+  Produce(UINT64_MAX, out);
+}
+
+void Resampler::Flush(std::vector<int16_t>* out) {
+  if (!passthrough()) {
+    // Silenzio oltre la fine, quanto basta al filtro dell'ultimo campione
+    buffer_.insert(buffer_.end(), static_cast<size_t>(half_) + 1, 0.0f);
+    Produce(OutputSize(consumed_), out);
+  }
+  Reset();
+}
+
+uint64_t Resampler::OutputSize(uint64_t input) const {
+  return (input * up_ + down_ - 1) / down_;
+}
+
+void Resampler::Reset() {
+  // I campioni prima dell'inizio del flusso valgono zero
+  buffer_.assign(static_cast<size_t>(half_), 0.0f);
+  base_ = -half_;
+  consumed_ = 0;
+  produced_ = 0;
+}
+
+void Resampler::Produce(uint64_t limit, std::vector<int16_t>* out) {
+  const size_t width = 2 * static_cast<size_t>(half_);
+  const int64_t end = base_ + static_cast<int64_t>(buffer_.size());
+  for (; produced_ < limit; ++produced_) {
+    const uint64_t position = produced_ * down_;
+    const int64_t center = static_cast<int64_t>(position / up_);
+    if (center + half_ >= end) break;
+    const float* taps = &taps_[(position % up_) * width];
+    const float* input = &buffer_[center - half_ + 1 - base_];
+    float sum = 0.0f;
+    for (size_t i = 0; i < width; ++i) sum += input[i] * taps[i];
+    out->push_back(static_cast<int16_t>(
+        std::lrint(std::clamp(sum, -32768.0f, 32767.0f))));
+  }
+
+  // Scarta l'ingresso che non serve più al prossimo campione
+  const int64_t first =
+      static_cast<int64_t>(produced_ * down_ / up_) - half_ + 1;
+  if (first > base_) {
+    const size_t drop =
+        std::min(buffer_.size(), static_cast<size_t>(first - base_));
+    buffer_.erase(buffer_.begin(),
+                  buffer_.begin() + static_cast<std::ptrdiff_t>(drop));
+    base_ += static_cast<int64_t>(drop);
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,65 @@
+// linux/native/resampler.h
+
+#ifndef OPENDSA_NATIVE_RESAMPLER_H_
+#define OPENDSA_NATIVE_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace opendsa {
+
+// Conversione della frequenza di campionamento di un flusso mono a 16 bit,
+// ad esempio dai 32 kHz del registratore ai 16 kHz del modello di
+// riconoscimento.
+//
+// Ogni campione in uscita è la convoluzione dell'ingresso con un sinc
+// finestrato (Hann) tagliato a metà della frequenza più bassa, con
+// kZeroCrossings zeri per lato. Il rapporto tra le frequenze viene ridotto
+// a L/M e i coefficienti delle L fasi sono calcolati una volta sola; ogni
+// fase è normalizzata a guadagno unitario in continua.
+//
+// Il flusso può arrivare a blocchi di dimensione qualsiasi: il risultato è
+// lo stesso dell'intero segnale convertito in una volta.
+class Resampler {
+ public:
+  static constexpr int kZeroCrossings = 16;
+
+  Resampler(uint32_t input_rate, uint32_t output_rate);
+
+  Resampler(const Resampler&) = delete;
+  Resampler& operator=(const Resampler&) = delete;
+
+  // Accoda |count| campioni e aggiunge a |out| quelli in uscita già
+  // calcolabili.
+  void Process(const int16_t* samples, size_t count,
+               std::vector<int16_t>* out);
+
+  // Chiude il flusso (con silenzio dopo l'ultimo campione) e aggiunge a
+  // |out| i campioni rimasti. Dopo Flush il convertitore riparte da zero.
+  void Flush(std::vector<int16_t>* out);
+
+  // Campioni in uscita per |input| campioni in ingresso, arrotondati per
+  // eccesso.
+  uint64_t OutputSize(uint64_t input) const;
+
+  bool passthrough() const { return up_ == down_; }
+
+ private:
+  void Reset();
+  void Produce(uint64_t limit, std::vector<int16_t>* out);
+
+  uint32_t up_;    // L
+  uint32_t down_;  // M
+  int32_t half_;   // Campioni di ingresso per lato del filtro
+  std::vector<float> taps_;  // up_ fasi di 2 * half_ coefficienti
+
+  std::vector<float> buffer_;  // Ingresso non ancora consumato
+  int64_t base_ = 0;           // Indice nel flusso di buffer_[0]
+  uint64_t consumed_ = 0;      // Campioni ricevuti
+  uint64_t produced_ = 0;      // Campioni emessi
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_RESAMPLER_H_
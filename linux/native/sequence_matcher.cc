@@ -0,0 +1,78 @@
+// linux/native/sequence_matcher.cc
+
+#include "sequence_matcher.h"
+
+#include <queue>
+
+namespace opendsa {
+
+SequenceMatcher::SequenceMatcher(const std::vector<std::u32string>& patterns) {
+  std::array<int16_t, kNumCharClasses> empty;
+  empty.fill(-1);
+  next_.push_back(empty);
+  output_.push_back(0);
+
+  // Costruzione del trie
+  for (size_t p = 0; p < patterns.size() && p < kMaxPatterns; p++) {
+    int state = 0;
+    for (char32_t cp : patterns[p]) {
+      const int cls = CharClass(cp);
+      if (next_[state][cls] < 0) {
+        next_[state][cls] = static_cast<int16_t>(next_.size());
+        next_.push_back(empty);
+        output_.push_back(0);
+      }
+      state = next_[state][cls];
+    }
+    output_[state] |= 1u << p;
+    lengths_.push_back(static_cast<int>(patterns[p].size()));
+  }
+
+  // Link di fallimento in ampiezza, trasformando il trie in un automa completo
+  std::vector<int> fail(next_.size(), 0);
+  std::queue<int> pending;
+  for (int cls = 0; cls < kNumCharClasses; cls++) {
+    if (next_[0][cls] < 0) {
+      next_[0][cls] = 0;
+    } else {
+      pending.push(next_[0][cls]);
+    }
+  }
+  while (!pending.empty()) {
+    const int state = pending.front();
+    pending.pop();
+    output_[state] |= output_[fail[state]];
+    for (int cls = 0; cls < kNumCharClasses; cls++) {
+      const int child = next_[state][cls];
+      if (child < 0) {
+        next_[state][cls] = next_[fail[state]][cls];
+      } else {
+        fail[child] = next_[fail[state]][cls];
+        pending.push(child);
+      }
+    }
+  }
+}
+
+const SequenceMatcher& SequenceMatcher::CommonSequences() {
+  static const SequenceMatcher matcher({
+      U"chi", U"che",  // Suoni chi/che
+      U"ghi", U"ghe",  // Suoni ghi/ghe
+      U"gn",           // Suono gn
+      U"gl",           // Suono gl
+      U"sc",           // Suono sc
+  });
+  return matcher;
+}
+
+uint32_t SequenceMatcher::PresenceMask(const std::u32string& text) const {
+  uint32_t mask = 0;
+  int state = 0;
+  for (char32_t cp : text) {
+    state = next_[state][CharClass(cp)];
+    mask |= output_[state];
+  }
+  return mask;
+}
+
+}  // namespace opendsa
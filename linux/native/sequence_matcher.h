@@ -0,0 +1,59 @@
+// linux/native/sequence_matcher.h
+
+#ifndef OPENDSA_NATIVE_SEQUENCE_MATCHER_H_
+#define OPENDSA_NATIVE_SEQUENCE_MATCHER_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cost_matrix.h"
+
+namespace opendsa {
+
+// Automa di Aho-Corasick sulle sequenze di lettere che causano difficoltà
+// di lettura (chi, che, ghi, ghe, gn, gl, sc). Le transizioni sono indicizzate
+// per classe di carattere, così ogni passo è un singolo accesso a tabella.
+class SequenceMatcher {
+ public:
+  // Massimo numero di pattern, limitato dalla maschera di output a 32 bit.
+  static constexpr int kMaxPatterns = 32;
+
+  explicit SequenceMatcher(const std::vector<std::u32string>& patterns);
+
+  // Automa sulle sequenze di TextSimilarity._commonSequenceErrors.
+  static const SequenceMatcher& CommonSequences();
+
+  // Invoca |fn(pattern, start, length)| per ogni occorrenza in |text|,
+  // in ordine di posizione finale.
+  template <typename Fn>
+  void ForEachMatch(const std::u32string& text, Fn&& fn) const {
+    int state = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      state = next_[state][CharClass(text[i])];
+      uint32_t output = output_[state];
+      while (output != 0) {
+        const int pattern = __builtin_ctz(output);
+        output &= output - 1;
+        const int length = lengths_[pattern];
+        fn(pattern, static_cast<int>(i) + 1 - length, length);
+      }
+    }
+  }
+
+  // Maschera dei pattern presenti almeno una volta in |text|.
+  uint32_t PresenceMask(const std::u32string& text) const;
+
+  int pattern_count() const { return static_cast<int>(lengths_.size()); }
+  int pattern_length(int pattern) const { return lengths_[pattern]; }
+
+ private:
+  std::vector<std::array<int16_t, kNumCharClasses>> next_;
+  std::vector<uint32_t> output_;
+  std::vector<int> lengths_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_SEQUENCE_MATCHER_H_
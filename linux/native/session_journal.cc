@@ -0,0 +1,232 @@
+// linux/native/session_journal.cc
+
+#include "session_journal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "crc32.h"
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// crc32, size, type, reserved
+constexpr size_t kRecordHeaderSize = 4 + 4 + 4;
+
+}  // namespace
+
+SessionJournal::~SessionJournal() { Close(); }
+
+bool SessionJournal::Open(const std::string& path,
+                          std::chrono::milliseconds window) {
+  Close();
+  path_ = path;
+
+  // Un file esistente ma illeggibile non va sostituito con uno vuoto
+  std::string data;
+  if (FileExists(path) && !ReadFile(path, &data)) return false;
+  if (data.empty()) {
+    SessionJournalHeader header = {};
+    std::memcpy(header.magic, kSessionJournalMagic, sizeof(header.magic));
+    header.version = kSessionJournalVersion;
+    data.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!WriteFileAtomically(path, data.data(), data.size())) return false;
+  }
+  size_t valid_end = 0;
+  if (!Replay(data, &valid_end)) {
+    records_.clear();
+    return false;
+  }
+  fd_ = open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  // Il record scritto a metà da un crash viene tolto prima di accodarne altri
+  if (fd_ < 0 || (valid_end < data.size() &&
+                  ftruncate(fd_, static_cast<off_t>(valid_end)) != 0)) {
+    Close();
+    return false;
+  }
+  file_size_ = valid_end;
+
+  window_ = std::max(window, std::chrono::milliseconds(0));
+  if (window_.count() > 0) {
+    stopping_ = false;
+    worker_ = std::thread(&SessionJournal::Run, this);
+  }
+  return true;
+}
+
+void SessionJournal::Close() {
+  StopWorker();
+  if (fd_ >= 0) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      SyncPending(&lock);
+    }
+    close(fd_);
+  }
+  fd_ = -1;
+  file_size_ = 0;
+  records_.clear();
+  unsynced_ = false;
+  failed_ = false;
+}
+
+bool SessionJournal::Replay(const std::string& data, size_t* valid_end) {
+  if (data.size() < sizeof(SessionJournalHeader)) return false;
+  SessionJournalHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kSessionJournalMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != kSessionJournalVersion) {
+    return false;
+  }
+
+  size_t offset = sizeof(SessionJournalHeader);
+  while (data.size() - offset >= kRecordHeaderSize) {
+    uint32_t crc;
+    uint32_t size;
+    std::memcpy(&crc, data.data() + offset, sizeof(crc));
+    std::memcpy(&size, data.data() + offset + 4, sizeof(size));
+    const uint8_t type = static_cast<uint8_t>(data[offset + 8]);
+    if (size > kMaxRecordSize ||
+        data.size() - offset - kRecordHeaderSize < size ||
+        Crc32(data.data() + offset + 4, kRecordHeaderSize - 4 + size) != crc ||
+        (type != kJournalBegin && type != kJournalEntry)) {
+      break;
+    }
+    records_.emplace_back(
+        type, data.substr(offset + kRecordHeaderSize, size));
+    offset += kRecordHeaderSize + size;
+  }
+  *valid_end = offset;
+  return true;
+}
+
+bool SessionJournal::Write(uint8_t type, std::string_view payload) {
+  if (fd_ < 0 || payload.size() > kMaxRecordSize) return false;
+  const auto size = static_cast<uint32_t>(payload.size());
+  record_.assign(kRecordHeaderSize, '\0');
+  std::memcpy(&record_[4], &size, sizeof(size));
+  record_[8] = static_cast<char>(type);
+  record_.append(payload.data(), payload.size());
+  const uint32_t crc = Crc32(record_.data() + 4, record_.size() - 4);
+  std::memcpy(&record_[0], &crc, sizeof(crc));
+
+  if (!WriteAll(fd_, record_.data(), record_.size())) {
+    // Come in ProfileLog: si torna all'ultima fine valida
+    if (ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+      // Il descrittore non va chiuso mentre il thread interno lo sincronizza
+      std::unique_lock<std::mutex> lock(mutex_);
+      synced_.wait(lock, [this] { return !syncing_; });
+      close(fd_);
+      fd_ = -1;
+    }
+    return false;
+  }
+  file_size_ += record_.size();
+  records_.emplace_back(type, std::string(payload));
+  return true;
+}
+
+bool SessionJournal::Truncate() {
+  if (fd_ < 0 ||
+      ftruncate(fd_, static_cast<off_t>(sizeof(SessionJournalHeader))) != 0) {
+    return false;
+  }
+  file_size_ = sizeof(SessionJournalHeader);
+  records_.clear();
+  return true;
+}
+
+bool SessionJournal::Begin(std::string_view payload) {
+  if (!Truncate() || !Write(kJournalBegin, payload)) return false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  unsynced_ = true;
+  return SyncPending(&lock);
+}
+
+bool SessionJournal::Append(std::string_view payload) {
+  if (!Write(kJournalEntry, payload)) return false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (window_.count() == 0) {
+    unsynced_ = true;
+    return SyncPending(&lock);
+  }
+  if (!unsynced_) {
+    unsynced_ = true;
+    first_unsynced_ = std::chrono::steady_clock::now();
+    wake_.notify_one();
+  }
+  const bool ok = !failed_;
+  failed_ = false;
+  return ok;
+}
+
+bool SessionJournal::Sync() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return fd_ >= 0 && SyncPending(&lock);
+}
+
+bool SessionJournal::Commit() {
+  if (!Truncate()) return false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  unsynced_ = true;
+  return SyncPending(&lock);
+}
+
+bool SessionJournal::SyncPending(std::unique_lock<std::mutex>* lock) {
+  // Un fsync già in corso può non coprire i record scritti dopo il suo
+  // inizio: si attende la sua fine e si decide dopo
+  synced_.wait(*lock, [this] { return !syncing_; });
+  bool ok = !failed_;
+  failed_ = false;
+  if (unsynced_) {
+    // Come ProfileStore::Commit: lo stato si aggiorna sotto il lock, l'fsync
+    // avviene fuori, così Append non lo attende
+    unsynced_ = false;
+    syncs_++;
+    syncing_ = true;
+    const int fd = fd_;
+    lock->unlock();
+    const bool synced = fd >= 0 && fdatasync(fd) == 0;
+    lock->lock();
+    syncing_ = false;
+    synced_.notify_all();
+    if (!synced) ok = false;
+  }
+  return ok;
+}
+
+uint64_t SessionJournal::syncs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return syncs_;
+}
+
+void SessionJournal::StopWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  if (worker_.joinable()) worker_.join();
+}
+
+void SessionJournal::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this] { return stopping_ || unsynced_; });
+    if (stopping_) return;
+    // I record che arrivano entro la finestra dal primo condividono l'fsync
+    wake_.wait_until(lock, first_unsynced_ + window_,
+                     [this] { return stopping_ || !unsynced_; });
+    if (stopping_) return;
+    if (!unsynced_) continue;  // Già reso durevole da Sync
+    if (!SyncPending(&lock)) failed_ = true;
+  }
+}
+
+}  // namespace opendsa
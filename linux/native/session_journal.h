@@ -0,0 +1,131 @@
+// linux/native/session_journal.h
+
+#ifndef OPENDSA_NATIVE_SESSION_JOURNAL_H_
+#define OPENDSA_NATIVE_SESSION_JOURNAL_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace opendsa {
+
+// Journal (write-ahead log) della sessione di allenamento in corso: un record
+// kJournalBegin con i dati della sessione, poi un record kJournalEntry per
+// ogni risultato. Ogni record viene scritto subito nel file, quindi
+// sopravvive a un crash dell'app; l'fsync che lo rende durevole anche a uno
+// spegnimento viene raggruppato su una finestra di tempo da un thread
+// interno, come le scritture di ProfileStore. Quando la sessione passa nella
+// cronologia il journal viene svuotato (Commit).
+//
+// Layout del file (little-endian):
+//   SessionJournalHeader                16 byte
+//   record...
+//
+// Record:
+//   crc32     u32   CRC dei byte successivi del record (size, type e payload)
+//   size      u32   byte del payload
+//   type      u8    kJournalBegin / kJournalEntry
+//   reserved  u8[3]
+//   payload
+//
+// All'apertura i record validi vengono riletti in ordine; il primo troncato
+// o con CRC errato segna la fine del journal e il file viene accorciato lì.
+//
+// Le operazioni vanno chiamate da un solo thread alla volta; l'fsync
+// raggruppato avviene sul thread interno o in Sync(), senza tenere il lock:
+// Append non attende l'fsync in corso.
+constexpr char kSessionJournalMagic[8] = {'O', 'D', 'S', 'A', 'S', 'J', 'N', 'L'};
+constexpr uint32_t kSessionJournalVersion = 1;
+
+constexpr uint8_t kJournalBegin = 1;
+constexpr uint8_t kJournalEntry = 2;
+
+struct SessionJournalHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(SessionJournalHeader) == 16,
+              "SessionJournalHeader deve restare 16 byte");
+
+class SessionJournal {
+ public:
+  // Limite di un singolo record, anche come difesa da dimensioni corrotte.
+  static constexpr uint32_t kMaxRecordSize = 1024 * 1024;
+
+  SessionJournal() = default;
+  ~SessionJournal();
+  SessionJournal(const SessionJournal&) = delete;
+  SessionJournal& operator=(const SessionJournal&) = delete;
+
+  // Apre il journal in |path|, creandolo se non esiste, e ne rilegge i
+  // record. Con |window| zero ogni record attende il proprio fsync.
+  // Restituisce false se il file non è accessibile o ha un formato diverso.
+  bool Open(const std::string& path, std::chrono::milliseconds window);
+
+  // Rende durevoli i record in attesa e chiude il file.
+  void Close();
+
+  // Svuota il journal e vi scrive |payload| come record kJournalBegin, con
+  // un fsync immediato.
+  bool Begin(std::string_view payload);
+
+  // Accoda |payload| come record kJournalEntry; l'fsync arriva entro la
+  // finestra. Restituisce false se la scrittura (o l'fsync di un record
+  // precedente) non è riuscita.
+  bool Append(std::string_view payload);
+
+  // Rende subito durevoli i record in attesa.
+  bool Sync();
+
+  // Svuota il journal, ad esempio dopo aver salvato la sessione nella
+  // cronologia.
+  bool Commit();
+
+  // Record nel journal (tipo e payload), in ordine di scrittura.
+  const std::vector<std::pair<uint8_t, std::string>>& records() const {
+    return records_;
+  }
+
+  uint64_t syncs() const;
+  bool is_open() const { return fd_ >= 0; }
+
+ private:
+  bool Replay(const std::string& data, size_t* valid_end);
+  bool Write(uint8_t type, std::string_view payload);
+  bool Truncate();
+  // Rende durevoli i record in attesa. Va chiamata con |lock| su mutex_,
+  // che viene rilasciato durante l'fsync; un fsync alla volta.
+  bool SyncPending(std::unique_lock<std::mutex>* lock);
+  void StopWorker();
+  void Run();
+
+  std::string path_;
+  int fd_ = -1;
+  uint64_t file_size_ = 0;
+  std::vector<std::pair<uint8_t, std::string>> records_;
+  std::string record_;  // Buffer riusato per il record da scrivere
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable synced_;  // Fine dell'fsync in corso
+  bool syncing_ = false;            // fsync in corso fuori dal lock
+  bool unsynced_ = false;
+  std::chrono::steady_clock::time_point first_unsynced_;
+  std::chrono::milliseconds window_{0};
+  bool failed_ = false;  // fsync non riuscito non ancora segnalato
+  bool stopping_ = false;
+  uint64_t syncs_ = 0;
+  std::thread worker_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_SESSION_JOURNAL_H_
@@ -0,0 +1,217 @@
+// linux/native/similarity.cc
+
+#include "similarity.h"
+
+#include <algorithm>
+
+#include "phonetic.h"
+#include "sequence_matcher.h"
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// Flag per posizione usati per attribuire gli errori alle sequenze difficili
+constexpr uint8_t kEdited = 1;         // Il carattere è coinvolto in un errore
+constexpr uint8_t kInsertedBefore = 2;  // Un carattere è stato aggiunto prima
+constexpr uint8_t kInSequenceError = 4;
+
+bool SpanHasError(const std::vector<uint8_t>& flags, int start, int length) {
+  for (int k = start; k < start + length; k++) {
+    if (flags[k] & kEdited) return true;
+    if (k > start && (flags[k] & kInsertedBefore)) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+void Diagnostics::Clear() {
+  inversions = 0;
+  confusions = 0;
+  sequence_errors = 0;
+  omissions = 0;
+  insertions = 0;
+  substitutions = 0;
+  distance = 0;
+  similarity = 0.0;
+  edits.clear();
+}
+
+void SimilarityEngine::Prepare(std::string_view recognized,
+                               std::string_view target) {
+  DecodeUtf8(recognized, &decoded_);
+  NormalizeText(decoded_, &recognized_);
+  DecodeUtf8(target, &decoded_);
+  NormalizeText(decoded_, &target_);
+}
+
+double SimilarityEngine::NormalizedSimilarity(int32_t distance,
+                                              size_t recognized_length,
+                                              size_t target_length) {
+  const size_t max_length = std::max(recognized_length, target_length);
+  return 1.0 - static_cast<double>(distance) / kCostUnit / max_length;
+}
+
+double SimilarityEngine::LevenshteinSimilarity(const std::u32string& recognized,
+                                               const std::u32string& target,
+                                               const CostMatrix& costs) {
+  if (recognized == target) return 1.0;
+  if (recognized.empty() || target.empty()) return 0.0;
+  const int32_t distance = aligner_.Distance(target, recognized, costs);
+  return NormalizedSimilarity(distance, recognized.size(), target.size());
+}
+
+double SimilarityEngine::PhoneticSimilarity(std::string_view target_phones) {
+  // Si confrontano le sequenze di fonemi; il codice fonetico resta per i
+  // testi che non ne producono (senza lettere)
+  if (target_phones.empty()) {
+    phonemizer_.PronounceText(target_, &phonetic_target_);
+  } else {
+    DecodeUtf8(target_phones, &phonetic_target_);
+  }
+  phonemizer_.PronounceText(recognized_, &phonetic_recognized_);
+  if (phonetic_target_.empty() || phonetic_recognized_.empty()) {
+    PhoneticCode(recognized_, &phonetic_recognized_);
+    PhoneticCode(target_, &phonetic_target_);
+  }
+  return LevenshteinSimilarity(phonetic_recognized_, phonetic_target_,
+                               CostMatrix::Plain());
+}
+
+double SimilarityEngine::SequenceSimilarity() const {
+  const SequenceMatcher& matcher = SequenceMatcher::CommonSequences();
+  const uint32_t all = (1u << matcher.pattern_count()) - 1;
+  const uint32_t same = ~(matcher.PresenceMask(recognized_) ^
+                          matcher.PresenceMask(target_)) & all;
+  return static_cast<double>(__builtin_popcount(same)) /
+         matcher.pattern_count();
+}
+
+double SimilarityEngine::Similarity(std::string_view recognized,
+                                    std::string_view target,
+                                    const CostMatrix& costs,
+                                    std::string_view target_phones) {
+  Prepare(recognized, target);
+  return PhoneticSimilarity(target_phones) * kPhoneticWeight +
+         LevenshteinSimilarity(recognized_, target_, costs) *
+             kLevenshteinWeight +
+         SequenceSimilarity() * kSequenceWeight;
+}
+
+const std::vector<AlignmentStep>& SimilarityEngine::Align(
+    std::string_view recognized,
+    std::string_view target,
+    const CostMatrix& costs) {
+  Prepare(recognized, target);
+  aligner_.Align(target_, recognized_, costs, &path_);
+  return path_;
+}
+
+void SimilarityEngine::Diagnose(std::string_view recognized,
+                                std::string_view target,
+                                Diagnostics* out,
+                                const CostMatrix& costs) {
+  out->Clear();
+  Prepare(recognized, target);
+
+  out->distance = aligner_.Align(target_, recognized_, costs, &path_);
+  double levenshtein = 1.0;
+  if (recognized_ != target_) {
+    levenshtein = recognized_.empty() || target_.empty()
+        ? 0.0
+        : NormalizedSimilarity(out->distance, recognized_.size(),
+                               target_.size());
+  }
+  out->similarity = PhoneticSimilarity() * kPhoneticWeight +
+                    levenshtein * kLevenshteinWeight +
+                    SequenceSimilarity() * kSequenceWeight;
+
+  // Flag per posizione sui due testi, con un elemento in più per le
+  // inserzioni in coda
+  target_flags_.assign(target_.size() + 1, 0);
+  recognized_flags_.assign(recognized_.size() + 1, 0);
+  recognized_to_target_.assign(recognized_.size(), -1);
+
+  for (const AlignmentStep& step : path_) {
+    const int32_t t = step.target_pos;
+    const int32_t r = step.recognized_pos;
+    switch (step.op) {
+      case EditOp::kMatch:
+        recognized_to_target_[r] = t;
+        break;
+      case EditOp::kTransposition:
+        out->inversions++;
+        out->edits.push_back({EditKind::kInversion, t, r, 2, target_[t],
+                              recognized_[r]});
+        target_flags_[t] |= kEdited;
+        target_flags_[t + 1] |= kEdited;
+        recognized_flags_[r] |= kEdited;
+        recognized_flags_[r + 1] |= kEdited;
+        recognized_to_target_[r] = t + 1;
+        recognized_to_target_[r + 1] = t;
+        break;
+      case EditOp::kSubstitution: {
+        const bool confusion = IsCommonConfusion(recognized_[r], target_[t]);
+        if (confusion) {
+          out->confusions++;
+        } else {
+          out->substitutions++;
+        }
+        out->edits.push_back({confusion ? EditKind::kConfusion
+                                        : EditKind::kSubstitution,
+                              t, r, 1, target_[t], recognized_[r]});
+        target_flags_[t] |= kEdited;
+        recognized_flags_[r] |= kEdited;
+        recognized_to_target_[r] = t;
+        break;
+      }
+      case EditOp::kDeletion:
+        out->omissions++;
+        out->edits.push_back({EditKind::kOmission, t, r, 1, target_[t], 0});
+        target_flags_[t] |= kEdited;
+        recognized_flags_[r] |= kInsertedBefore;
+        break;
+      case EditOp::kInsertion:
+        out->insertions++;
+        out->edits.push_back({EditKind::kInsertion, t, r, 1, 0,
+                              recognized_[r]});
+        target_flags_[t] |= kInsertedBefore;
+        recognized_flags_[r] |= kEdited;
+        recognized_to_target_[r] = t;
+        break;
+    }
+  }
+
+  // Sequenze difficili del testo atteso lette in modo errato
+  const SequenceMatcher& matcher = SequenceMatcher::CommonSequences();
+  matcher.ForEachMatch(target_, [&](int, int start, int length) {
+    if (!SpanHasError(target_flags_, start, length)) return;
+    out->sequence_errors++;
+    out->edits.push_back({EditKind::kSequence, start, -1, length, 0, 0});
+    for (int k = start; k < start + length; k++) {
+      target_flags_[k] |= kInSequenceError;
+    }
+  });
+
+  // Sequenze difficili comparse nel testo letto senza corrispondenza
+  // nell'atteso, escluse quelle già attribuite a una sequenza del target
+  matcher.ForEachMatch(recognized_, [&](int, int start, int length) {
+    if (!SpanHasError(recognized_flags_, start, length)) return;
+    for (int k = start; k < start + length; k++) {
+      const int32_t t = recognized_to_target_[k];
+      if (t >= 0 && (target_flags_[t] & kInSequenceError)) return;
+    }
+    const int32_t anchor = recognized_to_target_[start];
+    out->sequence_errors++;
+    out->edits.push_back({EditKind::kSequence, anchor, start, length, 0, 0});
+  });
+
+  std::stable_sort(out->edits.begin(), out->edits.end(),
+                   [](const DiagnosticEdit& a, const DiagnosticEdit& b) {
+                     return a.target_pos < b.target_pos;
+                   });
+}
+
+}  // namespace opendsa
@@ -0,0 +1,127 @@
+// linux/native/similarity.h
+
+#ifndef OPENDSA_NATIVE_SIMILARITY_H_
+#define OPENDSA_NATIVE_SIMILARITY_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alignment.h"
+#include "cost_matrix.h"
+#include "phonemizer.h"
+
+namespace opendsa {
+
+// Pesi delle metriche, come in TextSimilarity.calculateSimilarity.
+constexpr double kPhoneticWeight = 0.4;
+constexpr double kLevenshteinWeight = 0.4;
+constexpr double kSequenceWeight = 0.2;
+
+// Versione dei parametri del punteggio: va incrementata quando cambiano i
+// pesi, la tabella delle confusioni o il calcolo di una metrica, così che
+// l'app ricalcoli lo storico dei tentativi (HistoryRescorer).
+constexpr int32_t kSimilarityParametersVersion = 2;
+
+// Classificazione di un errore di lettura. I valori coincidono con le
+// costanti OPENDSA_EDIT_* esposte dall'API C.
+enum class EditKind : int32_t {
+  kInversion = 1,     // Lettere adiacenti invertite (es. "al" per "la")
+  kConfusion = 2,     // Sostituzione fra lettere confuse spesso (b/d, m/n...)
+  kSequence = 3,      // Errore dentro una sequenza difficile (chi, gn, sc...)
+  kOmission = 4,      // Lettera del testo atteso non letta
+  kInsertion = 5,     // Lettera letta in più
+  kSubstitution = 6,  // Altra sostituzione
+};
+
+struct DiagnosticEdit {
+  EditKind kind;
+  int32_t target_pos;      // Indice nel testo atteso normalizzato
+  int32_t recognized_pos;  // Indice nel testo letto normalizzato
+  int32_t length;          // Lunghezza della sequenza per kSequence, 1 altrimenti
+  char32_t expected;       // Carattere atteso (0 se non applicabile)
+  char32_t actual;         // Carattere letto (0 se non applicabile)
+};
+
+// Risultato della diagnosi: contatori per tipo ed elenco ordinato degli
+// errori con le loro posizioni.
+struct Diagnostics {
+  int32_t inversions = 0;
+  int32_t confusions = 0;
+  int32_t sequence_errors = 0;
+  int32_t omissions = 0;
+  int32_t insertions = 0;
+  int32_t substitutions = 0;
+  int32_t distance = 0;  // In unità kCostUnit
+  double similarity = 0.0;
+  std::vector<DiagnosticEdit> edits;
+
+  void Clear();
+};
+
+// Motore di similarità nativo, con le metriche e i pesi di TextSimilarity
+// ma senza allocazioni per chiamata una volta riscaldati i buffer interni.
+// La metrica fonetica confronta le pronunce del Phonemizer (tenute in una
+// cache delle parole recenti) invece del codice fonetico di TextSimilarity,
+// che resta per i testi senza lettere.
+// Non è thread-safe: usare un'istanza per thread.
+class SimilarityEngine {
+ public:
+  // Similarità combinata (fonetica, Levenshtein pesata, sequenze) in [0, 1].
+  // |costs| sostituisce la tabella delle confusioni predefinita.
+  // |target_phones|, se non vuota, è la pronuncia già nota del testo atteso
+  // (fonemi UTF-8 del lessico) e non viene ricalcolata.
+  double Similarity(std::string_view recognized,
+                    std::string_view target,
+                    const CostMatrix& costs = CostMatrix::Default(),
+                    std::string_view target_phones = {});
+
+  // Calcola similarità e diagnosi degli errori in un solo passaggio,
+  // riutilizzando il percorso di allineamento della distanza.
+  void Diagnose(std::string_view recognized,
+                std::string_view target,
+                Diagnostics* out,
+                const CostMatrix& costs = CostMatrix::Default());
+
+  // Normalizza e allinea i due testi. Il percorso e i testi normalizzati
+  // restano validi fino alla chiamata successiva sul motore.
+  const std::vector<AlignmentStep>& Align(
+      std::string_view recognized,
+      std::string_view target,
+      const CostMatrix& costs = CostMatrix::Default());
+
+  const std::u32string& normalized_recognized() const { return recognized_; }
+  const std::u32string& normalized_target() const { return target_; }
+
+  // Similarità di Levenshtein normalizzata su testi già normalizzati.
+  double LevenshteinSimilarity(const std::u32string& recognized,
+                               const std::u32string& target,
+                               const CostMatrix& costs);
+
+  Aligner* aligner() { return &aligner_; }
+
+ private:
+  void Prepare(std::string_view recognized, std::string_view target);
+  double PhoneticSimilarity(std::string_view target_phones = {});
+  double SequenceSimilarity() const;
+  static double NormalizedSimilarity(int32_t distance,
+                                     size_t recognized_length,
+                                     size_t target_length);
+
+  Aligner aligner_;
+  std::vector<AlignmentStep> path_;
+  std::u32string decoded_;
+  std::u32string recognized_;
+  std::u32string target_;
+  std::u32string phonetic_recognized_;
+  std::u32string phonetic_target_;
+  Phonemizer phonemizer_;  // Cache delle pronunce delle parole recenti
+  std::vector<uint8_t> target_flags_;
+  std::vector<uint8_t> recognized_flags_;
+  std::vector<int32_t> recognized_to_target_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_SIMILARITY_H_
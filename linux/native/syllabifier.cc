@@ -0,0 +1,237 @@
+// linux/native/syllabifier.cc
+
+#include "syllabifier.h"
+
+#include <algorithm>
+
+namespace opendsa {
+
+namespace {
+
+enum Role : uint8_t {
+  kConsonant = 0,
+  kVowel = 1,
+  kSilentI = 2,  // i diacritica: ciao, giallo, figlio, sciame
+};
+
+bool IsAccentedVowel(char32_t cp) {
+  switch (cp) {
+    case 0xE0: case 0xE8: case 0xE9: case 0xEC: case 0xED:
+    case 0xEE: case 0xF2: case 0xF3: case 0xF9: case 0xFA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsVowel(char32_t cp) {
+  return cp == 'a' || cp == 'e' || cp == 'i' || cp == 'o' || cp == 'u' ||
+         IsAccentedVowel(cp);
+}
+
+// Vocali che possono fare da semivocale; quelle accentate sono sempre toniche
+bool IsWeak(char32_t cp) { return cp == 'i' || cp == 'u'; }
+
+bool IsMutaCumLiquida(char32_t first, char32_t second) {
+  switch (first) {
+    case 'b': case 'c': case 'd': case 'f': case 'g': case 'p': case 't':
+    case 'v':
+      return second == 'l' || second == 'r';
+    default:
+      return false;
+  }
+}
+
+bool IsDigraph(char32_t first, char32_t second) {
+  return ((first == 'c' || first == 'g') && second == 'h') ||
+         (first == 'g' && (second == 'n' || second == 'l')) ||
+         (first == 's' && second == 'c');
+}
+
+// Attacco formato da un solo digramma che indica un unico suono: ch, gh, gn,
+// e gl o sc davanti a i/e (figlio, scena). Altrimenti è un gruppo consonantico.
+bool IsDigraphOnset(const std::u32string& word, int32_t begin,
+                    int32_t consonants) {
+  if (consonants != 2) return false;
+  const char32_t first = word[begin];
+  const char32_t second = word[begin + 1];
+  const char32_t next = begin + 2 < static_cast<int32_t>(word.size())
+      ? word[begin + 2]
+      : 0;
+  if (second == 'h') return first == 'c' || first == 'g';
+  if (first == 'g' && second == 'n') return true;
+  if (first == 'g' && second == 'l') return next == 'i';
+  if (first == 's' && second == 'c') return next == 'i' || next == 'e';
+  return false;
+}
+
+// Verifica se le consonanti word[begin, end) possono aprire una sillaba.
+// Una i diacritica finale appartiene all'attacco (fi-glio, ca-scia).
+bool IsValidOnset(const std::u32string& word,
+                  const std::vector<uint8_t>& roles,
+                  int32_t begin,
+                  int32_t end) {
+  if (end > begin && roles[end - 1] == kSilentI) end--;
+  const int32_t count = end - begin;
+  if (count <= 1) return true;
+
+  const char32_t first = word[begin];
+  const char32_t second = word[begin + 1];
+  // s impura: s seguita da un attacco valido (pa-sta, ca-scia, ma-schera)
+  if (first == 's' && second != 's') {
+    return IsValidOnset(word, roles, begin + 1, end);
+  }
+  if (count == 2) {
+    return IsDigraph(first, second) || IsMutaCumLiquida(first, second);
+  }
+  // chr, ghl e simili, quasi solo in prestiti
+  return count == 3 && (first == 'c' || first == 'g') && second == 'h' &&
+         (word[begin + 2] == 'l' || word[begin + 2] == 'r');
+}
+
+}  // namespace
+
+WordFeatures Syllabifier::Analyze(const std::u32string& word,
+                                  std::vector<int32_t>* syllable_starts) {
+  WordFeatures features;
+  const int32_t length = static_cast<int32_t>(word.size());
+  if (syllable_starts != nullptr) syllable_starts->clear();
+  nucleus_begin_.clear();
+  nucleus_end_.clear();
+
+  // Ruoli delle lettere e caratteristiche locali
+  roles_.assign(word.size(), kConsonant);
+  int32_t depth = 0;
+  for (int32_t p = 0; p < length; p++) {
+    const char32_t cp = word[p];
+    if (IsVowel(cp)) roles_[p] = kVowel;
+    if (IsAccentedVowel(cp)) features.flags |= kWordAccented;
+
+    const char32_t previous = p > 0 ? word[p - 1] : 0;
+    const char32_t next = p + 1 < length ? word[p + 1] : 0;
+    if (cp == 'h') {
+      depth++;  // Sempre muta
+      if (previous == 'c' || previous == 'g') {
+        features.flags |= kWordDigraph | kWordComplexSyllables;
+      }
+    } else if (cp == 'z') {
+      depth++;  // Sorda o sonora
+      if (previous == 'z') features.flags |= kWordComplexSyllables;
+    } else if (previous == 'g' && (cp == 'n' || cp == 'l')) {
+      features.flags |= kWordComplexSyllables;
+      if (cp == 'n' || next == 'i') {
+        features.flags |= kWordDigraph;
+        depth++;
+      }
+    } else if (previous == 's' && cp == 'c' && (next == 'i' || next == 'e')) {
+      features.flags |= kWordDigraph | kWordComplexSyllables;
+      depth++;
+    }
+    if (p > 0 && !IsVowel(cp) && !IsVowel(previous) &&
+        (cp == previous || (previous == 'c' && cp == 'q'))) {
+      features.flags |= kWordGeminate;
+    }
+  }
+
+  // i diacritica fra c, g, gl, sc e un'altra vocale
+  for (int32_t p = 1; p + 1 < length; p++) {
+    if (word[p] != 'i' || roles_[p + 1] != kVowel) continue;
+    const char32_t previous = word[p - 1];
+    if (previous == 'c' || previous == 'g' ||
+        (previous == 'l' && p >= 2 && word[p - 2] == 'g')) {
+      roles_[p] = kSilentI;
+      features.flags |= kWordDigraph;
+      depth++;
+    }
+  }
+
+  // Nuclei: ogni sequenza di vocali viene divisa in dittonghi, trittonghi e
+  // iati. Le semivocali i/u precedono la vocale del nucleo (al massimo due,
+  // come in a-iuo-la) o la seguono solo in fondo alla sequenza (mai, miei).
+  for (int32_t p = 0; p < length;) {
+    if (roles_[p] != kVowel) {
+      p++;
+      continue;
+    }
+    int32_t run_end = p;
+    while (run_end < length && roles_[run_end] == kVowel) run_end++;
+
+    int32_t i = p;
+    while (i < run_end) {
+      const int32_t begin = i;
+      int32_t glides = 0;
+      while (i + 1 < run_end && glides < 2 && IsWeak(word[i]) &&
+             word[i + 1] != word[i]) {
+        i++;
+        glides++;
+      }
+      i++;
+      if (i + 1 == run_end && IsWeak(word[i]) && word[i] != word[i - 1]) i++;
+
+      const int32_t vowels = i - begin;
+      if (vowels == 2) features.flags |= kWordDiphthong;
+      if (vowels >= 3) features.flags |= kWordTriphthong;
+      if (!nucleus_end_.empty() && nucleus_end_.back() == begin) {
+        features.flags |= kWordHiatus;
+      }
+      nucleus_begin_.push_back(begin);
+      nucleus_end_.push_back(i);
+    }
+    p = run_end;
+  }
+
+  // Divisione dei gruppi consonantici: la sillaba successiva prende l'attacco
+  // valido più lungo, ma le doppie (e cq) vanno sempre divise
+  const int32_t syllables = static_cast<int32_t>(nucleus_begin_.size());
+  for (int32_t k = 0; k < syllables; k++) {
+    const int32_t cluster_begin = k == 0 ? 0 : nucleus_end_[k - 1];
+    const int32_t cluster_end = nucleus_begin_[k];
+    int32_t onset = cluster_begin;
+    if (k > 0) {
+      int32_t limit = cluster_begin;
+      for (int32_t j = cluster_begin; j + 1 < cluster_end; j++) {
+        if (word[j] == word[j + 1] || (word[j] == 'c' && word[j + 1] == 'q')) {
+          limit = j + 1;
+        }
+      }
+      onset = cluster_end;
+      for (int32_t s = limit; s <= cluster_end; s++) {
+        if (IsValidOnset(word, roles_, s, cluster_end)) {
+          onset = s;
+          break;
+        }
+      }
+    }
+    if (syllable_starts != nullptr) syllable_starts->push_back(k == 0 ? 0 : onset);
+
+    // Attacchi di più consonanti, esclusi i digrammi semplici, e gruppi di
+    // tre o più consonanti fra due vocali
+    int32_t consonants = 0;
+    int32_t cluster_consonants = 0;
+    for (int32_t j = cluster_begin; j < cluster_end; j++) {
+      if (roles_[j] != kConsonant) continue;
+      cluster_consonants++;
+      if (j >= onset) consonants++;
+    }
+    if ((consonants >= 2 && !IsDigraphOnset(word, onset, consonants)) ||
+        (k > 0 && cluster_consonants >= 3)) {
+      features.flags |= kWordConsonantCluster;
+    }
+    if (consonants >= 3 && word[onset] == 's') {
+      features.flags |= kWordComplexSyllables;
+    }
+  }
+
+  // Accento: quello grafico se presente, altrimenti parola piana
+  features.syllables = syllables;
+  features.stress = syllables >= 2 ? 2 : syllables;
+  for (int32_t k = 0; k < syllables; k++) {
+    for (int32_t j = nucleus_begin_[k]; j < nucleus_end_[k]; j++) {
+      if (IsAccentedVowel(word[j])) features.stress = syllables - k;
+    }
+  }
+  features.orthographic_depth = static_cast<uint8_t>(std::min(depth, 255));
+  return features;
+}
+
+}  // namespace opendsa
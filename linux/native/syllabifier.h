@@ -0,0 +1,60 @@
+// linux/native/syllabifier.h
+
+#ifndef OPENDSA_NATIVE_SYLLABIFIER_H_
+#define OPENDSA_NATIVE_SYLLABIFIER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opendsa {
+
+// Caratteristiche ortografiche di una parola (WordFeatures::flags). I valori
+// coincidono con le costanti OPENDSA_WORD_* esposte dall'API C.
+constexpr uint16_t kWordComplexSyllables = 1 << 0;  // str, spr, gn, gl, sci...
+constexpr uint16_t kWordAccented = 1 << 1;          // Vocali accentate
+constexpr uint16_t kWordDigraph = 1 << 2;           // ch, gh, gn, gl, sc, ci/gi + vocale
+constexpr uint16_t kWordConsonantCluster = 1 << 3;  // Attacco di più consonanti
+constexpr uint16_t kWordGeminate = 1 << 4;          // Doppie (tt, zz, cq...)
+constexpr uint16_t kWordHiatus = 1 << 5;            // Vocali vicine in sillabe diverse
+constexpr uint16_t kWordDiphthong = 1 << 6;
+constexpr uint16_t kWordTriphthong = 1 << 7;
+
+struct WordFeatures {
+  int32_t syllables = 0;
+  // Sillaba tonica contata dalla fine (1 tronca, 2 piana, 3 sdrucciola).
+  // Senza accento grafico è una stima: le parole piane sono la maggioranza.
+  int32_t stress = 0;
+  uint16_t flags = 0;
+  // Lettere che non corrispondono uno a uno a un fonema: lettere mute (h, i
+  // diacritica), lettere in più dei digrammi e z, che ha due pronunce.
+  // L'italiano è una lingua trasparente: quasi tutte le parole stanno fra 0 e 3.
+  uint8_t orthographic_depth = 0;
+};
+
+// Sillabazione dell'italiano a regole: una parola minuscola (code point) viene
+// divisa in sillabe riconoscendo dittonghi, trittonghi e iati, la i
+// diacritica di ci/gi/gli/sci, e assegnando i gruppi consonantici secondo le
+// regole ortografiche (doppie divise, s impura e muta cum liquida con la
+// sillaba seguente, digrammi inseparabili). Tutte le caratteristiche sono
+// calcolate nello stesso passaggio.
+//
+// Non è thread-safe: usare un'istanza per thread.
+class Syllabifier {
+ public:
+  // Analizza |word|. Se |syllable_starts| non è null riceve l'indice di
+  // inizio di ogni sillaba.
+  WordFeatures Analyze(const std::u32string& word,
+                       std::vector<int32_t>* syllable_starts = nullptr);
+
+ private:
+  // Ruolo di ogni lettera: consonante, vocale o i diacritica
+  std::vector<uint8_t> roles_;
+  // Inizio e fine (esclusa) di ogni nucleo vocalico
+  std::vector<int32_t> nucleus_begin_;
+  std::vector<int32_t> nucleus_end_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_SYLLABIFIER_H_
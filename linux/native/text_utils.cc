@@ -0,0 +1,111 @@
+// linux/native/text_utils.cc
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+size_t Utf8SequenceLength(unsigned char lead) {
+  if (lead < 0x80) return 1;
+  if ((lead & 0xE0) == 0xC0) return 2;
+  if ((lead & 0xF0) == 0xE0) return 3;
+  if ((lead & 0xF8) == 0xF0) return 4;
+  return 1;
+}
+
+void DecodeUtf8(std::string_view text, std::u32string* out) {
+  out->clear();
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  const size_t length = text.size();
+  size_t i = 0;
+  while (i < length) {
+    const unsigned char lead = bytes[i];
+    if (lead < 0x80) {
+      out->push_back(lead);
+      i++;
+      continue;
+    }
+
+    const size_t sequence = Utf8SequenceLength(lead);
+    if (sequence == 1 || i + sequence > length) {
+      out->push_back(kReplacementChar);
+      i++;
+      continue;
+    }
+
+    char32_t cp = lead & (0xFF >> (sequence + 1));
+    bool valid = true;
+    for (size_t k = 1; k < sequence; k++) {
+      const unsigned char next = bytes[i + k];
+      if ((next & 0xC0) != 0x80) {
+        valid = false;
+        break;
+      }
+      cp = (cp << 6) | (next & 0x3F);
+    }
+
+    if (valid) {
+      out->push_back(cp);
+      i += sequence;
+    } else {
+      out->push_back(kReplacementChar);
+      i++;
+    }
+  }
+}
+
+void AppendUtf8(char32_t cp, std::string* out) {
+  if (cp < 0x80) {
+    out->push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (cp >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+char32_t ToLower(char32_t cp) {
+  if (cp >= 'A' && cp <= 'Z') return cp + 0x20;
+  // À-Þ escluso il segno di moltiplicazione
+  if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 0x20;
+  return cp;
+}
+
+bool IsWordChar(char32_t cp) {
+  if ((cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z')) return true;
+  if (cp >= '0' && cp <= '9') return true;
+  if (cp == '_') return true;
+  return cp >= 0xC0 && cp <= 0xFF && cp != 0xD7 && cp != 0xF7;
+}
+
+bool IsSpace(char32_t cp) {
+  return cp == ' ' || cp == '\t' || cp == '\n' || cp == '\r' || cp == '\f' ||
+         cp == '\v' || cp == 0xA0;
+}
+
+void NormalizeText(const std::u32string& text, std::u32string* out) {
+  out->clear();
+  out->reserve(text.size());
+  bool pending_space = false;
+  for (char32_t cp : text) {
+    if (IsSpace(cp)) {
+      pending_space = !out->empty();
+      continue;
+    }
+    if (!IsWordChar(cp)) continue;
+    if (pending_space) {
+      out->push_back(' ');
+      pending_space = false;
+    }
+    out->push_back(ToLower(cp));
+  }
+}
+
+}  // namespace opendsa
@@ -0,0 +1,42 @@
+// linux/native/text_utils.h
+
+#ifndef OPENDSA_NATIVE_TEXT_UTILS_H_
+#define OPENDSA_NATIVE_TEXT_UTILS_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace opendsa {
+
+// Carattere sostitutivo usato per le sequenze UTF-8 non valide.
+constexpr char32_t kReplacementChar = 0xFFFD;
+
+// Decodifica un testo UTF-8 in code point, sostituendo le sequenze non
+// valide con U+FFFD. Il contenuto precedente di |out| viene scartato.
+void DecodeUtf8(std::string_view text, std::u32string* out);
+
+// Accoda a |out| la codifica UTF-8 del code point |cp|.
+void AppendUtf8(char32_t cp, std::string* out);
+
+// Lunghezza in byte della sequenza UTF-8 che inizia con |lead|
+// (1 per i byte non validi, così da avanzare comunque).
+size_t Utf8SequenceLength(unsigned char lead);
+
+// Minuscolo per ASCII e Latin-1, gli unici alfabeti presenti negli esercizi.
+char32_t ToLower(char32_t cp);
+
+// Equivalente di \w ristretto alle lettere italiane: ASCII, cifre,
+// underscore e lettere accentate Latin-1.
+bool IsWordChar(char32_t cp);
+
+bool IsSpace(char32_t cp);
+
+// Porta nativa di TextSimilarity._normalizeText: minuscolo, rimozione della
+// punteggiatura e compattazione degli spazi. Le lettere accentate vengono
+// mantenute perché in italiano distinguono parole diverse.
+void NormalizeText(const std::u32string& text, std::u32string* out);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_TEXT_UTILS_H_
@@ -0,0 +1,285 @@
+// linux/native/tokenizer.cc
+
+#include "tokenizer.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr char32_t kEllipsis = 0x2026;
+
+// Abbreviazioni che non chiudono la frase, in minuscolo, senza punto e in
+// ordine alfabetico per la ricerca binaria.
+constexpr std::string_view kAbbreviations[] = {
+    "arch", "art",  "avv",  "ca",   "cap",   "cav",  "cfr",  "col",
+    "comm", "dott", "dr",   "ecc",  "egr",   "es",   "etc",  "fig",
+    "gen",  "gent", "geom", "ill",  "ing",   "mons", "nr",   "pag",
+    "pagg", "pp",   "prof", "rag",  "sig",   "sigg", "spett", "sr",
+    "ss",   "tab",  "tel",  "vol",
+};
+
+// Stato della frase dopo un segno che potrebbe chiuderla.
+enum class Pending {
+  kNone,
+  kWeak,    // Punto o puntini: la frase continua se segue una minuscola
+  kStrong,  // ! e ?: la frase è chiusa comunque
+};
+
+bool IsDigit(char32_t cp) {
+  return cp >= '0' && cp <= '9';
+}
+
+bool IsLetter(char32_t cp) {
+  return IsWordChar(cp) && !IsDigit(cp) && cp != '_';
+}
+
+bool IsUpper(char32_t cp) {
+  if (cp >= 'A' && cp <= 'Z') return true;
+  return cp >= 0xC0 && cp <= 0xDE && cp != 0xD7;
+}
+
+bool IsApostrophe(char32_t cp) {
+  return cp == '\'' || cp == 0x2019 || cp == 0x02BC;
+}
+
+// Segni che, preceduti da uno spazio, aprono la frase successiva.
+bool IsOpening(char32_t cp) {
+  return cp == '"' || cp == '\'' || cp == '(' || cp == '[' || cp == '-' ||
+         cp == 0xAB || cp == 0x2013 || cp == 0x2014 || cp == 0x2018 ||
+         cp == 0x201C;
+}
+
+bool IsAbbreviation(std::string_view word) {
+  return std::binary_search(std::begin(kAbbreviations),
+                            std::end(kAbbreviations), word);
+}
+
+uint32_t Utf16Units(char32_t cp) {
+  return cp >= 0x10000 ? 2 : 1;
+}
+
+// Decodifica il code point che inizia in |pos| e restituisce la sua
+// lunghezza in byte. Le sequenze non valide valgono U+FFFD e un byte, come
+// in DecodeUtf8.
+size_t DecodeAt(std::string_view text, size_t pos, char32_t* cp) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  const unsigned char lead = bytes[pos];
+  if (lead < 0x80) {
+    *cp = lead;
+    return 1;
+  }
+  const size_t sequence = Utf8SequenceLength(lead);
+  if (sequence == 1 || pos + sequence > text.size()) {
+    *cp = kReplacementChar;
+    return 1;
+  }
+  char32_t value = lead & (0xFF >> (sequence + 1));
+  for (size_t k = 1; k < sequence; k++) {
+    const unsigned char next = bytes[pos + k];
+    if ((next & 0xC0) != 0x80) {
+      *cp = kReplacementChar;
+      return 1;
+    }
+    value = (value << 6) | (next & 0x3F);
+  }
+  *cp = value;
+  return sequence;
+}
+
+}  // namespace
+
+void TokenizedText::Clear() {
+  begins.clear();
+  ends.clear();
+  utf16_begins.clear();
+  utf16_ends.clear();
+  kinds.clear();
+  flags.clear();
+  normalized_offsets.clear();
+  normalized_lengths.clear();
+  normalized.clear();
+  sentence_starts.clear();
+  paragraph_starts.clear();
+}
+
+void Tokenizer::Tokenize(std::string_view text, TokenizedText* out) const {
+  out->Clear();
+  if (text.size() > std::numeric_limits<uint32_t>::max()) return;
+
+  size_t pos = 0;
+  uint32_t utf16 = 0;
+  int newlines = 0;
+  bool space_before = false;
+  Pending pending = Pending::kNone;
+  int64_t terminator = -1;  // Token che ha reso la frase in sospeso
+  int64_t opening = -1;     // Virgolette o parentesi prima della nuova frase
+
+  // Consuma il code point |cp| lungo |length| byte
+  auto advance = [&](char32_t cp, size_t length) {
+    pos += length;
+    utf16 += Utf16Units(cp);
+  };
+
+  while (pos < text.size()) {
+    char32_t cp;
+    size_t length = DecodeAt(text, pos, &cp);
+    if (IsSpace(cp)) {
+      if (cp == '\n') newlines++;
+      space_before = true;
+      advance(cp, length);
+      continue;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(out->size());
+    const uint32_t begin = static_cast<uint32_t>(pos);
+    const uint32_t utf16_begin = utf16;
+    const uint32_t normalized_begin =
+        static_cast<uint32_t>(out->normalized.size());
+    const char32_t first = cp;
+    uint8_t flags = space_before ? kTokenSpaceBefore : 0;
+    if (IsUpper(cp)) flags |= kTokenCapitalized;
+    TokenKind kind;
+    size_t dots = 0;
+
+    if (IsLetter(cp)) {
+      kind = TokenKind::kWord;
+      while (pos < text.size()) {
+        length = DecodeAt(text, pos, &cp);
+        if (IsLetter(cp)) {
+          AppendUtf8(ToLower(cp), &out->normalized);
+          advance(cp, length);
+          continue;
+        }
+        // L'apostrofo fa parte della parola solo fra due lettere
+        char32_t next = 0;
+        if (IsApostrophe(cp) && pos + length < text.size()) {
+          DecodeAt(text, pos + length, &next);
+        }
+        if (!IsLetter(next)) break;
+        flags |= kTokenElision;
+        advance(cp, length);
+      }
+    } else if (IsDigit(cp)) {
+      kind = TokenKind::kNumber;
+      while (pos < text.size()) {
+        length = DecodeAt(text, pos, &cp);
+        if (IsDigit(cp)) {
+          out->normalized.push_back(static_cast<char>(cp));
+          advance(cp, length);
+          continue;
+        }
+        // Separatori decimali e delle migliaia: 3,5 e 1.000
+        if ((cp == '.' || cp == ',') && pos + 1 < text.size() &&
+            IsDigit(static_cast<unsigned char>(text[pos + 1]))) {
+          advance(cp, length);
+          continue;
+        }
+        break;
+      }
+    } else {
+      kind = TokenKind::kPunctuation;
+      advance(cp, length);
+      if (cp == '.') {
+        dots = 1;
+        while (pos < text.size() && text[pos] == '.') {
+          advance('.', 1);
+          dots++;
+        }
+      }
+    }
+
+    // Confini di paragrafo e di frase
+    bool paragraph_start = index == 0 || newlines >= 2;
+    int64_t sentence_start = -1;
+    if (paragraph_start) {
+      sentence_start = index;
+    } else if (pending != Pending::kNone) {
+      if (kind == TokenKind::kPunctuation) {
+        if (space_before && opening < 0 && IsOpening(first)) opening = index;
+      } else {
+        if (pending == Pending::kStrong || kind == TokenKind::kNumber ||
+            (flags & kTokenCapitalized) != 0) {
+          sentence_start = opening >= 0 ? opening : index;
+        } else {
+          terminator = -1;
+        }
+        pending = Pending::kNone;
+        opening = -1;
+      }
+    }
+
+    if (sentence_start >= 0) {
+      if (terminator >= 0) out->flags[terminator] |= kTokenSentenceEnd;
+      if (paragraph_start) {
+        flags |= kTokenParagraphStart;
+        if (index > 0 && newlines >= 3) flags |= kTokenPageStart;
+        out->paragraph_starts.push_back(index);
+      }
+      if (sentence_start == index) {
+        flags |= kTokenSentenceStart;
+      } else {
+        out->flags[sentence_start] |= kTokenSentenceStart;
+      }
+      out->sentence_starts.push_back(static_cast<uint32_t>(sentence_start));
+      pending = Pending::kNone;
+      terminator = -1;
+      opening = -1;
+    }
+
+    out->begins.push_back(begin);
+    out->ends.push_back(static_cast<uint32_t>(pos));
+    out->utf16_begins.push_back(utf16_begin);
+    out->utf16_ends.push_back(utf16);
+    out->kinds.push_back(static_cast<uint8_t>(kind));
+    out->flags.push_back(flags);
+    out->normalized_offsets.push_back(normalized_begin);
+    out->normalized_lengths.push_back(
+        static_cast<uint32_t>(out->normalized.size()) - normalized_begin);
+
+    // Segni che possono chiudere la frase
+    if (kind == TokenKind::kPunctuation) {
+      Pending closes = Pending::kNone;
+      if (first == '!' || first == '?') {
+        closes = Pending::kStrong;
+      } else if (first == kEllipsis || dots >= 2) {
+        closes = Pending::kWeak;
+      } else if (dots == 1) {
+        closes = Pending::kWeak;
+        // Abbreviazione o iniziale attaccata al punto
+        const uint32_t previous = index - 1;
+        if (index > 0 && out->ends[previous] == begin &&
+            out->kinds[previous] == static_cast<uint8_t>(TokenKind::kWord)) {
+          const std::string_view word = out->normalized_form(previous);
+          const bool initial =
+              (out->flags[previous] & kTokenCapitalized) != 0 &&
+              out->utf16_ends[previous] - out->utf16_begins[previous] == 1;
+          // ecc. ed etc. chiudono la frase se segue una maiuscola
+          if (initial || (IsAbbreviation(word) && word != "ecc" &&
+                          word != "etc")) {
+            closes = Pending::kNone;
+          }
+        }
+      }
+      if (closes != Pending::kNone) {
+        pending = std::max(pending, closes);
+        terminator = index;
+      }
+    }
+
+    newlines = 0;
+    space_before = false;
+  }
+
+  if (terminator >= 0) out->flags[terminator] |= kTokenSentenceEnd;
+  if (!out->begins.empty()) {
+    out->sentence_starts.push_back(static_cast<uint32_t>(out->size()));
+    out->paragraph_starts.push_back(static_cast<uint32_t>(out->size()));
+  }
+}
+
+}  // namespace opendsa
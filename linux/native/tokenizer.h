@@ -0,0 +1,90 @@
+// linux/native/tokenizer.h
+
+#ifndef OPENDSA_NATIVE_TOKENIZER_H_
+#define OPENDSA_NATIVE_TOKENIZER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace opendsa {
+
+// Tipo di un token. I valori coincidono con le costanti OPENDSA_TOKEN_*.
+enum class TokenKind : uint8_t {
+  kWord = 1,
+  kNumber = 2,
+  kPunctuation = 3,
+};
+
+// Caratteristiche di un token (TokenizedText::flags). I valori coincidono
+// con le costanti OPENDSA_TOKEN_* esposte dall'API C.
+constexpr uint8_t kTokenSentenceStart = 1 << 0;
+constexpr uint8_t kTokenParagraphStart = 1 << 1;
+constexpr uint8_t kTokenPageStart = 1 << 2;      // Dopo almeno due righe vuote
+constexpr uint8_t kTokenSpaceBefore = 1 << 3;    // Preceduto da spazi o a capo
+constexpr uint8_t kTokenCapitalized = 1 << 4;    // Inizia con una maiuscola
+constexpr uint8_t kTokenElision = 1 << 5;        // Contiene un'elisione (l'albero)
+constexpr uint8_t kTokenSentenceEnd = 1 << 6;    // Punteggiatura che chiude la frase
+
+// Testo suddiviso in token, memorizzato per colonne: ogni array ha un
+// elemento per token, così Dart può leggerli come liste tipizzate senza
+// copie. Le posizioni sono date sia in byte UTF-8 (per il codice nativo) sia
+// in unità UTF-16 (gli indici delle String Dart); la fine è esclusa.
+//
+// |sentence_starts| e |paragraph_starts| contengono l'indice del primo token
+// di ogni frase e paragrafo, seguito da una sentinella uguale al numero di
+// token: la frase i va da sentence_starts[i] a sentence_starts[i + 1].
+struct TokenizedText {
+  std::vector<uint32_t> begins;
+  std::vector<uint32_t> ends;
+  std::vector<uint32_t> utf16_begins;
+  std::vector<uint32_t> utf16_ends;
+  std::vector<uint8_t> kinds;
+  std::vector<uint8_t> flags;
+  // Forma normalizzata (minuscolo, senza apostrofi, come NormalizeText) in
+  // |normalized|; vuota per la punteggiatura.
+  std::vector<uint32_t> normalized_offsets;
+  std::vector<uint32_t> normalized_lengths;
+  std::string normalized;
+  std::vector<uint32_t> sentence_starts;
+  std::vector<uint32_t> paragraph_starts;
+
+  size_t size() const { return begins.size(); }
+  size_t sentence_count() const {
+    return sentence_starts.empty() ? 0 : sentence_starts.size() - 1;
+  }
+  size_t paragraph_count() const {
+    return paragraph_starts.empty() ? 0 : paragraph_starts.size() - 1;
+  }
+  std::string_view normalized_form(size_t token) const {
+    return std::string_view(normalized).substr(normalized_offsets[token],
+                                               normalized_lengths[token]);
+  }
+
+  // Svuota gli array mantenendo la memoria già allocata.
+  void Clear();
+};
+
+// Suddivide un testo UTF-8 in parole, numeri e segni di punteggiatura,
+// riconoscendo in un solo passaggio i confini di frase e di paragrafo.
+//
+// - Le parole comprendono le elisioni (l'albero, dell'acqua) e i numeri i
+//   separatori decimali e delle migliaia (3,5 e 1.000).
+// - Una frase termina con ! ? … e con il punto, tranne dopo le abbreviazioni
+//   comuni (sig., dott., ecc.) e le iniziali; dopo un punto o dei puntini di
+//   sospensione la frase successiva deve iniziare con una maiuscola o un
+//   numero. Virgolette e parentesi aperte prima della nuova frase ne fanno
+//   parte.
+// - Una riga vuota separa i paragrafi, due righe vuote le pagine (come in
+//   lib/assets/exercises/pages.txt).
+class Tokenizer {
+ public:
+  // Suddivide |text| in |out|, riutilizzandone la memoria. I testi oltre i
+  // 4 GiB non sono supportati.
+  void Tokenize(std::string_view text, TokenizedText* out) const;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_TOKENIZER_H_
@@ -0,0 +1,442 @@
+// linux/native/tools/batch_recognize.cc
+//
+// Trascrizione e valutazione in blocco di un corpus di registrazioni, senza
+// interfaccia grafica. Ogni WAV del manifesto viene riconosciuto con
+// libvosk (FileRecognizer), confrontato con il testo atteso e scritto come
+// una riga JSON con testo, parole, WER, similarità e fattore di tempo reale.
+//
+// Il manifesto ha una registrazione per riga, "<wav>\t<testo atteso>"; i
+// percorsi relativi partono dalla directory del manifesto, le righe vuote e
+// quelle che iniziano con # vengono ignorate. Il modello viene caricato una
+// volta e condiviso da un riconoscitore per thread.
+//
+// Uso: opendsa_batch [--model <dir>] [--vosk <libvosk.so>] [--threads <n>]
+//                    [--chunk-ms <ms>] [--output <file.jsonl>] [--verbose]
+//                    <manifesto>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "file_recognizer.h"
+#include "file_utils.h"
+#include "similarity.h"
+#include "tokenizer.h"
+#include "vosk_api.h"
+
+// Percorsi predefiniti nella directory di build (linux/CMakeLists.txt)
+#ifndef OPENDSA_DEFAULT_VOSK_MODEL
+#define OPENDSA_DEFAULT_VOSK_MODEL "vosk_model/vosk-model-small-it-0.22"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string model_dir = OPENDSA_DEFAULT_VOSK_MODEL;
+  std::string vosk_library;
+  std::string output_path;
+  std::string manifest_path;
+  int threads = 0;  // Uno per core
+  opendsa::FileRecognitionOptions recognition;
+  bool verbose = false;
+};
+
+struct Entry {
+  std::string wav;
+  std::string target;
+};
+
+struct Outcome {
+  bool recognized = false;
+  std::string line;  // Riga JSON, senza a capo
+  int32_t reference_words = 0;
+  int32_t errors = 0;  // Sostituzioni, omissioni e inserzioni
+  double similarity = 0.0;
+  double audio_seconds = 0.0;
+  double elapsed_seconds = 0.0;
+};
+
+// Errori a livello di parola fra |reference| e |hypothesis| (distanza di
+// Levenshtein con costi unitari), divisi per tipo.
+struct WordErrors {
+  int32_t substitutions = 0;
+  int32_t deletions = 0;
+  int32_t insertions = 0;
+
+  int32_t total() const { return substitutions + deletions + insertions; }
+};
+
+std::string Trim(const std::string& text) {
+  const size_t begin = text.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return std::string();
+  const size_t end = text.find_last_not_of(" \t\r\n");
+  return text.substr(begin, end - begin + 1);
+}
+
+bool LoadManifest(const std::string& path, std::vector<Entry>* entries) {
+  std::string data;
+  if (!opendsa::ReadFile(path, &data)) {
+    std::fprintf(stderr, "Impossibile leggere %s\n", path.c_str());
+    return false;
+  }
+  const size_t slash = path.rfind('/');
+  const std::string base =
+      slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+  size_t start = 0;
+  int line_number = 0;
+  while (start < data.size()) {
+    size_t end = data.find('\n', start);
+    if (end == std::string::npos) end = data.size();
+    const std::string line = data.substr(start, end - start);
+    start = end + 1;
+    line_number++;
+    if (Trim(line).empty() || Trim(line)[0] == '#') continue;
+    const size_t tab = line.find('\t');
+    if (tab == std::string::npos) {
+      std::fprintf(stderr, "%s:%d: manca il testo atteso dopo il tab\n",
+                   path.c_str(), line_number);
+      return false;
+    }
+    Entry entry;
+    entry.wav = Trim(line.substr(0, tab));
+    entry.target = Trim(line.substr(tab + 1));
+    if (!entry.wav.empty() && entry.wav[0] != '/') entry.wav = base + entry.wav;
+    entries->push_back(std::move(entry));
+  }
+  return true;
+}
+
+// Forme normalizzate delle parole e dei numeri di |text|
+std::vector<std::string> Words(const opendsa::Tokenizer& tokenizer,
+                               const std::string& text,
+                               opendsa::TokenizedText* tokens) {
+  tokenizer.Tokenize(text, tokens);
+  std::vector<std::string> words;
+  for (size_t i = 0; i < tokens->size(); i++) {
+    if (tokens->kinds[i] !=
+        static_cast<uint8_t>(opendsa::TokenKind::kPunctuation)) {
+      words.emplace_back(tokens->normalized_form(i));
+    }
+  }
+  return words;
+}
+
+WordErrors CountWordErrors(const std::vector<std::string>& reference,
+                           const std::vector<std::string>& hypothesis) {
+  const size_t rows = reference.size() + 1;
+  const size_t columns = hypothesis.size() + 1;
+  std::vector<int32_t> cost(rows * columns);
+  for (size_t i = 0; i < rows; i++) cost[i * columns] = static_cast<int32_t>(i);
+  for (size_t j = 0; j < columns; j++) cost[j] = static_cast<int32_t>(j);
+  for (size_t i = 1; i < rows; i++) {
+    for (size_t j = 1; j < columns; j++) {
+      const int32_t replace = cost[(i - 1) * columns + j - 1] +
+                              (reference[i - 1] == hypothesis[j - 1] ? 0 : 1);
+      cost[i * columns + j] =
+          std::min({replace, cost[(i - 1) * columns + j] + 1,
+                    cost[i * columns + j - 1] + 1});
+    }
+  }
+
+  // Percorso a ritroso, preferendo le corrispondenze e le sostituzioni
+  WordErrors errors;
+  size_t i = rows - 1;
+  size_t j = columns - 1;
+  while (i > 0 || j > 0) {
+    const int32_t current = cost[i * columns + j];
+    if (i > 0 && j > 0) {
+      const bool same = reference[i - 1] == hypothesis[j - 1];
+      if (cost[(i - 1) * columns + j - 1] + (same ? 0 : 1) == current) {
+        if (!same) errors.substitutions++;
+        i--;
+        j--;
+        continue;
+      }
+    }
+    if (i > 0 && cost[(i - 1) * columns + j] + 1 == current) {
+      errors.deletions++;
+      i--;
+    } else {
+      errors.insertions++;
+      j--;
+    }
+  }
+  return errors;
+}
+
+void AppendJsonString(const std::string& text, std::string* out) {
+  out->push_back('"');
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        *out += "\\\"";
+        break;
+      case '\\':
+        *out += "\\\\";
+        break;
+      case '\n':
+        *out += "\\n";
+        break;
+      case '\r':
+        *out += "\\r";
+        break;
+      case '\t':
+        *out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+          *out += escape;
+        } else {
+          out->push_back(c);
+        }
+    }
+  }
+  out->push_back('"');
+}
+
+void AppendField(const char* name, double value, std::string* out) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), ", \"%s\": %.4f", name, value);
+  *out += buffer;
+}
+
+void AppendField(const char* name, int32_t value, std::string* out) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), ", \"%s\": %d", name, value);
+  *out += buffer;
+}
+
+// Valuta le voci del manifesto prese a una a una da un indice condiviso:
+// le durate delle registrazioni variano molto, i blocchi fissi non
+// bilancerebbero il carico
+void Work(const opendsa::SpeechModel& model, const Options& options,
+          const std::vector<Entry>& entries, std::atomic<size_t>* next,
+          std::vector<Outcome>* outcomes) {
+  opendsa::FileRecognizer recognizer;
+  const bool ready = recognizer.Open(model);
+  opendsa::SimilarityEngine engine;
+  opendsa::Tokenizer tokenizer;
+  opendsa::TokenizedText tokens;
+  opendsa::FileRecognition recognition;
+  for (;;) {
+    const size_t index = next->fetch_add(1, std::memory_order_relaxed);
+    if (index >= entries.size()) break;
+    const Entry& entry = entries[index];
+    Outcome& outcome = (*outcomes)[index];
+    std::string& line = outcome.line;
+    line = "{\"wav\": ";
+    AppendJsonString(entry.wav, &line);
+    line += ", \"target\": ";
+    AppendJsonString(entry.target, &line);
+
+    if (!ready ||
+        !recognizer.RecognizeFile(entry.wav, options.recognition,
+                                  &recognition)) {
+      line += ", \"error\": ";
+      AppendJsonString(ready ? "file mancante, non WAV PCM o errore di libvosk"
+                             : "riconoscitore non disponibile",
+                       &line);
+      line += "}";
+      continue;
+    }
+
+    const std::vector<std::string> reference =
+        Words(tokenizer, entry.target, &tokens);
+    const std::vector<std::string> hypothesis =
+        Words(tokenizer, recognition.text, &tokens);
+    const WordErrors errors = CountWordErrors(reference, hypothesis);
+    const int32_t reference_words = static_cast<int32_t>(reference.size());
+    const double wer =
+        reference_words > 0
+            ? static_cast<double>(errors.total()) / reference_words
+            : (hypothesis.empty() ? 0.0 : 1.0);
+
+    outcome.recognized = true;
+    outcome.reference_words = reference_words;
+    outcome.errors = errors.total();
+    outcome.similarity = engine.Similarity(recognition.text, entry.target);
+    outcome.audio_seconds = recognition.audio_seconds;
+    outcome.elapsed_seconds = recognition.elapsed_seconds;
+
+    line += ", \"text\": ";
+    AppendJsonString(recognition.text, &line);
+    AppendField("wer", wer, &line);
+    AppendField("reference_words", reference_words, &line);
+    AppendField("substitutions", errors.substitutions, &line);
+    AppendField("deletions", errors.deletions, &line);
+    AppendField("insertions", errors.insertions, &line);
+    AppendField("similarity", outcome.similarity, &line);
+    AppendField("sample_rate", static_cast<int32_t>(recognition.sample_rate),
+                &line);
+    AppendField("audio_seconds", recognition.audio_seconds, &line);
+    AppendField("elapsed_seconds", recognition.elapsed_seconds, &line);
+    AppendField("rtf",
+                recognition.audio_seconds > 0.0
+                    ? recognition.elapsed_seconds / recognition.audio_seconds
+                    : 0.0,
+                &line);
+    line += ", \"words\": [";
+    for (size_t i = 0; i < recognition.words.size(); i++) {
+      const opendsa::RecognizedWord& word = recognition.words[i];
+      line += i > 0 ? ", {\"word\": " : "{\"word\": ";
+      AppendJsonString(word.word, &line);
+      AppendField("start", word.start, &line);
+      AppendField("end", word.end, &line);
+      AppendField("conf", word.confidence, &line);
+      line += "}";
+    }
+    line += "]}";
+  }
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--model" && has_value) {
+      options->model_dir = argv[++i];
+    } else if (arg == "--vosk" && has_value) {
+      options->vosk_library = argv[++i];
+    } else if (arg == "--threads" && has_value) {
+      options->threads = std::atoi(argv[++i]);
+    } else if (arg == "--chunk-ms" && has_value) {
+      options->recognition.chunk_ms =
+          static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+    } else if (arg == "--output" && has_value) {
+      options->output_path = argv[++i];
+    } else if (arg == "--verbose") {
+      options->verbose = true;
+    } else if (options->manifest_path.empty() && arg[0] != '-') {
+      options->manifest_path = arg;
+    } else {
+      options->manifest_path.clear();
+      break;
+    }
+  }
+  if (options->manifest_path.empty()) {
+    std::fprintf(stderr,
+                 "Uso: %s [--model <dir>] [--vosk <libvosk.so>] "
+                 "[--threads <n>] [--chunk-ms <ms>] [--output <file.jsonl>] "
+                 "[--verbose] <manifesto>\n",
+                 argv[0]);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) return 2;
+
+  std::vector<Entry> entries;
+  if (!LoadManifest(options.manifest_path, &entries)) return 1;
+
+  // LoadVoskApi cerca prima in $OPENDSA_VOSK_LIBRARY
+#ifdef OPENDSA_DEFAULT_VOSK_LIBRARY
+  if (options.vosk_library.empty() &&
+      std::getenv("OPENDSA_VOSK_LIBRARY") == nullptr) {
+    options.vosk_library = OPENDSA_DEFAULT_VOSK_LIBRARY;
+  }
+#endif
+  if (!options.vosk_library.empty()) {
+    setenv("OPENDSA_VOSK_LIBRARY", options.vosk_library.c_str(), 1);
+  }
+  const opendsa::VoskApi* api = opendsa::LoadVoskApi();
+  if (api == nullptr) {
+    std::fprintf(stderr, "libvosk non trovata (usare --vosk)\n");
+    return 1;
+  }
+  // Senza --verbose i messaggi di Kaldi coprirebbero il riepilogo
+  if (!options.verbose) api->set_log_level(-1);
+
+  const Clock::time_point load_start = Clock::now();
+  opendsa::SpeechModel model;
+  if (!model.Open(options.model_dir)) {
+    std::fprintf(stderr, "Impossibile caricare il modello %s\n",
+                 options.model_dir.c_str());
+    return 1;
+  }
+  const double load_seconds =
+      std::chrono::duration<double>(Clock::now() - load_start).count();
+
+  int threads = options.threads > 0
+                    ? options.threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  threads = std::max(1, std::min(threads, static_cast<int>(entries.size())));
+
+  const Clock::time_point start = Clock::now();
+  std::vector<Outcome> outcomes(entries.size());
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (int i = 0; i < threads; i++) {
+    workers.emplace_back(Work, std::cref(model), std::cref(options),
+                         std::cref(entries), &next, &outcomes);
+  }
+  for (std::thread& worker : workers) worker.join();
+  const double wall_seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  // Le righe seguono l'ordine del manifesto, qualunque thread le abbia
+  // prodotte
+  std::string jsonl;
+  size_t recognized = 0;
+  int64_t reference_words = 0;
+  int64_t errors = 0;
+  double similarity = 0.0;
+  double audio_seconds = 0.0;
+  double elapsed_seconds = 0.0;
+  for (const Outcome& outcome : outcomes) {
+    jsonl += outcome.line;
+    jsonl += '\n';
+    if (!outcome.recognized) continue;
+    recognized++;
+    reference_words += outcome.reference_words;
+    errors += outcome.errors;
+    similarity += outcome.similarity;
+    audio_seconds += outcome.audio_seconds;
+    elapsed_seconds += outcome.elapsed_seconds;
+  }
+  if (options.output_path.empty()) {
+    std::fwrite(jsonl.data(), 1, jsonl.size(), stdout);
+  } else if (!opendsa::WriteFileAtomically(options.output_path, jsonl.data(),
+                                           jsonl.size())) {
+    std::fprintf(stderr, "Impossibile scrivere %s\n",
+                 options.output_path.c_str());
+    return 1;
+  }
+
+  // Riepilogo su stderr, per non mescolarlo alle righe JSON
+  std::fprintf(stderr,
+               "File: %zu riconosciuti su %zu, %d thread, modello caricato in "
+               "%.2f s\n",
+               recognized, entries.size(), threads, load_seconds);
+  std::fprintf(stderr,
+               "WER del corpus: %.4f (%lld errori su %lld parole), "
+               "similarità media: %.4f\n",
+               reference_words > 0
+                   ? static_cast<double>(errors) / reference_words
+                   : 0.0,
+               static_cast<long long>(errors),
+               static_cast<long long>(reference_words),
+               recognized > 0 ? similarity / recognized : 0.0);
+  std::fprintf(stderr,
+               "Audio: %.1f s in %.1f s (RTF per thread %.3f, %.1fx il tempo "
+               "reale complessivo)\n",
+               audio_seconds, wall_seconds,
+               audio_seconds > 0.0 ? elapsed_seconds / audio_seconds : 0.0,
+               wall_seconds > 0.0 ? audio_seconds / wall_seconds : 0.0);
+  return recognized == entries.size() ? 0 : 1;
+}
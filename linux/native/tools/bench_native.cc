@@ -0,0 +1,518 @@
+// linux/native/tools/bench_native.cc
+//
+// Microbenchmark dei kernel nativi (codifica fonetica, similarità,
+// allineamento, diagnosi e ricerca della parola più vicina) sui corpora reali
+// di lib/assets/exercises. Per ogni kernel riporta ns/op, throughput e
+// allocazioni per operazione; con --json scrive gli stessi dati in un file
+// da confrontare fra una release e l'altra.
+//
+// Uso: bench_native [--corpus <dir>] [--json <file>] [--min-time <secondi>]
+//                   [--filter <testo>]
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binary_profile.h"
+#include "block_codec.h"
+#include "file_utils.h"
+#include "nearest_word.h"
+#include "phonemizer.h"
+#include "phonetic.h"
+#include "similarity.h"
+#include "text_utils.h"
+#include "tokenizer.h"
+#include "word_aligner.h"
+
+#ifndef OPENDSA_EXERCISES_DIR
+#define OPENDSA_EXERCISES_DIR "lib/assets/exercises"
+#endif
+
+// --- Conteggio delle allocazioni ---
+// La sostituzione globale di operator new vale per tutto l'eseguibile, incluso
+// il codice della libreria collegato staticamente.
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocated_bytes{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string corpus_dir = OPENDSA_EXERCISES_DIR;
+  std::string json_path;
+  std::string filter;
+  double min_seconds = 0.5;
+};
+
+struct Corpus {
+  std::vector<std::string> easy_words;
+  std::vector<std::string> medium_words;
+  std::vector<std::string> hard_words;
+  std::vector<std::string> sentences;
+  std::vector<std::string> paragraphs;
+  std::vector<std::string> pages;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterations = 0;
+  uint64_t ops = 0;
+  double ns_per_op = 0.0;
+  double ops_per_second = 0.0;
+  double mb_per_second = 0.0;
+  double allocations_per_op = 0.0;
+  double allocated_bytes_per_op = 0.0;
+};
+
+std::string Trim(const std::string& text) {
+  const size_t begin = text.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos) return std::string();
+  const size_t end = text.find_last_not_of(" \t\r\n");
+  return text.substr(begin, end - begin + 1);
+}
+
+// Righe del file ripulite dagli spazi, incluse quelle vuote
+std::vector<std::string> SplitRawLines(const std::string& text) {
+  std::vector<std::string> lines;
+  size_t start = 0;
+  while (start <= text.size()) {
+    size_t end = text.find('\n', start);
+    if (end == std::string::npos) end = text.size();
+    lines.push_back(Trim(text.substr(start, end - start)));
+    start = end + 1;
+  }
+  return lines;
+}
+
+// Una voce per riga non vuota, come ContentService per le liste di parole
+std::vector<std::string> SplitLines(const std::string& text) {
+  std::vector<std::string> lines;
+  for (std::string& line : SplitRawLines(text)) {
+    if (!line.empty()) lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+// Paragrafi o pagine come li costruisce ContentService dai token nativi:
+// un paragrafo inizia dopo una riga vuota, una pagina al paragrafo marcato
+// kTokenPageStart. Ogni voce è il testo originale dal primo all'ultimo token.
+std::vector<std::string> SplitTokenized(const std::string& text, bool pages) {
+  opendsa::Tokenizer tokenizer;
+  opendsa::TokenizedText tokens;
+  tokenizer.Tokenize(text, &tokens);
+  std::vector<std::string> units;
+  size_t first = 0;
+  const auto flush = [&](size_t end) {
+    if (end > first) {
+      units.push_back(text.substr(tokens.begins[first],
+                                  tokens.ends[end - 1] - tokens.begins[first]));
+    }
+    first = end;
+  };
+  for (size_t i = 1; i < tokens.paragraph_count(); i++) {
+    const uint32_t start = tokens.paragraph_starts[i];
+    if (!pages || (tokens.flags[start] & opendsa::kTokenPageStart) != 0) {
+      flush(start);
+    }
+  }
+  flush(tokens.size());
+  return units;
+}
+
+enum class Split { kLines, kParagraphs, kPages };
+
+bool LoadCorpus(const std::string& dir, Corpus* corpus) {
+  const struct {
+    const char* file;
+    std::vector<std::string>* target;
+    Split split;
+  } sources[] = {
+      {"easy_words.txt", &corpus->easy_words, Split::kLines},
+      {"medium_words.txt", &corpus->medium_words, Split::kLines},
+      {"hard_words.txt", &corpus->hard_words, Split::kLines},
+      {"sentences.txt", &corpus->sentences, Split::kLines},
+      {"paragraphs.txt", &corpus->paragraphs, Split::kParagraphs},
+      {"pages.txt", &corpus->pages, Split::kPages},
+  };
+  for (const auto& source : sources) {
+    std::string text;
+    const std::string path = dir + "/" + source.file;
+    if (!opendsa::ReadFile(path, &text)) {
+      std::fprintf(stderr, "Impossibile leggere %s\n", path.c_str());
+      return false;
+    }
+    *source.target = source.split == Split::kLines
+                         ? SplitLines(text)
+                         : SplitTokenized(text, source.split == Split::kPages);
+  }
+  return true;
+}
+
+// Simula una lettura imperfetta e deterministica: inversioni, confusioni
+// b/d e omissioni distribuite lungo il testo
+std::string Misread(const std::string& text, uint32_t seed) {
+  std::string result = text;
+  uint32_t state = seed * 2654435761u + 1;
+  for (size_t i = 0; i + 1 < result.size(); i++) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t roll = (state >> 24) % 23;
+    const unsigned char c = static_cast<unsigned char>(result[i]);
+    const unsigned char next = static_cast<unsigned char>(result[i + 1]);
+    if (c >= 0x80 || next >= 0x80) continue;
+    if (roll == 0) {
+      std::swap(result[i], result[i + 1]);
+      i++;
+    } else if (roll == 1 && (c == 'b' || c == 'd')) {
+      result[i] = c == 'b' ? 'd' : 'b';
+    } else if (roll == 2 && c != ' ') {
+      result.erase(i, 1);
+    }
+  }
+  return result;
+}
+
+std::vector<std::string> MisreadAll(const std::vector<std::string>& texts) {
+  std::vector<std::string> result;
+  result.reserve(texts.size());
+  for (size_t i = 0; i < texts.size(); i++) {
+    result.push_back(Misread(texts[i], static_cast<uint32_t>(i)));
+  }
+  return result;
+}
+
+size_t TotalBytes(const std::vector<std::string>& texts) {
+  size_t total = 0;
+  for (const std::string& text : texts) total += text.size();
+  return total;
+}
+
+// Esegue |fn| (che elabora |ops| elementi e |bytes| byte) finché non passano
+// almeno |min_seconds|, dopo un'iterazione di riscaldamento
+template <typename Fn>
+Result Run(const std::string& name, size_t ops, size_t bytes,
+           double min_seconds, Fn&& fn) {
+  Result result;
+  result.name = name;
+  fn();
+
+  const uint64_t allocations_before = g_allocations.load();
+  const uint64_t bytes_before = g_allocated_bytes.load();
+  const Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  do {
+    fn();
+    result.iterations++;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_seconds);
+
+  result.ops = result.iterations * ops;
+  const double total_ops = static_cast<double>(result.ops);
+  result.ns_per_op = elapsed * 1e9 / total_ops;
+  result.ops_per_second = total_ops / elapsed;
+  result.mb_per_second =
+      static_cast<double>(result.iterations * bytes) / elapsed / 1e6;
+  result.allocations_per_op =
+      static_cast<double>(g_allocations.load() - allocations_before) /
+      total_ops;
+  result.allocated_bytes_per_op =
+      static_cast<double>(g_allocated_bytes.load() - bytes_before) / total_ops;
+  return result;
+}
+
+void PrintResult(const Result& result) {
+  std::printf("%-32s %12.1f %14.0f %10.2f %10.3f %12.1f\n",
+              result.name.c_str(), result.ns_per_op, result.ops_per_second,
+              result.mb_per_second, result.allocations_per_op,
+              result.allocated_bytes_per_op);
+}
+
+bool WriteJson(const std::string& path, const Options& options,
+               const std::vector<Result>& results) {
+  std::string json = "{\n  \"benchmark\": \"bench_native\",\n";
+  char buffer[512];
+  std::snprintf(buffer, sizeof(buffer),
+                "  \"timestamp\": %lld,\n  \"min_time_seconds\": %.3f,\n"
+                "  \"results\": [\n",
+                static_cast<long long>(std::time(nullptr)),
+                options.min_seconds);
+  json += buffer;
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    std::snprintf(buffer, sizeof(buffer),
+                  "    {\"name\": \"%s\", \"iterations\": %llu, "
+                  "\"ops\": %llu, \"ns_per_op\": %.2f, "
+                  "\"ops_per_second\": %.1f, \"mb_per_second\": %.3f, "
+                  "\"allocations_per_op\": %.4f, "
+                  "\"allocated_bytes_per_op\": %.2f}%s\n",
+                  r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                  static_cast<unsigned long long>(r.ops), r.ns_per_op,
+                  r.ops_per_second, r.mb_per_second, r.allocations_per_op,
+                  r.allocated_bytes_per_op,
+                  i + 1 < results.size() ? "," : "");
+    json += buffer;
+  }
+  json += "  ]\n}\n";
+  return opendsa::WriteFileAtomically(path, json.data(), json.size());
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--corpus" && has_value) {
+      options->corpus_dir = argv[++i];
+    } else if (arg == "--json" && has_value) {
+      options->json_path = argv[++i];
+    } else if (arg == "--filter" && has_value) {
+      options->filter = argv[++i];
+    } else if (arg == "--min-time" && has_value) {
+      options->min_seconds = std::atof(argv[++i]);
+    } else {
+      std::fprintf(stderr,
+                   "Uso: %s [--corpus <dir>] [--json <file>] "
+                   "[--min-time <secondi>] [--filter <testo>]\n",
+                   argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) return 2;
+
+  Corpus corpus;
+  if (!LoadCorpus(options.corpus_dir, &corpus)) return 1;
+
+  const std::vector<std::string> misread_words = MisreadAll(corpus.medium_words);
+  const std::vector<std::string> misread_sentences = MisreadAll(corpus.sentences);
+  const std::vector<std::string> misread_paragraphs =
+      MisreadAll(corpus.paragraphs);
+  const std::vector<std::string> misread_pages = MisreadAll(corpus.pages);
+
+  std::vector<std::u32string> normalized_words;
+  for (const std::string& word : corpus.medium_words) {
+    std::u32string decoded;
+    std::u32string normalized;
+    opendsa::DecodeUtf8(word, &decoded);
+    opendsa::NormalizeText(decoded, &normalized);
+    normalized_words.push_back(normalized);
+  }
+
+  std::vector<std::string> lexicon = corpus.easy_words;
+  lexicon.insert(lexicon.end(), corpus.medium_words.begin(),
+                 corpus.medium_words.end());
+  lexicon.insert(lexicon.end(), corpus.hard_words.begin(),
+                 corpus.hard_words.end());
+  opendsa::NearestWordIndex nearest(lexicon);
+
+  std::printf("Corpus: %zu parole medie, %zu frasi, %zu paragrafi, %zu pagine"
+              " (lessico di %zu parole)\n\n",
+              corpus.medium_words.size(), corpus.sentences.size(),
+              corpus.paragraphs.size(), corpus.pages.size(), nearest.size());
+  std::printf("%-32s %12s %14s %10s %10s %12s\n", "kernel", "ns/op", "op/s",
+              "MB/s", "alloc/op", "byte/op");
+
+  opendsa::SimilarityEngine engine;
+  opendsa::Diagnostics diagnostics;
+  std::u32string phonetic;
+  volatile double sink = 0.0;
+  std::vector<Result> results;
+
+  auto bench = [&](const std::string& name, const std::vector<std::string>& texts,
+                   auto&& fn) {
+    if (!options.filter.empty() &&
+        name.find(options.filter) == std::string::npos) {
+      return;
+    }
+    if (texts.empty()) return;
+    results.push_back(
+        Run(name, texts.size(), TotalBytes(texts), options.min_seconds, fn));
+    PrintResult(results.back());
+  };
+
+  bench("phonetic/medium_words", corpus.medium_words, [&] {
+    for (const std::u32string& word : normalized_words) {
+      opendsa::PhoneticCode(word, &phonetic);
+      sink = sink + static_cast<double>(phonetic.size());
+    }
+  });
+
+  opendsa::Phonemizer phonemizer;
+  std::u32string phones;
+  bench("phonemize/medium_words", corpus.medium_words, [&] {
+    for (const std::u32string& word : normalized_words) {
+      phonemizer.Phonemize(word, &phones);
+      sink = sink + static_cast<double>(phones.size());
+    }
+  });
+
+  auto similarity = [&](const std::vector<std::string>& targets,
+                        const std::vector<std::string>& readings) {
+    return [&] {
+      for (size_t i = 0; i < targets.size(); i++) {
+        sink = sink + engine.Similarity(readings[i], targets[i]);
+      }
+    };
+  };
+  bench("similarity/medium_words", corpus.medium_words,
+        similarity(corpus.medium_words, misread_words));
+  bench("similarity/sentences", corpus.sentences,
+        similarity(corpus.sentences, misread_sentences));
+  bench("similarity/paragraphs", corpus.paragraphs,
+        similarity(corpus.paragraphs, misread_paragraphs));
+
+  auto align = [&](const std::vector<std::string>& targets,
+                   const std::vector<std::string>& readings) {
+    return [&] {
+      for (size_t i = 0; i < targets.size(); i++) {
+        sink = sink + static_cast<double>(
+                          engine.Align(readings[i], targets[i]).size());
+      }
+    };
+  };
+  bench("align/medium_words", corpus.medium_words,
+        align(corpus.medium_words, misread_words));
+  bench("align/sentences", corpus.sentences,
+        align(corpus.sentences, misread_sentences));
+  bench("align/paragraphs", corpus.paragraphs,
+        align(corpus.paragraphs, misread_paragraphs));
+  bench("align/pages", corpus.pages, align(corpus.pages, misread_pages));
+
+  bench("diagnose/pages", corpus.pages, [&] {
+    for (size_t i = 0; i < corpus.pages.size(); i++) {
+      engine.Diagnose(misread_pages[i], corpus.pages[i], &diagnostics);
+      sink = sink + diagnostics.similarity;
+    }
+  });
+
+  opendsa::Tokenizer tokenizer;
+  opendsa::TokenizedText tokens;
+  bench("tokenize/pages", corpus.pages, [&] {
+    for (const std::string& page : corpus.pages) {
+      tokenizer.Tokenize(page, &tokens);
+      sink = sink + static_cast<double>(tokens.size());
+    }
+  });
+
+  opendsa::WordAligner word_aligner;
+  std::vector<int32_t> matches;
+  bench("word_align/paragraphs", corpus.paragraphs, [&] {
+    for (size_t i = 0; i < corpus.paragraphs.size(); i++) {
+      tokenizer.Tokenize(corpus.paragraphs[i], &tokens);
+      word_aligner.Align(tokens, 0, tokens.size(), misread_paragraphs[i],
+                         &matches);
+      sink = sink + static_cast<double>(matches.size());
+    }
+  });
+
+  opendsa::BlockCompressor compressor;
+  std::vector<std::string> compressed_pages(corpus.pages.size());
+  for (size_t i = 0; i < corpus.pages.size(); i++) {
+    compressor.Compress(
+        reinterpret_cast<const uint8_t*>(corpus.pages[i].data()),
+        corpus.pages[i].size(), &compressed_pages[i]);
+  }
+  std::string compressed;
+  bench("block_compress/pages", corpus.pages, [&] {
+    for (const std::string& page : corpus.pages) {
+      compressed.clear();
+      compressor.Compress(reinterpret_cast<const uint8_t*>(page.data()),
+                          page.size(), &compressed);
+      sink = sink + static_cast<double>(compressed.size());
+    }
+  });
+
+  std::vector<uint8_t> decompressed;
+  bench("block_decompress/pages", corpus.pages, [&] {
+    for (size_t i = 0; i < corpus.pages.size(); i++) {
+      decompressed.resize(corpus.pages[i].size());
+      const bool ok = opendsa::DecompressBlock(
+          reinterpret_cast<const uint8_t*>(compressed_pages[i].data()),
+          compressed_pages[i].size(), decompressed.data(), decompressed.size());
+      sink = sink + (ok ? 1.0 : 0.0);
+    }
+  });
+
+  bench("nearest_word/medium_words", corpus.medium_words, [&] {
+    for (const std::string& word : misread_words) {
+      sink = sink + nearest.Find(word).distance;
+    }
+  });
+
+  // Profilo con le parole usate come in Player.toJson: costruzione dal JSON
+  // e lettura di un campo dalla mappatura, senza decodificare il resto
+  std::string profile_json = "{\"totalCrystals\":1234,\"usedWords\":[";
+  for (size_t i = 0; i < corpus.medium_words.size(); i++) {
+    if (i > 0) profile_json.push_back(',');
+    profile_json += "\"" + corpus.medium_words[i] + "\"";
+  }
+  profile_json += "]}";
+  std::string profile_data;
+  bench("binary_profile_build/medium_words", corpus.medium_words, [&] {
+    opendsa::BuildBinaryProfile(profile_json, &profile_data);
+    sink = sink + static_cast<double>(profile_data.size());
+  });
+
+  char profile_path[] = "/tmp/bench_native_profile_XXXXXX";
+  const int profile_fd = mkstemp(profile_path);
+  opendsa::BinaryProfile profile;
+  if (profile_fd >= 0 &&
+      opendsa::WriteAll(profile_fd, profile_data.data(), profile_data.size()) &&
+      profile.Open(profile_path)) {
+    bench("binary_profile_read/medium_words", corpus.medium_words, [&] {
+      const uint32_t words = profile.Find(profile.root(), "usedWords");
+      const uint32_t count = profile.node(words)->count;
+      for (uint32_t i = 0; i < count; i++) {
+        sink = sink + static_cast<double>(
+                          profile.String(profile.Element(words, i)).size());
+      }
+      sink = sink + static_cast<double>(
+                        profile.Int(profile.Find(profile.root(), "totalCrystals")));
+    });
+  }
+  if (profile_fd >= 0) {
+    close(profile_fd);
+    unlink(profile_path);
+  }
+
+  if (!options.json_path.empty()) {
+    if (!WriteJson(options.json_path, options, results)) {
+      std::fprintf(stderr, "Impossibile scrivere %s\n",
+                   options.json_path.c_str());
+      return 1;
+    }
+    std::printf("\nRisultati JSON scritti in %s\n", options.json_path.c_str());
+  }
+  return 0;
+}
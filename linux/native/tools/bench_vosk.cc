@@ -0,0 +1,520 @@
+// linux/native/tools/bench_vosk.cc
+//
+// Benchmark del riconoscimento con libvosk e il modello dell'applicazione.
+// Per ogni combinazione di audio (sintetico alle frequenze richieste e WAV
+// registrati), dimensione dei blocchi e numero di thread, decodifica
+// l'audio con un riconoscitore per thread sullo stesso modello, come
+// FileRecognizer, e riporta il fattore di tempo reale, i percentili della
+// latenza di ogni blocco (conversione di frequenza e accept_waveform) e la
+// memoria residente prima e dopo il caso. Riporta anche il tempo di
+// caricamento e la memoria del modello e, alla fine, il picco di memoria
+// del processo; con --json scrive gli stessi dati, con la versione di
+// libvosk, in un file da confrontare prima e dopo un aggiornamento.
+//
+// Uso: bench_vosk [--model <dir>] [--vosk <libvosk.so>] [--wav <file>]...
+//                 [--seconds <s>] [--rates <hz,...>] [--chunk-ms <ms,...>]
+//                 [--threads <n,...>] [--json <file>] [--verbose]
+
+#include <dlfcn.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "file_recognizer.h"
+#include "file_utils.h"
+#include "mapped_file.h"
+#include "resampler.h"
+#include "vosk_api.h"
+#include "wav_file.h"
+
+// Percorsi e versione predefiniti della directory di build
+// (linux/CMakeLists.txt)
+#ifndef OPENDSA_DEFAULT_VOSK_MODEL
+#define OPENDSA_DEFAULT_VOSK_MODEL "vosk_model/vosk-model-small-it-0.22"
+#endif
+#ifndef OPENDSA_VOSK_VERSION
+#define OPENDSA_VOSK_VERSION "sconosciuta"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kWarmupSeconds = 1.0;
+
+struct Options {
+  std::string model_dir = OPENDSA_DEFAULT_VOSK_MODEL;
+  std::string vosk_library;
+  std::string json_path;
+  std::vector<std::string> wav_paths;
+  double synthetic_seconds = 30.0;
+  std::vector<int> rates = {16000, 32000, 44100, 48000};
+  std::vector<int> chunk_ms = {20, 50, 100, 200, 400};
+  std::vector<int> threads;  // Predefinito: 1 e uno per core
+  bool verbose = false;
+};
+
+// Audio mono da decodificare, alla frequenza di origine
+struct Audio {
+  std::string name;
+  uint32_t sample_rate = 0;
+  std::vector<int16_t> samples;
+
+  double seconds() const {
+    return static_cast<double>(samples.size()) / sample_rate;
+  }
+};
+
+struct Result {
+  std::string audio;
+  uint32_t sample_rate = 0;
+  int chunk_ms = 0;
+  int threads = 0;
+  uint64_t chunks = 0;  // Blocchi per thread
+  double audio_seconds = 0.0;  // Per thread
+  double wall_seconds = 0.0;
+  double rtf = 0.0;  // Media dei thread
+  double realtime_multiple = 0.0;  // Audio di tutti i thread / tempo reale
+  double latency_p50_ms = 0.0;
+  double latency_p90_ms = 0.0;
+  double latency_p99_ms = 0.0;
+  double latency_max_ms = 0.0;
+  long rss_before_kb = 0;  // Prima di creare i riconoscitori
+  long rss_after_kb = 0;   // A decodifica finita, riconoscitori ancora aperti
+};
+
+// Memoria residente attuale (VmRSS), 0 se non disponibile
+long CurrentRssKb() {
+  FILE* file = std::fopen("/proc/self/status", "r");
+  if (file == nullptr) return 0;
+  long rss_kb = 0;
+  char line[256];
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    if (std::sscanf(line, "VmRSS: %ld kB", &rss_kb) == 1) break;
+  }
+  std::fclose(file);
+  return rss_kb;
+}
+
+// Picco di memoria residente del processo dall'avvio: non scende fra un
+// caso e l'altro, quindi viene riportato una sola volta
+long PeakRssKb() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  return usage.ru_maxrss;
+}
+
+// Segnale simile al parlato: sillabe di armoniche su una fondamentale che
+// varia lentamente, separate da brevi silenzi e da una pausa ogni due
+// secondi, così che libvosk chiuda le frasi come con una lettura vera. Il
+// rumore di fondo (generatore congruenziale a seme fisso) rende il segnale
+// uguale a ogni esecuzione.
+Audio SynthesizeSpeech(uint32_t sample_rate, double seconds) {
+  Audio audio;
+  audio.name = "sintetico";
+  audio.sample_rate = sample_rate;
+  const size_t count = static_cast<size_t>(seconds * sample_rate);
+  audio.samples.resize(count);
+  uint32_t noise = 12345;
+  double phase = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    const double t = static_cast<double>(i) / sample_rate;
+    const double fundamental = 150.0 + 40.0 * std::sin(2.0 * kPi * 0.7 * t);
+    phase += 2.0 * kPi * fundamental / sample_rate;
+    const double syllable = std::fmod(t, 0.25) / 0.25;
+    const bool pause = std::fmod(t, 2.0) >= 1.6;
+    const double envelope =
+        pause ? 0.0 : std::max(0.0, std::sin(kPi * syllable) - 0.2);
+    double voice = 0.0;
+    for (int harmonic = 1; harmonic <= 8; harmonic++) {
+      voice += std::sin(harmonic * phase) / harmonic;
+    }
+    noise = noise * 1664525u + 1013904223u;
+    const double hiss = (static_cast<double>(noise >> 8) / (1 << 24)) - 0.5;
+    const double sample = 6000.0 * envelope * voice + 100.0 * hiss;
+    audio.samples[i] = static_cast<int16_t>(
+        std::max(-32768.0, std::min(32767.0, std::round(sample))));
+  }
+  return audio;
+}
+
+bool LoadRecording(const std::string& path, Audio* audio) {
+  opendsa::MappedFile file;
+  opendsa::WavInfo info;
+  if (!file.Open(path) || !opendsa::ParseWav(file.data(), file.size(), &info) ||
+      info.frames == 0) {
+    return false;
+  }
+  std::vector<int16_t> pcm;
+  opendsa::ReadPcm16(file.data(), info, &pcm);
+  const size_t slash = path.rfind('/');
+  audio->name = slash == std::string::npos ? path : path.substr(slash + 1);
+  audio->sample_rate = info.sample_rate;
+  audio->samples.resize(pcm.size() / info.channels);
+  for (size_t i = 0; i < audio->samples.size(); i++) {
+    int32_t sum = 0;
+    for (uint16_t c = 0; c < info.channels; c++) {
+      sum += pcm[i * info.channels + c];
+    }
+    audio->samples[i] = static_cast<int16_t>(sum / info.channels);
+  }
+  return true;
+}
+
+// Decodifica |audio| a blocchi di |chunk| campioni con |recognizer|, come
+// FileRecognizer::Recognize, e aggiunge a |latencies| la durata di ogni
+// blocco in millisecondi. Restituisce il tempo complessivo in secondi, o un
+// valore negativo se libvosk segnala un errore.
+double Decode(const opendsa::VoskApi& api, opendsa::VoskRecognizer* recognizer,
+              uint32_t model_rate, const Audio& audio, size_t chunk,
+              std::vector<double>* latencies) {
+  api.recognizer_reset(recognizer);
+  opendsa::Resampler resampler(audio.sample_rate, model_rate);
+  std::vector<int16_t> resampled;
+  const Clock::time_point started = Clock::now();
+  for (size_t first = 0; first < audio.samples.size(); first += chunk) {
+    const Clock::time_point chunk_start = Clock::now();
+    const size_t count = std::min(chunk, audio.samples.size() - first);
+    resampled.clear();
+    resampler.Process(audio.samples.data() + first, count, &resampled);
+    if (!resampled.empty()) {
+      const int status = api.recognizer_accept_waveform_s(
+          recognizer, resampled.data(), static_cast<int>(resampled.size()));
+      if (status < 0) return -1.0;
+      // Come FileRecognizer, il risultato di una frase chiusa viene letto
+      // subito
+      if (status == 1) api.recognizer_result(recognizer);
+    }
+    latencies->push_back(
+        std::chrono::duration<double, std::milli>(Clock::now() - chunk_start)
+            .count());
+  }
+  resampled.clear();
+  resampler.Flush(&resampled);
+  if (!resampled.empty() &&
+      api.recognizer_accept_waveform_s(recognizer, resampled.data(),
+                                       static_cast<int>(resampled.size())) <
+          0) {
+    return -1.0;
+  }
+  api.recognizer_final_result(recognizer);
+  return std::chrono::duration<double>(Clock::now() - started).count();
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+  if (sorted.empty()) return 0.0;
+  const size_t rank = static_cast<size_t>(
+      std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Decodifica |audio| con |threads| riconoscitori in parallelo, tutti sullo
+// stesso modello. I riconoscitori vengono creati prima della misura.
+bool Run(const opendsa::SpeechModel& model, const Audio& audio, int chunk_ms,
+         int threads, Result* result) {
+  const opendsa::VoskApi& api = *model.api();
+  const long rss_before_kb = CurrentRssKb();
+  std::vector<opendsa::VoskRecognizer*> recognizers;
+  for (int i = 0; i < threads; i++) {
+    opendsa::VoskRecognizer* recognizer = api.recognizer_new(
+        model.handle(), static_cast<float>(model.sample_rate()));
+    if (recognizer == nullptr) break;
+    recognizers.push_back(recognizer);
+  }
+  const size_t chunk = std::max<size_t>(
+      1, static_cast<uint64_t>(audio.sample_rate) * chunk_ms / 1000);
+  std::vector<std::vector<double>> latencies(recognizers.size());
+  std::vector<double> elapsed(recognizers.size(), -1.0);
+  const Clock::time_point start = Clock::now();
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < recognizers.size(); i++) {
+    workers.emplace_back([&, i] {
+      elapsed[i] = Decode(api, recognizers[i], model.sample_rate(), audio,
+                          chunk, &latencies[i]);
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  const double wall_seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  const long rss_after_kb = CurrentRssKb();
+  for (opendsa::VoskRecognizer* recognizer : recognizers) {
+    api.recognizer_free(recognizer);
+  }
+  if (recognizers.size() != static_cast<size_t>(threads) ||
+      *std::min_element(elapsed.begin(), elapsed.end()) < 0.0) {
+    return false;
+  }
+
+  std::vector<double> all;
+  double total_elapsed = 0.0;
+  for (int i = 0; i < threads; i++) {
+    all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    total_elapsed += elapsed[i];
+  }
+  std::sort(all.begin(), all.end());
+  result->audio = audio.name;
+  result->sample_rate = audio.sample_rate;
+  result->chunk_ms = chunk_ms;
+  result->threads = threads;
+  result->chunks = latencies[0].size();
+  result->audio_seconds = audio.seconds();
+  result->wall_seconds = wall_seconds;
+  result->rtf = total_elapsed / threads / audio.seconds();
+  result->realtime_multiple = audio.seconds() * threads / wall_seconds;
+  result->latency_p50_ms = Percentile(all, 0.50);
+  result->latency_p90_ms = Percentile(all, 0.90);
+  result->latency_p99_ms = Percentile(all, 0.99);
+  result->latency_max_ms = all.empty() ? 0.0 : all.back();
+  result->rss_before_kb = rss_before_kb;
+  result->rss_after_kb = rss_after_kb;
+  return true;
+}
+
+void PrintHeader() {
+  std::printf("%-20s %6s %6s %4s %8s %9s %8s %8s %8s %8s %9s %8s\n", "audio",
+              "hz", "ms", "thr", "rtf", "x reale", "p50 ms", "p90 ms",
+              "p99 ms", "max ms", "rss MB", "+rss MB");
+}
+
+void PrintResult(const Result& r) {
+  std::printf(
+      "%-20s %6u %6d %4d %8.4f %9.1f %8.3f %8.3f %8.3f %8.3f %9.1f %+8.1f\n",
+      r.audio.c_str(), r.sample_rate, r.chunk_ms, r.threads, r.rtf,
+      r.realtime_multiple, r.latency_p50_ms, r.latency_p90_ms,
+      r.latency_p99_ms, r.latency_max_ms, r.rss_after_kb / 1024.0,
+      (r.rss_after_kb - r.rss_before_kb) / 1024.0);
+}
+
+std::string JsonString(const std::string& text) {
+  std::string out = "\"";
+  for (const char c : text) {
+    if (c == '"' || c == '\\') out.push_back('\\');
+    if (static_cast<unsigned char>(c) >= 0x20) out.push_back(c);
+  }
+  out.push_back('"');
+  return out;
+}
+
+bool WriteJson(const std::string& path, const Options& options,
+               const std::string& library, double load_seconds,
+               long load_rss_kb, long model_rss_kb, long peak_rss_kb,
+               const std::vector<Result>& results) {
+  std::string json = "{\n  \"benchmark\": \"bench_vosk\",\n";
+  json += "  \"vosk_version\": " + JsonString(OPENDSA_VOSK_VERSION) + ",\n";
+  json += "  \"vosk_library\": " + JsonString(library) + ",\n";
+  json += "  \"model\": " + JsonString(options.model_dir) + ",\n";
+  char buffer[512];
+  std::snprintf(buffer, sizeof(buffer),
+                "  \"timestamp\": %lld,\n  \"hardware_threads\": %u,\n"
+                "  \"model_load_seconds\": %.3f,\n"
+                "  \"rss_after_load_kb\": %ld,\n  \"model_rss_kb\": %ld,\n"
+                "  \"peak_rss_kb\": %ld,\n  \"results\": [\n",
+                static_cast<long long>(std::time(nullptr)),
+                std::thread::hardware_concurrency(), load_seconds,
+                load_rss_kb, model_rss_kb, peak_rss_kb);
+  json += buffer;
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    json += "    {\"audio\": " + JsonString(r.audio);
+    std::snprintf(buffer, sizeof(buffer),
+                  ", \"sample_rate\": %u, \"chunk_ms\": %d, \"threads\": %d, "
+                  "\"chunks\": %llu, \"audio_seconds\": %.3f, "
+                  "\"wall_seconds\": %.4f, \"rtf\": %.5f, "
+                  "\"realtime_multiple\": %.2f, \"latency_p50_ms\": %.4f, "
+                  "\"latency_p90_ms\": %.4f, \"latency_p99_ms\": %.4f, "
+                  "\"latency_max_ms\": %.4f, \"rss_before_kb\": %ld, "
+                  "\"rss_after_kb\": %ld, \"rss_delta_kb\": %ld}%s\n",
+                  r.sample_rate, r.chunk_ms, r.threads,
+                  static_cast<unsigned long long>(r.chunks), r.audio_seconds,
+                  r.wall_seconds, r.rtf, r.realtime_multiple,
+                  r.latency_p50_ms, r.latency_p90_ms, r.latency_p99_ms,
+                  r.latency_max_ms, r.rss_before_kb, r.rss_after_kb,
+                  r.rss_after_kb - r.rss_before_kb,
+                  i + 1 < results.size() ? "," : "");
+    json += buffer;
+  }
+  json += "  ]\n}\n";
+  return opendsa::WriteFileAtomically(path, json.data(), json.size());
+}
+
+// Interi positivi separati da virgole
+bool ParseList(const char* text, std::vector<int>* values) {
+  values->clear();
+  const char* cursor = text;
+  while (*cursor != '\0') {
+    char* end = nullptr;
+    const long value = std::strtol(cursor, &end, 10);
+    if (end == cursor || value <= 0 || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+    values->push_back(static_cast<int>(value));
+    cursor = *end == ',' ? end + 1 : end;
+  }
+  return !values->empty();
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  bool valid = true;
+  for (int i = 1; i < argc && valid; i++) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--model" && has_value) {
+      options->model_dir = argv[++i];
+    } else if (arg == "--vosk" && has_value) {
+      options->vosk_library = argv[++i];
+    } else if (arg == "--wav" && has_value) {
+      options->wav_paths.push_back(argv[++i]);
+    } else if (arg == "--seconds" && has_value) {
+      options->synthetic_seconds = std::atof(argv[++i]);
+    } else if (arg == "--rates" && has_value) {
+      valid = ParseList(argv[++i], &options->rates);
+    } else if (arg == "--chunk-ms" && has_value) {
+      valid = ParseList(argv[++i], &options->chunk_ms);
+    } else if (arg == "--threads" && has_value) {
+      valid = ParseList(argv[++i], &options->threads);
+    } else if (arg == "--json" && has_value) {
+      options->json_path = argv[++i];
+    } else if (arg == "--verbose") {
+      options->verbose = true;
+    } else {
+      valid = false;
+    }
+  }
+  if (!valid) {
+    std::fprintf(stderr,
+                 "Uso: %s [--model <dir>] [--vosk <libvosk.so>] "
+                 "[--wav <file>]... [--seconds <s>] [--rates <hz,...>] "
+                 "[--chunk-ms <ms,...>] [--threads <n,...>] [--json <file>] "
+                 "[--verbose]\n",
+                 argv[0]);
+  }
+  return valid;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) return 2;
+  if (options.threads.empty()) {
+    options.threads.push_back(1);
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    if (cores > 1) options.threads.push_back(cores);
+  }
+
+  if (options.wav_paths.empty() &&
+      (options.synthetic_seconds <= 0.0 || options.rates.empty())) {
+    std::fprintf(stderr, "Nessun audio da decodificare\n");
+    return 2;
+  }
+
+  // LoadVoskApi cerca prima in $OPENDSA_VOSK_LIBRARY
+#ifdef OPENDSA_DEFAULT_VOSK_LIBRARY
+  if (options.vosk_library.empty() &&
+      std::getenv("OPENDSA_VOSK_LIBRARY") == nullptr) {
+    options.vosk_library = OPENDSA_DEFAULT_VOSK_LIBRARY;
+  }
+#endif
+  if (!options.vosk_library.empty()) {
+    setenv("OPENDSA_VOSK_LIBRARY", options.vosk_library.c_str(), 1);
+  }
+  const opendsa::VoskApi* api = opendsa::LoadVoskApi();
+  if (api == nullptr) {
+    std::fprintf(stderr, "libvosk non trovata (usare --vosk)\n");
+    return 1;
+  }
+  if (!options.verbose) api->set_log_level(-1);
+  // Percorso della libvosk effettivamente caricata
+  std::string library = "?";
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void*>(api->model_new), &info) != 0 &&
+      info.dli_fname != nullptr) {
+    library = info.dli_fname;
+  }
+
+  // Il modello viene caricato prima di leggere o generare l'audio, così
+  // la memoria dopo il caricamento è solo quella di libvosk e del modello
+  const long rss_before_load_kb = CurrentRssKb();
+  const Clock::time_point load_start = Clock::now();
+  opendsa::SpeechModel model;
+  if (!model.Open(options.model_dir)) {
+    std::fprintf(stderr, "Impossibile caricare il modello %s\n",
+                 options.model_dir.c_str());
+    return 1;
+  }
+  const double load_seconds =
+      std::chrono::duration<double>(Clock::now() - load_start).count();
+  const long load_rss_kb = CurrentRssKb();
+  const long model_rss_kb = load_rss_kb - rss_before_load_kb;
+  std::printf("libvosk %s (%s)\n", OPENDSA_VOSK_VERSION, library.c_str());
+  std::printf(
+      "Modello %s (%u Hz) caricato in %.3f s, RSS %.1f MB (+%.1f MB)\n\n",
+      options.model_dir.c_str(), model.sample_rate(), load_seconds,
+      load_rss_kb / 1024.0, model_rss_kb / 1024.0);
+
+  std::vector<Audio> sources;
+  for (const std::string& path : options.wav_paths) {
+    Audio audio;
+    if (!LoadRecording(path, &audio)) {
+      std::fprintf(stderr, "Impossibile leggere il WAV %s\n", path.c_str());
+      return 1;
+    }
+    sources.push_back(std::move(audio));
+  }
+  if (options.synthetic_seconds > 0.0) {
+    for (const int rate : options.rates) {
+      sources.push_back(SynthesizeSpeech(static_cast<uint32_t>(rate),
+                                         options.synthetic_seconds));
+    }
+  }
+
+  // Un secondo di audio per portare a regime cache e allocatori prima
+  // delle misure
+  {
+    Result ignored;
+    Run(model, SynthesizeSpeech(model.sample_rate(), kWarmupSeconds), 200, 1,
+        &ignored);
+  }
+
+  PrintHeader();
+  std::vector<Result> results;
+  for (const Audio& audio : sources) {
+    for (const int chunk_ms : options.chunk_ms) {
+      for (const int threads : options.threads) {
+        Result result;
+        if (!Run(model, audio, chunk_ms, threads, &result)) {
+          std::fprintf(stderr, "Decodifica non riuscita: %s, %d ms, %d thread\n",
+                       audio.name.c_str(), chunk_ms, threads);
+          return 1;
+        }
+        PrintResult(result);
+        results.push_back(std::move(result));
+      }
+    }
+  }
+
+  const long peak_rss_kb = PeakRssKb();
+  std::printf("\nPicco di memoria del processo: %.1f MB\n",
+              peak_rss_kb / 1024.0);
+
+  if (!options.json_path.empty()) {
+    if (!WriteJson(options.json_path, options, library, load_seconds,
+                   load_rss_kb, model_rss_kb, peak_rss_kb, results)) {
+      std::fprintf(stderr, "Impossibile scrivere %s\n",
+                   options.json_path.c_str());
+      return 1;
+    }
+    std::printf("\nRisultati JSON scritti in %s\n", options.json_path.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+// linux/native/tools/build_content_pack.cc
+//
+// Compila i testi di lettura degli esercizi in un pacchetto di contenuti
+// compresso a blocchi (vedi content_pack.h). Eseguito da linux/CMakeLists.txt
+// a ogni modifica dei testi.
+//
+// Uso: build_content_pack <output> <lines|paragraphs|pages> <testo> [...]
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "content_pack.h"
+#include "file_utils.h"
+
+namespace {
+
+bool ParseSplit(const char* name, opendsa::ContentSplit* split) {
+  if (std::strcmp(name, "lines") == 0) {
+    *split = opendsa::ContentSplit::kLines;
+  } else if (std::strcmp(name, "paragraphs") == 0) {
+    *split = opendsa::ContentSplit::kParagraphs;
+  } else if (std::strcmp(name, "pages") == 0) {
+    *split = opendsa::ContentSplit::kPages;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  opendsa::ContentSplit split;
+  if (argc < 4 || !ParseSplit(argv[2], &split)) {
+    std::fprintf(stderr,
+                 "Uso: %s <output> <lines|paragraphs|pages> <testo> [...]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  opendsa::ContentPackBuilder builder;
+  for (int i = 3; i < argc; i++) {
+    std::string text;
+    if (!opendsa::ReadFile(argv[i], &text)) {
+      std::fprintf(stderr, "Impossibile leggere %s\n", argv[i]);
+      return 1;
+    }
+    builder.AddText(text, split);
+  }
+
+  const std::string pack = builder.Build();
+  if (!opendsa::WriteFileAtomically(argv[1], pack.data(), pack.size())) {
+    std::fprintf(stderr, "Impossibile scrivere %s\n", argv[1]);
+    return 1;
+  }
+  std::printf("Pacchetto: %zu pagine, %zu byte di testo in %zu byte -> %s\n",
+              builder.size(), builder.text_size(), pack.size(), argv[1]);
+  return 0;
+}
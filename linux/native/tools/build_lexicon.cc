@@ -0,0 +1,55 @@
+// linux/native/tools/build_lexicon.cc
+//
+// Compila le liste di parole degli esercizi nel lessico binario caricato
+// dall'applicazione (vedi lexicon.h). Eseguito da linux/CMakeLists.txt a ogni
+// modifica delle liste.
+//
+// Uso: build_lexicon <output> <parole livello 1> [<parole livello 2> ...]
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "file_utils.h"
+#include "lexicon.h"
+
+int main(int argc, char** argv) {
+  if (argc < 3 || argc - 2 > opendsa::kLexiconLevels) {
+    std::fprintf(stderr,
+                 "Uso: %s <output> <parole livello 1> [<livello 2> ...]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  opendsa::LexiconBuilder builder;
+  for (int level = 1; level <= argc - 2; level++) {
+    const char* path = argv[level + 1];
+    std::string text;
+    if (!opendsa::ReadFile(path, &text)) {
+      std::fprintf(stderr, "Impossibile leggere %s\n", path);
+      return 1;
+    }
+    std::string_view rest = text;
+    int line_number = 0;
+    while (!rest.empty()) {
+      const size_t end = rest.find('\n');
+      const std::string_view line = rest.substr(0, end);
+      rest = end == std::string_view::npos ? std::string_view()
+                                           : rest.substr(end + 1);
+      line_number++;
+      if (!builder.Add(line, level)) {
+        std::fprintf(stderr, "%s:%d: parola non valida\n", path, line_number);
+        return 1;
+      }
+    }
+  }
+
+  const std::string lexicon = builder.Build();
+  if (!opendsa::WriteFileAtomically(argv[1], lexicon.data(), lexicon.size())) {
+    std::fprintf(stderr, "Impossibile scrivere %s\n", argv[1]);
+    return 1;
+  }
+  std::printf("Lessico: %zu parole, %zu byte -> %s\n", builder.size(),
+              lexicon.size(), argv[1]);
+  return 0;
+}
@@ -0,0 +1,94 @@
+// linux/native/tools/profile_tool.cc
+//
+// Converte i profili tra il JSON dei file .profile e il formato binario
+// (vedi binary_profile.h), e ne legge singoli campi.
+//
+// Uso: profile_tool import <profilo.json> <profilo.pbin>
+//      profile_tool export <profilo.pbin> [profilo.json]
+//      profile_tool get <profilo.pbin> <campo>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "binary_profile.h"
+#include "file_utils.h"
+
+namespace {
+
+int Import(const char* json_path, const char* output) {
+  std::string json;
+  if (!opendsa::ReadFile(json_path, &json)) {
+    std::fprintf(stderr, "Impossibile leggere %s\n", json_path);
+    return 1;
+  }
+  std::string profile;
+  std::string error;
+  if (!opendsa::BuildBinaryProfile(json, &profile, &error)) {
+    std::fprintf(stderr, "%s: %s\n", json_path, error.c_str());
+    return 1;
+  }
+  if (!opendsa::WriteFileAtomically(output, profile.data(), profile.size())) {
+    std::fprintf(stderr, "Impossibile scrivere %s\n", output);
+    return 1;
+  }
+  std::printf("Profilo: %zu byte di JSON in %zu byte -> %s\n", json.size(),
+              profile.size(), output);
+  return 0;
+}
+
+int Export(const char* path, const char* output) {
+  opendsa::BinaryProfile profile;
+  if (!profile.Open(path)) {
+    std::fprintf(stderr, "%s non è un profilo binario valido\n", path);
+    return 1;
+  }
+  std::string json;
+  profile.ToJson(opendsa::BinaryProfile::kNone, &json);
+  if (output == nullptr) {
+    std::printf("%s\n", json.c_str());
+    return 0;
+  }
+  if (!opendsa::WriteFileAtomically(output, json.data(), json.size())) {
+    std::fprintf(stderr, "Impossibile scrivere %s\n", output);
+    return 1;
+  }
+  return 0;
+}
+
+int Get(const char* path, const char* key) {
+  opendsa::BinaryProfile profile;
+  if (!profile.Open(path)) {
+    std::fprintf(stderr, "%s non è un profilo binario valido\n", path);
+    return 1;
+  }
+  const uint32_t field = profile.Find(profile.root(), key);
+  if (field == opendsa::BinaryProfile::kNone) {
+    std::fprintf(stderr, "Campo %s assente\n", key);
+    return 1;
+  }
+  std::string json;
+  profile.ToJson(field, &json);
+  std::printf("%s\n", json.c_str());
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc == 4 && std::strcmp(argv[1], "import") == 0) {
+    return Import(argv[2], argv[3]);
+  }
+  if ((argc == 3 || argc == 4) && std::strcmp(argv[1], "export") == 0) {
+    return Export(argv[2], argc == 4 ? argv[3] : nullptr);
+  }
+  if (argc == 4 && std::strcmp(argv[1], "get") == 0) {
+    return Get(argv[2], argv[3]);
+  }
+  std::fprintf(stderr,
+               "Uso: %s import <profilo.json> <profilo.pbin>\n"
+               "     %s export <profilo.pbin> [profilo.json]\n"
+               "     %s get <profilo.pbin> <campo>\n",
+               argv[0], argv[0], argv[0]);
+  return 2;
+}
@@ -0,0 +1,80 @@
+// linux/native/vosk_api.cc
+
+#include "vosk_api.h"
+
+#include <dlfcn.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace opendsa {
+
+namespace {
+
+constexpr char kVoskLibraryName[] = "libvosk.so";
+
+template <typename Function>
+bool Resolve(void* library, const char* name, Function* function) {
+  *function = reinterpret_cast<Function>(dlsym(library, name));
+  return *function != nullptr;
+}
+
+void* OpenVoskLibrary() {
+  std::vector<std::string> candidates;
+  if (const char* path = std::getenv("OPENDSA_VOSK_LIBRARY")) {
+    candidates.emplace_back(path);
+  }
+  // L'applicazione è già collegata a libvosk: in quel caso dlopen
+  // restituisce la copia caricata
+  candidates.emplace_back(kVoskLibraryName);
+  Dl_info self;
+  if (dladdr(reinterpret_cast<const void*>(&LoadVoskApi), &self) != 0 &&
+      self.dli_fname != nullptr) {
+    std::string dir(self.dli_fname);
+    const size_t slash = dir.rfind('/');
+    if (slash != std::string::npos) {
+      candidates.push_back(dir.substr(0, slash + 1) + kVoskLibraryName);
+    }
+  }
+#ifdef VOSK_LIB_PATH
+  candidates.push_back(std::string(VOSK_LIB_PATH) + "/" + kVoskLibraryName);
+#endif
+  for (const std::string& candidate : candidates) {
+    if (void* library = dlopen(candidate.c_str(), RTLD_NOW | RTLD_GLOBAL)) {
+      return library;
+    }
+  }
+  return nullptr;
+}
+
+const VoskApi* Load() {
+  // La libreria resta caricata fino alla fine del processo
+  void* library = OpenVoskLibrary();
+  if (library == nullptr) return nullptr;
+  static VoskApi api;
+  const bool complete =
+      Resolve(library, "vosk_model_new", &api.model_new) &&
+      Resolve(library, "vosk_model_free", &api.model_free) &&
+      Resolve(library, "vosk_recognizer_new", &api.recognizer_new) &&
+      Resolve(library, "vosk_recognizer_set_words",
+              &api.recognizer_set_words) &&
+      Resolve(library, "vosk_recognizer_accept_waveform_s",
+              &api.recognizer_accept_waveform_s) &&
+      Resolve(library, "vosk_recognizer_result", &api.recognizer_result) &&
+      Resolve(library, "vosk_recognizer_final_result",
+              &api.recognizer_final_result) &&
+      Resolve(library, "vosk_recognizer_reset", &api.recognizer_reset) &&
+      Resolve(library, "vosk_recognizer_free", &api.recognizer_free) &&
+      Resolve(library, "vosk_set_log_level", &api.set_log_level);
+  return complete ? &api : nullptr;
+}
+
+}  // namespace
+
+const VoskApi* LoadVoskApi() {
+  static const VoskApi* const api = Load();
+  return api;
+}
+
+}  // namespace opendsa
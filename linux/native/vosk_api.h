@@ -0,0 +1,38 @@
+// linux/native/vosk_api.h
+
+#ifndef OPENDSA_NATIVE_VOSK_API_H_
+#define OPENDSA_NATIVE_VOSK_API_H_
+
+namespace opendsa {
+
+// Tipi opachi di libvosk (vosk_api.h).
+struct VoskModel;
+struct VoskRecognizer;
+
+// Funzioni di libvosk usate dal riconoscimento dei file, con le firme di
+// vosk_api.h. libvosk viene caricata con dlopen alla prima richiesta: la
+// libreria nativa e gli strumenti eseguiti durante la build non dipendono
+// da libvosk, e il resto delle funzioni resta disponibile dove manca.
+struct VoskApi {
+  VoskModel* (*model_new)(const char* model_path);
+  void (*model_free)(VoskModel* model);
+  VoskRecognizer* (*recognizer_new)(VoskModel* model, float sample_rate);
+  void (*recognizer_set_words)(VoskRecognizer* recognizer, int words);
+  int (*recognizer_accept_waveform_s)(VoskRecognizer* recognizer,
+                                      const short* data, int length);
+  const char* (*recognizer_result)(VoskRecognizer* recognizer);
+  const char* (*recognizer_final_result)(VoskRecognizer* recognizer);
+  void (*recognizer_reset)(VoskRecognizer* recognizer);
+  void (*recognizer_free)(VoskRecognizer* recognizer);
+  void (*set_log_level)(int log_level);
+};
+
+// Carica libvosk una sola volta per processo, cercandola nell'ordine in
+// $OPENDSA_VOSK_LIBRARY, tra le librerie già caricate o nei percorsi di
+// sistema, accanto alla libreria nativa e in VOSK_LIB_PATH. Thread-safe.
+// Restituisce null se libvosk o una delle funzioni manca.
+const VoskApi* LoadVoskApi();
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_VOSK_API_H_
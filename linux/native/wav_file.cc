@@ -0,0 +1,151 @@
+// linux/native/wav_file.cc
+
+#include "wav_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "file_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+constexpr size_t kRiffHeaderSize = 12;  // "RIFF", dimensione, "WAVE"
+constexpr size_t kChunkHeaderSize = 8;  // Identificatore, dimensione
+
+uint16_t ReadU16(const uint8_t* data) {
+  return static_cast<uint16_t>(data[0] | data[1] << 8);
+}
+
+uint32_t ReadU32(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) |
+         static_cast<uint32_t>(data[1]) << 8 |
+         static_cast<uint32_t>(data[2]) << 16 |
+         static_cast<uint32_t>(data[3]) << 24;
+}
+
+void AppendU16(std::string* out, uint16_t value) {
+  out->push_back(static_cast<char>(value & 0xFF));
+  out->push_back(static_cast<char>(value >> 8));
+}
+
+void AppendU32(std::string* out, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out->push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+}  // namespace
+
+bool ParseWav(const uint8_t* data, size_t size, WavInfo* out) {
+  *out = WavInfo();
+  if (size < kRiffHeaderSize || std::memcmp(data, "RIFF", 4) != 0 ||
+      std::memcmp(data + 8, "WAVE", 4) != 0) {
+    return false;
+  }
+
+  bool has_format = false;
+  size_t offset = kRiffHeaderSize;
+  while (size - offset >= kChunkHeaderSize) {
+    const uint8_t* chunk = data + offset;
+    const uint64_t chunk_size = ReadU32(chunk + 4);
+    const size_t body = offset + kChunkHeaderSize;
+    const size_t available = size - body;
+
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      if (chunk_size < 16 || chunk_size > available) return false;
+      uint16_t format = ReadU16(data + body);
+      out->channels = ReadU16(data + body + 2);
+      out->sample_rate = ReadU32(data + body + 4);
+      out->bits_per_sample = ReadU16(data + body + 14);
+      // WAVE_FORMAT_EXTENSIBLE: il formato vero è all'inizio del GUID
+      if (format == kFormatExtensible && chunk_size >= 40) {
+        format = ReadU16(data + body + 24);
+      }
+      if (format != kFormatPcm || out->channels == 0 ||
+          out->sample_rate == 0 || out->bits_per_sample % 8 != 0 ||
+          out->bits_per_sample < 8 || out->bits_per_sample > 32) {
+        return false;
+      }
+      has_format = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      if (!has_format) return false;
+      out->data_offset = body;
+      // 0 o oltre la fine: registrazione non chiusa
+      out->data_size = chunk_size == 0 || chunk_size > available
+                           ? available
+                           : chunk_size;
+      const uint32_t frame_size =
+          out->channels * (out->bits_per_sample / 8u);
+      out->frames = out->data_size / frame_size;
+      out->data_size = out->frames * frame_size;
+      return true;
+    }
+    // I blocchi hanno lunghezza pari
+    const uint64_t next = chunk_size + (chunk_size & 1);
+    if (next > available) return false;
+    offset = body + static_cast<size_t>(next);
+  }
+  return false;
+}
+
+void ReadPcm16(const uint8_t* data, const WavInfo& info,
+               std::vector<int16_t>* out) {
+  ReadPcm16(data, info, 0, static_cast<size_t>(info.frames), out);
+}
+
+void ReadPcm16(const uint8_t* data, const WavInfo& info, uint64_t first_frame,
+               size_t frames, std::vector<int16_t>* out) {
+  first_frame = std::min(first_frame, info.frames);
+  frames = static_cast<size_t>(
+      std::min<uint64_t>(frames, info.frames - first_frame));
+  const size_t count = frames * info.channels;
+  const size_t width = info.bits_per_sample / 8u;
+  out->resize(count);
+  const uint8_t* source =
+      data + info.data_offset + first_frame * info.channels * width;
+  if (width == 2) {
+    for (size_t i = 0; i < count; ++i) {
+      (*out)[i] = static_cast<int16_t>(ReadU16(source + i * 2));
+    }
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t* sample = source + i * width;
+    // 8 bit senza segno; negli altri formati il byte più significativo è
+    // l'ultimo
+    (*out)[i] = width == 1
+                    ? static_cast<int16_t>((sample[0] - 128) * 256)
+                    : static_cast<int16_t>(ReadU16(sample + width - 2));
+  }
+}
+
+bool WriteWav(const std::string& path, uint32_t sample_rate,
+              uint16_t channels, const int16_t* samples, size_t frames) {
+  const uint64_t data_size = static_cast<uint64_t>(frames) * channels * 2;
+  if (channels == 0 || data_size > UINT32_MAX - 36) return false;
+
+  std::string wav;
+  wav.reserve(44 + data_size);
+  wav += "RIFF";
+  AppendU32(&wav, static_cast<uint32_t>(36 + data_size));
+  wav += "WAVEfmt ";
+  AppendU32(&wav, 16);
+  AppendU16(&wav, kFormatPcm);
+  AppendU16(&wav, channels);
+  AppendU32(&wav, sample_rate);
+  AppendU32(&wav, sample_rate * channels * 2);  // Byte al secondo
+  AppendU16(&wav, static_cast<uint16_t>(channels * 2));
+  AppendU16(&wav, 16);
+  wav += "data";
+  AppendU32(&wav, static_cast<uint32_t>(data_size));
+  for (size_t i = 0; i < frames * channels; ++i) {
+    AppendU16(&wav, static_cast<uint16_t>(samples[i]));
+  }
+  return WriteFileAtomically(path, wav.data(), wav.size());
+}
+
+}  // namespace opendsa
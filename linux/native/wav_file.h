@@ -0,0 +1,49 @@
+// linux/native/wav_file.h
+
+#ifndef OPENDSA_NATIVE_WAV_FILE_H_
+#define OPENDSA_NATIVE_WAV_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace opendsa {
+
+// Formato di un file WAV PCM e posizione dei campioni nel file.
+struct WavInfo {
+  uint32_t sample_rate = 0;
+  uint16_t channels = 0;
+  uint16_t bits_per_sample = 0;
+  uint64_t data_offset = 0;  // Primo byte dei campioni
+  uint64_t data_size = 0;    // Byte dei campioni, troncati a frame interi
+  uint64_t frames = 0;
+};
+
+// Legge l'intestazione RIFF/WAVE di |data| (l'intero file) e cerca i blocchi
+// "fmt " e "data". Accetta solo PCM intero (formato 1 o
+// WAVE_FORMAT_EXTENSIBLE con sottoformato PCM) a 8, 16, 24 o 32 bit. Un
+// blocco "data" con dimensione non valida, come lo lasciano i registratori
+// interrotti, arriva fino alla fine del file. Restituisce false se |data|
+// non è un WAV PCM valido.
+bool ParseWav(const uint8_t* data, size_t size, WavInfo* out);
+
+// Campioni di |data| descritti da |info| convertiti a 16 bit, interleaved,
+// in |out|: gli 8 bit vengono estesi, 24 e 32 bit perdono i bit meno
+// significativi.
+void ReadPcm16(const uint8_t* data, const WavInfo& info,
+               std::vector<int16_t>* out);
+
+// Come sopra, solo per |frames| frame a partire da |first_frame|, per chi
+// legge il file a blocchi. L'intervallo viene limitato ai frame del file.
+void ReadPcm16(const uint8_t* data, const WavInfo& info, uint64_t first_frame,
+               size_t frames, std::vector<int16_t>* out);
+
+// Scrive in |path| un WAV PCM a 16 bit con |frames| frame interleaved di
+// |channels| canali.
+bool WriteWav(const std::string& path, uint32_t sample_rate,
+              uint16_t channels, const int16_t* samples, size_t frames);
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_WAV_FILE_H_
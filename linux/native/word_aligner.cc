@@ -0,0 +1,112 @@
+// linux/native/word_aligner.cc
+
+#include "word_aligner.h"
+
+#include <algorithm>
+
+#include "cost_matrix.h"
+#include "text_utils.h"
+
+namespace opendsa {
+
+namespace {
+
+// Costi dell'allineamento fra parole
+constexpr int32_t kWordIndelCost = 3;
+constexpr int32_t kWordSimilarCost = 2;
+constexpr int32_t kWordDifferentCost = 5;
+
+bool IsWordToken(const TokenizedText& text, size_t token) {
+  return text.kinds[token] != static_cast<uint8_t>(TokenKind::kPunctuation);
+}
+
+}  // namespace
+
+int32_t WordAligner::SubstitutionCost(size_t token, size_t word) {
+  const std::u32string& expected = target_words_[token];
+  const std::u32string& actual = recognized_words_[word];
+  if (expected == actual) return 0;
+  const int32_t distance =
+      aligner_.Distance(expected, actual, CostMatrix::Default());
+  const int32_t longest =
+      static_cast<int32_t>(std::max(expected.size(), actual.size()));
+  return 2 * distance <= longest * kCostUnit ? kWordSimilarCost
+                                             : kWordDifferentCost;
+}
+
+void WordAligner::Align(const TokenizedText& text,
+                        size_t first,
+                        size_t count,
+                        std::string_view recognized,
+                        std::vector<int32_t>* out) {
+  out->clear();
+  first = std::min(first, text.size());
+  count = std::min(count, text.size() - first);
+
+  // Solo parole e numeri partecipano all'allineamento
+  target_tokens_.clear();
+  for (size_t token = first; token < first + count; token++) {
+    if (IsWordToken(text, token)) {
+      target_tokens_.push_back(static_cast<uint32_t>(token));
+    }
+  }
+  const size_t n = target_tokens_.size();
+  // Le stringhe decodificate vengono riutilizzate fra una chiamata e l'altra
+  if (target_words_.size() < n) target_words_.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    DecodeUtf8(text.normalized_form(target_tokens_[i]), &target_words_[i]);
+  }
+
+  tokenizer_.Tokenize(recognized, &recognized_);
+  size_t m = 0;
+  for (size_t token = 0; token < recognized_.size(); token++) {
+    if (!IsWordToken(recognized_, token)) continue;
+    if (recognized_words_.size() <= m) recognized_words_.resize(m + 1);
+    DecodeUtf8(recognized_.normalized_form(token), &recognized_words_[m++]);
+  }
+
+  out->assign(m, -1);
+  if (n == 0 || m == 0) return;
+
+  const size_t width = m + 1;
+  matrix_.resize((n + 1) * width);
+  int32_t* d = matrix_.data();
+  for (size_t j = 0; j <= m; j++) {
+    d[j] = static_cast<int32_t>(j) * kWordIndelCost;
+  }
+  for (size_t i = 1; i <= n; i++) {
+    int32_t* row = d + i * width;
+    const int32_t* up = row - width;
+    row[0] = static_cast<int32_t>(i) * kWordIndelCost;
+    for (size_t j = 1; j <= m; j++) {
+      int32_t best = std::min(up[j], row[j - 1]) + kWordIndelCost;
+      // La sostituzione è calcolata solo se può migliorare il risultato
+      if (up[j - 1] < best) {
+        best = std::min(best, up[j - 1] + SubstitutionCost(i - 1, j - 1));
+      }
+      row[j] = best;
+    }
+  }
+
+  // Ricostruzione a ritroso, preferendo le corrispondenze
+  size_t i = n;
+  size_t j = m;
+  while (i > 0 && j > 0) {
+    const int32_t current = d[i * width + j];
+    const int32_t diagonal = d[(i - 1) * width + j - 1];
+    const int32_t cost = SubstitutionCost(i - 1, j - 1);
+    if (current == diagonal + cost) {
+      if (cost != kWordDifferentCost) {
+        (*out)[j - 1] = static_cast<int32_t>(target_tokens_[i - 1]);
+      }
+      i--;
+      j--;
+    } else if (current == d[(i - 1) * width + j] + kWordIndelCost) {
+      i--;
+    } else {
+      j--;
+    }
+  }
+}
+
+}  // namespace opendsa
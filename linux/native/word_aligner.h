@@ -0,0 +1,54 @@
+// linux/native/word_aligner.h
+
+#ifndef OPENDSA_NATIVE_WORD_ALIGNER_H_
+#define OPENDSA_NATIVE_WORD_ALIGNER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alignment.h"
+#include "tokenizer.h"
+
+namespace opendsa {
+
+// Allinea le parole riconosciute da VOSK ai token di un testo già
+// suddiviso, così la schermata di lettura può evidenziare la parola esatta
+// (con i suoi offset) senza ricostruire nulla.
+//
+// L'allineamento è una distanza di edit fra sequenze di parole: due parole
+// uguali costano 0, due parole simili (distanza fra caratteri al più metà
+// della più lunga) poco, due parole diverse più di un'omissione ma meno di
+// un'omissione e un'inserzione insieme. Le parole lette in più e quelle
+// saltate restano così fuori dall'allineamento senza spostare il resto.
+//
+// Non è thread-safe: usare un'istanza per thread.
+class WordAligner {
+ public:
+  // Allinea |recognized| ai token di |text| nell'intervallo
+  // [first, first + count). |out| riceve, per ogni parola riconosciuta,
+  // l'indice del token corrispondente o -1 se la parola non corrisponde a
+  // nessun token.
+  void Align(const TokenizedText& text,
+             size_t first,
+             size_t count,
+             std::string_view recognized,
+             std::vector<int32_t>* out);
+
+ private:
+  // Costo di sostituzione fra il token |token| e la parola |word|.
+  int32_t SubstitutionCost(size_t token, size_t word);
+
+  Tokenizer tokenizer_;
+  Aligner aligner_;
+  TokenizedText recognized_;
+  std::vector<uint32_t> target_tokens_;
+  std::vector<std::u32string> target_words_;
+  std::vector<std::u32string> recognized_words_;
+  std::vector<int32_t> matrix_;
+};
+
+}  // namespace opendsa
+
+#endif  // OPENDSA_NATIVE_WORD_ALIGNER_H_